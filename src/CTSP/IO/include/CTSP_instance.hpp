@@ -105,10 +105,13 @@ namespace CTSP
         /**
          * @brief Read CTSP instance from file
          * @param input_file Path to instance file
+         * @param os Stream the instance header is logged to
          * @note Automatically parses TSPLIB format with CTSP extensions
          * @note Validates triangle inequality and symmetry properties
+         * @note After set_lazy_distances(true), coordinate instances keep no
+         *       distance matrix (see get_distance_oracle()) and skip the checks
          */
-        virtual void read(const string &input_file);
+        virtual void read(const string &input_file, ostream &os = cout);
 
         /**
          * @brief Disable maximum distance constraint
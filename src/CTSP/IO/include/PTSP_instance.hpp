@@ -21,6 +21,8 @@
 #include <utility>
 
 #include "matrix.hpp"
+#include "distance_oracle.hpp"
+#include "coord_distance_oracle.hpp"
 
 using namespace std;
 
@@ -68,7 +70,11 @@ namespace PTSP
         size_t n_customers_; ///< Number of customers (excluding depot)
         size_t n_days_;      ///< Number of planning days/periods
 
-        GOMA::matrix<double> distances_; ///< Distance matrix (1-based indexing)
+        GOMA::matrix<double> distances_; ///< Distance matrix (1-based indexing, empty if lazy)
+
+        bool lazy_distances_;                        ///< Coordinate distances computed on demand
+        TSP::coord_distance_oracle coord_distances_; ///< On-demand distances (lazy read)
+        GOMA::matrix_distance_oracle matrix_distances_; ///< Oracle over distances_
 
         bool triangle_inequality_; ///< True if distances satisfy triangle inequality
         bool symmetry_;            ///< True if distance matrix is symmetric
@@ -88,6 +94,10 @@ namespace PTSP
          */
         virtual ~instance(void);
 
+        /// Not copyable (matrix_distances_ refers to distances_)
+        instance(const instance &) = delete;
+        instance &operator=(const instance &) = delete;
+
         /**
          * @brief Check if triangle inequality holds
          * @return true if d(i,k) + d(k,j) >= d(i,j) for all i,j,k
@@ -121,11 +131,44 @@ namespace PTSP
             return type_;
         }
 
+        /**
+         * @brief Get distance matrix
+         * @return Distances (empty after a lazy read of a coordinate instance)
+         */
         inline const GOMA::matrix<double> &get_distances(void) const
         {
             return distances_;
         }
 
+        /**
+         * @brief Get distances, stored or computed on demand
+         * @return Oracle over get_distances(), or over the coordinates after
+         *         a lazy read (not thread-safe then, see coord_distance_oracle)
+         */
+        inline const GOMA::distance_oracle &get_distance_oracle(void) const
+        {
+            if (lazy_distances_)
+                return coord_distances_;
+
+            return matrix_distances_;
+        }
+
+        /**
+         * @brief Keep coordinate instances as coordinates (read() option)
+         * @param lazy_distances true: no n x n matrix, distances computed
+         *        from the coordinates through get_distance_oracle()
+         * @note Explicit matrices are always stored
+         */
+        inline void set_lazy_distances(const bool lazy_distances)
+        {
+            lazy_distances_ = lazy_distances;
+        }
+
+        inline bool has_lazy_distances(void) const
+        {
+            return lazy_distances_;
+        }
+
         inline const size_t &get_n_days(void) const
         {
             return n_days_;
@@ -19,7 +19,10 @@
 #include <utility>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include "matrix.hpp"
+#include "TSPLIB_scanner.hpp"
+#include "coord_distance_oracle.hpp"
 
 using namespace std;
 
@@ -158,7 +161,9 @@ namespace TSP
         int maximum_allowable_differencial_; ///< Max time window width (CTSP extension)
         int depot_;                       ///< Depot node index
 
-        double *distances_; ///< Distance matrix (1D array)
+        bool lazy_distances_;             ///< Coordinate sections do not fill distances_
+
+        GOMA::matrix<double> distances_; ///< Distance matrix (1-based, rows through row())
 
         vector<int> coord_id_;            ///< Node IDs for coordinates
         vector<coordType> coord_;         ///< Node coordinates (x, y)
@@ -188,10 +193,13 @@ namespace TSP
         /**
          * @brief Read TSPLIB instance from file
          * @param input_file Path to TSPLIB format file
+         * @param os Stream the instance header is logged to
          * @note Automatically detects format and distance type
          * @note Computes distance matrix if coordinates are provided
+         * @note The file is memory-mapped and scanned in a single pass;
+         *       files that cannot be mapped go through the istream reader
          */
-        void read(const string &input_file);
+        void read(const string &input_file, ostream &os = cout);
 
         // Getters
         inline const string &get_instance_name(void) const
@@ -231,6 +239,30 @@ namespace TSP
          */
         void get_distances(GOMA::matrix<double> &distances_) const;
 
+        /**
+         * @brief Do not compute the distance matrix of coordinate instances
+         * @param lazy_distances true: get_distances() gives an empty matrix
+         *        for them, get_distance_oracle() computes on demand
+         * @note Must be set before read(); explicit matrices are always stored
+         */
+        inline void set_lazy_distances(const bool lazy_distances)
+        {
+            lazy_distances_ = lazy_distances;
+        }
+
+        /**
+         * @brief Whether the distances are given by coordinates only (lazy read)
+         */
+        bool has_coordinates(void) const;
+
+        /**
+         * @brief On-demand distances of a coordinate instance
+         * @param oracle Output: oracle over the node coordinates
+         * @param n_cache_rows Rows kept by the oracle cache
+         * @note Same values as get_distances() would give without the lazy read
+         */
+        void get_distance_oracle(coord_distance_oracle &oracle, const size_t n_cache_rows) const;
+
         inline const vector<vector<int>> &get_demands(void) const
         {
             return demand_;
@@ -260,9 +292,20 @@ namespace TSP
         /**
          * @brief Compute distance matrix from coordinates
          * @note Uses the appropriate distance function based on edge_weight_type_
+         * @note Rows are filled by the coord_distance_oracle kernels over
+         *       per-node terms (GEO latitude/longitude in radians computed
+         *       once), on several threads for large instances; values are
+         *       bit-identical to the per-pair distance functions
          */
         void compute_implicit_distance_matrix_(void);
 
+        /**
+         * @brief Worker of compute_implicit_distance_matrix_
+         * @param oracle Row kernels over the node coordinates
+         * @param next_row Shared row counter
+         */
+        void fill_distance_rows_(const coord_distance_oracle &oracle, atomic<int> &next_row);
+
         // Section reading methods (one per TSPLIB keyword)
         void read_name_section_(istream &is, ostream &os);
         void read_type_section_(istream &is, ostream &os);
@@ -315,7 +358,30 @@ namespace TSP
 
         void read_(istream &is, ostream &os);
 
-        int find_key_(const string &token, const vector<string> keywords) const;
+        /**
+         * @brief Single-pass reader over a memory-mapped file
+         * @param input_file Path to TSPLIB format file
+         * @param os Log stream (same messages as the istream reader)
+         * @return false (nothing read) if the file cannot be mapped
+         */
+        bool read_mapped_(const string &input_file, ostream &os);
+
+        // Mapped counterparts of the section readers with data sections
+        void scan_(TSPLIB_scanner &sc, ostream &os);
+        void scan_comment_section_(TSPLIB_scanner &sc, ostream &os);
+        void scan_edge_weight_section_(TSPLIB_scanner &sc, ostream &os);
+        void scan_node_coord_section_(TSPLIB_scanner &sc, ostream &os);
+        void scan_display_data_section_(TSPLIB_scanner &sc, ostream &os);
+        void scan_demand_section_(TSPLIB_scanner &sc, ostream &os);
+
+        /**
+         * @brief Skip a section of dimension_ lines of values
+         * @param sc Scanner
+         * @param n_values Values per line (node id included)
+         */
+        void scan_node_values_(TSPLIB_scanner &sc, const int n_values);
+
+        int find_key_(const string &token, const vector<string> &keywords) const;
 
         int nint_(double x) const;
         double dtrunc_(double x) const;
@@ -0,0 +1,120 @@
+/**
+ * @file TSPLIB_scanner.hpp
+ * @brief Single-pass tokenizer over a memory-mapped TSPLIB file
+ *
+ * TSPLIB_instance used to copy the input file without ':' to a temporary
+ * file and extract it token by token with istream >>. For large
+ * EDGE_WEIGHT_SECTION matrices (FULL_MATRIX instances with thousands of
+ * nodes) that dominates the startup time.
+ *
+ * TSPLIB_scanner maps the file read-only and walks it once: ':' counts as
+ * white space (so "NAME: x" and "NAME : x" are two tokens, as after the
+ * old cleaning step), keywords are returned as views into the mapping and
+ * numbers are converted in place with std::from_chars.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+using namespace std;
+
+namespace TSP
+{
+    /**
+     * @class TSPLIB_scanner
+     * @brief Read-only mmap of a file with token and number extraction
+     *
+     * ```cpp
+     * TSPLIB_scanner sc;
+     *
+     * if (sc.open("bayg29.tsp"))
+     *     while (!sc.next_token().empty()) { ... sc.next_int() ... }
+     * ```
+     */
+    class TSPLIB_scanner
+    {
+    private:
+        const char *begin_; ///< First byte of the mapping
+        const char *end_;   ///< One past the last byte
+        const char *pos_;   ///< Next byte to scan
+
+        size_t size_; ///< Mapped bytes (0: nothing mapped)
+
+    public:
+        TSPLIB_scanner(void);
+
+        /**
+         * @brief Unmap the file
+         */
+        virtual ~TSPLIB_scanner(void);
+
+        TSPLIB_scanner(const TSPLIB_scanner &) = delete;
+        TSPLIB_scanner &operator=(const TSPLIB_scanner &) = delete;
+
+        /**
+         * @brief Map a file
+         * @param filename Input file
+         * @return false if the file cannot be opened, is not a regular
+         *         file, is empty or cannot be mapped
+         */
+        bool open(const string &filename);
+
+        /**
+         * @brief Next white space (or ':') separated token
+         * @return View into the mapping, empty at the end of the file
+         */
+        string_view next_token(void);
+
+        /**
+         * @brief Next integer
+         * @return Value read (exits on a malformed number)
+         */
+        int next_int(void);
+
+        /**
+         * @brief Next real number
+         * @return Value read (exits on a malformed number)
+         */
+        double next_double(void);
+
+        /**
+         * @brief Next real number of the current line, if there is one
+         * @param val Output: value read (unchanged if none)
+         * @return false (only blanks of the line consumed) if no number
+         *         starts here
+         */
+        bool try_double(double &val);
+
+        /**
+         * @brief Skip up to a character of the current line
+         * @param c Character to look for
+         * @return false (stops at the end of the line) if c is not found
+         */
+        bool skip_past(const char c);
+
+        /**
+         * @brief Skip the rest of the current line
+         */
+        void skip_line(void);
+
+        inline bool eof(void) const { return pos_ >= end_; }
+
+    private:
+        void skip_blanks_(void);
+
+        /**
+         * @brief Convert the number starting at the current position
+         * @param val Output: value read (unchanged if none)
+         * @return false if no number starts here
+         */
+        bool parse_double_(double &val);
+
+        /**
+         * @brief Report a malformed number with its line and exit
+         */
+        [[noreturn]] void error_(void) const;
+    };
+}
@@ -0,0 +1,122 @@
+/**
+ * @file coord_distance_oracle.hpp
+ * @brief Distances of a coordinate TSPLIB instance computed on demand
+ *
+ * For EUC_2D/GEO/... instances the distance matrix is a function of the
+ * node coordinates. coord_distance_oracle keeps the per-node terms
+ * (coordinates, or latitude/longitude in radians for GEO) and evaluates
+ * distances with the TSPLIB rounding rules when they are read, so that the
+ * dense n x n matrix never has to exist. An optional direct-mapped cache
+ * keeps the last rows read: consumers that scan a row at a time (the
+ * routing partition of sync_model_builder) compute every row once.
+ *
+ * The row kernels are also what TSPLIB_instance uses to fill the full
+ * matrix, so both give bit-identical values.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#include "distance_oracle.hpp"
+
+// Edge weight types (index in TSPLIB_instance::wtypes)
+#define _EXPLICIT 0
+#define _EUC_2D 1
+#define _EUC_3D 2
+#define _MAX_2D 3
+#define _MAX_3D 4
+#define _MAN_2D 5
+#define _MAN_3D 6
+#define _CEIL_2D 7
+#define _GEO 8
+#define _ATT 9
+
+#define TSPLIB_PI 3.141592
+
+using namespace std;
+
+namespace TSP
+{
+    /**
+     * @class coord_distance_oracle
+     * @brief Lazily evaluated TSPLIB coordinate distances with a row cache
+     *
+     * ```cpp
+     * coord_distance_oracle D(_GEO, coords, 64); // 64 cached rows
+     *
+     * const double d_12{D(1, 2)};                // 1-based, diagonal 1E8 as get_distances
+     * ```
+     *
+     * @note operator() updates the cache and is not thread-safe; fill_row()
+     *       does not touch it and can be called concurrently
+     */
+    class coord_distance_oracle : public GOMA::distance_oracle
+    {
+    protected:
+        int edge_weight_type_; ///< _EUC_2D, _MAX_2D, _MAN_2D, _CEIL_2D, _GEO or _ATT
+        int n_;                ///< Number of nodes
+
+        vector<double> x_; ///< Per-node first term (x, or latitude in radians for GEO)
+        vector<double> y_; ///< Per-node second term (y, or longitude in radians for GEO)
+
+        size_t n_cache_rows_;               ///< Cache slots (0: no cache)
+        mutable vector<double> cache_;      ///< n_cache_rows_ rows of n_ distances
+        mutable vector<int> cache_row_;     ///< Row held by each slot (-1: none)
+
+    public:
+        coord_distance_oracle(void);
+
+        /**
+         * @brief Oracle over a set of coordinates
+         * @param edge_weight_type Distance type (index in TSPLIB_instance::wtypes)
+         * @param coord Node coordinates (x, y), or (latitude, longitude) for GEO
+         * @param n_cache_rows Rows kept by the cache (0: every read is computed)
+         * @note Exits if the type has no two-dimensional distance function
+         */
+        coord_distance_oracle(const int edge_weight_type, const vector<pair<double, double>> &coord, const size_t n_cache_rows = 0);
+
+        virtual ~coord_distance_oracle(void);
+
+        /**
+         * @brief Resize the row cache (emptying it)
+         * @param n_cache_rows Rows kept by the cache (0: no cache)
+         */
+        void set_cache_rows(const size_t n_cache_rows);
+
+        inline size_t get_n_rows(void) const { return n_; }
+        inline size_t get_cache_rows(void) const { return n_cache_rows_; }
+        inline bool empty(void) const { return n_ == 0; }
+
+        /**
+         * @brief Distance from i to j (1E8 on the diagonal, as TSPLIB_instance::get_distances)
+         * @param i Row index (1-based)
+         * @param j Column index (1-based)
+         */
+        double operator()(size_t i, size_t j) const;
+
+        /**
+         * @brief Concurrent operator() calls are safe without a row cache only
+         */
+        inline bool concurrent_reads(void) const { return n_cache_rows_ == 0; }
+
+        /**
+         * @brief Distances from node i to every node (diagonal not replaced)
+         * @param i Row (0-based)
+         * @param row Output: n distances
+         */
+        inline void fill_row(const int i, double *row) const { fill_range_(i, 0, n_, row); }
+
+    protected:
+        /**
+         * @brief Distances from node i to the nodes [first, last)
+         * @param i Row (0-based)
+         * @param first First column (0-based)
+         * @param last One past the last column
+         * @param out Output: out[j - first] for j in [first, last)
+         */
+        void fill_range_(const int i, const int first, const int last, double *out) const;
+    };
+}
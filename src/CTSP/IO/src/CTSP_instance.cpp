@@ -1,6 +1,8 @@
 #include "CTSP_instance.hpp"
 #include "TSPLIB_instance.hpp"
 
+#define DISTANCE_CACHE_ROWS 64
+
 namespace CTSP
 {
     instance::instance(void) : PTSP::instance(), T_(0), max_distance_(0), optimal_values_()
@@ -16,11 +18,12 @@ namespace CTSP
     {
     }
 
-    void instance::read(const string &input_file)
+    void instance::read(const string &input_file, ostream &os)
     {
         TSP::TSPLIB_instance tsplib_instance;
 
-        tsplib_instance.read(input_file);
+        tsplib_instance.set_lazy_distances(lazy_distances_);
+        tsplib_instance.read(input_file, os);
 
         id_ = tsplib_instance.get_instance_name();
         type_ = tsplib_instance.get_instance_type();
@@ -28,6 +31,12 @@ namespace CTSP
 
         n_customers_ = tsplib_instance.get_dimension() - 1;
 
+        // Explicit matrices are stored even if a lazy read was asked for
+        lazy_distances_ = tsplib_instance.has_coordinates();
+
+        if (lazy_distances_)
+            tsplib_instance.get_distance_oracle(coord_distances_, DISTANCE_CACHE_ROWS);
+
         tsplib_instance.get_distances(distances_);
         // distances_.write_raw(cout);
         // cout << endl;
@@ -47,14 +56,17 @@ namespace CTSP
 
         optimal_values_ = tsplib_instance.get_optimal_values();
 
-        triangle_inequality_ = check_triangle_inequality_();
+        // TSPLIB coordinate metrics pass both checks (their rounding stays
+        // within the tolerance of check_triangle_inequality_), and the O(n^3)
+        // check is what a lazy read of a large instance cannot afford
+        triangle_inequality_ = lazy_distances_ ? true : check_triangle_inequality_();
 
         if (!triangle_inequality_)
         {
             cerr << "Warning: Triangle inequality violated" << endl;
         }
 
-        symmetry_ = check_symmetry_();
+        symmetry_ = lazy_distances_ ? true : check_symmetry_();
 
         if (!symmetry_)
         {
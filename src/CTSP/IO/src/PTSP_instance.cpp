@@ -3,7 +3,7 @@
 
 namespace PTSP
 {
-    instance::instance(void) : id_(""), n_customers_(0), n_days_(0), distances_(), triangle_inequality_(false), symmetry_(false)
+    instance::instance(void) : id_(""), n_customers_(0), n_days_(0), distances_(), lazy_distances_(false), coord_distances_(), matrix_distances_(distances_), triangle_inequality_(false), symmetry_(false)
     {
     }
 
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <fstream>
 #include <cstdio>
+#include <thread>
 
 #include <stdlib.h>
 #include <errno.h>
@@ -12,23 +13,12 @@
 
 #define LINE_LEN 80
 
-#define _EXPLICIT 0
-#define _EUC_2D 1
-#define _EUC_3D 2
-#define _MAX_2D 3
-#define _MAX_3D 4
-#define _MAN_2D 5
-#define _MAN_3D 6
-#define _CEIL_2D 7
-#define _GEO 8
-#define _ATT 9
-
-#define TSPLIB_PI 3.141592
+#define PARALLEL_ROWS_THRLD 512
 
 namespace TSP
 {
 
-    TSPLIB_instance::TSPLIB_instance(void) : name_(), type_(), comment_(), dimension_(-1), edge_weight_type_(-1), edge_weight_format_(-1), display_data_type_(-1), num_days_(-1), max_distance_(-1), maximum_allowable_differencial_(-1), depot_(-1), distances_(NULL), coord_id_(), coord_(), display_id_(), display_(), demand_()
+    TSPLIB_instance::TSPLIB_instance(void) : name_(), type_(), comment_(), dimension_(-1), edge_weight_type_(-1), edge_weight_format_(-1), display_data_type_(-1), num_days_(-1), max_distance_(-1), maximum_allowable_differencial_(-1), depot_(-1), lazy_distances_(false), distances_(), coord_id_(), coord_(), display_id_(), display_(), demand_()
     {
         distance_function_.resize(WTYPE_NUM);
         read_function_.resize(KEY_NUM);
@@ -82,22 +72,15 @@ namespace TSP
 
     TSPLIB_instance::~TSPLIB_instance(void)
     {
-        if (distances_ != NULL)
-            delete[] distances_;
     }
 
     void TSPLIB_instance::get_distances(GOMA::matrix<double> &distances) const
     {
 
-        distances.resize(dimension_, dimension_);
+        distances = distances_;
 
-        for (int i = 0; i < dimension_; i++)
-            for (int j = 0; j < dimension_; j++)
-                if (i != j)
-                    distances(i + 1, j + 1) = distances_[i * dimension_ + j];
-                else
-                    distances(i + 1, j + 1) = 100000000.0;
-                
+        for (size_t i = 1; i <= distances.get_n_rows(); i++)
+            distances(i, i) = 100000000.0;
     }
 
     void TSPLIB_instance::read_name_section_(istream &is, ostream &os)
@@ -182,16 +165,8 @@ namespace TSP
     void TSPLIB_instance::establish_dimension_(const int dimension)
     {
 
-        if (distances_ != NULL)
-            delete[] distances_;
-
-        distances_ = NULL;
-
-        distances_ = new double[dimension * dimension];
-
-        for (int i = 0; i < dimension_; i++)
-            for (int j = 0; j < dimension_; j++)
-                distances_[i * dimension_ + j] = 0.0;
+        // Allocated by the section that fills it (none for lazy coordinates)
+        distances_.resize(0, 0);
 
         coord_id_.resize(dimension);
         coord_.resize(dimension);
@@ -371,7 +346,7 @@ namespace TSP
             coord_[i] = coordType(x, y);
         }
 
-        if (edge_weight_type_ != _EXPLICIT)
+        if (!lazy_distances_)
             compute_implicit_distance_matrix_();
 
         os << "Reading coords                : " << dimension_ << endl;
@@ -385,8 +360,8 @@ namespace TSP
             for (int j{i + 1}; j < dimension_; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -400,8 +375,8 @@ namespace TSP
             for (int j{0}; j < i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -415,8 +390,8 @@ namespace TSP
             for (int j{0}; j <= i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -430,8 +405,8 @@ namespace TSP
             for (int j{0}; j <= i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -445,8 +420,8 @@ namespace TSP
             for (int j{0}; j < i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -460,8 +435,8 @@ namespace TSP
             for (int j{0}; j < i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -475,8 +450,8 @@ namespace TSP
             for (int j{0}; j <= i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -490,8 +465,8 @@ namespace TSP
             for (int j{0}; j <= i; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
-                distances_[j * dimension_ + i] = k;
+                distances_(i + 1, j + 1) = k;
+                distances_(j + 1, i + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -505,7 +480,7 @@ namespace TSP
             for (int j{0}; j < dimension_; j++)
             {
                 is >> k;
-                distances_[i * dimension_ + j] = k;
+                distances_(i + 1, j + 1) = k;
             }
 
         os << "Reading distances             : " << dimension_ << endl;
@@ -532,6 +507,9 @@ namespace TSP
             exit(1);
         }
 
+        distances_.resize(dimension_, dimension_);
+        distances_.fill(0.0);
+
         (this->*edge_weight_reading_function_[edge_weight_format_])(is, os);
     }
 
@@ -550,16 +528,41 @@ namespace TSP
             exit(1);
         }
 
-        for (int i = 0; i < dimension_; i++)
-            for (int j = 0; j < dimension_; j++)
-            {
-                const coordType &coord_i{coord_[i]};
-                const coordType &coord_j{coord_[j]};
+        const int n{dimension_};
 
-                const double distance_ij{(this->*distance_function_[edge_weight_type_])(coord_i, coord_j)};
+        const coord_distance_oracle oracle(edge_weight_type_, coord_);
 
-                distances_[i * dimension_ + j] = distance_ij;
-            }
+        distances_.resize(n, n);
+
+        const int n_threads{n < PARALLEL_ROWS_THRLD ? 1 : (int)min((unsigned)n, max(1u, thread::hardware_concurrency()))};
+
+        atomic<int> next_row{0};
+        vector<thread> workers;
+
+        for (int t = 1; t < n_threads; t++)
+            workers.push_back(thread(&TSPLIB_instance::fill_distance_rows_, this, cref(oracle), ref(next_row)));
+
+        fill_distance_rows_(oracle, next_row);
+
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    void TSPLIB_instance::fill_distance_rows_(const coord_distance_oracle &oracle, atomic<int> &next_row)
+    {
+        // Aligned, padded rows: the oracle fills each one contiguously
+        for (int i{next_row++}; i < dimension_; i = next_row++)
+            oracle.fill_row(i, distances_.row(i + 1));
+    }
+
+    bool TSPLIB_instance::has_coordinates(void) const
+    {
+        return (edge_weight_type_ > _EXPLICIT) && !coord_.empty() && distances_.get_n_rows() == 0;
+    }
+
+    void TSPLIB_instance::get_distance_oracle(coord_distance_oracle &oracle, const size_t n_cache_rows) const
+    {
+        oracle = coord_distance_oracle(edge_weight_type_, coord_, n_cache_rows);
     }
 
     int TSPLIB_instance::nint_(double x) const
@@ -687,15 +690,18 @@ namespace TSP
         os << "                                Optimal value allowing waiting    : " << setw(5) << optimal_values_[1] << endl;
     }
 
-    void TSPLIB_instance::read(const string &input_file)
+    void TSPLIB_instance::read(const string &input_file, ostream &os)
     {
+        if (read_mapped_(input_file, os))
+            return;
+
         const string temp_file{input_file + ".tmp"};
 
         clean_(input_file, temp_file);
 
         ifstream is(temp_file);
 
-        read_(is, cout);
+        read_(is, os);
 
         is.close();
 
@@ -734,7 +740,7 @@ namespace TSP
         }
     }
 
-    int TSPLIB_instance::find_key_(const string &token, const vector<string> keywrds) const
+    int TSPLIB_instance::find_key_(const string &token, const vector<string> &keywrds) const
     {
         const size_t key_num{keywrds.size()};
 
@@ -761,4 +767,309 @@ namespace TSP
             (this->*read_function_[k])(is, os);
         }
     }
-}
\ No newline at end of file
+
+    bool TSPLIB_instance::read_mapped_(const string &input_file, ostream &os)
+    {
+        TSPLIB_scanner sc;
+
+        if (!sc.open(input_file))
+            return false;
+
+        scan_(sc, os);
+
+        return true;
+    }
+
+    void TSPLIB_instance::scan_(TSPLIB_scanner &sc, ostream &os)
+    {
+        os << messages[0] << endl;
+
+        for (string_view token{sc.next_token()}; !token.empty(); token = sc.next_token())
+        {
+            const int k{find_key_(string(token), keywords)};
+
+            switch (k)
+            {
+            case 0:
+                name_ = string(sc.next_token());
+                os << "File                          : " << name_ << endl;
+                break;
+
+            case 1:
+                type_ = string(sc.next_token());
+                os << "Type                          : " << type_ << endl;
+                break;
+
+            case 2:
+                scan_comment_section_(sc, os);
+                break;
+
+            case 3:
+                dimension_ = sc.next_int();
+                establish_dimension_(dimension_);
+                os << "Dimension                     : " << dimension_ << endl;
+                break;
+
+            case 4:
+                scan_node_values_(sc, 2);
+                os << "Reading capacities            : " << dimension_ << endl;
+                break;
+
+            case 5:
+            {
+                const string s_token{sc.next_token()};
+                os << "Edge Weigh Type               : " << s_token << endl;
+                edge_weight_type_ = find_key_(s_token, wtypes);
+                break;
+            }
+
+            case 6:
+            {
+                const string s_token{sc.next_token()};
+                os << "Edge Weigh Format             : " << s_token << endl;
+                edge_weight_format_ = find_key_(s_token, wformats);
+                break;
+            }
+
+            case 7:
+            {
+                const string s_token{sc.next_token()};
+                os << "Display Data Type             : " << s_token << endl;
+                display_data_type_ = find_key_(s_token, dtypes);
+                break;
+            }
+
+            case 8:
+                scan_edge_weight_section_(sc, os);
+                break;
+
+            case 9:
+                scan_display_data_section_(sc, os);
+                break;
+
+            case 10:
+                scan_node_coord_section_(sc, os);
+                break;
+
+            case 11:
+                os << "Node Coord Type               : " << sc.next_token() << endl;
+                break;
+
+            case 12:
+                depot_ = sc.next_int();
+                os << "Depot                         : " << depot_ << endl;
+                sc.next_token();
+                break;
+
+            case 13:
+                scan_node_values_(sc, 2);
+                os << "Reading capacity volumes      : " << dimension_ << endl;
+                break;
+
+            case 14:
+                scan_demand_section_(sc, os);
+                break;
+
+            case 15:
+                scan_node_values_(sc, 3);
+                os << "Reading time windows          : " << dimension_ << endl;
+                break;
+
+            case 16:
+                scan_node_values_(sc, 2);
+                os << "Reading standtimes            : " << dimension_ << endl;
+                break;
+
+            case 17:
+                scan_node_values_(sc, 2);
+                os << "Reading pickups               : " << dimension_ << endl;
+                break;
+
+            case 18:
+                os << "EOF                           : " << sc.next_token() << endl;
+                os << endl;
+                break;
+
+            case 19:
+                os << "Number of trucks              : " << sc.next_int() << endl;
+                break;
+
+            case 20:
+                num_days_ = sc.next_int();
+                os << "Number of days                : " << num_days_ << endl;
+                break;
+
+            case 21:
+                max_distance_ = sc.next_int();
+                os << "Distance                      : " << max_distance_ << endl;
+                break;
+
+            case 22:
+                maximum_allowable_differencial_ = sc.next_int();
+                os << "Maximum allowable differential: " << maximum_allowable_differencial_ << endl;
+                break;
+
+            default:
+                cerr << "ERROR reading input file: unknown keyword " << token << endl;
+                exit(1);
+            }
+        }
+    }
+
+    void TSPLIB_instance::scan_comment_section_(TSPLIB_scanner &sc, ostream &os)
+    {
+        optimal_values_.assign(2, 0.0);
+
+        // "<value>, <value> ..." on the keyword line, as read_comment_section_
+        sc.try_double(optimal_values_[0]);
+
+        if (sc.skip_past(','))
+            sc.try_double(optimal_values_[1]);
+
+        sc.skip_line();
+
+        os << "Comment                       : " << "Optimal value not allowing waiting: " << setw(5) << optimal_values_[0] << endl;
+        os << "                                Optimal value allowing waiting    : " << setw(5) << optimal_values_[1] << endl;
+    }
+
+    void TSPLIB_instance::scan_edge_weight_section_(TSPLIB_scanner &sc, ostream &os)
+    {
+        if (edge_weight_type_ == -1)
+        {
+            cerr << "Edge weight type not defined" << endl;
+            exit(1);
+        }
+
+        if (edge_weight_format_ == -1)
+        {
+            cerr << "Edge weight format not defined" << endl;
+            exit(1);
+        }
+
+        if (edge_weight_type_ != _EXPLICIT)
+        {
+            cerr << "Edge weight type is not explicit" << endl;
+            exit(1);
+        }
+
+        const int n{dimension_};
+
+        distances_.resize(n, n);
+        distances_.fill(0.0);
+
+        if (edge_weight_format_ == 8)
+        {
+            for (int i{0}; i < n; i++)
+            {
+                double *d_i{distances_.row(i + 1)};
+
+                for (int j{0}; j < n; j++)
+                    d_i[j] = sc.next_int();
+            }
+        }
+        else
+        {
+            // Same row ranges as the edge_weight_reading_function_ table
+            const int f{edge_weight_format_};
+
+            for (int i{0}; i < n; i++)
+            {
+                const int first{f == 0 ? i + 1 : 0};
+                const int last{f == 0 ? n : ((f == 2) || (f == 3) || (f == 6) || (f == 7)) ? i + 1 : i};
+
+                double *d_i{distances_.row(i + 1)};
+
+                for (int j{first}; j < last; j++)
+                {
+                    const int k{sc.next_int()};
+
+                    d_i[j] = k;
+                    distances_(j + 1, i + 1) = k;
+                }
+            }
+        }
+
+        os << "Reading distances             : " << dimension_ << endl;
+    }
+
+    void TSPLIB_instance::scan_node_coord_section_(TSPLIB_scanner &sc, ostream &os)
+    {
+        if (edge_weight_type_ == -1)
+        {
+            cerr << "Edge weight type not defined" << endl;
+            exit(1);
+        }
+        else if (edge_weight_type_ == _EXPLICIT)
+        {
+            cerr << "Edge weight type is explicit" << endl;
+            exit(1);
+        }
+
+        for (int i = 0; i < dimension_; i++)
+        {
+            coord_id_[i] = sc.next_int();
+
+            const double x{sc.next_double()};
+            const double y{sc.next_double()};
+
+            coord_[i] = coordType(x, y);
+        }
+
+        if (!lazy_distances_)
+            compute_implicit_distance_matrix_();
+
+        os << "Reading coords                : " << dimension_ << endl;
+    }
+
+    void TSPLIB_instance::scan_display_data_section_(TSPLIB_scanner &sc, ostream &os)
+    {
+        if ((display_data_type_ == -1) || (display_data_type_ == 2))
+        {
+            cerr << "Display data type not defined" << endl;
+            exit(1);
+        }
+
+        for (int i = 0; i < dimension_; i++)
+        {
+            const int num{sc.next_int()};
+
+            const double x{sc.next_double()};
+            const double y{sc.next_double()};
+
+            display_id_[num - 1] = num;
+            display_[num - 1] = coordType(x, y);
+        }
+
+        os << "Reading coords                : " << dimension_ << endl;
+    }
+
+    void TSPLIB_instance::scan_demand_section_(TSPLIB_scanner &sc, ostream &os)
+    {
+        if (num_days_ == -1)
+        {
+            cerr << "Number of days not defined" << endl;
+            exit(1);
+        }
+
+        for (size_t i = 0; i < demand_.size(); i++)
+            demand_[i].resize(num_days_);
+
+        for (int i = 0; i < dimension_; i++)
+        {
+            vector<int> &demand_i{demand_[sc.next_int() - 1]};
+
+            for (int j = 0; j < num_days_; j++)
+                demand_i[j] = sc.next_int();
+        }
+
+        os << "Reading demands               : " << demand_.size() << endl;
+    }
+
+    void TSPLIB_instance::scan_node_values_(TSPLIB_scanner &sc, const int n_values)
+    {
+        const int n_skip{dimension_ * n_values};
+
+        for (int k = 0; k < n_skip; k++)
+            sc.next_double();
+    }
+}
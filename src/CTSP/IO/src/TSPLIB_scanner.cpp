@@ -0,0 +1,151 @@
+#include "TSPLIB_scanner.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace TSP
+{
+    TSPLIB_scanner::TSPLIB_scanner(void) : begin_(NULL), end_(NULL), pos_(NULL), size_(0)
+    {
+    }
+
+    TSPLIB_scanner::~TSPLIB_scanner(void)
+    {
+        if (size_ > 0)
+            munmap(const_cast<char *>(begin_), size_);
+    }
+
+    bool TSPLIB_scanner::open(const string &filename)
+    {
+        const int fd{::open(filename.c_str(), O_RDONLY)};
+
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+
+        if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size == 0))
+        {
+            close(fd);
+            return false;
+        }
+
+        void *addr{mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+        // The mapping stays valid after closing the descriptor
+        close(fd);
+
+        if (addr == MAP_FAILED)
+            return false;
+
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+        size_ = st.st_size;
+        begin_ = static_cast<const char *>(addr);
+        end_ = begin_ + size_;
+        pos_ = begin_;
+
+        return true;
+    }
+
+    void TSPLIB_scanner::skip_blanks_(void)
+    {
+        while ((pos_ < end_) && ((*pos_ == ' ') || (*pos_ == '\n') || (*pos_ == '\t') || (*pos_ == '\r') || (*pos_ == ':')))
+            pos_++;
+    }
+
+    string_view TSPLIB_scanner::next_token(void)
+    {
+        skip_blanks_();
+
+        const char *first{pos_};
+
+        while ((pos_ < end_) && (*pos_ != ' ') && (*pos_ != '\n') && (*pos_ != '\t') && (*pos_ != '\r') && (*pos_ != ':'))
+            pos_++;
+
+        return string_view(first, pos_ - first);
+    }
+
+    int TSPLIB_scanner::next_int(void)
+    {
+        skip_blanks_();
+
+        if ((pos_ < end_) && (*pos_ == '+'))
+            pos_++;
+
+        int val{0};
+
+        const from_chars_result res{from_chars(pos_, end_, val)};
+
+        if (res.ec != errc())
+            error_();
+
+        pos_ = res.ptr;
+
+        return val;
+    }
+
+    double TSPLIB_scanner::next_double(void)
+    {
+        skip_blanks_();
+
+        double val{0.0};
+
+        if (!parse_double_(val))
+            error_();
+
+        return val;
+    }
+
+    bool TSPLIB_scanner::try_double(double &val)
+    {
+        while ((pos_ < end_) && ((*pos_ == ' ') || (*pos_ == '\t') || (*pos_ == ':')))
+            pos_++;
+
+        return parse_double_(val);
+    }
+
+    bool TSPLIB_scanner::parse_double_(double &val)
+    {
+        const char *first{((pos_ < end_) && (*pos_ == '+')) ? pos_ + 1 : pos_};
+
+        const from_chars_result res{from_chars(first, end_, val)};
+
+        if (res.ec != errc())
+            return false;
+
+        pos_ = res.ptr;
+
+        return true;
+    }
+
+    bool TSPLIB_scanner::skip_past(const char c)
+    {
+        while ((pos_ < end_) && (*pos_ != '\n'))
+            if (*pos_++ == c)
+                return true;
+
+        return false;
+    }
+
+    void TSPLIB_scanner::skip_line(void)
+    {
+        while ((pos_ < end_) && (*pos_ != '\n'))
+            pos_++;
+    }
+
+    void TSPLIB_scanner::error_(void) const
+    {
+        const size_t line{(size_t)count(begin_, pos_, '\n') + 1};
+
+        cerr << "ERROR reading input file: number expected at line " << line << endl;
+        exit(1);
+    }
+}
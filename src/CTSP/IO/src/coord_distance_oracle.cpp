@@ -0,0 +1,175 @@
+#include "coord_distance_oracle.hpp"
+
+#include <iostream>
+#include <cmath>
+
+#include <stdlib.h>
+
+namespace TSP
+{
+    coord_distance_oracle::coord_distance_oracle(void) : edge_weight_type_(-1), n_(0), x_(), y_(), n_cache_rows_(0), cache_(), cache_row_()
+    {
+    }
+
+    coord_distance_oracle::coord_distance_oracle(const int edge_weight_type, const vector<pair<double, double>> &coord, const size_t n_cache_rows) : edge_weight_type_(edge_weight_type),
+                                                                                                                                                      n_((int)coord.size()),
+                                                                                                                                                      x_(coord.size()),
+                                                                                                                                                      y_(coord.size()),
+                                                                                                                                                      n_cache_rows_(0),
+                                                                                                                                                      cache_(),
+                                                                                                                                                      cache_row_()
+    {
+        if ((edge_weight_type_ != _EUC_2D) && (edge_weight_type_ != _MAX_2D) && (edge_weight_type_ != _MAN_2D) &&
+            (edge_weight_type_ != _CEIL_2D) && (edge_weight_type_ != _GEO) && (edge_weight_type_ != _ATT))
+        {
+            cerr << "Edge weight type not supported" << endl;
+            exit(1);
+        }
+
+        // Structure of arrays, so that the row kernels vectorize
+        for (int i = 0; i < n_; i++)
+        {
+            if (edge_weight_type_ == _GEO)
+            {
+                // Same conversion as TSPLIB_instance::radian_coords_
+                const double x{coord[i].first};
+                const double deg_x{(double)(int)x};
+
+                x_[i] = TSPLIB_PI * (deg_x + 5.0 * (x - deg_x) / 3.0) / 180.0;
+
+                const double y{coord[i].second};
+                const double deg_y{(double)(int)y};
+
+                y_[i] = TSPLIB_PI * (deg_y + 5.0 * (y - deg_y) / 3.0) / 180.0;
+            }
+            else
+            {
+                x_[i] = coord[i].first;
+                y_[i] = coord[i].second;
+            }
+        }
+
+        set_cache_rows(n_cache_rows);
+    }
+
+    coord_distance_oracle::~coord_distance_oracle(void)
+    {
+    }
+
+    void coord_distance_oracle::set_cache_rows(const size_t n_cache_rows)
+    {
+        n_cache_rows_ = n_cache_rows < (size_t)n_ ? n_cache_rows : n_;
+
+        cache_.assign(n_cache_rows_ * n_, 0.0);
+        cache_row_.assign(n_cache_rows_, -1);
+    }
+
+    double coord_distance_oracle::operator()(size_t i, size_t j) const
+    {
+        if (i == j)
+            return 100000000.0;
+
+        const int r{(int)i - 1};
+        const int c{(int)j - 1};
+
+        if (n_cache_rows_ == 0)
+        {
+            double d;
+            fill_range_(r, c, c + 1, &d);
+
+            return d;
+        }
+
+        const size_t slot{(size_t)r % n_cache_rows_};
+        double *row{&cache_[slot * n_]};
+
+        if (cache_row_[slot] != r)
+        {
+            fill_row(r, row);
+            cache_row_[slot] = r;
+        }
+
+        return row[c];
+    }
+
+    void coord_distance_oracle::fill_range_(const int i, const int first, const int last, double *out) const
+    {
+        const int n{last - first};
+
+        const double x_i{x_[i]};
+        const double y_i{y_[i]};
+
+        const double *x{&x_[first]};
+        const double *y{&y_[first]};
+
+        // Same expressions as the TSPLIB_instance::compute_*_distance_ functions
+        switch (edge_weight_type_)
+        {
+        case _EUC_2D:
+            for (int j = 0; j < n; j++)
+            {
+                const double xd{x_i - x[j]};
+                const double yd{y_i - y[j]};
+
+                out[j] = (int)(sqrt(xd * xd + yd * yd) + 0.5);
+            }
+            break;
+
+        case _MAX_2D:
+            for (int j = 0; j < n; j++)
+            {
+                const int xd{(int)(fabs(x_i - x[j]) + 0.5)};
+                const int yd{(int)(fabs(y_i - y[j]) + 0.5)};
+
+                out[j] = xd > yd ? xd : yd;
+            }
+            break;
+
+        case _MAN_2D:
+            for (int j = 0; j < n; j++)
+                out[j] = (int)(fabs(x_i - x[j]) + fabs(y_i - y[j]) + 0.5);
+            break;
+
+        case _CEIL_2D:
+            for (int j = 0; j < n; j++)
+            {
+                const double xd{x_i - x[j]};
+                const double yd{y_i - y[j]};
+
+                out[j] = ceil(sqrt(xd * xd + yd * yd));
+            }
+            break;
+
+        case _GEO:
+        {
+            const double RRR{6378.388};
+
+            // x: latitude, y: longitude
+            for (int j = 0; j < n; j++)
+            {
+                const double q1{cos(y_i - y[j])};
+                const double q2{cos(x_i - x[j])};
+                const double q3{cos(x_i + x[j])};
+
+                const double acos_arg{0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)};
+
+                out[j] = (int)(RRR * acos(acos_arg) + 1.0);
+            }
+            break;
+        }
+
+        case _ATT:
+            for (int j = 0; j < n; j++)
+            {
+                const double xd{x_i - x[j]};
+                const double yd{y_i - y[j]};
+
+                const double rij{sqrt((xd * xd + yd * yd) / 10.0)};
+                const double tij{(double)(int)(rij + 0.5)};
+
+                out[j] = (tij < rij) ? tij + 1.0 : tij;
+            }
+            break;
+        }
+    }
+}
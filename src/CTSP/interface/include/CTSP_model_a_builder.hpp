@@ -14,6 +14,7 @@
 #pragma once
 
 #include "sync_model_a_builder.hpp"
+#include "sync_model_family.hpp"
 #include "CTSP_instance.hpp"
 
 /// Sentinel value indicating max_distance constraint is not set
@@ -78,6 +79,8 @@ namespace CTSP
              * @brief Construct model builder from CTSP instance
              * @param problem_type Problem variant (CTSP1 or CTSP2)
              * @param instance CTSP instance data
+             * @param pruning Routing arcs left out of the model (default: none)
+             * @param n_threads Threads building the model (default 1, 0: one per core)
              * 
              * @note Automatically extracts all necessary data from instance
              * @note Sets n_depots based on problem_type:
@@ -85,12 +88,25 @@ namespace CTSP
              *       - CTSP2: n_depots = n_days (one depot per day/vehicle)
              */
             CTSP_model_a_builder(const CTSP::CTSP_problem_type &problem_type, 
-                                 const CTSP::instance &instance);
+                                 const CTSP::instance &instance,
+                                 const SYNC_LIB::arc_pruning &pruning = SYNC_LIB::arc_pruning(),
+                                 const size_t n_threads = 1);
             
             /**
              * @brief Destructor
              */
             virtual ~CTSP_model_a_builder(void);
+
+            /**
+             * @brief Routing structure key of an instance (SYNC_LIB::sync_model_family)
+             * @param problem_type Problem variant (CTSP1 or CTSP2)
+             * @param instance CTSP instance data
+             * @param pruning Routing arcs left out of the model
+             * @return Same key for instances that only differ in T
+             */
+            static uint64_t structure_key(const CTSP::CTSP_problem_type &problem_type,
+                                          const CTSP::instance &instance,
+                                          const SYNC_LIB::arc_pruning &pruning = SYNC_LIB::arc_pruning());
     };
 
     /**
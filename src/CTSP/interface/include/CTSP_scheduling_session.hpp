@@ -0,0 +1,53 @@
+/**
+ * @file CTSP_scheduling_session.hpp
+ * @brief Scheduling session built from an in-memory CTSP instance
+ *
+ * Embeddable entry point: a caller holding a CTSP::instance (read once at
+ * startup) checks routings through it without spawning ctsp_scheduler nor
+ * touching the filesystem.
+ */
+
+#pragma once
+
+#include "scheduling_session.hpp"
+#include "CTSP_model_a_builder.hpp"
+#include "CTSP_instance.hpp"
+
+namespace CTSP
+{
+    /**
+     * @class CTSP_scheduling_session
+     * @brief scheduling_session over the CTSP_model_a_builder of an instance
+     *
+     * ```cpp
+     * CTSP::instance instance;
+     * instance.read("bayg29_p5_f90_lL.contsp");
+     *
+     * CTSP::CTSP_scheduling_session session(instance);
+     *
+     * if (session.check(routes))               // vector<vector<int>>, one route per depot
+     *     schedule = session.get_schedule();
+     * else
+     *     cycles = session.get_violated_cycles();
+     * ```
+     *
+     * The instance is only read during construction.
+     */
+    class CTSP_scheduling_session : public SYNC_LIB::scheduling_session
+    {
+    public:
+        /**
+         * @brief Build the model and the converter of an instance
+         * @param instance CTSP instance data
+         * @param problem_type Problem variant (CTSP2 is the one scheduled by ctsp_scheduler)
+         * @param tol Numerical tolerance of the checkers
+         * @param engine Verification engine (fractional x always uses the LP)
+         */
+        CTSP_scheduling_session(const CTSP::instance &instance,
+                                const CTSP::CTSP_problem_type &problem_type = CTSP::CTSP_problem_type::CTSP2,
+                                const double tol = 1e-6,
+                                const SYNC_LIB::sync_engine engine = SYNC_LIB::sync_engine::LP);
+
+        virtual ~CTSP_scheduling_session(void);
+    };
+}
@@ -2,9 +2,14 @@
 
 namespace CTSP
 {
-    CTSP_model_a_builder::CTSP_model_a_builder(const CTSP::CTSP_problem_type &problem_type, const CTSP::instance &instance) : SYNC_LIB::sync_model_a_builder(problem_type == CTSP::CTSP_problem_type::CTSP1?1:2,instance.get_instance_name(), 1, instance.get_n_days(), instance.get_n_customers(), instance.get_demands(), instance.get_max_distance(), instance.get_T(), instance.get_distances(), instance.triangle_inequality())
+    CTSP_model_a_builder::CTSP_model_a_builder(const CTSP::CTSP_problem_type &problem_type, const CTSP::instance &instance, const SYNC_LIB::arc_pruning &pruning, const size_t n_threads) : SYNC_LIB::sync_model_a_builder(problem_type == CTSP::CTSP_problem_type::CTSP1?1:2,instance.get_instance_name(), 1, instance.get_n_days(), instance.get_n_customers(), instance.get_demands(), instance.get_max_distance(), instance.get_T(), instance.get_distance_oracle(), instance.triangle_inequality(), pruning, n_threads)
     {
     }
 
     CTSP_model_a_builder::~CTSP_model_a_builder(void) {}
+
+    uint64_t CTSP_model_a_builder::structure_key(const CTSP::CTSP_problem_type &problem_type, const CTSP::instance &instance, const SYNC_LIB::arc_pruning &pruning)
+    {
+        return SYNC_LIB::sync_model_family::structure_key(problem_type == CTSP::CTSP_problem_type::CTSP1 ? 1 : 2, instance.get_n_days(), instance.get_n_customers(), instance.get_demands(), instance.get_max_distance(), instance.get_distance_oracle(), instance.triangle_inequality(), pruning);
+    }
 }
\ No newline at end of file
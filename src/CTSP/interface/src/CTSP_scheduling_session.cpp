@@ -0,0 +1,10 @@
+#include "CTSP_scheduling_session.hpp"
+
+namespace CTSP
+{
+    CTSP_scheduling_session::CTSP_scheduling_session(const CTSP::instance &instance, const CTSP::CTSP_problem_type &problem_type, const double tol, const SYNC_LIB::sync_engine engine) : SYNC_LIB::scheduling_session(unique_ptr<SYNC_LIB::sync_model_a_builder>(new CTSP_model_a_builder(problem_type, instance)), tol, engine)
+    {
+    }
+
+    CTSP_scheduling_session::~CTSP_scheduling_session(void) {}
+}
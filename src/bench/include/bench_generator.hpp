@@ -0,0 +1,138 @@
+/**
+ * @file bench_generator.hpp
+ * @brief Random CTSP2 instances and solutions for ctsp_bench
+ *
+ * Generated instances use integer coordinates and MAN_2D distances, so
+ * the distance matrix satisfies the triangle inequality exactly. Two
+ * solutions are built for each instance:
+ *
+ * - **Consistent**: every day visits its customers in the same (angular)
+ *   order around the depot. With waiting allowed, each visit can start at
+ *   the time of the full tour, so the solution is always synchronizable
+ *   (exercises the schedule and JSON stages).
+ * - **Shuffled**: every day visits its customers in an independent random
+ *   order. With a small differential this is (almost surely) infeasible
+ *   (exercises path_finder and the DOT stage).
+ * - **Infeasible**: the consistent routes with two customers of two days
+ *   visited in opposite orders. When the two customers are farther apart
+ *   than the differential, this is infeasible whatever the waits: one of
+ *   them would need a visit window wider than the differential.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace std;
+
+namespace BENCH
+{
+    /**
+     * @class bench_generator
+     * @brief Random CTSP2 instance with one consistent and one shuffled solution
+     *
+     * ```cpp
+     * bench_generator generator(1);
+     * generator.generate(50, 3, 0.5, 10);
+     *
+     * ofstream ins_file("bench_n50_p3.contsp");
+     * generator.write_instance(ins_file);
+     * ```
+     */
+    class bench_generator
+    {
+    private:
+        mt19937 rng_; ///< Random number generator
+
+        string name_;                  ///< Instance name
+        size_t n_customers_;           ///< Number of customers (depot excluded)
+        size_t n_days_;                ///< Number of days
+        double max_differential_;      ///< MAXIMUM_ALLOWABLE_DIFFERENTIAL
+        vector<pair<int, int>> coord_; ///< Node coordinates (depot first)
+        vector<vector<int>> demands_;  ///< demands_[i][d] = 1 if node i + 1 is visited on day d, -1 otherwise
+
+    public:
+        /**
+         * @brief Construct generator
+         * @param seed Random seed (same seed, same instances)
+         */
+        bench_generator(size_t seed);
+
+        virtual ~bench_generator(void);
+
+        /**
+         * @brief Draw a new instance
+         * @param n_customers Number of customers
+         * @param n_days Number of days (depots in CTSP2)
+         * @param frequency Probability that a customer is visited on a day
+         * @param max_differential Maximum allowable differential (time window width)
+         *
+         * Every customer is visited on at least one day.
+         */
+        void generate(size_t n_customers, size_t n_days, double frequency, double max_differential);
+
+        /**
+         * @brief Write the instance in .contsp format
+         * @param os Output stream
+         */
+        ostream &write_instance(ostream &os) const;
+
+        /**
+         * @brief Routes visiting the customers of each day in angular order
+         * @param routes [out] One route per day, 1-based nodes, depot at both ends
+         */
+        void consistent_routes(vector<vector<int>> &routes) const;
+
+        /**
+         * @brief Routes visiting the customers of each day in random order
+         * @param routes [out] One route per day, 1-based nodes, depot at both ends
+         */
+        void shuffled_routes(vector<vector<int>> &routes);
+
+        /**
+         * @brief Consistent routes with one pair of customers swapped on one day
+         * @param routes [out] One route per day, 1-based nodes, depot at both ends
+         * @return true if the routes are infeasible for sure (the farthest pair
+         *         of customers sharing two days is farther apart than the
+         *         differential); false if no such pair exists (the routes are
+         *         then the consistent ones)
+         */
+        bool infeasible_routes(vector<vector<int>> &routes) const;
+
+        /**
+         * @brief Get instance name
+         * @return Name ("bench_n<customers>_p<days>")
+         */
+        inline const string &get_name(void) const { return name_; }
+
+        /**
+         * @brief Get number of customers
+         * @return Number of customers
+         */
+        inline size_t get_n_customers(void) const { return n_customers_; }
+
+        /**
+         * @brief Get number of days
+         * @return Number of days
+         */
+        inline size_t get_n_days(void) const { return n_days_; }
+
+    private:
+        /**
+         * @brief MAN_2D distance between two nodes
+         * @param a 1-based node id
+         * @param b 1-based node id
+         */
+        int distance_(int a, int b) const;
+
+        /**
+         * @brief Customers visited on a day, in angular order around the depot
+         * @param day Day index
+         * @param customers [out] 1-based node ids
+         */
+        void day_customers_(size_t day, vector<int> &customers) const;
+    };
+}
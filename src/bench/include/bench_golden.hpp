@@ -0,0 +1,117 @@
+/**
+ * @file bench_golden.hpp
+ * @brief Golden results of a ctsp_bench run, for regression checks
+ *
+ * A golden file keeps, for every benchmarked instance, the outcome of each
+ * solution (feasible or not, number of violated cycles found) and the
+ * median time of each stage. A later run on the same generated instances
+ * (same sizes, parameters and seed) is checked against it: a different
+ * outcome, or a stage slower than the tolerance allows, is a regression.
+ *
+ * Outcomes are portable; timings only compare on the machine (and build)
+ * that wrote the file.
+ *
+ * File format, one record per line (`#` starts a comment):
+ *
+ * ```
+ * result <instance> <solution> <instance_key> <solution_key> <feasible> <n_cycles>
+ * time <instance> <stage> <p50>
+ * ```
+ *
+ * Keys are the FNV-1a hashes of the file contents
+ * (sync_model_cache::instance_key), so a generator change is reported as
+ * such rather than as a wrong outcome.
+ */
+
+#pragma once
+
+#include "bench_stats.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace BENCH
+{
+    /**
+     * @class bench_outcome
+     * @brief Result of scheduling one solution (first repetition)
+     */
+    class bench_outcome
+    {
+    public:
+        string solution_;       ///< Solution label (e.g. "consistent")
+        uint64_t instance_key_; ///< Hash of the instance file
+        uint64_t solution_key_; ///< Hash of the solution file
+        bool feasible_;         ///< conTSP2_scheduling::solve result
+        size_t n_cycles_;       ///< Violated cycles found by find_paths (0 if feasible)
+
+        bench_outcome(void) : solution_(), instance_key_(0), solution_key_(0), feasible_(false), n_cycles_(0) {}
+
+        virtual ~bench_outcome(void) {}
+    };
+
+    /**
+     * @class bench_golden
+     * @brief Outcomes and stage medians of a run, written to or checked against a file
+     *
+     * ```cpp
+     * bench_golden golden;
+     *
+     * if (!golden.read("golden.txt"))
+     *     ...
+     *
+     * const size_t n_failed{golden.check(report, outcomes, 2.0, cerr)};
+     * ```
+     */
+    class bench_golden
+    {
+    private:
+        map<string, bench_outcome> outcomes_; ///< Outcomes by "<instance> <solution>"
+        map<string, double> times_;           ///< Stage medians (s) by "<instance> <stage>"
+
+    public:
+        bench_golden(void);
+
+        virtual ~bench_golden(void);
+
+        /**
+         * @brief Record the outcomes and stage medians of one instance
+         * @param report Stage samples of the instance
+         * @param outcomes Outcome of each solution of the instance
+         */
+        void add(const bench_report &report, const vector<bench_outcome> &outcomes);
+
+        /**
+         * @brief Write the recorded results
+         * @param file_name Golden file
+         * @return false if the file cannot be written
+         */
+        bool write(const string &file_name) const;
+
+        /**
+         * @brief Load a golden file
+         * @param file_name Golden file
+         * @return false if the file cannot be read or a line is malformed
+         *         (reported on cerr)
+         */
+        bool read(const string &file_name);
+
+        /**
+         * @brief Check one instance against the loaded results
+         * @param report Stage samples of the instance
+         * @param outcomes Outcome of each solution of the instance
+         * @param time_tolerance Largest allowed ratio of a stage median to
+         *        its golden median (below 1 ms of difference, any ratio passes)
+         * @param log Stream for the regressions found
+         * @return Number of regressions (instances and stages missing from
+         *         the golden file are reported but not counted)
+         */
+        size_t check(const bench_report &report, const vector<bench_outcome> &outcomes,
+                     double time_tolerance, ostream &log) const;
+    };
+}
@@ -0,0 +1,142 @@
+/**
+ * @file bench_stats.hpp
+ * @brief Stage timers and percentile reports for ctsp_bench
+ *
+ * Every pipeline stage keeps the wall-clock samples of its repetitions.
+ * Reports give count, min, percentiles (p50, p90, p99), max and mean per
+ * stage, as CSV rows or JSON objects, so runs can be compared by scripts.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+
+using namespace std;
+
+namespace BENCH
+{
+    /**
+     * @class stage_samples
+     * @brief Timing samples (seconds) of one pipeline stage
+     */
+    class stage_samples
+    {
+    public:
+        string name_;            ///< Stage name (e.g. "builder")
+        vector<double> samples_; ///< One wall-clock time per repetition
+
+        stage_samples(const string &name) : name_(name), samples_() {}
+
+        virtual ~stage_samples(void) {}
+
+        /**
+         * @brief Percentile by linear interpolation between closest ranks
+         * @param sorted Samples in ascending order (not empty)
+         * @param p Percentile in [0, 100]
+         * @return Interpolated value
+         */
+        static double percentile(const vector<double> &sorted, double p);
+    };
+
+    /**
+     * @class bench_report
+     * @brief Timing samples of every stage for one benchmarked instance
+     *
+     * ```cpp
+     * bench_report report("bench_n50", 50, 3);
+     *
+     * for (size_t r{0}; r < reps; r++)
+     * {
+     *     bench_timer timer(report.stage("builder"));
+     *     CTSP::CTSP_model_a_builder builder(CTSP::CTSP_problem_type::CTSP2, I);
+     * }
+     *
+     * report.write_csv(cout);
+     * ```
+     */
+    class bench_report
+    {
+    private:
+        string instance_name_;         ///< Benchmarked instance
+        size_t n_customers_;           ///< Number of customers
+        size_t n_days_;                ///< Number of days (depots)
+        deque<stage_samples> stages_;  ///< Stages, in first-use order (stable references)
+
+    public:
+        bench_report(const string &instance_name, size_t n_customers, size_t n_days);
+
+        virtual ~bench_report(void);
+
+        /**
+         * @brief Samples of a stage (created on first use)
+         * @param name Stage name
+         * @return Samples of the stage
+         */
+        stage_samples &stage(const string &name);
+
+        /**
+         * @brief Percentile of a stage
+         * @param name Stage name
+         * @param p Percentile in [0, 100]
+         * @param value [out] Percentile in seconds
+         * @return false if the stage has no samples
+         */
+        bool get_percentile(const string &name, double p, double &value) const;
+
+        /**
+         * @brief Names of the stages with samples, in first-use order
+         * @param names [out] Stage names
+         */
+        void get_stage_names(vector<string> &names) const;
+
+        /**
+         * @brief Get instance name
+         * @return Benchmarked instance
+         */
+        inline const string &get_instance_name(void) const { return instance_name_; }
+
+        /**
+         * @brief Write the CSV header line
+         * @param os Output stream
+         */
+        static ostream &write_csv_header(ostream &os);
+
+        /**
+         * @brief Write one CSV line per stage with samples
+         * @param os Output stream
+         */
+        ostream &write_csv(ostream &os) const;
+
+        /**
+         * @brief Write the report as one JSON object
+         * @param os Output stream
+         */
+        ostream &write_json(ostream &os) const;
+    };
+
+    /**
+     * @class bench_timer
+     * @brief Scoped timer: adds one sample to a stage when destroyed
+     */
+    class bench_timer
+    {
+    private:
+        typedef chrono::steady_clock clock_type;
+
+        stage_samples &stage_;               ///< Stage receiving the sample
+        const clock_type::time_point start_; ///< Construction time
+
+    public:
+        bench_timer(stage_samples &stage) : stage_(stage), start_(clock_type::now()) {}
+
+        virtual ~bench_timer(void)
+        {
+            const chrono::duration<double> elapsed{clock_type::now() - start_};
+            stage_.samples_.push_back(elapsed.count());
+        }
+    };
+}
@@ -0,0 +1,246 @@
+/**
+ * @file bench_generator.cpp
+ * @brief Implementation of the random CTSP2 instance generator
+ */
+
+#include "bench_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#define BENCH_GRID_SIZE 1000
+
+// Largest route duration below the "unbounded" threshold (1E6) of the
+// checkers, so the duration arcs between depots keep their real value
+#define BENCH_MAX_DISTANCE 999999
+
+namespace BENCH
+{
+    bench_generator::bench_generator(const size_t seed) : rng_((unsigned int)seed),
+                                                          name_(),
+                                                          n_customers_(0),
+                                                          n_days_(0),
+                                                          max_differential_(0),
+                                                          coord_(),
+                                                          demands_()
+    {
+    }
+
+    bench_generator::~bench_generator(void)
+    {
+    }
+
+    void bench_generator::generate(const size_t n_customers, const size_t n_days, const double frequency, const double max_differential)
+    {
+        n_customers_ = n_customers;
+        n_days_ = n_days;
+        max_differential_ = max_differential;
+
+        name_ = "bench_n" + to_string(n_customers) + "_p" + to_string(n_days);
+
+        uniform_int_distribution<int> coord_dist(0, BENCH_GRID_SIZE - 1);
+        uniform_real_distribution<double> visit_dist(0.0, 1.0);
+        uniform_int_distribution<size_t> day_dist(0, n_days - 1);
+
+        const size_t n_nodes{n_customers + 1};
+
+        coord_.resize(n_nodes);
+
+        // Depot in the middle of the grid
+        coord_[0] = make_pair(BENCH_GRID_SIZE / 2, BENCH_GRID_SIZE / 2);
+
+        for (size_t i{1}; i < n_nodes; i++)
+        {
+            const int x{coord_dist(rng_)};
+            const int y{coord_dist(rng_)};
+
+            coord_[i] = make_pair(x, y);
+        }
+
+        demands_.assign(n_nodes, vector<int>(n_days, -1));
+        fill(demands_[0].begin(), demands_[0].end(), 1);
+
+        for (size_t i{1}; i < n_nodes; i++)
+        {
+            bool visited{false};
+
+            for (size_t d{0}; d < n_days; d++)
+            {
+                if (visit_dist(rng_) < frequency)
+                {
+                    demands_[i][d] = 1;
+                    visited = true;
+                }
+            }
+
+            if (!visited)
+                demands_[i][day_dist(rng_)] = 1;
+        }
+    }
+
+    ostream &bench_generator::write_instance(ostream &os) const
+    {
+        const size_t n_nodes{n_customers_ + 1};
+
+        os << "NAME: " << name_ << endl;
+        os << "TYPE: CONTSP" << endl;
+        os << "COMMENT: 0 (optimal value not allowing waiting), 0 (optimal value allowing waiting)" << endl;
+        os << "DIMENSION: " << n_nodes << endl;
+        os << "NUM_DAYS: " << n_days_ << endl;
+        os << "DISTANCE: " << BENCH_MAX_DISTANCE << endl;
+        os << "MAXIMUM_ALLOWABLE_DIFFERENTIAL: " << max_differential_ << endl;
+        os << "EDGE_WEIGHT_TYPE: MAN_2D" << endl;
+        os << "NODE_COORD_SECTION" << endl;
+
+        for (size_t i{0}; i < n_nodes; i++)
+            os << i + 1 << " " << coord_[i].first << " " << coord_[i].second << endl;
+
+        os << "DEMAND_SECTION" << endl;
+
+        for (size_t i{0}; i < n_nodes; i++)
+        {
+            os << i + 1;
+
+            for (size_t d{0}; d < n_days_; d++)
+                os << " " << demands_[i][d];
+
+            os << endl;
+        }
+
+        os << "DEPOT_SECTION" << endl;
+        os << 1 << endl;
+        os << -1 << endl;
+        os << "EOF" << endl;
+
+        return os;
+    }
+
+    int bench_generator::distance_(const int a, const int b) const
+    {
+        const pair<int, int> &coord_a{coord_[a - 1]};
+        const pair<int, int> &coord_b{coord_[b - 1]};
+
+        return abs(coord_a.first - coord_b.first) + abs(coord_a.second - coord_b.second);
+    }
+
+    void bench_generator::day_customers_(const size_t day, vector<int> &customers) const
+    {
+        customers.clear();
+
+        for (size_t i{1}; i <= n_customers_; i++)
+        {
+            if (demands_[i][day] > 0)
+                customers.push_back((int)i + 1);
+        }
+
+        const pair<int, int> &depot{coord_[0]};
+
+        // Node ids are 1-based: node a has coordinates coord_[a - 1]
+        sort(customers.begin(), customers.end(),
+             [&](const int a, const int b)
+             {
+                 const double angle_a{atan2(coord_[a - 1].second - depot.second, coord_[a - 1].first - depot.first)};
+                 const double angle_b{atan2(coord_[b - 1].second - depot.second, coord_[b - 1].first - depot.first)};
+
+                 return angle_a < angle_b || (angle_a == angle_b && a < b);
+             });
+    }
+
+    void bench_generator::consistent_routes(vector<vector<int>> &routes) const
+    {
+        routes.resize(n_days_);
+
+        vector<int> customers;
+
+        for (size_t d{0}; d < n_days_; d++)
+        {
+            day_customers_(d, customers);
+
+            routes[d].clear();
+            routes[d].push_back(1);
+            routes[d].insert(routes[d].end(), customers.begin(), customers.end());
+            routes[d].push_back(1);
+        }
+    }
+
+    void bench_generator::shuffled_routes(vector<vector<int>> &routes)
+    {
+        routes.resize(n_days_);
+
+        vector<int> customers;
+
+        for (size_t d{0}; d < n_days_; d++)
+        {
+            day_customers_(d, customers);
+            shuffle(customers.begin(), customers.end(), rng_);
+
+            routes[d].clear();
+            routes[d].push_back(1);
+            routes[d].insert(routes[d].end(), customers.begin(), customers.end());
+            routes[d].push_back(1);
+        }
+    }
+
+    bool bench_generator::infeasible_routes(vector<vector<int>> &routes) const
+    {
+        consistent_routes(routes);
+
+        // Arrival times a (day d) and b (day e) of customers i and j visited
+        // i before j on day d and j before i on day e:
+        //   (b_i - a_i) + (a_j - b_j) >= 2 distance(i, j),
+        // so one of the two windows exceeds the differential when
+        // distance(i, j) > max_differential_
+        int best_distance{-1};
+        size_t best_day{0};
+        size_t best_i{0};
+        size_t best_j{0};
+
+        vector<size_t> position(n_customers_ + 2);
+
+        for (size_t d{1}; d < n_days_; d++)
+        {
+            const vector<int> &route{routes[d]};
+
+            for (size_t k{1}; k + 1 < route.size(); k++)
+                position[route[k]] = k;
+
+            for (size_t e{0}; e < d; e++)
+            {
+                for (size_t k{1}; k + 1 < routes[e].size(); k++)
+                {
+                    const int i{routes[e][k]};
+
+                    if (demands_[i - 1][d] < 0)
+                        continue;
+
+                    for (size_t l{k + 1}; l + 1 < routes[e].size(); l++)
+                    {
+                        const int j{routes[e][l]};
+
+                        if (demands_[j - 1][d] < 0)
+                            continue;
+
+                        const int c_distance{distance_(i, j)};
+
+                        if (c_distance > best_distance)
+                        {
+                            best_distance = c_distance;
+                            best_day = d;
+                            best_i = position[i];
+                            best_j = position[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        if (best_distance < 0 || best_distance <= max_differential_)
+            return false;
+
+        // Consistent routes share the angular order: swapping reverses the pair on one day
+        swap(routes[best_day][best_i], routes[best_day][best_j]);
+
+        return true;
+    }
+}
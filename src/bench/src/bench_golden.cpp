@@ -0,0 +1,216 @@
+/**
+ * @file bench_golden.cpp
+ * @brief Implementation of the golden results of ctsp_bench
+ */
+
+#include "bench_golden.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+// Stage time differences below this (s) are timer noise, whatever the ratio
+#define BENCH_TIME_FLOOR 1E-3
+
+namespace BENCH
+{
+    bench_golden::bench_golden(void) : outcomes_(),
+                                       times_()
+    {
+    }
+
+    bench_golden::~bench_golden(void)
+    {
+    }
+
+    void bench_golden::add(const bench_report &report, const vector<bench_outcome> &outcomes)
+    {
+        const string &instance{report.get_instance_name()};
+
+        for (const bench_outcome &outcome : outcomes)
+            outcomes_[instance + " " + outcome.solution_] = outcome;
+
+        vector<string> stages;
+        report.get_stage_names(stages);
+
+        for (const string &stage : stages)
+        {
+            double p50{0};
+            report.get_percentile(stage, 50, p50);
+
+            times_[instance + " " + stage] = p50;
+        }
+    }
+
+    bool bench_golden::write(const string &file_name) const
+    {
+        ofstream file(file_name);
+
+        if (!file)
+            return false;
+
+        file << "# ctsp_bench golden results" << endl;
+        file << "# result <instance> <solution> <instance_key> <solution_key> <feasible> <n_cycles>" << endl;
+        file << "# time <instance> <stage> <p50>" << endl;
+
+        for (const pair<const string, bench_outcome> &c_outcome : outcomes_)
+        {
+            const bench_outcome &outcome{c_outcome.second};
+
+            file << "result " << c_outcome.first << hex
+                 << " " << outcome.instance_key_
+                 << " " << outcome.solution_key_ << dec
+                 << " " << (outcome.feasible_ ? 1 : 0)
+                 << " " << outcome.n_cycles_ << endl;
+        }
+
+        file << scientific << setprecision(6);
+
+        for (const pair<const string, double> &c_time : times_)
+            file << "time " << c_time.first << " " << c_time.second << endl;
+
+        return bool(file);
+    }
+
+    bool bench_golden::read(const string &file_name)
+    {
+        ifstream file(file_name);
+
+        if (!file)
+        {
+            cerr << "ERROR: Cannot open golden file " << file_name << endl;
+            return false;
+        }
+
+        outcomes_.clear();
+        times_.clear();
+
+        string line;
+        size_t n_line{0};
+
+        while (getline(file, line))
+        {
+            n_line++;
+
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            istringstream is(line);
+
+            string kind;
+            string instance;
+            string name;
+
+            is >> kind >> instance >> name;
+
+            if (kind == "result")
+            {
+                bench_outcome outcome;
+                int feasible{0};
+
+                outcome.solution_ = name;
+                is >> hex >> outcome.instance_key_ >> outcome.solution_key_ >> dec >> feasible >> outcome.n_cycles_;
+                outcome.feasible_ = feasible != 0;
+
+                if (is.fail())
+                {
+                    cerr << "ERROR: " << file_name << ":" << n_line << ": malformed result line" << endl;
+                    return false;
+                }
+
+                outcomes_[instance + " " + name] = outcome;
+            }
+            else if (kind == "time")
+            {
+                double p50{0};
+                is >> p50;
+
+                if (is.fail())
+                {
+                    cerr << "ERROR: " << file_name << ":" << n_line << ": malformed time line" << endl;
+                    return false;
+                }
+
+                times_[instance + " " + name] = p50;
+            }
+            else
+            {
+                cerr << "ERROR: " << file_name << ":" << n_line << ": unknown record " << kind << endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    size_t bench_golden::check(const bench_report &report, const vector<bench_outcome> &outcomes,
+                               const double time_tolerance, ostream &log) const
+    {
+        const string &instance{report.get_instance_name()};
+
+        size_t n_failed{0};
+
+        for (const bench_outcome &outcome : outcomes)
+        {
+            const string key{instance + " " + outcome.solution_};
+
+            const map<string, bench_outcome>::const_iterator it{outcomes_.find(key)};
+
+            if (it == outcomes_.end())
+            {
+                log << "NOTE: " << key << ": no golden result" << endl;
+                continue;
+            }
+
+            const bench_outcome &golden{it->second};
+
+            if (golden.instance_key_ != outcome.instance_key_ || golden.solution_key_ != outcome.solution_key_)
+            {
+                log << "REGRESSION: " << key << ": generated files differ from the golden ones" << endl;
+                n_failed++;
+            }
+            else if (golden.feasible_ != outcome.feasible_)
+            {
+                log << "REGRESSION: " << key << ": " << (outcome.feasible_ ? "feasible" : "infeasible")
+                    << ", golden " << (golden.feasible_ ? "feasible" : "infeasible") << endl;
+                n_failed++;
+            }
+            else if (golden.n_cycles_ != outcome.n_cycles_)
+            {
+                log << "REGRESSION: " << key << ": " << outcome.n_cycles_ << " violated cycles, golden "
+                    << golden.n_cycles_ << endl;
+                n_failed++;
+            }
+        }
+
+        vector<string> stages;
+        report.get_stage_names(stages);
+
+        for (const string &stage : stages)
+        {
+            const string key{instance + " " + stage};
+
+            const map<string, double>::const_iterator it{times_.find(key)};
+
+            if (it == times_.end())
+            {
+                log << "NOTE: " << key << ": no golden time" << endl;
+                continue;
+            }
+
+            double p50{0};
+            report.get_percentile(stage, 50, p50);
+
+            const double golden_p50{it->second};
+
+            if (p50 > golden_p50 * time_tolerance && p50 - golden_p50 > BENCH_TIME_FLOOR)
+            {
+                log << "REGRESSION: " << key << ": p50 " << p50 << " s, golden " << golden_p50
+                    << " s (x" << p50 / golden_p50 << ")" << endl;
+                n_failed++;
+            }
+        }
+
+        return n_failed;
+    }
+}
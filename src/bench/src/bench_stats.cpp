@@ -0,0 +1,149 @@
+/**
+ * @file bench_stats.cpp
+ * @brief Implementation of stage timers and percentile reports
+ */
+
+#include "bench_stats.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+#include <cmath>
+
+namespace BENCH
+{
+    double stage_samples::percentile(const vector<double> &sorted, const double p)
+    {
+        const size_t sz{sorted.size()};
+
+        if (sz == 1)
+            return sorted[0];
+
+        const double rank{p / 100.0 * (double)(sz - 1)};
+        const size_t lo{(size_t)floor(rank)};
+        const size_t hi{min(lo + 1, sz - 1)};
+
+        return sorted[lo] + (rank - (double)lo) * (sorted[hi] - sorted[lo]);
+    }
+
+    bench_report::bench_report(const string &instance_name, const size_t n_customers, const size_t n_days) : instance_name_(instance_name),
+                                                                                                          n_customers_(n_customers),
+                                                                                                          n_days_(n_days),
+                                                                                                          stages_()
+    {
+    }
+
+    bench_report::~bench_report(void)
+    {
+    }
+
+    stage_samples &bench_report::stage(const string &name)
+    {
+        for (stage_samples &c_stage : stages_)
+        {
+            if (c_stage.name_ == name)
+                return c_stage;
+        }
+
+        stages_.push_back(stage_samples(name));
+
+        return stages_.back();
+    }
+
+    bool bench_report::get_percentile(const string &name, const double p, double &value) const
+    {
+        for (const stage_samples &c_stage : stages_)
+        {
+            if (c_stage.name_ != name || c_stage.samples_.empty())
+                continue;
+
+            vector<double> sorted{c_stage.samples_};
+            sort(sorted.begin(), sorted.end());
+
+            value = stage_samples::percentile(sorted, p);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void bench_report::get_stage_names(vector<string> &names) const
+    {
+        names.clear();
+
+        for (const stage_samples &c_stage : stages_)
+        {
+            if (!c_stage.samples_.empty())
+                names.push_back(c_stage.name_);
+        }
+    }
+
+    ostream &bench_report::write_csv_header(ostream &os)
+    {
+        os << "instance,n_customers,n_days,stage,count,min,p50,p90,p99,max,mean" << endl;
+
+        return os;
+    }
+
+    ostream &bench_report::write_csv(ostream &os) const
+    {
+        for (const stage_samples &c_stage : stages_)
+        {
+            if (c_stage.samples_.empty())
+                continue;
+
+            vector<double> sorted{c_stage.samples_};
+            sort(sorted.begin(), sorted.end());
+
+            const double mean{accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size()};
+
+            os << instance_name_ << "," << n_customers_ << "," << n_days_ << "," << c_stage.name_ << "," << sorted.size();
+            os << scientific << setprecision(6);
+            os << "," << sorted.front();
+            os << "," << stage_samples::percentile(sorted, 50);
+            os << "," << stage_samples::percentile(sorted, 90);
+            os << "," << stage_samples::percentile(sorted, 99);
+            os << "," << sorted.back();
+            os << "," << mean;
+            os << defaultfloat << endl;
+        }
+
+        return os;
+    }
+
+    ostream &bench_report::write_json(ostream &os) const
+    {
+        os << "{\"instance\": \"" << instance_name_ << "\", \"n_customers\": " << n_customers_ << ", \"n_days\": " << n_days_ << ", \"stages\": [";
+
+        bool first{true};
+
+        for (const stage_samples &c_stage : stages_)
+        {
+            if (c_stage.samples_.empty())
+                continue;
+
+            vector<double> sorted{c_stage.samples_};
+            sort(sorted.begin(), sorted.end());
+
+            const double mean{accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size()};
+
+            os << (first ? "" : ", ");
+            os << "{\"stage\": \"" << c_stage.name_ << "\", \"count\": " << sorted.size();
+            os << scientific << setprecision(6);
+            os << ", \"min\": " << sorted.front();
+            os << ", \"p50\": " << stage_samples::percentile(sorted, 50);
+            os << ", \"p90\": " << stage_samples::percentile(sorted, 90);
+            os << ", \"p99\": " << stage_samples::percentile(sorted, 99);
+            os << ", \"max\": " << sorted.back();
+            os << ", \"mean\": " << mean << "}";
+            os << defaultfloat;
+
+            first = false;
+        }
+
+        os << "]}";
+
+        return os;
+    }
+}
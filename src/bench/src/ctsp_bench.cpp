@@ -0,0 +1,611 @@
+/**
+ * @file ctsp_bench.cpp
+ * @brief Stage-by-stage benchmark of the CTSP2 scheduling pipeline
+ *
+ * Times each stage of CTSP2_scheduler separately, so a regression can be
+ * attributed to the parser, the model builder, the LP or the cycle search
+ * without an external profiler:
+ *
+ * | Stage          | Code timed                                              |
+ * |----------------|---------------------------------------------------------|
+ * | `parse`        | `CTSP::instance::read` (TSPLIB parser)                  |
+ * | `builder`      | `CTSP_model_a_builder` construction                     |
+ * | `primal_model` | `ctsp_lb_dual_primal_model` construction (checker LP)   |
+ * | `lp_load`      | `sync_checker_solver` construction (LP sent to solver)  |
+ * | `sol_parse`    | `.sol` read and conversion to model_a variables         |
+ * | `is_feasible`  | First (cold) `is_feasible_(x)` of a new checker         |
+ * | `find_paths`   | `path_finder::find_paths` (infeasible solutions)        |
+ * | `write_json`   | `.sched.json` writing (feasible solutions)              |
+ * | `write_paths`  | `.infeas_paths.txt` writing (infeasible solutions)      |
+ * | `write_dot`    | `.graph.dot` writing (infeasible solutions)             |
+ *
+ * Output is written to memory, so write stages do not measure the disk.
+ * Results are one CSV line (or JSON object) per instance and stage with
+ * count, min, p50, p90, p99, max and mean wall-clock seconds.
+ *
+ * With --golden, the outcomes and stage medians of the sweep are checked
+ * against a file written by an earlier run (--write-golden), and the
+ * program fails on a regression (bench_golden.hpp).
+ */
+
+#include "bench_stats.hpp"
+#include "bench_generator.hpp"
+#include "bench_golden.hpp"
+
+#include "CTSP_instance.hpp"
+#include "CTSP_model_a_builder.hpp"
+
+#include "model_a_solution_interface.hpp"
+#include "sync_solution.hpp"
+#include "sync_solution_parser.hpp"
+#include "sync_scheduling.hpp"
+#include "sync_infeasible.hpp"
+#include "sync_model_cache.hpp"
+
+#include "ctsp_lb_primal_model.hpp"
+#include "ctsp_lb_sync_checker.hpp"
+#include "sync_iterative_checker.hpp"
+#include "sync_difference_checker.hpp"
+#include "sync_checker_solver.hpp"
+
+#include "path_finder.hpp"
+#include "sol_2_scheduling.hpp"
+#include "stats_timer.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * @brief Benchmark settings from the command line
+     */
+    struct bench_options
+    {
+        vector<size_t> sizes{14, 50, 100, 200}; ///< Generated instance sizes (customers)
+        size_t n_days{3};                       ///< Days of generated instances
+        double frequency{0.5};                  ///< Probability of a visit per customer and day
+        double max_differential{60};            ///< Time window width of generated instances
+        size_t reps{10};                        ///< Repetitions per instance
+        size_t seed{1};                         ///< Generator seed
+        string work_dir{"."};                   ///< Directory for generated files
+        string ins_file{""};                    ///< Given instance (no sweep)
+        string sol_file{""};                    ///< Given solution (with ins_file)
+        bool json{false};                       ///< JSON instead of CSV
+        bool difference{false};                 ///< is_feasible with sync_difference_checker
+        size_t max_cycles_per_arc{10};          ///< path_finder limit (0: all cycles)
+        size_t max_cycles{0};                   ///< path_finder limit (0: no limit)
+        double cycle_time_limit{0};             ///< path_finder limit (0: no limit)
+        size_t n_threads{1};                    ///< path_finder threads
+        bool generate_only{false};              ///< Write the generated files, no timing
+        string golden_file{""};                 ///< Golden results checked (empty: none)
+        string write_golden_file{""};           ///< Golden results written (empty: none)
+        double time_tolerance{2};               ///< Largest stage median / golden median
+    };
+
+    /**
+     * @brief Size ladder of the regression sweep (--sizes ladder)
+     */
+    const vector<size_t> ladder_sizes{14, 50, 100, 200, 500, 1000, 2000};
+
+    /**
+     * @class cout_redirect
+     * @brief Sends cout to a buffer while alive (the parser and the
+     *        scheduler log to cout, which would mix with the report)
+     */
+    class cout_redirect
+    {
+    private:
+        ostringstream sink_;
+        streambuf *old_;
+
+    public:
+        cout_redirect(void) : sink_(), old_(cout.rdbuf(sink_.rdbuf())) {}
+
+        virtual ~cout_redirect(void) { cout.rdbuf(old_); }
+    };
+
+    /**
+     * @brief Display usage information
+     * @param program_name Name of the executable
+     */
+    void print_usage(const char *program_name)
+    {
+        std::cerr << "\n"
+                  << "CTSP Bench - Stage timings of the CTSP2 scheduling pipeline\n"
+                  << "===========================================================\n\n"
+                  << "Usage:\n"
+                  << "  " << program_name << " [options]\n\n"
+                  << "Options:\n"
+                  << "  --sizes n1,n2,...       Customers of the generated instances (default 14,50,100,200;\n"
+                  << "                          ladder: 14,50,100,200,500,1000,2000)\n"
+                  << "  --days p                Days of the generated instances (default 3)\n"
+                  << "  --frequency f           Probability of a visit per customer and day (default 0.5)\n"
+                  << "  --differential d        Maximum allowable differential (default 60)\n"
+                  << "  --seed s                Generator seed (default 1)\n"
+                  << "  --dir path              Directory for the generated files (default .)\n"
+                  << "  --generate-only         Write the generated instances and solutions, no timing\n"
+                  << "  --instance file         Benchmark a given .contsp file instead of the sweep\n"
+                  << "  --solution file         Solution of the given instance (.sol)\n"
+                  << "  --reps r                Repetitions per instance (default 10)\n"
+                  << "  --engine lp|diff        Checker timed by is_feasible (default lp)\n"
+                  << "  --max-cycles-per-arc n  path_finder limit (default 10, 0: all cycles)\n"
+                  << "  --max-cycles n          path_finder limit (default 0: none)\n"
+                  << "  --cycle-time-limit t    path_finder limit in seconds (default 0: none)\n"
+                  << "  --threads n             path_finder threads (default 1)\n"
+                  << "  --format csv|json       Report format on standard output (default csv)\n"
+                  << "  --write-golden file     Save the outcomes and stage medians as golden results\n"
+                  << "  --golden file           Check the outcomes and stage medians against golden\n"
+                  << "                          results; exit 1 on a regression\n"
+                  << "  --time-tolerance f      Largest stage median / golden median (default 2)\n\n"
+                  << "Example:\n"
+                  << "  " << program_name << " --sizes 50,100 --reps 20 --dir /tmp --format json\n"
+                  << "  " << program_name << " --sizes ladder --reps 3 --dir /tmp --golden golden.txt\n\n";
+    }
+
+    /**
+     * @brief Value of an option, or exit if it is missing
+     */
+    const char *option_value(int argc, char **argv, int &i)
+    {
+        if (i + 1 >= argc)
+        {
+            cerr << "ERROR: Missing value for option " << argv[i] << endl;
+            print_usage(argv[0]);
+            exit(1);
+        }
+
+        return argv[++i];
+    }
+
+    /**
+     * @brief Parse the command line
+     * @param argc Argument count
+     * @param argv Argument vector
+     * @param options [out] Benchmark settings
+     */
+    void set_options(int argc, char **argv, bench_options &options)
+    {
+        for (int i{1}; i < argc; i++)
+        {
+            const string option{argv[i]};
+
+            if (option == "--sizes")
+            {
+                options.sizes.clear();
+
+                const string sizes_s{option_value(argc, argv, i)};
+
+                if (sizes_s == "ladder")
+                    options.sizes = ladder_sizes;
+                else
+                {
+                    stringstream sizes(sizes_s);
+                    string size;
+
+                    while (getline(sizes, size, ','))
+                        options.sizes.push_back(strtoul(size.c_str(), NULL, 10));
+                }
+            }
+            else if (option == "--days")
+                options.n_days = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--frequency")
+                options.frequency = atof(option_value(argc, argv, i));
+            else if (option == "--differential")
+                options.max_differential = atof(option_value(argc, argv, i));
+            else if (option == "--seed")
+                options.seed = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--dir")
+                options.work_dir = option_value(argc, argv, i);
+            else if (option == "--instance")
+                options.ins_file = option_value(argc, argv, i);
+            else if (option == "--solution")
+                options.sol_file = option_value(argc, argv, i);
+            else if (option == "--reps")
+                options.reps = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--max-cycles-per-arc")
+                options.max_cycles_per_arc = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--max-cycles")
+                options.max_cycles = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--cycle-time-limit")
+                options.cycle_time_limit = atof(option_value(argc, argv, i));
+            else if (option == "--threads")
+                options.n_threads = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--generate-only")
+                options.generate_only = true;
+            else if (option == "--golden")
+                options.golden_file = option_value(argc, argv, i);
+            else if (option == "--write-golden")
+                options.write_golden_file = option_value(argc, argv, i);
+            else if (option == "--time-tolerance")
+                options.time_tolerance = atof(option_value(argc, argv, i));
+            else if (option == "--engine")
+            {
+                const string engine{option_value(argc, argv, i)};
+
+                if (engine != "lp" && engine != "diff")
+                {
+                    cerr << "ERROR: Unknown engine " << engine << " (expected lp or diff)" << endl;
+                    exit(1);
+                }
+
+                options.difference = engine == "diff";
+            }
+            else if (option == "--format")
+            {
+                const string format{option_value(argc, argv, i)};
+
+                if (format != "csv" && format != "json")
+                {
+                    cerr << "ERROR: Unknown format " << format << " (expected csv or json)" << endl;
+                    exit(1);
+                }
+
+                options.json = format == "json";
+            }
+            else if (option == "--help" || option == "-h")
+            {
+                print_usage(argv[0]);
+                exit(0);
+            }
+            else
+            {
+                cerr << "ERROR: Unknown option " << option << endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        }
+
+        if (options.ins_file.empty() != options.sol_file.empty())
+        {
+            cerr << "ERROR: --instance and --solution go together" << endl;
+            exit(1);
+        }
+
+        if (options.reps == 0 || options.n_days == 0 || options.sizes.empty())
+        {
+            cerr << "ERROR: --reps, --days and --sizes must be positive" << endl;
+            exit(1);
+        }
+
+        if (options.generate_only && !options.ins_file.empty())
+        {
+            cerr << "ERROR: --generate-only and --instance cannot be combined" << endl;
+            exit(1);
+        }
+
+        if (options.time_tolerance < 1)
+        {
+            cerr << "ERROR: --time-tolerance must be at least 1" << endl;
+            exit(1);
+        }
+    }
+
+    /**
+     * @brief Outcome of a solution before it is scheduled
+     * @param ins_file Instance file (.contsp)
+     * @param sol_file Solution file (.sol)
+     * @param label Solution label in the golden results
+     */
+    BENCH::bench_outcome new_outcome(const string &ins_file, const string &sol_file, const string &label)
+    {
+        BENCH::bench_outcome outcome;
+
+        outcome.solution_ = label;
+        SYNC_LIB::sync_model_cache::instance_key(ins_file, 2, outcome.instance_key_);
+        SYNC_LIB::sync_model_cache::instance_key(sol_file, 2, outcome.solution_key_);
+
+        return outcome;
+    }
+
+    /**
+     * @brief Time every pipeline stage of one instance
+     * @param ins_file Instance file (.contsp)
+     * @param sol_files Solutions of the instance (.sol)
+     * @param options Benchmark settings
+     * @param report [out] Samples of every stage
+     * @param outcomes [in,out] One per solution (new_outcome): feasibility and
+     *        violated cycles found in the first repetition
+     */
+    void bench_instance(const string &ins_file, const vector<string> &sol_files, const bench_options &options, BENCH::bench_report &report, vector<BENCH::bench_outcome> &outcomes)
+    {
+        const double tol{1e-6};
+
+        const SYNC_LIB::sync_engine engine{options.difference ? SYNC_LIB::sync_engine::DIFFERENCE : SYNC_LIB::sync_engine::LP};
+
+        cout_redirect redirect;
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            CTSP::instance instance;
+            {
+                BENCH::bench_timer timer(report.stage("parse"));
+                instance.read(ins_file);
+            }
+
+            unique_ptr<CTSP::CTSP_model_a_builder> builder;
+            {
+                BENCH::bench_timer timer(report.stage("builder"));
+                builder.reset(new CTSP::CTSP_model_a_builder(CTSP::CTSP_problem_type::CTSP2, instance));
+            }
+
+            unique_ptr<SYNC_LIB::ctsp_lb_dual_primal_model> model;
+            {
+                BENCH::bench_timer timer(report.stage("primal_model"));
+                model.reset(new SYNC_LIB::ctsp_lb_dual_primal_model(*builder));
+            }
+
+            unique_ptr<GOMA::sync_checker_solver> solver;
+            {
+                BENCH::bench_timer timer(report.stage("lp_load"));
+                solver.reset(new GOMA::sync_checker_solver(*model, tol));
+            }
+
+            solver.reset();
+            model.reset();
+
+            // Produces the schedule / cycles that the write stages serialize
+            SYNC_LIB::conTSP2_scheduling scheduler(*builder, tol, engine);
+            scheduler.get_path_finder().set_limits(options.max_cycles_per_arc, options.max_cycles, options.cycle_time_limit);
+            scheduler.get_path_finder().set_n_threads(options.n_threads);
+
+            SYNC_LIB::model_a_solution_interface solution_interfaz;
+            solution_interfaz.set(*builder);
+
+            // Reused by every schedule, as in batch mode
+            SYNC_LIB::json_buffer json_buffer;
+
+            SYNC_LIB::sync_solution_parser solution_parser;
+            SYNC_LIB::sync_solution feas_sol;
+
+            for (size_t s{0}; s < sol_files.size(); s++)
+            {
+                const string &sol_file{sol_files[s]};
+
+                vector<double> x;
+                {
+                    BENCH::bench_timer timer(report.stage("sol_parse"));
+                    solution_parser.read(sol_file, feas_sol);
+                    solution_interfaz.sync_solution_2_model_a(feas_sol, x);
+                }
+
+                // A new checker per solution: cold check, as in CTSP2_scheduler
+                if (options.difference)
+                {
+                    SYNC_LIB::sync_difference_checker checker(*builder, tol);
+                    BENCH::bench_timer timer(report.stage("is_feasible"));
+                    checker.is_feasible_(x);
+                }
+                else
+                {
+                    SYNC_LIB::sync_iterative_checker<SYNC_LIB::ctsp_lb_sync_checker> checker(*builder, tol);
+                    BENCH::bench_timer timer(report.stage("is_feasible"));
+                    checker.is_feasible_(x);
+                }
+
+                SYNC_LIB::sync_scheduling feasible_schedule;
+                SYNC_LIB::sync_infeasible infeasible_paths(x, *builder);
+
+                // The cycle search is timed inside this check, on its cold support graph
+                const double cycle_time{scheduler.get_stats().cycle_time};
+
+                const bool feasible{scheduler.solve(feas_sol.get_instance_name(), x, feasible_schedule, infeasible_paths)};
+
+                if (r == 0)
+                    outcomes[s].feasible_ = feasible;
+
+                if (feasible)
+                {
+                    ostringstream os;
+                    BENCH::bench_timer timer(report.stage("write_json"));
+                    json_buffer.open(os);
+                    feas_sol.write_header(json_buffer);
+                    json_buffer.put('\n');
+                    feasible_schedule.write_json(json_buffer);
+                    feas_sol.write_end(json_buffer);
+                    json_buffer.close();
+                }
+                else
+                {
+                    const SYNC_LIB::cycle_list &cycles{infeasible_paths.violated_cycles()};
+
+                    // sync_stats timers: USE_STATS builds only
+                    GOMA_STATS(report.stage("find_paths").samples_.push_back(scheduler.get_stats().cycle_time - cycle_time));
+
+                    if (r == 0)
+                        outcomes[s].n_cycles_ = cycles.size();
+
+                    {
+                        ostringstream os;
+                        BENCH::bench_timer timer(report.stage("write_paths"));
+                        infeasible_paths.write_infeasible_paths(os);
+                    }
+                    {
+                        ostringstream os;
+                        BENCH::bench_timer timer(report.stage("write_dot"));
+                        infeasible_paths.write_primal_dual_graph(os);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Write one report in the selected format
+     */
+    void write_report(const BENCH::bench_report &report, const bench_options &options, bool first)
+    {
+        if (options.json)
+        {
+            cout << (first ? "[\n" : ",\n");
+            report.write_json(cout);
+        }
+        else
+        {
+            if (first)
+                BENCH::bench_report::write_csv_header(cout);
+
+            report.write_csv(cout);
+        }
+
+        cout.flush();
+    }
+}
+
+/**
+ * @brief Main entry point
+ * @param argc Argument count
+ * @param argv Argument vector (see print_usage)
+ * @return 0 on success, 1 on error or on a regression (--golden)
+ *
+ * Without --instance, runs the sweep: for every size, generates an
+ * instance with a consistent (feasible), a shuffled and, when the
+ * differential allows it, an infeasible solution in --dir, then times
+ * them through the pipeline (not with --generate-only).
+ *
+ * Example usage:
+ * @code
+ * ./ctsp_bench --sizes 50,100,200 --reps 20 --format csv > bench.csv
+ * ./ctsp_bench --instance input/burma14_p3_f50_lH.contsp --solution input/burma14_p3_f50_lH.infeas.sol
+ * ./ctsp_bench --sizes ladder --reps 3 --dir /tmp --write-golden golden.txt
+ * ./ctsp_bench --sizes ladder --reps 3 --dir /tmp --golden golden.txt
+ * @endcode
+ */
+int main(int argc, char **argv)
+{
+    bench_options options;
+    set_options(argc, argv, options);
+
+    BENCH::bench_golden golden;
+
+    if (!options.golden_file.empty() && !golden.read(options.golden_file))
+        return 1;
+
+    BENCH::bench_golden new_golden;
+    size_t n_failed{0};
+
+    if (!options.ins_file.empty())
+    {
+        CTSP::instance instance;
+        {
+            cout_redirect redirect;
+            instance.read(options.ins_file);
+        }
+
+        BENCH::bench_report report(instance.get_instance_name(), instance.get_n_customers(), instance.get_n_days());
+
+        // Labelled by the solution file name
+        const string sol_label{options.sol_file.substr(options.sol_file.find_last_of('/') + 1)};
+
+        vector<BENCH::bench_outcome> outcomes{new_outcome(options.ins_file, options.sol_file, sol_label)};
+
+        bench_instance(options.ins_file, {options.sol_file}, options, report, outcomes);
+        write_report(report, options, true);
+
+        if (!options.golden_file.empty())
+            n_failed += golden.check(report, outcomes, options.time_tolerance, cerr);
+
+        new_golden.add(report, outcomes);
+    }
+    else
+    {
+        BENCH::bench_generator generator(options.seed);
+
+        for (size_t i{0}; i < options.sizes.size(); i++)
+        {
+            generator.generate(options.sizes[i], options.n_days, options.frequency, options.max_differential);
+
+            const string base{options.work_dir + "/" + generator.get_name()};
+            const string ins_file{base + ".contsp"};
+            const string consistent_file{base + ".sol"};
+            const string shuffled_file{base + ".shuffled.sol"};
+            const string infeasible_file{base + ".infeas.sol"};
+
+            vector<vector<int>> routes;
+
+            ofstream ins_s(ins_file);
+            generator.write_instance(ins_s);
+            ins_s.close();
+
+            generator.consistent_routes(routes);
+            ofstream consistent_s(consistent_file);
+            SYNC_LIB::sync_solution(generator.get_name(), routes).write(consistent_s);
+            consistent_s.close();
+
+            generator.shuffled_routes(routes);
+            ofstream shuffled_s(shuffled_file);
+            SYNC_LIB::sync_solution(generator.get_name(), routes).write(shuffled_s);
+            shuffled_s.close();
+
+            const bool infeasible{generator.infeasible_routes(routes)};
+
+            ofstream infeasible_s;
+
+            if (infeasible)
+            {
+                infeasible_s.open(infeasible_file);
+                SYNC_LIB::sync_solution(generator.get_name(), routes).write(infeasible_s);
+                infeasible_s.close();
+            }
+            else
+                cerr << "WARNING: No two customers of two days of " << generator.get_name()
+                     << " are farther apart than the differential: no infeasible solution" << endl;
+
+            if (!ins_s || !consistent_s || !shuffled_s || !infeasible_s)
+            {
+                cerr << "ERROR: Cannot write generated files in " << options.work_dir << endl;
+                return 1;
+            }
+
+            if (options.generate_only)
+                continue;
+
+            vector<string> sol_files{consistent_file, shuffled_file};
+            vector<BENCH::bench_outcome> outcomes{new_outcome(ins_file, consistent_file, "consistent"),
+                                                  new_outcome(ins_file, shuffled_file, "shuffled")};
+
+            if (infeasible)
+            {
+                sol_files.push_back(infeasible_file);
+                outcomes.push_back(new_outcome(ins_file, infeasible_file, "infeasible"));
+            }
+
+            BENCH::bench_report report(generator.get_name(), generator.get_n_customers(), generator.get_n_days());
+
+            bench_instance(ins_file, sol_files, options, report, outcomes);
+            write_report(report, options, i == 0);
+
+            if (!options.golden_file.empty())
+                n_failed += golden.check(report, outcomes, options.time_tolerance, cerr);
+
+            new_golden.add(report, outcomes);
+        }
+    }
+
+    if (options.generate_only)
+        return 0;
+
+    if (options.json)
+        cout << "\n]" << endl;
+
+    if (!options.write_golden_file.empty() && !new_golden.write(options.write_golden_file))
+    {
+        cerr << "ERROR: Cannot write golden file " << options.write_golden_file << endl;
+        return 1;
+    }
+
+    if (n_failed > 0)
+    {
+        cerr << "ERROR: " << n_failed << " regressions against " << options.golden_file << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,706 @@
+/**
+ * @file ctsp_microbench.cpp
+ * @brief Microbenchmarks of the graph, bitset, matrix and mapping primitives
+ *
+ * Times the primitives under the cycle search and the model on synthetic
+ * inputs, so that a rewrite of one of them can be measured on its own
+ * before the end-to-end figures of ctsp_bench:
+ *
+ * | Primitive                | Case                                                   |
+ * |--------------------------|--------------------------------------------------------|
+ * | `search_graph`           | `DFS` and `backtrack_DFS` over random DAG supports     |
+ * | `succ_list`              | `add_arc`, `successors` (edit lists and compressed)    |
+ * | `fixed_bitset`           | `insert`, `contains`, `==` (search_fixed_bitset)       |
+ * | `matrix`                 | Row-major (per element, row()), column-major, random   |
+ * | `pair_map`               | `at` on arcs of the map and on missing pairs           |
+ * | `path_finder`            | `remove_repeated_cycles_` on cycles with duplicates    |
+ *
+ * Every case runs --reps times; each sample is the wall-clock time of one
+ * batch divided by its operations. Results are one CSV line per case with
+ * count, min, p50, p90 and max nanoseconds per operation.
+ */
+
+#include "bench_stats.hpp"
+#include "bench_generator.hpp"
+
+#include "graph.hpp"
+#include "fixed_bitset.hpp"
+#include "matrix.hpp"
+
+#include "sync_mapping.hpp"
+#include "sync_types.hpp"
+
+#include "CTSP_instance.hpp"
+#include "CTSP_model_a_builder.hpp"
+
+#include "path_finder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * @brief Benchmark settings from the command line
+     */
+    struct micro_options
+    {
+        size_t reps{20};                             ///< Samples per case
+        size_t seed{1};                              ///< Random seed
+        size_t dfs_vertices{60};                     ///< Vertices of the DFS supports
+        vector<double> densities{0.05, 0.1, 0.15, 0.2}; ///< Arc probabilities of the DFS supports
+        size_t graph_vertices{1000};                 ///< Vertices of the succ_list cases
+        size_t out_degree{10};                       ///< Arcs per vertex of the succ_list cases
+        size_t matrix_size{1000};                    ///< Rows and columns of the matrix cases
+        size_t n_items{2000};                        ///< Operations of the pair_map case
+        size_t n_cycles{10000};                      ///< Cycles of the duplicate removal case
+        size_t customers{100};                       ///< Customers of the duplicate removal model
+        string work_dir{"."};                        ///< Directory for the generated instance
+        string only{""};                             ///< Run only this primitive (empty: all)
+    };
+
+    /**
+     * @brief Keeps the benchmarked results alive (not optimized away)
+     */
+    volatile size_t sink{0};
+
+    /**
+     * @class cout_redirect
+     * @brief Sends cout to a buffer while alive (the parser logs to cout)
+     */
+    class cout_redirect
+    {
+    private:
+        ostringstream sink_;
+        streambuf *old_;
+
+    public:
+        cout_redirect(void) : sink_(), old_(cout.rdbuf(sink_.rdbuf())) {}
+
+        virtual ~cout_redirect(void) { cout.rdbuf(old_); }
+    };
+
+    /**
+     * @class micro_case
+     * @brief Samples (ns per operation) of one benchmarked case
+     */
+    class micro_case
+    {
+    private:
+        typedef chrono::steady_clock clock_type;
+
+        BENCH::stage_samples samples_; ///< ns per operation, one per repetition
+        string primitive_;             ///< Benchmarked primitive
+        size_t n_ops_;                 ///< Operations per sample
+
+        clock_type::time_point start_; ///< Start of the current sample
+
+    public:
+        micro_case(const string &primitive, const string &name, const size_t n_ops) : samples_(name),
+                                                                                     primitive_(primitive),
+                                                                                     n_ops_(n_ops),
+                                                                                     start_()
+        {
+        }
+
+        virtual ~micro_case(void) {}
+
+        inline void start(void) { start_ = clock_type::now(); }
+
+        inline void stop(void)
+        {
+            const chrono::duration<double, nano> elapsed{clock_type::now() - start_};
+            samples_.samples_.push_back(elapsed.count() / (double)max(n_ops_, (size_t)1));
+        }
+
+        /**
+         * @brief Write the CSV line of the case
+         */
+        void write_csv(ostream &os) const
+        {
+            vector<double> sorted{samples_.samples_};
+            sort(sorted.begin(), sorted.end());
+
+            os << primitive_ << "," << samples_.name_ << "," << n_ops_ << "," << sorted.size();
+            os << fixed << setprecision(3);
+            os << "," << sorted.front();
+            os << "," << BENCH::stage_samples::percentile(sorted, 50);
+            os << "," << BENCH::stage_samples::percentile(sorted, 90);
+            os << "," << sorted.back();
+            os << defaultfloat << endl;
+            os.flush();
+        }
+    };
+
+    /**
+     * @brief Display usage information
+     * @param program_name Name of the executable
+     */
+    void print_usage(const char *program_name)
+    {
+        std::cerr << "\n"
+                  << "CTSP Microbench - Graph, bitset, matrix and mapping primitives\n"
+                  << "==============================================================\n\n"
+                  << "Usage:\n"
+                  << "  " << program_name << " [options]\n\n"
+                  << "Options:\n"
+                  << "  --reps r                Samples per case (default 20)\n"
+                  << "  --seed s                Random seed (default 1)\n"
+                  << "  --dfs-vertices n        Vertices of the DFS supports (default 60, at most 640)\n"
+                  << "  --densities p1,p2,...   Arc probabilities of the DFS supports (default 0.05,0.1,0.15,0.2)\n"
+                  << "  --graph-vertices n      Vertices of the succ_list cases (default 1000)\n"
+                  << "  --out-degree d          Arcs per vertex of the succ_list cases (default 10)\n"
+                  << "  --matrix-size n         Rows and columns of the matrix cases (default 1000)\n"
+                  << "  --items n               Operations of the pair_map case (default 2000)\n"
+                  << "  --cycles n              Cycles of the duplicate removal case (default 10000)\n"
+                  << "  --customers n           Customers of the duplicate removal model (default 100)\n"
+                  << "  --dir path              Directory for the generated instance (default .)\n"
+                  << "  --only name             Run one primitive: search_graph, succ_list, fixed_bitset,\n"
+                  << "                          matrix, pair_map or path_finder\n\n"
+                  << "Example:\n"
+                  << "  " << program_name << " --only search_graph --densities 0.1,0.2 --reps 50\n\n";
+    }
+
+    /**
+     * @brief Value of an option, or exit if it is missing
+     */
+    const char *option_value(int argc, char **argv, int &i)
+    {
+        if (i + 1 >= argc)
+        {
+            cerr << "ERROR: Missing value for option " << argv[i] << endl;
+            print_usage(argv[0]);
+            exit(1);
+        }
+
+        return argv[++i];
+    }
+
+    /**
+     * @brief Parse the command line
+     * @param argc Argument count
+     * @param argv Argument vector
+     * @param options [out] Benchmark settings
+     */
+    void set_options(int argc, char **argv, micro_options &options)
+    {
+        for (int i{1}; i < argc; i++)
+        {
+            const string option{argv[i]};
+
+            if (option == "--reps")
+                options.reps = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--seed")
+                options.seed = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--dfs-vertices")
+                options.dfs_vertices = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--densities")
+            {
+                options.densities.clear();
+
+                stringstream densities(option_value(argc, argv, i));
+                string density;
+
+                while (getline(densities, density, ','))
+                    options.densities.push_back(atof(density.c_str()));
+            }
+            else if (option == "--graph-vertices")
+                options.graph_vertices = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--out-degree")
+                options.out_degree = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--matrix-size")
+                options.matrix_size = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--items")
+                options.n_items = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--cycles")
+                options.n_cycles = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--customers")
+                options.customers = strtoul(option_value(argc, argv, i), NULL, 10);
+            else if (option == "--dir")
+                options.work_dir = option_value(argc, argv, i);
+            else if (option == "--only")
+                options.only = option_value(argc, argv, i);
+            else if (option == "--help" || option == "-h")
+            {
+                print_usage(argv[0]);
+                exit(0);
+            }
+            else
+            {
+                cerr << "ERROR: Unknown option " << option << endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        }
+
+        if (options.reps == 0 || options.graph_vertices == 0 || options.matrix_size == 0 ||
+            options.n_items < 2 || options.n_cycles == 0 || options.customers < 2)
+        {
+            cerr << "ERROR: --reps, --graph-vertices, --matrix-size, --cycles must be positive, --items and --customers at least 2" << endl;
+            exit(1);
+        }
+
+        if (options.dfs_vertices < 2 || options.dfs_vertices > 640)
+        {
+            cerr << "ERROR: --dfs-vertices must be in [2, 640] (search_fixed_bitset)" << endl;
+            exit(1);
+        }
+
+        const vector<string> primitives{"", "search_graph", "succ_list", "fixed_bitset", "matrix", "pair_map", "path_finder"};
+
+        if (find(primitives.begin(), primitives.end(), options.only) == primitives.end())
+        {
+            cerr << "ERROR: Unknown primitive " << options.only << endl;
+            exit(1);
+        }
+    }
+
+    /**
+     * @brief search_graph::DFS and backtrack_DFS from the first to the last vertex
+     *
+     * Supports are random DAGs (arc i -> j, i < j, with probability p), so
+     * the number of paths is p (1 + p)^(n - 2) in expectation: the density
+     * controls the work without making the enumeration explode.
+     */
+    void bench_search_graph(const micro_options &options, mt19937 &rng)
+    {
+        const size_t n{options.dfs_vertices};
+
+        for (const double density : options.densities)
+        {
+            uniform_real_distribution<double> arc_dist(0.0, 1.0);
+
+            GOMA::search_graph graph(n);
+
+            for (size_t i{0}; i < n; i++)
+            {
+                for (size_t j{i + 1}; j < n; j++)
+                {
+                    if (arc_dist(rng) < density)
+                        graph.add_arc((int)i, (int)j);
+                }
+            }
+
+            graph.compress();
+
+            vector<vector<int>> dfs_paths;
+            GOMA::ragged_array<int> paths;
+            graph.backtrack_DFS(0, (int)n - 1, paths);
+
+            const size_t n_paths{max(paths.size(), (size_t)1)};
+
+            ostringstream name;
+            name << "p" << density << "_n" << n << "_paths" << paths.size();
+
+            // One operation: one path found
+            micro_case dfs_case("search_graph", "DFS_" + name.str(), n_paths);
+            micro_case backtrack_case("search_graph", "backtrack_DFS_" + name.str(), n_paths);
+
+            for (size_t r{0}; r < options.reps; r++)
+            {
+                dfs_case.start();
+                graph.DFS(0, (int)n - 1, dfs_paths);
+                dfs_case.stop();
+                sink = sink + dfs_paths.size();
+
+                backtrack_case.start();
+                graph.backtrack_DFS(0, (int)n - 1, paths);
+                backtrack_case.stop();
+                sink = sink + paths.size();
+            }
+
+            dfs_case.write_csv(cout);
+            backtrack_case.write_csv(cout);
+        }
+    }
+
+    /**
+     * @brief succ_list::add_arc and successors on a random graph
+     */
+    void bench_succ_list(const micro_options &options, mt19937 &rng)
+    {
+        const size_t n{options.graph_vertices};
+        const size_t n_arcs{n * options.out_degree};
+
+        uniform_int_distribution<int> vertex_dist(0, (int)n - 1);
+
+        vector<pair<int, int>> arcs(n_arcs);
+
+        for (size_t a{0}; a < n_arcs; a++)
+            arcs[a] = make_pair((int)(a % n), vertex_dist(rng));
+
+        const string name{"n" + to_string(n) + "_d" + to_string(options.out_degree)};
+
+        micro_case add_case("succ_list", "add_arc_" + name, n_arcs);
+        micro_case edit_case("succ_list", "successors_edit_" + name, n_arcs);
+        micro_case csr_case("succ_list", "successors_compressed_" + name, n_arcs);
+
+        GOMA::succ_list succ(n);
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            succ.clear();
+
+            add_case.start();
+            for (const pair<int, int> &arc : arcs)
+                succ.add_arc(arc.first, arc.second, 1.0);
+            add_case.stop();
+
+            const int *succ_v{nullptr};
+            size_t sz{0};
+            size_t sum{0};
+
+            edit_case.start();
+            for (size_t i{0}; i < n; i++)
+            {
+                succ.successors((int)i, succ_v, sz);
+
+                for (size_t k{0}; k < sz; k++)
+                    sum += succ_v[k];
+            }
+            edit_case.stop();
+
+            succ.compress();
+
+            csr_case.start();
+            for (size_t i{0}; i < n; i++)
+            {
+                succ.successors((int)i, succ_v, sz);
+
+                for (size_t k{0}; k < sz; k++)
+                    sum += succ_v[k];
+            }
+            csr_case.stop();
+
+            sink = sink + sum;
+        }
+
+        add_case.write_csv(cout);
+        edit_case.write_csv(cout);
+        csr_case.write_csv(cout);
+    }
+
+    /**
+     * @brief fixed_bitset insert, contains and equality (search_fixed_bitset)
+     */
+    void bench_fixed_bitset(const micro_options &options, mt19937 &rng)
+    {
+        const size_t n_ops{100000};
+        const size_t n_bits{640};
+
+        // Elements are 1-based
+        uniform_int_distribution<unsigned int> bit_dist(1, (unsigned int)n_bits);
+
+        vector<unsigned int> bits(n_ops);
+
+        for (unsigned int &bit : bits)
+            bit = bit_dist(rng);
+
+        micro_case insert_case("fixed_bitset", "insert_640", n_ops);
+        micro_case contains_case("fixed_bitset", "contains_640", n_ops);
+        micro_case equal_case("fixed_bitset", "equal_640", n_ops);
+
+        GOMA::search_fixed_bitset set_a;
+        GOMA::search_fixed_bitset set_b;
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            set_a.clear();
+
+            insert_case.start();
+            for (const unsigned int bit : bits)
+                set_a.insert(bit);
+            insert_case.stop();
+
+            size_t n_found{0};
+
+            contains_case.start();
+            for (const unsigned int bit : bits)
+                n_found += set_a.contains(bit);
+            contains_case.stop();
+
+            // Equal sets: every block is compared
+            set_b = set_a;
+
+            size_t n_equal{0};
+
+            equal_case.start();
+            for (size_t k{0}; k < n_ops; k++)
+                n_equal += set_a == set_b;
+            equal_case.stop();
+
+            sink = sink + n_found + n_equal;
+        }
+
+        insert_case.write_csv(cout);
+        contains_case.write_csv(cout);
+        equal_case.write_csv(cout);
+    }
+
+    /**
+     * @brief GOMA::matrix reads by rows (storage order, per element and
+     *        through row()), by columns and at random
+     */
+    void bench_matrix(const micro_options &options, mt19937 &rng)
+    {
+        const size_t n{options.matrix_size};
+        const size_t n_elements{n * n};
+
+        GOMA::matrix<double> M(n, n, 1.0);
+
+        uniform_int_distribution<size_t> index_dist(1, n);
+
+        vector<pair<size_t, size_t>> positions(n_elements);
+
+        for (pair<size_t, size_t> &position : positions)
+            position = make_pair(index_dist(rng), index_dist(rng));
+
+        const string name{to_string(n) + "x" + to_string(n)};
+
+        micro_case row_case("matrix", "row_major_" + name, n_elements);
+        micro_case span_case("matrix", "row_span_" + name, n_elements);
+        micro_case col_case("matrix", "col_major_" + name, n_elements);
+        micro_case random_case("matrix", "random_" + name, n_elements);
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            double sum{0};
+
+            row_case.start();
+            for (size_t i{1}; i <= n; i++)
+                for (size_t j{1}; j <= n; j++)
+                    sum += M(i, j);
+            row_case.stop();
+
+            span_case.start();
+            for (size_t i{1}; i <= n; i++)
+            {
+                const double *M_i{M.row(i)};
+
+                for (size_t j{0}; j < n; j++)
+                    sum += M_i[j];
+            }
+            span_case.stop();
+
+            col_case.start();
+            for (size_t j{1}; j <= n; j++)
+                for (size_t i{1}; i <= n; i++)
+                    sum += M(i, j);
+            col_case.stop();
+
+            random_case.start();
+            for (const pair<size_t, size_t> &position : positions)
+                sum += M(position.first, position.second);
+            random_case.stop();
+
+            sink = sink + (size_t)sum;
+        }
+
+        row_case.write_csv(cout);
+        span_case.write_csv(cout);
+        col_case.write_csv(cout);
+        random_case.write_csv(cout);
+    }
+
+    /**
+     * @brief pair_map::at on the arcs of the map and on missing pairs
+     */
+    void bench_pair_map(const micro_options &options, mt19937 &rng)
+    {
+        const size_t n{options.n_items};
+        const size_t n_arcs{n * options.out_degree};
+
+        uniform_int_distribution<int> item_dist(0, (int)n - 1);
+
+        vector<SYNC_LIB::triplet> arcs;
+        arcs.reserve(n_arcs);
+
+        for (size_t a{0}; a < n_arcs; a++)
+            arcs.push_back(SYNC_LIB::triplet((int)(a % n), item_dist(rng), 0, 0));
+
+        SYNC_LIB::pair_map map(n);
+        map.set(arcs);
+
+        vector<pair<int, int>> hits(n_arcs);
+        vector<pair<int, int>> misses;
+        misses.reserve(n_arcs);
+
+        uniform_int_distribution<size_t> arc_dist(0, n_arcs - 1);
+
+        for (size_t a{0}; a < n_arcs; a++)
+        {
+            const SYNC_LIB::triplet &arc{arcs[arc_dist(rng)]};
+            hits[a] = make_pair(arc.i_, arc.j_);
+        }
+
+        while (misses.size() < n_arcs)
+        {
+            const pair<int, int> pair_ij(item_dist(rng), item_dist(rng));
+
+            if (map.at(pair_ij) < 0)
+                misses.push_back(pair_ij);
+        }
+
+        const string name{"n" + to_string(n) + "_d" + to_string(options.out_degree)};
+
+        micro_case hit_case("pair_map", "at_hit_" + name, n_arcs);
+        micro_case miss_case("pair_map", "at_miss_" + name, n_arcs);
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            size_t sum{0};
+
+            hit_case.start();
+            for (const pair<int, int> &pair_ij : hits)
+                sum += map.at(pair_ij.first, pair_ij.second);
+            hit_case.stop();
+
+            miss_case.start();
+            for (const pair<int, int> &pair_ij : misses)
+                sum += map.at(pair_ij.first, pair_ij.second);
+            miss_case.stop();
+
+            sink = sink + sum;
+        }
+
+        hit_case.write_csv(cout);
+        miss_case.write_csv(cout);
+    }
+
+    /**
+     * @brief path_finder::remove_repeated_cycles_ on random cycles, half of them repeated
+     *
+     * The path finder needs a model: one is generated (bench_generator)
+     * in --dir. Cycles hold 10 routing arcs and 2 sync arcs; a repeated
+     * cycle is an earlier one with its arcs shuffled.
+     */
+    bool bench_path_finder(const micro_options &options, mt19937 &rng)
+    {
+        BENCH::bench_generator generator(options.seed);
+        generator.generate(options.customers, 3, 0.5, 60);
+
+        const string ins_file{options.work_dir + "/" + generator.get_name() + ".micro.contsp"};
+
+        ofstream ins_s(ins_file);
+        generator.write_instance(ins_s);
+        ins_s.close();
+
+        if (!ins_s)
+        {
+            cerr << "ERROR: Cannot write " << ins_file << endl;
+            return false;
+        }
+
+        CTSP::instance instance;
+        {
+            cout_redirect redirect;
+            instance.read(ins_file);
+        }
+
+        const CTSP::CTSP_model_a_builder builder(CTSP::CTSP_problem_type::CTSP2, instance);
+        const SYNC_LIB::path_finder finder(builder);
+
+        const int n_routing{(int)builder.get_routing_arcs().size()};
+        const int n_sync{(int)builder.get_sync_arcs().size()};
+
+        uniform_int_distribution<int> routing_dist(0, n_routing - 1);
+        uniform_int_distribution<int> sync_dist(n_routing, n_routing + max(n_sync, 1) - 1);
+
+        SYNC_LIB::cycle_list base_cycles;
+        vector<int> cycle;
+
+        for (size_t c{0}; c < options.n_cycles; c++)
+        {
+            cycle.clear();
+
+            if (c % 2 == 1)
+            {
+                uniform_int_distribution<size_t> earlier_dist(0, c - 1);
+
+                base_cycles[earlier_dist(rng)].copy_to(cycle);
+                shuffle(cycle.begin(), cycle.end(), rng);
+            }
+            else
+            {
+                for (int k{0}; k < 10; k++)
+                    cycle.push_back(routing_dist(rng));
+
+                for (int k{0}; k < 2 && n_sync > 0; k++)
+                    cycle.push_back(sync_dist(rng));
+            }
+
+            base_cycles.push_back(cycle);
+        }
+
+        micro_case dedup_case("path_finder", "remove_repeated_cycles_" + to_string(options.n_cycles), options.n_cycles);
+
+        SYNC_LIB::cycle_list cycles;
+
+        for (size_t r{0}; r < options.reps; r++)
+        {
+            cycles = base_cycles;
+
+            dedup_case.start();
+            finder.remove_repeated_cycles_(cycles);
+            dedup_case.stop();
+
+            sink = sink + cycles.size();
+        }
+
+        dedup_case.write_csv(cout);
+
+        return true;
+    }
+}
+
+/**
+ * @brief Main entry point
+ * @param argc Argument count
+ * @param argv Argument vector (see print_usage)
+ * @return 0 on success, 1 on error
+ *
+ * Output (standard output), one line per case:
+ * @code
+ * primitive,case,ops,count,min_ns,p50_ns,p90_ns,max_ns
+ * search_graph,DFS_p0.1_n60_paths25,25,20,...
+ * @endcode
+ */
+int main(int argc, char **argv)
+{
+    micro_options options;
+    set_options(argc, argv, options);
+
+    mt19937 rng((unsigned int)options.seed);
+
+    cout << "primitive,case,ops,count,min_ns,p50_ns,p90_ns,max_ns" << endl;
+
+    if (options.only.empty() || options.only == "search_graph")
+        bench_search_graph(options, rng);
+
+    if (options.only.empty() || options.only == "succ_list")
+        bench_succ_list(options, rng);
+
+    if (options.only.empty() || options.only == "fixed_bitset")
+        bench_fixed_bitset(options, rng);
+
+    if (options.only.empty() || options.only == "matrix")
+        bench_matrix(options, rng);
+
+    if (options.only.empty() || options.only == "pair_map")
+        bench_pair_map(options, rng);
+
+    if ((options.only.empty() || options.only == "path_finder") && !bench_path_finder(options, rng))
+        return 1;
+
+    return 0;
+}
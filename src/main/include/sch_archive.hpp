@@ -0,0 +1,260 @@
+/**
+ * @file sch_archive.hpp
+ * @brief Result archive: every result file of a run in one container
+ *
+ * Batch and sharded runs write one `.sched.json`, or one
+ * `.infeas_paths.txt` and one `.graph.dot`, per solution. With millions of
+ * solutions on a network file system, creating and closing the files
+ * costs more than writing their bytes. With --archive, the same contents
+ * are appended as records of one container file per run, in blocks that
+ * may be compressed with zstd, and an index gives the position of every
+ * record.
+ *
+ * Container (`.ctspa`), native byte order, no padding:
+ * ```
+ *     char[8]  "CTSPARC\0"
+ *     uint32   0x01020304 (byte order check)
+ *     uint32   version (1)
+ *     uint32   codec (0: none, 1: zstd)
+ *     then, per block:
+ *     uint64   stored bytes
+ *     uint64   raw bytes
+ *     stored bytes (raw bytes, or one zstd frame of them)
+ * ```
+ * The raw bytes of a block are its records, one after another:
+ * ```
+ *     uint32   name bytes
+ *     uint64   data bytes
+ *     name, data
+ * ```
+ * Blocks are compressed independently, so a record is read back by
+ * decompressing its block only.
+ *
+ * Index (`.ctspa.idx`), one tab-separated line per record, in write order:
+ * record name, file offset of its block, offset of the data in the raw
+ * bytes of the block, data bytes. The index is written under a temporary
+ * name and renamed when the archive is closed; an archive without index
+ * (interrupted run) is read by scanning its blocks.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace SCH
+{
+    /**
+     * @enum archive_codec
+     * @brief Compression of the archive blocks
+     */
+    enum class archive_codec : uint32_t
+    {
+        NONE = 0, ///< Raw records
+        ZSTD = 1  ///< One zstd frame per block (USE_ZSTD builds)
+    };
+
+    /**
+     * @class result_archive
+     * @brief Append-only writer of a result archive
+     *
+     * ```cpp
+     * result_archive archive;
+     *
+     * archive.open("out/results.ctspa", "out", archive_codec::ZSTD);
+     *
+     * infeasible_paths.write_infeasible_paths(archive.begin_record());
+     * archive.end_record(archive.get_record_name("out/bayg29", "sol_3.infeas_paths.txt"));
+     *
+     * archive.close();   // last block, index
+     * ```
+     *
+     * Not thread-safe: records are added by the thread that writes the
+     * results (the pipelined batch writer included).
+     */
+    class result_archive
+    {
+    protected:
+        string file_;         ///< Container file
+        string root_;         ///< Directory the record names are relative to
+        archive_codec codec_; ///< Block compression
+        int level_;           ///< zstd level
+        size_t block_size_;   ///< Raw bytes after which a block is written
+
+        ofstream os_;       ///< Container
+        ofstream index_os_; ///< Index (temporary name until close)
+        bool good_;         ///< No write failed
+
+        ostringstream record_; ///< Data of the record being written
+        string block_;         ///< Raw bytes of the open block
+        string stored_;        ///< Compressed block
+        uint64_t offset_;      ///< File offset of the open block
+
+        size_t n_records_;     ///< Records written
+        uint64_t raw_bytes_;   ///< Data bytes of the records
+        uint64_t file_bytes_;  ///< Container bytes written
+
+        void *cctx_; ///< zstd compression context, reused by every block
+
+        /**
+         * @brief Write the open block (compressed) and start a new one
+         */
+        void write_block_(void);
+
+    public:
+        result_archive(void);
+
+        /**
+         * @brief Closes the archive if still open
+         */
+        virtual ~result_archive(void);
+
+        /**
+         * @brief Create the archive
+         * @param file Container file (`<file>.idx` is the index)
+         * @param root Directory the record names are relative to
+         * @param codec Block compression
+         * @param level zstd level (1-19)
+         * @param block_size Raw bytes per block
+         * @return false if the file cannot be created or the codec is not
+         *         compiled in
+         */
+        bool open(const string &file, const string &root, archive_codec codec, int level = 3, size_t block_size = 1 << 20);
+
+        /**
+         * @brief Stream the data of the next record is written to
+         * @return Empty stream, valid until end_record()
+         */
+        ostream &begin_record(void);
+
+        /**
+         * @brief Append the record written since begin_record()
+         * @param name Record name (get_record_name)
+         */
+        void end_record(const string &name);
+
+        /**
+         * @brief Write the last block and the index
+         * @return false if a write failed
+         */
+        bool close(void);
+
+        /**
+         * @brief Name of a result file as an archive record
+         * @param dir Directory the file would be written to
+         * @param file File name
+         * @return Path of the file relative to the archive root
+         *         (e.g. `bayg29/sol_3.sched.json` in shard mode)
+         */
+        string get_record_name(const string &dir, const string &file) const;
+
+        inline bool is_open(void) const { return os_.is_open(); }
+        inline const string &get_file(void) const { return file_; }
+        inline size_t get_n_records(void) const { return n_records_; }
+        inline uint64_t get_raw_bytes(void) const { return raw_bytes_; }
+        inline uint64_t get_file_bytes(void) const { return file_bytes_; }
+
+        /**
+         * @brief Whether a codec is compiled in
+         * @param codec Block compression
+         */
+        static bool has_codec(archive_codec codec);
+
+        /**
+         * @brief Index file of an archive
+         * @param file Container file
+         * @return `<file>.idx`
+         */
+        static string get_index_file(const string &file);
+    };
+
+    /**
+     * @class result_archive_reader
+     * @brief Random access to the records of a result archive
+     *
+     * ```cpp
+     * result_archive_reader reader;
+     *
+     * if (reader.open("out/results.ctspa"))
+     *     for (const string &name : reader.get_names())
+     *         reader.read(name, data);   // one block decompressed at most
+     * ```
+     */
+    class result_archive_reader
+    {
+    protected:
+        /**
+         * @struct entry
+         * @brief Position of a record
+         */
+        struct entry
+        {
+            uint64_t block;  ///< File offset of its block
+            uint64_t offset; ///< Offset of the data in the raw block
+            uint64_t size;   ///< Data bytes
+        };
+
+        ifstream is_;         ///< Container
+        archive_codec codec_; ///< Block compression
+        uint64_t data_begin_; ///< File offset of the first block
+
+        vector<string> names_;                  ///< Record names, in write order
+        unordered_map<string, entry> entries_;  ///< Position of each record
+
+        uint64_t cached_block_; ///< File offset of the block in raw_ (UINT64_MAX: none)
+        string raw_;            ///< Raw bytes of the last block read
+        string stored_;         ///< Stored bytes of the last block read
+
+        /**
+         * @brief Read and decompress a block
+         * @param block File offset of the block
+         * @param next Output: file offset of the next block
+         * @return false if the block is truncated or corrupt
+         */
+        bool read_block_(uint64_t block, uint64_t &next);
+
+        /**
+         * @brief Index the records of every block (no index file)
+         * @return false if a block is corrupt (the records before it are kept)
+         */
+        bool scan_(void);
+
+        /**
+         * @brief Add a record position
+         */
+        void add_entry_(const string &name, const entry &e);
+
+    public:
+        result_archive_reader(void);
+        virtual ~result_archive_reader(void);
+
+        /**
+         * @brief Open an archive and load its index
+         * @param file Container file
+         * @return false if the file is not an archive or its codec is not
+         *         compiled in
+         *
+         * Without `<file>.idx`, the blocks are scanned: the records of an
+         * interrupted run are readable up to its last complete block.
+         */
+        bool open(const string &file);
+
+        /**
+         * @brief Data of a record
+         * @param name Record name
+         * @param data Output: record data
+         * @return false if there is no such record or its block is corrupt
+         */
+        bool read(const string &name, string &data);
+
+        inline size_t size(void) const { return names_.size(); }
+        inline const vector<string> &get_names(void) const { return names_; }
+        inline bool contains(const string &name) const { return entries_.count(name) > 0; }
+    };
+}
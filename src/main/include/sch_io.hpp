@@ -12,11 +12,22 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 using namespace std;
 
 namespace SCH
 {
+    /**
+     * @struct study_entry
+     * @brief One line of a study manifest (--shard, --merge-shards)
+     */
+    struct study_entry
+    {
+        string ins_file; ///< Instance file (.contsp)
+        string sol_file; ///< Solution file (.sol) of that instance
+    };
+
     /**
      * @class input_files
      * @brief Container for input file paths
@@ -28,7 +39,12 @@ namespace SCH
     {
     public:
         string ins_file; ///< Path to instance file (.contsp format)
-        string sol_file; ///< Path to solution file (.sol format)
+        string sol_file; ///< Path to solution file (.sol format), or manifest/directory in batch mode
+
+        vector<string> sol_files; ///< Batch mode: solution files to schedule, in order
+        vector<string> ins_files; ///< Server mode: instance files to serve
+
+        vector<study_entry> study; ///< Shard mode: (instance, solution) pairs of the study manifest, in order
 
         /**
          * @brief Constructor with file paths
@@ -53,15 +69,54 @@ namespace SCH
          * @param _out_file Path to solution file
          */
         void set(const string &_ins_file, const string &_out_file);
+
+        /**
+         * @brief Fill sol_files from sol_file (batch mode)
+         *
+         * - If sol_file is a directory: every *.sol file in it, sorted by name
+         * - Otherwise sol_file is a manifest: one solution path per line;
+         *   empty lines and lines starting with '#' are skipped, and relative
+         *   paths are taken from the manifest directory
+         *
+         * @note Exits with error if the manifest cannot be read or no solution is found
+         */
+        void set_batch(void);
+
+        /**
+         * @brief Fill ins_files from ins_file (server mode)
+         *
+         * - If ins_file is a directory: every *.contsp file in it, sorted by name
+         * - Otherwise ins_file itself
+         *
+         * @note Exits with error if no instance is found
+         */
+        void set_serve(void);
+
+        /**
+         * @brief Fill study from ins_file (shard mode)
+         *
+         * ins_file is a study manifest: one `instance solution` pair per
+         * line, separated by spaces or tabs; empty lines and lines starting
+         * with '#' are skipped, and relative paths are taken from the
+         * manifest directory. Every node of a sharded run reads the same
+         * manifest.
+         *
+         * @note Exits with error if the manifest cannot be read, a line has
+         *       no solution, or no pair is found
+         */
+        void set_study(void);
     };
 
+    class result_archive;
+
     class output_files
     {
     public:
         string output_path;
         string instance_name;
+        result_archive *archive; ///< Archive the result files are appended to, NULL: separate files (--archive)
 
-        output_files(const string &_output_path, const string &_ins_file);
+        output_files(const string &_output_path, const string &_ins_file, result_archive *_archive = NULL);
         output_files(void);
         ~output_files(void);
 
@@ -106,6 +161,17 @@ namespace SCH
         void set(const string &sch_file);
     };
 
+    /**
+     * @enum archive_output
+     * @brief Where the result files of batch and shard runs go
+     */
+    enum class archive_output
+    {
+        FILES, ///< One file per result
+        RAW,   ///< One result archive, uncompressed blocks
+        ZSTD   ///< One result archive, zstd blocks
+    };
+
     /**
      * @enum problem_type
      * @brief Supported problem variants
@@ -114,7 +180,102 @@ namespace SCH
      */
     enum class problem_type
     {
-        CTSP2 ///< Multi-depot Consistent TSP
+        CTSP2, ///< Multi-depot Consistent TSP
+        CTSP1  ///< Single-depot Consistent TSP (all routes leave together)
+    };
+
+    /**
+     * @enum checker_engine
+     * @brief Synchronization verification engine
+     */
+    enum class checker_engine
+    {
+        LP,        ///< LP-based checker (CPLEX/CLP)
+        DIFFERENCE ///< Negative-cycle checker (no LP solver call)
+    };
+
+    /**
+     * @enum cycle_engine
+     * @brief Violated cycle search of infeasible solutions
+     */
+    enum class cycle_engine
+    {
+        PATHS,   ///< Enumerate the paths of the LP certificate support (path_finder)
+        MIN_MEAN ///< Minimum mean cycles, polynomial (min_mean_cycle_finder)
+    };
+
+    /**
+     * @enum graph_output
+     * @brief Primal-dual graph written for infeasible solutions
+     */
+    enum class graph_output
+    {
+        FULL,        ///< Arcs of x and of the certificate
+        CERTIFICATE, ///< Arcs of the certificate (α, γ nonzero)
+        CYCLES,      ///< Arcs of the violated cycles
+        NONE         ///< No graph file
+    };
+
+    /**
+     * @class run_options
+     * @brief Optional command-line settings
+     *
+     * Holds the settings given as `--option value` after the positional
+     * arguments.
+     */
+    class run_options
+    {
+    public:
+        checker_engine engine; ///< Engine used to verify synchronization (--engine lp|diff)
+        cycle_engine cycles;   ///< Violated cycle search (--cycles paths|mmc)
+
+        size_t max_cycles_per_arc; ///< Violated cycles per sync arc, 0: all (--max-cycles-per-arc n)
+        size_t max_cycles;         ///< Violated cycles in total, 0: all (--max-cycles n)
+        double cycle_time_limit;   ///< Seconds for cycle search, 0: no limit (--cycle-time-limit t)
+        size_t n_threads;          ///< Threads for cycle search and model build, 0: all cores (--threads n)
+        bool batch;                ///< Schedule every solution of a manifest or directory (--batch)
+        bool decompose;            ///< One LP per support graph component (--decompose)
+        bool race;                 ///< Engines of each check run concurrently, first answer wins (--race)
+        string lp_backend;         ///< LP solver backend, empty: built-in default (--lp-backend name)
+        string basis_cache_file;   ///< LP bases kept between runs, empty: none (--basis-cache file)
+        vector<double> mad_sweep;  ///< Differentials to check each solution for (--mad-sweep from:to:step)
+        bool min_mad;              ///< Report the minimal feasible differential (--min-mad)
+        bool feasibility_only;     ///< Stop the LP at the first infeasibility certificate (--feasibility-only)
+        bool shared_sources;       ///< One path search per distinct sync arc source (--shared-sources)
+        bool work_stealing;        ///< Every thread on each sync arc's path search (--work-stealing)
+        bool integral_fast_path;   ///< Route walk instead of path enumeration for integral x (--integral-fast-path)
+        bool minimal_cycles;       ///< Shrink violated cycles to minimal infeasible arc sets (--minimal-cycles)
+        bool lazy_distances;       ///< Coordinate distances computed on demand, no matrix (--lazy-distances)
+        string model_cache_file;   ///< Built model kept between runs (.ctspbin), empty: none (--model-cache file)
+        bool round_trip_times;     ///< Shortest round-trip times in the JSON schedule, not one decimal (--round-trip-times)
+        bool stream;               ///< NDJSON solutions from stdin, one result line each to stdout (--stream)
+        string serve_address;      ///< Serve check requests on unix:path or host:port, empty: no server (--serve address)
+        size_t max_sessions;       ///< Warm sessions per served instance, 0: one per core (--max-sessions n)
+        graph_output graph;        ///< Arcs of the primal-dual graph of infeasible solutions (--graph full|certificate|cycles|none)
+        bool graph_binary;         ///< Binary edge list (.graph.bin) instead of DOT (--graph-format dot|bin)
+        bool prune_duration;       ///< Leave out routing arcs no route within the maximum duration can use (--prune-duration)
+        size_t knn_arcs;           ///< Candidate routing arcs per customer, 0: all (--knn-arcs k)
+        bool stats_json;           ///< Work counters and timers as JSON on stderr at the end (--stats json)
+        string trace_file;         ///< Chrome trace JSON of the stages and threads of the run, empty: none (--trace file)
+        bool memory_json;          ///< Bytes held by the model and search structures as JSON on stderr at the end (--memory json)
+        size_t batch_jobs;         ///< Solver workers of the batch pipeline, 1: sequential, 0: one per core (--jobs n)
+        double deadline;           ///< Seconds per solution for the check and the cycle search, 0: no limit (--deadline t)
+        size_t shard_index;        ///< Shard run by this process, 0-based (--shard k/N)
+        size_t n_shards;           ///< Shards of the study manifest, 0: no shard mode (--shard k/N)
+        size_t merge_shards;       ///< Merge the result files of this many shards, 0: no merge (--merge-shards N)
+        double flexibility;        ///< Horizon of the start time windows (.flex.json), 0: earliest completion, negative: none (--flexibility h)
+        archive_output archive;    ///< Result files of batch and shard runs appended to one archive (--archive files|raw|zstd[:level])
+        int archive_level;         ///< zstd level of the archive blocks (--archive zstd:level)
+
+        /**
+         * @brief Default constructor - LP engine, full cycle enumeration
+         */
+        run_options(void);
+
+        /**
+         * @brief Destructor
+         */
+        ~run_options(void);
     };
 
     /**
@@ -124,19 +285,31 @@ namespace SCH
      * @param sch_instance Output streams (will be initialized)
      * @param input_files_instance Input files (will be initialized)
      * @param prob_type Problem type (will be set)
+     * @param options Optional settings (will be set)
      *
      * **Expected Command Line:**
      * ```
-     * ctsp_scheduler <problem_type> <instance_file> <solution_file> <schedule_output>
+     * ctsp_scheduler <problem_type> <instance_file> <solution_file> <schedule_output> [--engine lp|diff] [--cycles paths|mmc]
+     *                [--max-cycles-per-arc n] [--max-cycles n] [--cycle-time-limit t] [--threads n]
+     *                [--batch] [--decompose] [--race] [--lp-backend cplex|clp|highs] [--basis-cache file]
+     *                [--mad-sweep from:to:step] [--min-mad] [--feasibility-only] [--shared-sources] [--work-stealing]
+     *                [--integral-fast-path] [--minimal-cycles] [--lazy-distances] [--model-cache file]
+     *                [--round-trip-times] [--stream] [--serve unix:path|host:port] [--max-sessions n]
+     *                [--graph full|certificate|cycles|none] [--graph-format dot|bin]
+     *                [--prune-duration] [--knn-arcs k] [--stats json] [--trace file] [--memory json]
+     *                [--jobs n] [--deadline t] [--shard k/N|env] [--merge-shards N] [--flexibility h]
+     *                [--archive files|raw|zstd[:level]]
      * ```
      *
      * **Example:**
      * ```bash
      * ./ctsp_scheduler ctsp2 input/bayg29.contsp input/bayg29.sol output/bayg29.sched.json
+     * ./ctsp_scheduler ctsp2 input/bayg29.contsp input/bayg29_sols/ output/ --batch
+     * ./ctsp_scheduler ctsp2 study.txt - output/ --shard 3/8 --archive zstd
      * ```
      *
-     * @note Exits program with error if problem_type is not recognized
+     * @note Exits program with error if problem_type or an option is not recognized
      */
-    void set_files(int argc, char **argv, output_streams &sch_instance, input_files &input_files_instance, output_files &output_files_instance, problem_type &prob_type);
+    void set_files(int argc, char **argv, output_streams &sch_instance, input_files &input_files_instance, output_files &output_files_instance, problem_type &prob_type, run_options &options);
 
 }
\ No newline at end of file
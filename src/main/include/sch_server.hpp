@@ -0,0 +1,183 @@
+/**
+ * @file sch_server.hpp
+ * @brief Separation server: warm checkers answering over a socket
+ *
+ * Optimizer processes on other hosts (or other processes of the same host)
+ * that check many routings would each load the instance, build the model
+ * and the checker LP, and hold a solver licence. sch_server loads the
+ * instances once and keeps their scheduling sessions warm in memory; the
+ * clients send routings over a Unix or TCP socket and get back the
+ * feasibility, the schedule or the violated cycles (as cuts).
+ */
+
+#pragma once
+
+#include "sch_io.hpp"
+
+#include "sync_model_a_builder.hpp"
+#include "scheduling_session.hpp"
+#include "sync_solution_parser.hpp"
+#include "sync_cuts.hpp"
+#include "json_buffer.hpp"
+
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace SCH
+{
+    /**
+     * @enum request_type
+     * @brief First byte of a request payload
+     */
+    enum class request_type : char
+    {
+        CHECK = 'c',    ///< Feasibility only
+        SCHEDULE = 's', ///< Schedule, or violated cycles (arc names) if infeasible
+        SEPARATE = 'x'  ///< Path elimination cuts of the violated cycles
+    };
+
+    /**
+     * @class served_instance
+     * @brief Model of one instance and its idle sessions
+     *
+     * Sessions are built on demand, up to the server limit, and returned to
+     * the idle list after each request: a request waits only when every
+     * session of its instance is busy.
+     */
+    class served_instance
+    {
+    public:
+        unique_ptr<SYNC_LIB::sync_model_a_builder> builder; ///< Model (shared by the sessions)
+
+        mutex idle_mutex;                                       ///< Guards idle and n_sessions
+        condition_variable idle_cv;                             ///< Signalled when a session is returned
+        vector<unique_ptr<SYNC_LIB::scheduling_session>> idle; ///< Sessions not in use
+        size_t n_sessions;                                      ///< Sessions built
+
+        served_instance(unique_ptr<SYNC_LIB::sync_model_a_builder> _builder);
+
+        virtual ~served_instance(void);
+    };
+
+    /**
+     * @class sch_server
+     * @brief Length-prefixed request / response server over warm sessions
+     *
+     * ```cpp
+     * sch_server server(options);
+     *
+     * server.add_instance(move(builder));   // one or more instances
+     * server.serve("unix:/tmp/ctsp.sock");  // or "host:port", ":port"
+     * ```
+     *
+     * Each frame is a 4 byte big-endian payload length followed by the
+     * payload. A request payload is one request_type byte and a JSON
+     * solution (sync_solution_parser format, nodes 0-based):
+     *
+     * ```
+     * s{"instance_name": "bayg29", "routes": [[0, 3, 7, 0], ...]}
+     * ```
+     *
+     * The instance is selected by "instance_name" (it may be omitted when
+     * one instance is served). A response payload is a JSON object:
+     *
+     * ```
+     * {"feasible": true}                                   (check)
+     * {"feasible": true, "schedule": [[...], ...]}         (schedule)
+     * {"feasible": false, "cycles": [["(0_3)", ...], ...]} (schedule)
+     * {"feasible": false, "cuts": [{"ind": [...], "rhs": r}, ...]} (separate: sum of x[ind] <= rhs)
+     * {"error": "..."}
+     * ```
+     *
+     * Every client connection is served by its own thread and may send
+     * any number of requests; concurrent requests of the same instance are
+     * checked by different sessions.
+     */
+    class sch_server
+    {
+    protected:
+        const run_options &options_; ///< Checker settings of the sessions
+        size_t max_sessions_;        ///< Sessions per instance
+
+        vector<unique_ptr<served_instance>> instances_; ///< Served instances
+
+        mutex build_mutex_; ///< Sessions are built one at a time (the model is read)
+
+    public:
+        /**
+         * @brief Server with no instance
+         * @param options Checker settings (engine, cycle search, limits) and
+         *        session limit (--max-sessions, 0: one per hardware thread)
+         */
+        sch_server(const run_options &options);
+
+        virtual ~sch_server(void);
+
+        /**
+         * @brief Serve an instance
+         * @param builder Model of the instance (ownership taken)
+         */
+        void add_instance(unique_ptr<SYNC_LIB::sync_model_a_builder> builder);
+
+        /**
+         * @brief Accept clients until the process is stopped
+         * @param address "unix:path" (Unix socket, an existing file is
+         *        replaced), "host:port" or ":port" (TCP, any interface)
+         * @return 1 if the socket cannot be opened, 0 when stopped by SIGINT
+         *         or SIGTERM with --trace (does not return otherwise)
+         *
+         * With --trace, SIGINT and SIGTERM are handled by the accepting
+         * thread only (blocked in the client threads), so the caller can
+         * write the trace once serve() returns.
+         */
+        int serve(const string &address);
+
+    private:
+        /**
+         * @brief Open the listening socket of an address
+         * @return Socket descriptor, -1 on error (reported on cerr)
+         */
+        int listen_(const string &address);
+
+        /**
+         * @brief Answer the requests of one connection until it is closed
+         * @param fd Connected socket (closed on return)
+         */
+        void client_(const int fd);
+
+        /**
+         * @brief Check a routing and format the response of a request
+         * @param instance Instance selected by the request
+         * @param type Request type
+         * @param routes Routing (one route per depot)
+         * @param cuts Cuts scratch (reused by the connection)
+         * @param response Output: response payload
+         */
+        void answer_(served_instance &instance, const request_type type, const vector<vector<int>> &routes,
+                     SYNC_LIB::sync_cuts &cuts, SYNC_LIB::json_buffer &response);
+
+        /**
+         * @brief Instance of a request
+         * @param instance_name Instance name of the request (empty: the only instance)
+         * @return NULL if not served
+         */
+        served_instance *find_instance_(const string &instance_name);
+
+        /**
+         * @brief Take an idle session of an instance, building one if below the limit
+         */
+        unique_ptr<SYNC_LIB::scheduling_session> acquire_(served_instance &instance);
+
+        /**
+         * @brief Return a session to the idle list of its instance
+         */
+        void release_(served_instance &instance, unique_ptr<SYNC_LIB::scheduling_session> session);
+
+        static void put_error_(SYNC_LIB::json_buffer &response, const string &message);
+    };
+}
@@ -0,0 +1,135 @@
+/**
+ * @file sch_shards.hpp
+ * @brief Sharded batch runs of a study manifest over several nodes
+ *
+ * A study checks the solutions of many instances. Batch mode builds the
+ * model of one instance once and streams its solutions through the
+ * checker; a sharded run gives every node (process) a share of the
+ * instances, so each model is still built once, by one node.
+ *
+ * Every node reads the same study manifest and computes the same plan:
+ * the instances are assigned to the shards by decreasing number of
+ * solutions, each to the shard with the fewest solutions so far (ties:
+ * the first instance in the manifest, the lowest shard). The plan depends
+ * on the manifest and the shard count only, not on the node that computes
+ * it. Each node writes its own result file to the (shared) output
+ * directory; the merge step reads them back in manifest order.
+ */
+
+#pragma once
+
+#include "sch_io.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace SCH
+{
+    /**
+     * @struct shard_result
+     * @brief Result of one solution of the study
+     */
+    struct shard_result
+    {
+        size_t index;  ///< Line of the solution in the study (0-based, comments skipped)
+        bool feasible; ///< Check result
+        bool failed;   ///< Not checked: the routes use arcs pruned from the model
+        double c_time; ///< Seconds to read and check
+    };
+
+    /**
+     * @class shard_plan
+     * @brief Assignment of the instances of a study to the shards
+     *
+     * ```cpp
+     * const shard_plan plan(input_files.study, options.n_shards);
+     *
+     * for (const size_t i : plan.get_instances(options.shard_index))
+     *     // build plan.get_instance(i) once, check plan.get_entries(i)
+     * ```
+     */
+    class shard_plan
+    {
+    protected:
+        size_t n_shards_; ///< Shards
+
+        vector<string> instances_;       ///< Distinct instance files, in order of first appearance
+        vector<vector<size_t>> entries_; ///< Study entries of each instance, in manifest order
+        vector<size_t> shard_;           ///< Shard of each instance
+        vector<size_t> load_;            ///< Solutions of each shard
+
+    public:
+        /**
+         * @brief Plan the shards of a study
+         * @param study (instance, solution) pairs of the study manifest
+         * @param n_shards Shard count (> 0)
+         */
+        shard_plan(const vector<study_entry> &study, size_t n_shards);
+
+        virtual ~shard_plan(void);
+
+        /**
+         * @brief Instances of a shard
+         * @param shard Shard (0-based)
+         * @return Instance indices, in order of first appearance in the manifest
+         */
+        vector<size_t> get_instances(size_t shard) const;
+
+        inline size_t get_n_shards(void) const { return n_shards_; }
+        inline size_t get_n_instances(void) const { return instances_.size(); }
+        inline const string &get_instance(const size_t i) const { return instances_[i]; }
+        inline const vector<size_t> &get_entries(const size_t i) const { return entries_[i]; }
+        inline size_t get_shard(const size_t i) const { return shard_[i]; }
+        inline size_t get_n_solutions(const size_t shard) const { return load_[shard]; }
+
+        /**
+         * @brief Result file of a shard in the output directory
+         * @param output_path Output directory
+         * @param shard Shard (0-based)
+         * @param n_shards Shard count
+         * @return `<output_path>/shard-<shard>-of-<n_shards>.tsv`
+         */
+        static string get_result_file(const string &output_path, size_t shard, size_t n_shards);
+
+        /**
+         * @brief Result archive of a shard in the output directory (--archive)
+         * @param output_path Output directory
+         * @param shard Shard (0-based)
+         * @param n_shards Shard count
+         * @return `<output_path>/shard-<shard>-of-<n_shards>.ctspa`
+         */
+        static string get_archive_file(const string &output_path, size_t shard, size_t n_shards);
+    };
+
+    /**
+     * @brief Write the result file of a shard
+     * @param result_file Result file (shard_plan::get_result_file)
+     * @param study (instance, solution) pairs of the study manifest
+     * @param results Results of the shard's solutions
+     * @return false if the file cannot be written
+     *
+     * One tab-separated line per solution: study line, `feasible` or
+     * `infeasible`, time (s), instance file and solution file. The file is
+     * written under a temporary name and renamed, so that the merge step
+     * never reads a partial file.
+     */
+    bool write_shard_results(const string &result_file, const vector<study_entry> &study, const vector<shard_result> &results);
+
+    /**
+     * @brief Merge the result files of every shard (--merge-shards)
+     * @param study (instance, solution) pairs of the study manifest
+     * @param output_path Output directory holding the shard result files
+     * @param n_shards Shard count of the run
+     * @return 0 on success, 1 if a shard file is missing or malformed, or
+     *         does not match the manifest
+     *
+     * Writes `<output_path>/results.tsv`: the lines of every shard, in
+     * manifest order, followed by the shard that checked them. Prints the
+     * solution, feasible and infeasible counts. The result archives of the
+     * shards (--archive) are left as they are: each is read with its own
+     * index.
+     */
+    int merge_shard_results(const vector<study_entry> &study, const string &output_path, size_t n_shards);
+}
@@ -9,29 +9,52 @@
 
 #pragma once
 
-#include "sync_model_builder.hpp"
+#include "sync_model_a_builder.hpp"
 
 #include "CTSP_instance.hpp"
+#include "CTSP_model_a_builder.hpp"
 #include "sync_solution.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "sch_io.hpp"
+#include "sch_shards.hpp"
+#include "sync_scheduling.hpp"
+#include "sync_infeasible.hpp"
+#include "sol_2_scheduling.hpp"
+#include "sync_stats.hpp"
+#include "sync_memory.hpp"
 
 using namespace std;
 
 namespace SCH
 {
+    /**
+     * @struct batch_result
+     * @brief Result of one solution of a batch run
+     */
+    struct batch_result
+    {
+        bool feasible; ///< Check result
+        bool failed;   ///< Not checked: the routes use arcs pruned from the model
+        double c_time; ///< Seconds to read and check
+    };
+
     /**
      * @brief Generate schedule for CTSP2 (multi-depot) problem
-     * @param I CTSP instance
+     * @param model_builder Synchronization model of the CTSP instance (built or
+     *        restored from the model cache)
      * @param initial_feasible_solution Feasible CTSP solution (routing)
      * @param output_streams_instance Output streams for schedule file
+     * @param options Optional settings (verification engine, cycle search limits)
+     * @param stats Output: work counters of the check and output write time
+     * @param memory Output: bytes held by the model and search structures
      *
      * This function:
-     * 1. Builds synchronization model from CTSP instance
+     * 1. Builds the checker from the synchronization model
      * 2. Converts solution format to model_a representation
      * 3. Verifies synchronization constraints via LP
      * 4. Computes operation start times
@@ -44,20 +67,167 @@ namespace SCH
      */
     void CTSP2_scheduler(
         const SCH::output_files &output_files,
-        const CTSP::instance &I,
-        const SYNC_LIB::sync_solution &initial_feasible_solution);
+        SYNC_LIB::sync_model_a_builder &model_builder,
+        const SYNC_LIB::sync_solution &initial_feasible_solution,
+        const SCH::run_options &options,
+        SYNC_LIB::sync_stats &stats,
+        SYNC_LIB::sync_memory &memory);
+
+
+    /**
+     * @brief Generate schedules for many CTSP2 solutions of one instance
+     * @param output_files Output directory (file names come from each solution file)
+     * @param model_builder Synchronization model of the CTSP instance (built or
+     *        restored from the model cache)
+     * @param sol_files Solution files (.sol), scheduled in order
+     * @param options Optional settings (verification engine, cycle search limits)
+     * @param stats Output: work counters of the checks and output write time
+     * @param memory Output: bytes held by the model and search structures
+     * @param results Output (if not null): result of each solution, in the
+     *        order of sol_files
+     *
+     * Builds the checker (LP model) and the solution converter once, then streams every solution through
+     * conTSP2_scheduling::solve. The LP checker only updates the routing
+     * coefficients that change from one solution to the next.
+     *
+     * For solution file `dir/name.sol`, writes `name.sched.json` (feasible)
+     * or `name.infeas_paths.txt` and `name.graph.dot` (infeasible) in the
+     * output directory. Prints one line per solution and aggregate timings
+     * (setup, total, mean, min and max solve time) to standard output.
+     */
+    void CTSP2_batch_scheduler(
+        const SCH::output_files &output_files,
+        SYNC_LIB::sync_model_a_builder &model_builder,
+        const vector<string> &sol_files,
+        const SCH::run_options &options,
+        SYNC_LIB::sync_stats &stats,
+        SYNC_LIB::sync_memory &memory,
+        vector<batch_result> *results = nullptr);
 
+    /**
+     * @brief Run one shard of a study manifest (--shard k/N)
+     * @param input_files Study manifest entries
+     * @param output_files Output directory, shared by the shards
+     * @param problem_type Model built for every instance
+     * @param options Optional settings (shard, checker settings, --jobs)
+     * @param stats Output: work counters of the checks, model build and
+     *        output write times, added up over the instances
+     * @param memory Output: bytes held by the largest model and its search
+     *        structures
+     * @return 0 on success, 1 if the shard result file cannot be written
+     *
+     * Each instance of the shard (shard_plan) is built once and its
+     * solutions are checked as in batch mode, into the subdirectory of
+     * output_files named after the instance. The shard result file
+     * (shard_plan::get_result_file) lists every solution of the shard.
+     */
+    int CTSP2_shard_scheduler(
+        const SCH::input_files &input_files,
+        const SCH::output_files &output_files,
+        CTSP::CTSP_problem_type problem_type,
+        const SCH::run_options &options,
+        SYNC_LIB::sync_stats &stats,
+        SYNC_LIB::sync_memory &memory);
+
+    /**
+     * @brief Schedule NDJSON solutions read from a stream (--stream)
+     * @param model_builder Synchronization model of the CTSP instance (built or
+     *        restored from the model cache)
+     * @param is Input: one JSON solution per line (sync_solution_parser JSON
+     *        format, nodes 0-based as sync_solution::write_json writes them)
+     * @param os Output: one JSON object per input line, flushed after each
+     * @param options Optional settings (verification engine, cycle search limits)
+     * @param stats Output: work counters of the checks and result line write time
+     * @param memory Output: bytes held by the model and search structures
+     *
+     * The checker and the solution converter are built once, as in batch
+     * mode. Blank input lines are skipped. For the n-th solution line:
+     *
+     * ```
+     * {"line": n, "instance_name": "...", "feasible": true, "schedule": [[{"customer": c, "arrival_starting": [a, s]}, ...], ...]}
+     * {"line": n, "instance_name": "...", "feasible": false, "cycles": [["(a_b)", ...], ...]}
+     * {"line": n, "error": "..."}
+     * ```
+     *
+     * No file is written.
+     */
+    void CTSP2_stream_scheduler(
+        SYNC_LIB::sync_model_a_builder &model_builder,
+        istream &is,
+        ostream &os,
+        const SCH::run_options &options,
+        SYNC_LIB::sync_stats &stats,
+        SYNC_LIB::sync_memory &memory);
+
+    /**
+     * @brief Run a separation server over the instances of input_files (--serve)
+     * @param input_files Instance file, or directory of .contsp files
+     * @param problem_type Model built for every instance
+     * @param options Optional settings (checker settings of the sessions,
+     *        server address, sessions per instance)
+     * @return 1 if the server cannot listen (does not return otherwise)
+     *
+     * Every instance is loaded (or restored from --model-cache, single
+     * instance only) before the first client is accepted. See sch_server
+     * for the protocol.
+     */
+    int CTSP2_server(
+        const SCH::input_files &input_files,
+        CTSP::CTSP_problem_type problem_type,
+        const SCH::run_options &options);
+
+    /**
+     * @brief Set up a CTSP2 scheduler from the run options
+     * @param scheduler Scheduler to configure
+     * @param options Optional settings (cycle search and limits, threads and decomposition)
+     */
+    void set_scheduler_options(SYNC_LIB::conTSP2_scheduling &scheduler, const SCH::run_options &options);
+
+    /**
+     * @brief Verification engine selected by the run options
+     * @param options Optional settings
+     * @return Engine for conTSP2_scheduling
+     */
+    SYNC_LIB::sync_engine get_sync_engine(const SCH::run_options &options);
+
+    /**
+     * @brief Write the result files of one scheduled solution
+     * @param output_files Output directory, file name prefix and archive
+     * @param feas_sol Scheduled solution (header of the JSON output)
+     * @param feasible true if the solution satisfies the sync constraints
+     * @param feasible_schedule Schedule (written if feasible)
+     * @param infeasible_paths Violated cycles (written if infeasible)
+     * @param json_buffer Buffer the JSON schedule and the DOT graph are
+     *        formatted into (reused across solutions in batch mode)
+     * @param options Optional settings (graph arcs and format)
+     *
+     * Writes `<prefix>.sched.json`, or `<prefix>.infeas_paths.txt` and
+     * `<prefix>.graph.dot` (`<prefix>.graph.bin` with --graph-format bin,
+     * none with --graph none). With an archive (--archive), the same
+     * contents are appended to it as records named after these files.
+     */
+    void write_schedule_results(
+        const SCH::output_files &output_files,
+        const SYNC_LIB::sync_solution &feas_sol,
+        bool feasible,
+        const SYNC_LIB::sync_scheduling &feasible_schedule,
+        const SYNC_LIB::sync_infeasible &infeasible_paths,
+        SYNC_LIB::json_buffer &json_buffer,
+        const SCH::run_options &options);
 
     /**
      * @typedef scheduler_ptr
      * @brief Function pointer type for scheduler functions
      *
-     * Points to functions that generate schedules from CTSP instances and solutions.
+     * Points to functions that generate schedules from CTSP models and solutions.
      */
     typedef void (*scheduler_ptr)(
         const SCH::output_files &output_files,
-        const CTSP::instance &I,
-        const SYNC_LIB::sync_solution &feasible_solution);
+        SYNC_LIB::sync_model_a_builder &model_builder,
+        const SYNC_LIB::sync_solution &feasible_solution,
+        const SCH::run_options &options,
+        SYNC_LIB::sync_stats &stats,
+        SYNC_LIB::sync_memory &memory);
 
     /**
      * @typedef sch_method_ptr
@@ -67,16 +237,18 @@ namespace SCH
      */
     typedef int (*sch_method_ptr)(const SCH::input_files &input_files,
                                   const SCH::output_files &output_files,
-                                  SCH::output_streams &os_instance);
+                                  const SCH::run_options &options);
 
     /**
      * @brief Complete CTSP2 scheduling workflow
      * @param input_files Input file paths (instance and solution)
-     * @param os_instance Output streams for results
+     * @param output_files Output file paths
+     * @param options Optional settings
      * @return 0 on success
      *
      * This function implements the complete workflow:
-     * 1. Load CTSP instance from file
+     * 1. Load CTSP instance from file and build its synchronization model
+     *    (or restore the model from --model-cache)
      * 2. Load solution from file
      * 3. Generate temporal schedule
      * 4. Write schedule to output file
@@ -84,33 +256,42 @@ namespace SCH
      * @note This is the main entry point called from command line
      */
     int ctsp2_scheduler(const SCH::input_files &input_files,
-                        SCH::output_streams &os_instance);
+                        const SCH::output_files &output_files,
+                        const SCH::run_options &options);
 
     /**
      * @brief Complete CTSP1 scheduling workflow
-     * @param input_files Input file paths
-     * @param os_instance Output streams
+     * @param input_files Input file paths (instance and solution)
+     * @param output_files Output file paths
+     * @param options Optional settings
      * @return 0 on success
+     *
+     * Same workflow and modes as ctsp2_scheduler over the CTSP1 model: all
+     * routes leave the depot together (equal departure times) and the
+     * depots carry no duration arcs, so the synchronization graph has
+     * n_days (n_days - 1) depot arcs instead of n_days². set_files selects
+     * the difference engine for ctsp1 unless --engine is given: integral
+     * solutions are checked by a negative-cycle search, without an LP call.
      */
     int ctsp1_scheduler(const SCH::input_files &input_files,
-                        SCH::output_streams &os_instance);
+                        const SCH::output_files &output_files,
+                        const SCH::run_options &options);
 
     /**
      * @brief Run appropriate scheduler based on problem type
      * @param input_files Input file paths
-     * @param sch_instance Output streams
+     * @param output_files Output file paths
      * @param prob_type Problem type identifier (CTSP1 or CTSP2)
+     * @param options Optional settings
      * @return 0 on success, non-zero on error
      *
      * This function dispatches to the appropriate scheduler based on
      * the problem type. It uses function pointer arrays for efficient
      * dispatching.
-     *
-     * @note Currently only CTSP2 is fully implemented
      */
     int run_method(const SCH::input_files &input_files,
                    const SCH::output_files &output_files,
-                   SCH::output_streams &sch_instance,
-                   SCH::problem_type prob_type);
+                   SCH::problem_type prob_type,
+                   const SCH::run_options &options);
 
 }
\ No newline at end of file
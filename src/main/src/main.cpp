@@ -26,14 +26,104 @@ namespace {
                   << "CTSP Scheduler - Convert routing solutions to temporal schedules\n"
                   << "================================================================\n\n"
                   << "Usage:\n"
-                  << "  " << program_name << " <problem_type> <instance_file> <solution_file> <output_file>\n\n"
+                  << "  " << program_name << " <problem_type> <instance_file> <solution_file> <output_file> [options]\n\n"
                   << "Arguments:\n"
                   << "  problem_type    Problem variant: 'ctsp2' (multi-depot) or 'ctsp1' (single-depot)\n"
                   << "  instance_file   Path to CTSP instance file (.contsp format)\n"
                   << "  solution_file   Path to feasible solution file (.sol format)\n"
                   << "  output_file     Path for output schedule file (.sched.json format)\n\n"
+                  << "Options:\n"
+                  << "  --engine lp|diff  Synchronization checker: LP solver (ctsp2 default) or\n"
+                  << "                    negative-cycle search (integral solutions, no LP call;\n"
+                  << "                    ctsp1 default)\n"
+                  << "  --cycles paths|mmc      Violated cycle search: paths of the LP certificate\n"
+                  << "                          support (default) or minimum mean cycles (polynomial)\n"
+                  << "  --max-cycles-per-arc n  Report at most n violated cycles per sync arc,\n"
+                  << "                          most violated first (default: all)\n"
+                  << "  --max-cycles n          Report at most n violated cycles in total\n"
+                  << "  --cycle-time-limit t    Stop the violated cycle search after t seconds\n"
+                  << "  --threads n             Threads for the violated cycle search, the\n"
+                  << "                          component LPs and the model build (0: all cores)\n"
+                  << "  --batch                 solution_file is a directory of .sol files or a manifest\n"
+                  << "                          (one .sol path per line); output_file is a directory\n"
+                  << "  --decompose             Solve one LP per connected component of the routing +\n"
+                  << "                          sync support graph instead of the full LP\n"
+                  << "  --race                  Run the engines that apply to each check (difference,\n"
+                  << "                          full LP, component LPs) concurrently; first answer wins\n"
+                  << "  --lp-backend name       LP solver backend: cplex, clp or highs, among the ones\n"
+                  << "                          compiled in (default: the first of them)\n"
+                  << "  --basis-cache file      Warm start the LP from the bases saved in file by\n"
+                  << "                          earlier runs on the same instance, and update it\n"
+                  << "  --mad-sweep from:to:step  Also check each solution for every maximum allowable\n"
+                  << "                          differential from, from+step, ..., to (one model)\n"
+                  << "  --min-mad               Also report the minimal feasible maximum allowable\n"
+                  << "                          differential of each solution\n"
+                  << "  --feasibility-only      Stop the LP at the first infeasibility certificate\n"
+                  << "                          instead of the most violated one\n"
+                  << "  --shared-sources        One path search per sync arc source, serving all the\n"
+                  << "                          sync arcs leaving it (same cycles)\n"
+                  << "  --work-stealing         With --threads, all threads search each sync arc's\n"
+                  << "                          paths, stealing subtrees from each other (same cycles)\n"
+                  << "  --integral-fast-path    For integral routings, one violated cycle per sync arc\n"
+                  << "                          by walking the routes instead of all of them\n"
+                  << "  --minimal-cycles        Shrink each violated cycle to a minimal infeasible\n"
+                  << "                          set of its routing arcs, without duplicates\n"
+                  << "  --lazy-distances        Coordinate instances: compute distances from the\n"
+                  << "                          coordinates when read instead of storing the matrix\n"
+                  << "  --model-cache file      Load the built model from file (.ctspbin) if it was\n"
+                  << "                          saved for this instance, else build and save it\n"
+                  << "  --round-trip-times      Write schedule times with all their digits (shortest\n"
+                  << "                          exact form) instead of one decimal\n"
+                  << "  --stream                Read one JSON solution per line from stdin and write\n"
+                  << "                          one JSON result per line to stdout (solution_file and\n"
+                  << "                          output_file are not used, pass -)\n"
+                  << "  --serve address         Keep the model and warm checkers in memory and answer\n"
+                  << "                          check/schedule/separate requests on unix:path or\n"
+                  << "                          host:port; instance_file may be a directory of .contsp\n"
+                  << "                          files (solution_file and output_file are not used)\n"
+                  << "  --max-sessions n        Server: warm checkers per instance, i.e. requests of\n"
+                  << "                          one instance checked at once (0: all cores, default)\n"
+                  << "  --graph full|certificate|cycles|none  Arcs of the primal-dual graph written for\n"
+                  << "                          infeasible solutions: x and certificate (default),\n"
+                  << "                          certificate only, violated cycles only, or no graph\n"
+                  << "  --graph-format dot|bin  Graph as DOT (default) or binary edge list (.graph.bin)\n"
+                  << "  --prune-duration        Leave out of the model the routing arcs no route within\n"
+                  << "                          the maximum duration can use\n"
+                  << "  --knn-arcs k            Keep only the arcs to the k nearest customers of each\n"
+                  << "                          customer (and from its k nearest); solutions using\n"
+                  << "                          other arcs cannot be checked\n"
+                  << "  --stats json            Print the work counters and timers (LP solves and\n"
+                  << "                          iterations, DFS nodes, cycles, model build and output\n"
+                  << "                          times) as one JSON object to stderr at the end\n"
+                  << "  --trace file            Write a Chrome trace (chrome://tracing, Perfetto) of\n"
+                  << "                          the stages and threads of the run; in server mode\n"
+                  << "                          when it is stopped with SIGINT or SIGTERM\n"
+                  << "  --memory json           Print the bytes held by the model, LP and cycle search\n"
+                  << "                          structures (after the build and at the separation\n"
+                  << "                          peak) and the process RSS as JSON to stderr at the end\n"
+                  << "  --jobs n                Batch mode: check n solutions at once (n converters)\n"
+                  << "                          while one thread reads and one writes (0: one per\n"
+                  << "                          core, default 1: sequential)\n"
+                  << "  --deadline t            Give each solution t seconds for the check and the\n"
+                  << "                          cycle search; a solution cut short is reported as\n"
+                  << "                          truncated (0: no limit, default)\n"
+                  << "  --shard k/N|env         instance_file is a study manifest (one instance and\n"
+                  << "                          one solution per line): check the instances of shard\n"
+                  << "                          k of N (env: rank and size of srun or mpirun), each\n"
+                  << "                          model built once, into the output_file directory\n"
+                  << "  --merge-shards N        Merge the result files of the N shards of a study\n"
+                  << "                          manifest into output_file/results.tsv\n"
+                  << "  --flexibility h         Also write the earliest and latest start time of every\n"
+                  << "                          operation of a feasible solution in [0, h] to\n"
+                  << "                          .flex.json (0: the earliest completion)\n"
+                  << "  --archive files|raw|zstd[:level]\n"
+                  << "                          Batch and shard modes: append the result files to one\n"
+                  << "                          archive (results.ctspa, shard-k-of-N.ctspa) with an\n"
+                  << "                          index (.idx), in zstd blocks with zstd (level 1-19,\n"
+                  << "                          default 3; USE_ZSTD builds). Default: files\n\n"
                   << "Example:\n"
-                  << "  " << program_name << " ctsp2 input/bayg29.contsp input/bayg29.sol output/schedule.json\n\n";
+                  << "  " << program_name << " ctsp2 input/bayg29.contsp input/bayg29.sol output/schedule.json\n"
+                  << "  " << program_name << " ctsp2 study.txt - output/ --shard 0/4 --engine diff\n\n";
     }
 
     /**
@@ -45,9 +135,9 @@ namespace {
     bool validate_arguments(int argc, char** argv) {
         const int REQUIRED_ARGS = 5;
         
-        if (argc != REQUIRED_ARGS) {
+        if (argc < REQUIRED_ARGS) {
             std::cerr << "Error: Invalid number of arguments.\n"
-                      << "Expected " << (REQUIRED_ARGS - 1) << " arguments, got " << (argc - 1) << ".\n";
+                      << "Expected at least " << (REQUIRED_ARGS - 1) << " arguments, got " << (argc - 1) << ".\n";
             print_usage(argv[0]);
             return false;
         }
@@ -58,16 +148,24 @@ namespace {
 
 /**
  * @brief Main entry point
- * @param argc Argument count (must be 5)
+ * @param argc Argument count (at least 5)
  * @param argv Argument vector:
  *   - argv[0]: Program name
  *   - argv[1]: Problem type ("ctsp2" or "ctsp1")
  *   - argv[2]: Instance file path (.contsp format)
  *   - argv[3]: Solution file path (.sol format)
  *   - argv[4]: Output file path (.sched.json)
+ *   - argv[5..]: Options (--engine lp|diff, --cycles paths|mmc, --max-cycles-per-arc n, --max-cycles n,
+ *     --cycle-time-limit t, --threads n, --batch, --decompose, --race, --lp-backend name,
+ *     --basis-cache file, --mad-sweep from:to:step, --min-mad, --feasibility-only,
+ *     --shared-sources, --work-stealing, --integral-fast-path, --minimal-cycles, --lazy-distances, --model-cache file,
+ *     --round-trip-times, --stream, --serve address, --max-sessions n,
+ *     --graph full|certificate|cycles|none, --graph-format dot|bin, --prune-duration,
+ *     --knn-arcs k, --stats json, --trace file, --memory json, --jobs n, --deadline t,
+ *     --shard k/N|env, --merge-shards N, --flexibility h, --archive files|raw|zstd[:level])
  * @return 0 on success, 1 on error
  * 
- * @note Requires exactly 4 arguments plus program name
+ * @note Requires 4 positional arguments plus program name, followed by options
  * @note Output is written to JSON file with schedules for each depot
  * 
  * Example usage:
@@ -88,13 +186,12 @@ int main(int argc, char **argv)
         SCH::input_files input_files;
         SCH::output_files output_files;
         SCH::problem_type prob_type;
+        SCH::run_options options;
 
         // Parse command-line arguments
-        SCH::set_files(argc, argv, output_streams, input_files, output_files, prob_type);
+        SCH::set_files(argc, argv, output_streams, input_files, output_files, prob_type, options);
         // Execute scheduling workflow
-        SCH::run_method(input_files, output_files, output_streams, prob_type);
-
-        return 0;
+        return SCH::run_method(input_files, output_files, prob_type, options);
         
     } catch (const std::exception& e) {
         std::cerr << "\nError: " << e.what() << "\n\n";
@@ -0,0 +1,447 @@
+/**
+ * @file sch_archive.cpp
+ * @brief Implementation of the result archive writer and reader
+ */
+
+#include "sch_archive.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace SCH
+{
+    namespace
+    {
+        const char archive_magic[8]{'C', 'T', 'S', 'P', 'A', 'R', 'C', '\0'};
+        const uint32_t archive_byte_order{0x01020304};
+        const uint32_t archive_version{1};
+
+        template <typename T>
+        inline void put(string &s, const T value)
+        {
+            s.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        inline void put(ostream &os, const T value)
+        {
+            os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        inline bool get(istream &is, T &value)
+        {
+            return (bool)is.read(reinterpret_cast<char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        inline bool get(const string &s, size_t &p, T &value)
+        {
+            if (s.size() - p < sizeof(T))
+                return false;
+
+            memcpy(&value, s.data() + p, sizeof(T));
+            p += sizeof(T);
+
+            return true;
+        }
+
+        const size_t header_bytes{sizeof(archive_magic) + 3 * sizeof(uint32_t)};
+        const size_t block_header_bytes{2 * sizeof(uint64_t)};
+    }
+
+    result_archive::result_archive(void) : file_(),
+                                           root_(),
+                                           codec_(archive_codec::NONE),
+                                           level_(3),
+                                           block_size_(1 << 20),
+                                           os_(),
+                                           index_os_(),
+                                           good_(false),
+                                           record_(),
+                                           block_(),
+                                           stored_(),
+                                           offset_(0),
+                                           n_records_(0),
+                                           raw_bytes_(0),
+                                           file_bytes_(0),
+                                           cctx_(NULL)
+    {
+    }
+
+    result_archive::~result_archive(void)
+    {
+        if (os_.is_open())
+            close();
+
+#ifdef USE_ZSTD
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(cctx_));
+#endif
+    }
+
+    bool result_archive::has_codec(const archive_codec codec)
+    {
+#ifdef USE_ZSTD
+        return codec == archive_codec::NONE || codec == archive_codec::ZSTD;
+#else
+        return codec == archive_codec::NONE;
+#endif
+    }
+
+    string result_archive::get_index_file(const string &file)
+    {
+        return file + ".idx";
+    }
+
+    bool result_archive::open(const string &file, const string &root, const archive_codec codec, const int level, const size_t block_size)
+    {
+        if (!has_codec(codec))
+            return false;
+
+        file_ = file;
+        root_ = root;
+        codec_ = codec;
+        level_ = level;
+        block_size_ = block_size;
+
+#ifdef USE_ZSTD
+        if (codec_ == archive_codec::ZSTD)
+        {
+            if (cctx_ == NULL)
+                cctx_ = ZSTD_createCCtx();
+
+            if (cctx_ == NULL || ZSTD_isError(ZSTD_CCtx_setParameter(static_cast<ZSTD_CCtx *>(cctx_), ZSTD_c_compressionLevel, level_)))
+                return false;
+        }
+#endif
+
+        os_.open(file_, ios::binary | ios::trunc);
+        index_os_.open(get_index_file(file_) + ".tmp", ios::trunc);
+
+        if (!os_ || !index_os_)
+        {
+            os_.close();
+            index_os_.close();
+            return false;
+        }
+
+        os_.write(archive_magic, sizeof(archive_magic));
+        put(os_, archive_byte_order);
+        put(os_, archive_version);
+        put(os_, static_cast<uint32_t>(codec_));
+
+        index_os_ << "# name\tblock\toffset\tbytes" << '\n';
+
+        block_.clear();
+        block_.reserve(block_size_ + (block_size_ >> 3));
+
+        offset_ = header_bytes;
+        file_bytes_ = header_bytes;
+        n_records_ = 0;
+        raw_bytes_ = 0;
+        good_ = (bool)os_;
+
+        return good_;
+    }
+
+    ostream &result_archive::begin_record(void)
+    {
+        record_.str(string());
+        record_.clear();
+
+        return record_;
+    }
+
+    void result_archive::end_record(const string &name)
+    {
+        const string data{record_.str()};
+
+        put(block_, static_cast<uint32_t>(name.size()));
+        put(block_, static_cast<uint64_t>(data.size()));
+        block_.append(name);
+
+        // Position of the data, known before the block is written
+        index_os_ << name << '\t' << offset_ << '\t' << block_.size() << '\t' << data.size() << '\n';
+
+        block_.append(data);
+
+        n_records_++;
+        raw_bytes_ += data.size();
+
+        if (block_.size() >= block_size_)
+            write_block_();
+    }
+
+    void result_archive::write_block_(void)
+    {
+        if (block_.empty())
+            return;
+
+        const string *stored{&block_};
+
+#ifdef USE_ZSTD
+        if (codec_ == archive_codec::ZSTD)
+        {
+            stored_.resize(ZSTD_compressBound(block_.size()));
+
+            const size_t n_bytes{ZSTD_compress2(static_cast<ZSTD_CCtx *>(cctx_), &stored_[0], stored_.size(), block_.data(), block_.size())};
+
+            if (ZSTD_isError(n_bytes))
+            {
+                good_ = false;
+                block_.clear();
+                return;
+            }
+
+            stored_.resize(n_bytes);
+            stored = &stored_;
+        }
+#endif
+
+        put(os_, static_cast<uint64_t>(stored->size()));
+        put(os_, static_cast<uint64_t>(block_.size()));
+        os_.write(stored->data(), stored->size());
+
+        offset_ += block_header_bytes + stored->size();
+        file_bytes_ = offset_;
+
+        good_ = good_ && (bool)os_;
+
+        block_.clear();
+    }
+
+    bool result_archive::close(void)
+    {
+        if (!os_.is_open())
+            return good_;
+
+        write_block_();
+
+        os_.close();
+        index_os_.close();
+
+        good_ = good_ && !os_.fail() && !index_os_.fail();
+
+        // The index names complete archives only
+        const string index_file{get_index_file(file_)};
+
+        if (good_)
+            good_ = rename((index_file + ".tmp").c_str(), index_file.c_str()) == 0;
+
+        return good_;
+    }
+
+    string result_archive::get_record_name(const string &dir, const string &file) const
+    {
+        namespace fs = std::filesystem;
+
+        const fs::path relative{fs::path(dir).lexically_relative(root_)};
+
+        if (relative.empty() || relative == ".")
+            return file;
+
+        return (relative / file).generic_string();
+    }
+
+    result_archive_reader::result_archive_reader(void) : is_(),
+                                                         codec_(archive_codec::NONE),
+                                                         data_begin_(0),
+                                                         names_(),
+                                                         entries_(),
+                                                         cached_block_(UINT64_MAX),
+                                                         raw_(),
+                                                         stored_()
+    {
+    }
+
+    result_archive_reader::~result_archive_reader(void)
+    {
+    }
+
+    void result_archive_reader::add_entry_(const string &name, const entry &e)
+    {
+        // A name written twice (rerun of a solution) keeps its last record
+        if (entries_.count(name) == 0)
+            names_.push_back(name);
+
+        entries_[name] = e;
+    }
+
+    bool result_archive_reader::open(const string &file)
+    {
+        names_.clear();
+        entries_.clear();
+        cached_block_ = UINT64_MAX;
+
+        is_.close();
+        is_.clear();
+        is_.open(file, ios::binary);
+
+        char magic[sizeof(archive_magic)];
+        uint32_t byte_order, version, codec;
+
+        if (!is_.read(magic, sizeof(magic)) || memcmp(magic, archive_magic, sizeof(magic)) != 0)
+            return false;
+
+        if (!get(is_, byte_order) || !get(is_, version) || !get(is_, codec))
+            return false;
+
+        if (byte_order != archive_byte_order || version != archive_version)
+            return false;
+
+        codec_ = static_cast<archive_codec>(codec);
+
+        if (!result_archive::has_codec(codec_))
+            return false;
+
+        data_begin_ = header_bytes;
+
+        ifstream index_is(result_archive::get_index_file(file));
+
+        if (!index_is)
+            return scan_();
+
+        string line;
+
+        while (getline(index_is, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            // Name first: the offsets are the last three fields
+            size_t tab[3];
+            size_t p{line.size()};
+            bool ok{true};
+
+            for (int f{2}; f >= 0 && ok; f--)
+            {
+                p = p == 0 ? string::npos : line.rfind('\t', p - 1);
+                ok = p != string::npos;
+                tab[f] = p;
+            }
+
+            if (!ok)
+                return false;
+
+            entry e;
+            e.block = stoull(line.substr(tab[0] + 1, tab[1] - tab[0] - 1));
+            e.offset = stoull(line.substr(tab[1] + 1, tab[2] - tab[1] - 1));
+            e.size = stoull(line.substr(tab[2] + 1));
+
+            add_entry_(line.substr(0, tab[0]), e);
+        }
+
+        return true;
+    }
+
+    bool result_archive_reader::read_block_(const uint64_t block, uint64_t &next)
+    {
+        uint64_t stored_size, raw_size;
+
+        is_.clear();
+        is_.seekg(block);
+
+        if (!get(is_, stored_size) || !get(is_, raw_size))
+            return false;
+
+        next = block + block_header_bytes + stored_size;
+
+        if (cached_block_ == block)
+            return true;
+
+        cached_block_ = UINT64_MAX;
+
+        if (codec_ == archive_codec::NONE)
+        {
+            if (stored_size != raw_size)
+                return false;
+
+            raw_.resize(raw_size);
+
+            if (!is_.read(&raw_[0], raw_size))
+                return false;
+        }
+        else
+        {
+#ifdef USE_ZSTD
+            stored_.resize(stored_size);
+
+            if (!is_.read(&stored_[0], stored_size))
+                return false;
+
+            raw_.resize(raw_size);
+
+            const size_t n_bytes{ZSTD_decompress(&raw_[0], raw_.size(), stored_.data(), stored_.size())};
+
+            if (ZSTD_isError(n_bytes) || n_bytes != raw_size)
+                return false;
+#else
+            return false;
+#endif
+        }
+
+        cached_block_ = block;
+
+        return true;
+    }
+
+    bool result_archive_reader::scan_(void)
+    {
+        is_.clear();
+        is_.seekg(0, ios::end);
+
+        const uint64_t file_size{static_cast<uint64_t>(is_.tellg())};
+
+        uint64_t block{data_begin_};
+        uint64_t next;
+
+        while (block < file_size)
+        {
+            if (!read_block_(block, next))
+                return false;
+
+            size_t p{0};
+
+            while (p < raw_.size())
+            {
+                uint32_t name_size;
+                uint64_t data_size;
+
+                if (!get(raw_, p, name_size) || !get(raw_, p, data_size) || raw_.size() - p < name_size + data_size)
+                    return false;
+
+                const string name(raw_, p, name_size);
+                p += name_size;
+
+                add_entry_(name, entry{block, p, data_size});
+                p += data_size;
+            }
+
+            block = next;
+        }
+
+        return true;
+    }
+
+    bool result_archive_reader::read(const string &name, string &data)
+    {
+        const auto it{entries_.find(name)};
+
+        if (it == entries_.end())
+            return false;
+
+        uint64_t next;
+
+        if (!read_block_(it->second.block, next) || it->second.offset + it->second.size > raw_.size())
+            return false;
+
+        data.assign(raw_, it->second.offset, it->second.size);
+
+        return true;
+    }
+}
@@ -7,7 +7,13 @@
  */
 
 #include "sch_io.hpp"
+#include "sch_archive.hpp"
+#include "LP_backend.hpp"
 #include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
 
 namespace SCH
 {
@@ -41,13 +47,163 @@ namespace SCH
         sol_file= _sol_file;
     }
 
+    /**
+     * @brief Collect batch solution files from a directory or a manifest
+     */
+    void input_files::set_batch(void)
+    {
+        namespace fs = std::filesystem;
+
+        sol_files.clear();
+
+        const fs::path sol_path(sol_file);
+
+        if (fs::is_directory(sol_path))
+        {
+            for (const fs::directory_entry &entry : fs::directory_iterator(sol_path))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".sol")
+                    sol_files.push_back(entry.path().string());
+            }
+
+            sort(sol_files.begin(), sol_files.end());
+        }
+        else
+        {
+            ifstream manifest(sol_file);
+
+            if (!manifest)
+            {
+                cerr << "ERROR: Cannot open batch manifest " << sol_file << endl;
+                exit(1);
+            }
+
+            const fs::path base_path{sol_path.parent_path()};
+
+            string line;
+
+            while (getline(manifest, line))
+            {
+                // Trim spaces and carriage returns
+                const size_t first{line.find_first_not_of(" \t\r")};
+
+                if (first == string::npos || line[first] == '#')
+                    continue;
+
+                const size_t last{line.find_last_not_of(" \t\r")};
+                const fs::path c_path(line.substr(first, last - first + 1));
+
+                sol_files.push_back(c_path.is_relative() ? (base_path / c_path).string() : c_path.string());
+            }
+        }
+
+        if (sol_files.empty())
+        {
+            cerr << "ERROR: No solution files found in " << sol_file << endl;
+            exit(1);
+        }
+    }
+
+
+    /**
+     * @brief Collect the served instances from a directory or a single file
+     */
+    void input_files::set_serve(void)
+    {
+        namespace fs = std::filesystem;
+
+        ins_files.clear();
+
+        const fs::path ins_path(ins_file);
+
+        if (fs::is_directory(ins_path))
+        {
+            for (const fs::directory_entry &entry : fs::directory_iterator(ins_path))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".contsp")
+                    ins_files.push_back(entry.path().string());
+            }
+
+            sort(ins_files.begin(), ins_files.end());
+        }
+        else
+        {
+            ins_files.push_back(ins_file);
+        }
 
-    output_files::output_files(const string &_output_path, const string &_ins_file) : output_path(_output_path)
+        if (ins_files.empty())
+        {
+            cerr << "ERROR: No instance files found in " << ins_file << endl;
+            exit(1);
+        }
+    }
+
+
+    /**
+     * @brief Read the (instance, solution) pairs of a study manifest
+     */
+    void input_files::set_study(void)
+    {
+        namespace fs = std::filesystem;
+
+        study.clear();
+
+        ifstream manifest(ins_file);
+
+        if (!manifest)
+        {
+            cerr << "ERROR: Cannot open study manifest " << ins_file << endl;
+            exit(1);
+        }
+
+        const fs::path base_path{fs::path(ins_file).parent_path()};
+
+        string line;
+        size_t line_number{0};
+
+        while (getline(manifest, line))
+        {
+            line_number++;
+
+            const size_t first{line.find_first_not_of(" \t\r")};
+
+            if (first == string::npos || line[first] == '#')
+                continue;
+
+            istringstream fields(line);
+
+            string c_ins;
+            string c_sol;
+            string extra;
+
+            if (!(fields >> c_ins >> c_sol) || (fields >> extra))
+            {
+                cerr << "ERROR: Line " << line_number << " of " << ins_file << " is not an instance and a solution" << endl;
+                exit(1);
+            }
+
+            const fs::path ins_path(c_ins);
+            const fs::path sol_path(c_sol);
+
+            study.push_back(study_entry{ins_path.is_relative() ? (base_path / ins_path).string() : ins_path.string(),
+                                        sol_path.is_relative() ? (base_path / sol_path).string() : sol_path.string()});
+        }
+
+        if (study.empty())
+        {
+            cerr << "ERROR: No solution files found in " << ins_file << endl;
+            exit(1);
+        }
+    }
+
+
+    output_files::output_files(const string &_output_path, const string &_ins_file, result_archive *_archive) : output_path(_output_path),
+                                                                                                               archive(_archive)
     {
         instance_name = get_instance_name(_ins_file);
     }
 
-    output_files::output_files(void) : output_path(""), instance_name("")
+    output_files::output_files(void) : output_path(""), instance_name(""), archive(NULL)
     {
     }
 
@@ -105,6 +261,55 @@ namespace SCH
         sch_s.open(sch_file);
     }
 
+    /**
+     * @brief Default constructor - LP engine, full cycle enumeration
+     */
+    run_options::run_options(void) : engine(checker_engine::LP),
+                                     cycles(cycle_engine::PATHS),
+                                     max_cycles_per_arc(0),
+                                     max_cycles(0),
+                                     cycle_time_limit(0),
+                                     n_threads(1),
+                                     batch(false),
+                                     decompose(false),
+                                     race(false),
+                                     lp_backend(),
+                                     basis_cache_file(),
+                                     mad_sweep(),
+                                     min_mad(false),
+                                     feasibility_only(false),
+                                     shared_sources(false),
+                                     work_stealing(false),
+                                     integral_fast_path(false),
+                                     minimal_cycles(false),
+                                     lazy_distances(false),
+                                     model_cache_file(),
+                                     round_trip_times(false),
+                                     stream(false),
+                                     serve_address(),
+                                     max_sessions(0),
+                                     graph(graph_output::FULL),
+                                     graph_binary(false),
+                                     prune_duration(false),
+                                     knn_arcs(0),
+                                     stats_json(false),
+                                     trace_file(),
+                                     memory_json(false),
+                                     batch_jobs(1),
+                                     deadline(0),
+                                     shard_index(0),
+                                     n_shards(0),
+                                     merge_shards(0),
+                                     flexibility(-1),
+                                     archive(archive_output::FILES),
+                                     archive_level(3)
+    {
+    }
+
+    run_options::~run_options(void)
+    {
+    }
+
     /**
      * @brief Parse command-line arguments and configure I/O
      * @param argc Argument count
@@ -112,16 +317,26 @@ namespace SCH
      * @param sch_instance Output streams to configure
      * @param input_files_instance Input files to configure
      * @param prob_type Problem type to set (CTSP1 or CTSP2)
+     * @param options Optional settings to configure
      * 
      * Expected arguments:
      * - argv[1]: Problem type ("ctsp2" or "ctsp1")
      * - argv[2]: Instance file (.contsp)
      * - argv[3]: Solution file (.sol)
      * - argv[4]: Schedule output file (.sched.json)
+     * - argv[5..]: Options (--engine lp|diff, --cycles paths|mmc, --max-cycles-per-arc n, --max-cycles n,
+     *   --cycle-time-limit t, --threads n, --batch, --decompose, --race, --lp-backend name,
+     *   --basis-cache file, --mad-sweep from:to:step, --min-mad, --feasibility-only,
+     *   --shared-sources, --work-stealing, --integral-fast-path, --minimal-cycles, --lazy-distances, --model-cache file,
+     *   --round-trip-times, --stream, --serve address, --max-sessions n,
+     *   --graph full|certificate|cycles|none, --graph-format dot|bin, --prune-duration,
+     *   --knn-arcs k, --stats json, --trace file, --memory json, --jobs n, --deadline t,
+     *   --shard k/N|env, --merge-shards N, --flexibility h, --archive files|raw|zstd[:level])
      * 
-     * @note Exits with error if problem type is not recognized
+     * @note Exits with error if problem type or an option is not recognized,
+     *       or if the LP backend or the archive codec is not compiled in
      */
-    void set_files(int argc, char **argv, output_streams &sch_instance, input_files &input_files_instance, output_files &output_files_instance, problem_type &prob_type)
+    void set_files(int argc, char **argv, output_streams &sch_instance, input_files &input_files_instance, output_files &output_files_instance, problem_type &prob_type, run_options &options)
     {
 
         const string prob_type_s(argv[1]);
@@ -133,15 +348,430 @@ namespace SCH
         input_files_instance.set(ins_file, sol_file);
         output_files_instance.set(sch_file, ins_file);
 
-        sch_instance.set(sch_file);
-
 
         if (prob_type_s == "ctsp2")
             prob_type = problem_type::CTSP2;
+        else if (prob_type_s == "ctsp1")
+            prob_type = problem_type::CTSP1;
         else
         {
             cerr << "ERROR: Incorrect problem type" << endl;
             exit(1);
         }
+
+        // CTSP1 checks with the difference engine unless --engine is given
+        if (prob_type == problem_type::CTSP1)
+            options.engine = checker_engine::DIFFERENCE;
+
+        for (int i{5}; i < argc; i++)
+        {
+            const string option(argv[i]);
+
+            if (option == "--engine" && i + 1 < argc)
+            {
+                const string engine_s(argv[++i]);
+
+                if (engine_s == "lp")
+                    options.engine = checker_engine::LP;
+                else if (engine_s == "diff")
+                    options.engine = checker_engine::DIFFERENCE;
+                else
+                {
+                    cerr << "ERROR: Incorrect engine " << engine_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--cycles" && i + 1 < argc)
+            {
+                const string cycles_s(argv[++i]);
+
+                if (cycles_s == "paths")
+                    options.cycles = cycle_engine::PATHS;
+                else if (cycles_s == "mmc")
+                    options.cycles = cycle_engine::MIN_MEAN;
+                else
+                {
+                    cerr << "ERROR: Incorrect cycle search " << cycles_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--max-cycles-per-arc" && i + 1 < argc)
+            {
+                options.max_cycles_per_arc = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--max-cycles" && i + 1 < argc)
+            {
+                options.max_cycles = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--cycle-time-limit" && i + 1 < argc)
+            {
+                options.cycle_time_limit = atof(argv[++i]);
+            }
+            else if (option == "--threads" && i + 1 < argc)
+            {
+                options.n_threads = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--batch")
+            {
+                options.batch = true;
+            }
+            else if (option == "--decompose")
+            {
+                options.decompose = true;
+            }
+            else if (option == "--race")
+            {
+                options.race = true;
+            }
+            else if (option == "--lp-backend" && i + 1 < argc)
+            {
+                options.lp_backend = argv[++i];
+            }
+            else if (option == "--basis-cache" && i + 1 < argc)
+            {
+                options.basis_cache_file = argv[++i];
+            }
+            else if (option == "--mad-sweep" && i + 1 < argc)
+            {
+                const string sweep_s(argv[++i]);
+
+                double from{0};
+                double to{0};
+                double step{0};
+
+                if (sscanf(sweep_s.c_str(), "%lf:%lf:%lf", &from, &to, &step) != 3 || step <= 0 || from < 0 || to < from)
+                {
+                    cerr << "ERROR: Incorrect differential sweep " << sweep_s << endl;
+                    exit(1);
+                }
+
+                options.mad_sweep.clear();
+
+                for (size_t k{0}; from + k * step <= to + 1E-9; k++)
+                    options.mad_sweep.push_back(from + k * step);
+            }
+            else if (option == "--min-mad")
+            {
+                options.min_mad = true;
+            }
+            else if (option == "--feasibility-only")
+            {
+                options.feasibility_only = true;
+            }
+            else if (option == "--shared-sources")
+            {
+                options.shared_sources = true;
+            }
+            else if (option == "--work-stealing")
+            {
+                options.work_stealing = true;
+            }
+            else if (option == "--integral-fast-path")
+            {
+                options.integral_fast_path = true;
+            }
+            else if (option == "--minimal-cycles")
+            {
+                options.minimal_cycles = true;
+            }
+            else if (option == "--lazy-distances")
+            {
+                options.lazy_distances = true;
+            }
+            else if (option == "--model-cache" && i + 1 < argc)
+            {
+                options.model_cache_file = argv[++i];
+            }
+            else if (option == "--round-trip-times")
+            {
+                options.round_trip_times = true;
+            }
+            else if (option == "--stream")
+            {
+                options.stream = true;
+            }
+            else if (option == "--serve" && i + 1 < argc)
+            {
+                options.serve_address = argv[++i];
+            }
+            else if (option == "--max-sessions" && i + 1 < argc)
+            {
+                options.max_sessions = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--graph" && i + 1 < argc)
+            {
+                const string graph_s(argv[++i]);
+
+                if (graph_s == "full")
+                    options.graph = graph_output::FULL;
+                else if (graph_s == "certificate")
+                    options.graph = graph_output::CERTIFICATE;
+                else if (graph_s == "cycles")
+                    options.graph = graph_output::CYCLES;
+                else if (graph_s == "none")
+                    options.graph = graph_output::NONE;
+                else
+                {
+                    cerr << "ERROR: Incorrect graph output " << graph_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--graph-format" && i + 1 < argc)
+            {
+                const string format_s(argv[++i]);
+
+                if (format_s == "dot")
+                    options.graph_binary = false;
+                else if (format_s == "bin")
+                    options.graph_binary = true;
+                else
+                {
+                    cerr << "ERROR: Incorrect graph format " << format_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--prune-duration")
+            {
+                options.prune_duration = true;
+            }
+            else if (option == "--knn-arcs" && i + 1 < argc)
+            {
+                options.knn_arcs = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--stats" && i + 1 < argc)
+            {
+                const string format_s(argv[++i]);
+
+                if (format_s == "json")
+                    options.stats_json = true;
+                else
+                {
+                    cerr << "ERROR: Incorrect stats format " << format_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--trace" && i + 1 < argc)
+            {
+                options.trace_file = argv[++i];
+            }
+            else if (option == "--memory" && i + 1 < argc)
+            {
+                const string format_s(argv[++i]);
+
+                if (format_s == "json")
+                    options.memory_json = true;
+                else
+                {
+                    cerr << "ERROR: Incorrect memory format " << format_s << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--jobs" && i + 1 < argc)
+            {
+                options.batch_jobs = (size_t)atol(argv[++i]);
+            }
+            else if (option == "--deadline" && i + 1 < argc)
+            {
+                options.deadline = atof(argv[++i]);
+
+                if (options.deadline < 0)
+                {
+                    cerr << "ERROR: Incorrect deadline " << argv[i] << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--flexibility" && i + 1 < argc)
+            {
+                options.flexibility = atof(argv[++i]);
+
+                if (options.flexibility < 0)
+                {
+                    cerr << "ERROR: Incorrect flexibility horizon " << argv[i] << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--shard" && i + 1 < argc)
+            {
+                const string shard_s(argv[++i]);
+
+                if (shard_s == "env")
+                {
+                    // Rank and size of the launcher (srun, mpirun) of this process
+                    static const char *const rank_size[][2]{{"SLURM_PROCID", "SLURM_NTASKS"},
+                                                            {"OMPI_COMM_WORLD_RANK", "OMPI_COMM_WORLD_SIZE"},
+                                                            {"PMI_RANK", "PMI_SIZE"}};
+
+                    for (const auto &names : rank_size)
+                    {
+                        const char *const rank{getenv(names[0])};
+                        const char *const size{getenv(names[1])};
+
+                        if (rank != nullptr && size != nullptr)
+                        {
+                            options.shard_index = (size_t)atol(rank);
+                            options.n_shards = (size_t)atol(size);
+                            break;
+                        }
+                    }
+
+                    if (options.n_shards == 0)
+                    {
+                        cerr << "ERROR: --shard env needs SLURM_PROCID/SLURM_NTASKS, OMPI_COMM_WORLD_RANK/OMPI_COMM_WORLD_SIZE or PMI_RANK/PMI_SIZE" << endl;
+                        exit(1);
+                    }
+                }
+                else
+                {
+                    long index{-1};
+                    long count{0};
+                    char end{0};
+
+                    if (sscanf(shard_s.c_str(), "%ld/%ld%c", &index, &count, &end) != 2 || count <= 0 || index < 0)
+                    {
+                        cerr << "ERROR: Incorrect shard " << shard_s << endl;
+                        exit(1);
+                    }
+
+                    options.shard_index = (size_t)index;
+                    options.n_shards = (size_t)count;
+                }
+
+                if (options.shard_index >= options.n_shards)
+                {
+                    cerr << "ERROR: Incorrect shard " << options.shard_index << " of " << options.n_shards << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--merge-shards" && i + 1 < argc)
+            {
+                options.merge_shards = (size_t)atol(argv[++i]);
+
+                if (options.merge_shards == 0)
+                {
+                    cerr << "ERROR: Incorrect shard count " << argv[i] << endl;
+                    exit(1);
+                }
+            }
+            else if (option == "--archive" && i + 1 < argc)
+            {
+                const string archive_s(argv[++i]);
+                const string codec_s{archive_s.substr(0, archive_s.find(':'))};
+
+                if (codec_s == "files" && codec_s == archive_s)
+                    options.archive = archive_output::FILES;
+                else if (codec_s == "raw" && codec_s == archive_s)
+                    options.archive = archive_output::RAW;
+                else if (codec_s == "zstd")
+                {
+                    options.archive = archive_output::ZSTD;
+
+                    if (codec_s != archive_s)
+                        options.archive_level = atoi(archive_s.c_str() + codec_s.size() + 1);
+
+                    if (options.archive_level < 1 || options.archive_level > 19)
+                    {
+                        cerr << "ERROR: Incorrect zstd level " << archive_s << endl;
+                        exit(1);
+                    }
+
+                    if (!result_archive::has_codec(archive_codec::ZSTD))
+                    {
+                        cerr << "ERROR: zstd archives need a build with USE_ZSTD" << endl;
+                        exit(1);
+                    }
+                }
+                else
+                {
+                    cerr << "ERROR: Incorrect archive output " << archive_s << endl;
+                    exit(1);
+                }
+            }
+            else
+            {
+                cerr << "ERROR: Incorrect option " << option << endl;
+                exit(1);
+            }
+        }
+
+        if (options.stream && options.batch)
+        {
+            cerr << "ERROR: --stream and --batch cannot be combined" << endl;
+            exit(1);
+        }
+
+        if (!options.serve_address.empty() && (options.stream || options.batch))
+        {
+            cerr << "ERROR: --serve cannot be combined with --stream or --batch" << endl;
+            exit(1);
+        }
+
+        const bool shard_mode{options.n_shards > 0 || options.merge_shards > 0};
+
+        if (options.n_shards > 0 && options.merge_shards > 0)
+        {
+            cerr << "ERROR: --shard and --merge-shards cannot be combined" << endl;
+            exit(1);
+        }
+
+        // A shard is a batch run per instance of the study manifest
+        if (shard_mode && (options.stream || options.batch || !options.serve_address.empty()))
+        {
+            cerr << "ERROR: --shard and --merge-shards cannot be combined with --stream, --batch or --serve" << endl;
+            exit(1);
+        }
+
+        if (options.batch_jobs != 1 && !options.batch && options.n_shards == 0)
+        {
+            cerr << "ERROR: --jobs requires --batch or --shard" << endl;
+            exit(1);
+        }
+
+        // The differential analyses change the model the workers share
+        if (options.batch_jobs != 1 && (!options.mad_sweep.empty() || options.min_mad))
+        {
+            cerr << "ERROR: --jobs cannot be combined with --mad-sweep or --min-mad" << endl;
+            exit(1);
+        }
+
+        // One report per solution file, next to its schedule
+        if (options.flexibility >= 0 && (options.stream || options.batch || !options.serve_address.empty() || shard_mode))
+        {
+            cerr << "ERROR: --flexibility cannot be combined with --stream, --batch, --serve or --shard" << endl;
+            exit(1);
+        }
+
+        // One archive per batch run or per shard
+        if (options.archive != archive_output::FILES && !options.batch && options.n_shards == 0)
+        {
+            cerr << "ERROR: --archive requires --batch or --shard" << endl;
+            exit(1);
+        }
+
+        // Stream, server and shard modes write no single file: argv[3] and argv[4] are not opened
+        if (!options.stream && options.serve_address.empty() && !shard_mode)
+            sch_instance.set(sch_file);
+
+        // Every sync_checker_solver created from now on uses this backend
+        if (!options.lp_backend.empty())
+            GOMA::LP_backend_registry::set_default(options.lp_backend);
+
+        // HiGHS has no primal objective limit: the checker LP would run to optimality anyway
+        if (options.feasibility_only && GOMA::LP_backend_registry::get_default() == "highs")
+        {
+            cerr << "ERROR: --feasibility-only is not supported by the HiGHS backend" << endl;
+            exit(1);
+        }
+
+        // argv[3] is a manifest or a directory of solutions
+        if (options.batch)
+            input_files_instance.set_batch();
+
+        // argv[2] is an instance or a directory of instances
+        if (!options.serve_address.empty())
+            input_files_instance.set_serve();
+
+        // argv[2] is a study manifest of (instance, solution) pairs
+        if (shard_mode)
+            input_files_instance.set_study();
     }
 }
\ No newline at end of file
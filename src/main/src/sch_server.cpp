@@ -0,0 +1,500 @@
+/**
+ * @file sch_server.cpp
+ * @brief Implementation of the separation server
+ */
+
+#include "sch_server.hpp"
+#include "schedulers.hpp"
+
+#include "json_format_io.hpp"
+#include "trace_recorder.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+
+#include <unistd.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace SCH
+{
+    /// Largest accepted request payload (bytes)
+    static const uint32_t MAX_REQUEST_SIZE{1u << 26};
+
+    /// Set by SIGINT / SIGTERM when the server stops on them (--trace)
+    static volatile sig_atomic_t stop_requested{0};
+
+    static void request_stop(int)
+    {
+        stop_requested = 1;
+    }
+
+    /**
+     * @brief Read exactly n bytes
+     * @return false if the connection is closed or fails first
+     */
+    static bool read_all(const int fd, char *data, size_t n)
+    {
+        while (n > 0)
+        {
+            const ssize_t n_read{recv(fd, data, n, 0)};
+
+            if (n_read < 0 && errno == EINTR)
+                continue;
+
+            if (n_read <= 0)
+                return false;
+
+            data += n_read;
+            n -= n_read;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Write exactly n bytes
+     * @return false if the connection is closed or fails first
+     */
+    static bool write_all(const int fd, const char *data, size_t n)
+    {
+        while (n > 0)
+        {
+            const ssize_t n_written{send(fd, data, n, MSG_NOSIGNAL)};
+
+            if (n_written < 0 && errno == EINTR)
+                continue;
+
+            if (n_written <= 0)
+                return false;
+
+            data += n_written;
+            n -= n_written;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Read one frame (4 byte big-endian length, payload)
+     * @param payload Output: payload (capacity kept between frames)
+     * @return false if the connection is closed or the frame is too large
+     */
+    static bool read_frame(const int fd, vector<char> &payload)
+    {
+        unsigned char header[4];
+
+        if (!read_all(fd, (char *)header, 4))
+            return false;
+
+        const uint32_t size{((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | (uint32_t)header[3]};
+
+        if (size > MAX_REQUEST_SIZE)
+            return false;
+
+        payload.resize(size);
+
+        return read_all(fd, payload.data(), size);
+    }
+
+    /**
+     * @brief Write one frame
+     */
+    static bool write_frame(const int fd, const char *payload, const size_t size)
+    {
+        const unsigned char header[4]{(unsigned char)(size >> 24), (unsigned char)(size >> 16), (unsigned char)(size >> 8), (unsigned char)size};
+
+        return write_all(fd, (const char *)header, 4) && write_all(fd, payload, size);
+    }
+
+    served_instance::served_instance(unique_ptr<SYNC_LIB::sync_model_a_builder> _builder) : builder(move(_builder)),
+                                                                                            idle_mutex(),
+                                                                                            idle_cv(),
+                                                                                            idle(),
+                                                                                            n_sessions(0)
+    {
+    }
+
+    served_instance::~served_instance(void)
+    {
+    }
+
+    sch_server::sch_server(const run_options &options) : options_(options),
+                                                         max_sessions_(options.max_sessions),
+                                                         instances_(),
+                                                         build_mutex_()
+    {
+        if (max_sessions_ == 0)
+            max_sessions_ = max(1u, thread::hardware_concurrency());
+    }
+
+    sch_server::~sch_server(void)
+    {
+    }
+
+    void sch_server::add_instance(unique_ptr<SYNC_LIB::sync_model_a_builder> builder)
+    {
+        instances_.push_back(unique_ptr<served_instance>(new served_instance(move(builder))));
+    }
+
+    int sch_server::serve(const string &address)
+    {
+        // A client closing early must not stop the server
+        signal(SIGPIPE, SIG_IGN);
+
+        const int listen_fd{listen_(address)};
+
+        if (listen_fd < 0)
+            return 1;
+
+        // The trace is written on return: stop on SIGINT / SIGTERM. No
+        // SA_RESTART, so the signal interrupts accept()
+        const bool stop_on_signal{!options_.trace_file.empty()};
+
+        sigset_t stop_signals;
+        sigemptyset(&stop_signals);
+        sigaddset(&stop_signals, SIGINT);
+        sigaddset(&stop_signals, SIGTERM);
+
+        if (stop_on_signal)
+        {
+            struct sigaction action;
+            memset(&action, 0, sizeof(action));
+            action.sa_handler = request_stop;
+            sigemptyset(&action.sa_mask);
+
+            sigaction(SIGINT, &action, NULL);
+            sigaction(SIGTERM, &action, NULL);
+        }
+
+        cout << "Serving " << instances_.size() << " instance(s) on " << address
+             << " (" << max_sessions_ << " sessions per instance)" << endl;
+
+        while (stop_requested == 0)
+        {
+            const int fd{accept(listen_fd, NULL, NULL)};
+
+            if (fd < 0)
+            {
+                if (errno != EINTR)
+                    cerr << "WARNING: accept: " << strerror(errno) << endl;
+
+                continue;
+            }
+
+            // Requests and responses are small: do not wait to fill segments
+            const int one{1};
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            // Client threads (and their workers) inherit the blocked signals:
+            // only this thread is interrupted
+            sigset_t old_signals;
+
+            if (stop_on_signal)
+                pthread_sigmask(SIG_BLOCK, &stop_signals, &old_signals);
+
+            thread(&sch_server::client_, this, fd).detach();
+
+            if (stop_on_signal)
+                pthread_sigmask(SIG_SETMASK, &old_signals, NULL);
+        }
+
+        close(listen_fd);
+
+        cout << "Server stopped" << endl;
+
+        return 0;
+    }
+
+    int sch_server::listen_(const string &address)
+    {
+        if (address.compare(0, 5, "unix:") == 0)
+        {
+            const string path{address.substr(5)};
+
+            sockaddr_un addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+
+            if (path.empty() || path.size() >= sizeof(addr.sun_path))
+            {
+                cerr << "ERROR: Incorrect socket path " << path << endl;
+                return -1;
+            }
+
+            memcpy(addr.sun_path, path.c_str(), path.size());
+
+            const int fd{socket(AF_UNIX, SOCK_STREAM, 0)};
+
+            // A socket file left by a previous server is replaced
+            unlink(path.c_str());
+
+            if (fd < 0 || bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0)
+            {
+                cerr << "ERROR: Cannot listen on " << address << ": " << strerror(errno) << endl;
+
+                if (fd >= 0)
+                    close(fd);
+
+                return -1;
+            }
+
+            return fd;
+        }
+
+        const size_t colon{address.find_last_of(':')};
+
+        if (colon == string::npos)
+        {
+            cerr << "ERROR: Incorrect address " << address << " (unix:path or host:port expected)" << endl;
+            return -1;
+        }
+
+        const string host{address.substr(0, colon)};
+        const string port{address.substr(colon + 1)};
+
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+
+        addrinfo *res{NULL};
+
+        const int gai_error{getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &res)};
+
+        if (gai_error != 0)
+        {
+            cerr << "ERROR: Cannot resolve " << address << ": " << gai_strerror(gai_error) << endl;
+            return -1;
+        }
+
+        int fd{-1};
+
+        for (addrinfo *ai{res}; ai != NULL && fd < 0; ai = ai->ai_next)
+        {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+
+            if (fd < 0)
+                continue;
+
+            const int one{1};
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+            if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || listen(fd, SOMAXCONN) != 0)
+            {
+                close(fd);
+                fd = -1;
+            }
+        }
+
+        freeaddrinfo(res);
+
+        if (fd < 0)
+            cerr << "ERROR: Cannot listen on " << address << ": " << strerror(errno) << endl;
+
+        return fd;
+    }
+
+    void sch_server::client_(const int fd)
+    {
+        // Connection scratch, reused by every request
+        vector<char> request;
+
+        SYNC_LIB::sync_solution_parser solution_parser;
+        SYNC_LIB::sync_solution solution;
+        SYNC_LIB::sync_cuts cuts;
+
+        SYNC_LIB::json_buffer response;
+        response.set_round_trip(options_.round_trip_times);
+
+        while (read_frame(fd, request))
+        {
+            GOMA::trace_scope trace("request", "server");
+
+            response.clear();
+
+            const request_type type{static_cast<request_type>(request.empty() ? '\0' : request[0])};
+
+            if (type != request_type::CHECK && type != request_type::SCHEDULE && type != request_type::SEPARATE)
+            {
+                put_error_(response, "unknown request type");
+            }
+            else if (!solution_parser.parse(request.data() + 1, request.data() + request.size(), solution))
+            {
+                put_error_(response, solution_parser.get_error());
+            }
+            else
+            {
+                served_instance *instance{find_instance_(solution.get_instance_name())};
+
+                if (instance == NULL)
+                    put_error_(response, "instance " + solution.get_instance_name() + " not served");
+                else
+                    answer_(*instance, type, solution.get_routes(), cuts, response);
+            }
+
+            if (!write_frame(fd, response.data(), response.size()))
+                break;
+        }
+
+        close(fd);
+    }
+
+    void sch_server::answer_(served_instance &instance, const request_type type, const vector<vector<int>> &routes,
+                             SYNC_LIB::sync_cuts &cuts, SYNC_LIB::json_buffer &response)
+    {
+        unique_ptr<SYNC_LIB::scheduling_session> session{acquire_(instance)};
+
+        try
+        {
+            bool feasible{false};
+            {
+                GOMA::trace_scope trace("session_check", "server");
+                feasible = session->check(routes);
+            }
+
+            GOMA::trace_scope trace("format_response", "server");
+
+            response.put(feasible ? "{\"feasible\": true" : "{\"feasible\": false");
+
+            // Cut short by --deadline: no proof, or only the cycles found in time
+            if (!feasible && session->get_infeasible().truncated())
+                response.put(", \"truncated\": true");
+
+            if (type == request_type::SCHEDULE)
+            {
+                if (feasible)
+                {
+                    response.put(", \"schedule\": ");
+                    SYNC_LIB::json_format_io().write_compact_scheduling(response, session->get_schedule());
+                }
+                else
+                {
+                    response.put(", \"cycles\": ");
+                    session->get_infeasible().write_json_cycles(response);
+                }
+            }
+            else if (type == request_type::SEPARATE)
+            {
+                cuts.clear();
+
+                if (!feasible)
+                    session->get_infeasible().get_cuts(cuts);
+
+                response.put(", \"cuts\": [");
+
+                // Unit coefficients, sense 'L'
+                for (int k{0}; k < cuts.get_n_cuts(); k++)
+                {
+                    if (k > 0)
+                        response.put(", ");
+
+                    response.put("{\"ind\": [");
+
+                    for (int l{cuts.get_rmatbeg()[k]}; l < cuts.get_rmatbeg()[k + 1]; l++)
+                    {
+                        if (l > cuts.get_rmatbeg()[k])
+                            response.put(", ");
+
+                        response.put_int(cuts.get_rmatind()[l]);
+                    }
+
+                    response.put("], \"rhs\": ");
+                    response.put_int((long long)cuts.get_rhs()[k]);
+                    response.put('}');
+                }
+
+                response.put(']');
+            }
+
+            response.put('}');
+        }
+        catch (const invalid_argument &e)
+        {
+            response.clear();
+            put_error_(response, e.what());
+        }
+        catch (const exception &e)
+        {
+            // A failed request must not stop the server nor keep its session
+            response.clear();
+            put_error_(response, string("check failed: ") + e.what());
+        }
+
+        release_(instance, move(session));
+    }
+
+    served_instance *sch_server::find_instance_(const string &instance_name)
+    {
+        if (instance_name.empty())
+            return instances_.size() == 1 ? instances_[0].get() : NULL;
+
+        for (const unique_ptr<served_instance> &instance : instances_)
+        {
+            if (instance->builder->get_instance_name() == instance_name)
+                return instance.get();
+        }
+
+        return NULL;
+    }
+
+    unique_ptr<SYNC_LIB::scheduling_session> sch_server::acquire_(served_instance &instance)
+    {
+        {
+            // Time waiting for a session of the instance
+            GOMA::trace_scope trace("acquire_session", "server");
+
+            unique_lock<mutex> lock(instance.idle_mutex);
+
+            instance.idle_cv.wait(lock, [&]
+                                  { return !instance.idle.empty() || instance.n_sessions < max_sessions_; });
+
+            if (!instance.idle.empty())
+            {
+                unique_ptr<SYNC_LIB::scheduling_session> session{move(instance.idle.back())};
+                instance.idle.pop_back();
+
+                return session;
+            }
+
+            instance.n_sessions++;
+        }
+
+        // Built outside the idle lock: the other sessions keep serving
+        GOMA::trace_scope trace("build_session", "server");
+
+        lock_guard<mutex> build_lock(build_mutex_);
+
+        unique_ptr<SYNC_LIB::scheduling_session> session(new SYNC_LIB::scheduling_session(*instance.builder, 1e-6, get_sync_engine(options_)));
+        set_scheduler_options(session->get_scheduler(), options_);
+
+        return session;
+    }
+
+    void sch_server::release_(served_instance &instance, unique_ptr<SYNC_LIB::scheduling_session> session)
+    {
+        {
+            lock_guard<mutex> lock(instance.idle_mutex);
+            instance.idle.push_back(move(session));
+        }
+
+        instance.idle_cv.notify_one();
+    }
+
+    void sch_server::put_error_(SYNC_LIB::json_buffer &response, const string &message)
+    {
+        // Messages hold no quotes nor backslashes but the instance name,
+        // which keeps the escapes of the request
+        response.put("{\"error\": \"");
+        response.put(message);
+        response.put("\"}");
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ * @file sch_shards.cpp
+ * @brief Implementation of the shard plan and the shard result files
+ */
+
+#include "sch_shards.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace SCH
+{
+    shard_plan::shard_plan(const vector<study_entry> &study, const size_t n_shards) : n_shards_(n_shards),
+                                                                                      instances_(),
+                                                                                      entries_(),
+                                                                                      shard_(),
+                                                                                      load_(n_shards, 0)
+    {
+        // Instances as written in the manifest: every node sees the same paths
+        map<string, size_t> instance_index;
+
+        for (size_t e{0}; e < study.size(); e++)
+        {
+            const auto inserted{instance_index.emplace(study[e].ins_file, instances_.size())};
+
+            if (inserted.second)
+            {
+                instances_.push_back(study[e].ins_file);
+                entries_.emplace_back();
+            }
+
+            entries_[inserted.first->second].push_back(e);
+        }
+
+        // Largest instances first, each to the least loaded shard
+        vector<size_t> order(instances_.size());
+
+        for (size_t i{0}; i < order.size(); i++)
+            order[i] = i;
+
+        stable_sort(order.begin(), order.end(), [this](const size_t a, const size_t b)
+                    { return entries_[a].size() > entries_[b].size(); });
+
+        shard_.assign(instances_.size(), 0);
+
+        for (const size_t i : order)
+        {
+            const size_t shard{(size_t)(min_element(load_.begin(), load_.end()) - load_.begin())};
+
+            shard_[i] = shard;
+            load_[shard] += entries_[i].size();
+        }
+    }
+
+    shard_plan::~shard_plan(void)
+    {
+    }
+
+    vector<size_t> shard_plan::get_instances(const size_t shard) const
+    {
+        vector<size_t> instances;
+
+        for (size_t i{0}; i < instances_.size(); i++)
+            if (shard_[i] == shard)
+                instances.push_back(i);
+
+        return instances;
+    }
+
+    string shard_plan::get_result_file(const string &output_path, const size_t shard, const size_t n_shards)
+    {
+        return (std::filesystem::path(output_path) / ("shard-" + to_string(shard) + "-of-" + to_string(n_shards) + ".tsv")).string();
+    }
+
+    string shard_plan::get_archive_file(const string &output_path, const size_t shard, const size_t n_shards)
+    {
+        return (std::filesystem::path(output_path) / ("shard-" + to_string(shard) + "-of-" + to_string(n_shards) + ".ctspa")).string();
+    }
+
+    bool write_shard_results(const string &result_file, const vector<study_entry> &study, const vector<shard_result> &results)
+    {
+        const string tmp_file{result_file + ".tmp"};
+
+        {
+            ofstream os(tmp_file);
+
+            if (!os)
+                return false;
+
+            os << "# line\tresult\ttime_s\tinstance\tsolution" << endl;
+
+            for (const shard_result &result : results)
+                os << result.index << '\t' << (result.failed ? "error" : result.feasible ? "feasible" : "infeasible") << '\t' << result.c_time << '\t'
+                   << study[result.index].ins_file << '\t' << study[result.index].sol_file << '\n';
+
+            if (!os.flush())
+                return false;
+        }
+
+        return rename(tmp_file.c_str(), result_file.c_str()) == 0;
+    }
+
+    int merge_shard_results(const vector<study_entry> &study, const string &output_path, const size_t n_shards)
+    {
+        // Result line and shard of each study entry (empty: not checked)
+        vector<string> lines(study.size());
+        vector<size_t> shards(study.size(), 0);
+
+        for (size_t k{0}; k < n_shards; k++)
+        {
+            const string result_file{shard_plan::get_result_file(output_path, k, n_shards)};
+
+            ifstream is(result_file);
+
+            if (!is)
+            {
+                cerr << "ERROR: Cannot open shard result file " << result_file << endl;
+                return 1;
+            }
+
+            string line;
+
+            while (getline(is, line))
+            {
+                if (line.empty() || line[0] == '#')
+                    continue;
+
+                istringstream fields(line);
+
+                size_t index{0};
+                string result;
+                double c_time{0};
+                string ins_file;
+                string sol_file;
+
+                fields >> index >> result >> c_time;
+                fields.ignore(1);
+                getline(fields, ins_file, '\t');
+                getline(fields, sol_file);
+
+                // A manifest edited since the run would merge other solutions
+                if (!fields || index >= study.size() || study[index].ins_file != ins_file || study[index].sol_file != sol_file)
+                {
+                    cerr << "ERROR: " << result_file << " does not match the study manifest: " << line << endl;
+                    return 1;
+                }
+
+                if (!lines[index].empty())
+                {
+                    cerr << "ERROR: Line " << index << " of the study is in two shard result files" << endl;
+                    return 1;
+                }
+
+                lines[index] = line;
+                shards[index] = k;
+            }
+        }
+
+        const string merged_file{(std::filesystem::path(output_path) / "results.tsv").string()};
+
+        ofstream os(merged_file);
+
+        if (!os)
+        {
+            cerr << "ERROR: Cannot write " << merged_file << endl;
+            return 1;
+        }
+
+        os << "# line\tresult\ttime_s\tinstance\tsolution\tshard" << endl;
+
+        size_t n_feasible{0};
+        size_t n_failed{0};
+
+        for (size_t e{0}; e < study.size(); e++)
+        {
+            if (lines[e].empty())
+            {
+                cerr << "ERROR: No shard result for " << study[e].sol_file << " (" << study[e].ins_file << ")" << endl;
+                return 1;
+            }
+
+            if (lines[e].find("\tfeasible\t") != string::npos)
+                n_feasible++;
+            else if (lines[e].find("\terror\t") != string::npos)
+                n_failed++;
+
+            os << lines[e] << '\t' << shards[e] << '\n';
+        }
+
+        cout << "Merged " << n_shards << " shards into " << merged_file << endl;
+        cout << "Solutions           : " << study.size() << endl;
+        cout << "Feasible            : " << n_feasible << endl;
+        cout << "Infeasible          : " << study.size() - n_feasible - n_failed << endl;
+        cout << "Failed              : " << n_failed << endl;
+
+        return 0;
+    }
+}
@@ -17,20 +17,248 @@
 #include "sync_model_a_builder.hpp"
 #include "CTSP_model_a_builder.hpp"
 #include "model_a_solution_interface.hpp"
+#include "sparse_x.hpp"
+#include "sync_model_cache.hpp"
+#include "sync_model_family.hpp"
+#include "sync_solution_parser.hpp"
+#include "sch_server.hpp"
+#include "sch_shards.hpp"
+#include "sch_archive.hpp"
+#include "json_format_io.hpp"
 
 #include "sol_2_scheduling.hpp"
+#include "sync_stats.hpp"
+#include "sync_memory.hpp"
+#include "stats_timer.hpp"
+#include "trace_recorder.hpp"
+#include "memory_usage.hpp"
+#include "bounded_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <thread>
 
 namespace SCH
 {
 
+    void set_scheduler_options(SYNC_LIB::conTSP2_scheduling &scheduler, const SCH::run_options &options)
+    {
+        // Bound the violated cycle search (no limits: all cycles)
+        scheduler.get_path_finder().set_limits(options.max_cycles_per_arc, options.max_cycles, options.cycle_time_limit);
+        scheduler.get_path_finder().set_n_threads(options.n_threads);
+        scheduler.get_path_finder().set_shared_sources(options.shared_sources);
+        scheduler.get_path_finder().set_work_stealing(options.work_stealing);
+        scheduler.get_path_finder().set_integral_fast_path(options.integral_fast_path);
+
+        scheduler.set_decomposition(options.decompose, options.n_threads);
+        scheduler.set_race(options.race);
+        scheduler.set_feasibility_only(options.feasibility_only);
+
+        // Each solve() stops at the deadline with the cycles found so far
+        scheduler.set_time_limit(options.deadline);
+
+        // The minimum mean cycle search keeps --max-cycles cycles (0: one per component)
+        scheduler.set_cycle_search(options.cycles == SCH::cycle_engine::MIN_MEAN ? SYNC_LIB::cycle_search::MIN_MEAN : SYNC_LIB::cycle_search::PATHS);
+        scheduler.get_mean_cycle_finder().set_max_cycles(options.max_cycles);
+
+        // Shorter, dominating cuts from every cycle search
+        scheduler.set_minimal_cycles(options.minimal_cycles);
+    }
+
+    /**
+     * @brief Attach the basis cache file of the run options to a scheduler
+     * @param scheduler Scheduler using the cache
+     * @param cache Cache to fill from the file (must outlive the checks)
+     * @param options Optional settings (basis cache file)
+     */
+    static void load_basis_cache(SYNC_LIB::conTSP2_scheduling &scheduler, SYNC_LIB::lp_basis_cache &cache, const SCH::run_options &options)
+    {
+        if (options.basis_cache_file.empty())
+            return;
+
+        // A missing file or a file of another instance leaves the cache empty
+        cache.set_instance_key(scheduler.get_instance_key());
+        cache.load(options.basis_cache_file);
+
+        scheduler.set_basis_cache(&cache);
+    }
+
+    /**
+     * @brief Write the basis cache back to the file of the run options
+     * @param cache Cache filled by the checks
+     * @param options Optional settings (basis cache file)
+     */
+    static void save_basis_cache(const SYNC_LIB::lp_basis_cache &cache, const SCH::run_options &options)
+    {
+        if (options.basis_cache_file.empty())
+            return;
+
+        if (!cache.save(options.basis_cache_file))
+            cerr << "WARNING: Cannot write basis cache " << options.basis_cache_file << endl;
+    }
+
+    /**
+     * @brief Stream for progress messages
+     * @param options Optional settings
+     * @return cerr in stream mode (stdout carries the results only), else cout
+     */
+    static ostream &log_stream(const SCH::run_options &options)
+    {
+        return options.stream ? cerr : cout;
+    }
+
+    /**
+     * @brief Report the differential analysis of the run options for one solution
+     * @param scheduler Scheduler built from builder
+     * @param builder Model builder (its differential is restored on return)
+     * @param x Solution in model_a format
+     * @param label Solution name printed before the results
+     * @param options Optional settings (differential sweep, minimal differential)
+     */
+    static void report_differential(SYNC_LIB::conTSP2_scheduling &scheduler, SYNC_LIB::sync_model_a_builder &builder, const vector<double> &x, const string &label, const SCH::run_options &options)
+    {
+        if (!options.mad_sweep.empty())
+        {
+            vector<bool> feasible;
+            scheduler.sweep_time_windows_max_size(builder, x, options.mad_sweep, feasible);
+
+            ostream &log{log_stream(options)};
+
+            log << label << " : differential sweep" << endl;
+
+            for (size_t i{0}; i < feasible.size(); i++)
+                log << "  " << options.mad_sweep[i] << " : " << (feasible[i] ? "feasible" : "infeasible") << endl;
+        }
+
+        if (options.min_mad)
+        {
+            size_t n_checks{0};
+            const double min_mad{scheduler.get_min_time_windows_max_size(builder, x, n_checks)};
+
+            log_stream(options) << label << " : minimal differential " << min_mad << " (" << n_checks << " checks)" << endl;
+        }
+    }
+
+    /**
+     * @brief Write the start time windows of a feasible solution (--flexibility h)
+     * @param scheduler Scheduler built from the model of x
+     * @param output_files Output directory and instance name (.flex.json)
+     * @param feas_sol Solution (header of the file)
+     * @param x Solution in model_a format
+     * @param json_buffer Output buffer
+     * @param options Optional settings (horizon)
+     */
+    static void write_flexibility(SYNC_LIB::conTSP2_scheduling &scheduler, const SCH::output_files &output_files, const SYNC_LIB::sync_solution &feas_sol, const vector<double> &x, SYNC_LIB::json_buffer &json_buffer, const SCH::run_options &options)
+    {
+        SYNC_LIB::sync_flexibility flexibility;
+
+        // 0: the earliest completion of the routing
+        const double horizon{options.flexibility > 0 ? options.flexibility : -1.0};
+
+        if (!scheduler.get_flexibility(feas_sol.get_instance_name(), x, flexibility, horizon))
+        {
+            cerr << "WARNING: The schedule does not fit in the flexibility horizon " << options.flexibility << endl;
+            return;
+        }
+
+        std::ofstream flexibility_file(output_files.output_path + "/" + output_files.instance_name + ".flex.json");
+
+        json_buffer.open(flexibility_file);
+        feas_sol.write_header(json_buffer);
+        flexibility.write_json(json_buffer);
+        feas_sol.write_end(json_buffer);
+        json_buffer.close();
+
+        flexibility_file.close();
+    }
+
+    SYNC_LIB::sync_engine get_sync_engine(const SCH::run_options &options)
+    {
+        return options.engine == SCH::checker_engine::DIFFERENCE ? SYNC_LIB::sync_engine::DIFFERENCE : SYNC_LIB::sync_engine::LP;
+    }
+
+    /**
+     * @brief Write one result file, or append it to the archive of the run
+     * @param output_files Output directory, file name prefix and archive
+     * @param suffix File name suffix (e.g. `.sched.json`)
+     * @param mode Open mode of the file
+     * @param write Writes the contents to an ostream
+     */
+    template <typename F>
+    static void write_result_file(const SCH::output_files &output_files, const string &suffix, const ios::openmode mode, F write)
+    {
+        if (output_files.archive != NULL)
+        {
+            write(output_files.archive->begin_record());
+            output_files.archive->end_record(output_files.archive->get_record_name(output_files.output_path, output_files.instance_name + suffix));
+            return;
+        }
+
+        std::ofstream result_file(output_files.output_path + "/" + output_files.instance_name + suffix, mode);
+        write(result_file);
+        result_file.close();
+    }
+
+    void write_schedule_results(const SCH::output_files &output_files,
+                                const SYNC_LIB::sync_solution &feas_sol,
+                                const bool feasible,
+                                const SYNC_LIB::sync_scheduling &feasible_schedule,
+                                const SYNC_LIB::sync_infeasible &infeasible_paths,
+                                SYNC_LIB::json_buffer &json_buffer,
+                                const SCH::run_options &options)
+    {
+        if (feasible)
+        {
+            write_result_file(output_files, ".sched.json", ios::out, [&](ostream &schedule_file)
+                              {
+                                  // Write schedule to JSON output (one block write per 64 KiB)
+                                  json_buffer.open(schedule_file);
+                                  feas_sol.write_header(json_buffer);
+                                  json_buffer.put('\n');
+                                  feasible_schedule.write_json(json_buffer);
+                                  feas_sol.write_end(json_buffer);
+                                  json_buffer.close(); });
+        }
+        else
+        {
+            write_result_file(output_files, ".infeas_paths.txt", ios::out, [&](ostream &infeasible_paths_file)
+                              { infeasible_paths.write_infeasible_paths(infeasible_paths_file); });
+
+            if (options.graph == SCH::graph_output::NONE)
+                return;
+
+            const SYNC_LIB::graph_filter filter{options.graph == SCH::graph_output::CYCLES        ? SYNC_LIB::graph_filter::CYCLES
+                                                : options.graph == SCH::graph_output::CERTIFICATE ? SYNC_LIB::graph_filter::CERTIFICATE
+                                                                                                  : SYNC_LIB::graph_filter::FULL};
+
+            if (options.graph_binary)
+            {
+                write_result_file(output_files, ".graph.bin", ios::binary, [&](ostream &primal_dual_graph_file)
+                                  { infeasible_paths.write_primal_dual_edges(primal_dual_graph_file, filter); });
+            }
+            else
+            {
+                write_result_file(output_files, ".graph.dot", ios::out, [&](ostream &primal_dual_graph_file)
+                                  {
+                                      json_buffer.open(primal_dual_graph_file);
+                                      infeasible_paths.write_primal_dual_graph(json_buffer, filter);
+                                      json_buffer.close(); });
+            }
+        }
+    }
+
     /**
      * @brief Generate temporal schedule for CTSP2 problem
-     * @param instance CTSP instance with customers, depots, and constraints
+     * @param model_builder Synchronization model of the CTSP instance
      * @param feas_sol Feasible routing solution
      * @param output_streams Output file stream for schedule
+     * @param options Optional settings (verification engine, cycle search limits)
      *
      * Implementation steps:
-     * 1. Build CTSP model_a from instance
+     * 1. Take the CTSP model_a (built from the instance or the model cache)
      * 2. Create scheduling solver with tolerance 1e-6
      * 3. Convert sync_solution to model_a format
      * 4. Solve LP to compute operation times and time windows
@@ -39,20 +267,29 @@ namespace SCH
      * @note Asserts that solution is feasible (LP has solution)
      * @note Output format includes schedules per depot and time windows per customer
      */
-    void CTSP2_scheduler(const SCH::output_files &output_files, const CTSP::instance &instance, const SYNC_LIB::sync_solution &feas_sol)
+    void CTSP2_scheduler(const SCH::output_files &output_files, SYNC_LIB::sync_model_a_builder &model_builder, const SYNC_LIB::sync_solution &feas_sol, const SCH::run_options &options, SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory)
     {
-        // Build synchronization model from CTSP instance
-        CTSP::CTSP_model_a_builder model_builder(CTSP::CTSP_problem_type::CTSP2, instance);
-
         // Create scheduler with numerical tolerance
-        SYNC_LIB::conTSP2_scheduling scheduler(model_builder, 1e-6);
+        SYNC_LIB::conTSP2_scheduling scheduler(model_builder, 1e-6, get_sync_engine(options));
+        set_scheduler_options(scheduler, options);
+
+        SYNC_LIB::lp_basis_cache basis_cache;
+        load_basis_cache(scheduler, basis_cache, options);
 
         // Convert solution to model_a format
         vector<double> x;
         {
+            GOMA::trace_scope trace("to_model_a", "scheduler");
+
             SYNC_LIB::model_a_solution_interface solution_interfaz;
             solution_interfaz.set(model_builder);
-            solution_interfaz.sync_solution_2_model_a(feas_sol, x);
+
+            // The model has no variable for a pruned arc: nothing to check
+            if (!solution_interfaz.sync_solution_2_model_a(feas_sol, x))
+            {
+                cerr << "ERROR: The solution uses routing arcs pruned from the model (--prune-duration, --knn-arcs)" << endl;
+                exit(1);
+            }
         }
 
         // Compute schedule and time windows via LP
@@ -61,30 +298,849 @@ namespace SCH
 
         const bool feasible{scheduler.solve(feas_sol.get_instance_name(), x, feasible_schedule, infeasible_paths)};
 
-        if (feasible)
+        report_differential(scheduler, model_builder, x, feas_sol.get_instance_name(), options);
+
+        save_basis_cache(basis_cache, options);
+
+        SYNC_LIB::json_buffer json_buffer;
+        json_buffer.set_round_trip(options.round_trip_times);
+
+        double output_time{0};
+        {
+            GOMA::stats_timer timer(output_time);
+            GOMA::trace_scope trace("write_output", "scheduler");
+            write_schedule_results(output_files, feas_sol, feasible, feasible_schedule, infeasible_paths, json_buffer, options);
+
+            if (feasible && options.flexibility >= 0)
+                write_flexibility(scheduler, output_files, feas_sol, x, json_buffer, options);
+        }
+
+        stats = scheduler.get_stats();
+        stats.output_time = output_time;
+
+        memory = scheduler.get_memory();
+    }
+
+    /**
+     * @brief One solution in flight through the batch pipeline
+     */
+    struct batch_slot_
+    {
+        size_t index;                                           ///< Position in the solution files
+        SYNC_LIB::sync_solution feas_sol;                       ///< Parsed solution
+        vector<double> x;                                       ///< Solution in model_a format
+        SYNC_LIB::sync_scheduling feasible_schedule;            ///< Schedule (feasible)
+        unique_ptr<SYNC_LIB::sync_infeasible> infeasible_paths; ///< Violated cycles (infeasible)
+        bool feasible;                                          ///< Check result
+        bool failed;                                            ///< Not checked (arcs pruned from the model)
+        double c_time;                                          ///< Seconds to read and check
+
+        batch_slot_(void) : index(0), feas_sol(), x(), feasible_schedule(), infeasible_paths(), feasible(false), failed(false), c_time(0) {}
+    };
+
+    /**
+     * @brief Batch mode with overlapped stages (--jobs n, n > 1)
+     *
+     * A reader thread parses and converts the solutions, n workers check
+     * them, each with its own converter (LP) over the shared model, and the
+     * calling thread writes the results in the order of sol_files. Slots
+     * holding a solution circulate through bounded queues (free -> solve ->
+     * write -> free), so at most 2n solutions are in flight and nothing is
+     * allocated per solution once the slots have grown.
+     */
+    static void CTSP2_pipelined_batch_scheduler(const SCH::output_files &output_files, SYNC_LIB::sync_model_a_builder &model_builder, const vector<string> &sol_files, const SCH::run_options &options, const size_t n_jobs, SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory, vector<batch_result> *results)
+    {
+        typedef chrono::steady_clock batch_clock;
+
+        const batch_clock::time_point setup_start{batch_clock::now()};
+
+        vector<unique_ptr<SYNC_LIB::conTSP2_scheduling>> schedulers(n_jobs);
+        vector<SYNC_LIB::lp_basis_cache> basis_caches(n_jobs);
+
+        for (size_t w{0}; w < n_jobs; w++)
+        {
+            schedulers[w].reset(new SYNC_LIB::conTSP2_scheduling(model_builder, 1e-6, get_sync_engine(options)));
+            set_scheduler_options(*schedulers[w], options);
+
+            // The writer reports infeasible solutions, in order
+            schedulers[w]->set_verbose(false);
+
+            load_basis_cache(*schedulers[w], basis_caches[w], options);
+        }
+
+        SYNC_LIB::model_a_solution_interface solution_interfaz;
+        solution_interfaz.set(model_builder);
+
+        SYNC_LIB::json_buffer json_buffer;
+        json_buffer.set_round_trip(options.round_trip_times);
+
+        const chrono::duration<double> setup_time{batch_clock::now() - setup_start};
+
+        const size_t n_slots{2 * n_jobs};
+        vector<batch_slot_> slots(n_slots);
+
+        GOMA::bounded_queue<size_t> free_slots(n_slots);
+        GOMA::bounded_queue<size_t> solve_queue(n_slots);
+        GOMA::bounded_queue<size_t> write_queue(n_slots);
+
+        for (size_t s{0}; s < n_slots; s++)
+            free_slots.push(s);
+
+        const batch_clock::time_point run_start{batch_clock::now()};
+
+        // Reader: parse and convert, in order
+        thread reader([&]()
+                      {
+                          SYNC_LIB::sync_solution_parser solution_parser;
+
+                          for (size_t i{0}; i < sol_files.size(); i++)
+                          {
+                              size_t s{0};
+                              free_slots.pop(s);
+
+                              batch_slot_ &slot{slots[s]};
+                              const batch_clock::time_point start{batch_clock::now()};
+
+                              {
+                                  GOMA::trace_scope trace_read("read_solution", "scheduler");
+
+                                  if (!solution_parser.read(sol_files[i], slot.feas_sol))
+                                  {
+                                      cerr << solution_parser.get_error() << endl;
+                                      slot.feas_sol.init();
+                                  }
+
+                                  slot.failed = !solution_interfaz.sync_solution_2_model_a(slot.feas_sol, slot.x);
+
+                                  if (slot.failed)
+                                      cerr << "ERROR: " << sol_files[i] << " uses routing arcs pruned from the model (--prune-duration, --knn-arcs)" << endl;
+                              }
+
+                              const chrono::duration<double> elapsed{batch_clock::now() - start};
+
+                              slot.index = i;
+                              slot.c_time = elapsed.count();
+
+                              solve_queue.push(s);
+                          }
+
+                          solve_queue.close();
+                      });
+
+        // Workers: check, the last one to finish ends the write queue
+        atomic<size_t> n_running{n_jobs};
+        vector<thread> workers;
+
+        for (size_t w{0}; w < n_jobs; w++)
+        {
+            workers.emplace_back([&, w]()
+                                 {
+                                     SYNC_LIB::conTSP2_scheduling &scheduler{*schedulers[w]};
+
+                                     size_t s{0};
+
+                                     while (solve_queue.pop(s))
+                                     {
+                                         batch_slot_ &slot{slots[s]};
+                                         const batch_clock::time_point start{batch_clock::now()};
+
+                                         slot.feasible_schedule = SYNC_LIB::sync_scheduling();
+                                         slot.infeasible_paths.reset(new SYNC_LIB::sync_infeasible(slot.x, model_builder));
+
+                                         slot.feasible = !slot.failed && scheduler.solve(slot.feas_sol.get_instance_name(), slot.x, slot.feasible_schedule, *slot.infeasible_paths);
+
+                                         const chrono::duration<double> elapsed{batch_clock::now() - start};
+                                         slot.c_time += elapsed.count();
+
+                                         write_queue.push(s);
+                                     }
+
+                                     if (n_running.fetch_sub(1) == 1)
+                                         write_queue.close();
+                                 });
+        }
+
+        // Writer (this thread): results in the order of sol_files
+        size_t n_feasible{0};
+        size_t n_failed{0};
+        double total_time{0};
+        double min_time{0};
+        double max_time{0};
+        double output_time{0};
+
+        map<size_t, size_t> pending;
+        size_t next{0};
+        size_t s{0};
+
+        while (write_queue.pop(s))
+        {
+            pending[slots[s].index] = s;
+
+            for (map<size_t, size_t>::iterator it{pending.find(next)}; it != pending.end(); it = pending.find(next))
+            {
+                const size_t slot_s{it->second};
+                batch_slot_ &slot{slots[slot_s]};
+                const string &sol_file{sol_files[slot.index]};
+
+                if (slot.failed)
+                {
+                    n_failed++;
+                }
+                else
+                {
+                    if (!slot.feasible)
+                        cout << "Solution is infeasible in synchronization constraints." << endl;
+
+                    const SCH::output_files sol_output_files(output_files.output_path, sol_file, output_files.archive);
+                    {
+                        GOMA::stats_timer timer(output_time);
+                        GOMA::trace_scope trace_write("write_output", "scheduler");
+                        write_schedule_results(sol_output_files, slot.feas_sol, slot.feasible, slot.feasible_schedule, *slot.infeasible_paths, json_buffer, options);
+                    }
+                }
+
+                const double c_time{slot.c_time};
+
+                if (slot.feasible)
+                    n_feasible++;
+
+                total_time += c_time;
+                min_time = (next == 0 || c_time < min_time) ? c_time : min_time;
+                max_time = (next == 0 || c_time > max_time) ? c_time : max_time;
+
+                cout << sol_file << " : " << (slot.failed ? "error" : slot.feasible ? "feasible" : "infeasible") << " " << c_time << " s" << endl;
+
+                if (results != nullptr)
+                    results->push_back(batch_result{slot.feasible, slot.failed, c_time});
+
+                pending.erase(it);
+                free_slots.push(slot_s);
+                next++;
+            }
+        }
+
+        reader.join();
+
+        for (thread &worker : workers)
+            worker.join();
+
+        const chrono::duration<double> run_time{batch_clock::now() - run_start};
+
+        // Bases of the first worker (one file)
+        save_basis_cache(basis_caches[0], options);
+
+        stats.clear();
+
+        for (const unique_ptr<SYNC_LIB::conTSP2_scheduling> &scheduler : schedulers)
+            stats.add(scheduler->get_stats());
+
+        stats.output_time = output_time;
+
+        // Per converter: every worker holds the same structures
+        memory = schedulers[0]->get_memory();
+
+        const size_t n_solutions{sol_files.size()};
+
+        cout << endl;
+        cout << "Solutions           : " << n_solutions << endl;
+        cout << "Feasible            : " << n_feasible << endl;
+        cout << "Infeasible          : " << n_solutions - n_feasible - n_failed << endl;
+        cout << "Failed              : " << n_failed << endl;
+        cout << "Workers             : " << n_jobs << endl;
+        cout << "Setup time (s)      : " << setup_time.count() << endl;
+        cout << "Total solve time (s): " << total_time << endl;
+        cout << "Wall time (s)       : " << run_time.count() << endl;
+        cout << "Mean time (s)       : " << total_time / n_solutions << endl;
+        cout << "Min time (s)        : " << min_time << endl;
+        cout << "Max time (s)        : " << max_time << endl;
+    }
+
+    void CTSP2_batch_scheduler(const SCH::output_files &output_files, SYNC_LIB::sync_model_a_builder &model_builder, const vector<string> &sol_files, const SCH::run_options &options, SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory, vector<batch_result> *results)
+    {
+        if (results != nullptr)
+            results->clear();
+
+        const size_t n_jobs{options.batch_jobs == 0 ? (size_t)max(1u, thread::hardware_concurrency()) : options.batch_jobs};
+
+        // Reading, checking and writing overlap
+        if (n_jobs > 1 && sol_files.size() > 1)
+        {
+            CTSP2_pipelined_batch_scheduler(output_files, model_builder, sol_files, options, n_jobs, stats, memory, results);
+            return;
+        }
+
+        typedef chrono::steady_clock batch_clock;
+
+        const batch_clock::time_point setup_start{batch_clock::now()};
+
+        // Checker and solution converter are built once for all solutions
+        SYNC_LIB::conTSP2_scheduling scheduler(model_builder, 1e-6, get_sync_engine(options));
+        set_scheduler_options(scheduler, options);
+
+        SYNC_LIB::lp_basis_cache basis_cache;
+        load_basis_cache(scheduler, basis_cache, options);
+
+        SYNC_LIB::model_a_solution_interface solution_interfaz;
+        solution_interfaz.set(model_builder);
+
+        // Schedules are formatted into one buffer, allocated once
+        SYNC_LIB::json_buffer json_buffer;
+        json_buffer.set_round_trip(options.round_trip_times);
+
+        const chrono::duration<double> setup_time{batch_clock::now() - setup_start};
+
+        size_t n_feasible{0};
+        size_t n_failed{0};
+        double total_time{0};
+        double min_time{0};
+        double max_time{0};
+        double output_time{0};
+
+        // Nonzero entries only: the scheduler loads the arcs that changed
+        SYNC_LIB::sparse_x x;
+
+        // Every solution file is parsed into the same object (no allocation
+        // once the routes have their sizes)
+        SYNC_LIB::sync_solution_parser solution_parser;
+        SYNC_LIB::sync_solution feas_sol;
+
+        for (size_t i{0}; i < sol_files.size(); i++)
+        {
+            const string &sol_file{sol_files[i]};
+
+            GOMA::trace_scope trace("solution", "scheduler");
+
+            const batch_clock::time_point start{batch_clock::now()};
+
+            bool failed{false};
+            {
+                GOMA::trace_scope trace_read("read_solution", "scheduler");
+
+                if (!solution_parser.read(sol_file, feas_sol))
+                {
+                    cerr << solution_parser.get_error() << endl;
+                    feas_sol.init();
+                }
+
+                failed = !solution_interfaz.sync_solution_2_model_a(feas_sol, x);
+
+                if (failed)
+                    cerr << "ERROR: " << sol_file << " uses routing arcs pruned from the model (--prune-duration, --knn-arcs)" << endl;
+            }
+
+            if (failed)
+            {
+                const chrono::duration<double> elapsed{batch_clock::now() - start};
+                const double c_time{elapsed.count()};
+
+                n_failed++;
+
+                total_time += c_time;
+                min_time = (i == 0 || c_time < min_time) ? c_time : min_time;
+                max_time = (i == 0 || c_time > max_time) ? c_time : max_time;
+
+                cout << sol_file << " : error " << c_time << " s" << endl;
+
+                if (results != nullptr)
+                    results->push_back(batch_result{false, true, c_time});
+
+                continue;
+            }
+
+            SYNC_LIB::sync_scheduling feasible_schedule;
+            SYNC_LIB::sync_infeasible infeasible_paths(scheduler.get_x(), model_builder);
+
+            const bool feasible{scheduler.solve(feas_sol.get_instance_name(), x, feasible_schedule, infeasible_paths)};
+
+            // One output set per solution, named after the solution file
+            const SCH::output_files sol_output_files(output_files.output_path, sol_file, output_files.archive);
+            {
+                GOMA::stats_timer timer(output_time);
+                GOMA::trace_scope trace_write("write_output", "scheduler");
+                write_schedule_results(sol_output_files, feas_sol, feasible, feasible_schedule, infeasible_paths, json_buffer, options);
+            }
+
+            const chrono::duration<double> elapsed{batch_clock::now() - start};
+            const double c_time{elapsed.count()};
+
+            if (feasible)
+                n_feasible++;
+
+            total_time += c_time;
+            min_time = (i == 0 || c_time < min_time) ? c_time : min_time;
+            max_time = (i == 0 || c_time > max_time) ? c_time : max_time;
+
+            cout << sol_file << " : " << (feasible ? "feasible" : "infeasible") << " " << c_time << " s" << endl;
+
+            if (results != nullptr)
+                results->push_back(batch_result{feasible, false, c_time});
+
+            report_differential(scheduler, model_builder, scheduler.get_x(), sol_file, options);
+        }
+
+        save_basis_cache(basis_cache, options);
+
+        stats = scheduler.get_stats();
+        stats.output_time = output_time;
+
+        memory = scheduler.get_memory();
+
+        const size_t n_solutions{sol_files.size()};
+
+        cout << endl;
+        cout << "Solutions           : " << n_solutions << endl;
+        cout << "Feasible            : " << n_feasible << endl;
+        cout << "Infeasible          : " << n_solutions - n_feasible - n_failed << endl;
+        cout << "Failed              : " << n_failed << endl;
+        cout << "Setup time (s)      : " << setup_time.count() << endl;
+        cout << "Total solve time (s): " << total_time << endl;
+        cout << "Mean time (s)       : " << total_time / n_solutions << endl;
+        cout << "Min time (s)        : " << min_time << endl;
+        cout << "Max time (s)        : " << max_time << endl;
+    }
+
+    /**
+     * @brief Check that the routes of a solution fit the model
+     * @param solution_interfaz Converter of the model
+     * @param feas_sol Parsed solution
+     * @param error Output: why the routes were rejected
+     * @return false if the routes would index outside the operation map
+     */
+    static bool valid_routes(const SYNC_LIB::model_a_solution_interface &solution_interfaz, const SYNC_LIB::sync_solution &feas_sol, string &error)
+    {
+        try
+        {
+            solution_interfaz.validate_routes(feas_sol.get_routes());
+        }
+        catch (const invalid_argument &e)
+        {
+            error = e.what();
+            return false;
+        }
+
+        return true;
+    }
+
+    void CTSP2_stream_scheduler(SYNC_LIB::sync_model_a_builder &model_builder, istream &is, ostream &os, const SCH::run_options &options, SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory)
+    {
+        // Checker and solution converter are built once for all solutions
+        SYNC_LIB::conTSP2_scheduling scheduler(model_builder, 1e-6, get_sync_engine(options));
+        set_scheduler_options(scheduler, options);
+
+        // stdout carries the result lines only
+        scheduler.set_verbose(false);
+
+        SYNC_LIB::lp_basis_cache basis_cache;
+        load_basis_cache(scheduler, basis_cache, options);
+
+        SYNC_LIB::model_a_solution_interface solution_interfaz;
+        solution_interfaz.set(model_builder);
+
+        SYNC_LIB::sync_solution_parser solution_parser;
+        SYNC_LIB::sync_solution feas_sol;
+
+        SYNC_LIB::json_buffer json_buffer;
+        json_buffer.set_round_trip(options.round_trip_times);
+        json_buffer.open(os);
+
+        SYNC_LIB::sparse_x x;
+        string line;
+        string route_error;
+
+        size_t n_line{0};
+        double output_time{0};
+
+        while (getline(is, line))
         {
-            std::ofstream schedule_file(output_files.output_path + "/" + output_files.instance_name + ".sched.json");
-            std::ostream& sch_s = schedule_file;
+            n_line++;
+
+            if (line.find_first_not_of(" \t\r") == string::npos)
+                continue;
+
+            GOMA::trace_scope trace("line", "scheduler");
 
-            // Write schedule to JSON output
-            feas_sol.write_header(sch_s);
-            sch_s << endl;
-            feasible_schedule.write_json(sch_s);
-            feas_sol.write_end(sch_s);
+            json_buffer.put("{\"line\": ");
+            json_buffer.put_int(n_line);
 
-            schedule_file.close();
+            if (!solution_parser.parse(line.data(), line.data() + line.size(), feas_sol))
+            {
+                // Parser messages hold no quotes nor backslashes
+                json_buffer.put(", \"error\": \"");
+                json_buffer.put(solution_parser.get_error());
+                json_buffer.put("\"}\n");
+            }
+            else if (!valid_routes(solution_interfaz, feas_sol, route_error))
+            {
+                // Route messages hold no quotes nor backslashes
+                json_buffer.put(", \"error\": \"");
+                json_buffer.put(route_error);
+                json_buffer.put("\"}\n");
+            }
+            else if (!solution_interfaz.sync_solution_2_model_a(feas_sol, x))
+            {
+                json_buffer.put(", \"error\": \"routes use arcs pruned from the model\"}\n");
+            }
+            else
+            {
+                SYNC_LIB::sync_scheduling feasible_schedule;
+                SYNC_LIB::sync_infeasible infeasible_paths(scheduler.get_x(), model_builder);
+
+                const bool feasible{scheduler.solve(feas_sol.get_instance_name(), x, feasible_schedule, infeasible_paths)};
+
+                {
+                    GOMA::stats_timer timer(output_time);
+                    GOMA::trace_scope trace_write("write_output", "scheduler");
+
+                    json_buffer.put(", \"instance_name\": \"");
+                    json_buffer.put(feas_sol.get_instance_name());
+                    json_buffer.put("\", \"feasible\": ");
+
+                    if (feasible)
+                    {
+                        json_buffer.put("true, \"schedule\": ");
+                        SYNC_LIB::json_format_io().write_compact_scheduling(json_buffer, feasible_schedule);
+                    }
+                    else
+                    {
+                        json_buffer.put("false, \"cycles\": ");
+                        infeasible_paths.write_json_cycles(json_buffer);
+
+                        if (infeasible_paths.truncated())
+                            json_buffer.put(", \"truncated\": true");
+                    }
+
+                    json_buffer.put("}\n");
+                }
+
+                report_differential(scheduler, model_builder, scheduler.get_x(), "line " + to_string(n_line), options);
+            }
+
+            // The producer waits for this line: no block buffering across solutions
+            {
+                GOMA::stats_timer timer(output_time);
+                GOMA::trace_scope trace_flush("flush_output", "scheduler");
+
+                json_buffer.flush();
+                os.flush();
+            }
+        }
+
+        json_buffer.close();
+
+        save_basis_cache(basis_cache, options);
+
+        stats = scheduler.get_stats();
+        stats.output_time = output_time;
+
+        memory = scheduler.get_memory();
+    }
+
+    /**
+     * @brief Build the synchronization model of an instance, through the model cache
+     * @param ins_file Instance file (.contsp)
+     * @param problem_type CTSP1 (departures synchronized) or CTSP2 (duration arcs between depots)
+     * @param options Optional settings (lazy distances, arc pruning, model cache file)
+     * @param model_builder Output: synchronization model
+     * @param family Models of the instances built so far (NULL: none)
+     *
+     * With --model-cache, a cache file saved for the same instance contents
+     * and arc pruning is loaded instead of parsing the instance; otherwise
+     * the model is built and the file (re)written. With a family, an
+     * instance that only differs from an earlier one in T reuses its model.
+     */
+    static void build_model(const string &ins_file, const CTSP::CTSP_problem_type problem_type, const SCH::run_options &options, unique_ptr<SYNC_LIB::sync_model_a_builder> &model_builder, SYNC_LIB::sync_model_family *family = NULL)
+    {
+        const SYNC_LIB::arc_pruning pruning(options.prune_duration, options.knn_arcs);
+
+        uint64_t instance_key{0};
+
+        const bool use_cache{!options.model_cache_file.empty() && SYNC_LIB::sync_model_cache::instance_key(ins_file, problem_type == CTSP::CTSP_problem_type::CTSP1 ? 1 : 2, instance_key, pruning.get_key())};
+
+        SYNC_LIB::sync_model_cache cache(options.model_cache_file, instance_key);
+
+        if (use_cache && cache.load(model_builder))
+        {
+            log_stream(options) << "Model cache: loaded " << options.model_cache_file << endl;
+            return;
         }
+
+        // Load instance from file (released once the model is built)
+        {
+            CTSP::instance I;
+
+            I.set_lazy_distances(options.lazy_distances);
+            // Header to stderr in stream mode: stdout carries the results only
+            I.read(ins_file, log_stream(options));
+
+            if (pruning.duration && !I.triangle_inequality())
+                cerr << "WARNING: The distances do not satisfy the triangle inequality, --prune-duration ignored" << endl;
+
+            const uint64_t structure_key{family != NULL ? CTSP::CTSP_model_a_builder::structure_key(problem_type, I, pruning) : 0};
+
+            string base_name;
+
+            if (family != NULL && family->find(structure_key, I.get_instance_name(), I.get_T(), model_builder, base_name))
+            {
+                log_stream(options) << "Model family: routing model shared with " << base_name << endl;
+                return;
+            }
+
+            model_builder.reset(new CTSP::CTSP_model_a_builder(problem_type, I, pruning, options.n_threads));
+
+            if (family != NULL)
+                family->add(structure_key, *model_builder);
+        }
+
+        if (!pruning.none())
+            log_stream(options) << "Arc pruning: " << model_builder->get_n_pruned_arcs() << " routing arcs left out, "
+                                << model_builder->get_routing_arcs().size() << " kept" << endl;
+
+        if (!use_cache)
+            return;
+
+        if (cache.save(*model_builder))
+            log_stream(options) << "Model cache: saved " << options.model_cache_file << endl;
         else
+            cerr << "WARNING: Cannot write model cache " << options.model_cache_file << endl;
+    }
+
+    /**
+     * @brief Write the trace of the run (--trace), if one is recorded
+     */
+    static void write_trace(const SCH::run_options &options)
+    {
+        if (options.trace_file.empty())
+            return;
+
+        GOMA::trace_recorder::stop();
+
+        if (!GOMA::trace_recorder::write(options.trace_file))
+            cerr << "WARNING: Cannot write trace file " << options.trace_file << endl;
+
+        const size_t n_dropped{GOMA::trace_recorder::get_n_dropped()};
+
+        if (n_dropped > 0)
+            cerr << "WARNING: " << n_dropped << " trace events dropped (" << GOMA::trace_recorder::max_events << " per thread)" << endl;
+    }
+
+    /**
+     * @brief Write the work counters (--stats json) and memory (--memory json) of the run
+     * @param options Optional settings
+     * @param stats Work counters, model build time included
+     * @param memory Bytes held, process resident set after the build included
+     */
+    static void write_run_reports(const SCH::run_options &options, const SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory)
+    {
+        // stderr: stdout carries the results in stream mode
+        if (options.stats_json)
+            stats.write_json(cerr);
+
+        if (options.memory_json)
+        {
+            memory.peak_rss = GOMA::process_peak_rss_bytes();
+            memory.write_json(cerr);
+        }
+    }
+
+    int CTSP2_server(const SCH::input_files &input_files, const CTSP::CTSP_problem_type problem_type, const SCH::run_options &options)
+    {
+        // One cache file holds one model: not used for an instance directory
+        SCH::run_options server_options(options);
+
+        if (input_files.ins_files.size() > 1 && !server_options.model_cache_file.empty())
+        {
+            cerr << "WARNING: --model-cache ignored with several instances" << endl;
+            server_options.model_cache_file.clear();
+        }
+
+        sch_server server(server_options);
+
+        // Instances that only differ in T share their routing arrays
+        SYNC_LIB::sync_model_family family;
+
+        for (const string &ins_file : input_files.ins_files)
+        {
+            unique_ptr<SYNC_LIB::sync_model_a_builder> model_builder;
+
+            {
+                GOMA::trace_scope trace("build_model", "scheduler");
+                build_model(ins_file, problem_type, server_options, model_builder, input_files.ins_files.size() > 1 ? &family : NULL);
+            }
+
+            cout << "Loaded " << model_builder->get_instance_name() << endl;
+
+            server.add_instance(move(model_builder));
+        }
+
+        const int status{server.serve(server_options.serve_address)};
+
+        // Reached when the server is stopped by a signal (--trace)
+        write_trace(options);
+
+        return status;
+    }
+
+    /**
+     * @brief Open the result archive of a batch run or a shard (--archive)
+     * @param archive Archive to open
+     * @param file Container file
+     * @param root Output directory the record names are relative to
+     * @param options Optional settings (codec and zstd level)
+     * @return false if the archive cannot be created
+     */
+    static bool open_archive(SCH::result_archive &archive, const string &file, const string &root, const SCH::run_options &options)
+    {
+        const SCH::archive_codec codec{options.archive == SCH::archive_output::ZSTD ? SCH::archive_codec::ZSTD : SCH::archive_codec::NONE};
+
+        if (!archive.open(file, root, codec, options.archive_level))
         {
-            std::ofstream infeasible_paths_file(output_files.output_path + "/" + output_files.instance_name + ".infeas_paths.txt");
-            std::ofstream primal_dual_graph_file(output_files.output_path + "/" + output_files.instance_name + ".graph.dot");
-            infeasible_paths.write_infeasible_paths(infeasible_paths_file);
-            infeasible_paths.write_primal_dual_graph(primal_dual_graph_file);
-            infeasible_paths_file.close();
-            primal_dual_graph_file.close();
+            cerr << "ERROR: Cannot create result archive " << file << endl;
+            return false;
         }
 
-        // Verify solution feasibility
+        return true;
+    }
+
+    /**
+     * @brief Write the last block and the index of a result archive
+     * @param archive Open archive
+     * @return false if a write failed
+     */
+    static bool close_archive(SCH::result_archive &archive)
+    {
+        if (!archive.close())
+        {
+            cerr << "ERROR: Cannot write result archive " << archive.get_file() << endl;
+            return false;
+        }
+
+        cout << "Archive             : " << archive.get_file() << " (" << archive.get_n_records() << " records, "
+             << archive.get_raw_bytes() << " bytes in " << archive.get_file_bytes() << ")" << endl;
+
+        return true;
+    }
+
+    int CTSP2_shard_scheduler(const SCH::input_files &input_files, const SCH::output_files &output_files, const CTSP::CTSP_problem_type problem_type, const SCH::run_options &options, SYNC_LIB::sync_stats &stats, SYNC_LIB::sync_memory &memory)
+    {
+        namespace fs = std::filesystem;
+
+        const shard_plan plan(input_files.study, options.n_shards);
+        const vector<size_t> instances{plan.get_instances(options.shard_index)};
+
+        cout << "Shard " << options.shard_index << "/" << options.n_shards << ": " << instances.size() << " of "
+             << plan.get_n_instances() << " instances, " << plan.get_n_solutions(options.shard_index) << " solutions" << endl;
+
+        // One cache file holds one model (and the bases of one instance)
+        SCH::run_options shard_options(options);
+
+        if (instances.size() > 1 && !shard_options.model_cache_file.empty())
+        {
+            cerr << "WARNING: --model-cache ignored with several instances" << endl;
+            shard_options.model_cache_file.clear();
+        }
+
+        if (instances.size() > 1 && !shard_options.basis_cache_file.empty())
+        {
+            cerr << "WARNING: --basis-cache ignored with several instances" << endl;
+            shard_options.basis_cache_file.clear();
+        }
+
+        stats.clear();
+        memory.clear();
+
+        vector<shard_result> shard_results;
+        vector<string> sol_files;
+        vector<batch_result> results;
+
+        // Instances that only differ in T share their routing arrays
+        SYNC_LIB::sync_model_family family;
+
+        // One archive for the results of every instance of the shard
+        SCH::result_archive archive;
+
+        if (options.archive != SCH::archive_output::FILES &&
+            !open_archive(archive, shard_plan::get_archive_file(output_files.output_path, options.shard_index, options.n_shards), output_files.output_path, options))
+            return 1;
+
+        for (const size_t i : instances)
+        {
+            const string &ins_file{plan.get_instance(i)};
+            const vector<size_t> &entries{plan.get_entries(i)};
+
+            GOMA::trace_scope trace("instance", "scheduler");
+
+            cout << endl
+                 << "Instance " << ins_file << " (" << entries.size() << " solutions)" << endl;
+
+            unique_ptr<SYNC_LIB::sync_model_a_builder> model_builder;
+
+            double model_build_time{0};
+            {
+                GOMA::stats_timer timer(model_build_time);
+                GOMA::trace_scope trace_build("build_model", "scheduler");
+                build_model(ins_file, problem_type, shard_options, model_builder, instances.size() > 1 ? &family : NULL);
+            }
+
+            const size_t rss_after_build{options.memory_json ? GOMA::process_rss_bytes() : 0};
+
+            // Solutions of different instances may share a file name
+            const fs::path output_path{fs::path(output_files.output_path) / fs::path(ins_file).stem()};
+
+            error_code ec;
+
+            // Archived results are records named after the directory
+            if (!archive.is_open())
+                fs::create_directories(output_path, ec);
+
+            if (ec)
+            {
+                cerr << "ERROR: Cannot create output directory " << output_path.string() << endl;
+                return 1;
+            }
+
+            sol_files.clear();
+
+            for (const size_t e : entries)
+                sol_files.push_back(input_files.study[e].sol_file);
+
+            SYNC_LIB::sync_stats c_stats;
+            SYNC_LIB::sync_memory c_memory;
+
+            const SCH::output_files ins_output_files(output_path.string(), ins_file, archive.is_open() ? &archive : NULL);
+            CTSP2_batch_scheduler(ins_output_files, *model_builder, sol_files, shard_options, c_stats, c_memory, &results);
+
+            for (size_t s{0}; s < results.size(); s++)
+                shard_results.push_back(shard_result{entries[s], results[s].feasible, results[s].failed, results[s].c_time});
+
+            c_stats.model_build_time = model_build_time;
+            stats.add(c_stats);
+
+            c_memory.rss_after_build = rss_after_build;
+
+            if (c_memory.model >= memory.model)
+                memory = c_memory;
+        }
+
+        // Manifest order, whatever the instance order of the shard
+        sort(shard_results.begin(), shard_results.end(), [](const shard_result &a, const shard_result &b)
+             { return a.index < b.index; });
+
+        // Closed first: the result file marks a complete shard
+        if (archive.is_open() && !close_archive(archive))
+            return 1;
+
+        const string result_file{shard_plan::get_result_file(output_files.output_path, options.shard_index, options.n_shards)};
+
+        if (!write_shard_results(result_file, input_files.study, shard_results))
+        {
+            cerr << "ERROR: Cannot write shard result file " << result_file << endl;
+            return 1;
+        }
+
+        cout << endl
+             << "Shard results       : " << result_file << endl;
+
+        return 0;
     }
 
     /**
@@ -94,9 +1150,11 @@ namespace SCH
     scheduler_ptr scheduler_array[] = {CTSP2_scheduler};
 
     /**
-     * @brief Complete CTSP2 scheduling workflow
+     * @brief Scheduling workflow of one problem type
+     * @param problem_type Model built for the instance
      * @param input_files Input file paths (instance, solution)
-     * @param os_instance Output streams for schedule
+     * @param output_files Output directory and file name prefix
+     * @param options Optional settings
      * @return 0 on success
      *
      * Workflow:
@@ -104,43 +1162,148 @@ namespace SCH
      * 2. Load solution from .sol file
      * 3. Generate temporal schedule
      * 4. Write to .sched.json file
+     *
+     * In batch mode, steps 2-4 are repeated for every solution file by
+     * CTSP2_batch_scheduler; in stream mode, for every line of stdin by
+     * CTSP2_stream_scheduler; in server mode, for every client request by
+     * CTSP2_server. In shard mode, steps 1-4 are repeated for every
+     * instance of the shard by CTSP2_shard_scheduler, and the merge step
+     * (merge_shard_results) reads the shard result files only.
+     *
+     * With --stats json, the work counters of the run (sync_stats) are
+     * written to stderr at the end (not in server mode), and with --memory
+     * json the bytes held by the model and search structures (sync_memory).
+     * With --trace, the stages of the run are recorded and written as a
+     * Chrome trace at the end (in server mode, when the server is stopped).
      */
-    int ctsp2_scheduler(const SCH::input_files &input_files,
-                        const SCH::output_files &output_files,
-                        SCH::output_streams &os_instance)
+    static int schedule_instance(const CTSP::CTSP_problem_type problem_type,
+                                 const SCH::input_files &input_files,
+                                 const SCH::output_files &output_files,
+                                 const SCH::run_options &options)
     {
-        // Load instance and solution from files
-        CTSP::instance I(input_files.ins_file);
-        SYNC_LIB::sync_solution feas_sol(input_files.sol_file);
+        if (!options.trace_file.empty())
+            GOMA::trace_recorder::start();
+
+        // Server mode: models built once, kept until the process is stopped
+        if (!options.serve_address.empty())
+            return CTSP2_server(input_files, problem_type, options);
+
+        // Merge step of a sharded run: no model is built
+        if (options.merge_shards > 0)
+            return merge_shard_results(input_files.study, output_files.output_path, options.merge_shards);
+
+        SYNC_LIB::sync_stats stats;
+        SYNC_LIB::sync_memory memory;
+
+        // Shard mode: one model per instance of the shard
+        if (options.n_shards > 0)
+        {
+            const int status{CTSP2_shard_scheduler(input_files, output_files, problem_type, options, stats, memory)};
+
+            if (status == 0)
+                write_run_reports(options, stats, memory);
+
+            write_trace(options);
+
+            return status;
+        }
+
+        // Synchronization model of the instance
+        unique_ptr<SYNC_LIB::sync_model_a_builder> model_builder;
+
+        double model_build_time{0};
+        {
+            GOMA::stats_timer timer(model_build_time);
+            GOMA::trace_scope trace("build_model", "scheduler");
+            build_model(input_files.ins_file, problem_type, options, model_builder);
+        }
+
+        const size_t rss_after_build{options.memory_json ? GOMA::process_rss_bytes() : 0};
 
-        // Generate schedule
-        (*scheduler_array[0])(output_files, I, feas_sol);
+        if (options.stream)
+        {
+            // Stream mode: one model for every line of stdin
+            CTSP2_stream_scheduler(*model_builder, cin, cout, options, stats, memory);
+        }
+        else if (options.batch)
+        {
+            // Batch mode: one model for every solution
+            if (options.archive == SCH::archive_output::FILES)
+                CTSP2_batch_scheduler(output_files, *model_builder, input_files.sol_files, options, stats, memory);
+            else
+            {
+                SCH::result_archive archive;
+
+                const string archive_file{(std::filesystem::path(output_files.output_path) / "results.ctspa").string()};
+
+                if (!open_archive(archive, archive_file, output_files.output_path, options))
+                    return 1;
+
+                SCH::output_files archive_output_files(output_files);
+                archive_output_files.archive = &archive;
+
+                CTSP2_batch_scheduler(archive_output_files, *model_builder, input_files.sol_files, options, stats, memory);
+
+                if (!close_archive(archive))
+                    return 1;
+            }
+        }
+        else
+        {
+            // Load solution from file
+            SYNC_LIB::sync_solution feas_sol(input_files.sol_file);
+
+            // Generate schedule
+            (*scheduler_array[0])(output_files, *model_builder, feas_sol, options, stats, memory);
+        }
+
+        stats.model_build_time = model_build_time;
+        memory.rss_after_build = rss_after_build;
+
+        write_run_reports(options, stats, memory);
+
+        write_trace(options);
 
         return 0;
     }
 
+    int ctsp2_scheduler(const SCH::input_files &input_files,
+                        const SCH::output_files &output_files,
+                        const SCH::run_options &options)
+    {
+        return schedule_instance(CTSP::CTSP_problem_type::CTSP2, input_files, output_files, options);
+    }
+
+    int ctsp1_scheduler(const SCH::input_files &input_files,
+                        const SCH::output_files &output_files,
+                        const SCH::run_options &options)
+    {
+        // Smaller sync graph: departures tied together, no depot duration arcs
+        return schedule_instance(CTSP::CTSP_problem_type::CTSP1, input_files, output_files, options);
+    }
+
     /**
      * @brief Array of scheduling method function pointers
-     * @note Index 0: ctsp2_scheduler
+     * @note Index 0: ctsp2_scheduler, index 1: ctsp1_scheduler (problem_type order)
      */
-    sch_method_ptr sch_method_array[] = {ctsp2_scheduler};
+    sch_method_ptr sch_method_array[] = {ctsp2_scheduler, ctsp1_scheduler};
 
     /**
      * @brief Dispatch to appropriate scheduler based on problem type
      * @param input_files Input file paths
-     * @param sch_instance Output streams
-     * @param prob_type Problem type (CTSP1=0 or CTSP2=0)
+     * @param output_files Output file paths
+     * @param prob_type Problem type (CTSP2=0 or CTSP1=1)
+     * @param options Optional settings
      * @return 0 on success
      *
      * Uses function pointer array for efficient dispatching.
-     * Currently only CTSP2 is implemented.
      */
     int run_method(const SCH::input_files &input_files,
                    const SCH::output_files &output_files,
-                   SCH::output_streams &sch_instance,
-                   SCH::problem_type prob_type)
+                   SCH::problem_type prob_type,
+                   const SCH::run_options &options)
     {
-        return (*sch_method_array[static_cast<int>(prob_type)])(input_files, output_files, sch_instance);
+        return (*sch_method_array[static_cast<int>(prob_type)])(input_files, output_files, options);
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <vector>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * @file json_buffer.hpp
+ * @brief Reusable character buffer for the JSON writers
+ *
+ * json_format_io used to format every number through `ostream <<` (with
+ * setw / fixed / setprecision and the stream locale) one insertion at a
+ * time. json_buffer formats numbers with std::to_chars into a char buffer
+ * that is written to the stream in large blocks. The buffer keeps its
+ * capacity between open / close, so writing many schedules (batch mode)
+ * does not allocate once the first one has been written.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @class json_buffer
+     * @brief Block-buffered, locale-free text output
+     *
+     * ```cpp
+     * json_buffer buffer;          // reused for every file
+     *
+     * buffer.open(os);
+     * buffer.put("\"x\": ");
+     * buffer.put_double(x, 6);     // "  12.5" (or "12.53125" in round-trip mode)
+     * buffer.close();              // writes what is left, unbinds os
+     * ```
+     *
+     * Doubles are written in fixed notation with one decimal by default,
+     * the same text as `setw(w) << fixed << setprecision(1)`. In round-trip
+     * mode they are written with the shortest representation that reads
+     * back to the same double.
+     */
+    class json_buffer
+    {
+    private:
+        vector<char> buffer_; ///< Pending text
+        size_t used_;         ///< Pending bytes in buffer_
+        size_t block_size_;   ///< Pending bytes that trigger a write
+
+        ostream *os_; ///< Bound stream (NULL: none)
+
+        bool round_trip_; ///< Shortest round-trip doubles instead of one decimal
+
+    public:
+        /**
+         * @brief Unbound buffer
+         * @param block_size Bytes gathered before each write to the stream
+         */
+        json_buffer(const size_t block_size = 1 << 16);
+
+        /**
+         * @brief Writes what is left to the bound stream
+         */
+        virtual ~json_buffer(void);
+
+        json_buffer(const json_buffer &) = delete;
+        json_buffer &operator=(const json_buffer &) = delete;
+
+        /**
+         * @brief Bind an output stream (closes the previous one)
+         */
+        void open(ostream &os);
+
+        /**
+         * @brief Write the pending text and unbind the stream
+         */
+        void close(void);
+
+        /**
+         * @brief Write the pending text to the bound stream
+         */
+        void flush(void);
+
+        inline void set_round_trip(const bool round_trip) { round_trip_ = round_trip; }
+        inline bool get_round_trip(void) const { return round_trip_; }
+
+        inline bool is_open(void) const { return os_ != NULL; }
+
+        /**
+         * @brief Pending text (all of it while no stream is bound, e.g. to
+         *        frame it for a socket)
+         */
+        inline const char *data(void) const { return buffer_.data(); }
+        inline size_t size(void) const { return used_; }
+
+        /**
+         * @brief Drop the pending text (capacity kept)
+         */
+        inline void clear(void) { used_ = 0; }
+
+        inline void put(const char c)
+        {
+            reserve_(1);
+            buffer_[used_++] = c;
+        }
+
+        void put(const char *s);
+        void put(const string &s);
+
+        /**
+         * @brief Write a string right-aligned in width characters
+         */
+        void put(const string &s, const int width);
+
+        /**
+         * @brief Write an integer right-aligned in width characters
+         */
+        void put_int(const long long val, const int width = 0);
+
+        /**
+         * @brief Write a double right-aligned in width characters
+         */
+        void put_double(const double val, const int width = 0);
+
+        /**
+         * @brief Write a double in fixed notation with the given decimals,
+         *        right-aligned in width characters (round-trip mode ignored)
+         */
+        void put_fixed(const double val, const int width, const int precision);
+
+    private:
+        /**
+         * @brief Room for n more bytes (flushes full blocks)
+         */
+        inline void reserve_(const size_t n)
+        {
+            if (used_ + n > buffer_.size())
+                grow_(n);
+        }
+
+        void grow_(const size_t n);
+        void put_padded_(const char *s, const size_t len, const int width);
+    };
+}
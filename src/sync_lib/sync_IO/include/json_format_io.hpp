@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "sync_scheduling.hpp"
+#include "json_buffer.hpp"
 
 using namespace std;
 
@@ -19,6 +20,9 @@ using namespace std;
  * 
  * Note: This implementation does not use a full JSON parser library and has
  * limitations compared to standard JSON libraries.
+ *
+ * The schedule and time window writers fill a json_buffer (std::to_chars,
+ * block writes); their ostream overloads wrap the stream in a temporary one.
  */
 
 namespace SYNC_LIB
@@ -67,6 +71,14 @@ namespace SYNC_LIB
          */
         void write(ostream &os, const string &instance_name, const sync_scheduling &schedules) const;
 
+        /**
+         * @brief Write a complete schedule into a buffer
+         * @param buffer Output buffer (reused across schedules)
+         * @param instance_name Name of the problem instance
+         * @param schedules Schedule data with timing for each operation
+         */
+        void write(json_buffer &buffer, const string &instance_name, const sync_scheduling &schedules) const;
+
         /**
          * @brief Read a vector of integers from JSON array format
          * @param is Input stream
@@ -132,12 +144,36 @@ namespace SYNC_LIB
          */
         void write_vector_of_scheduling(ostream &os, const vector<vector<operation_info>> &vec) const;
 
+        /**
+         * @brief Write scheduling information into a buffer
+         * @param buffer Output buffer
+         * @param vec Scheduling data: for each route, list of (customer, timing) info
+         */
+        void write_vector_of_scheduling(json_buffer &buffer, const vector<vector<operation_info>> &vec) const;
+
+        /**
+         * @brief Write scheduling information on a single line (NDJSON)
+         * @param buffer Output buffer
+         * @param vec Scheduling data: for each route, list of (customer, timing) info
+         *
+         * `[[{"customer": c, "arrival_starting": [a, s]}, ...], ...]`, one
+         * array per route, no line breaks nor padding.
+         */
+        void write_compact_scheduling(json_buffer &buffer, const vector<vector<operation_info>> &vec) const;
+
         /**
          * @brief Write a pair of doubles in JSON format
          * @param os Output stream
          * @param p Pair to write
          */
         void write_pair_(ostream &os, const pair<double, double> &p) const;
+
+        /**
+         * @brief Write a pair of doubles into a buffer
+         * @param buffer Output buffer
+         * @param p Pair to write
+         */
+        void write_pair_(json_buffer &buffer, const pair<double, double> &p) const;
         
         /**
          * @brief Read a pair of doubles from JSON format
@@ -152,6 +188,13 @@ namespace SYNC_LIB
          * @param vec Vector of pairs
          */
         void write_vector_of_pairs(ostream &os, const vector<pair<double, double>> &vec) const;
+
+        /**
+         * @brief Write a vector of pairs into a buffer
+         * @param buffer Output buffer
+         * @param vec Vector of pairs
+         */
+        void write_vector_of_pairs(json_buffer &buffer, const vector<pair<double, double>> &vec) const;
         
         /**
          * @brief Read a vector of pairs from JSON format
@@ -2,6 +2,8 @@
 
 #include "sync_model_a_builder.hpp"
 #include "sync_solution.hpp"
+#include "route_times.hpp"
+#include "sparse_x.hpp"
 
 #include "matrix.hpp"
 
@@ -45,7 +47,7 @@ namespace SYNC_LIB
         vector<SYNC_LIB::sync_operation> operations_;   ///< All operations in the problem
         GOMA::matrix<int> operations_map_;              ///< Maps (customer, depot) to operation index
         size_t n_depots_;                               ///< Number of depots/vehicles
-        vector<string> routing_arc_names_;              ///< Human-readable arc names
+        size_t n_customers_;                            ///< Number of customers
 
     public:
         model_a_solution_interface(void);
@@ -60,15 +62,44 @@ namespace SYNC_LIB
          */
         void set(const sync_model_a_builder &model_builder);
 
+        /**
+         * @brief Reject routes the model has no operations for
+         * @param routes One route per depot, 0-based nodes
+         * @throw std::invalid_argument On the first malformed route
+         *
+         * The conversions below index the operation map without bound
+         * checks: routes from other processes (sch_server, --stream) are
+         * validated first.
+         */
+        void validate_routes(const vector<vector<int>> &routes) const;
+
         /**
          * @brief Convert sync_solution to Model A variable vector
          * @param sol Input solution (routes)
          * @param x Output: binary decision variables (1 if arc used, 0 otherwise)
+         * @param times Output, if not NULL: time from the departure to each
+         *        stop of each route (an arc pruned from the model counts
+         *        1E9, as sync_model_a_builder::get_arc_time)
+         * @return false if the routes use an arc left out of the model
+         *         (arc_pruning); x then holds the other arcs only
          * 
          * This converts a high-level routing solution into the arc-based
-         * representation used in optimization models.
+         * representation used in optimization models. The route times are
+         * filled in the same pass, from the arc indices already looked up.
+         */
+        bool sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, vector<double> &x, route_times *times = nullptr) const;
+
+        /**
+         * @brief Convert sync_solution to the nonzero Model A variables
+         * @param sol Input solution (routes)
+         * @param x Output: arcs of the routes, value 1, sorted by arc
+         * @param times Output, if not NULL: as the dense version
+         * @return false if the routes use an arc left out of the model
+         *
+         * Same arcs as the dense version, in O(route length) instead of a
+         * pass over every routing arc.
          */
-        void sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, vector<double> &x) const;
+        bool sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, sparse_x &x, route_times *times = nullptr) const;
         
         /**
          * @brief Convert Model A variable vector to sync_solution
@@ -86,5 +117,15 @@ namespace SYNC_LIB
          * @param sync_pair Output: (customer_id, depot_id) pair
          */
         void operation_2_sync_solution_pair(const int operation, pair<int, int> &sync_pair) const;
+
+    private:
+        /**
+         * @brief Call use(arc) for every routing arc of the routes
+         * @return false if a route uses an arc left out of the model (skipped)
+         */
+        template <typename F>
+        bool route_arcs_(const SYNC_LIB::sync_solution &sol, route_times *times, const F &use) const;
+
+        inline double arc_time_(const int inx) const { return inx != EMPTY_VAR ? routing_arc_times_[inx] : 1E9; }
     };
 }
\ No newline at end of file
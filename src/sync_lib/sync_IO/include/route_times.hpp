@@ -0,0 +1,120 @@
+/**
+ * @file route_times.hpp
+ * @brief Cumulative route times: elapsed time between two stops in O(1)
+ *
+ * The time of a routing arc (i, j) is the service time of i plus the travel
+ * time to j. Summing them between two stops of a route costs one arc lookup
+ * per arc in between. route_times keeps, for each route, the time from the
+ * departure to every stop, so that the time between stops p and q is one
+ * subtraction: elapsed(p) = Σ t(stop r - 1, stop r), r = 1..p.
+ *
+ * Waiting is not included: elapsed(p) is the earliest arrival at stop p
+ * when the vehicle leaves the depot at 0 and never waits, and the last
+ * entry is the travel and service time of the whole route, a lower bound
+ * on its duration.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class route_times
+     * @brief Per-route prefix sums of routing arc times
+     *
+     * ```cpp
+     * route_times times;
+     *
+     * interface.sync_solution_2_model_a(sol, x, &times);  // built in the same pass
+     *
+     * const double t{times.get_elapsed(k, p, q)};          // stop p to stop q of route k
+     *
+     * if (times.get_duration(k) > max_distance)
+     *     // route k is too long, whatever the schedule
+     * ```
+     *
+     * Stops are positions in the sync_solution layout: stop 0 is the depot
+     * departure, the last stop the return to the depot.
+     */
+    class route_times
+    {
+    protected:
+        vector<vector<int>> operations_; ///< Operation at each stop of each route
+        vector<vector<double>> elapsed_; ///< Time from the departure to each stop
+
+    public:
+        route_times(void);
+        virtual ~route_times(void);
+
+        /**
+         * @brief Empty every route
+         * @param n_routes Routes (one per depot)
+         *
+         * The stops of earlier routes keep their capacity.
+         */
+        void resize(size_t n_routes);
+
+        /**
+         * @brief Restart a route at its depot departure
+         * @param k Route
+         * @param operation Departure operation
+         */
+        void start_route(size_t k, int operation);
+
+        /**
+         * @brief Append a stop to a route
+         * @param k Route (started)
+         * @param operation Operation of the stop
+         * @param arc_time Time of the arc from the previous stop
+         */
+        inline void push_stop(const size_t k, const int operation, const double arc_time)
+        {
+            assert(!elapsed_[k].empty());
+
+            operations_[k].push_back(operation);
+            elapsed_[k].push_back(elapsed_[k].back() + arc_time);
+        }
+
+        inline size_t get_n_routes(void) const { return elapsed_.size(); }
+        inline size_t get_n_stops(const size_t k) const { return elapsed_[k].size(); }
+        inline int get_operation(const size_t k, const size_t p) const { return operations_[k][p]; }
+
+        /**
+         * @brief Time between two stops of a route
+         * @param k Route
+         * @param p First stop
+         * @param q Second stop (p ≤ q)
+         * @return Travel and service time from stop p to stop q
+         */
+        inline double get_elapsed(const size_t k, const size_t p, const size_t q) const
+        {
+            assert(p <= q && q < elapsed_[k].size());
+
+            return elapsed_[k][q] - elapsed_[k][p];
+        }
+
+        /**
+         * @brief Earliest arrival at a stop, leaving the depot at 0
+         * @param k Route
+         * @param p Stop
+         */
+        inline double get_arrival(const size_t k, const size_t p) const { return elapsed_[k][p]; }
+
+        /**
+         * @brief Travel and service time of a whole route
+         * @param k Route
+         */
+        inline double get_duration(const size_t k) const { return elapsed_[k].back(); }
+
+        /**
+         * @brief Longest route
+         * @return Its duration, 0 if there is no route
+         */
+        double get_max_duration(void) const;
+    };
+}
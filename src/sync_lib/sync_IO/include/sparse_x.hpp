@@ -0,0 +1,129 @@
+/**
+ * @file sparse_x.hpp
+ * @brief Routing solution x as its nonzero entries
+ *
+ * x has one entry per routing arc, O(n²) per depot, while an integral
+ * routing uses one arc per operation. A dense x costs a pass over every
+ * arc to build, to compare with the previous one and to load in the LP;
+ * sparse_x keeps the nonzero entries only, sorted by arc, so that this
+ * work scales with the support of x.
+ *
+ * A dense copy kept alongside (for the checkers that read x by arc) is
+ * updated in O(support) too: unscatter() the previous x, scatter() the
+ * new one.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sparse_x
+     * @brief Sorted (arc, value) pairs of a routing solution
+     *
+     * ```cpp
+     * sparse_x x;
+     *
+     * interface.sync_solution_2_model_a(sol, x);   // model_a_solution_interface
+     * checker.is_feasible(x, s, alpha, beta, gamma);
+     *
+     * x.unscatter(dense);                          // dense mirror, O(support)
+     * ```
+     */
+    class sparse_x
+    {
+    protected:
+        size_t n_;             ///< Routing arcs (size of the dense x)
+        vector<int> index_;    ///< Arcs with a nonzero value, increasing
+        vector<double> value_; ///< Their values
+
+    public:
+        sparse_x(void);
+
+        /**
+         * @brief Empty solution (x = 0)
+         * @param n Routing arcs
+         */
+        explicit sparse_x(size_t n);
+
+        /**
+         * @brief Nonzero entries of a dense solution
+         * @param x Dense solution
+         * @param tol Entries with |x_a| ≤ tol are left out
+         */
+        explicit sparse_x(const vector<double> &x, double tol = 0.0);
+
+        virtual ~sparse_x(void);
+
+        /**
+         * @brief Set x = 0
+         * @param n Routing arcs
+         *
+         * The entries keep their capacity.
+         */
+        void clear(size_t n);
+
+        /**
+         * @brief Set an entry
+         * @param arc Routing arc (< n)
+         * @param value Its value
+         *
+         * Entries may be pushed in any order: call sort() afterwards.
+         */
+        inline void push_back(const int arc, const double value)
+        {
+            assert(arc >= 0 && (size_t)arc < n_);
+
+            index_.push_back(arc);
+            value_.push_back(value);
+        }
+
+        /**
+         * @brief Sort the entries by arc
+         *
+         * An arc pushed twice keeps the value pushed last, as the
+         * assignment to a dense x would.
+         */
+        void sort(void);
+
+        /**
+         * @brief Set the entries of x in a dense solution
+         * @param x Dense solution (size n, zero outside this support)
+         */
+        void scatter(vector<double> &x) const;
+
+        /**
+         * @brief Reset the entries of x in a dense solution
+         * @param x Dense solution (size n)
+         */
+        void unscatter(vector<double> &x) const;
+
+        /**
+         * @brief Dense solution
+         * @param x Output: n values
+         */
+        void to_dense(vector<double> &x) const;
+
+        /**
+         * @brief Value of an arc (binary search)
+         * @param arc Routing arc
+         * @return x_arc, 0 outside the support
+         */
+        double at(int arc) const;
+
+        inline size_t get_n(void) const { return n_; }
+        inline size_t size(void) const { return index_.size(); }
+        inline bool empty(void) const { return index_.empty(); }
+
+        inline int get_index(const size_t p) const { return index_[p]; }
+        inline double get_value(const size_t p) const { return value_[p]; }
+
+        inline const vector<int> &get_indices(void) const { return index_; }
+        inline const vector<double> &get_values(void) const { return value_; }
+    };
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <iostream>
+
+#include "LP_solver.hpp"
+
+using namespace std;
+
+/**
+ * @file sync_cuts.hpp
+ * @brief Sparse cut rows for injection into a caller-owned LP
+ *
+ * Stores a batch of cuts in the row-wise layout of CPXaddrows and
+ * LP_solver::add_cut (rhs, sense, rmatbeg, rmatind, rmatval), so the
+ * violated cycles found by path_finder can be added to a branch-and-cut
+ * master without writing and parsing text files.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_cuts
+     * @brief Batch of sparse cut rows
+     *
+     * Cut k has sense get_sense()[k], right-hand side get_rhs()[k] and the
+     * non-zeros rmatind/rmatval in [rmatbeg[k], rmatbeg[k + 1]). rmatbeg has
+     * one extra entry (the total number of non-zeros), so the arrays can be
+     * passed as they are to CPXaddrows / CPXcutcallbackadd-like calls:
+     *
+     * ```cpp
+     * sync_cuts cuts;
+     * infeasible.get_cuts(cuts);
+     *
+     * // Caller-owned CPLEX model
+     * CPXaddrows(env, lp, 0, cuts.get_n_cuts(), cuts.get_nz(), cuts.get_rhs().data(), cuts.get_sense().data(),
+     *            cuts.get_rmatbeg().data(), cuts.get_rmatind().data(), cuts.get_rmatval().data(), NULL, NULL);
+     *
+     * // Or any GOMA::LP_solver (one add_cut call per cut)
+     * cuts.add_to(solver);
+     * ```
+     */
+    class sync_cuts
+    {
+    private:
+        vector<double> rhs_;     ///< Right-hand side of each cut
+        vector<char> sense_;     ///< Sense of each cut ('L', 'E', 'G')
+        vector<int> rmatbeg_;    ///< Start of each cut in rmatind/rmatval (n_cuts + 1)
+        vector<int> rmatind_;    ///< Column index of each non-zero
+        vector<double> rmatval_; ///< Value of each non-zero
+
+    public:
+        sync_cuts(void);
+
+        virtual ~sync_cuts(void);
+
+        /**
+         * @brief Remove every cut
+         */
+        void clear(void);
+
+        /**
+         * @brief Append one cut
+         * @param ind Column indices of the non-zeros
+         * @param val Values of the non-zeros (same size as ind)
+         * @param rhs Right-hand side
+         * @param sense Sense ('L', 'E', 'G')
+         */
+        void add(const vector<int> &ind, const vector<double> &val, double rhs, char sense);
+
+        /**
+         * @brief Add every cut to an LP
+         * @param solver LP (one add_cut call per cut)
+         */
+        void add_to(GOMA::LP_solver &solver) const;
+
+        /**
+         * @brief Write cuts as "a_1 x_j1 + ... <= rhs" lines
+         * @param os Output stream
+         */
+        ostream &write(ostream &os) const;
+
+        /**
+         * @brief Get number of cuts
+         * @return Number of cuts
+         */
+        inline int get_n_cuts(void) const { return (int)rhs_.size(); }
+
+        /**
+         * @brief Get number of non-zeros of all cuts
+         * @return Number of non-zeros
+         */
+        inline int get_nz(void) const { return (int)rmatind_.size(); }
+
+        /**
+         * @brief Get number of non-zeros of one cut
+         * @param k Cut index
+         * @return Number of non-zeros of cut k
+         */
+        inline int get_nz(const int k) const { return rmatbeg_[k + 1] - rmatbeg_[k]; }
+
+        inline const vector<double> &get_rhs(void) const { return rhs_; }        ///< Right-hand sides (n_cuts)
+        inline const vector<char> &get_sense(void) const { return sense_; }      ///< Senses (n_cuts)
+        inline const vector<int> &get_rmatbeg(void) const { return rmatbeg_; }   ///< Cut starts (n_cuts + 1)
+        inline const vector<int> &get_rmatind(void) const { return rmatind_; }   ///< Column indices (nz)
+        inline const vector<double> &get_rmatval(void) const { return rmatval_; } ///< Coefficients (nz)
+    };
+}
@@ -5,11 +5,24 @@
 #include <iostream>
 
 #include "sync_model_a_builder.hpp"
+#include "sync_cuts.hpp"
+#include "json_buffer.hpp"
 
 using namespace std;
 
 namespace SYNC_LIB
 {
+    /**
+     * @enum graph_filter
+     * @brief Arcs written by the primal-dual graph writers
+     */
+    enum class graph_filter
+    {
+        FULL,        ///< Routing arcs with x or α nonzero, sync arcs with γ nonzero
+        CERTIFICATE, ///< Arcs with α or γ nonzero (the support of the certificate)
+        CYCLES       ///< Arcs of the violated cycles only
+    };
+
     /**
      * @class sync_infeasible
      * @brief Exception for infeasible synchronization constraints
@@ -28,17 +41,18 @@ namespace SYNC_LIB
         vector<double> beta_;  ///< Dual variables for route duration constraints
         vector<double> gamma_; ///< Dual variables for synchronization constraints
 
-        vector<vector<int>> violated_cycles_; ///< Detected violated cycles in the solution
+        cycle_list violated_cycles_; ///< Detected violated cycles in the solution (flat, reused between checks)
 
         const vector<string> &operation_names_;
-        const vector<string> &routing_arc_names_; ///< Names for routing arcs (display)
-        const vector<string> &sync_arc_names_;    ///< Names for sync arcs (display)
+        const sync_model_a_builder &builder_;     ///< Model (arc names for display, built on demand)
         const vector<triplet> &routing_arcs_;
         const vector<triplet> &sync_arcs_;
         const vector<double> &routing_arc_times_;
 
         const vector<double> &x_;
 
+        bool truncated_;         ///< The check or the cycle search was stopped by a deadline
+
         const double tol_{1E-6}; ///< Tolerance for variable activity
 
     public:
@@ -53,14 +67,91 @@ namespace SYNC_LIB
         inline const vector<double> &beta(void) const { return beta_; }
         inline const vector<double> &gamma(void) const { return gamma_; }
 
-        inline vector<vector<int>> &violated_cycles(void) { return violated_cycles_; }
-        inline const vector<vector<int>> &violated_cycles(void) const { return violated_cycles_; }
+        inline cycle_list &violated_cycles(void) { return violated_cycles_; }
+        inline const cycle_list &violated_cycles(void) const { return violated_cycles_; }
+
+        /**
+         * @brief Check if the answer was cut short by a deadline
+         * @return true if x is not proven infeasible (the check was
+         *         stopped, no cycles) or the violated cycles are only those
+         *         found before the cycle search was stopped
+         */
+        inline bool truncated(void) const { return truncated_; }
+        inline void set_truncated(const bool truncated) { truncated_ = truncated; }
 
         ostream &write_infeasible_paths(ostream &os) const;
-        ostream &write_primal_dual_graph(ostream &os) const;
+        ostream &write_primal_dual_graph(ostream &os, const graph_filter filter = graph_filter::FULL) const;
+
+        /**
+         * @brief Primal-dual graph in DOT format, through a buffer
+         * @param buffer Output buffer (its stream gets 64 KiB blocks)
+         * @param filter Arcs to write
+         *
+         * FULL writes the graph of write_primal_dual_graph(ostream&). On
+         * large instances it has too many arcs for Graphviz to lay out:
+         * CERTIFICATE drops the arcs only x uses, and CYCLES keeps the
+         * violated cycles only.
+         */
+        void write_primal_dual_graph(json_buffer &buffer, const graph_filter filter = graph_filter::FULL) const;
+
+        /**
+         * @brief Primal-dual graph as a binary edge list
+         * @param os Output stream (binary)
+         * @param filter Arcs to write
+         * @return false if the stream failed
+         *
+         * Native byte order, no padding:
+         *
+         *     char[8]  "CTSPEDG"
+         *     uint32   version (1)
+         *     uint32   0x01020304 (byte order check)
+         *     uint32   number of operations
+         *     uint32   number of edges
+         *     edges:   int32 source operation, int32 target operation,
+         *              int32 arc (routing arcs first, sync arcs shifted by
+         *              the number of routing arcs, as in violated_cycles()),
+         *              float x (0 for sync arcs), float α or γ
+         */
+        bool write_primal_dual_edges(ostream &os, const graph_filter filter = graph_filter::FULL) const;
+
+        /**
+         * @brief Violated cycles as a single-line JSON array (NDJSON)
+         * @param buffer Output buffer
+         *
+         * `[["(a_b)", "(b_c)", ...], ...]`: one array of arc names per
+         * cycle, as in write_infeasible_paths.
+         */
+        void write_json_cycles(json_buffer &buffer) const;
+
+        /**
+         * @brief Path elimination cuts of the violated cycles
+         * @param cuts [out] Cuts are appended (call cuts.clear() to start anew)
+         * @param col_offset Column of routing arc 0 in the caller's model
+         * @return Number of cuts appended
+         *
+         * For each violated cycle with routing arcs R (model_a indices):
+         *
+         *     sum_{a in R} x_a <= |R| - 1
+         *
+         * Column of arc a is a + col_offset. Cycles without routing arcs
+         * are skipped.
+         */
+        int get_cuts(sync_cuts &cuts, int col_offset = 0) const;
 
     private:
-        ostream &write_path_(ostream &os, const vector<int> &cycle) const;
-        ostream &write_(ostream &os, const vector<double> &x, const vector<double> &alpha_v, const vector<double> &beta_v) const;
+        ostream &write_path_(ostream &os, const GOMA::array_view<int> &cycle) const;
+
+        /**
+         * @brief Arcs passing a filter
+         * @param filter Arcs to keep
+         * @param arcs [out] Arc indices, routing arcs first, sync arcs shifted
+         *        by the number of routing arcs
+         */
+        void select_arcs_(const graph_filter filter, vector<int> &arcs) const;
+
+        inline double alpha_at_(const size_t i) const { return i < alpha_.size() ? alpha_[i] : 0; }
+        inline double gamma_at_(const size_t i) const { return i < gamma_.size() ? gamma_[i] : 0; }
+
+        void write_style_(json_buffer &buffer, const double val) const;
     };
 } // namespace SYNC_LIB
\ No newline at end of file
@@ -9,7 +9,6 @@
 #include <iostream>
 
 #include "sync_types.hpp"
-#include "matrix.hpp"
 
 using namespace std;
 
@@ -27,12 +26,15 @@ namespace SYNC_LIB
      * @class pair_map
      * @brief Efficient mapping from operation pairs to linear indices
      * 
-     * This class provides a matrix-based mapping from pairs of operations (i,j)
-     * to linear indices used in optimization models. This is particularly useful
-     * for Model A formulations where decision variables are indexed by arcs.
+     * This class provides a mapping from pairs of operations (i,j) to linear
+     * indices used in optimization models. This is particularly useful for
+     * Model A formulations where decision variables are indexed by arcs.
      * 
-     * The mapping uses 1-based indexing internally for compatibility with
-     * mathematical formulations, but provides 0-based access methods.
+     * The pairs are stored row-wise (compressed sparse rows): for each
+     * operation i, its successors j in increasing order and the index of
+     * arc (i,j). Memory is O(n_items + |arcs|) instead of the
+     * (n_items + 1)² entries of a dense index matrix; at(i, j) is a binary
+     * search over the successors of i.
      * 
      * Example:
      * - If arc from operation 0 to operation 5 is the 3rd arc, then:
@@ -41,7 +43,10 @@ namespace SYNC_LIB
     class pair_map
     {
     private:
-        GOMA::matrix<int> map_;  ///< Matrix storing the pair-to-index mapping
+        size_t n_items_;          ///< Number of operations
+        vector<int> row_begin_;   ///< Start of the successors of each operation (n_items + 1)
+        vector<int> successors_;  ///< Successors, sorted within each row
+        vector<int> indices_;     ///< Index of arc (i, successors_[k])
 
     public:
         /**
@@ -62,17 +67,17 @@ namespace SYNC_LIB
          * @param arcs Vector of triplets (i, j, k_i, k_j) defining arcs
          * 
          * This method builds the mapping by assigning sequential indices
-         * to each arc in the provided list.
+         * to each arc in the provided list (a repeated pair keeps its last
+         * index).
          */
         void set(const vector<triplet> &arcs);
 
         /**
-         * @brief Get the underlying mapping matrix
-         * @return Constant reference to the mapping matrix
+         * @brief Get number of mapped pairs
          */
-        inline const GOMA::matrix<int> &get_map(void) const
+        inline size_t size(void) const
         {
-            return map_;
+            return successors_.size();
         }
 
         /**
@@ -80,9 +85,9 @@ namespace SYNC_LIB
          * @param t Pair of operation indices
          * @return Linear index, or EMPTY_VAR (-1) if pair not in mapping
          */
-        int at(const pair<int,int> &t) const
+        inline int at(const pair<int,int> &t) const
         {
-            return map_(t.first + 1, t.second + 1);
+            return at(t.first, t.second);
         }
 
         /**
@@ -91,9 +96,11 @@ namespace SYNC_LIB
          * @param j Second operation index
          * @return Linear index, or EMPTY_VAR (-1) if pair not in mapping
          */
-        int at(const int i, const int j) const
-        {
-            return map_(i + 1, j + 1);
-        }
+        int at(const int i, const int j) const;
+
+        /**
+         * @brief Heap bytes held (row offsets, successors and indices)
+         */
+        size_t get_memory_bytes(void) const;
     };
 }
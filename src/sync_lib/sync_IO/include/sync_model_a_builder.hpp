@@ -3,6 +3,8 @@
 #include "sync_model_builder.hpp"
 #include "sync_mapping.hpp"
 
+#include <memory>
+
 /**
  * @file sync_model_a_builder.hpp
  * @brief Advanced model builder for arc-based CTSP formulations
@@ -24,6 +26,43 @@
 
 namespace SYNC_LIB
 {
+    class sync_model_snapshot;
+
+    /**
+     * @struct sync_routing_arrays
+     * @brief Routing arcs of a Model A with their times, map and adjacency lists
+     *
+     * They depend on the distances, the days, the demands and the maximum
+     * route duration, not on the maximum allowable differential: the
+     * variants of an instance that only differ in it share one copy
+     * (sync_model_family). Immutable once indexed.
+     */
+    struct sync_routing_arrays
+    {
+        pair_map pair_map_;                 ///< Maps (op_i, op_j) to routing arc index
+        vector<triplet> arcs_;              ///< List of all routing arcs
+        vector<double> times_;              ///< Travel time for each routing arc
+        vector<vector<int>> outbound_arcs_; ///< For each operation, outgoing routing arcs
+        vector<vector<int>> inbound_arcs_;  ///< For each operation, incoming routing arcs
+
+        /**
+         * @brief Empty arrays
+         * @param n_operations Operations (rows of the map and adjacency lists)
+         */
+        explicit sync_routing_arrays(size_t n_operations);
+
+        /**
+         * @brief Build the map and the adjacency lists of arcs_
+         * @param n_operations Operations
+         */
+        void index(size_t n_operations);
+
+        /**
+         * @brief Heap bytes held by the arrays
+         */
+        size_t get_memory_bytes(void) const;
+    };
+
     /**
      * @class sync_model_a_builder
      * @brief Builds Model A arc-based formulation for CTSP problems
@@ -51,26 +90,18 @@ namespace SYNC_LIB
         const size_t n_vehicles_;           ///< Number of vehicles/depots
         const size_t n_depots_;             ///< Number of depot locations
         const double max_distance_;         ///< Maximum route distance/duration
-        const double time_windows_max_size_;///< Maximum time window width
+        double time_windows_max_size_;      ///< Maximum time window width
 
         // Routing arc structures
-        pair_map routing_arcs_pair_map_;    ///< Maps (op_i, op_j) to routing arc index
-        vector<triplet> routing_arcs_;      ///< List of all routing arcs
-        vector<string> routing_arc_names_;  ///< Human-readable routing arc names
-        vector<double> routing_arc_times_;  ///< Travel time for each routing arc
-
-        vector<vector<int>> routing_outbound_arcs_;  ///< For each operation, outgoing routing arcs
-        vector<vector<int>> routing_inbound_arcs_;   ///< For each operation, incoming routing arcs
+        shared_ptr<const sync_routing_arrays> routing_arrays_;       ///< Routing arcs, times, map and adjacency lists (shared by variants)
+        mutable shared_ptr<const vector<string>> routing_arc_names_; ///< Routing arc names, built on the first get_routing_arc_names()
 
         // Synchronization arc structures  
         pair_map sync_arcs_pair_map_;       ///< Maps (op_i, op_j) to sync arc index
         vector<triplet> sync_arcs_;         ///< List of all synchronization arcs
-        vector<string> sync_arc_names_;     ///< Human-readable sync arc names
+        mutable shared_ptr<const vector<string>> sync_arc_names_;    ///< Sync arc names, built on the first get_sync_arc_names()
         vector<double> sync_arc_times_;     ///< Time offset for each sync arc
 
-        // Global time matrix
-        GOMA::matrix<double> arc_time_matrix_;  ///< Travel times between all operations
-
         // Operation metadata
         vector<string> operation_names_;        ///< Operation identifiers
         vector<vector<double>> operation_resources_;  ///< Resource consumption per operation
@@ -79,6 +110,9 @@ namespace SYNC_LIB
         vector<int> operation_2_customer_;      ///< Maps operation to customer ID
         vector<int> operation_2_depot_;         ///< Maps operation to depot ID
 
+        /// Shared read-only copy for the checkers, built by the first get_snapshot()
+        mutable shared_ptr<const sync_model_snapshot> snapshot_;
+
     public:
         /**
          * @brief Construct Model A builder
@@ -90,15 +124,64 @@ namespace SYNC_LIB
          * @param demands Customer demand matrix [customer][resource]
          * @param max_distance Maximum route distance/duration
          * @param w Time window widths for synchronization (per customer)
-         * @param distances Distance/time matrix between locations
+         * @param distances Distance/time matrix between locations (stored or
+         *        computed on demand; only read while building)
          * @param triangle_inequality Whether to enforce triangle inequality in preprocessing
+         * @param pruning Routing arcs left out of the model (duration pruning
+         *        only applies if triangle_inequality holds)
+         * @param n_threads Threads building the partitions and the arc arrays
+         *        (default 1, 0: one per core); the model does not depend on it
          */
         sync_model_a_builder(const int problem_type, const string &instance_name, 
                             const size_t n_vehicles, const size_t n_depots, 
                             const size_t n_customers, const vector<vector<int>> &demands, 
                             const double max_distance, const vector<double> &w, 
-                            const GOMA::matrix<double> &distances, 
-                            const bool triangle_inequality);
+                            const GOMA::distance_oracle &distances, 
+                            const bool triangle_inequality,
+                            const arc_pruning &pruning = arc_pruning(),
+                            const size_t n_threads = 1);
+
+        /**
+         * @brief Restore a Model A builder from the arrays saved by sync_model_cache
+         * @param problem_type 1=CTSP1 (time window sync), 2=CTSP2 (exact sync)
+         * @param instance_name Problem identifier
+         * @param n_vehicles Number of vehicles
+         * @param n_depots Number of depot locations
+         * @param n_customers Number of customers
+         * @param max_distance Maximum route distance/duration
+         * @param time_windows_max_size Maximum time window width
+         * @param operations Operations (moved from)
+         * @param routing_arcs Routing arcs (moved from)
+         * @param routing_arc_times Travel time of each routing arc (moved from)
+         * @param sync_arcs Synchronization arcs (moved from)
+         * @param sync_arc_times Time offset of each sync arc (moved from)
+         *
+         * Names, maps and per-operation arrays are derived from these in
+         * linear time (plus the pair_map initialization); no distance is read.
+         * The base class partitions are left empty.
+         */
+        sync_model_a_builder(const int problem_type, const string &instance_name,
+                            const size_t n_vehicles, const size_t n_depots,
+                            const size_t n_customers, const double max_distance,
+                            const double time_windows_max_size,
+                            vector<sync_operation> &&operations,
+                            vector<triplet> &&routing_arcs, vector<double> &&routing_arc_times,
+                            vector<triplet> &&sync_arcs, vector<double> &&sync_arc_times);
+
+        /**
+         * @brief Variant of a built model with another maximum time window width
+         * @param base Built model of the same distances, days, demands and
+         *        maximum route duration
+         * @param instance_name Problem identifier of the variant
+         * @param time_windows_max_size Its MAXIMUM_ALLOWABLE_DIFFERENTIAL
+         *        (the same for every customer)
+         *
+         * The routing arrays and the snapshot are shared with base, not
+         * copied; operations, sync arcs and their maps are copied and the
+         * width-dependent entries rewritten. No distance is read and the
+         * base class partitions are left empty. O(operations + sync arcs).
+         */
+        sync_model_a_builder(const sync_model_a_builder &base, const string &instance_name, double time_windows_max_size);
 
         virtual ~sync_model_a_builder(void);
 
@@ -106,13 +189,26 @@ namespace SYNC_LIB
         inline const vector<int> &get_operation_2_customer(void) const { return operation_2_customer_; }
         inline const vector<int> &get_operation_2_depot(void) const { return operation_2_depot_; }
         inline double get_time_windows_max_size(void) const { return time_windows_max_size_; }
+        inline int get_problem_type(void) const { return problem_type_; }
         inline size_t get_n_vehicles(void) const { return n_vehicles_; }
         inline size_t get_n_depots(void) const { return n_depots_; }
         inline size_t get_n_customers(void) const { return n_customers_; }
         inline double get_max_distance(void) const { return max_distance_; }
 
-        // Accessors for time/cost data
-        inline const GOMA::matrix<double> &get_arc_time_matrix(void) const { return arc_time_matrix_; }
+        /**
+         * @brief Travel time between two operations
+         * @param i Tail operation
+         * @param j Head operation
+         * @return Time of the routing arc (i,j), 1E9 if there is none
+         * @note Looked up in the routing arc map: no operations x operations
+         *       time matrix is kept
+         */
+        inline double get_arc_time(const int i, const int j) const
+        {
+            const int arc{routing_arrays_->pair_map_.at(i, j)};
+
+            return arc != EMPTY_VAR ? routing_arrays_->times_[arc] : 1E9;
+        }
 
         // Accessors for operations metadata
         inline const vector<string> &get_operation_names(void) const { return operation_names_; }
@@ -123,24 +219,94 @@ namespace SYNC_LIB
         inline size_t get_n_operations(void) const { return sync_model_builder::operations_.size(); }
 
         // Accessors for routing arc data
-        size_t get_n_routing_arcs(void) const { return routing_arcs_.size(); }
-        inline const pair_map &get_routing_arcs_pair_map(void) const { return routing_arcs_pair_map_; }
-        inline const vector<triplet> &get_routing_arcs(void) const { return routing_arcs_; }
-        inline const vector<string> &get_routing_arc_names(void) const { return routing_arc_names_; }
-        inline const vector<double> &get_routing_arc_times(void) const { return routing_arc_times_; }
-        inline const vector<vector<int>> &get_routing_outbound_arcs(void) const { return routing_outbound_arcs_; }
-        inline const vector<vector<int>> &get_routing_inbound_arcs(void) const { return routing_inbound_arcs_; }
+        size_t get_n_routing_arcs(void) const { return routing_arrays_->arcs_.size(); }
+        inline const pair_map &get_routing_arcs_pair_map(void) const { return routing_arrays_->pair_map_; }
+        inline const vector<triplet> &get_routing_arcs(void) const { return routing_arrays_->arcs_; }
+
+        /**
+         * @brief Human-readable routing arc names, "(op_i_op_j)"
+         *
+         * Only the cycle, DOT and LP label output read them, so they are
+         * built on the first call (safe from several threads) and not with
+         * the model.
+         */
+        const vector<string> &get_routing_arc_names(void) const;
+
+        inline const vector<double> &get_routing_arc_times(void) const { return routing_arrays_->times_; }
+        inline const vector<vector<int>> &get_routing_outbound_arcs(void) const { return routing_arrays_->outbound_arcs_; }
+        inline const vector<vector<int>> &get_routing_inbound_arcs(void) const { return routing_arrays_->inbound_arcs_; }
+
+        /**
+         * @brief Routing arrays, to check whether two builders share them
+         */
+        inline const shared_ptr<const sync_routing_arrays> &get_routing_arrays(void) const { return routing_arrays_; }
 
         // Accessors for synchronization arc data
         size_t get_n_sync_arcs(void) const { return sync_arcs_.size(); }
         inline const pair_map &get_sync_arcs_pair_map(void) const { return sync_arcs_pair_map_; }
         inline const vector<triplet> &get_sync_arcs(void) const { return sync_arcs_; }
-        inline const vector<string> &get_sync_arc_names(void) const { return sync_arc_names_; }
+
+        /**
+         * @brief Human-readable sync arc names, built on the first call (see get_routing_arc_names)
+         */
+        const vector<string> &get_sync_arc_names(void) const;
+
         inline const vector<double> &get_sync_arc_times(void) const { return sync_arc_times_; }
 
+        /**
+         * @brief Change the maximum time window width of every customer
+         * @param time_windows_max_size New MAXIMUM_ALLOWABLE_DIFFERENTIAL
+         *
+         * Rewrites the times of the customer synchronization arcs (both
+         * operations are customer visits); depot arcs keep max_distance.
+         * Checkers built from this builder must be told with their
+         * update_sync_arc_times() (see conTSP2_scheduling).
+         */
+        void set_time_windows_max_size(double time_windows_max_size);
+
+        /**
+         * @brief Whether a synchronization arc links two visits of one customer
+         * @param arc Sync arc index
+         * @return true for customer arcs (time = time window width)
+         */
+        inline bool is_customer_sync_arc(const size_t arc) const { return sync_arcs_[arc].i_ >= 2 * (int)n_depots_; }
+
+        /**
+         * @brief Routing structure shared by the checkers of this model
+         * @return The same snapshot on every call (built on the first one,
+         *         safe to call from several threads)
+         *
+         * Checkers keep the snapshot instead of copying the arcs, adjacency
+         * lists and operation arrays, so a pool of checkers costs one copy
+         * of the model. Sync arc times are not in it (see
+         * set_time_windows_max_size).
+         */
+        shared_ptr<const sync_model_snapshot> get_snapshot(void) const;
+
+        /**
+         * @brief Heap bytes of the two arc pair maps (routing, sync)
+         */
+        inline size_t get_pair_map_bytes(void) const
+        {
+            return routing_arrays_->pair_map_.get_memory_bytes() + sync_arcs_pair_map_.get_memory_bytes();
+        }
+
+        /**
+         * @brief Heap bytes held by the model arrays
+         *
+         * Arcs, arc times, pair maps, adjacency lists, operation arrays,
+         * arc names and the snapshot once built (the operation partitions
+         * of sync_model_builder are not counted). The routing arrays and the
+         * snapshot count in full even when shared with other variants.
+         */
+        size_t get_memory_bytes(void) const;
+
     private:
-        void init_routing_arcs_map_(vector<triplet> &arcs);
-        void init_sync_arcs_map_(vector<triplet> &arcs);
+        const vector<string> &arc_names_(shared_ptr<const vector<string>> &names, const vector<triplet> &arcs) const;
+        void init_operation_arrays_(void);
+
+        void init_routing_arrays_(void);
+        void init_sync_arcs_map_(vector<triplet> &arcs, vector<double> &times);
 
         void init_routing_operations_subset(vector<vector<int>> &vertices);
 
@@ -150,9 +316,6 @@ namespace SYNC_LIB
         void init_routing_subsets_resources_(vector<vector<double>> &resources);
         void init_sync_subsets_resources_(vector<vector<double>> &resources);
 
-        void init_routing_arc_resources_(vector<double> &costs);
-        void init_sync_arc_resources_(vector<double> &costs);
-
         void init_operation_names_(vector<string> &names);
         void init_operations_map_(GOMA::matrix<int> &operations_map);
         void init_operation_resources_(vector<vector<double>> &resources);
@@ -161,11 +324,6 @@ namespace SYNC_LIB
         void init_routing_subset_maps_(vector<int> &ss_maps);
         void init_sync_subset_maps_(vector<int> &ss_maps);
 
-        void get_routing_outbound_arcs_(vector<vector<int>> &arc_inxs) const;
-        void get_routing_inbound_arcs_(vector<vector<int>> &arc_inxs) const;
-
-        void set_routing_cost_matrix_(GOMA::matrix<double> &cost_matrix) const;
-
         void get_operation_2_customer_(vector<int> &operation_2_customer) const;
         void get_operation_2_depot_(vector<int> &operation_2_depot) const;
 
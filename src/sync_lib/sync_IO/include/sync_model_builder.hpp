@@ -3,10 +3,12 @@
 #include "sync_operations.hpp"
 
 #include "matrix.hpp"
+#include "distance_oracle.hpp"
 
 #include <vector>
 #include <map>
 #include <utility>
+#include <cstdint>
 
 /**
  * @file sync_model_builder.hpp
@@ -20,6 +22,47 @@
 
 namespace SYNC_LIB
 {
+    /**
+     * @class arc_pruning
+     * @brief Routing arcs left out of the model while building it
+     *
+     * build_routing_partition links every pair of operations of a routing
+     * subset. Fewer arcs shrink the checker LP (α rows), the pair maps and
+     * the support graphs together.
+     *
+     * - duration: drop arc (i, j) when d(depot, i) + t_ij + d(j, depot)
+     *   exceeds the maximum route duration, so no route can use it. Sound
+     *   only if the distances satisfy the triangle inequality (ignored
+     *   otherwise by sync_model_a_builder).
+     * - k_nearest: keep arc (i, j) between customers only if j is one of
+     *   the k nearest successors of i or i one of the k nearest
+     *   predecessors of j (ties kept). Depot arcs are always kept. This is
+     *   a candidate-arc restriction: a routing using another arc cannot be
+     *   represented in the model.
+     */
+    class arc_pruning
+    {
+    public:
+        bool duration;    ///< Drop arcs that break the maximum route duration
+        size_t k_nearest; ///< Candidate arcs per customer, 0: all
+
+        arc_pruning(void) : duration(false), k_nearest(0) {}
+
+        arc_pruning(const bool _duration, const size_t _k_nearest) : duration(_duration), k_nearest(_k_nearest) {}
+
+        virtual ~arc_pruning(void) {}
+
+        /**
+         * @brief true if no arc is pruned
+         */
+        inline bool none(void) const { return !duration && (k_nearest == 0); }
+
+        /**
+         * @brief Settings as a number, 0 if no arc is pruned (model cache key)
+         */
+        inline uint64_t get_key(void) const { return ((uint64_t)k_nearest << 1) | (duration ? 1 : 0); }
+    };
+
     /**
      * @class sync_model_builder
      * @brief Builds intermediate operation-based representation for CTSP problems
@@ -36,6 +79,14 @@ namespace SYNC_LIB
      * 
      * This intermediate representation can be used to build various mathematical
      * programming formulations (e.g., Model A, Model B, etc.)
+     *
+     * The routing subsets (one per depot) and the synchronization subsets
+     * (one per customer) are independent: with n_threads != 1 they are
+     * built concurrently, each into its own slot of the partition, so the
+     * model is the same, arc for arc, whatever the thread count. The
+     * routing subsets read the distances from every thread; they are built
+     * by one thread if the oracle is not safe for concurrent reads
+     * (GOMA::distance_oracle::concurrent_reads).
      */
     class sync_model_builder
     {
@@ -57,6 +108,10 @@ namespace SYNC_LIB
         map<operation_pair, int> operations_map_;     ///< Map (customer, vehicle) to operation index
         map<int, operation_pair> operations_map_inv_; ///< Map operation index to (customer, vehicle)
 
+        arc_pruning pruning_;  ///< Routing arcs left out by build_routing_partition
+        size_t n_pruned_arcs_; ///< Routing arcs left out
+        size_t n_threads_;     ///< Threads building the partitions (0: one per core)
+
     public:
         /**
          * @brief Construct model builder for CTSP problem
@@ -68,13 +123,33 @@ namespace SYNC_LIB
          * @param demands Demand matrix [customer][resource_type]
          * @param max_distance Maximum route length/duration
          * @param w Synchronization time window widths per customer
-         * @param distances Distance/time matrix between locations
+         * @param distances Distance/time matrix between locations (stored or
+         *        computed on demand; only read while building)
+         * @param pruning Routing arcs left out of the model (default: none)
+         * @param n_threads Threads building the partitions (default 1, 0: one per core)
          */
         sync_model_builder(const int problem_type, const string &instance_name, 
                           const size_t n_vehicles, const size_t n_depots, 
                           const size_t n_customers, const vector<vector<int>> &demands, 
                           const double max_distance, const vector<double> &w, 
-                          const GOMA::matrix<double> &distances);
+                          const GOMA::distance_oracle &distances,
+                          const arc_pruning &pruning = arc_pruning(),
+                          const size_t n_threads = 1);
+
+        /**
+         * @brief Restore the operations of a builder saved by sync_model_cache
+         * @param problem_type 1 for CTSP1 (time window sync), 2 for CTSP2 (exact sync)
+         * @param instance_name Problem instance identifier
+         * @param n_vehicles Number of vehicles/depots
+         * @param n_customers Number of customers
+         * @param operations Operations as built by build_operations (moved from)
+         * @note The routing and synchronization partitions are not restored
+         *       (left empty): the flat arc arrays of sync_model_a_builder are
+         *       what the model consumers read
+         */
+        sync_model_builder(const int problem_type, const string &instance_name,
+                          const size_t n_vehicles, const size_t n_customers,
+                          vector<sync_operation> &&operations);
 
         virtual ~sync_model_builder(void);
 
@@ -84,6 +159,8 @@ namespace SYNC_LIB
         inline const operations_partition &get_routing(void) const { return routing_; }
         inline const operations_partition &get_synchronization(void) const { return synchronization_; }
         inline size_t get_n_operations(void) const { return operations_.size(); }
+        inline const arc_pruning &get_arc_pruning(void) const { return pruning_; }
+        inline size_t get_n_pruned_arcs(void) const { return n_pruned_arcs_; }
 
         /**
          * @brief Build complete intermediate representation
@@ -96,14 +173,14 @@ namespace SYNC_LIB
          */
         void build_instance(const size_t n_depots, const size_t n_customers, 
                            const vector<vector<int>> &demands, const double max_distance, 
-                           const vector<double> &w, const GOMA::matrix<double> &distances);
+                           const vector<double> &w, const GOMA::distance_oracle &distances);
 
         // Build components of the model
         void build_operations(const size_t n_depots, const size_t n_customers, 
                              const vector<double> &w, const double max_distance, 
                              const vector<vector<int>> &demands);
         void build_routing_partition(const size_t n_depots, const double max_distance, 
-                                     const GOMA::matrix<double> &distances);
+                                     const GOMA::distance_oracle &distances);
         void build_synchronization_partition(const size_t n_depots, const size_t n_customers, 
                                              const vector<double> &w, const double max_distance);
 
@@ -113,7 +190,7 @@ namespace SYNC_LIB
                              const vector<vector<int>> &demands, 
                              vector<sync_operation> &operations);
         void build_routing_partition(const size_t n_depots, const double max_distance, 
-                                     const GOMA::matrix<double> &distances, 
+                                     const GOMA::distance_oracle &distances, 
                                      const vector<sync_operation> &operations, 
                                      operations_partition &routing);
         void build_synchronization_partition(const size_t n_depots, const size_t n_customers, 
@@ -158,6 +235,19 @@ namespace SYNC_LIB
         void get_routing_subsets_maps(vector<int> &ss_maps) const;
         void get_sync_subsets_maps(vector<int> &ss_maps) const;
 
+    protected:
+        /**
+         * @brief Arcs of a partition and one resource of each, in get_arcs_ order
+         * @param P Partition (arcs between subsets first, then subset by subset)
+         * @param resource Resource copied to values (routing: 1, time; sync: 0)
+         * @param arcs Output: arcs (replaced)
+         * @param values Output: resource of each arc (replaced)
+         *
+         * Each subset is copied to its own range (prefix sums of the subset
+         * sizes), n_threads_ subsets at a time.
+         */
+        void flatten_arcs_(const operations_partition &P, size_t resource, vector<triplet> &arcs, vector<double> &values) const;
+
     private:
         // Internal methods for extracting information from partitions
         void get_arcs_(const operations_partition &P, vector<triplet> &arcs) const;
@@ -167,5 +257,19 @@ namespace SYNC_LIB
         void init_arcs_(const operation_arc_list &A, vector<triplet> &arcs) const;
         void init_arc_labels_(const vector<sync_operation> &operations, const operation_arc_list &A, vector<string> &labels) const;
         void init_arc_resources_(const operation_arc_list &A, vector<vector<double>> &resources) const;
+
+        /**
+         * @brief k-th smallest arc time out of and into each operation of a subset
+         * @param r_subset Operations of the routing subset
+         * @param node Distance matrix node of each operation
+         * @param n_depots Number of depots (depot operations are skipped)
+         * @param distances Distance matrix
+         * @param out_threshold Output: per position in r_subset, time of the
+         *        k-th nearest customer successor (infinity if fewer)
+         * @param in_threshold Output: same for predecessors
+         */
+        void get_knn_thresholds_(const vector<int> &r_subset, const vector<int> &node, const size_t n_depots,
+                                 const GOMA::distance_oracle &distances,
+                                 vector<double> &out_threshold, vector<double> &in_threshold) const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file sync_model_cache.hpp
+ * @brief Binary cache (.ctspbin) of a built Model A
+ *
+ * Building sync_model_a_builder means parsing the instance, creating the
+ * operations, both partitions (every routing arc reads a distance) and the
+ * arc arrays. Runs on the same instance rebuild exactly the same model, so
+ * sync_model_cache saves the arrays the model is made of (operations,
+ * routing and synchronization arcs with their times) to a versioned binary
+ * file, keyed by a hash of the instance file contents. Loading maps the
+ * file and copies the arrays in bulk; names, maps and adjacency lists are
+ * derived from them in linear time.
+ *
+ * The checker LP (ctsp_primal_model) is not stored: it is a linear pass
+ * over the same arrays and each checker builds it for its own LP backend.
+ *
+ * File layout (native byte order, checked on load):
+ *
+ * | Field                              | Type                          |
+ * |------------------------------------|-------------------------------|
+ * | magic `CTSPBIN`                    | 8 bytes                       |
+ * | version, byte order mark           | 2 x uint32                    |
+ * | instance key                       | uint64                        |
+ * | problem type                       | int32                         |
+ * | vehicles, depots, customers        | 3 x uint64                    |
+ * | max distance, time window width    | 2 x double                    |
+ * | instance name                      | string (uint64 size + bytes)  |
+ * | operations                         | uint64 n, then per operation: |
+ * |                                    | name, resources, 2 x int32    |
+ * | routing arcs                       | uint64 n, n x 4 int32, n doubles |
+ * | synchronization arcs               | uint64 n, n x 4 int32, n doubles |
+ */
+
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_model_cache
+     * @brief Save / restore a sync_model_a_builder to / from a .ctspbin file
+     *
+     * ```cpp
+     * uint64_t key;
+     * sync_model_cache::instance_key("bayg29.contsp", 2, key);
+     *
+     * sync_model_cache cache("bayg29.ctspbin", key);
+     * unique_ptr<sync_model_a_builder> builder;
+     *
+     * if (!cache.load(builder))        // missing, stale or of another instance
+     * {
+     *     builder.reset(new CTSP::CTSP_model_a_builder(...));
+     *     cache.save(*builder);
+     * }
+     * ```
+     */
+    class sync_model_cache
+    {
+    protected:
+        string filename_;       ///< .ctspbin file
+        uint64_t instance_key_; ///< Key of the instance the model must belong to
+
+    public:
+        /**
+         * @brief Cache bound to a file and an instance
+         * @param filename .ctspbin file
+         * @param instance_key Instance key (instance_key())
+         */
+        sync_model_cache(const string &filename, const uint64_t instance_key);
+
+        virtual ~sync_model_cache(void);
+
+        /**
+         * @brief Write a built model
+         * @param builder Model to save
+         * @return false if the file cannot be written
+         * @note Written to a temporary file renamed over filename, so that
+         *       concurrent runs never read a partial cache
+         */
+        bool save(const sync_model_a_builder &builder) const;
+
+        /**
+         * @brief Restore the model of the file
+         * @param builder Output: restored model (unchanged on failure)
+         * @return false if the file is missing, malformed, of another
+         *         version or byte order, or of another instance
+         */
+        bool load(unique_ptr<sync_model_a_builder> &builder) const;
+
+        /**
+         * @brief Key of an instance: hash of the file contents and problem type
+         * @param instance_file Instance file (.contsp)
+         * @param problem_type 1=CTSP1, 2=CTSP2
+         * @param key Output: 64-bit FNV-1a hash
+         * @param variant Other model settings (arc_pruning::get_key()), 0: none
+         * @return false if the file cannot be read
+         */
+        static bool instance_key(const string &instance_file, const int problem_type, uint64_t &key, const uint64_t variant = 0);
+
+        inline const string &get_filename(void) const { return filename_; }
+        inline uint64_t get_instance_key(void) const { return instance_key_; }
+    };
+}
@@ -0,0 +1,120 @@
+/**
+ * @file sync_model_family.hpp
+ * @brief Model A shared by the variants of an instance
+ *
+ * Benchmark sets derive several instances from one geometry: the same
+ * distances, days, demands and maximum route duration, with another
+ * maximum allowable differential w. Everything sync_model_a_builder spends
+ * its build time on (routing partition, routing arcs and their times, pair
+ * map, adjacency lists, snapshot) depends on the former only: w is the
+ * time of the customer sync arcs and the second resource of the customer
+ * visits.
+ *
+ * sync_model_family keeps the first model built of each structure, keyed
+ * by a hash of everything but w. A later instance with the same key gets a
+ * variant (sync_model_a_builder variant constructor) that shares the
+ * routing arrays and the snapshot and rewrites the w entries, in time
+ * linear in the operations and sync arcs, instead of a full build.
+ *
+ * Only a uniform w (the same for every customer, as in CTSP instances) is
+ * shared; other instances are built as usual.
+ */
+
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+#include "distance_oracle.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_model_family
+     * @brief Thread-safe registry of built models by routing structure
+     *
+     * ```cpp
+     * sync_model_family family;
+     *
+     * for (const string &file : files)
+     * {
+     *     const uint64_t key{sync_model_family::structure_key(2, n_depots, n_customers, demands, max_distance, distances, triangle_inequality, pruning)};
+     *
+     *     if (!family.find(key, name, w, builder))   // first of its family
+     *     {
+     *         builder.reset(new CTSP::CTSP_model_a_builder(...));
+     *         family.add(key, *builder);
+     *     }
+     * }
+     * ```
+     */
+    class sync_model_family
+    {
+    protected:
+        mutable mutex mutex_;                                           ///< Guards models_ and the counters
+        map<uint64_t, shared_ptr<const sync_model_a_builder>> models_; ///< First model of each structure
+        size_t n_shared_;                                               ///< Models made as variants
+
+    public:
+        sync_model_family(void);
+        virtual ~sync_model_family(void);
+
+        /**
+         * @brief Key of the routing structure of an instance
+         * @param problem_type CTSP1 (1) or CTSP2 (2)
+         * @param n_depots Depots (days)
+         * @param n_customers Customers
+         * @param demands Demands (only whether each one is positive counts)
+         * @param max_distance Maximum route duration
+         * @param distances Distances (every entry is read: O(n²))
+         * @param triangle_inequality Whether they satisfy it (duration pruning)
+         * @param pruning Routing arcs left out of the model
+         * @return FNV-1a hash; w is left out
+         */
+        static uint64_t structure_key(int problem_type,
+                                      size_t n_depots,
+                                      size_t n_customers,
+                                      const vector<vector<int>> &demands,
+                                      double max_distance,
+                                      const GOMA::distance_oracle &distances,
+                                      bool triangle_inequality,
+                                      const arc_pruning &pruning);
+
+        /**
+         * @brief Variant of the model of a structure, if one was added
+         * @param key Structure key (structure_key())
+         * @param instance_name Problem identifier of the variant
+         * @param w Maximum allowable differential of each customer
+         * @param builder Output: the variant, untouched if none is made
+         * @param base_name Output: instance of the shared model
+         * @return false if no model has this key or w is not uniform
+         */
+        bool find(uint64_t key, const string &instance_name, const vector<double> &w,
+                  unique_ptr<sync_model_a_builder> &builder, string &base_name);
+
+        /**
+         * @brief Register a built model as the one of its structure
+         * @param key Structure key
+         * @param builder Built model
+         *
+         * A variant of builder is kept, sharing its routing arrays: the
+         * caller keeps ownership of builder. Ignored if the key is known.
+         */
+        void add(uint64_t key, const sync_model_a_builder &builder);
+
+        /**
+         * @brief Models made as variants so far
+         */
+        size_t get_n_shared(void) const;
+
+        /**
+         * @brief Structures registered
+         */
+        size_t size(void) const;
+    };
+}
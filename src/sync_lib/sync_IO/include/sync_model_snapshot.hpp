@@ -0,0 +1,97 @@
+/**
+ * @file sync_model_snapshot.hpp
+ * @brief Immutable routing structure of a Model A, shared by its checkers
+ *
+ * Every checker of a model used to copy the arcs, adjacency lists, travel
+ * times and operation arrays it reads out of sync_model_a_builder. With a
+ * pool of checkers (checker_pool, server sessions, components) those copies
+ * dominate the memory of a checker. A sync_model_snapshot holds them once;
+ * the builder hands out one reference-counted snapshot
+ * (sync_model_a_builder::get_snapshot) and each checker keeps a pointer to
+ * it plus its own mutable solver state only.
+ *
+ * The synchronization arc times are not part of the snapshot: they change
+ * with sync_model_a_builder::set_time_windows_max_size and are still read
+ * from the builder (update_sync_arc_times).
+ */
+
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_model_snapshot
+     * @brief Read-only copy of the routing structure of a sync_model_a_builder
+     *
+     * ```cpp
+     * shared_ptr<const sync_model_snapshot> model{builder.get_snapshot()};
+     *
+     * for (const int arc : model->get_routing_outbound_arcs()[i])
+     *     ... model->get_routing_arcs()[arc], model->get_routing_arc_times()[arc]
+     * ```
+     *
+     * Every member is const after construction, so any number of threads
+     * can read one snapshot.
+     */
+    class sync_model_snapshot
+    {
+    protected:
+        const size_t n_operations_; ///< Operations (graph vertices)
+        const size_t n_customers_;  ///< Customers
+        const size_t n_depots_;     ///< Depots
+        const double max_distance_; ///< Maximum route duration
+
+        const vector<triplet> routing_arcs_;             ///< Routing arcs (i, j)
+        const vector<double> routing_arc_times_;         ///< Travel time of each routing arc
+        const vector<vector<int>> routing_outbound_arcs_; ///< Outgoing routing arcs per operation
+        const vector<vector<int>> routing_inbound_arcs_;  ///< Incoming routing arcs per operation
+
+        const vector<triplet> sync_arcs_; ///< Synchronization arcs (i, j) (times stay in the builder)
+
+        const vector<int> operation_2_customer_; ///< Customer of each operation
+        const vector<int> operation_2_depot_;    ///< Depot of each operation
+        const vector<string> operation_names_;   ///< Operation names
+
+    public:
+        /**
+         * @brief Copy the routing structure of a built model
+         * @param builder Built model (not referenced afterwards)
+         */
+        explicit sync_model_snapshot(const sync_model_a_builder &builder);
+
+        virtual ~sync_model_snapshot(void);
+
+        sync_model_snapshot(const sync_model_snapshot &) = delete;
+        sync_model_snapshot &operator=(const sync_model_snapshot &) = delete;
+
+        inline size_t get_n_operations(void) const { return n_operations_; }
+        inline size_t get_n_customers(void) const { return n_customers_; }
+        inline size_t get_n_depots(void) const { return n_depots_; }
+        inline double get_max_distance(void) const { return max_distance_; }
+
+        inline size_t get_n_routing_arcs(void) const { return routing_arcs_.size(); }
+        inline const vector<triplet> &get_routing_arcs(void) const { return routing_arcs_; }
+        inline const vector<double> &get_routing_arc_times(void) const { return routing_arc_times_; }
+        inline const vector<vector<int>> &get_routing_outbound_arcs(void) const { return routing_outbound_arcs_; }
+        inline const vector<vector<int>> &get_routing_inbound_arcs(void) const { return routing_inbound_arcs_; }
+
+        inline size_t get_n_sync_arcs(void) const { return sync_arcs_.size(); }
+        inline const vector<triplet> &get_sync_arcs(void) const { return sync_arcs_; }
+
+        inline const vector<int> &get_operation_2_customer(void) const { return operation_2_customer_; }
+        inline const vector<int> &get_operation_2_depot(void) const { return operation_2_depot_; }
+        inline const vector<string> &get_operation_names(void) const { return operation_names_; }
+
+        /**
+         * @brief Heap bytes held by the copied arrays
+         */
+        size_t get_memory_bytes(void) const;
+    };
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <utility>
 
+#include "json_buffer.hpp"
+
 using namespace std;
 
 /**
@@ -59,6 +61,12 @@ namespace SYNC_LIB
              * @return Reference to output stream
              */
             ostream &write_json(ostream &os) const;
+
+            /**
+             * @brief Write scheduling into a buffer in JSON format
+             * @param buffer Output buffer (reused across schedules)
+             */
+            void write_json(json_buffer &buffer) const;
             
             /**
              * @brief Read scheduling from input stream in JSON format
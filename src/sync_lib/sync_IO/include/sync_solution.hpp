@@ -5,6 +5,8 @@
 #include <string>
 #include <utility>
 
+#include "json_buffer.hpp"
+
 using namespace std;
 
 /**
@@ -44,7 +46,8 @@ namespace SYNC_LIB
         
         /**
          * @brief Construct a solution by loading from file
-         * @param instance_name Path to solution file
+         * @param instance_name Path to solution file (.sol or JSON, read
+         *        with sync_solution_parser)
          */
         sync_solution(const string &instance_name);
         
@@ -131,11 +134,26 @@ namespace SYNC_LIB
             return instance_name_;
         }
 
+        /**
+         * @brief Get the instance name (mutable version)
+         * @return Reference to instance name string
+         */
+        inline string &get_instance_name(void)
+        {
+            return instance_name_;
+        }
+
         /**
          * @brief Write JSON header section
          * @param os Output stream
          */
         void write_header(ostream &os) const;
+
+        /**
+         * @brief Write JSON header section into a buffer
+         * @param buffer Output buffer
+         */
+        void write_header(json_buffer &buffer) const;
         
         /**
          * @brief Write routes section
@@ -149,5 +167,11 @@ namespace SYNC_LIB
          */
         void write_end(ostream &os) const;
 
+        /**
+         * @brief Write JSON closing section into a buffer
+         * @param buffer Output buffer
+         */
+        void write_end(json_buffer &buffer) const;
+
     };
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "sync_solution.hpp"
+
+using namespace std;
+
+/**
+ * @file sync_solution_parser.hpp
+ * @brief Single-pass parser of .sol and JSON solutions over a contiguous buffer
+ *
+ * sync_solution::read and json_format_io::read_sol extract the routes
+ * through istream, one token (or one character) at a time, and every
+ * sync_solution is built from scratch. When a heuristic streams thousands
+ * of solutions, that rivals the check itself.
+ *
+ * sync_solution_parser reads the whole file into a buffer it keeps, scans
+ * it once converting numbers with std::from_chars, and fills the routes of
+ * a caller-owned sync_solution in place (resize over the vectors already
+ * there). Parsing many solutions into the same sync_solution does not
+ * allocate once the largest one has been seen.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_solution_parser
+     * @brief Reusable .sol / JSON solution reader
+     *
+     * ```cpp
+     * sync_solution_parser parser;
+     * sync_solution sol;                       // reused for every file
+     *
+     * for (const string &sol_file : sol_files)
+     *     if (!parser.read(sol_file, sol))
+     *         cerr << parser.get_error() << endl;
+     * ```
+     *
+     * Formats (chosen by the first non-blank character):
+     * - `.sol`: instance name, number of routes, then for each route its
+     *   number of nodes and the nodes (1-based, stored 0-based as in
+     *   sync_solution::read). Whatever follows the last route is ignored.
+     * - JSON (`{`): object with "instance_name" (string) and "routes"
+     *   (array of integer arrays, stored as written, as in
+     *   json_format_io::read_sol). Other members are skipped.
+     * - JSON (`[`): a bare array of routes (json_format_io::write_sol),
+     *   instance name left empty.
+     */
+    class sync_solution_parser
+    {
+    private:
+        vector<char> buffer_; ///< File contents, kept between reads
+
+        const char *begin_; ///< First byte of the text being parsed
+        const char *pos_;   ///< Next byte to scan
+        const char *end_;   ///< One past the last byte
+
+        string error_; ///< Last error, empty if none
+
+    public:
+        sync_solution_parser(void);
+
+        virtual ~sync_solution_parser(void);
+
+        /**
+         * @brief Parse a solution file
+         * @param filename .sol or JSON solution file
+         * @param sol Output: solution (partially filled on error)
+         * @return false if the file cannot be read or is malformed (get_error)
+         */
+        bool read(const string &filename, sync_solution &sol);
+
+        /**
+         * @brief Parse a solution held in memory
+         * @param first First byte
+         * @param last One past the last byte
+         * @param sol Output: solution (partially filled on error)
+         * @return false if malformed (get_error)
+         */
+        bool parse(const char *first, const char *last, sync_solution &sol);
+
+        inline const string &get_error(void) const { return error_; }
+
+    private:
+        bool parse_sol_(sync_solution &sol);
+        bool parse_json_(sync_solution &sol);
+        bool parse_json_routes_(vector<vector<int>> &routes);
+        bool skip_json_value_(void);
+
+        void skip_blanks_(void);
+        bool next_int_(int &val);
+        bool next_size_(size_t &val);
+        bool expect_(const char c);
+        bool json_string_(const char *&first, const char *&last);
+
+        /**
+         * @brief Record an error with the line it was found at
+         * @return false
+         */
+        bool error_at_(const char *what);
+    };
+}
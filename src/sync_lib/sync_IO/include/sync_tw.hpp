@@ -5,6 +5,8 @@
 #include <string>
 #include <utility>
 
+#include "json_buffer.hpp"
+
 using namespace std;
 
 /**
@@ -103,4 +105,39 @@ namespace SYNC_LIB
             */
            istream &read_json(istream &is);
    };
+
+   /**
+    * @class sync_flexibility
+    * @brief Earliest and latest start time of every operation of a schedule
+    *
+    * Window i is [earliest, latest] start of operation i over all the
+    * schedules of a routing that fit in [0, horizon_]. The slack is how far
+    * the operation can move, but the windows are not independent: moving
+    * one operation may move others.
+    */
+   class sync_flexibility : public sync_time_windows
+   {
+       public:
+           double horizon_;                 ///< Every operation starts in [0, horizon_]
+           vector<string> operation_names_; ///< Name of each operation (one per window)
+
+       public:
+           sync_flexibility(void);
+           virtual ~sync_flexibility(void);
+
+           /**
+            * @brief How far operation i can move
+            * @param i Operation
+            * @return Latest minus earliest start time
+            */
+           inline double get_slack(const size_t i) const { return (*this)[i].upper_bound() - (*this)[i].lower_bound(); }
+
+           using sync_time_windows::write_json;
+
+           /**
+            * @brief Write the horizon and the windows, one per operation, in JSON
+            * @param buffer Output buffer (inside the object opened by the caller)
+            */
+           void write_json(json_buffer &buffer) const;
+   };
 }
\ No newline at end of file
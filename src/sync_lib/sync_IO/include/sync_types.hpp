@@ -3,6 +3,8 @@
 #include <vector>
 #include <utility>
 
+#include "ragged_array.hpp"
+
 using namespace std;
 
 /**
@@ -18,6 +20,13 @@ namespace SYNC_LIB
 {
     /// Successor list representation for routes (adjacency list format)
     typedef vector<vector<int>> succ_list;
+
+    /**
+     * Violated cycles, one list of arc indices each (routing arcs first,
+     * sync arcs offset by the number of routing arcs), stored flat so that
+     * a list reused across separation rounds stops allocating
+     */
+    typedef GOMA::ragged_array<int> cycle_list;
     
     /// Set of operation indices
     typedef vector<int> subset;
@@ -0,0 +1,124 @@
+#include "json_buffer.hpp"
+
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+
+namespace SYNC_LIB
+{
+    json_buffer::json_buffer(const size_t block_size) : buffer_(),
+                                                        used_(0),
+                                                        block_size_(block_size > 0 ? block_size : 1),
+                                                        os_(NULL),
+                                                        round_trip_(false)
+    {
+    }
+
+    json_buffer::~json_buffer(void)
+    {
+        close();
+    }
+
+    void json_buffer::open(ostream &os)
+    {
+        close();
+
+        os_ = &os;
+    }
+
+    void json_buffer::close(void)
+    {
+        flush();
+
+        os_ = NULL;
+    }
+
+    void json_buffer::flush(void)
+    {
+        // Unbound: the text stays pending until a stream is opened
+        if (os_ == NULL)
+            return;
+
+        if (used_ > 0)
+            os_->write(buffer_.data(), used_);
+
+        used_ = 0;
+    }
+
+    void json_buffer::grow_(const size_t n)
+    {
+        if (used_ >= block_size_ && os_ != NULL)
+            flush();
+
+        if (used_ + n > buffer_.size())
+            buffer_.resize(max({used_ + n, 2 * buffer_.size(), block_size_ + 64}));
+    }
+
+    void json_buffer::put(const char *s)
+    {
+        const size_t len{strlen(s)};
+
+        reserve_(len);
+        memcpy(buffer_.data() + used_, s, len);
+        used_ += len;
+    }
+
+    void json_buffer::put(const string &s)
+    {
+        reserve_(s.size());
+        memcpy(buffer_.data() + used_, s.data(), s.size());
+        used_ += s.size();
+    }
+
+    void json_buffer::put(const string &s, const int width)
+    {
+        put_padded_(s.data(), s.size(), width);
+    }
+
+    void json_buffer::put_padded_(const char *s, const size_t len, const int width)
+    {
+        const size_t pad{width > (int)len ? width - len : 0};
+
+        reserve_(pad + len);
+
+        memset(buffer_.data() + used_, ' ', pad);
+        memcpy(buffer_.data() + used_ + pad, s, len);
+        used_ += pad + len;
+    }
+
+    void json_buffer::put_int(const long long val, const int width)
+    {
+        char s[24];
+
+        const to_chars_result res{to_chars(s, s + sizeof(s), val)};
+
+        put_padded_(s, res.ptr - s, width);
+    }
+
+    void json_buffer::put_double(const double val, const int width)
+    {
+        char s[64];
+
+        // Fixed with one decimal overflows s for |val| >= 1e62: fall back to
+        // the shortest form (scientific for such values)
+        to_chars_result res{round_trip_ ? to_chars(s, s + sizeof(s), val)
+                                        : to_chars(s, s + sizeof(s), val, chars_format::fixed, 1)};
+
+        if (res.ec != errc())
+            res = to_chars(s, s + sizeof(s), val);
+
+        put_padded_(s, res.ptr - s, width);
+    }
+
+    void json_buffer::put_fixed(const double val, const int width, const int precision)
+    {
+        char s[128];
+
+        to_chars_result res{to_chars(s, s + sizeof(s), val, chars_format::fixed, precision)};
+
+        if (res.ec != errc())
+            res = to_chars(s, s + sizeof(s), val);
+
+        put_padded_(s, res.ptr - s, width);
+    }
+}
@@ -15,15 +15,18 @@ namespace SYNC_LIB
 
     void json_format_io::write(ostream &os, const string &instance_name, const sync_scheduling &schedules) const
     {
-        // os << "{" << endl;
-        // os << "  \"instance_name\": \"" << instance_name << "\"," << endl;
-        // os << "  \"obj_value\": " << obj_value << "," << endl;
-        os << "  \"schedule\": " << endl;
+        json_buffer buffer;
 
-        // write_vector_of_double_vectors(os, schedules);
-        write_vector_of_scheduling(os, schedules);
-        os << endl;
-        // os << "}" << endl;
+        buffer.open(os);
+        write(buffer, instance_name, schedules);
+    }
+
+    void json_format_io::write(json_buffer &buffer, const string &instance_name, const sync_scheduling &schedules) const
+    {
+        buffer.put("  \"schedule\": \n");
+
+        write_vector_of_scheduling(buffer, schedules);
+        buffer.put('\n');
     }
 
     void json_format_io::write_sol(ostream &os, const string &instance_name, const vector<vector<int>> &routes) const
@@ -218,35 +221,79 @@ namespace SYNC_LIB
 
     void json_format_io::write_vector_of_scheduling(ostream &os, const vector<vector<operation_info>> &vec) const
     {
-        os << "  [" << endl;
+        json_buffer buffer;
+
+        buffer.open(os);
+        write_vector_of_scheduling(buffer, vec);
+    }
+
+    void json_format_io::write_vector_of_scheduling(json_buffer &buffer, const vector<vector<operation_info>> &vec) const
+    {
+        buffer.put("  [\n");
         for (size_t i = 0; i < vec.size(); ++i)
         {
-            os << "  {" << endl;
-            os << "    \"route\": " << i + 1 << "," << endl;
-            os << "    \"tasks\": " << endl;
-            os << "    [" << endl;
+            buffer.put("  {\n");
+            buffer.put("    \"route\": ");
+            buffer.put_int(i + 1);
+            buffer.put(",\n");
+            buffer.put("    \"tasks\": \n");
+            buffer.put("    [\n");
             for (size_t j = 0; j < vec[i].size(); ++j)
             {
                 const operation_info &op_info = vec[i][j];
 
-                os << "      { \"customer\": " << setw(3) << op_info.first
-                   << ", \"arrival_starting\": [" << setw(6) << fixed << setprecision(1) << op_info.second.first << ", " << setw(6) << fixed << setprecision(1) << op_info.second.second << "] }";
+                buffer.put("      { \"customer\": ");
+                buffer.put_int(op_info.first, 3);
+                buffer.put(", \"arrival_starting\": [");
+                buffer.put_double(op_info.second.first, 6);
+                buffer.put(", ");
+                buffer.put_double(op_info.second.second, 6);
+                buffer.put("] }");
                 if (j < vec[i].size() - 1)
                 {
-                    os << ",";
+                    buffer.put(',');
                 }
-                os << endl;
+                buffer.put('\n');
             }
-            os << "    ]" << endl;
-            os << "  }";
+            buffer.put("    ]\n");
+            buffer.put("  }");
 
             if (i < vec.size() - 1)
             {
-                os << ",";
+                buffer.put(',');
             }
-            os << endl;
+            buffer.put('\n');
+        }
+        buffer.put("  ]\n");
+    }
+
+    void json_format_io::write_compact_scheduling(json_buffer &buffer, const vector<vector<operation_info>> &vec) const
+    {
+        buffer.put('[');
+        for (size_t i = 0; i < vec.size(); ++i)
+        {
+            if (i > 0)
+                buffer.put(", ");
+
+            buffer.put('[');
+            for (size_t j = 0; j < vec[i].size(); ++j)
+            {
+                const operation_info &op_info = vec[i][j];
+
+                if (j > 0)
+                    buffer.put(", ");
+
+                buffer.put("{\"customer\": ");
+                buffer.put_int(op_info.first);
+                buffer.put(", \"arrival_starting\": [");
+                buffer.put_double(op_info.second.first);
+                buffer.put(", ");
+                buffer.put_double(op_info.second.second);
+                buffer.put("]}");
+            }
+            buffer.put(']');
         }
-        os << "  ]" << endl;
+        buffer.put(']');
     }
 
     // void json_format_io::read_sch(istream &is, string &instance_name, vector<vector<double>> &schedules)
@@ -369,7 +416,19 @@ namespace SYNC_LIB
 
     void json_format_io::write_pair_(ostream &os, const pair<double, double> &p) const
     {
-        os << "\"tw\": [" << setw(6) << fixed << setprecision(1) << p.first << ", " << setw(6) << fixed << setprecision(1) << p.second << "]";
+        json_buffer buffer;
+
+        buffer.open(os);
+        write_pair_(buffer, p);
+    }
+
+    void json_format_io::write_pair_(json_buffer &buffer, const pair<double, double> &p) const
+    {
+        buffer.put("\"tw\": [");
+        buffer.put_double(p.first, 6);
+        buffer.put(", ");
+        buffer.put_double(p.second, 6);
+        buffer.put(']');
     }
 
     void json_format_io::read_pair_(istream &is, pair<double, double> &p) const
@@ -402,23 +461,32 @@ namespace SYNC_LIB
 
     void json_format_io::write_vector_of_pairs(ostream &os, const vector<pair<double, double>> &vec) const
     {
-        os << "  [";
-        os << endl;
+        json_buffer buffer;
+
+        buffer.open(os);
+        write_vector_of_pairs(buffer, vec);
+    }
+
+    void json_format_io::write_vector_of_pairs(json_buffer &buffer, const vector<pair<double, double>> &vec) const
+    {
+        buffer.put("  [\n");
         for (size_t i = 0; i < vec.size(); ++i)
         {
-            os << "      { ";
-            os << "\"customer\": " << setw(3) << i + 1 << ", ";
-            write_pair_(os, vec[i]);
-            os << " }";
+            buffer.put("      { ");
+            buffer.put("\"customer\": ");
+            buffer.put_int(i + 1, 3);
+            buffer.put(", ");
+            write_pair_(buffer, vec[i]);
+            buffer.put(" }");
 
             if (i < vec.size() - 1)
             {
-                os << ", ";
+                buffer.put(", ");
             }
 
-            os << endl;
+            buffer.put('\n');
         }
-        os << "  ]" << endl;
+        buffer.put("  ]\n");
     }
 
     void json_format_io::read_vector_of_pairs(istream &is, vector<pair<double, double>> &vec) const
@@ -1,5 +1,7 @@
 #include "model_a_solution_interface.hpp"
 
+#include <stdexcept>
+
 namespace SYNC_LIB
 {
     model_a_solution_interface::model_a_solution_interface(void) {}
@@ -15,18 +17,48 @@ namespace SYNC_LIB
         operations_ = model_builder.get_operations();
         operations_map_ = model_builder.get_operations_map();
         n_depots_ = model_builder.get_n_depots();
-        routing_arc_names_ = model_builder.get_routing_arc_names();
+        n_customers_ = model_builder.get_n_customers();
     }
 
-    void model_a_solution_interface::sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, vector<double> &x) const
+    void model_a_solution_interface::validate_routes(const vector<vector<int>> &routes) const
     {
-        if (sol.empty())
+        if (routes.size() != n_depots_)
+            throw std::invalid_argument(to_string(routes.size()) + " routes for " + to_string(n_depots_) + " depots");
+
+        for (size_t k{0}; k < n_depots_; k++)
         {
-            x.clear();
-            return;
+            const vector<int> &route{routes[k]};
+            const string route_name{"route " + to_string(k + 1)};
+
+            // Depot, at least one customer, depot
+            if (route.size() < 3)
+                throw std::invalid_argument(route_name + " has " + to_string(route.size()) + " nodes (3 at least)");
+
+            if (route.front() != 0 || route.back() != 0)
+                throw std::invalid_argument(route_name + " does not start and end at the depot");
+
+            for (size_t p{1}; p + 1 < route.size(); p++)
+            {
+                const int customer{route[p]};
+
+                if (customer < 1 || customer > (int)n_customers_)
+                    throw std::invalid_argument(route_name + " visits node " + to_string(customer) + " (customers 1 to " +
+                                                to_string(n_customers_) + ")");
+
+                if (operations_map_(customer + 1, k + 1) < 0)
+                    throw std::invalid_argument(route_name + " visits customer " + to_string(customer) +
+                                                ", not served by its depot");
+            }
         }
+    }
+
+    template <typename F>
+    bool model_a_solution_interface::route_arcs_(const SYNC_LIB::sync_solution &sol, route_times *times, const F &use) const
+    {
+        if (times != nullptr)
+            times->resize(n_depots_);
 
-        x.resize(routing_arcs_.size(), 0.0);
+        bool complete{true};
 
         const vector<vector<int>> &routes{sol.get_routes()};
 
@@ -38,6 +70,9 @@ namespace SYNC_LIB
 
             const size_t route_sz{route.size()};
 
+            if (times != nullptr)
+                times->start_route(k, (int)k);
+
             {
                 const int customer_t{route[1] + 1};
 
@@ -46,10 +81,16 @@ namespace SYNC_LIB
 
                 const int inx{routing_arcs_pair_map_.at(operation_s, operation_t)};
 
-                assert(inx >= 0);
-                assert(inx < (int)x.size());
+                assert(inx < (int)routing_arcs_.size());
+
+                // Arc pruned from the model
+                if (inx == EMPTY_VAR)
+                    complete = false;
+                else
+                    use(inx);
 
-                x[inx] = 1.0;
+                if (times != nullptr)
+                    times->push_stop(k, operation_t, arc_time_(inx));
             }
 
             for (size_t j{1}; j < route_sz - 2; ++j)
@@ -62,10 +103,16 @@ namespace SYNC_LIB
 
                 const int inx{routing_arcs_pair_map_.at(operation_s, operation_t)};
 
-                assert(inx >= 0);
-                assert(inx < (int)x.size());
+                assert(inx < (int)routing_arcs_.size());
 
-                x[inx] = 1.0;
+                // Arc pruned from the model
+                if (inx == EMPTY_VAR)
+                    complete = false;
+                else
+                    use(inx);
+
+                if (times != nullptr)
+                    times->push_stop(k, operation_t, arc_time_(inx));
             }
 
             {
@@ -76,14 +123,63 @@ namespace SYNC_LIB
 
                 const int inx{routing_arcs_pair_map_.at(operation_s, operation_t)};
 
-                assert(inx >= 0);
-                assert(inx < (int)x.size());
+                assert(inx < (int)routing_arcs_.size());
+
+                // Arc pruned from the model
+                if (inx == EMPTY_VAR)
+                    complete = false;
+                else
+                    use(inx);
 
-                x[inx] = 1.0;
+                if (times != nullptr)
+                    times->push_stop(k, operation_t, arc_time_(inx));
             }
 
             //cout << endl;
         }
+
+        return complete;
+    }
+
+    bool model_a_solution_interface::sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, vector<double> &x, route_times *times) const
+    {
+        if (sol.empty())
+        {
+            x.clear();
+
+            if (times != nullptr)
+                times->resize(0);
+
+            return true;
+        }
+
+        x.assign(routing_arcs_.size(), 0.0);
+
+        return route_arcs_(sol, times, [&x](const int inx)
+                           { x[inx] = 1.0; });
+    }
+
+    bool model_a_solution_interface::sync_solution_2_model_a(const SYNC_LIB::sync_solution &sol, sparse_x &x, route_times *times) const
+    {
+        if (sol.empty())
+        {
+            x.clear(0);
+
+            if (times != nullptr)
+                times->resize(0);
+
+            return true;
+        }
+
+        x.clear(routing_arcs_.size());
+
+        const bool complete{route_arcs_(sol, times, [&x](const int inx)
+                                        { x.push_back(inx, 1.0); })};
+
+        // Routes are walked by depot, not by arc index
+        x.sort();
+
+        return complete;
     }
 
     void model_a_solution_interface::model_a_2_sync_solution(const vector<double> &x, SYNC_LIB::sync_solution &sol) const
@@ -0,0 +1,49 @@
+/**
+ * @file route_times.cpp
+ * @brief Implementation of the cumulative route times
+ */
+
+#include "route_times.hpp"
+
+#include <algorithm>
+
+namespace SYNC_LIB
+{
+    route_times::route_times(void) : operations_(),
+                                     elapsed_()
+    {
+    }
+
+    route_times::~route_times(void)
+    {
+    }
+
+    void route_times::resize(const size_t n_routes)
+    {
+        operations_.resize(n_routes);
+        elapsed_.resize(n_routes);
+
+        for (size_t k{0}; k < n_routes; k++)
+        {
+            operations_[k].clear();
+            elapsed_[k].clear();
+        }
+    }
+
+    void route_times::start_route(const size_t k, const int operation)
+    {
+        operations_[k].assign(1, operation);
+        elapsed_[k].assign(1, 0.0);
+    }
+
+    double route_times::get_max_duration(void) const
+    {
+        double max_duration{0.0};
+
+        for (const vector<double> &elapsed : elapsed_)
+            if (!elapsed.empty())
+                max_duration = max(max_duration, elapsed.back());
+
+        return max_duration;
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file sparse_x.cpp
+ * @brief Implementation of the sparse routing solution
+ */
+
+#include "sparse_x.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SYNC_LIB
+{
+    sparse_x::sparse_x(void) : n_(0),
+                               index_(),
+                               value_()
+    {
+    }
+
+    sparse_x::sparse_x(const size_t n) : n_(n),
+                                         index_(),
+                                         value_()
+    {
+    }
+
+    sparse_x::sparse_x(const vector<double> &x, const double tol) : n_(x.size()),
+                                                                    index_(),
+                                                                    value_()
+    {
+        for (size_t a{0}; a < n_; a++)
+        {
+            if (fabs(x[a]) > tol)
+            {
+                index_.push_back((int)a);
+                value_.push_back(x[a]);
+            }
+        }
+    }
+
+    sparse_x::~sparse_x(void)
+    {
+    }
+
+    void sparse_x::clear(const size_t n)
+    {
+        n_ = n;
+
+        index_.clear();
+        value_.clear();
+    }
+
+    void sparse_x::sort(void)
+    {
+        const size_t n_entries{index_.size()};
+
+        bool sorted{true};
+
+        for (size_t p{1}; p < n_entries && sorted; p++)
+            sorted = index_[p - 1] < index_[p];
+
+        if (sorted)
+            return;
+
+        // Stable: the last of equal arcs is the last pushed
+        vector<size_t> order(n_entries);
+
+        for (size_t p{0}; p < n_entries; p++)
+            order[p] = p;
+
+        stable_sort(order.begin(), order.end(), [this](const size_t a, const size_t b)
+                    { return index_[a] < index_[b]; });
+
+        vector<int> index;
+        vector<double> value;
+
+        index.reserve(n_entries);
+        value.reserve(n_entries);
+
+        for (const size_t p : order)
+        {
+            if (!index.empty() && index.back() == index_[p])
+            {
+                value.back() = value_[p];
+                continue;
+            }
+
+            index.push_back(index_[p]);
+            value.push_back(value_[p]);
+        }
+
+        index_.swap(index);
+        value_.swap(value);
+    }
+
+    void sparse_x::scatter(vector<double> &x) const
+    {
+        assert(x.size() == n_);
+
+        for (size_t p{0}; p < index_.size(); p++)
+            x[index_[p]] = value_[p];
+    }
+
+    void sparse_x::unscatter(vector<double> &x) const
+    {
+        assert(x.size() == n_);
+
+        for (const int a : index_)
+            x[a] = 0.0;
+    }
+
+    void sparse_x::to_dense(vector<double> &x) const
+    {
+        x.assign(n_, 0.0);
+
+        scatter(x);
+    }
+
+    double sparse_x::at(const int arc) const
+    {
+        const auto it{lower_bound(index_.begin(), index_.end(), arc)};
+
+        return (it != index_.end() && *it == arc) ? value_[it - index_.begin()] : 0.0;
+    }
+}
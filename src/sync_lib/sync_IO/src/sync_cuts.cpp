@@ -0,0 +1,68 @@
+#include "sync_cuts.hpp"
+
+#include <cassert>
+
+namespace SYNC_LIB
+{
+    sync_cuts::sync_cuts(void) : rhs_(), sense_(), rmatbeg_(1, 0), rmatind_(), rmatval_()
+    {
+    }
+
+    sync_cuts::~sync_cuts(void)
+    {
+    }
+
+    void sync_cuts::clear(void)
+    {
+        rhs_.clear();
+        sense_.clear();
+        rmatbeg_.assign(1, 0);
+        rmatind_.clear();
+        rmatval_.clear();
+    }
+
+    void sync_cuts::add(const vector<int> &ind, const vector<double> &val, const double rhs, const char sense)
+    {
+        assert(ind.size() == val.size());
+
+        rhs_.push_back(rhs);
+        sense_.push_back(sense);
+
+        rmatind_.insert(rmatind_.end(), ind.begin(), ind.end());
+        rmatval_.insert(rmatval_.end(), val.begin(), val.end());
+
+        rmatbeg_.push_back((int)rmatind_.size());
+    }
+
+    void sync_cuts::add_to(GOMA::LP_solver &solver) const
+    {
+        const int n_cuts{get_n_cuts()};
+        const int rmatbeg[]{0};
+
+        for (int k{0}; k < n_cuts; k++)
+        {
+            const int beg{rmatbeg_[k]};
+
+            solver.add_cut(get_nz(k), &rhs_[k], &sense_[k], rmatbeg, rmatind_.data() + beg, rmatval_.data() + beg, NULL);
+        }
+    }
+
+    ostream &sync_cuts::write(ostream &os) const
+    {
+        const int n_cuts{get_n_cuts()};
+
+        for (int k{0}; k < n_cuts; k++)
+        {
+            for (int i{rmatbeg_[k]}; i < rmatbeg_[k + 1]; i++)
+            {
+                os << (i > rmatbeg_[k] ? " + " : "") << rmatval_[i] << " x_" << rmatind_[i];
+            }
+
+            const char sense{sense_[k]};
+
+            os << (sense == 'L' ? " <= " : (sense == 'G' ? " >= " : " = ")) << rhs_[k] << endl;
+        }
+
+        return os;
+    }
+}
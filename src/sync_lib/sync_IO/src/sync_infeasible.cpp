@@ -2,20 +2,24 @@
 
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
 
 namespace SYNC_LIB
 {
+    static const char edge_list_magic[8]{'C', 'T', 'S', 'P', 'E', 'D', 'G', '\0'};
+
     /**
      * Default constructor
      */
     sync_infeasible::sync_infeasible(const vector<double> &x,const sync_model_a_builder &builder)
         : operation_names_(builder.get_operation_names()),
-          routing_arc_names_(builder.get_routing_arc_names()),
-          sync_arc_names_(builder.get_sync_arc_names()),
+          builder_(builder),
           routing_arcs_(builder.get_routing_arcs()),
           sync_arcs_(builder.get_sync_arcs()),
           routing_arc_times_(builder.get_routing_arc_times()),
-          x_(x)
+          x_(x),
+          truncated_(false)
     {
     }
 
@@ -26,19 +30,21 @@ namespace SYNC_LIB
     {
     }
 
-    ostream &sync_infeasible::write_path_(ostream &os, const vector<int> &cycle) const
+    ostream &sync_infeasible::write_path_(ostream &os, const GOMA::array_view<int> &cycle) const
     {
         const size_t n_routing_arcs{routing_arcs_.size()};
+        const vector<string> &routing_arc_names{builder_.get_routing_arc_names()};
+        const vector<string> &sync_arc_names{builder_.get_sync_arc_names()};
 
         for (int inx : cycle)
         {
             if (inx < (int)n_routing_arcs)
             {
-                os << routing_arc_names_[inx] << " ";
+                os << routing_arc_names[inx] << " ";
             }
             else
             {
-                os << sync_arc_names_[inx - (int)n_routing_arcs] << " ";
+                os << sync_arc_names[inx - (int)n_routing_arcs] << " ";
             }
         }
 
@@ -49,9 +55,14 @@ namespace SYNC_LIB
 
     ostream &sync_infeasible::write_infeasible_paths(ostream &os) const
     {
-        os << "Infeasible paths detected in the solution:" << endl;
-
-        for (const auto &cycle : violated_cycles_)
+        if (truncated_ && violated_cycles_.empty())
+            os << "Synchronization check stopped by the deadline: feasibility unknown" << endl;
+        else if (truncated_)
+            os << "Infeasible paths detected in the solution (search stopped by the deadline):" << endl;
+        else
+            os << "Infeasible paths detected in the solution:" << endl;
+
+        for (const GOMA::array_view<int> cycle : violated_cycles_)
         {
             write_path_(os, cycle);
             os << endl;
@@ -60,165 +71,244 @@ namespace SYNC_LIB
         return os;
     }
 
-    ostream &sync_infeasible::write_primal_dual_graph(ostream &os) const
+    void sync_infeasible::write_json_cycles(json_buffer &buffer) const
+    {
+        const int n_routing_arcs{(int)routing_arcs_.size()};
+        const vector<string> &routing_arc_names{builder_.get_routing_arc_names()};
+        const vector<string> &sync_arc_names{builder_.get_sync_arc_names()};
+
+        buffer.put('[');
+
+        for (size_t k{0}; k < violated_cycles_.size(); k++)
+        {
+            if (k > 0)
+                buffer.put(", ");
+
+            buffer.put('[');
+
+            const GOMA::array_view<int> cycle{violated_cycles_[k]};
+
+            for (size_t l{0}; l < cycle.size(); l++)
+            {
+                const int inx{cycle[l]};
+
+                if (l > 0)
+                    buffer.put(", ");
+
+                buffer.put('"');
+                buffer.put(inx < n_routing_arcs ? routing_arc_names[inx] : sync_arc_names[inx - n_routing_arcs]);
+                buffer.put('"');
+            }
+
+            buffer.put(']');
+        }
+
+        buffer.put(']');
+    }
+
+    int sync_infeasible::get_cuts(sync_cuts &cuts, const int col_offset) const
+    {
+        const int n_routing_arcs{(int)routing_arcs_.size()};
+
+        vector<int> ind;
+        vector<double> val;
+
+        int n_cuts{0};
+
+        for (const GOMA::array_view<int> cycle : violated_cycles_)
+        {
+            ind.clear();
+
+            // Sync arcs are shifted by n_routing_arcs and do not appear in the cut
+            for (const int inx : cycle)
+            {
+                if (inx < n_routing_arcs)
+                    ind.push_back(inx);
+            }
+
+            sort(ind.begin(), ind.end());
+            ind.erase(unique(ind.begin(), ind.end()), ind.end());
+
+            if (ind.empty())
+                continue;
+
+            for (int &col : ind)
+                col += col_offset;
+
+            val.assign(ind.size(), 1.0);
+
+            cuts.add(ind, val, (double)ind.size() - 1.0, 'L');
+            n_cuts++;
+        }
+
+        return n_cuts;
+    }
+
+    ostream &sync_infeasible::write_primal_dual_graph(ostream &os, const graph_filter filter) const
     {
-        write_(os, x_, alpha_, gamma_);
+        json_buffer buffer;
+
+        buffer.open(os);
+        write_primal_dual_graph(buffer, filter);
+        buffer.close();
 
         return os;
     }
 
-    ostream &sync_infeasible::write_(ostream &os, const vector<double> &x, const vector<double> &alpha_v, const vector<double> &beta_v) const
+    void sync_infeasible::select_arcs_(const graph_filter filter, vector<int> &arcs) const
     {
-        os << endl;
-        os << "digraph G { \n\nrankdir=LR; \noverlap=false \n " << endl;
+        const size_t n_routing_arcs{routing_arcs_.size()};
+        const size_t n_sync_arcs{sync_arcs_.size()};
 
-        // const vector<double> &routing_arc_costs{input_.get_routing_arc_costs()};
-        // const vector<double> &sync_arc_costs{input_.get_sync_arc_costs()};
-        // const pair_map &sync_arc_map{input_.get_sync_arcs_pair_map()};
+        arcs.clear();
 
-        /////////////////////////
+        if (filter == graph_filter::CYCLES)
         {
-            const size_t n_routing_arcs{routing_arc_times_.size()};
+            vector<bool> in_cycle(n_routing_arcs + n_sync_arcs, false);
 
-            for (size_t i{0}; i < n_routing_arcs; i++)
+            for (const GOMA::array_view<int> cycle : violated_cycles_)
             {
-                const double alpha_val{alpha_v[i]};
-                const double x_val{x[i]};
+                for (const int inx : cycle)
+                    in_cycle[inx] = true;
+            }
 
-                if ((fabs(alpha_val) > tol_) && (fabs(x_val - alpha_val) < tol_))
-                {
-                    const triplet &arc = routing_arcs_[i];
-
-                    const int s{arc.i_};
-                    const int t{arc.j_};
-
-                    os << setw(5) << operation_names_[s] << " -> " << setw(5) << operation_names_[t];
-                    os << " [ fontsize=\"10pt\" ";
-                    os << ", label = \" ";
-                    os << setw(4) << fixed << setprecision(2) << alpha_val;
-                    // os << "<" << fixed << setprecision(2) << x_val << ">";
-                    os << "\"";
-                    os << ", color =\"blue\" ";
-
-                    if (alpha_val > 0.9)
-                    {
-                        os << ", style =\"solid\" ";
-                    }
-                    else if (alpha_val > 0.4)
-                    {
-                        os << ", style =\"dashed\" ";
-                    }
-                    else
-                    {
-                        os << ", style =\"dotted\" ";
-                    }
-
-                    os << " ] ";
-                    os << endl;
-                }
-                else
-                {
-                    if (x_val > tol_)
-                    {
-                        const triplet &arc = routing_arcs_[i];
-
-                        const int s{arc.i_};
-                        const int t{arc.j_};
-
-                        os << setw(5) << operation_names_[s] << " -> " << setw(5) << operation_names_[t];
-                        os << " [ fontsize=\"10pt\", label = \" ";
-                        os << setw(4) << fixed << setprecision(2) << x_val;
-                        if (alpha_val > tol_)
-                        {
-                            os << " / " << setw(4) << fixed << setprecision(2) << alpha_val;
-                            os << "\", color =\"green\"";
-                        }
-                        else
-                            os << "\", color =\"gray\"";
-
-                        if (x_val > 0.9)
-                        {
-                            os << ", style =\"solid\" ";
-                        }
-                        else if (x_val > 0.4)
-                        {
-                            os << ", style =\"dashed\" ";
-                        }
-                        else
-                        {
-                            os << ", style =\"dotted\" ";
-                        }
-
-                        os << " ] ";
-                        os << endl;
-                    }
-                    else
-                    {
-                        if (fabs(alpha_val) > tol_)
-                        {
-                            const triplet &arc = routing_arcs_[i];
-
-                            const int s{arc.i_};
-                            const int t{arc.j_};
-
-                            os << setw(5) << operation_names_[s] << " -> " << setw(5) << operation_names_[t];
-                            os << " [ fontsize=\"10pt\", label = \" ";
-
-                            os << setw(4) << fixed << setprecision(2) << alpha_val;
-                            // os << "<" << fixed << setprecision(0) << routing_arc_costs[i] << ">";
-                            os << "\", color =\"blue\" ]";
-                            os << endl;
-                        }
-                    }
-                }
+            for (size_t i{0}; i < in_cycle.size(); i++)
+            {
+                if (in_cycle[i])
+                    arcs.push_back((int)i);
             }
+
+            return;
         }
 
-        /////////////////////////
+        for (size_t i{0}; i < n_routing_arcs; i++)
+        {
+            const bool in_certificate{fabs(alpha_at_(i)) > tol_};
 
-        const size_t n_sync_arcs{sync_arc_names_.size()};
+            if (in_certificate || ((filter == graph_filter::FULL) && (x_[i] > tol_)))
+                arcs.push_back((int)i);
+        }
 
         for (size_t i{0}; i < n_sync_arcs; i++)
         {
-            const double val{beta_v[i]};
+            if (gamma_at_(i) > tol_)
+                arcs.push_back((int)(n_routing_arcs + i));
+        }
+    }
 
-            if (val > tol_)
-            {
-                const triplet &arc = sync_arcs_[i];
+    void sync_infeasible::write_style_(json_buffer &buffer, const double val) const
+    {
+        if (val > 0.9)
+            buffer.put(", style =\"solid\" ");
+        else if (val > 0.4)
+            buffer.put(", style =\"dashed\" ");
+        else
+            buffer.put(", style =\"dotted\" ");
+    }
 
-                const int s{arc.i_};
-                const int t{arc.j_};
+    void sync_infeasible::write_primal_dual_graph(json_buffer &buffer, const graph_filter filter) const
+    {
+        const int n_routing_arcs{(int)routing_arcs_.size()};
 
-                const pair<int, int> reverse_arc{pair<int, int>(t, s)};
-                // const int reverse_arc_inx{sync_arc_map.at(reverse_arc)};
+        vector<int> arcs;
+        select_arcs_(filter, arcs);
 
-                os << setw(5) << operation_names_[s] << " -> " << setw(5) << operation_names_[t];
-                os << " [ fontsize=\"10pt\" ";
-                // os << ", label = \" ";
-                // os << setw(4) << fixed << setprecision(2) << val;
-                // os << " <" << fixed << setprecision(0) << sync_arc_costs[i] << ">";
-                // os << "<" << fixed << setprecision(0) << sync_arc_costs[reverse_arc_inx] << "> \"";
+        buffer.put("\ndigraph G { \n\nrankdir=LR; \noverlap=false \n \n");
 
-                if (val > 0.9)
-                {
-                    os << ", style =\"solid\" ";
-                }
-                else if (val > 0.4)
+        for (const int inx : arcs)
+        {
+            const bool routing{inx < n_routing_arcs};
+            const triplet &arc{routing ? routing_arcs_[inx] : sync_arcs_[inx - n_routing_arcs]};
+
+            buffer.put(operation_names_[arc.i_], 5);
+            buffer.put(" -> ");
+            buffer.put(operation_names_[arc.j_], 5);
+
+            if (!routing)
+            {
+                // Synchronization arc: γ
+                buffer.put(" [ fontsize=\"10pt\" ");
+                write_style_(buffer, gamma_at_(inx - n_routing_arcs));
+                buffer.put(", color =\"red\" ]\n");
+                continue;
+            }
+
+            const double alpha_val{alpha_at_(inx)};
+            const double x_val{x_[inx]};
+
+            if ((fabs(alpha_val) > tol_) && (fabs(x_val - alpha_val) < tol_))
+            {
+                // Certificate arc used as much as x
+                buffer.put(" [ fontsize=\"10pt\" , label = \" ");
+                buffer.put_fixed(alpha_val, 4, 2);
+                buffer.put("\", color =\"blue\" ");
+                write_style_(buffer, alpha_val);
+                buffer.put(" ] \n");
+            }
+            else if (x_val > tol_)
+            {
+                // Arc of x, with its α if any
+                buffer.put(" [ fontsize=\"10pt\", label = \" ");
+                buffer.put_fixed(x_val, 4, 2);
+
+                if (alpha_val > tol_)
                 {
-                    os << ", style =\"dashed\" ";
+                    buffer.put(" / ");
+                    buffer.put_fixed(alpha_val, 4, 2);
+                    buffer.put("\", color =\"green\"");
                 }
                 else
-                {
-                    os << ", style =\"dotted\" ";
-                }
+                    buffer.put("\", color =\"gray\"");
 
-                os << ", color =\"red\" ]";
-                os << endl;
+                write_style_(buffer, x_val);
+                buffer.put(" ] \n");
+            }
+            else
+            {
+                // Certificate arc not used by x
+                buffer.put(" [ fontsize=\"10pt\", label = \" ");
+                buffer.put_fixed(alpha_val, 4, 2);
+                buffer.put("\", color =\"blue\" ]\n");
             }
         }
 
-        os << "}" << endl;
+        buffer.put("}\n");
+    }
 
-        return os;
+    bool sync_infeasible::write_primal_dual_edges(ostream &os, const graph_filter filter) const
+    {
+        const int n_routing_arcs{(int)routing_arcs_.size()};
+
+        vector<int> arcs;
+        select_arcs_(filter, arcs);
+
+        const uint32_t header[4]{1, 0x01020304, (uint32_t)operation_names_.size(), (uint32_t)arcs.size()};
+
+        os.write(edge_list_magic, sizeof(edge_list_magic));
+        os.write((const char *)header, sizeof(header));
+
+        // One record per edge: 3 int32 and 2 float, packed into one block
+        const size_t record_size{3 * sizeof(int32_t) + 2 * sizeof(float)};
+
+        vector<char> records(arcs.size() * record_size);
+        char *pos{records.data()};
+
+        for (const int inx : arcs)
+        {
+            const bool routing{inx < n_routing_arcs};
+            const triplet &arc{routing ? routing_arcs_[inx] : sync_arcs_[inx - n_routing_arcs]};
+
+            const int32_t ids[3]{arc.i_, arc.j_, inx};
+            const float vals[2]{routing ? (float)x_[inx] : 0.0f,
+                                routing ? (float)alpha_at_(inx) : (float)gamma_at_(inx - n_routing_arcs)};
+
+            memcpy(pos, ids, sizeof(ids));
+            memcpy(pos + sizeof(ids), vals, sizeof(vals));
+            pos += record_size;
+        }
+
+        os.write(records.data(), records.size());
+
+        return (bool)os;
     }
-}
\ No newline at end of file
+}
@@ -1,31 +1,90 @@
 #include "sync_mapping.hpp"
+#include "memory_usage.hpp"
+
+#include <algorithm>
+#include <tuple>
 
 namespace SYNC_LIB
 {
-    pair_map::pair_map(const size_t n_items) : map_(n_items, n_items)
+    pair_map::pair_map(const size_t n_items) : n_items_(n_items),
+                                               row_begin_(n_items + 1, 0),
+                                               successors_(),
+                                               indices_()
     {
-        map_.init(EMPTY_VAR);
     }    
 
-    pair_map::pair_map(void) {}
+    pair_map::pair_map(void) : n_items_(0),
+                               row_begin_(1, 0),
+                               successors_(),
+                               indices_()
+    {
+    }
 
     pair_map::~pair_map(void) {}
 
+    size_t pair_map::get_memory_bytes(void) const
+    {
+        return GOMA::vector_bytes(row_begin_) + GOMA::vector_bytes(successors_) + GOMA::vector_bytes(indices_);
+    }
+
     void pair_map::set(const vector<triplet> &arcs)
     {
+        // (i, j, index), sorted by pair and, within a pair, by index
+        vector<tuple<int, int, int>> entries;
+        entries.reserve(arcs.size());
+
         int index{0};
 
         for(const triplet &t : arcs)
         {
-            const int i = t.i_;
-            const int j = t.j_;
+            entries.push_back(make_tuple(t.i_, t.j_, index));
 
-            map_(i + 1, j + 1) = index;
+            n_items_ = max(n_items_, (size_t)max(t.i_, t.j_) + 1);
 
             index++;
         }
 
-        //map_.write_raw(cout);
-        //cout << endl;
+        sort(entries.begin(), entries.end());
+
+        row_begin_.assign(n_items_ + 1, 0);
+        successors_.clear();
+        indices_.clear();
+
+        successors_.reserve(entries.size());
+        indices_.reserve(entries.size());
+
+        for (size_t k{0}; k < entries.size(); k++)
+        {
+            const int i{get<0>(entries[k])};
+            const int j{get<1>(entries[k])};
+
+            // A repeated pair keeps its last index
+            if ((k + 1 < entries.size()) && (get<0>(entries[k + 1]) == i) && (get<1>(entries[k + 1]) == j))
+                continue;
+
+            successors_.push_back(j);
+            indices_.push_back(get<2>(entries[k]));
+
+            row_begin_[i + 1]++;
+        }
+
+        for (size_t i{0}; i < n_items_; i++)
+            row_begin_[i + 1] += row_begin_[i];
+    }
+
+    int pair_map::at(const int i, const int j) const
+    {
+        if ((i < 0) || ((size_t)i >= n_items_))
+            return EMPTY_VAR;
+
+        const vector<int>::const_iterator first{successors_.begin() + row_begin_[i]};
+        const vector<int>::const_iterator last{successors_.begin() + row_begin_[i + 1]};
+
+        const vector<int>::const_iterator it{lower_bound(first, last, j)};
+
+        if ((it == last) || (*it != j))
+            return EMPTY_VAR;
+
+        return indices_[it - successors_.begin()];
     }
 }
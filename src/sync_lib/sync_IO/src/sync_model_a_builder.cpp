@@ -1,4 +1,6 @@
 #include "sync_model_a_builder.hpp"
+#include "sync_model_snapshot.hpp"
+#include "memory_usage.hpp"
 
 #include <set>
 #include <cmath>
@@ -7,6 +9,65 @@
 
 namespace SYNC_LIB
 {
+    /**
+     * @brief Pruning the model can apply: d(depot, i) + t_ij + d(j, depot)
+     *        is a lower bound of a route through (i, j) only under the
+     *        triangle inequality
+     */
+    static arc_pruning sound_pruning(const arc_pruning &pruning, const bool triangle_inequality)
+    {
+        return arc_pruning(pruning.duration && triangle_inequality, pruning.k_nearest);
+    }
+
+    /**
+     * @brief Operations of a variant: customer visits take the new maximum
+     *        time window width as their second resource
+     */
+    static vector<sync_operation> variant_operations(const vector<sync_operation> &operations, const size_t n_customers, const double time_windows_max_size)
+    {
+        vector<sync_operation> variant(operations);
+
+        for (sync_operation &operation : variant)
+        {
+            const int c{operation.get_customer()};
+
+            if (c >= 1 && (size_t)c <= n_customers)
+                operation.set_r({operation.get_resources()[0], time_windows_max_size});
+        }
+
+        return variant;
+    }
+
+    sync_routing_arrays::sync_routing_arrays(const size_t n_operations) : pair_map_(n_operations),
+                                                                          arcs_(),
+                                                                          times_(),
+                                                                          outbound_arcs_(),
+                                                                          inbound_arcs_()
+    {
+    }
+
+    void sync_routing_arrays::index(const size_t n_operations)
+    {
+        pair_map_.set(arcs_);
+
+        outbound_arcs_.assign(n_operations, vector<int>());
+        inbound_arcs_.assign(n_operations, vector<int>());
+
+        const size_t n_arcs{arcs_.size()};
+
+        for (size_t a{0}; a < n_arcs; a++)
+        {
+            outbound_arcs_[arcs_[a].i_].push_back(a);
+            inbound_arcs_[arcs_[a].j_].push_back(a);
+        }
+    }
+
+    size_t sync_routing_arrays::get_memory_bytes(void) const
+    {
+        return pair_map_.get_memory_bytes() + GOMA::vector_bytes(arcs_) + GOMA::vector_bytes(times_) +
+               GOMA::vector_bytes(outbound_arcs_) + GOMA::vector_bytes(inbound_arcs_);
+    }
+
     sync_model_a_builder::sync_model_a_builder(const int problem_type,
                                                const string &instance_name,
                                                const size_t n_vehicles,
@@ -15,101 +76,232 @@ namespace SYNC_LIB
                                                const vector<vector<int>> &demands,
                                                const double max_distance,
                                                const vector<double> &w,
-                                               const GOMA::matrix<double> &distances,
-                                               const bool triangle_inequality) : sync_model_builder(problem_type, instance_name, n_vehicles, n_depots, n_customers, demands, max_distance, w, distances), n_operations_(get_n_operations()),
+                                               const GOMA::distance_oracle &distances,
+                                               const bool triangle_inequality,
+                                               const arc_pruning &pruning,
+                                               const size_t n_threads) : sync_model_builder(problem_type, instance_name, n_vehicles, n_depots, n_customers, demands, max_distance, w, distances, sound_pruning(pruning, triangle_inequality), n_threads), n_operations_(get_n_operations()),
                                                                                  problem_type_(problem_type),
                                                                                  n_customers_(n_customers),
                                                                                  n_vehicles_(n_vehicles),
                                                                                  n_depots_(n_depots),
                                                                                  max_distance_(max_distance),
                                                                                  time_windows_max_size_(w[1]),
-                                                                                 routing_arcs_pair_map_(n_operations_),
-                                                                                 routing_arcs_(),
+                                                                                 routing_arrays_(),
                                                                                  routing_arc_names_(),
-                                                                                 routing_arc_times_(),
                                                                                  sync_arcs_pair_map_(n_operations_),
                                                                                  sync_arcs_(),
                                                                                  sync_arc_names_(),
                                                                                  sync_arc_times_(),
                                                                                  operation_names_(),
                                                                                  operation_resources_(),
-                                                                                 operations_map_(n_customers_ + 1, n_depots_)
+                                                                                 operations_map_(n_customers_ + 1, n_depots_),
+                                                                                 snapshot_()
     {
-        init_routing_arcs_map_(routing_arcs_);
-        init_sync_arcs_map_(sync_arcs_);
+        init_routing_arrays_();
+        init_sync_arcs_map_(sync_arcs_, sync_arc_times_);
 
-        sync_model_builder::get_routing_arc_names(routing_arc_names_);
-        sync_model_builder::get_sync_arc_names(sync_arc_names_);
+        init_operation_arrays_();
+    }
 
-        init_routing_arc_resources_(routing_arc_times_);
-        init_sync_arc_resources_(sync_arc_times_);
+    sync_model_a_builder::sync_model_a_builder(const int problem_type,
+                                               const string &instance_name,
+                                               const size_t n_vehicles,
+                                               const size_t n_depots,
+                                               const size_t n_customers,
+                                               const double max_distance,
+                                               const double time_windows_max_size,
+                                               vector<sync_operation> &&operations,
+                                               vector<triplet> &&routing_arcs,
+                                               vector<double> &&routing_arc_times,
+                                               vector<triplet> &&sync_arcs,
+                                               vector<double> &&sync_arc_times) : sync_model_builder(problem_type, instance_name, n_vehicles, n_customers, move(operations)), n_operations_(get_n_operations()),
+                                                                                 problem_type_(problem_type),
+                                                                                 n_customers_(n_customers),
+                                                                                 n_vehicles_(n_vehicles),
+                                                                                 n_depots_(n_depots),
+                                                                                 max_distance_(max_distance),
+                                                                                 time_windows_max_size_(time_windows_max_size),
+                                                                                 routing_arrays_(),
+                                                                                 routing_arc_names_(),
+                                                                                 sync_arcs_pair_map_(n_operations_),
+                                                                                 sync_arcs_(move(sync_arcs)),
+                                                                                 sync_arc_names_(),
+                                                                                 sync_arc_times_(move(sync_arc_times)),
+                                                                                 operation_names_(),
+                                                                                 operation_resources_(),
+                                                                                 operations_map_(n_customers_ + 1, n_depots_),
+                                                                                 snapshot_()
+    {
+        shared_ptr<sync_routing_arrays> routing_arrays{make_shared<sync_routing_arrays>(n_operations_)};
 
-        init_operation_names_(operation_names_);
-        init_operations_map_(operations_map_);
-        init_operation_resources_(operation_resources_);
-        init_operation_costs_(operation_costs_);
+        routing_arrays->arcs_ = move(routing_arcs);
+        routing_arrays->times_ = move(routing_arc_times);
+        routing_arrays->index(n_operations_);
 
-        get_routing_outbound_arcs_(routing_outbound_arcs_);
-        get_routing_inbound_arcs_(routing_inbound_arcs_);
+        routing_arrays_ = routing_arrays;
 
-        set_routing_cost_matrix_(arc_time_matrix_);
+        sync_arcs_pair_map_.set(sync_arcs_);
 
-        get_operation_2_customer_(operation_2_customer_);
-        get_operation_2_depot_(operation_2_depot_);
+        init_operation_arrays_();
+    }
+
+    sync_model_a_builder::sync_model_a_builder(const sync_model_a_builder &base,
+                                               const string &instance_name,
+                                               const double time_windows_max_size) : sync_model_builder(base.problem_type_, instance_name, base.n_vehicles_, base.n_customers_, variant_operations(base.operations_, base.n_customers_, time_windows_max_size)), n_operations_(get_n_operations()),
+                                                                                     problem_type_(base.problem_type_),
+                                                                                     n_customers_(base.n_customers_),
+                                                                                     n_vehicles_(base.n_vehicles_),
+                                                                                     n_depots_(base.n_depots_),
+                                                                                     max_distance_(base.max_distance_),
+                                                                                     time_windows_max_size_(time_windows_max_size),
+                                                                                     routing_arrays_(base.routing_arrays_),
+                                                                                     routing_arc_names_(atomic_load(&base.routing_arc_names_)),
+                                                                                     sync_arcs_pair_map_(base.sync_arcs_pair_map_),
+                                                                                     sync_arcs_(base.sync_arcs_),
+                                                                                     sync_arc_names_(atomic_load(&base.sync_arc_names_)),
+                                                                                     sync_arc_times_(base.sync_arc_times_),
+                                                                                     operation_names_(),
+                                                                                     operation_resources_(),
+                                                                                     operations_map_(n_customers_ + 1, n_depots_),
+                                                                                     snapshot_(base.get_snapshot())
+    {
+        pruning_ = base.pruning_;
+        n_pruned_arcs_ = base.n_pruned_arcs_;
+
+        init_operation_arrays_();
+        set_time_windows_max_size(time_windows_max_size);
     }
 
     sync_model_a_builder::~sync_model_a_builder(void) {}
 
-    void sync_model_a_builder::init_routing_subset_maps_(vector<int> &ss_maps)
+    size_t sync_model_a_builder::get_memory_bytes(void) const
     {
-        get_routing_subsets_maps(ss_maps);
+        size_t bytes{routing_arrays_->get_memory_bytes() + sync_arcs_pair_map_.get_memory_bytes()};
+
+        bytes += GOMA::vector_bytes(sync_arcs_) + GOMA::vector_bytes(sync_arc_times_);
+
+        bytes += GOMA::vector_bytes(operation_names_) + GOMA::vector_bytes(operation_resources_) +
+                 GOMA::vector_bytes(operation_costs_) + operations_map_.get_memory_bytes() +
+                 GOMA::vector_bytes(operation_2_customer_) + GOMA::vector_bytes(operation_2_depot_) +
+                 GOMA::vector_bytes(sync_model_builder::operations_);
+
+        // Built on demand, possibly by another thread: read each pointer once
+        const shared_ptr<const vector<string>> routing_arc_names{atomic_load(&routing_arc_names_)};
+        const shared_ptr<const vector<string>> sync_arc_names{atomic_load(&sync_arc_names_)};
+        const shared_ptr<const sync_model_snapshot> snapshot{atomic_load(&snapshot_)};
+
+        if (routing_arc_names)
+            bytes += GOMA::vector_bytes(*routing_arc_names);
+
+        if (sync_arc_names)
+            bytes += GOMA::vector_bytes(*sync_arc_names);
+
+        if (snapshot)
+            bytes += snapshot->get_memory_bytes();
+
+        return bytes;
     }
 
-    void sync_model_a_builder::init_sync_subset_maps_(vector<int> &ss_maps)
+    shared_ptr<const sync_model_snapshot> sync_model_a_builder::get_snapshot(void) const
     {
-        get_sync_subsets_maps(ss_maps);
+        shared_ptr<const sync_model_snapshot> snapshot{atomic_load(&snapshot_)};
+
+        if (snapshot)
+            return snapshot;
+
+        // Concurrent first calls may both build one: the first one stored wins
+        shared_ptr<const sync_model_snapshot> built{make_shared<const sync_model_snapshot>(*this)};
+
+        if (atomic_compare_exchange_strong(&snapshot_, &snapshot, built))
+            return built;
+
+        return snapshot;
     }
 
-    void sync_model_a_builder::init_routing_arcs_map_(vector<triplet> &arcs)
+    void sync_model_a_builder::init_operation_arrays_(void)
     {
-        sync_model_builder::get_routing_arcs(arcs);
-        routing_arcs_pair_map_.set(routing_arcs_);
+        init_operation_names_(operation_names_);
+        init_operations_map_(operations_map_);
+        init_operation_resources_(operation_resources_);
+        init_operation_costs_(operation_costs_);
+
+        get_operation_2_customer_(operation_2_customer_);
+        get_operation_2_depot_(operation_2_depot_);
     }
 
-    void sync_model_a_builder::init_sync_arcs_map_(vector<triplet> &arcs)
+    const vector<string> &sync_model_a_builder::get_routing_arc_names(void) const
     {
-        sync_model_builder::get_sync_arcs(arcs);
-        sync_arcs_pair_map_.set(sync_arcs_);
+        return arc_names_(routing_arc_names_, routing_arrays_->arcs_);
+    }
+
+    const vector<string> &sync_model_a_builder::get_sync_arc_names(void) const
+    {
+        return arc_names_(sync_arc_names_, sync_arcs_);
     }
 
-    void sync_model_a_builder::init_routing_arc_resources_(vector<double> &costs)
+    const vector<string> &sync_model_a_builder::arc_names_(shared_ptr<const vector<string>> &names, const vector<triplet> &arcs) const
     {
-        vector<vector<double>> resources;
+        shared_ptr<const vector<string>> stored{atomic_load(&names)};
+
+        if (stored)
+            return *stored;
+
+        // Same format as operation_arc::get_name
+        shared_ptr<vector<string>> built{make_shared<vector<string>>()};
+        built->reserve(arcs.size());
+
+        for (const triplet &arc : arcs)
+            built->push_back("(" + operations_[arc.i_].get_name() + "_" + operations_[arc.j_].get_name() + ")");
 
-        sync_model_builder::get_routing_arc_resources(resources);
+        // Concurrent first calls may both build them: the first one stored wins
+        shared_ptr<const vector<string>> candidate{built};
 
-        const int n_arcs{(int)routing_arcs_.size()};
-        costs.resize(n_arcs);
+        if (atomic_compare_exchange_strong(&names, &stored, candidate))
+            return *candidate;
+
+        return *stored;
+    }
+
+    void sync_model_a_builder::set_time_windows_max_size(const double time_windows_max_size)
+    {
+        time_windows_max_size_ = time_windows_max_size;
 
-        for (int i{0}; i < n_arcs; i++)
+        // Customer sync arcs have time w_c - processing time (0)
+        const size_t n_sync_arcs{sync_arcs_.size()};
+
+        for (size_t i{0}; i < n_sync_arcs; i++)
         {
-            costs[i] = resources[i][1];
+            if (is_customer_sync_arc(i))
+                sync_arc_times_[i] = time_windows_max_size;
         }
     }
 
-    void sync_model_a_builder::init_sync_arc_resources_(vector<double> &costs)
+    void sync_model_a_builder::init_routing_subset_maps_(vector<int> &ss_maps)
     {
-        vector<vector<double>> resources;
+        get_routing_subsets_maps(ss_maps);
+    }
 
-        sync_model_builder::get_sync_arc_resources(resources);
+    void sync_model_a_builder::init_sync_subset_maps_(vector<int> &ss_maps)
+    {
+        get_sync_subsets_maps(ss_maps);
+    }
 
-        const int n_arcs{(int)sync_arcs_.size()};
-        costs.resize(n_arcs);
+    void sync_model_a_builder::init_routing_arrays_(void)
+    {
+        shared_ptr<sync_routing_arrays> routing_arrays{make_shared<sync_routing_arrays>(n_operations_)};
 
-        for (int i{0}; i < n_arcs; i++)
-        {
-            costs[i] = resources[i][0];
-        }
+        // Arc (i,j) and its travel time (resource 1)
+        flatten_arcs_(routing_, 1, routing_arrays->arcs_, routing_arrays->times_);
+        routing_arrays->index(n_operations_);
+
+        routing_arrays_ = routing_arrays;
+    }
+
+    void sync_model_a_builder::init_sync_arcs_map_(vector<triplet> &arcs, vector<double> &times)
+    {
+        // Arc (i,j) and its offset w (resource 0)
+        flatten_arcs_(synchronization_, 0, arcs, times);
+        sync_arcs_pair_map_.set(sync_arcs_);
     }
 
     void sync_model_a_builder::init_routing_operations_subset(vector<vector<int>> &vertices)
@@ -177,42 +369,6 @@ namespace SYNC_LIB
         }
     }
 
-    void sync_model_a_builder::get_routing_inbound_arcs_(vector<vector<int>> &arc_inxs) const
-    {
-        const size_t n_operations{n_operations_};
-
-        arc_inxs.resize(n_operations);
-
-        const size_t routing_arcs_sz{routing_arcs_.size()};
-
-        for (size_t i{0}; i < routing_arcs_sz; i++)
-        {
-            const triplet &arc{routing_arcs_[i]};
-
-            const int jj{arc.j_};
-
-            arc_inxs[jj].push_back(i);
-        }
-    }
-
-    void sync_model_a_builder::get_routing_outbound_arcs_(vector<vector<int>> &arc_inxs) const
-    {
-        const size_t n_operations{n_operations_};
-
-        arc_inxs.resize(n_operations);
-
-        const size_t routing_arcs_sz{routing_arcs_.size()};
-
-        for (size_t i{0}; i < routing_arcs_sz; i++)
-        {
-            const triplet &arc{routing_arcs_[i]};
-
-            const int ii{arc.i_};
-
-            arc_inxs[ii].push_back(i);
-        }
-    }
-
     void sync_model_a_builder::get_operation_2_customer_(vector<int> &operation_2_customer) const
     {
         operation_2_customer.resize(n_operations_);
@@ -233,39 +389,16 @@ namespace SYNC_LIB
         }
     }
 
-    void sync_model_a_builder::set_routing_cost_matrix_(GOMA::matrix<double> &cost_mat) const
-    {
-        const size_t n_operations{n_operations_};
-
-        cost_mat.resize(n_operations, n_operations);
-        cost_mat.init(1E9);
-
-        const vector<triplet> &arcs{get_routing_arcs()};
-
-        int arc_inx{0};
-
-        for (const triplet &arc : arcs)
-        {
-            const int i{arc.i_};
-            const int j{arc.j_};
-
-            const double cost{routing_arc_times_[arc_inx]};
-
-            cost_mat(i + 1, j + 1) = cost;
-
-            arc_inx++;
-        }
-    }
-
     void sync_model_a_builder::build_cluster_arcs_(vector<int> &clusters) const
     {
         clusters.clear();
 
-        const size_t n_arcs{routing_arc_times_.size()};
+        const vector<double> &times{routing_arrays_->times_};
+        const size_t n_arcs{times.size()};
 
         for (size_t i{0}; i < n_arcs; i++)
         {
-            const double c_ij{routing_arc_times_[i]};
+            const double c_ij{times[i]};
 
             if (fabs(c_ij) < 1E-2)
             {
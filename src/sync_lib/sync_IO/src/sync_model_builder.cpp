@@ -1,17 +1,69 @@
 #include "sync_model_builder.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+// Customers per synchronization block handed to a thread
+#define SYNC_BLOCK_SIZE 64
 
 namespace SYNC_LIB
 {
-    sync_model_builder::sync_model_builder(const int problem_type, const string &instance_name, const size_t n_vehicles, const size_t n_depots, const size_t n_customers, const vector<vector<int>> &demands, const double max_distance, const vector<double> &w, const GOMA::matrix<double> &distances) : problem_type_(problem_type), instance_name_(instance_name), routing_("Routing"), synchronization_("Synchronization"), n_vehicles_(n_vehicles), n_customers_(n_customers)
+    /**
+     * @brief Run body(k) once for every k in [0, n), on up to n_threads
+     *        threads (the calling one included, 0: one per core)
+     *
+     * Blocks are handed out in order through a shared counter; body must
+     * only write to the slots of its own k.
+     */
+    template <typename F>
+    static void run_blocks(const size_t n, const size_t n_threads, const F &body)
+    {
+        const size_t n_workers{min(n, n_threads == 0 ? (size_t)max(1u, thread::hardware_concurrency()) : n_threads)};
+
+        atomic<size_t> next{0};
+
+        const auto work{[&]()
+                        {
+                            for (size_t k{next++}; k < n; k = next++)
+                                body(k);
+                        }};
+
+        vector<thread> workers;
+
+        for (size_t t{1}; t < n_workers; t++)
+            workers.emplace_back(work);
+
+        work();
+
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    sync_model_builder::sync_model_builder(const int problem_type, const string &instance_name, const size_t n_vehicles, const size_t n_depots, const size_t n_customers, const vector<vector<int>> &demands, const double max_distance, const vector<double> &w, const GOMA::distance_oracle &distances, const arc_pruning &pruning, const size_t n_threads) : problem_type_(problem_type), instance_name_(instance_name), routing_("Routing"), synchronization_("Synchronization"), n_vehicles_(n_vehicles), n_customers_(n_customers), pruning_(pruning), n_pruned_arcs_(0), n_threads_(n_threads)
     {
         build_instance(n_depots, n_customers, demands, max_distance, w, distances);
     }
 
+    sync_model_builder::sync_model_builder(const int problem_type, const string &instance_name, const size_t n_vehicles, const size_t n_customers, vector<sync_operation> &&operations) : problem_type_(problem_type), instance_name_(instance_name), operations_(move(operations)), routing_("Routing"), synchronization_("Synchronization"), n_vehicles_(n_vehicles), n_customers_(n_customers), pruning_(), n_pruned_arcs_(0), n_threads_(1)
+    {
+        // Same (customer + 1, vehicle) keys as build_operations
+        const int n_operations{(int)operations_.size()};
+
+        for (int j{0}; j < n_operations; j++)
+        {
+            const pair<int, int> &custom_vehicle{operations_[j].get_custom_vehicle()};
+            const operation_pair op_pair{custom_vehicle.first + 1, custom_vehicle.second};
+
+            operations_map_[op_pair] = j;
+            operations_map_inv_[j] = op_pair;
+        }
+    }
+
     sync_model_builder::~sync_model_builder(void) {}
 
-    void sync_model_builder::build_instance(const size_t n_depots, const size_t n_customers, const vector<vector<int>> &demands, const double max_distance, const vector<double> &w, const GOMA::matrix<double> &distances)
+    void sync_model_builder::build_instance(const size_t n_depots, const size_t n_customers, const vector<vector<int>> &demands, const double max_distance, const vector<double> &w, const GOMA::distance_oracle &distances)
     {
         build_operations(n_depots, n_customers, w, max_distance, demands);
         build_routing_partition(n_depots, max_distance, distances);
@@ -23,7 +75,7 @@ namespace SYNC_LIB
         build_operations(n_depots, n_customers, w, max_distance, demands, operations_);
     }
 
-    void sync_model_builder::build_routing_partition(const size_t n_depots, const double max_distance, const GOMA::matrix<double> &distances)
+    void sync_model_builder::build_routing_partition(const size_t n_depots, const double max_distance, const GOMA::distance_oracle &distances)
     {
         build_routing_partition(n_depots, max_distance, distances, operations_, routing_);
     }
@@ -123,7 +175,7 @@ namespace SYNC_LIB
         }
     }
 
-    void sync_model_builder::build_routing_partition(const size_t n_depots, const double max_distance, const GOMA::matrix<double> &distances, const vector<sync_operation> &operations, operations_partition &routing)
+    void sync_model_builder::build_routing_partition(const size_t n_depots, const double max_distance, const GOMA::distance_oracle &distances, const vector<sync_operation> &operations, operations_partition &routing)
     {
         const size_t n_operations{operations.size()};
         const size_t n_vertices{distances.get_n_rows()};
@@ -136,9 +188,15 @@ namespace SYNC_LIB
             routing_subset[l] = S;
         }
 
+        // (customer + 1, vehicle) of each operation, read by every thread
+        vector<operation_pair> operation_pairs(n_operations);
+
+        for (size_t j{0}; j < n_operations; ++j)
+            operation_pairs[j] = operations_map_inv_.at(j);
+
         for (size_t j{0}; j < n_operations; ++j)
         {
-            const auto &operation = operations_map_inv_[j];
+            const auto &operation = operation_pairs[j];
             const int l = operation.second - 1;
 
             assert(l >= 0 && l < (int)n_depots);
@@ -146,10 +204,41 @@ namespace SYNC_LIB
             routing_subset[l].push_back(j);
         }
 
-        // Intra set arcs
+        // Distance matrix node of each operation (depot operations: node 1)
+        vector<int> node(n_operations);
 
-        for (size_t l{0}; l < n_depots; l++)
+        for (size_t j{0}; j < n_operations; ++j)
+            node[j] = ((operation_pairs[j].first - 1) % n_vertices) + 1;
+
+        // Route duration bound: d(depot, i) + t_ij + d(j, depot) <= max_distance
+        // (the matrix diagonal holds a large value, not 0)
+        const bool prune_duration{pruning_.duration};
+
+        vector<double> from_depot(n_operations, 0);
+        vector<double> to_depot(n_operations, 0);
+
+        if (prune_duration)
+        {
+            for (size_t j{0}; j < n_operations; ++j)
+            {
+                if (node[j] != 1)
+                {
+                    from_depot[j] = distances(1, node[j]);
+                    to_depot[j] = distances(node[j], 1);
+                }
+            }
+        }
+
+        // Arcs left out in each subset
+        vector<size_t> n_pruned(n_depots, 0);
+
+        // Intra set arcs, one subset per thread at a time
+
+        const auto build_subset{[&](const size_t l)
         {
+            vector<double> out_threshold;
+            vector<double> in_threshold;
+
             const size_t operation_depot_s{l};
             const size_t operation_depot_t{n_depots + l};
 
@@ -158,6 +247,9 @@ namespace SYNC_LIB
 
             const size_t n_subset_operations{r_subset.size()};
 
+            if (pruning_.k_nearest > 0)
+                get_knn_thresholds_(r_subset, node, n_depots, distances, out_threshold, in_threshold);
+
             for (size_t i{0}; i < n_subset_operations; i++)
             {
                 const int operation_i{r_subset[i]};
@@ -165,9 +257,12 @@ namespace SYNC_LIB
                 if (operation_i != operation_depot_t)
                 {
 
-                    const auto &operation_pair_i{operations_map_inv_[operation_i]};
+                    const auto &operation_pair_i{operation_pairs[operation_i]};
                     const int p_i{operation_pair_i.first - 1};
 
+                    // Stored distances: one contiguous row, no call per arc
+                    const double *distances_i{distances.get_row(p_i + 1)};
+
 #ifndef NDEBUG
                     const int p_i_l{operation_pair_i.second - 1};
                     assert(p_i_l == (int)(l));
@@ -183,7 +278,7 @@ namespace SYNC_LIB
                             // Evitamos que 0_s sea destino y que 0_t sea origen
                             if ((operation_j != operation_depot_s) && (!(operation_j == operation_depot_t && operation_i == operation_depot_s)))
                             {
-                                const auto &operation_pair_j{operations_map_inv_[operation_j]};
+                                const auto &operation_pair_j{operation_pairs[operation_j]};
                                 const int p_j{operation_pair_j.first - 1};
 
 #ifndef NDEBUG
@@ -191,7 +286,7 @@ namespace SYNC_LIB
                                 assert(p_j_l == (int)(l));
 #endif
 
-                                double distance{distances(p_i + 1, (p_j % n_vertices) + 1)};
+                                double distance{distances_i != NULL ? distances_i[p_j % n_vertices] : distances(p_i + 1, (p_j % n_vertices) + 1)};
                                 double time{distance + processing_time_i};
 
                                 if (distance > 10000)
@@ -202,6 +297,20 @@ namespace SYNC_LIB
                                     time =  0;
                                 }
 
+                                const bool depot_arc{(operation_i < (int)n_depots) || (operation_j >= (int)n_depots && operation_j < 2 * (int)n_depots)};
+
+                                if (prune_duration && (from_depot[operation_i] + time + to_depot[operation_j] > max_distance + 1E-6))
+                                {
+                                    n_pruned[l]++;
+                                    continue;
+                                }
+
+                                if ((pruning_.k_nearest > 0) && !depot_arc && (time > out_threshold[i]) && (time > in_threshold[j]))
+                                {
+                                    n_pruned[l]++;
+                                    continue;
+                                }
+
                                 const operation_arc arc{operation_arc(operation_pair(operation_i, operation_j), subset_pair(l, l), {distance, time})};
 
                                 routing_subset_l.add_arc(arc);
@@ -209,11 +318,63 @@ namespace SYNC_LIB
                         }
                 }
             }
-        }
+        }};
+
+        run_blocks(n_depots, distances.concurrent_reads() ? n_threads_ : 1, build_subset);
+
+        n_pruned_arcs_ = 0;
+
+        for (const size_t n_pruned_l : n_pruned)
+            n_pruned_arcs_ += n_pruned_l;
 
         routing.insert(routing.end(), routing_subset.begin(), routing_subset.end());
     }
 
+    void sync_model_builder::get_knn_thresholds_(const vector<int> &r_subset, const vector<int> &node, const size_t n_depots,
+                                                 const GOMA::distance_oracle &distances,
+                                                 vector<double> &out_threshold, vector<double> &in_threshold) const
+    {
+        const size_t n_subset_operations{r_subset.size()};
+        const size_t k{pruning_.k_nearest};
+
+        out_threshold.assign(n_subset_operations, numeric_limits<double>::infinity());
+        in_threshold.assign(n_subset_operations, numeric_limits<double>::infinity());
+
+        // Customer operations only: depot arcs are always kept
+        vector<double> times;
+        times.reserve(n_subset_operations);
+
+        for (int direction{0}; direction < 2; direction++)
+        {
+            vector<double> &threshold{direction == 0 ? out_threshold : in_threshold};
+
+            for (size_t i{0}; i < n_subset_operations; i++)
+            {
+                if (r_subset[i] < 2 * (int)n_depots)
+                    continue;
+
+                times.clear();
+
+                for (size_t j{0}; j < n_subset_operations; j++)
+                {
+                    if ((i == j) || (r_subset[j] < 2 * (int)n_depots))
+                        continue;
+
+                    const int s{node[r_subset[direction == 0 ? i : j]]};
+                    const int t{node[r_subset[direction == 0 ? j : i]]};
+
+                    times.push_back(distances(s, t));
+                }
+
+                if (times.size() <= k)
+                    continue;
+
+                nth_element(times.begin(), times.begin() + (k - 1), times.end());
+                threshold[i] = times[k - 1];
+            }
+        }
+    }
+
     void sync_model_builder::build_synchronization_partition(const size_t n_depots, const size_t n_customers, const vector<double> &w, const double max_distance, const vector<sync_operation> &operations, operations_partition &synchronization)
     {
         vector<operations_subset> synchronization_subset(n_customers + 1);
@@ -241,7 +402,8 @@ namespace SYNC_LIB
             synchronization_subset[i].push_back(j);
         }
 
-        for (size_t c{0}; c < n_customers; c++)
+        // Customer subsets, SYNC_BLOCK_SIZE customers per thread at a time
+        const auto build_customer{[&](const size_t c)
         {
             operations_subset &synchronization_subset_l{synchronization_subset[c + 1]};
             const vector<int> &s_subset{synchronization_subset_l.get_operations_id()};
@@ -272,7 +434,16 @@ namespace SYNC_LIB
                         synchronization_subset_l.add_arc(arc);
                     }
             }
-        }
+        }};
+
+        const size_t n_blocks{(n_customers + SYNC_BLOCK_SIZE - 1) / SYNC_BLOCK_SIZE};
+
+        run_blocks(n_blocks, n_threads_, [&](const size_t b)
+                   {
+                       const size_t last{min(n_customers, (b + 1) * SYNC_BLOCK_SIZE)};
+
+                       for (size_t c{b * SYNC_BLOCK_SIZE}; c < last; c++)
+                           build_customer(c); });
 
         {
             operations_subset &synchronization_subset_l{synchronization_subset[0]};
@@ -355,6 +526,38 @@ namespace SYNC_LIB
         }
     }
 
+    void sync_model_builder::flatten_arcs_(const operations_partition &P, const size_t resource, vector<triplet> &arcs, vector<double> &values) const
+    {
+        const size_t n_subsets{P.size()};
+
+        // First arc of the arcs between subsets (block 0) and of each subset
+        vector<size_t> first(n_subsets + 2, 0);
+
+        first[1] = P.get_arcs().size();
+
+        for (size_t k{0}; k < n_subsets; k++)
+            first[k + 2] = first[k + 1] + P.at(k).get_arcs().size();
+
+        arcs.resize(first.back());
+        values.resize(first.back());
+
+        const auto fill_block{[&](const size_t b)
+        {
+            const operation_arc_list &A{b == 0 ? P.get_arcs() : P.at(b - 1).get_arcs()};
+
+            size_t a{first[b]};
+
+            for (const operation_arc &arc : A)
+            {
+                arcs[a] = triplet(arc.first.first.first, arc.first.first.second, arc.first.second.first, arc.first.second.second);
+                values[a] = arc.second[resource];
+                a++;
+            }
+        }};
+
+        run_blocks(n_subsets + 1, n_threads_, fill_block);
+    }
+
     void sync_model_builder::init_arcs_(const operation_arc_list &A, vector<triplet> &arcs) const
     {
         for (const operation_arc &arc : A)
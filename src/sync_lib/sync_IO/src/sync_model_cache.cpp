@@ -0,0 +1,365 @@
+/**
+ * @file sync_model_cache.cpp
+ * @brief Implementation of the .ctspbin model cache
+ */
+
+#include "sync_model_cache.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MODEL_CACHE_VERSION 1
+#define MODEL_CACHE_BYTE_ORDER 0x01020304
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+namespace SYNC_LIB
+{
+    static const char model_cache_magic[8]{'C', 'T', 'S', 'P', 'B', 'I', 'N', '\0'};
+
+    static_assert(sizeof(triplet) == 4 * sizeof(int32_t), "triplet is stored as four int32");
+
+    /**
+     * @class mapped_file_
+     * @brief Read-only mapping of a whole file with a bounds-checked cursor
+     */
+    class mapped_file_
+    {
+    private:
+        const char *begin_; ///< First byte of the mapping
+        const char *end_;   ///< One past the last byte
+        const char *pos_;   ///< Next byte to read
+
+        size_t size_; ///< Mapped bytes (0: nothing mapped)
+
+    public:
+        mapped_file_(void) : begin_(NULL), end_(NULL), pos_(NULL), size_(0) {}
+
+        ~mapped_file_(void)
+        {
+            if (size_ > 0)
+                munmap(const_cast<char *>(begin_), size_);
+        }
+
+        mapped_file_(const mapped_file_ &) = delete;
+        mapped_file_ &operator=(const mapped_file_ &) = delete;
+
+        bool open(const string &filename)
+        {
+            const int fd{::open(filename.c_str(), O_RDONLY)};
+
+            if (fd < 0)
+                return false;
+
+            struct stat st;
+
+            if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size == 0))
+            {
+                close(fd);
+                return false;
+            }
+
+            void *addr{mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+            close(fd);
+
+            if (addr == MAP_FAILED)
+                return false;
+
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+            size_ = st.st_size;
+            begin_ = static_cast<const char *>(addr);
+            end_ = begin_ + size_;
+            pos_ = begin_;
+
+            return true;
+        }
+
+        inline const char *data(void) const { return begin_; }
+        inline size_t size(void) const { return size_; }
+
+        /**
+         * @brief Copy the next n bytes
+         * @return false (nothing copied) if fewer than n bytes are left
+         */
+        bool read(void *dst, const size_t n)
+        {
+            if ((size_t)(end_ - pos_) < n)
+                return false;
+
+            memcpy(dst, pos_, n);
+            pos_ += n;
+
+            return true;
+        }
+
+        template <typename T>
+        bool read(T &val) { return read(&val, sizeof(T)); }
+
+        /**
+         * @brief Read an element count, checking that n items of item_size bytes fit
+         */
+        bool read_size(size_t &n, const size_t item_size)
+        {
+            uint64_t n64{0};
+
+            if (!read(n64) || (item_size > 0 && n64 > (uint64_t)(end_ - pos_) / item_size))
+                return false;
+
+            n = n64;
+
+            return true;
+        }
+
+        bool read(string &s)
+        {
+            size_t n{0};
+
+            if (!read_size(n, 1))
+                return false;
+
+            s.assign(pos_, n);
+            pos_ += n;
+
+            return true;
+        }
+
+        bool read(vector<double> &v)
+        {
+            size_t n{0};
+
+            if (!read_size(n, sizeof(double)))
+                return false;
+
+            v.resize(n);
+
+            return read(v.data(), n * sizeof(double));
+        }
+
+        bool read(vector<triplet> &v)
+        {
+            size_t n{0};
+
+            if (!read_size(n, sizeof(triplet)))
+                return false;
+
+            v.resize(n);
+
+            return read(v.data(), n * sizeof(triplet));
+        }
+    };
+
+    template <typename T>
+    static void write_(ostream &os, const T &val)
+    {
+        os.write(reinterpret_cast<const char *>(&val), sizeof(T));
+    }
+
+    static void write_(ostream &os, const string &s)
+    {
+        write_(os, (uint64_t)s.size());
+        os.write(s.data(), s.size());
+    }
+
+    static void write_(ostream &os, const vector<double> &v)
+    {
+        write_(os, (uint64_t)v.size());
+        os.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(double));
+    }
+
+    static void write_(ostream &os, const vector<triplet> &v)
+    {
+        write_(os, (uint64_t)v.size());
+        os.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(triplet));
+    }
+
+    sync_model_cache::sync_model_cache(const string &filename, const uint64_t instance_key) : filename_(filename),
+                                                                                             instance_key_(instance_key)
+    {
+    }
+
+    sync_model_cache::~sync_model_cache(void)
+    {
+    }
+
+    bool sync_model_cache::instance_key(const string &instance_file, const int problem_type, uint64_t &key, const uint64_t variant)
+    {
+        mapped_file_ file;
+
+        if (!file.open(instance_file))
+            return false;
+
+        uint64_t hash{FNV_OFFSET_BASIS};
+
+        const unsigned char *data{reinterpret_cast<const unsigned char *>(file.data())};
+        const size_t size{file.size()};
+
+        for (size_t i{0}; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+
+        // A CTSP1 and a CTSP2 model of one file differ
+        hash ^= (uint64_t)problem_type;
+        hash *= FNV_PRIME;
+
+        // Pruned models differ too (keys of unpruned models are unchanged)
+        if (variant != 0)
+        {
+            for (int b{0}; b < 8; b++)
+            {
+                hash ^= (variant >> (8 * b)) & 0xFF;
+                hash *= FNV_PRIME;
+            }
+        }
+
+        key = hash;
+
+        return true;
+    }
+
+    bool sync_model_cache::save(const sync_model_a_builder &builder) const
+    {
+        const string tmp_filename{filename_ + ".tmp" + to_string(getpid())};
+
+        {
+            ofstream os(tmp_filename, ios::binary);
+
+            if (!os)
+                return false;
+
+            os.write(model_cache_magic, sizeof(model_cache_magic));
+            write_(os, (uint32_t)MODEL_CACHE_VERSION);
+            write_(os, (uint32_t)MODEL_CACHE_BYTE_ORDER);
+            write_(os, instance_key_);
+
+            write_(os, (int32_t)builder.get_problem_type());
+            write_(os, (uint64_t)builder.get_n_vehicles());
+            write_(os, (uint64_t)builder.get_n_depots());
+            write_(os, (uint64_t)builder.get_n_customers());
+            write_(os, builder.get_max_distance());
+            write_(os, builder.get_time_windows_max_size());
+            write_(os, builder.get_instance_name());
+
+            const vector<sync_operation> &operations{builder.get_operations()};
+
+            write_(os, (uint64_t)operations.size());
+
+            for (const sync_operation &operation : operations)
+            {
+                write_(os, operation.get_name());
+                write_(os, operation.get_resources());
+                write_(os, (int32_t)operation.get_custom_vehicle().first);
+                write_(os, (int32_t)operation.get_custom_vehicle().second);
+            }
+
+            write_(os, builder.get_routing_arcs());
+            write_(os, builder.get_routing_arc_times());
+            write_(os, builder.get_sync_arcs());
+            write_(os, builder.get_sync_arc_times());
+
+            os.close();
+
+            if (!os)
+            {
+                remove(tmp_filename.c_str());
+                return false;
+            }
+        }
+
+        if (rename(tmp_filename.c_str(), filename_.c_str()) != 0)
+        {
+            remove(tmp_filename.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool sync_model_cache::load(unique_ptr<sync_model_a_builder> &builder) const
+    {
+        mapped_file_ file;
+
+        if (!file.open(filename_))
+            return false;
+
+        char magic[sizeof(model_cache_magic)];
+        uint32_t version{0};
+        uint32_t byte_order{0};
+        uint64_t instance_key{0};
+
+        if (!file.read(magic, sizeof(magic)) || !file.read(version) || !file.read(byte_order) || !file.read(instance_key))
+            return false;
+
+        if (memcmp(magic, model_cache_magic, sizeof(magic)) != 0 || version != MODEL_CACHE_VERSION ||
+            byte_order != MODEL_CACHE_BYTE_ORDER || instance_key != instance_key_)
+            return false;
+
+        int32_t problem_type{0};
+        uint64_t n_vehicles{0};
+        uint64_t n_depots{0};
+        uint64_t n_customers{0};
+        double max_distance{0};
+        double time_windows_max_size{0};
+        string instance_name;
+
+        if (!file.read(problem_type) || !file.read(n_vehicles) || !file.read(n_depots) || !file.read(n_customers) ||
+            !file.read(max_distance) || !file.read(time_windows_max_size) || !file.read(instance_name))
+            return false;
+
+        size_t n_operations{0};
+
+        // Smallest operation: empty name, no resources, two int32
+        if (!file.read_size(n_operations, 2 * sizeof(uint64_t) + 2 * sizeof(int32_t)))
+            return false;
+
+        vector<sync_operation> operations(n_operations);
+
+        string name;
+        resource_vector r;
+
+        for (size_t j{0}; j < n_operations; j++)
+        {
+            int32_t customer{0};
+            int32_t vehicle{0};
+
+            if (!file.read(name) || !file.read(r) || !file.read(customer) || !file.read(vehicle))
+                return false;
+
+            operations[j] = sync_operation(name, r, pair<int, int>(customer, vehicle));
+        }
+
+        vector<triplet> routing_arcs;
+        vector<double> routing_arc_times;
+        vector<triplet> sync_arcs;
+        vector<double> sync_arc_times;
+
+        if (!file.read(routing_arcs) || !file.read(routing_arc_times) || !file.read(sync_arcs) || !file.read(sync_arc_times))
+            return false;
+
+        if (routing_arcs.size() != routing_arc_times.size() || sync_arcs.size() != sync_arc_times.size())
+            return false;
+
+        // Arc ends must be operations (they index the pair maps)
+        for (const vector<triplet> *arcs : {&routing_arcs, &sync_arcs})
+            for (const triplet &arc : *arcs)
+                if (arc.i_ < 0 || arc.j_ < 0 || (size_t)arc.i_ >= n_operations || (size_t)arc.j_ >= n_operations)
+                    return false;
+
+        builder.reset(new sync_model_a_builder(problem_type, instance_name, n_vehicles, n_depots, n_customers,
+                                               max_distance, time_windows_max_size, move(operations),
+                                               move(routing_arcs), move(routing_arc_times),
+                                               move(sync_arcs), move(sync_arc_times)));
+
+        return true;
+    }
+}
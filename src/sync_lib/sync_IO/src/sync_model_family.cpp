@@ -0,0 +1,142 @@
+/**
+ * @file sync_model_family.cpp
+ * @brief Implementation of the model registry by routing structure
+ */
+
+#include "sync_model_family.hpp"
+
+#include <cstring>
+
+// FNV-1a, as the instance keys of sync_model_cache
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+namespace SYNC_LIB
+{
+    /**
+     * @brief Mix the bytes of a value into an FNV-1a hash
+     */
+    template <class T>
+    static void hash_value(uint64_t &hash, const T &value)
+    {
+        unsigned char bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+
+        for (const unsigned char byte : bytes)
+        {
+            hash ^= byte;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    sync_model_family::sync_model_family(void) : mutex_(),
+                                                 models_(),
+                                                 n_shared_(0)
+    {
+    }
+
+    sync_model_family::~sync_model_family(void)
+    {
+    }
+
+    uint64_t sync_model_family::structure_key(const int problem_type,
+                                              const size_t n_depots,
+                                              const size_t n_customers,
+                                              const vector<vector<int>> &demands,
+                                              const double max_distance,
+                                              const GOMA::distance_oracle &distances,
+                                              const bool triangle_inequality,
+                                              const arc_pruning &pruning)
+    {
+        uint64_t hash{FNV_OFFSET_BASIS};
+
+        hash_value(hash, (int32_t)problem_type);
+        hash_value(hash, (uint64_t)n_depots);
+        hash_value(hash, (uint64_t)n_customers);
+        hash_value(hash, max_distance);
+        hash_value(hash, (uint8_t)triangle_inequality);
+        hash_value(hash, pruning.get_key());
+
+        // Deliveries: which days each customer is visited
+        hash_value(hash, (uint64_t)demands.size());
+
+        for (const vector<int> &row : demands)
+        {
+            hash_value(hash, (uint64_t)row.size());
+
+            for (const int demand : row)
+                hash_value(hash, (uint8_t)(demand > 0));
+        }
+
+        const size_t n{distances.get_n_rows()};
+
+        hash_value(hash, (uint64_t)n);
+
+        for (size_t i{1}; i <= n; i++)
+            for (size_t j{1}; j <= n; j++)
+                hash_value(hash, distances(i, j));
+
+        return hash;
+    }
+
+    bool sync_model_family::find(const uint64_t key, const string &instance_name, const vector<double> &w,
+                                 unique_ptr<sync_model_a_builder> &builder, string &base_name)
+    {
+        if (w.empty())
+            return false;
+
+        for (const double w_i : w)
+            if (w_i != w[0])
+                return false;
+
+        shared_ptr<const sync_model_a_builder> base;
+
+        {
+            lock_guard<mutex> lock(mutex_);
+
+            const auto it{models_.find(key)};
+
+            if (it == models_.end())
+                return false;
+
+            base = it->second;
+            n_shared_++;
+        }
+
+        // The base is immutable: the variant is made outside the lock
+        builder.reset(new sync_model_a_builder(*base, instance_name, w[0]));
+        base_name = base->get_instance_name();
+
+        return true;
+    }
+
+    void sync_model_family::add(const uint64_t key, const sync_model_a_builder &builder)
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+
+            if (models_.count(key) != 0)
+                return;
+        }
+
+        shared_ptr<const sync_model_a_builder> model{make_shared<const sync_model_a_builder>(builder, builder.get_instance_name(), builder.get_time_windows_max_size())};
+
+        lock_guard<mutex> lock(mutex_);
+
+        models_.emplace(key, model);
+    }
+
+    size_t sync_model_family::get_n_shared(void) const
+    {
+        lock_guard<mutex> lock(mutex_);
+
+        return n_shared_;
+    }
+
+    size_t sync_model_family::size(void) const
+    {
+        lock_guard<mutex> lock(mutex_);
+
+        return models_.size();
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file sync_model_snapshot.cpp
+ * @brief Implementation of the shared model snapshot
+ */
+
+#include "sync_model_snapshot.hpp"
+#include "memory_usage.hpp"
+
+namespace SYNC_LIB
+{
+    sync_model_snapshot::sync_model_snapshot(const sync_model_a_builder &builder) : n_operations_(builder.get_n_operations()),
+                                                                                    n_customers_(builder.get_n_customers()),
+                                                                                    n_depots_(builder.get_n_depots()),
+                                                                                    max_distance_(builder.get_max_distance()),
+                                                                                    routing_arcs_(builder.get_routing_arcs()),
+                                                                                    routing_arc_times_(builder.get_routing_arc_times()),
+                                                                                    routing_outbound_arcs_(builder.get_routing_outbound_arcs()),
+                                                                                    routing_inbound_arcs_(builder.get_routing_inbound_arcs()),
+                                                                                    sync_arcs_(builder.get_sync_arcs()),
+                                                                                    operation_2_customer_(builder.get_operation_2_customer()),
+                                                                                    operation_2_depot_(builder.get_operation_2_depot()),
+                                                                                    operation_names_(builder.get_operation_names())
+    {
+    }
+
+    sync_model_snapshot::~sync_model_snapshot(void)
+    {
+    }
+
+    size_t sync_model_snapshot::get_memory_bytes(void) const
+    {
+        return GOMA::vector_bytes(routing_arcs_) + GOMA::vector_bytes(routing_arc_times_) +
+               GOMA::vector_bytes(routing_outbound_arcs_) + GOMA::vector_bytes(routing_inbound_arcs_) +
+               GOMA::vector_bytes(sync_arcs_) + GOMA::vector_bytes(operation_2_customer_) +
+               GOMA::vector_bytes(operation_2_depot_) + GOMA::vector_bytes(operation_names_);
+    }
+}
@@ -23,6 +23,12 @@ namespace SYNC_LIB
         return os;
     }
 
+    void sync_scheduling::write_json(json_buffer &buffer) const
+    {
+        json_format_io json_io;
+        json_io.write(buffer, instance_name_, *this);
+    }
+
     istream &sync_scheduling::read_json(istream &is)
     {
         json_format_io json_io;
@@ -1,6 +1,7 @@
 #include "sync_solution.hpp"
 
 #include "json_format_io.hpp"
+#include "sync_solution_parser.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -16,16 +17,10 @@ namespace SYNC_LIB
     {
         if (instance_file != "")
         {
-            ifstream is(instance_file);
-            if (!is.is_open())
-            {
-                cerr << "Error opening file: " << instance_file << endl;
-            }
-            else
-            {
-                read(is);
-                is.close();
-            }
+            sync_solution_parser parser;
+
+            if (!parser.read(instance_file, *this))
+                cerr << parser.get_error() << endl;
         }
     }
 
@@ -139,6 +134,14 @@ namespace SYNC_LIB
         //os << "  \"routes\": " << endl;
     }
 
+    void sync_solution::write_header(json_buffer &buffer) const
+    {
+        buffer.put("{\n");
+        buffer.put("  \"instance_name\": \"");
+        buffer.put(instance_name_);
+        buffer.put("\",\n");
+    }
+
     void sync_solution::write_routes(ostream &os) const
     {
         json_format_io json_io;
@@ -151,6 +154,11 @@ namespace SYNC_LIB
         os << "}" << endl;
     }
 
+    void sync_solution::write_end(json_buffer &buffer) const
+    {
+        buffer.put("}\n");
+    }
+
     void sync_solution::write_json(ostream &os) const
     {
         json_format_io json_io;
@@ -0,0 +1,422 @@
+#include "sync_solution_parser.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cctype>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace SYNC_LIB
+{
+    sync_solution_parser::sync_solution_parser(void) : buffer_(),
+                                                       begin_(NULL),
+                                                       pos_(NULL),
+                                                       end_(NULL),
+                                                       error_()
+    {
+    }
+
+    sync_solution_parser::~sync_solution_parser(void)
+    {
+    }
+
+    bool sync_solution_parser::read(const string &filename, sync_solution &sol)
+    {
+        const int fd{::open(filename.c_str(), O_RDONLY)};
+
+        if (fd < 0)
+        {
+            error_ = "Error opening file: " + filename;
+            return false;
+        }
+
+        struct stat st;
+
+        if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+        {
+            close(fd);
+            error_ = "Error opening file: " + filename;
+            return false;
+        }
+
+        // Solution files are small: one read into the kept buffer is
+        // cheaper than mapping and unmapping each of them
+        if (buffer_.size() < (size_t)st.st_size)
+            buffer_.resize(st.st_size);
+
+        size_t n_read{0};
+
+        while (n_read < (size_t)st.st_size)
+        {
+            const ssize_t n{::read(fd, buffer_.data() + n_read, st.st_size - n_read)};
+
+            if (n <= 0)
+                break;
+
+            n_read += n;
+        }
+
+        close(fd);
+
+        if (n_read < (size_t)st.st_size)
+        {
+            error_ = "Error reading file: " + filename;
+            return false;
+        }
+
+        return parse(buffer_.data(), buffer_.data() + n_read, sol);
+    }
+
+    bool sync_solution_parser::parse(const char *first, const char *last, sync_solution &sol)
+    {
+        begin_ = first;
+        pos_ = first;
+        end_ = last;
+        error_.clear();
+
+        skip_blanks_();
+
+        if (pos_ >= end_)
+        {
+            sol.get_instance_name().clear();
+            sol.get_routes().clear();
+
+            error_ = "Error: Feasible solution file is empty.";
+            return false;
+        }
+
+        if ((*pos_ == '{') || (*pos_ == '['))
+            return parse_json_(sol);
+
+        return parse_sol_(sol);
+    }
+
+    bool sync_solution_parser::parse_sol_(sync_solution &sol)
+    {
+        // Instance name: first white space separated token
+        const char *name{pos_};
+
+        while ((pos_ < end_) && !isspace((unsigned char)*pos_))
+            pos_++;
+
+        sol.get_instance_name().assign(name, pos_);
+
+        size_t n_routes{0};
+
+        if (!next_size_(n_routes))
+            return error_at_("number of routes expected");
+
+        vector<vector<int>> &routes{sol.get_routes()};
+
+        routes.resize(n_routes);
+
+        for (vector<int> &route : routes)
+        {
+            size_t n_nodes{0};
+
+            if (!next_size_(n_nodes))
+                return error_at_("number of nodes expected");
+
+            route.resize(n_nodes);
+
+            for (int &node : route)
+            {
+                if (!next_int_(node))
+                    return error_at_("node expected");
+
+                node--;
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_solution_parser::parse_json_(sync_solution &sol)
+    {
+        string &instance_name{sol.get_instance_name()};
+        vector<vector<int>> &routes{sol.get_routes()};
+
+        instance_name.clear();
+
+        if (*pos_ == '[')
+            return parse_json_routes_(routes);
+
+        pos_++; // {
+
+        skip_blanks_();
+
+        if ((pos_ < end_) && (*pos_ == '}'))
+        {
+            pos_++;
+            routes.clear();
+            return true;
+        }
+
+        bool routes_read{false};
+
+        while (true)
+        {
+            const char *key{NULL};
+            const char *key_end{NULL};
+
+            if (!json_string_(key, key_end) || !expect_(':'))
+                return error_at_("member name expected");
+
+            const string_view member(key, key_end - key);
+
+            if (member == "instance_name")
+            {
+                const char *value{NULL};
+                const char *value_end{NULL};
+
+                if (!json_string_(value, value_end))
+                    return error_at_("instance name expected");
+
+                instance_name.assign(value, value_end);
+            }
+            else if (member == "routes")
+            {
+                skip_blanks_();
+
+                if (!parse_json_routes_(routes))
+                    return false;
+
+                routes_read = true;
+            }
+            else if (!skip_json_value_())
+            {
+                return error_at_("value expected");
+            }
+
+            skip_blanks_();
+
+            if (pos_ >= end_)
+                return error_at_("',' or '}' expected");
+
+            const char c{*pos_++};
+
+            if (c == '}')
+            {
+                if (!routes_read)
+                    routes.clear();
+
+                return true;
+            }
+
+            if (c != ',')
+                return error_at_("',' or '}' expected");
+        }
+    }
+
+    bool sync_solution_parser::parse_json_routes_(vector<vector<int>> &routes)
+    {
+        if (!expect_('['))
+            return error_at_("'[' expected at the beginning of routes");
+
+        size_t n_routes{0};
+
+        skip_blanks_();
+
+        if ((pos_ < end_) && (*pos_ == ']'))
+        {
+            pos_++;
+            routes.clear();
+            return true;
+        }
+
+        while (true)
+        {
+            if (!expect_('['))
+                return error_at_("'[' expected at the beginning of integer vector");
+
+            // Keep the capacity of the route that was there
+            if (routes.size() <= n_routes)
+                routes.resize(n_routes + 1);
+
+            vector<int> &route{routes[n_routes++]};
+
+            route.clear();
+
+            skip_blanks_();
+
+            if ((pos_ < end_) && (*pos_ == ']'))
+            {
+                pos_++;
+            }
+            else
+            {
+                while (true)
+                {
+                    int node{0};
+
+                    if (!next_int_(node))
+                        return error_at_("integer expected in integer vector");
+
+                    route.push_back(node);
+
+                    skip_blanks_();
+
+                    if (pos_ >= end_)
+                        return error_at_("',' or ']' expected in integer vector");
+
+                    const char c{*pos_++};
+
+                    if (c == ']')
+                        break;
+
+                    if (c != ',')
+                        return error_at_("',' or ']' expected in integer vector");
+                }
+            }
+
+            skip_blanks_();
+
+            if (pos_ >= end_)
+                return error_at_("',' or ']' expected after route");
+
+            const char c{*pos_++};
+
+            if (c == ']')
+                break;
+
+            if (c != ',')
+                return error_at_("',' or ']' expected after route");
+        }
+
+        routes.resize(n_routes);
+
+        return true;
+    }
+
+    bool sync_solution_parser::skip_json_value_(void)
+    {
+        skip_blanks_();
+
+        if (pos_ >= end_)
+            return false;
+
+        if (*pos_ == '"')
+        {
+            const char *first{NULL};
+            const char *last{NULL};
+
+            return json_string_(first, last);
+        }
+
+        if ((*pos_ == '[') || (*pos_ == '{'))
+        {
+            // Nesting depth only: strings may hold brackets
+            size_t depth{0};
+
+            while (pos_ < end_)
+            {
+                const char c{*pos_};
+
+                if (c == '"')
+                {
+                    const char *first{NULL};
+                    const char *last{NULL};
+
+                    if (!json_string_(first, last))
+                        return false;
+
+                    continue;
+                }
+
+                pos_++;
+
+                if ((c == '[') || (c == '{'))
+                    depth++;
+                else if (((c == ']') || (c == '}')) && (--depth == 0))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Number, true, false, null
+        while ((pos_ < end_) && (*pos_ != ',') && (*pos_ != '}') && (*pos_ != ']') && !isspace((unsigned char)*pos_))
+            pos_++;
+
+        return true;
+    }
+
+    void sync_solution_parser::skip_blanks_(void)
+    {
+        while ((pos_ < end_) && ((*pos_ == ' ') || (*pos_ == '\n') || (*pos_ == '\t') || (*pos_ == '\r')))
+            pos_++;
+    }
+
+    bool sync_solution_parser::next_int_(int &val)
+    {
+        skip_blanks_();
+
+        if ((pos_ < end_) && (*pos_ == '+'))
+            pos_++;
+
+        const from_chars_result res{from_chars(pos_, end_, val)};
+
+        if (res.ec != errc())
+            return false;
+
+        pos_ = res.ptr;
+
+        return true;
+    }
+
+    bool sync_solution_parser::next_size_(size_t &val)
+    {
+        skip_blanks_();
+
+        const from_chars_result res{from_chars(pos_, end_, val)};
+
+        if (res.ec != errc())
+            return false;
+
+        pos_ = res.ptr;
+
+        return true;
+    }
+
+    bool sync_solution_parser::expect_(const char c)
+    {
+        skip_blanks_();
+
+        if ((pos_ >= end_) || (*pos_ != c))
+            return false;
+
+        pos_++;
+
+        return true;
+    }
+
+    bool sync_solution_parser::json_string_(const char *&first, const char *&last)
+    {
+        if (!expect_('"'))
+            return false;
+
+        first = pos_;
+
+        // Escapes are kept as written (instance names have none)
+        while ((pos_ < end_) && (*pos_ != '"'))
+            pos_ += ((*pos_ == '\\') && (pos_ + 1 < end_)) ? 2 : 1;
+
+        if (pos_ >= end_)
+            return false;
+
+        last = pos_++;
+
+        return true;
+    }
+
+    bool sync_solution_parser::error_at_(const char *what)
+    {
+        const size_t line{(size_t)count(begin_, min(pos_, end_), '\n') + 1};
+
+        error_ = string("Error reading solution: ") + what + " at line " + to_string(line);
+        return false;
+    }
+}
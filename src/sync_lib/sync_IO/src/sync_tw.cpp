@@ -87,4 +87,43 @@ namespace SYNC_LIB
 
         return is;
     }
-}
\ No newline at end of file
+
+    sync_flexibility::sync_flexibility(void) : sync_time_windows(),
+                                               horizon_(0.0),
+                                               operation_names_()
+    {
+    }
+
+    sync_flexibility::~sync_flexibility(void)
+    {
+    }
+
+    void sync_flexibility::write_json(json_buffer &buffer) const
+    {
+        buffer.put("  \"horizon\": ");
+        buffer.put_double(horizon_);
+        buffer.put(",\n");
+
+        buffer.put("  \"flexibility\": [\n");
+
+        for (size_t i{0}; i < size(); ++i)
+        {
+            buffer.put("      { \"operation\": \"");
+            buffer.put(i < operation_names_.size() ? operation_names_[i] : to_string(i));
+            buffer.put("\", \"tw\": [");
+            buffer.put_double((*this)[i].lower_bound(), 6);
+            buffer.put(", ");
+            buffer.put_double((*this)[i].upper_bound(), 6);
+            buffer.put("], \"slack\": ");
+            buffer.put_double(get_slack(i), 6);
+            buffer.put(" }");
+
+            if (i + 1 < size())
+                buffer.put(',');
+
+            buffer.put('\n');
+        }
+
+        buffer.put("  ]\n");
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+#include "trace_recorder.hpp"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @file checker_pool.hpp
+ * @brief Pool of synchronization checkers for parallel batch checking
+ *
+ * A checker owns mutable LP state (loaded x, dual values, solver model), so
+ * one instance cannot be shared between threads. checker_pool builds one
+ * checker per thread from the same (read-only) sync_model_a_builder and
+ * spreads a population of routing vectors over the threads.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_check_result
+     * @brief Outcome of one checked routing vector
+     */
+    class sync_check_result
+    {
+    public:
+        bool feasible_;        ///< true if the synchronization constraints are satisfied
+        vector<double> s_;     ///< Start times (if feasible)
+        vector<double> alpha_; ///< α certificate (if infeasible)
+        vector<double> beta_;  ///< β certificate (if infeasible)
+        vector<double> gamma_; ///< γ certificate (if infeasible)
+
+        sync_check_result(void) : feasible_(false), s_(), alpha_(), beta_(), gamma_() {}
+
+        virtual ~sync_check_result(void) {}
+    };
+
+    /**
+     * @class checker_pool
+     * @brief One checker per worker thread, built from a shared builder
+     *
+     * Each worker takes the next unchecked vector from a shared atomic
+     * counter and checks it with its own checker, so the LP of every checker
+     * keeps its warm start along the vectors it checks. Results are stored
+     * by vector index, hence they do not depend on the thread schedule.
+     *
+     * ```cpp
+     * checker_pool<sync_iterative_checker<ctsp_lb_sync_checker>> pool(builder, tol, 8);
+     *
+     * vector<sync_check_result> results;
+     * pool.check(population, results);
+     * ```
+     *
+     * @tparam T Checker type, constructible as T(builder, tol) and providing
+     *           `is_feasible(x, s, alpha, beta, gamma)` (e.g.
+     *           sync_iterative_checker<ctsp_lb_sync_checker> or
+     *           sync_difference_checker)
+     *
+     * @note The builder must outlive the pool and must not change while
+     *       checking.
+     */
+    template <class T>
+    class checker_pool
+    {
+    protected:
+        vector<unique_ptr<T>> checkers_; ///< One checker per worker thread
+
+    public:
+        /**
+         * @brief Build n_threads checkers from the builder
+         * @param builder Model A builder (shared, read-only)
+         * @param tol Numerical tolerance
+         * @param n_threads Number of workers (0: one per hardware thread)
+         *
+         * Checkers are built one after the other, so the builder is only
+         * read by one thread at a time.
+         */
+        checker_pool(const sync_model_a_builder &builder, const double tol, size_t n_threads)
+        {
+            if (n_threads == 0)
+                n_threads = max(1u, thread::hardware_concurrency());
+
+            checkers_.reserve(n_threads);
+
+            for (size_t t{0}; t < n_threads; t++)
+                checkers_.push_back(unique_ptr<T>(new T(builder, tol)));
+        }
+
+        virtual ~checker_pool(void) {}
+
+        /**
+         * @brief Get number of workers
+         * @return Number of checkers in the pool
+         */
+        inline size_t get_n_threads(void) const { return checkers_.size(); }
+
+        /**
+         * @brief Access checker of a worker
+         * @param t Worker index
+         * @return Checker of worker t (e.g. to set options before check())
+         */
+        inline T &get_checker(const size_t t) { return *checkers_[t]; }
+
+        /**
+         * @brief Check a population of routing vectors in parallel
+         * @param xs Routing vectors (arc variables)
+         * @param[out] results One result per vector, in the order of xs
+         * @return Number of feasible vectors
+         */
+        size_t check(const vector<vector<double>> &xs, vector<sync_check_result> &results)
+        {
+            results.resize(xs.size());
+
+            const size_t n_threads{min(checkers_.size(), xs.size())};
+
+            atomic<size_t> next_x{0};
+
+            vector<thread> workers;
+
+            for (size_t t{1}; t < n_threads; t++)
+            {
+                workers.push_back(thread(&checker_pool::check_worker_, this, t,
+                                         cref(xs), ref(next_x), ref(results)));
+            }
+
+            if (n_threads > 0)
+                check_worker_(0, xs, next_x, results);
+
+            for (thread &worker : workers)
+                worker.join();
+
+            size_t n_feasible{0};
+
+            for (const sync_check_result &result : results)
+            {
+                if (result.feasible_)
+                    n_feasible++;
+            }
+
+            return n_feasible;
+        }
+
+    protected:
+        /**
+         * @brief Worker loop: check vectors until none is left
+         * @param t Worker index (selects the checker)
+         * @param xs Routing vectors
+         * @param next_x Shared counter: next vector to check
+         * @param[out] results Results (each worker writes its own entries)
+         */
+        void check_worker_(const size_t t, const vector<vector<double>> &xs, atomic<size_t> &next_x, vector<sync_check_result> &results)
+        {
+            T &checker{*checkers_[t]};
+
+            const size_t n_xs{xs.size()};
+
+            for (size_t i{next_x++}; i < n_xs; i = next_x++)
+            {
+                GOMA::trace_scope trace("pool_check_x", "checker");
+
+                sync_check_result &result{results[i]};
+
+                result.s_.clear();
+                result.alpha_.clear();
+                result.beta_.clear();
+                result.gamma_.clear();
+
+                result.feasible_ = checker.is_feasible(xs[i], result.s_, result.alpha_, result.beta_, result.gamma_);
+            }
+        }
+    };
+}
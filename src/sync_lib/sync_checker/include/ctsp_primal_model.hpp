@@ -123,10 +123,10 @@ namespace SYNC_LIB
         /**
          * @brief Build constraint matrix for primal model
          * @param builder Model builder
-         * @param M Output: constraint matrix
+         * @param M Output: constraint matrix (compressed sparse column)
          * @param nz Output: number of non-zeros
          */
-        void build_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz);
+        void build_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz);
 
         /**
          * @brief Build α portion of constraint matrix
@@ -134,7 +134,7 @@ namespace SYNC_LIB
          * @param M Output: matrix to populate
          * @param nz Input/Output: non-zero counter
          */
-        void build_alpha_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz);
+        void build_alpha_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz);
         
         /**
          * @brief Build β portion of constraint matrix
@@ -142,7 +142,7 @@ namespace SYNC_LIB
          * @param M Output: matrix to populate
          * @param nz Input/Output: non-zero counter
          */
-        void build_beta_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz);
+        void build_beta_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz);
         
         /**
          * @brief Build γ portion of constraint matrix
@@ -150,7 +150,7 @@ namespace SYNC_LIB
          * @param M Output: matrix to populate
          * @param nz Input/Output: non-zero counter
          */
-        void build_gamma_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz);
+        void build_gamma_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz);
 
         /**
          * @brief Set variable names for debugging
@@ -167,6 +167,8 @@ namespace SYNC_LIB
         /**
          * @brief Initialize model structure
          * @param builder Model builder
+         *
+         * Labels are set only if GOMA::model_description::get_labels()
          */
         void init_model_(const sync_model_a_builder &builder);
 
@@ -3,8 +3,14 @@
 #include "model_description.hpp"
 #include "sync_checker_solver.hpp"
 #include "sync_model_a_builder.hpp"
+#include "sync_model_snapshot.hpp"
+#include "lp_basis_cache.hpp"
+#include "sparse_x.hpp"
+#include "array_view.hpp"
+#include "search_deadline.hpp"
 
 #include <vector>
+#include <memory>
 #include <cmath>
 
 using namespace std;
@@ -66,17 +72,12 @@ namespace SYNC_LIB
 
         size_t n_col_;              ///< Number of columns (variables) in LP
 
-        double *routing_arc_resources_;   ///< Travel times for routing arcs
-        double *operations_resources_;    ///< Service times for operations
+        /// Arcs, adjacency lists and travel times, shared with the other checkers of the model
+        shared_ptr<const sync_model_snapshot> model_;
+        const double *routing_arc_resources_;   ///< Travel times for routing arcs (in model_)
 
         double max_distance_;       ///< Maximum route duration
 
-        vector<vector<int>> routing_outbound_arcs_;  ///< Outbound arcs per operation
-        vector<vector<int>> routing_inbound_arcs_;   ///< Inbound arcs per operation
-        vector<int> operation_2_customer_;           ///< Maps operation to customer
-        vector<triplet> routing_arcs_;               ///< List of routing arcs
-        pair_map routing_arcs_pair_map_;             ///< Maps arc pairs to indices
-
         int *col_inx_;      ///< Column indices for sparse matrix updates
         int *row_inx_;      ///< Row indices for sparse matrix updates
         double *coef_val_;  ///< Coefficient values for sparse updates
@@ -85,6 +86,29 @@ namespace SYNC_LIB
         double *alpha_;     ///< Buffer for dual variable values
         double *s_;         ///< Buffer for slack variable values
 
+        vector<double> x_;              ///< Routing solution loaded in the LP (truncated values)
+        vector<int> changed_arcs_;      ///< Scratch: arcs that differ from x_
+        vector<double> changed_values_; ///< Scratch: new values of changed_arcs_
+        vector<int> support_;           ///< Arcs with x_ nonzero, increasing (if support_valid_)
+        bool support_valid_;            ///< support_ matches x_ (dense loads and update_x reset it)
+
+        lp_basis_cache *basis_cache_;   ///< Optional cache of final bases (not owned)
+        vector<int> active_;            ///< Active arcs of the x being checked (with basis_cache_)
+        vector<int> col_stat_;          ///< Scratch: column statuses of a basis
+        vector<int> row_stat_;          ///< Scratch: row statuses of a basis
+        size_t n_basis_restores_;       ///< Solves started from a cached basis
+
+        bool feasibility_only_;         ///< Stop each solve at the first certificate
+        size_t n_early_stops_;          ///< Solves stopped by the objective cutoff
+
+        vector<int> obj_rows_;          ///< Scratch: operation rows of a start time objective
+        vector<double> obj_rhs_;        ///< Scratch: their right-hand sides
+        size_t n_objective_solves_;     ///< Re-solves with a start time objective
+
+        const GOMA::search_deadline *deadline_; ///< Stop token of the checks (not owned, NULL: none)
+        bool time_limited_;             ///< The solver has a time limit from deadline_
+        bool truncated_;                ///< The last check was stopped by the deadline
+
     protected:
         size_t n_alpha_var_;     ///< Number of α variables
         size_t n_beta_var_;      ///< Number of β variables
@@ -142,6 +166,141 @@ namespace SYNC_LIB
          */
         bool is_feasible_(const vector<double> &x, double &obj_val);
 
+        /**
+         * @brief Check a routing solution given by its nonzero entries
+         * @param x Routing solution (sparse)
+         * @return true if synchronization is feasible
+         *
+         * Same answer as is_feasible_(dense x). After the first load, the
+         * arcs that changed are found by merging the support of x with the
+         * loaded one, so the work of the load (and of the basis cache
+         * lookup) is O(support) rather than a pass over every routing arc.
+         */
+        bool is_feasible_(const sparse_x &x);
+
+        /**
+         * @brief Check feasibility after changing a few arcs of the last solution
+         * @param changed_arcs Routing arc indices that changed
+         * @param new_values New values of the changed arcs
+         * @return true if synchronization is feasible
+         *
+         * Equivalent to is_feasible_(x) with x the last solution updated by
+         * update_x(), but only the affected LP entries are touched and the
+         * solve starts from the previous basis.
+         */
+        bool is_feasible_(const vector<int> &changed_arcs, const vector<double> &new_values);
+
+        /**
+         * @brief Change a few arcs of the routing solution loaded in the LP
+         * @param changed_arcs Routing arc indices that changed
+         * @param new_values New values of the changed arcs
+         *
+         * Only the objective entries and coefficients of the changed α/β
+         * columns are updated. Requires a previous full load (is_feasible_(x)).
+         */
+        void update_x(const vector<int> &changed_arcs, const vector<double> &new_values);
+
+        /**
+         * @brief Reload the synchronization arc times of the builder
+         * @param builder Model A builder (after set_time_windows_max_size)
+         *
+         * Only the objective entries of the γ columns change, so the basis
+         * of the last solve stays primal feasible and the next check warm
+         * starts from it. The loaded routing is kept.
+         */
+        void update_sync_arc_times(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Warm start full checks from a basis cache
+         * @param cache Basis cache (not owned, NULL to disable)
+         *
+         * Before is_feasible_(x), the cached basis whose active arc set is
+         * closest to that of x is loaded, if it is closer than the routing
+         * of the previous check (whose basis the solver keeps). The final
+         * basis is stored under the active arc set of x. Incremental checks
+         * (changed arcs) keep using the previous basis.
+         */
+        inline void set_basis_cache(lp_basis_cache *cache) { basis_cache_ = cache; }
+
+        /**
+         * @brief Get number of solves started from a cached basis
+         * @return Cached bases loaded since construction
+         */
+        inline size_t get_n_basis_restores(void) const { return n_basis_restores_; }
+
+        /**
+         * @brief Answer checks without solving the LP to optimality
+         * @param feasibility_only true to stop at the first infeasibility certificate
+         *
+         * x is infeasible iff the LP optimum is below -0.001. With an
+         * objective cutoff at that threshold the simplex stops at the first
+         * feasible α/β/γ below it, which is a valid (not necessarily the
+         * most violated) certificate. Feasible checks still solve to
+         * optimality, so their start times are unchanged. Backends without
+         * an objective limit (HiGHS) ignore it.
+         */
+        void set_feasibility_only(const bool feasibility_only);
+
+        inline bool get_feasibility_only(void) const { return feasibility_only_; }
+
+        /**
+         * @brief Get number of solves stopped by the objective cutoff
+         * @return Early stops since construction
+         */
+        inline size_t get_n_early_stops(void) const { return n_early_stops_; }
+
+        /**
+         * @brief Optimize the start times of the last feasible check
+         * @param weights Weight of each operation's start time (sum 0)
+         * @return true if s_ now holds a schedule minimizing Σ weights_i s_i,
+         *         false if the re-solve did not reach optimality (s_ keeps
+         *         the feasibility schedule)
+         * @throw std::invalid_argument If weights has not one entry per
+         *        operation or does not sum to 0 (start times are only
+         *        defined up to a shift)
+         *
+         * The LP is the dual of the start time model: an objective on the
+         * start times is the right-hand side of the operation rows. Only
+         * those entries change, so the optimal basis of the check stays dual
+         * feasible and the re-solve takes a few pivots. Since the dual
+         * variables are bounded by 1 (the violation penalty), the weights
+         * are scaled to a total positive weight of 0.5: the schedule stays
+         * feasible. The right-hand sides, the objective cutoff and the basis
+         * of the check are restored afterwards. Call it right after a
+         * feasible full check (is_feasible_(x) or an incremental one).
+         */
+        bool optimize_s(const vector<double> &weights);
+
+        /**
+         * @brief Get number of re-solves with a start time objective
+         * @return optimize_s() solves since construction
+         */
+        inline size_t get_n_objective_solves(void) const { return n_objective_solves_; }
+
+        /**
+         * @brief Bound the checks by a deadline
+         * @param deadline Stop token (not owned, NULL to disable)
+         *
+         * Before each solve, the time left becomes the time limit of the
+         * LP. A check whose deadline expires (before or during the solve)
+         * is not answered: it returns false with is_truncated() set and an
+         * all-zero certificate. A cancellation is only seen before the
+         * solve; set_interrupt() stops a running one (also truncated).
+         */
+        inline void set_deadline(const GOMA::search_deadline *deadline) { deadline_ = deadline; }
+
+        /**
+         * @brief Check if the last check was stopped by the deadline
+         * @return true if its false answer is no proof of infeasibility
+         */
+        inline bool is_truncated(void) const { return truncated_; }
+
+        /**
+         * @brief Fingerprint of the instance (LP size, arcs and travel times)
+         * @return Key to bind an lp_basis_cache to this model
+         */
+        size_t get_instance_key(void) const;
+
         /**
          * @brief Check feasibility and extract dual variables
          * @param x Routing solution
@@ -172,6 +331,19 @@ namespace SYNC_LIB
          */
         void get_s(vector<double> &s) const;
 
+        /**
+         * @name Zero-copy views of the last solve
+         * Read the solver output in place, without the copies of
+         * get_alpha_beta_gamma() / get_s(). Views stay valid until the
+         * next check (or set()) of this checker.
+         * @{
+         */
+        inline GOMA::array_view<double> get_alpha_view(void) const { return GOMA::array_view<double>(alpha_ + base_alpha_var_, n_alpha_var_); }
+        inline GOMA::array_view<double> get_beta_view(void) const { return GOMA::array_view<double>(alpha_ + base_beta_var_, n_beta_var_); }
+        inline GOMA::array_view<double> get_gamma_view(void) const { return GOMA::array_view<double>(alpha_ + base_gamma_var_, n_gamma_var_); }
+        inline GOMA::array_view<double> get_s_view(void) const { return GOMA::array_view<double>(s_, n_operations_); }
+        /** @} */
+
     protected:
         /**
          * @brief Check feasibility without updating RHS (uses current state)
@@ -186,9 +358,24 @@ namespace SYNC_LIB
          */
         bool is_feasible_(double &obj_val);
 
+        /**
+         * @brief Map the deadline to the time limit of the next solve
+         * @return false if the deadline has already expired (truncated_ set)
+         */
+        bool limit_time_(void);
+
+        /**
+         * @brief Keep the answer of the last solve in alpha_ (certificate) or s_ (start times)
+         * @param feasible Answer of the solve
+         */
+        void keep_solution_(bool feasible);
+
         /**
          * @brief Write current LP model to file for debugging
          * @param filename Output file path
+         *
+         * Rows and columns are named only if labels were enabled
+         * (GOMA::model_description::set_labels) before the checker was built.
          */
         void write(const char *filename) const;
 
@@ -211,50 +398,102 @@ namespace SYNC_LIB
         /**
          * @brief Compute number of constraints (pure virtual, implemented in derived classes)
          * @param builder Model builder
+         *
+         * Called once per set(); the per-check code dispatches on the
+         * resulting families through the *_t_ templates.
          */
         virtual void compute_constraints_number_(const sync_model_a_builder &builder) = 0;
 
         /**
-         * @brief Convert routing solution x to LP constraint coefficients
+         * @brief Load routing solution x in the LP
          * @param x Routing solution
+         *
+         * The first call (or a size change) rewrites every objective entry and
+         * coefficient. Later calls only update the arcs that differ from x_.
          */
-        void x_2_coef_(const vector<double> &x);
-        
+        void load_x_(const vector<double> &x);
+
+        /**
+         * @brief Load a sparse routing solution in the LP
+         * @param x Routing solution (sparse)
+         *
+         * Updates the arcs of the support of x or of the loaded solution
+         * whose value differs (update_x).
+         */
+        void load_x_(const sparse_x &x);
+
+        /**
+         * @brief Rebuild support_ from x_ if a dense load or update_x changed it
+         */
+        void load_support_(void);
+
         /**
-         * @brief Build α constraint coefficients from solution x
+         * @brief Load the nearest cached basis before checking x
+         * @param x Routing solution (not loaded yet)
+         *
+         * Computes active_. Does nothing without a basis cache.
+         */
+        void restore_basis_(const vector<double> &x);
+
+        /**
+         * @brief restore_basis_ for a sparse routing solution
+         * @param x Routing solution (not loaded yet)
+         */
+        void restore_basis_(const sparse_x &x);
+
+        /**
+         * @brief Store the final basis of the last solve under active_
+         */
+        void store_basis_(void);
+
+        /**
+         * @brief Value of x_ij as seen by the LP
+         * @param val Routing variable value
+         * @return 0 under tolerance, truncated value otherwise
+         */
+        inline double x_val_(const double val) const { return fabs(val) > tol_ ? truncate_(val) : 0.0; }
+
+        /**
+         * @brief Convert routing solution x to LP constraint coefficients
          * @param x Routing solution
-         * @param row_i Row index
-         * @param nz Number of non-zeros
+         *
+         * Picks the x_2_coef_t_ instance of the constraint families of the
+         * model once, instead of testing them for every row.
          */
-        void x_2_alpha_coef_(const vector<double> &x, const size_t row_i, int &nz);
-        
+        void x_2_coef_(const vector<double> &x);
+
         /**
-         * @brief Build β constraint coefficients from solution x
+         * @brief Constraint coefficients of x for fixed constraint families
+         * @tparam ALPHA Whether the model has α variables
+         * @tparam BETA Whether the model has β variables
          * @param x Routing solution
-         * @param row_i Row index
-         * @param nz Number of non-zeros
+         *
+         * The family tests are compile-time constants, so the loops over the
+         * adjacency lists have no family branch.
          */
-        void x_2_beta_coef_(const vector<double> &x, const size_t row_i, int &nz);
+        template <bool ALPHA, bool BETA>
+        void x_2_coef_t_(const vector<double> &x);
 
         /**
          * @brief Convert routing solution x to LP objective coefficients
          * @param x Routing solution
          */
         void x_2_obj_(const vector<double> &x);
-        
+
         /**
-         * @brief Build α objective coefficients from solution x
+         * @brief Objective coefficients of x for fixed constraint families (see x_2_coef_t_)
          * @param x Routing solution
-         * @param nz Number of non-zeros
          */
-        void x_2_alpha_obj_(const vector<double> &x, int &nz);
-        
+        template <bool ALPHA, bool BETA>
+        void x_2_obj_t_(const vector<double> &x);
+
         /**
-         * @brief Build β objective coefficients from solution x
-         * @param x Routing solution
-         * @param nz Number of non-zeros
+         * @brief update_x for fixed constraint families (see x_2_coef_t_)
+         * @param changed_arcs Routing arcs whose value changes (not empty)
+         * @param new_values New value of each changed arc
          */
-        void x_2_beta_obj_(const vector<double> &x, int &nz);
+        template <bool ALPHA, bool BETA>
+        void update_x_t_(const vector<int> &changed_arcs, const vector<double> &new_values);
 
         /**
          * @brief Truncate value to specified precision
@@ -0,0 +1,163 @@
+/**
+ * @file lp_basis_cache.hpp
+ * @brief Cache of final LP bases keyed by the active routing arc set
+ *
+ * The checker LP of ctsp_sync_checker only depends on x through the α/β
+ * columns of the active arcs (x_ij > 0). Routings that share most of their
+ * arcs have close optimal bases, so a basis stored for one of them is a good
+ * starting point for the others, even when the previous check (whose basis
+ * the LP solver keeps) was a very different routing.
+ *
+ * Entries are keyed by the sorted active arc set. find_nearest() returns the
+ * entry with the smallest symmetric difference to a given set. The cache is
+ * bound to one instance (instance key) and can be saved to / loaded from a
+ * file between runs.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @struct active_set_hash
+     * @brief Hash of a sorted active arc set (boost::hash_combine mixing step)
+     */
+    struct active_set_hash
+    {
+        size_t operator()(const vector<int> &active) const
+        {
+            size_t seed{active.size()};
+
+            for (const int arc : active)
+                seed ^= hash<int>()(arc) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+            return seed;
+        }
+    };
+
+    /**
+     * @class cached_basis
+     * @brief One final basis with the active arc set it was computed for
+     */
+    class cached_basis
+    {
+    public:
+        vector<int> active_;   ///< Sorted active routing arcs
+        vector<int> col_stat_; ///< GOMA::BasisStat of each LP column
+        vector<int> row_stat_; ///< GOMA::BasisStat of each LP row
+        size_t last_use_;      ///< Clock of the last store or lookup hit
+
+        cached_basis(void) : active_(), col_stat_(), row_stat_(), last_use_(0) {}
+
+        virtual ~cached_basis(void) {}
+    };
+
+    /**
+     * @class lp_basis_cache
+     * @brief Bounded LRU cache of LP bases with nearest active set lookup
+     *
+     * ```cpp
+     * lp_basis_cache cache(checker.get_instance_key(), 64);
+     * cache.load("bayg29.basis");      // false (ignored) if missing or another instance
+     *
+     * checker.set_basis_cache(&cache); // full checks warm start from the nearest entry
+     * // ... checks ...
+     *
+     * cache.save("bayg29.basis");
+     * ```
+     */
+    class lp_basis_cache
+    {
+    protected:
+        size_t instance_key_; ///< Fingerprint of the instance the bases belong to
+        size_t capacity_;     ///< Maximum number of entries (least recently used evicted)
+        size_t clock_;        ///< Logical time for LRU eviction
+
+        vector<cached_basis> entries_;                                ///< Cached bases
+        unordered_map<vector<int>, size_t, active_set_hash> index_; ///< Active set → entry
+
+        size_t n_lookups_;    ///< Calls to find_nearest()
+        size_t n_exact_hits_; ///< Lookups answered by the same active set
+        size_t n_near_hits_;  ///< Lookups answered by a different, closer set
+
+    public:
+        /**
+         * @brief Construct an empty cache
+         * @param instance_key Instance fingerprint (ctsp_sync_checker::get_instance_key())
+         * @param capacity Maximum number of bases (at least 1)
+         */
+        lp_basis_cache(size_t instance_key = 0, size_t capacity = 64);
+
+        virtual ~lp_basis_cache(void);
+
+        /**
+         * @brief Find the cached basis closest to an active arc set
+         * @param active Sorted active routing arcs
+         * @param max_distance Only entries at distance < max_distance are returned
+         * @param distance Output: symmetric difference to the returned entry
+         * @return Closest entry, or NULL if none is close enough
+         */
+        const cached_basis *find_nearest(const vector<int> &active, size_t max_distance, size_t &distance);
+
+        /**
+         * @brief Store (or refresh) the basis of an active arc set
+         * @param active Sorted active routing arcs
+         * @param col_stat Column statuses
+         * @param row_stat Row statuses
+         */
+        void store(const vector<int> &active, const vector<int> &col_stat, const vector<int> &row_stat);
+
+        /**
+         * @brief Write the cache to a file
+         * @param filename Output file
+         * @return false if the file cannot be written
+         */
+        bool save(const string &filename) const;
+
+        /**
+         * @brief Add the bases of a file written by save()
+         * @param filename Input file
+         * @return false if the file is missing, malformed or of another instance
+         */
+        bool load(const string &filename);
+
+        /**
+         * @brief Remove every entry and reset the statistics
+         */
+        void clear(void);
+
+        /**
+         * @brief Symmetric difference of two sorted arc sets
+         * @param a First set
+         * @param b Second set
+         * @param bound Stop counting at this value
+         * @return |a Δ b|, or bound if it is at least bound
+         */
+        static size_t distance(const vector<int> &a, const vector<int> &b, size_t bound);
+
+        inline size_t size(void) const { return entries_.size(); }
+        inline bool empty(void) const { return entries_.empty(); }
+        inline size_t get_capacity(void) const { return capacity_; }
+        inline size_t get_instance_key(void) const { return instance_key_; }
+        inline void set_instance_key(const size_t instance_key) { instance_key_ = instance_key; }
+        inline size_t get_n_lookups(void) const { return n_lookups_; }
+        inline size_t get_n_exact_hits(void) const { return n_exact_hits_; }
+        inline size_t get_n_near_hits(void) const { return n_near_hits_; }
+
+    protected:
+        /**
+         * @brief Read one status line of a cache file
+         * @param is Input stream
+         * @param stat Output: statuses
+         * @return false if the line is malformed
+         */
+        static bool read_stats_(istream &is, vector<int> &stat);
+    };
+}
@@ -0,0 +1,206 @@
+/**
+ * @file sync_batch_checker.hpp
+ * @brief Feasibility of several integral routings at once, lane by lane
+ *
+ * A population step or a neighbourhood scan checks many routings of the
+ * same model. sync_difference_checker answers them one after the other;
+ * the synchronization arcs, the largest part of the constraint graph, are
+ * the same for all of them.
+ *
+ * sync_batch_checker checks up to n_lanes routings together. The potentials
+ * are stored in structure-of-arrays layout: the n_lanes values of an
+ * operation are contiguous, one register with AVX-512 (two with AVX2). A
+ * Bellman-Ford round visits every operation once and lowers its potentials
+ * in every lane at the same time:
+ *
+ * - synchronization edges j → i are shared: one vertical min of
+ *   dist(j) + w over the lanes;
+ * - in an integral routing an operation i has at most one routing arc
+ *   (i, j), hence one routing edge j → i per lane: its tail is gathered
+ *   lane by lane (the operation itself, at cost 0, if not routed).
+ *
+ * A lane whose potentials do not change during a round is feasible. The
+ * operation that last lowered each potential is kept lane by lane as well
+ * (blended with the min): every few rounds the predecessor graph of each
+ * lane still changing is searched for a cycle, which is negative, as in
+ * sync_difference_checker. A lane still changing after n_operations + 1
+ * rounds has a negative cycle too. Lanes that are not settled after
+ * get_max_rounds() rounds, and routings that are not routes (an operation
+ * with two active arcs), are checked by a sync_difference_checker, so the
+ * answer is exact.
+ */
+
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+#include "sync_difference_checker.hpp"
+#include "sync_model_snapshot.hpp"
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_batch_checker
+     * @brief Lane-parallel negative cycle checker for integral routings
+     *
+     * ```cpp
+     * sync_batch_checker checker(builder, 1e-6);
+     *
+     * vector<char> feasible;
+     * checker.check(population, feasible);   // any number of x, n_lanes at a time
+     *
+     * const uint32_t bits{checker.check_lanes(xs, 8)};  // bit l: xs[l] feasible
+     * ```
+     *
+     * Same answer as sync_difference_checker::is_feasible_() (x integral,
+     * a routing arc active when x_ij ≥ 1 - tol), without start times or
+     * certificates: check the routings of interest again with
+     * sync_difference_checker for them. One checker per thread.
+     */
+    class sync_batch_checker
+    {
+    public:
+        static constexpr size_t n_lanes = 8; ///< Routings checked together
+
+    protected:
+        /**
+         * @struct lane_values
+         * @brief Values of one operation in every lane
+         */
+        struct alignas(64) lane_values
+        {
+            double v_[n_lanes];
+        };
+
+        /**
+         * @struct lane_indices
+         * @brief Gather indices of one operation in every lane
+         */
+        struct alignas(32) lane_indices
+        {
+            int32_t v_[n_lanes];
+        };
+
+        double tol_;             ///< Numerical tolerance for active arcs
+        const double precision_; ///< Precision for value truncation (1E3)
+
+        size_t n_operations_;   ///< Operations (graph vertices)
+        size_t n_routing_arcs_; ///< Routing arcs
+
+        shared_ptr<const sync_model_snapshot> model_; ///< Routing and sync arcs (i, j), shared
+        vector<double> routing_arc_cost_;             ///< Edge j → i cost: -t_ij
+
+        // Synchronization edges, shared by the lanes, grouped by head
+        vector<int> sync_head_;    ///< CSR offsets (n_operations + 1)
+        vector<int> sync_from_;    ///< Tail of each edge
+        vector<double> sync_cost_; ///< Cost of each edge (as sync_difference_checker)
+
+        // Lanes (structure of arrays)
+        vector<lane_values> dist_;    ///< Potentials
+        vector<lane_values> pred_;    ///< Operation that last lowered each potential (-1 if none)
+        vector<lane_indices> succ_;   ///< Element of dist_ pulled along the routing edge (the operation itself if none)
+        vector<lane_values> tail_;    ///< Tail operation of the routing edge
+        vector<lane_values> cost_;    ///< Cost of the routing edge (0 if none)
+        vector<char> mark_;           ///< Scratch marks for predecessor cycle search
+
+        size_t max_rounds_;  ///< Rounds before unsettled lanes go to fallback_
+        size_t cycle_check_; ///< Rounds between two predecessor cycle searches
+
+        sync_difference_checker fallback_; ///< Exact check of the lanes not settled
+
+        size_t n_checks_;    ///< Routings checked
+        size_t n_rounds_;    ///< Bellman-Ford rounds
+        size_t n_fallbacks_; ///< Routings checked by fallback_
+
+    public:
+        /**
+         * @brief Construct batch checker
+         * @param builder Model A builder containing problem structure
+         * @param tol Numerical tolerance
+         */
+        sync_batch_checker(const sync_model_a_builder &builder, double tol);
+
+        virtual ~sync_batch_checker(void);
+
+        /**
+         * @brief Reload the synchronization arc times of the builder
+         * @param builder Model A builder (after set_time_windows_max_size)
+         */
+        void update_sync_arc_times(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Check up to n_lanes routings together
+         * @param xs Routing solutions (arc variables)
+         * @param n Number of routings (≤ n_lanes)
+         * @return Bit l set if xs[l] is feasible
+         */
+        uint32_t check_lanes(const vector<double> *const *xs, size_t n);
+
+        /**
+         * @brief Check a population, n_lanes routings at a time
+         * @param xs Routing solutions
+         * @param feasible Output: 1 if xs[i] is feasible, 0 otherwise
+         * @return Number of feasible routings
+         */
+        size_t check(const vector<vector<double>> &xs, vector<char> &feasible);
+
+        /**
+         * @brief Set the round budget of the lanes
+         * @param max_rounds Rounds before the routings still changing are
+         *        checked one by one (default, or n_operations + 1 or more:
+         *        none are)
+         */
+        inline void set_max_rounds(const size_t max_rounds) { max_rounds_ = max_rounds; }
+
+        inline size_t get_max_rounds(void) const { return max_rounds_; }
+        inline size_t get_n_checks(void) const { return n_checks_; }
+        inline size_t get_n_rounds(void) const { return n_rounds_; }
+        inline size_t get_n_fallbacks(void) const { return n_fallbacks_; }
+
+        /**
+         * @brief Heap bytes held by the lanes and the shared edges
+         */
+        size_t get_memory_bytes(void) const;
+
+    protected:
+        /**
+         * @brief Set the routing edges of the lanes
+         * @param xs Routing solutions
+         * @param n Number of routings
+         * @return Bit l set if xs[l] is not a routing (sent to fallback_)
+         */
+        uint32_t load_lanes_(const vector<double> *const *xs, size_t n);
+
+        /**
+         * @brief One Bellman-Ford round over every operation
+         * @param forward Visit the operations in increasing order
+         * @return Bit l set if a potential of lane l was lowered
+         */
+        uint32_t round_(bool forward);
+
+        /**
+         * @brief Lower the potentials of an operation in every lane
+         * @param i Operation
+         * @return Bit l set if lowered in lane l
+         */
+        uint32_t relax_(int i);
+
+        /**
+         * @brief Look for a cycle in the predecessor graph of a lane
+         * @param l Lane
+         * @return true if there is one (a negative cycle)
+         */
+        bool has_pred_cycle_(size_t l);
+
+        /**
+         * @brief Truncate value to specified precision
+         */
+        inline double truncate_(const double val) const { return round(val * precision_) / precision_; }
+    };
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "model_description.hpp"
+#include "sync_model_a_builder.hpp"
+#include "search_deadline.hpp"
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+
+using namespace std;
+
+/**
+ * @file sync_component_checker.hpp
+ * @brief LP synchronization checker solving one small LP per component
+ *
+ * The LP of ctsp_lb_sync_checker (ctsp_lb_dual_primal_model) has one row
+ * per operation and one column per routing arc (α) and sync arc (γ):
+ *
+ * - α_ij: coefficient x_ij in row i, -1 in row j, cost -t_ij x_ij
+ * - γ_ij: coefficient 1 in row i, -1 in row j, cost w_ij
+ *
+ * For a given x, rows i and j only share a column through a sync arc or a
+ * routing arc with x_ij > 0 (an α column with x_ij = 0 only touches row j).
+ * The LP is therefore block diagonal over the connected components of the
+ * support graph (operations, active routing arcs and sync arcs), and its
+ * optimum is the sum of the optima of the component LPs.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_component_checker
+     * @brief Component-wise LP synchronization checker
+     *
+     * Exposes the `is_feasible(x, s, alpha, beta, gamma)` contract of
+     * sync_iterative_checker<ctsp_lb_sync_checker>:
+     *
+     * 1. Find the connected components of the support graph of x (union-find)
+     * 2. Build the dual LP restricted to each component, with x already set
+     *    in the objective and the α coefficients
+     * 3. Solve the component LPs on n_threads workers (one LP solver per
+     *   component, single-operation components need no LP)
+     * 4. Stitch the results: s is the union of the component start times;
+     *    alpha/gamma hold the LP values of the infeasible components and 0
+     *    elsewhere, an optimal solution of the full LP. beta is not used (the
+     *    lower bound model has no β rows) and is left untouched.
+     *
+     * `x` is feasible iff every component LP has objective > -0.001, the
+     * threshold of ctsp_sync_checker.
+     *
+     * @note The component LPs are rebuilt on every call, since the
+     *       components depend on x. For one big component (e.g. an integral
+     *       CTSP2 routing where every day shares customers) the full
+     *       ctsp_lb_sync_checker, which only updates the changed arcs, is
+     *       faster.
+     */
+    class sync_component_checker
+    {
+    protected:
+        const double tol_;        ///< Numerical tolerance for active arcs
+        const double precision_;  ///< Precision for value truncation (1E3)
+
+        const size_t n_operations_;   ///< Total number of operations (LP rows)
+        const size_t n_routing_arcs_; ///< Number of routing arcs (α columns)
+        const size_t n_sync_arcs_;    ///< Number of synchronization arcs (γ columns)
+
+        const vector<triplet> &routing_arcs_;      ///< Routing arcs (i, j)
+        const vector<double> &routing_arc_times_;  ///< Travel times t_ij
+        const vector<triplet> &sync_arcs_;         ///< Sync arcs (i, j)
+        const vector<double> &sync_arc_times_;     ///< Sync offsets w_ij
+        const sync_model_a_builder &builder_;      ///< Model (arc names, only read for labels)
+        const vector<string> &operation_names_;    ///< Operation names (row labels)
+
+        size_t n_threads_;        ///< LP workers (0: one per hardware thread)
+        bool feasibility_only_;   ///< Stop each component LP at the first certificate
+
+        const GOMA::search_deadline *deadline_; ///< Stop token of the checks (not owned, NULL: none)
+        atomic<bool> truncated_;                ///< The last check skipped components
+
+        vector<double> x_;        ///< Routing solution as seen by the LP (truncated values)
+
+        vector<int> parent_;      ///< Union-find forest over operations
+        vector<int> component_;   ///< Component of each operation
+        vector<int> local_row_;   ///< Row of each operation in its component LP
+
+        vector<vector<int>> component_operations_;   ///< Operations of each component
+        vector<vector<int>> component_routing_arcs_; ///< Routing arcs of each component (by head)
+        vector<vector<int>> component_sync_arcs_;    ///< Sync arcs of each component
+
+        vector<char> feasible_;             ///< Result of each component LP
+        vector<vector<double>> s_;          ///< Start times of each component (LP duals)
+        vector<vector<double>> y_;          ///< α/γ values of each infeasible component
+
+        size_t n_lps_;            ///< Component LPs solved in the last call
+
+    public:
+        /**
+         * @brief Construct component checker
+         * @param builder Model A builder containing problem structure (must outlive the checker)
+         * @param tol Numerical tolerance
+         * @param n_threads LP workers (0: one per hardware thread, 1: serial)
+         */
+        sync_component_checker(const sync_model_a_builder &builder, double tol, size_t n_threads = 1);
+
+        virtual ~sync_component_checker(void);
+
+        /**
+         * @brief Set number of LP workers
+         * @param n_threads 0: one per hardware thread, 1: serial
+         */
+        inline void set_n_threads(const size_t n_threads) { n_threads_ = n_threads; }
+
+        /**
+         * @brief Stop infeasible component LPs at the first certificate
+         * @param feasibility_only See ctsp_sync_checker::set_feasibility_only()
+         */
+        inline void set_feasibility_only(const bool feasibility_only) { feasibility_only_ = feasibility_only; }
+
+        /**
+         * @brief Bound the checks by a deadline
+         * @param deadline Stop token (not owned, NULL to disable)
+         *
+         * The workers poll it before each component LP: once it expires,
+         * the remaining components are skipped and the check returns false
+         * with is_truncated() set (no answer). A component LP already
+         * running is finished.
+         */
+        inline void set_deadline(const GOMA::search_deadline *deadline) { deadline_ = deadline; }
+
+        /**
+         * @brief Check if the last check was stopped by the deadline
+         * @return true if its false answer is no proof of infeasibility
+         */
+        inline bool is_truncated(void) const { return truncated_.load(memory_order_relaxed); }
+
+        /**
+         * @brief Check feasibility (components, LPs and stitching)
+         * @param x Routing solution (arc variables)
+         * @return true if every component is feasible
+         */
+        bool is_feasible_(const vector<double> &x);
+
+        /**
+         * @brief Check feasibility and extract dual variables if infeasible
+         * @param x Routing solution
+         * @param alpha Output: α values (if infeasible)
+         * @param beta Output: β values, not used
+         * @param gamma Output: γ values (if infeasible)
+         * @return true if feasible
+         */
+        bool is_feasible(const vector<double> &x, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Check feasibility and extract start times or dual variables
+         * @param x Routing solution
+         * @param s Output: start times (if feasible)
+         * @param alpha Output: α values (if infeasible)
+         * @param beta Output: β values, not used
+         * @param gamma Output: γ values (if infeasible)
+         * @return true if feasible
+         */
+        bool is_feasible(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Stitched α/γ values of the last check
+         * @param alpha Output: α values (n_routing_arcs)
+         * @param beta Output: β values, not used
+         * @param gamma Output: γ values (n_sync_arcs)
+         */
+        void get_alpha_beta_gamma(vector<double> &alpha, vector<double> &beta, vector<double> &gamma) const;
+
+        /**
+         * @brief Stitched start times of the last check
+         * @param s Output: start time of each operation
+         */
+        void get_s(vector<double> &s) const;
+
+        /**
+         * @brief Get number of components of the last check
+         * @return Number of connected components of the support graph
+         */
+        inline size_t get_n_components(void) const { return component_operations_.size(); }
+
+        /**
+         * @brief Get number of LPs solved in the last check
+         * @return Components with more than one operation
+         */
+        inline size_t get_n_lps(void) const { return n_lps_; }
+
+        /**
+         * @brief Get component of each operation of the last check
+         * @return Component index per operation
+         */
+        inline const vector<int> &get_components(void) const { return component_; }
+
+    protected:
+        /**
+         * @brief Union-find root of an operation (path halving)
+         * @param i Operation
+         * @return Root of the tree of i
+         */
+        int find_(int i);
+
+        /**
+         * @brief Compute the components of the support graph of x_
+         *
+         * Fills component_, local_row_ and the operations and arcs of each
+         * component.
+         */
+        void find_components_(void);
+
+        /**
+         * @brief Build the dual LP of one component
+         * @param k Component index
+         * @param model Output: LP (rows: operations, columns: α then γ)
+         */
+        void build_model_(size_t k, GOMA::model_description &model) const;
+
+        /**
+         * @brief Build and solve the LP of one component
+         * @param k Component index
+         */
+        void solve_component_(size_t k);
+
+        /**
+         * @brief Worker loop: solve components until none is left
+         * @param next_k Shared counter: next component to solve
+         */
+        void solve_worker_(atomic<size_t> &next_k);
+
+        /**
+         * @brief Value of x_ij as seen by the LP
+         * @param val Routing variable value
+         * @return 0 under tolerance, truncated value otherwise
+         */
+        inline double x_val_(const double val) const { return fabs(val) > tol_ ? truncate_(val) : 0.0; }
+
+        /**
+         * @brief Truncate value to specified precision
+         * @param val Input value
+         * @return Truncated value
+         */
+        inline double truncate_(const double val) const { return round(val * precision_) / precision_; }
+    };
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+#include "sync_model_snapshot.hpp"
+#include "sparse_x.hpp"
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @file sync_difference_checker.hpp
+ * @brief Combinatorial synchronization checker for integral routings
+ *
+ * For an integral routing vector x, the system checked by
+ * ctsp_lb_sync_checker is a system of difference constraints:
+ *
+ * - α (routing arc (i,j) with x_ij = 1):  s_i - s_j ≤ -t_ij
+ * - γ (sync arc (i,j)):                   s_i - s_j ≤ w_ij
+ *
+ * It is feasible iff the constraint graph (edge j → i with cost c for every
+ * constraint s_i - s_j ≤ c) has no negative cycle. This file provides a
+ * Bellman-Ford (SPFA) checker that answers the same question as the LP
+ * checker without calling CPLEX/CLP.
+ *
+ * Costs are truncated to 1/precision_ as in the LP checkers, so they are
+ * integers in some unit: the time unit when every cost is integral (TSPLIB
+ * nint distances, integral maximum allowable differential), 1/precision_
+ * otherwise. The search runs on integer potentials in that unit: decisions
+ * are exact, with no tolerance, and 32-bit potentials halve the memory
+ * traffic of the double ones whenever the costs of the routing allow them.
+ */
+
+namespace SYNC_LIB
+{
+    /**
+     * @enum potential_type
+     * @brief Arithmetic of the shortest path potentials
+     */
+    enum class potential_type
+    {
+        DOUBLE, ///< Time units, comparisons within 0.5/precision
+        INT32,  ///< Integer cost units, 32 bits
+        INT64   ///< Integer cost units, 64 bits (sums too large for 32 bits)
+    };
+
+    /**
+     * @class sync_difference_checker
+     * @brief Negative-cycle based synchronization checker
+     *
+     * Exposes the same `is_feasible(x, s, alpha, beta, gamma)` contract as
+     * sync_iterative_checker<ctsp_lb_sync_checker>:
+     *
+     * - **Feasible**: s holds start times (shortest path potentials shifted
+     *   so that the earliest operation starts at 0).
+     * - **Infeasible**: alpha/gamma hold a 0/1 certificate, the routing and
+     *   synchronization arcs of one negative cycle. beta is not used (the
+     *   lower bound model has no β rows) and is left untouched.
+     *
+     * The certificate is a valid dual ray of the LP checked by
+     * ctsp_lb_sync_checker, so it can be passed to path_finder as it is.
+     *
+     * @note The answer is exact for integral x only. A routing arc is active
+     *       when x_ij ≥ 1 - tol; use is_integral() to fall back to the LP
+     *       checker for fractional points.
+     */
+    class sync_difference_checker
+    {
+    protected:
+        double tol_;              ///< Numerical tolerance for active arcs
+        const double precision_;  ///< Precision for value truncation (1E3)
+
+        size_t n_operations_;     ///< Total number of operations (graph vertices)
+        size_t n_routing_arcs_;   ///< Number of routing arcs
+        size_t n_sync_arcs_;      ///< Number of synchronization arcs
+
+        shared_ptr<const sync_model_snapshot> model_; ///< Routing and sync arcs (i, j), shared
+        vector<double> routing_arc_cost_;  ///< Edge j → i cost: -t_ij
+        vector<double> sync_arc_cost_;     ///< Edge j → i cost: w_ij (0 if unbounded)
+
+        // Integer costs (units_ units per time unit)
+        bool integer_;                       ///< Use integer potentials (set_integer_arithmetic)
+        double units_;                       ///< Cost units per time unit: 1 or precision_
+        vector<int64_t> routing_arc_icost_;  ///< Routing arc costs in units
+        vector<int64_t> sync_arc_icost_;     ///< Sync arc costs in units
+        int64_t sync_negative_icost_;        ///< Sum of the negative sync arc costs
+        int64_t max_icost_;                  ///< Largest absolute cost
+        potential_type type_;                ///< Arithmetic of the last check
+
+        vector<int> head_;        ///< CSR offsets of the constraint graph (n_operations + 1)
+        vector<int> edge_from_;   ///< Tail vertex of each edge
+        vector<int> edge_to_;     ///< Head vertex of each edge
+        vector<int> edge_arc_;    ///< Arc index of each edge (sync arcs shifted by n_routing_arcs)
+        vector<double> edge_cost_;///< Cost of each edge
+        vector<int32_t> edge_cost32_; ///< Cost of each edge in units (INT32)
+        vector<int64_t> edge_cost64_; ///< Cost of each edge in units (INT64)
+        int64_t floor_;           ///< Minus the sum of the negative edge costs, in units
+        vector<int> degree_;      ///< Scratch out-degree counter
+
+        vector<double> dist_;     ///< Shortest path potentials (DOUBLE)
+        vector<int32_t> dist32_;  ///< Shortest path potentials in units (INT32)
+        vector<int64_t> dist64_;  ///< Shortest path potentials in units (INT64)
+        vector<int> pred_;        ///< Predecessor edge of each vertex (-1 if none)
+        vector<int> queue_;       ///< Circular SPFA queue
+        vector<char> in_queue_;   ///< Queue membership flags
+        vector<char> mark_;       ///< Scratch marks for predecessor cycle search
+
+        vector<int> cycle_;       ///< Arcs of the last negative cycle found
+
+    public:
+        /**
+         * @brief Construct difference checker
+         * @param builder Model A builder containing problem structure
+         * @param tol Numerical tolerance
+         */
+        sync_difference_checker(const sync_model_a_builder &builder, double tol);
+
+        /**
+         * @brief Default constructor (creates uninitialized checker)
+         */
+        sync_difference_checker(void);
+
+        virtual ~sync_difference_checker(void);
+
+        /**
+         * @brief Initialize checker with builder
+         * @param builder Model A builder
+         * @param tol Numerical tolerance
+         */
+        void set(const sync_model_a_builder &builder, double tol);
+
+        /**
+         * @brief Reload the synchronization arc times of the builder
+         * @param builder Model A builder (after set_time_windows_max_size)
+         */
+        void update_sync_arc_times(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Enable or disable integer potentials
+         * @param integer true (default): INT32 or INT64 potentials in cost
+         *        units; false: DOUBLE potentials in time units
+         */
+        inline void set_integer_arithmetic(const bool integer) { integer_ = integer; }
+
+        /**
+         * @brief Arithmetic of the last check
+         */
+        inline potential_type get_potential_type(void) const { return type_; }
+
+        /**
+         * @brief Cost units per time unit (1 if every cost is integral)
+         */
+        inline double get_cost_units(void) const { return units_; }
+
+        /**
+         * @brief Check if x is integral (within tolerance)
+         * @param x Routing solution
+         * @return true if every entry is 0 or 1
+         */
+        bool is_integral(const vector<double> &x) const;
+
+        /**
+         * @brief Check if a sparse x is integral (within tolerance)
+         * @param x Routing solution, nonzero entries
+         * @return true if every entry is 0 or 1, in O(support)
+         */
+        bool is_integral(const sparse_x &x) const;
+
+        /**
+         * @brief Check feasibility of routing x
+         * @param x Routing solution (arc variables)
+         * @return true if synchronization is feasible
+         *
+         * Potentials (if feasible) or the negative cycle (if infeasible)
+         * are kept for get_s() / get_alpha_beta_gamma().
+         */
+        bool is_feasible_(const vector<double> &x);
+
+        /**
+         * @brief Check feasibility and extract certificate if infeasible
+         * @param x Routing solution
+         * @param alpha Output: α indicator of the negative cycle
+         * @param beta Output: unused
+         * @param gamma Output: γ indicator of the negative cycle
+         * @return true if feasible
+         */
+        bool is_feasible(const vector<double> &x, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Check feasibility, extracting start times or certificate
+         * @param x Routing solution
+         * @param s Output: operation start times (if feasible)
+         * @param alpha Output: α indicator (if infeasible)
+         * @param beta Output: unused
+         * @param gamma Output: γ indicator (if infeasible)
+         * @return true if feasible
+         */
+        bool is_feasible(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Get negative cycle certificate from last check
+         * @param alpha Output: α indicator (size n_routing_arcs)
+         * @param beta Output: unused
+         * @param gamma Output: γ indicator (size n_sync_arcs)
+         */
+        void get_alpha_beta_gamma(vector<double> &alpha, vector<double> &beta, vector<double> &gamma) const;
+
+        /**
+         * @brief Get start times from last feasible check
+         * @param s Output: start time per operation
+         */
+        void get_s(vector<double> &s) const;
+
+        /**
+         * @brief Earliest and latest start times after a feasible check
+         * @param horizon Every operation starts in [0, horizon]; negative:
+         *        the earliest completion (largest earliest start)
+         * @param earliest Output: smallest start time of each operation
+         * @param latest Output: largest start time of each operation
+         * @return false if no schedule fits in the horizon
+         *
+         * The latest start times are the potentials of the check, shifted
+         * by the horizon; the earliest ones take one more shortest path
+         * pass over the reversed constraint graph. Each bound is attained
+         * by a schedule, but moving one operation to its bound may move
+         * others: the windows are not independent.
+         */
+        bool get_flexibility(double horizon, vector<double> &earliest, vector<double> &latest);
+
+        /**
+         * @brief Arcs of the last negative cycle
+         * @return Arc indices (sync arcs shifted by n_routing_arcs), in cycle order
+         */
+        inline const vector<int> &get_cycle(void) const { return cycle_; }
+
+    protected:
+        /**
+         * @brief Build the CSR constraint graph for routing x
+         * @param x Routing solution
+         */
+        void build_graph_(const vector<double> &x);
+
+        /**
+         * @brief Convert the costs to integer units
+         */
+        void set_units_(void);
+
+        /**
+         * @brief Set the cost of edge e in the arithmetic of the check
+         */
+        inline void set_edge_cost_(const int e, const double cost, const int64_t icost)
+        {
+            if (type_ == potential_type::INT32)
+                edge_cost32_[e] = (int32_t)icost;
+            else if (type_ == potential_type::INT64)
+                edge_cost64_[e] = icost;
+            else
+                edge_cost_[e] = cost;
+        }
+
+        /**
+         * @brief Run SPFA from a virtual source joined to every vertex
+         * @return true if no negative cycle exists
+         */
+        bool shortest_paths_(void);
+
+        /**
+         * @brief SPFA on potentials of type T
+         * @param dist Potentials
+         * @param edge_cost Cost of each edge
+         * @param eps Lowering below it is ignored (rounding of DOUBLE)
+         * @param floor No path is cheaper: a potential below it closes a
+         *        negative cycle in the predecessor graph (and keeps integer
+         *        potentials in range)
+         * @return true if no negative cycle exists
+         */
+        template <typename T>
+        bool shortest_paths_(vector<T> &dist, const vector<T> &edge_cost, T eps, T floor);
+
+        /**
+         * @brief Flexibility on potentials of type T
+         * @param dist Potentials of the last feasible check
+         * @param edge_cost Cost of each edge
+         * @param eps Lowering below it is ignored (rounding of DOUBLE)
+         * @param scale Potential units per time unit
+         * @param horizon Horizon in time units, negative: earliest completion
+         * @param earliest Output: earliest start times
+         * @param latest Output: latest start times
+         * @return false if no schedule fits in the horizon
+         */
+        template <typename T>
+        bool get_flexibility_(const vector<T> &dist, const vector<T> &edge_cost, T eps, double scale, double horizon,
+                              vector<double> &earliest, vector<double> &latest);
+
+        /**
+         * @brief Look for a cycle in the predecessor graph
+         * @return A vertex on the cycle, or -1 if the graph is a forest
+         */
+        int find_pred_cycle_(void);
+
+        /**
+         * @brief Collect the arcs of the predecessor cycle through v
+         * @param v Vertex on the cycle
+         */
+        void collect_cycle_(int v);
+
+        /**
+         * @brief Truncate value to specified precision
+         * @param val Input value
+         * @return Truncated value
+         */
+        inline double truncate_(const double val) const { return round(val * precision_) / precision_; }
+    };
+}
@@ -118,6 +118,121 @@ namespace SYNC_LIB
             return feasible;
         }
 
+        /**
+         * @brief Check feasibility after changing a few arcs of the last solution
+         * @param changed_arcs Routing arc indices that changed since the last check
+         * @param new_values New values of the changed arcs
+         * @param s Output: slack variable values (if feasible)
+         * @param alpha Output: α dual variables (if infeasible)
+         * @param beta Output: β dual variables (if infeasible)
+         * @param gamma Output: γ dual variables (if infeasible)
+         * @return true if feasible
+         *
+         * Delta variant for branch-and-cut: only the LP entries of the
+         * changed arcs are updated and the solve is warm-started from the
+         * previous basis.
+         */
+        bool is_feasible(const vector<int> &changed_arcs, const vector<double> &new_values, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+        {
+            const bool feasible{T::is_feasible_(changed_arcs, new_values)};
+
+            if (feasible)
+            {
+                T::get_s(s);
+            }
+            else
+            {
+                T::get_alpha_beta_gamma(alpha, beta, gamma);
+            }
+
+            return feasible;
+        }
+
+        /**
+         * @brief Check feasibility and view the solver output in place
+         * @param x Routing solution
+         * @param s Output: view of the start times (if feasible)
+         * @param alpha Output: view of the α duals (if infeasible)
+         * @param beta Output: view of the β duals (if infeasible)
+         * @param gamma Output: view of the γ duals (if infeasible)
+         * @return true if feasible
+         *
+         * Zero-copy variant for separation loops: the views point into the
+         * checker buffers and are only valid until its next check.
+         */
+        bool is_feasible(const vector<double> &x, GOMA::array_view<double> &s, GOMA::array_view<double> &alpha, GOMA::array_view<double> &beta, GOMA::array_view<double> &gamma)
+        {
+            const bool feasible{T::is_feasible_(x)};
+
+            if (feasible)
+            {
+                s = T::get_s_view();
+            }
+            else
+            {
+                alpha = T::get_alpha_view();
+                beta = T::get_beta_view();
+                gamma = T::get_gamma_view();
+            }
+
+            return feasible;
+        }
+
+        /**
+         * @brief Check a sparse routing solution (see is_feasible(x, s, alpha, beta, gamma))
+         * @param x Routing solution, nonzero entries only
+         * @param s Output: slack variable values (if feasible)
+         * @param alpha Output: α dual variables (if infeasible)
+         * @param beta Output: β dual variables (if infeasible)
+         * @param gamma Output: γ dual variables (if infeasible)
+         * @return true if feasible
+         *
+         * The load costs O(support) after the first check (see
+         * ctsp_sync_checker::is_feasible_(const sparse_x &)).
+         */
+        bool is_feasible(const sparse_x &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+        {
+            const bool feasible{T::is_feasible_(x)};
+
+            if (feasible)
+            {
+                T::get_s(s);
+            }
+            else
+            {
+                T::get_alpha_beta_gamma(alpha, beta, gamma);
+            }
+
+            return feasible;
+        }
+
+        /**
+         * @brief Check a sparse routing solution and view the solver output in place
+         * @param x Routing solution, nonzero entries only
+         * @param s Output: view of the start times (if feasible)
+         * @param alpha Output: view of the α duals (if infeasible)
+         * @param beta Output: view of the β duals (if infeasible)
+         * @param gamma Output: view of the γ duals (if infeasible)
+         * @return true if feasible
+         */
+        bool is_feasible(const sparse_x &x, GOMA::array_view<double> &s, GOMA::array_view<double> &alpha, GOMA::array_view<double> &beta, GOMA::array_view<double> &gamma)
+        {
+            const bool feasible{T::is_feasible_(x)};
+
+            if (feasible)
+            {
+                s = T::get_s_view();
+            }
+            else
+            {
+                alpha = T::get_alpha_view();
+                beta = T::get_beta_view();
+                gamma = T::get_gamma_view();
+            }
+
+            return feasible;
+        }
+
         /**
          * @brief Check feasibility using pre-set solution and extract duals
          * @param inx Index parameter (currently unused, for future extensions)
@@ -136,7 +251,7 @@ namespace SYNC_LIB
 
             if (!feasible)
             {
-                T::get_vars(T::alpha_);
+                T::keep_solution_(feasible);
                 T::get_alpha_beta_gamma_(T::alpha_, alpha, beta, gamma);
             }
 
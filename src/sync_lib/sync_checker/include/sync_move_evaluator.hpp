@@ -0,0 +1,354 @@
+/**
+ * @file sync_move_evaluator.hpp
+ * @brief Feasibility of local search moves on an integral routing, without LP
+ *
+ * A heuristic asks whether a routing stays synchronizable after inserting,
+ * removing, swapping or reversing customers, many times per accepted move.
+ * Rebuilding x and checking it (LP or sync_difference_checker) costs a pass
+ * over the whole model per question.
+ *
+ * The constraints of an integral routing are difference constraints (see
+ * sync_difference_checker): s_i - s_j ≤ c is an edge j → i of cost c, and
+ * the routing is feasible iff the graph has no negative cycle. For the
+ * committed routing, sync_move_evaluator keeps the shortest path cost
+ * P(u, v) between every pair of operations: every schedule satisfies
+ * s_v - s_u ≤ P(u, v). Relative to the departure o of its depot, an
+ * operation v starts between -P(v, o) (earliest label, forward propagation)
+ * and P(o, v) (latest label, backward propagation).
+ *
+ * A move removes some edges and adds a few, and the new routing is
+ * infeasible iff a cycle through the added edges is negative:
+ *
+ * - insertion of c between a and b, removal of c from between them: the
+ *   cycle closes through P (c → a, b → c, b → a), in O(1). P is exact
+ *   here: a shortest path ending at a or starting at b never uses an edge
+ *   the move removes.
+ * - swap and 2-opt: the reversed or exchanged arcs would close cycles
+ *   through the removed ones in P, so they are checked by a negative cycle
+ *   search (SPFA) on the new graph, started from the committed schedule:
+ *   only the operations whose start times must move are visited.
+ *
+ * Committing a move updates P in O(n²) per added edge when the removed
+ * edges are implied by the new routes (an insertion under the triangle
+ * inequality), and recomputes it (Johnson: one SPFA, then one Dijkstra per
+ * operation) otherwise. P takes n_operations² doubles.
+ */
+
+#pragma once
+
+#include "sync_model_a_builder.hpp"
+#include "route_times.hpp"
+
+#include <vector>
+#include <deque>
+#include <cmath>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_move_evaluator
+     * @brief Incremental move evaluation on the difference constraints of a routing
+     *
+     * ```cpp
+     * sync_move_evaluator evaluator(builder, 1e-6);
+     *
+     * if (evaluator.load(routes))                       // sync_solution layout
+     * {
+     *     double delta;
+     *
+     *     if (evaluator.eval_insert(k, c, p, delta) && delta < best)
+     *         evaluator.insert(k, c, p);               // commit
+     * }
+     * ```
+     *
+     * Routes use the sync_solution layout: one route per depot, route[0]
+     * and route.back() the depot, customers 0-based nodes. Positions are
+     * indices in these vectors. delta is the change of the travel time of
+     * the routes. Queries and commits assume a feasible committed routing
+     * (load() returned true). One evaluator per thread.
+     */
+    class sync_move_evaluator
+    {
+    protected:
+        /**
+         * @struct route_change
+         * @brief Positions [begin_, end_) of route k_ replaced by ops_
+         */
+        struct route_change
+        {
+            size_t k_;          ///< Route
+            size_t begin_;      ///< First position replaced (≥ 1)
+            size_t end_;        ///< One past the last one (≤ route size - 1)
+            vector<int> ops_;   ///< New operations
+            vector<int> nodes_; ///< Their route nodes
+        };
+
+        double tol_;             ///< Numerical tolerance
+        const double precision_; ///< Precision for value truncation (1E3)
+
+        const sync_model_a_builder *builder_; ///< Model (outlives the evaluator)
+
+        size_t n_operations_; ///< Operations (graph vertices)
+        size_t n_depots_;     ///< Depots (routes)
+
+        vector<double> routing_arc_cost_; ///< Edge j → i cost of routing arc (i, j): -t_ij
+        vector<double> sync_arc_cost_;    ///< Edge j → i cost of sync arc (i, j), as sync_difference_checker
+
+        vector<vector<int>> routes_; ///< Committed routes (sync_solution layout)
+        vector<vector<int>> ops_;    ///< Operation at each position of each route
+        vector<int> route_;          ///< Route of each operation, -1 if not routed
+        vector<int> position_;       ///< Position of each operation in its route
+        route_times route_times_;    ///< Truncated arc times summed along each route
+
+        vector<double> P_; ///< Shortest path cost between every pair of operations (row-major)
+        bool feasible_;    ///< The committed routing is feasible
+
+        // Constraint graph of the committed routing
+        vector<int> head_;               ///< CSR offsets
+        vector<int> edge_to_;            ///< Head vertex of each edge
+        vector<double> edge_cost_;       ///< Cost of each edge
+        vector<vector<int>> route_edge_; ///< Edge of the arc ending at each route position (-1 at 0)
+        vector<double> potential_;       ///< Feasible potentials (a schedule, Johnson reweighting)
+
+        // Recompute workspace
+        vector<int> n_enqueued_;    ///< SPFA enqueue counters (negative cycle detection)
+        vector<double> dist_;       ///< Dijkstra distances (reduced costs)
+        vector<double> column_;     ///< Incremental update: P(·, tail)
+        vector<double> row_;        ///< Incremental update: P(head, ·)
+
+        // Local search workspace
+        vector<char> edge_removed_; ///< Edges removed by the move
+        vector<double> label_;      ///< Potentials of the new graph (potential_ where not touched)
+        vector<int> pred_;          ///< Vertex that last lowered each label, -1 if none
+        vector<char> in_queue_;     ///< Queue membership flags
+        vector<int> touched_;       ///< Vertices whose label was lowered
+        deque<int> queue_;          ///< SPFA queue
+
+        // Query workspace
+        vector<route_change> changes_; ///< Routes changed by the move
+        vector<int> added_from_;       ///< Added edges: tail
+        vector<int> added_to_;         ///< Added edges: head
+        vector<double> added_cost_;    ///< Added edges: cost
+        vector<int> removed_arcs_;     ///< Routing arcs removed by the move
+        vector<int> nodes_;            ///< Endpoints of the added edges
+        vector<double> M_;             ///< Cost matrix between the endpoints
+
+        size_t n_evaluations_; ///< Move queries
+        size_t n_commits_;     ///< Moves committed
+        size_t n_recomputes_;  ///< Commits that recomputed P (load included)
+
+    public:
+        /**
+         * @brief Construct move evaluator
+         * @param builder Model A builder (must outlive the evaluator)
+         * @param tol Numerical tolerance
+         */
+        sync_move_evaluator(const sync_model_a_builder &builder, double tol);
+
+        virtual ~sync_move_evaluator(void);
+
+        /**
+         * @brief Reload the synchronization arc times of the builder
+         * @param builder Model A builder (after set_time_windows_max_size)
+         *
+         * Call load() again afterwards: P is not updated.
+         */
+        void update_sync_arc_times(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Commit a routing and compute its labels
+         * @param routes One route per depot
+         * @return true if the routing is feasible
+         * @throw std::invalid_argument If there is not one route per depot,
+         *        a customer is not served by the depot or visited twice, or
+         *        a route uses an arc pruned from the model
+         */
+        bool load(const vector<vector<int>> &routes);
+
+        /**
+         * @brief Insertion of a customer
+         * @param k Route
+         * @param customer Customer node (0-based), not in route k
+         * @param p Position it takes (1 ≤ p ≤ route size - 1)
+         * @param delta Output: travel time change
+         * @return true if the routing stays feasible (exact)
+         */
+        bool eval_insert(size_t k, int customer, size_t p, double &delta);
+
+        /**
+         * @brief Removal of a customer
+         * @param k Route
+         * @param p Position (1 ≤ p ≤ route size - 2)
+         * @param delta Output: travel time change
+         * @return true if the routing stays feasible (exact)
+         */
+        bool eval_remove(size_t k, size_t p, double &delta);
+
+        /**
+         * @brief Exchange of two customers (same or different routes)
+         * @param k1 First route
+         * @param p1 First position
+         * @param k2 Second route
+         * @param p2 Second position
+         * @param delta Output: travel time change
+         * @return true if the routing stays feasible (exact)
+         *
+         * Between routes, each customer must be served by the other depot
+         * and not be in its route already.
+         */
+        bool eval_swap(size_t k1, size_t p1, size_t k2, size_t p2, double &delta);
+
+        /**
+         * @brief Reversal of the customers at positions i..j of a route
+         * @param k Route
+         * @param i First position (≥ 1)
+         * @param j Last position (i < j ≤ route size - 2)
+         * @param delta Output: travel time change
+         * @return true if the routing stays feasible (exact)
+         */
+        bool eval_two_opt(size_t k, size_t i, size_t j, double &delta);
+
+        /**
+         * @brief Commit an insertion (see eval_insert)
+         */
+        void insert(size_t k, int customer, size_t p);
+
+        /**
+         * @brief Commit a removal (see eval_remove)
+         */
+        void remove(size_t k, size_t p);
+
+        /**
+         * @brief Commit a swap (see eval_swap)
+         */
+        void swap(size_t k1, size_t p1, size_t k2, size_t p2);
+
+        /**
+         * @brief Commit a 2-opt move (see eval_two_opt)
+         */
+        void two_opt(size_t k, size_t i, size_t j);
+
+        inline bool is_feasible(void) const { return feasible_; }
+        inline const vector<vector<int>> &get_routes(void) const { return routes_; }
+
+        /**
+         * @brief Earliest start of a visit, from the departure of its depot
+         * @param k Route
+         * @param p Position
+         */
+        inline double get_earliest_start(const size_t k, const size_t p) const { return -P_at_(ops_[k][p], (int)k); }
+
+        /**
+         * @brief Latest start of a visit, from the departure of its depot
+         * @param k Route
+         * @param p Position
+         * @return Infinity if not bounded
+         */
+        inline double get_latest_start(const size_t k, const size_t p) const { return P_at_((int)k, ops_[k][p]); }
+
+        /**
+         * @brief Travel and service time between two visits of a route, in O(1)
+         * @param k Route
+         * @param p First position
+         * @param q Second position (p ≤ q)
+         * @return Sum of the arc times in between, truncated as the edge costs
+         */
+        inline double get_elapsed(const size_t k, const size_t p, const size_t q) const { return route_times_.get_elapsed(k, p, q); }
+
+        /**
+         * @brief Start times of a feasible committed routing
+         * @param s Output: start time per operation (earliest one at 0)
+         */
+        void get_s(vector<double> &s) const;
+
+        inline size_t get_n_evaluations(void) const { return n_evaluations_; }
+        inline size_t get_n_commits(void) const { return n_commits_; }
+        inline size_t get_n_recomputes(void) const { return n_recomputes_; }
+
+        /**
+         * @brief Heap bytes held (P and the workspaces)
+         */
+        size_t get_memory_bytes(void) const;
+
+    protected:
+        inline double P_at_(const int u, const int v) const { return P_[(size_t)u * n_operations_ + v]; }
+
+        /**
+         * @brief Operation of a route node
+         * @return -1 if the depot does not serve the customer
+         */
+        int operation_(size_t k, int node) const;
+
+        /**
+         * @brief Routing arc (i, j)
+         * @return Arc index, EMPTY_VAR if pruned
+         */
+        inline int arc_(const int i, const int j) const { return builder_->get_routing_arcs_pair_map().at(i, j); }
+
+        /**
+         * @brief Fill the added edges and removed arcs of changes_
+         * @param delta Output: travel time change
+         * @return false if a new arc is pruned from the model
+         */
+        bool collect_edges_(double &delta);
+
+        /**
+         * @brief Test an insertion or removal in changes_ against P
+         * @param delta Output: travel time change
+         * @return true if no negative cycle goes through the added edges
+         *
+         * Negative cycle search on the endpoints of the added edges, with P
+         * as the cost between them.
+         */
+        bool evaluate_(double &delta);
+
+        /**
+         * @brief Apply changes_ to the routes and update P
+         */
+        void commit_(void);
+
+        /**
+         * @brief Set changes_ to a move
+         * @return false if the move is not possible (customer not served by
+         *         the depot or already in the route)
+         */
+        bool set_insert_(size_t k, int customer, size_t p);
+        bool set_remove_(size_t k, size_t p);
+        bool set_swap_(size_t k1, size_t p1, size_t k2, size_t p2);
+        bool set_two_opt_(size_t k, size_t i, size_t j);
+
+        /**
+         * @brief Compute P for the committed routes
+         * @return false if they have a negative cycle
+         */
+        bool recompute_(void);
+
+        /**
+         * @brief Build the constraint graph of the committed routes
+         */
+        void build_graph_(void);
+
+        /**
+         * @brief Recompute the cumulative times of a committed route
+         * @param k Route
+         */
+        void set_route_times_(size_t k);
+
+        /**
+         * @brief Negative cycle search on the graph changed by changes_
+         * @param keep Keep the new labels as potentials if no cycle is found
+         * @return true if there is no negative cycle
+         *
+         * Needs collect_edges_() first. SPFA from the heads of the added
+         * edges the committed potentials violate.
+         */
+        bool local_search_(bool keep);
+
+        /**
+         * @brief Truncate value to specified precision
+         */
+        inline double truncate_(const double val) const { return round(val * precision_) / precision_; }
+    };
+}
@@ -1,5 +1,7 @@
 #include "ctsp_primal_model.hpp"
 
+#include <cassert>
+
 #define INF_MD_THRLD 1E6
 
 namespace SYNC_LIB
@@ -29,8 +31,11 @@ namespace SYNC_LIB
         build_model_(builder);
         build_primal_matrix_(builder, GOMA::model_description::M_, GOMA::model_description::nz_);
 
-        set_var_labels_(builder);
-        set_cons_labels_(builder);
+        if (GOMA::model_description::get_labels())
+        {
+            set_var_labels_(builder);
+            set_cons_labels_(builder);
+        }
     }
 
     ctsp_primal_model::~ctsp_primal_model(void)
@@ -146,19 +151,23 @@ namespace SYNC_LIB
         build_objective_sense_(builder);
     }
 
-    void ctsp_primal_model::build_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz)
+    void ctsp_primal_model::build_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz)
     {
         M.resize(n_row_, n_col_);
-        M.init(0.0);
+        M.reserve(2 * n_row_);
 
         nz = 0;
 
         build_alpha_primal_matrix_(builder, M, nz);
         build_beta_primal_matrix_(builder, M, nz);
         build_gamma_primal_matrix_(builder, M, nz);
+
+        M.compress();
+
+        assert(nz == M.get_nz());
     }
 
-    void ctsp_primal_model::build_alpha_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz)
+    void ctsp_primal_model::build_alpha_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz)
     {
         if (n_alpha_constraints_ == 0)
             return;
@@ -172,15 +181,15 @@ namespace SYNC_LIB
             const int o_i = arc.i_;
             const int o_j = arc.j_;
 
-            M(base_alpha_constraints_ + i + 1, o_i + 1) = 1;
+            M.insert(base_alpha_constraints_ + i + 1, o_i + 1, 1);
             nz++;
 
-            M(base_alpha_constraints_ + i + 1, o_j + 1) = -1;
+            M.insert(base_alpha_constraints_ + i + 1, o_j + 1, -1);
             nz++;
         }
     }
 
-    void ctsp_primal_model::build_beta_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz)
+    void ctsp_primal_model::build_beta_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz)
     {
         if (n_beta_constraints_ == 0)
             return;
@@ -194,15 +203,15 @@ namespace SYNC_LIB
             const int o_i = arc.i_;
             const int o_j = arc.j_;
 
-            M(base_beta_constraints_ + i + 1, o_i + 1) = -1;
+            M.insert(base_beta_constraints_ + i + 1, o_i + 1, -1);
             nz++;
 
-            M(base_beta_constraints_ + i + 1, o_j + 1) = 1;
+            M.insert(base_beta_constraints_ + i + 1, o_j + 1, 1);
             nz++;
         }
     }
 
-    void ctsp_primal_model::build_gamma_primal_matrix_(const sync_model_a_builder &builder, GOMA::matrix<double> &M, int &nz)
+    void ctsp_primal_model::build_gamma_primal_matrix_(const sync_model_a_builder &builder, GOMA::sparse_matrix<double> &M, int &nz)
     {
         const vector<triplet> &sync_arcs{builder.get_sync_arcs()};
         const size_t n_sync_arcs{sync_arcs.size()};
@@ -213,10 +222,10 @@ namespace SYNC_LIB
             const int o_i = arc.i_;
             const int o_j = arc.j_;
 
-            M(base_gamma_constraints_ + i + 1, o_j + 1) = -1;
+            M.insert(base_gamma_constraints_ + i + 1, o_j + 1, -1);
             nz++;
 
-            M(base_gamma_constraints_ + i + 1, o_i + 1) = 1;
+            M.insert(base_gamma_constraints_ + i + 1, o_i + 1, 1);
             nz++;
         }
     }
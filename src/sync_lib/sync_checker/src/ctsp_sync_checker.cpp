@@ -1,8 +1,13 @@
 #include "ctsp_sync_checker.hpp"
 #include <cassert>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
 
 #include "sync_checker_solver.hpp"
 
+#define INF_MD_THRLD 1E6
+
 namespace SYNC_LIB
 {
 
@@ -15,20 +20,26 @@ namespace SYNC_LIB
                                                                                                                                         n_customers_(builder.get_n_customers()),
                                                                                                                                         n_depots_(builder.get_n_depots()),
                                                                                                                                         n_col_(model.get_n_col()),
-                                                                                                                                        routing_arc_resources_(new double[builder.get_routing_arc_times().size()]),
-                                                                                                                                        operations_resources_(new double[n_operations_]),
+                                                                                                                                        model_(builder.get_snapshot()),
+                                                                                                                                        routing_arc_resources_(model_->get_routing_arc_times().data()),
                                                                                                                                         max_distance_(builder.get_max_distance()),
-                                                                                                                                        routing_outbound_arcs_(builder.get_routing_outbound_arcs()),
-                                                                                                                                        routing_inbound_arcs_(builder.get_routing_inbound_arcs()),
-                                                                                                                                        operation_2_customer_(n_operations_, -1),
-                                                                                                                                        routing_arcs_(builder.get_routing_arcs()),
-                                                                                                                                        routing_arcs_pair_map_(builder.get_routing_arcs_pair_map()),
                                                                                                                                         col_inx_(new int[get_nz()]),
                                                                                                                                         row_inx_(new int[get_nz()]),
                                                                                                                                         coef_val_(new double[get_nz()]),
                                                                                                                                         sense_(new char[get_nz()]),
                                                                                                                                         alpha_(new double[model.get_n_col()]),
                                                                                                                                         s_(new double[model.get_n_row()]),
+                                                                                                                                        support_valid_(false),
+                                                                                                                                        basis_cache_(nullptr),
+                                                                                                                                        n_basis_restores_(0),
+                                                                                                                                        feasibility_only_(false),
+                                                                                                                                        n_early_stops_(0),
+                                                                                                                                        obj_rows_(),
+                                                                                                                                        obj_rhs_(),
+                                                                                                                                        n_objective_solves_(0),
+                                                                                                                                        deadline_(NULL),
+                                                                                                                                        time_limited_(false),
+                                                                                                                                        truncated_(false),
                                                                                                                                         n_alpha_var_(0),
                                                                                                                                         n_beta_var_(0),
                                                                                                                                         n_gamma_var_(0),
@@ -37,32 +48,7 @@ namespace SYNC_LIB
                                                                                                                                         base_gamma_var_(0)
 
     {
-        const vector<double> &routing_arc_resources{builder.get_routing_arc_times()};
-        const size_t sz{routing_arc_resources.size()};
-
-        for (size_t i{0}; i < sz; i++)
-        {
-            routing_arc_resources_[i] = routing_arc_resources[i];
-        }
-
-        const vector<vector<double>> &operations_resources{builder.get_operation_resources()};
-
-        assert(operations_resources.size() == n_operations_);
-
-        operations_resources_[0] = 0;
-
-        for (size_t i{1}; i < n_operations_; i++)
-        {
-            operations_resources_[i] = operations_resources[i][1];
-        }
-
-        const vector<sync_operation> &operations{builder.get_operations()};
-
-        for (size_t i{0}; i < n_operations_; i++)
-        {
-            const sync_operation &op{operations[i]};
-            operation_2_customer_[i] = op.get_customer();
-        }
+        set_warm_start(true);
     }
 
     ctsp_sync_checker::ctsp_sync_checker(void) : sync_checker_solver(),
@@ -72,31 +58,33 @@ namespace SYNC_LIB
                                                  n_routing_arcs_(0),
                                                  n_sync_arcs_(0),
                                                  n_customers_(0),
+                                                 n_depots_(0),
                                                  n_col_(0),
+                                                 model_(),
                                                  routing_arc_resources_(nullptr),
-                                                 operations_resources_(nullptr),
                                                  max_distance_(0),
                                                  col_inx_(nullptr),
                                                  row_inx_(nullptr),
                                                  coef_val_(nullptr),
                                                  sense_(nullptr),
                                                  alpha_(nullptr),
-                                                 s_(nullptr)
+                                                 s_(nullptr),
+                                                 support_valid_(false),
+                                                 basis_cache_(nullptr),
+                                                 n_basis_restores_(0),
+                                                 feasibility_only_(false),
+                                                 n_early_stops_(0),
+                                                 obj_rows_(),
+                                                 obj_rhs_(),
+                                                 n_objective_solves_(0),
+                                                 deadline_(NULL),
+                                                 time_limited_(false),
+                                                 truncated_(false)
     {
     }
 
     ctsp_sync_checker::~ctsp_sync_checker(void)
     {
-        if (routing_arc_resources_ != nullptr)
-        {
-            delete[] routing_arc_resources_;
-        }
-
-        if (operations_resources_ != nullptr)
-        {
-            delete[] operations_resources_;
-        }
-
         if (col_inx_ != nullptr)
         {
             delete[] col_inx_;
@@ -138,57 +126,11 @@ namespace SYNC_LIB
         n_customers_ = builder.get_n_customers();
         n_col_ = model.get_n_col();
 
-        routing_arcs_pair_map_ = builder.get_routing_arcs_pair_map();
-
-        const vector<double> &routing_arc_resources{builder.get_routing_arc_times()};
-        const size_t sz{routing_arc_resources.size()};
-
-        if (routing_arc_resources_ != nullptr)
-        {
-            delete[] routing_arc_resources_;
-        }
-
-        routing_arc_resources_ = new double[sz];
-
-        for (size_t i{0}; i < sz; i++)
-        {
-            routing_arc_resources_[i] = routing_arc_resources[i];
-        }
-
-        const vector<vector<double>> &operations_resources{builder.get_operation_resources()};
-
-        if (operations_resources_ != nullptr)
-        {
-            delete[] operations_resources_;
-        }
-
-        operations_resources_ = new double[n_operations_];
-
-        assert(operations_resources.size() == n_operations_);
-
+        n_depots_ = builder.get_n_depots();
         max_distance_ = builder.get_max_distance();
 
-        for (size_t i{0}; i < n_operations_; i++)
-        {
-            operations_resources_[i] = operations_resources[i][1];
-        }
-
-        const vector<sync_operation> &operations{builder.get_operations()};
-
-        if (operation_2_customer_.size() != n_operations_)
-        {
-            operation_2_customer_.resize(n_operations_);
-        }
-
-        for (size_t i{0}; i < n_operations_; i++)
-        {
-            const sync_operation &op{operations[i]};
-            operation_2_customer_[i] = op.get_customer();
-        }
-
-        routing_outbound_arcs_ = builder.get_routing_outbound_arcs();
-        routing_inbound_arcs_ = builder.get_routing_inbound_arcs();
-        routing_arcs_ = builder.get_routing_arcs();
+        model_ = builder.get_snapshot();
+        routing_arc_resources_ = model_->get_routing_arc_times().data();
 
         if (col_inx_ != nullptr)
         {
@@ -227,6 +169,12 @@ namespace SYNC_LIB
         alpha_ = new double[model.get_n_col()];
         s_ = new double[model.get_n_row()];
 
+        x_.clear();
+        support_valid_ = false;
+
+        set_warm_start(true);
+        set_feasibility_only(feasibility_only_);
+
         compute_constraints_number_(builder);
     }
 
@@ -255,15 +203,118 @@ namespace SYNC_LIB
         get_s_(s_, s);
     }
 
+    void ctsp_sync_checker::set_feasibility_only(const bool feasibility_only)
+    {
+        feasibility_only_ = feasibility_only;
+
+        set_obj_cutoff(feasibility_only ? -0.001 : -numeric_limits<double>::infinity());
+    }
+
+    bool ctsp_sync_checker::optimize_s(const vector<double> &weights)
+    {
+        if (weights.size() != n_operations_)
+            throw std::invalid_argument("ctsp_sync_checker: " + to_string(weights.size()) + " start time weights for " +
+                                        to_string(n_operations_) + " operations");
+
+        double sum{0.0};
+        double supply{0.0};
+
+        obj_rows_.clear();
+
+        for (size_t i{0}; i < n_operations_; i++)
+        {
+            sum += weights[i];
+
+            if (weights[i] > 0)
+                supply += weights[i];
+
+            if (weights[i] != 0)
+                obj_rows_.push_back((int)i);
+        }
+
+        if (fabs(sum) > 1E-9 * max(1.0, supply))
+            throw std::invalid_argument("ctsp_sync_checker: start time weights must sum to 0");
+
+        if (obj_rows_.empty())
+            return true;
+
+        if (!limit_time_())
+        {
+            // The answer of the check stands, only the objective is given up
+            truncated_ = false;
+            return false;
+        }
+
+        // Basis of the check, restored for the next one
+        const bool saved{get_basis(col_stat_, row_stat_)};
+
+        // Minimizing Σ w_i s_i is maximizing Σ -w_i s_i in the start time model
+        const double scale{-0.5 / supply};
+
+        obj_rhs_.resize(obj_rows_.size());
+
+        for (size_t r{0}; r < obj_rows_.size(); r++)
+            obj_rhs_[r] = scale * weights[obj_rows_[r]];
+
+        set_rhs((int)obj_rows_.size(), obj_rows_.data(), obj_rhs_.data());
+        set_obj_cutoff(-numeric_limits<double>::infinity());
+
+        solve();
+
+        n_objective_solves_++;
+
+        const bool optimal{get_lp_stat() == 1};
+
+        if (optimal)
+            get_dual_vars(s_);
+
+        fill(obj_rhs_.begin(), obj_rhs_.end(), 0.0);
+        set_rhs((int)obj_rows_.size(), obj_rows_.data(), obj_rhs_.data());
+        set_feasibility_only(feasibility_only_);
+
+        if (saved)
+            set_basis(col_stat_, row_stat_);
+
+        return optimal;
+    }
+
     void ctsp_sync_checker::write(const char *filename) const
     {
         write_model(filename);
     }
 
+    /**
+     * The time left of the deadline is the time limit of the solve; a
+     * limit set by an earlier check is lifted when the deadline has none
+     * (or is removed).
+     */
+    bool ctsp_sync_checker::limit_time_(void)
+    {
+        truncated_ = false;
+
+        if (deadline_ != NULL && deadline_->expired())
+        {
+            truncated_ = true;
+            return false;
+        }
+
+        const bool limited{deadline_ != NULL && deadline_->is_limited()};
+
+        if (limited || time_limited_)
+            set_time_limit(limited ? deadline_->remaining() : 0.0);
+
+        time_limited_ = limited;
+
+        return true;
+    }
+
     bool ctsp_sync_checker::is_feasible_(void)
     {
         bool feasible{false};
 
+        if (!limit_time_())
+            return false;
+
         solve();
 
         const int lp_stat = get_lp_stat();
@@ -279,16 +330,26 @@ namespace SYNC_LIB
                 feasible = true;
             }
         }
+        else if (lp_stat == GOMA::LP_STAT_OBJ_LIMIT)
+        {
+            // Stopped below the threshold: the current point is a certificate
+            n_early_stops_++;
+        }
+        else if (lp_stat == GOMA::LP_STAT_TIME_LIMIT || lp_stat == GOMA::LP_STAT_INTERRUPTED)
+        {
+            // Stopped by the deadline or interrupted: no answer
+            truncated_ = true;
+        }
         else if (lp_stat == 2)
         {
             assert(false);
-            cout << "Unbounded" << endl;
+            cerr << "Unbounded" << endl;
             exit(0);
         }
         else
         {
             assert(false);
-            cout << "Error" << endl;
+            cerr << "Error" << endl;
             exit(0);
         }
 
@@ -301,6 +362,9 @@ namespace SYNC_LIB
 
         obj_val = 0.0;
 
+        if (!limit_time_())
+            return false;
+
         solve();
 
         const int lp_stat = get_lp_stat();
@@ -316,10 +380,20 @@ namespace SYNC_LIB
                 feasible = true;
             }
         }
+        else if (lp_stat == GOMA::LP_STAT_OBJ_LIMIT)
+        {
+            // Objective of the certificate, an upper bound of the optimum
+            obj_val = get_obj();
+            n_early_stops_++;
+        }
+        else if (lp_stat == GOMA::LP_STAT_TIME_LIMIT || lp_stat == GOMA::LP_STAT_INTERRUPTED)
+        {
+            truncated_ = true;
+        }
         else if (lp_stat == 2)
         {
             assert(false);
-            cout << "Unbounded" << endl;
+            cerr << "Unbounded" << endl;
             exit(0);
         }
         else
@@ -327,7 +401,7 @@ namespace SYNC_LIB
             feasible = true;
             //write_model("error_model.lp");
             //assert(false);
-            cout << "Error: " << lp_stat << endl;
+            cerr << "Error: " << lp_stat << endl;
             //exit(0);
         }
 
@@ -336,33 +410,68 @@ namespace SYNC_LIB
 
     bool ctsp_sync_checker::is_feasible_(const vector<double> &x)
     {
+        restore_basis_(x);
 
-        x_2_obj_(x);
-        x_2_coef_(x);
+        load_x_(x);
 
         const bool feasible{is_feasible_()};
 
-        if (!feasible)
-        {
-            get_vars(alpha_);
-        }
-        else
-        {
-            get_dual_vars(s_);
-        }
+        store_basis_();
+
+        keep_solution_(feasible);
 
         return feasible;
     }
 
     bool ctsp_sync_checker::is_feasible_(const vector<double> &x, double &obj_val)
     {
+        restore_basis_(x);
 
-        x_2_obj_(x);
-        x_2_coef_(x);
+        load_x_(x);
 
         const bool feasible{is_feasible_(obj_val)};
 
-        if (!feasible)
+        store_basis_();
+
+        keep_solution_(feasible);
+
+        return feasible;
+    }
+
+    bool ctsp_sync_checker::is_feasible_(const sparse_x &x)
+    {
+        restore_basis_(x);
+
+        load_x_(x);
+
+        const bool feasible{is_feasible_()};
+
+        store_basis_();
+
+        keep_solution_(feasible);
+
+        return feasible;
+    }
+
+    bool ctsp_sync_checker::is_feasible_(const vector<int> &changed_arcs, const vector<double> &new_values)
+    {
+        update_x(changed_arcs, new_values);
+
+        const bool feasible{is_feasible_()};
+
+        keep_solution_(feasible);
+
+        return feasible;
+    }
+
+    void ctsp_sync_checker::keep_solution_(const bool feasible)
+    {
+        // A truncated check has no certificate: the path finder gets an empty support
+        if (truncated_)
+        {
+            fill(alpha_, alpha_ + n_col_, 0.0);
+        }
+        else if (!feasible)
         {
             get_vars(alpha_);
         }
@@ -370,161 +479,425 @@ namespace SYNC_LIB
         {
             get_dual_vars(s_);
         }
-
-        return feasible;
     }
 
-    void ctsp_sync_checker::x_2_alpha_coef_(const vector<double> &x, const size_t row_i, int &nz)
+    void ctsp_sync_checker::load_x_(const vector<double> &x)
     {
-        if (n_alpha_var_ == 0)
-            return;
+        if (x_.size() != n_routing_arcs_)
+        {
+            x_2_obj_(x);
+            x_2_coef_(x);
 
-        const vector<int> &routing_outbound_arcs_o{routing_outbound_arcs_[row_i]};
-        const size_t n_routing_outbound_arcs{routing_outbound_arcs_o.size()};
+            x_.resize(n_routing_arcs_);
 
-        for (size_t j{0}; j < n_routing_outbound_arcs; j++)
-        {
-            const int arc = routing_outbound_arcs_o[j];
+            for (size_t i{0}; i < n_routing_arcs_; i++)
+            {
+                x_[i] = x_val_(x[i]);
+            }
 
-            assert(arc < (int)n_routing_arcs_);
+            support_valid_ = false;
 
-            row_inx_[nz] = row_i;
-            col_inx_[nz] = base_alpha_var_ + arc;
+            return;
+        }
 
-            const double val{x[arc]};
+        changed_arcs_.clear();
+        changed_values_.clear();
 
-            if (fabs(val) > tol_)
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+        {
+            if (x_val_(x[i]) != x_[i])
             {
-                const double x_val{truncate_(val)};
-                coef_val_[nz] = x_val;
+                changed_arcs_.push_back((int)i);
+                changed_values_.push_back(x[i]);
             }
-            else
+        }
+
+        update_x(changed_arcs_, changed_values_);
+    }
+
+    void ctsp_sync_checker::load_x_(const sparse_x &x)
+    {
+        assert(x.get_n() == n_routing_arcs_);
+
+        // First load: every entry is written once
+        if (x_.size() != n_routing_arcs_)
+        {
+            vector<double> dense;
+            x.to_dense(dense);
+
+            load_x_(dense);
+        }
+        else
+        {
+            load_support_();
+
+            const vector<int> &index{x.get_indices()};
+            const vector<double> &value{x.get_values()};
+
+            changed_arcs_.clear();
+            changed_values_.clear();
+
+            // Merge of the loaded support and x: other arcs are 0 in both
+            size_t p{0};
+            size_t q{0};
+
+            while (p < support_.size() || q < index.size())
             {
-                coef_val_[nz] = 0.0;
+                if (q == index.size() || (p < support_.size() && support_[p] < index[q]))
+                {
+                    changed_arcs_.push_back(support_[p]);
+                    changed_values_.push_back(0.0);
+                    p++;
+                    continue;
+                }
+
+                if (p < support_.size() && support_[p] == index[q])
+                    p++;
+
+                if (x_val_(value[q]) != x_[index[q]])
+                {
+                    changed_arcs_.push_back(index[q]);
+                    changed_values_.push_back(value[q]);
+                }
+
+                q++;
             }
 
-            nz++;
+            update_x(changed_arcs_, changed_values_);
         }
+
+        support_.clear();
+
+        for (size_t q{0}; q < x.size(); q++)
+        {
+            if (x_[x.get_index(q)] != 0.0)
+                support_.push_back(x.get_index(q));
+        }
+
+        support_valid_ = true;
     }
 
-    void ctsp_sync_checker::x_2_beta_coef_(const vector<double> &x, const size_t row_i, int &nz)
+    void ctsp_sync_checker::load_support_(void)
     {
-        if (n_beta_var_ == 0)
+        if (support_valid_)
             return;
 
-        const vector<int> &routing_in_arcs_o{routing_inbound_arcs_[row_i]};
-        const size_t n_routing_in_arcs{routing_in_arcs_o.size()};
+        support_.clear();
 
-        for (size_t j{0}; j < n_routing_in_arcs; j++)
+        for (size_t i{0}; i < x_.size(); i++)
         {
-            const int arc = routing_in_arcs_o[j];
+            if (x_[i] != 0.0)
+                support_.push_back((int)i);
+        }
 
-            assert(arc < (int)n_routing_arcs_);
+        support_valid_ = true;
+    }
 
-            row_inx_[nz] = row_i;
-            col_inx_[nz] = base_beta_var_ + arc;
+    void ctsp_sync_checker::restore_basis_(const vector<double> &x)
+    {
+        if (basis_cache_ == nullptr)
+            return;
 
-            const double val{x[arc]};
+        active_.clear();
 
-            if (fabs(val) > tol_)
-            {
-                const double x_val{truncate_(val)};
-                coef_val_[nz] = x_val;
-            }
-            else
+        // Distance to the routing of the previous check (its basis is kept)
+        size_t current{x_.size() == n_routing_arcs_ ? 0 : n_routing_arcs_ + 1};
+
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+        {
+            const bool active{x_val_(x[i]) != 0.0};
+
+            if (active)
+                active_.push_back((int)i);
+
+            if (x_.size() == n_routing_arcs_ && active != (x_[i] != 0.0))
+                current++;
+        }
+
+        size_t distance{0};
+        const cached_basis *entry{basis_cache_->find_nearest(active_, current, distance)};
+
+        if (entry != nullptr && set_basis(entry->col_stat_, entry->row_stat_))
+            n_basis_restores_++;
+    }
+
+    void ctsp_sync_checker::restore_basis_(const sparse_x &x)
+    {
+        if (basis_cache_ == nullptr)
+            return;
+
+        active_.clear();
+
+        for (size_t q{0}; q < x.size(); q++)
+        {
+            if (x_val_(x.get_value(q)) != 0.0)
+                active_.push_back(x.get_index(q));
+        }
+
+        // Distance to the routing of the previous check: active sets differ
+        size_t current{n_routing_arcs_ + 1};
+
+        if (x_.size() == n_routing_arcs_)
+        {
+            load_support_();
+
+            size_t p{0};
+            size_t q{0};
+            size_t n_common{0};
+
+            while (p < active_.size() && q < support_.size())
             {
-                coef_val_[nz] = 0.0;
+                if (active_[p] < support_[q])
+                    p++;
+                else if (support_[q] < active_[p])
+                    q++;
+                else
+                {
+                    n_common++;
+                    p++;
+                    q++;
+                }
             }
 
-            nz++;
+            current = active_.size() + support_.size() - 2 * n_common;
         }
+
+        size_t distance{0};
+        const cached_basis *entry{basis_cache_->find_nearest(active_, current, distance)};
+
+        if (entry != nullptr && set_basis(entry->col_stat_, entry->row_stat_))
+            n_basis_restores_++;
     }
 
-    void ctsp_sync_checker::x_2_coef_(const vector<double> &x)
+    void ctsp_sync_checker::store_basis_(void)
     {
-        int nz{0};
+        if (basis_cache_ == nullptr || truncated_ || get_lp_stat() != 1)
+            return;
 
-        for (size_t i{0}; i < n_operations_; i++)
+        if (get_basis(col_stat_, row_stat_))
+            basis_cache_->store(active_, col_stat_, row_stat_);
+    }
+
+    size_t ctsp_sync_checker::get_instance_key(void) const
+    {
+        active_set_hash hasher;
+
+        vector<int> key{(int)n_operations_, (int)n_routing_arcs_, (int)n_sync_arcs_, (int)n_col_};
+
+        const vector<triplet> &routing_arcs{model_->get_routing_arcs()};
+
+        for (size_t a{0}; a < n_routing_arcs_; a++)
         {
-            x_2_alpha_coef_(x, i, nz);
-            x_2_beta_coef_(x, i, nz);
+            key.push_back(routing_arcs[a].i_);
+            key.push_back(routing_arcs[a].j_);
+            key.push_back((int)round(routing_arc_resources_[a] * precision_));
         }
 
-        set_coef(nz, row_inx_, col_inx_, coef_val_);
+        return hasher(key);
     }
 
-    void ctsp_sync_checker::x_2_obj_(const vector<double> &x)
+    void ctsp_sync_checker::update_x(const vector<int> &changed_arcs, const vector<double> &new_values)
     {
-        int nz{0};
+        assert(x_.size() == n_routing_arcs_);
+        assert(changed_arcs.size() == new_values.size());
 
-        x_2_alpha_obj_(x, nz);
-        x_2_beta_obj_(x, nz);
+        if (changed_arcs.empty())
+            return;
 
-        set_obj(coef_val_, col_inx_, nz);
+        support_valid_ = false;
+
+        if (n_alpha_var_ > 0 && n_beta_var_ > 0)
+            update_x_t_<true, true>(changed_arcs, new_values);
+        else if (n_alpha_var_ > 0)
+            update_x_t_<true, false>(changed_arcs, new_values);
+        else if (n_beta_var_ > 0)
+            update_x_t_<false, true>(changed_arcs, new_values);
+        else
+            update_x_t_<false, false>(changed_arcs, new_values);
     }
 
-    void ctsp_sync_checker::x_2_alpha_obj_(const vector<double> &x, int &nz)
+    template <bool ALPHA, bool BETA>
+    void ctsp_sync_checker::update_x_t_(const vector<int> &changed_arcs, const vector<double> &new_values)
     {
-        if (n_alpha_var_ == 0)
-            return;
+        const size_t n_changed{changed_arcs.size()};
 
-        for (size_t i{0}; i < n_routing_arcs_; i++)
+        const int depot_thrld{2 * static_cast<int>(n_depots_)};
+        const vector<triplet> &routing_arcs{model_->get_routing_arcs()};
+
+        int nz{0};
+
+        for (size_t k{0}; k < n_changed; k++)
         {
-            const double val{x[i]};
-            col_inx_[nz] = (int)(base_alpha_var_ + i);
+            const int arc{changed_arcs[k]};
 
-            if (fabs(val) > tol_)
+            assert(arc < (int)n_routing_arcs_);
+
+            const double x_val{x_val_(new_values[k])};
+
+            x_[arc] = x_val;
+
+            if (ALPHA)
             {
-                const double x_val{truncate_(val)};
-                const double coef{truncate_(-routing_arc_resources_[i] * x_val)};
-                coef_val_[nz] = coef;
+                col_inx_[nz] = (int)(base_alpha_var_ + arc);
+                coef_val_[nz] = x_val != 0.0 ? truncate_(-routing_arc_resources_[arc] * x_val) : 0.0;
+                nz++;
             }
-            else
+
+            if (BETA)
+            {
+                col_inx_[nz] = (int)(base_beta_var_ + arc);
+                coef_val_[nz] = routing_arcs[arc].j_ < depot_thrld ? 1E100 : (x_val != 0.0 ? truncate_(routing_arc_resources_[arc] * x_val) : 0.0);
+                nz++;
+            }
+        }
+
+        set_obj(coef_val_, col_inx_, nz);
+
+        nz = 0;
+
+        for (size_t k{0}; k < n_changed; k++)
+        {
+            const int arc{changed_arcs[k]};
+            const triplet &a{routing_arcs[arc]};
+
+            if (ALPHA)
             {
-                coef_val_[nz] = 0.0;
+                row_inx_[nz] = a.i_;
+                col_inx_[nz] = (int)(base_alpha_var_ + arc);
+                coef_val_[nz] = x_[arc];
+                nz++;
             }
 
-            nz++;
+            if (BETA)
+            {
+                row_inx_[nz] = a.j_;
+                col_inx_[nz] = (int)(base_beta_var_ + arc);
+                coef_val_[nz] = x_[arc];
+                nz++;
+            }
         }
+
+        set_coef(nz, row_inx_, col_inx_, coef_val_);
     }
 
-    void ctsp_sync_checker::x_2_beta_obj_(const vector<double> &x, int &nz)
+    void ctsp_sync_checker::update_sync_arc_times(const sync_model_a_builder &builder)
     {
-        if (n_beta_var_ == 0)
-            return;
+        const vector<double> &sync_arc_times{builder.get_sync_arc_times()};
 
-        const int depot_thrld{2 * static_cast<int>(n_depots_)};
+        assert(sync_arc_times.size() == n_gamma_var_);
 
-        for (size_t i{0}; i < n_routing_arcs_; i++)
+        // Same objective as the gamma constraints RHS of ctsp_primal_model
+        for (size_t i{0}; i < n_gamma_var_; i++)
         {
-            const triplet &arc{routing_arcs_[i]};
-            const int t{arc.j_};
+            const double w_h_p_j{sync_arc_times[i]};
 
-            col_inx_[nz] = (int)(base_beta_var_ + i);
+            col_inx_[i] = (int)(base_gamma_var_ + i);
+            coef_val_[i] = w_h_p_j < INF_MD_THRLD ? w_h_p_j : 0.0;
+        }
 
-            if (t >= depot_thrld)
-            {
+        set_obj(coef_val_, col_inx_, (int)n_gamma_var_);
+    }
 
-                const double val{x[i]};
+    void ctsp_sync_checker::x_2_coef_(const vector<double> &x)
+    {
+        if (n_alpha_var_ > 0 && n_beta_var_ > 0)
+            x_2_coef_t_<true, true>(x);
+        else if (n_alpha_var_ > 0)
+            x_2_coef_t_<true, false>(x);
+        else if (n_beta_var_ > 0)
+            x_2_coef_t_<false, true>(x);
+        else
+            x_2_coef_t_<false, false>(x);
+    }
+
+    template <bool ALPHA, bool BETA>
+    void ctsp_sync_checker::x_2_coef_t_(const vector<double> &x)
+    {
+        const vector<vector<int>> &routing_outbound_arcs{model_->get_routing_outbound_arcs()};
+        const vector<vector<int>> &routing_inbound_arcs{model_->get_routing_inbound_arcs()};
+
+        int nz{0};
 
-                if (fabs(val) > tol_)
+        for (size_t i{0}; i < n_operations_; i++)
+        {
+            // α rows: outgoing arcs of operation i
+            if (ALPHA)
+            {
+                for (const int arc : routing_outbound_arcs[i])
                 {
-                    const double x_val{truncate_(val)};
-                    const double coef{truncate_(routing_arc_resources_[i] * x_val)};
-                    coef_val_[nz] = coef;
+                    assert(arc < (int)n_routing_arcs_);
+
+                    row_inx_[nz] = (int)i;
+                    col_inx_[nz] = (int)(base_alpha_var_ + arc);
+                    coef_val_[nz] = x_val_(x[arc]);
+                    nz++;
                 }
-                else
+            }
+
+            // β rows: incoming arcs of operation i
+            if (BETA)
+            {
+                for (const int arc : routing_inbound_arcs[i])
                 {
-                    coef_val_[nz] = 0.0;
+                    assert(arc < (int)n_routing_arcs_);
+
+                    row_inx_[nz] = (int)i;
+                    col_inx_[nz] = (int)(base_beta_var_ + arc);
+                    coef_val_[nz] = x_val_(x[arc]);
+                    nz++;
                 }
             }
-            else
+        }
+
+        set_coef(nz, row_inx_, col_inx_, coef_val_);
+    }
+
+    void ctsp_sync_checker::x_2_obj_(const vector<double> &x)
+    {
+        if (n_alpha_var_ > 0 && n_beta_var_ > 0)
+            x_2_obj_t_<true, true>(x);
+        else if (n_alpha_var_ > 0)
+            x_2_obj_t_<true, false>(x);
+        else if (n_beta_var_ > 0)
+            x_2_obj_t_<false, true>(x);
+        else
+            x_2_obj_t_<false, false>(x);
+    }
+
+    template <bool ALPHA, bool BETA>
+    void ctsp_sync_checker::x_2_obj_t_(const vector<double> &x)
+    {
+        int nz{0};
+
+        if (ALPHA)
+        {
+            for (size_t i{0}; i < n_routing_arcs_; i++)
             {
-                coef_val_[nz] = 1E100;
+                const double x_val{x_val_(x[i])};
+
+                col_inx_[nz] = (int)(base_alpha_var_ + i);
+                coef_val_[nz] = x_val != 0.0 ? truncate_(-routing_arc_resources_[i] * x_val) : 0.0;
+                nz++;
             }
+        }
 
-            nz++;
+        if (BETA)
+        {
+            const int depot_thrld{2 * static_cast<int>(n_depots_)};
+            const vector<triplet> &routing_arcs{model_->get_routing_arcs()};
+
+            for (size_t i{0}; i < n_routing_arcs_; i++)
+            {
+                const double x_val{x_val_(x[i])};
+
+                // Only arcs into a final depot carry the route duration
+                col_inx_[nz] = (int)(base_beta_var_ + i);
+                coef_val_[nz] = routing_arcs[i].j_ < depot_thrld ? 1E100 : (x_val != 0.0 ? truncate_(routing_arc_resources_[i] * x_val) : 0.0);
+                nz++;
+            }
         }
+
+        set_obj(coef_val_, col_inx_, nz);
     }
 
     void ctsp_sync_checker::get_s_(double *s, vector<double> &s_vec) const
@@ -0,0 +1,269 @@
+/**
+ * @file lp_basis_cache.cpp
+ * @brief Implementation of the LP basis cache
+ */
+
+#include "lp_basis_cache.hpp"
+
+#include <fstream>
+
+#define BASIS_CACHE_MAGIC "CTSP_BASIS_CACHE"
+#define BASIS_CACHE_VERSION 1
+
+namespace SYNC_LIB
+{
+    lp_basis_cache::lp_basis_cache(const size_t instance_key, const size_t capacity) : instance_key_(instance_key),
+                                                                                       capacity_(capacity > 0 ? capacity : 1),
+                                                                                       clock_(0),
+                                                                                       entries_(),
+                                                                                       index_(),
+                                                                                       n_lookups_(0),
+                                                                                       n_exact_hits_(0),
+                                                                                       n_near_hits_(0)
+    {
+    }
+
+    lp_basis_cache::~lp_basis_cache(void)
+    {
+    }
+
+    void lp_basis_cache::clear(void)
+    {
+        entries_.clear();
+        index_.clear();
+
+        clock_ = 0;
+        n_lookups_ = 0;
+        n_exact_hits_ = 0;
+        n_near_hits_ = 0;
+    }
+
+    size_t lp_basis_cache::distance(const vector<int> &a, const vector<int> &b, const size_t bound)
+    {
+        // The size difference is a lower bound of the symmetric difference
+        const size_t size_gap{a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()};
+
+        if (size_gap >= bound)
+            return bound;
+
+        size_t n_diff{0};
+        size_t i{0};
+        size_t j{0};
+
+        while (i < a.size() && j < b.size())
+        {
+            if (a[i] == b[j])
+            {
+                i++;
+                j++;
+                continue;
+            }
+
+            if (a[i] < b[j])
+                i++;
+            else
+                j++;
+
+            if (++n_diff >= bound)
+                return bound;
+        }
+
+        n_diff += (a.size() - i) + (b.size() - j);
+
+        return n_diff < bound ? n_diff : bound;
+    }
+
+    const cached_basis *lp_basis_cache::find_nearest(const vector<int> &active, const size_t max_distance, size_t &distance)
+    {
+        n_lookups_++;
+        clock_++;
+
+        distance = max_distance;
+
+        if (max_distance == 0)
+            return nullptr;
+
+        const auto it{index_.find(active)};
+
+        if (it != index_.end())
+        {
+            cached_basis &entry{entries_[it->second]};
+
+            entry.last_use_ = clock_;
+            distance = 0;
+            n_exact_hits_++;
+
+            return &entry;
+        }
+
+        size_t best{entries_.size()};
+
+        for (size_t k{0}; k < entries_.size(); k++)
+        {
+            const size_t d{lp_basis_cache::distance(active, entries_[k].active_, distance)};
+
+            if (d < distance)
+            {
+                distance = d;
+                best = k;
+            }
+        }
+
+        if (best == entries_.size())
+            return nullptr;
+
+        entries_[best].last_use_ = clock_;
+        n_near_hits_++;
+
+        return &entries_[best];
+    }
+
+    void lp_basis_cache::store(const vector<int> &active, const vector<int> &col_stat, const vector<int> &row_stat)
+    {
+        clock_++;
+
+        const auto it{index_.find(active)};
+
+        if (it != index_.end())
+        {
+            cached_basis &entry{entries_[it->second]};
+
+            entry.col_stat_ = col_stat;
+            entry.row_stat_ = row_stat;
+            entry.last_use_ = clock_;
+
+            return;
+        }
+
+        size_t k{entries_.size()};
+
+        if (entries_.size() < capacity_)
+        {
+            entries_.push_back(cached_basis());
+        }
+        else
+        {
+            // Evict the least recently used entry
+            k = 0;
+
+            for (size_t l{1}; l < entries_.size(); l++)
+            {
+                if (entries_[l].last_use_ < entries_[k].last_use_)
+                    k = l;
+            }
+
+            index_.erase(entries_[k].active_);
+        }
+
+        cached_basis &entry{entries_[k]};
+
+        entry.active_ = active;
+        entry.col_stat_ = col_stat;
+        entry.row_stat_ = row_stat;
+        entry.last_use_ = clock_;
+
+        index_.emplace(active, k);
+    }
+
+    bool lp_basis_cache::save(const string &filename) const
+    {
+        ofstream os(filename);
+
+        if (!os)
+            return false;
+
+        os << BASIS_CACHE_MAGIC << " " << BASIS_CACHE_VERSION << endl;
+        os << "instance " << instance_key_ << endl;
+        os << "entries " << entries_.size() << endl;
+
+        // One line per set: size, then items; statuses as one digit each
+        for (const cached_basis &entry : entries_)
+        {
+            os << entry.active_.size();
+
+            for (const int arc : entry.active_)
+                os << " " << arc;
+
+            os << endl;
+
+            os << entry.col_stat_.size() << " ";
+
+            for (const int stat : entry.col_stat_)
+                os << (char)('0' + stat);
+
+            os << endl;
+
+            os << entry.row_stat_.size() << " ";
+
+            for (const int stat : entry.row_stat_)
+                os << (char)('0' + stat);
+
+            os << endl;
+        }
+
+        return (bool)os;
+    }
+
+    bool lp_basis_cache::read_stats_(istream &is, vector<int> &stat)
+    {
+        size_t n_stat{0};
+        string stats;
+
+        is >> n_stat;
+
+        if (n_stat > 0)
+            is >> stats;
+
+        if (!is || stats.size() != n_stat)
+            return false;
+
+        stat.resize(n_stat);
+
+        for (size_t i{0}; i < n_stat; i++)
+            stat[i] = stats[i] - '0';
+
+        return true;
+    }
+
+    bool lp_basis_cache::load(const string &filename)
+    {
+        ifstream is(filename);
+
+        if (!is)
+            return false;
+
+        string magic;
+        int version{0};
+        string key_s;
+        size_t instance_key{0};
+        string entries_s;
+        size_t n_entries{0};
+
+        is >> magic >> version >> key_s >> instance_key >> entries_s >> n_entries;
+
+        if (!is || magic != BASIS_CACHE_MAGIC || version != BASIS_CACHE_VERSION || instance_key != instance_key_)
+            return false;
+
+        vector<int> active;
+        vector<int> col_stat;
+        vector<int> row_stat;
+
+        for (size_t k{0}; k < n_entries; k++)
+        {
+            size_t n_active{0};
+            is >> n_active;
+
+            active.resize(n_active);
+
+            for (size_t i{0}; i < n_active; i++)
+                is >> active[i];
+
+            if (!is || !read_stats_(is, col_stat) || !read_stats_(is, row_stat))
+                return false;
+
+            store(active, col_stat, row_stat);
+        }
+
+        return true;
+    }
+}
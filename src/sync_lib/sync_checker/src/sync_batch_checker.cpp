@@ -0,0 +1,419 @@
+/**
+ * @file sync_batch_checker.cpp
+ * @brief Implementation of the lane-parallel negative cycle checker
+ */
+
+#include "sync_batch_checker.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    sync_batch_checker::sync_batch_checker(const sync_model_a_builder &builder, const double tol) : tol_(tol),
+                                                                                                   precision_(1E3),
+                                                                                                   n_operations_(builder.get_n_operations()),
+                                                                                                   n_routing_arcs_(builder.get_n_routing_arcs()),
+                                                                                                   model_(builder.get_snapshot()),
+                                                                                                   routing_arc_cost_(),
+                                                                                                   sync_head_(),
+                                                                                                   sync_from_(),
+                                                                                                   sync_cost_(),
+                                                                                                   dist_(n_operations_),
+                                                                                                   pred_(n_operations_),
+                                                                                                   succ_(n_operations_),
+                                                                                                   tail_(n_operations_),
+                                                                                                   cost_(n_operations_),
+                                                                                                   mark_(n_operations_),
+                                                                                                   max_rounds_(numeric_limits<size_t>::max()),
+                                                                                                   cycle_check_(4),
+                                                                                                   fallback_(builder, tol),
+                                                                                                   n_checks_(0),
+                                                                                                   n_rounds_(0),
+                                                                                                   n_fallbacks_(0)
+    {
+        const vector<double> &routing_arc_times{builder.get_routing_arc_times()};
+
+        assert(routing_arc_times.size() == n_routing_arcs_);
+
+        // Same costs as sync_difference_checker
+        routing_arc_cost_.resize(n_routing_arcs_);
+
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+            routing_arc_cost_[a] = truncate_(-routing_arc_times[a]);
+
+        // Synchronization edges j -> i grouped by head i (pulled by relax_)
+        const vector<triplet> &sync_arcs{model_->get_sync_arcs()};
+
+        sync_head_.assign(n_operations_ + 1, 0);
+        sync_from_.resize(sync_arcs.size());
+
+        for (const triplet &arc : sync_arcs)
+            sync_head_[arc.i_ + 1]++;
+
+        for (size_t v{0}; v < n_operations_; v++)
+            sync_head_[v + 1] += sync_head_[v];
+
+        update_sync_arc_times(builder);
+    }
+
+    sync_batch_checker::~sync_batch_checker(void)
+    {
+    }
+
+    void sync_batch_checker::update_sync_arc_times(const sync_model_a_builder &builder)
+    {
+        const vector<double> &sync_arc_times{builder.get_sync_arc_times()};
+        const vector<triplet> &sync_arcs{model_->get_sync_arcs()};
+
+        assert(sync_arc_times.size() == sync_arcs.size());
+
+        vector<int> next(sync_head_.begin(), sync_head_.end() - 1);
+
+        sync_cost_.resize(sync_arcs.size());
+
+        for (size_t a{0}; a < sync_arcs.size(); a++)
+        {
+            const double w_h_p_j{sync_arc_times[a]};
+            const int e{next[sync_arcs[a].i_]++};
+
+            sync_from_[e] = sync_arcs[a].j_;
+            sync_cost_[e] = w_h_p_j < INF_MD_THRLD ? truncate_(w_h_p_j) : 0.0;
+        }
+
+        fallback_.update_sync_arc_times(builder);
+    }
+
+    uint32_t sync_batch_checker::load_lanes_(const vector<double> *const *xs, const size_t n)
+    {
+        const vector<triplet> &routing_arcs{model_->get_routing_arcs()};
+
+        uint32_t not_routes{0};
+
+        // Unused lanes pull nothing along routing edges: settled in one round
+        for (size_t i{0}; i < n_operations_; i++)
+        {
+            for (size_t l{0}; l < n_lanes; l++)
+            {
+                dist_[i].v_[l] = 0.0;
+                pred_[i].v_[l] = -1.0;
+                succ_[i].v_[l] = (int32_t)(i * n_lanes + l);
+                tail_[i].v_[l] = (double)i;
+                cost_[i].v_[l] = 0.0;
+            }
+        }
+
+        for (size_t l{0}; l < n; l++)
+        {
+            const vector<double> &x{*xs[l]};
+
+            assert(x.size() >= n_routing_arcs_);
+
+            for (size_t a{0}; a < n_routing_arcs_; a++)
+            {
+                if (x[a] < 1.0 - tol_)
+                    continue;
+
+                // Arc (i, j): edge j -> i, pulled by i
+                const triplet &arc{routing_arcs[a]};
+                int32_t &succ{succ_[arc.i_].v_[l]};
+
+                if (succ != (int32_t)(arc.i_ * n_lanes + l))
+                {
+                    not_routes |= 1u << l;
+                    break;
+                }
+
+                succ = (int32_t)(arc.j_ * n_lanes + l);
+                tail_[arc.i_].v_[l] = (double)arc.j_;
+                cost_[arc.i_].v_[l] = routing_arc_cost_[a];
+            }
+        }
+
+        return not_routes;
+    }
+
+    uint32_t sync_batch_checker::relax_(const int i)
+    {
+        // Costs and potentials are multiples of 1/precision_: eps only
+        // absorbs rounding, as in sync_difference_checker
+        const double eps{0.5 / precision_};
+
+        const double *dist{dist_[0].v_};
+        double *d_i{dist_[i].v_};
+        double *p_i{pred_[i].v_};
+
+        const int32_t *succ{succ_[i].v_};
+        const double *tail{tail_[i].v_};
+        const double *cost{cost_[i].v_};
+
+#if defined(__AVX512F__)
+        // Routing edge (gathered), then the shared synchronization edges.
+        // Masked gather: the plain one reads an undefined source, which GCC
+        // reports as uninitialized
+        __m512d m{_mm512_add_pd(_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, _mm256_load_si256((const __m256i *)succ), dist, 8),
+                                _mm512_load_pd(cost))};
+        __m512d p{_mm512_load_pd(tail)};
+
+        for (int e{sync_head_[i]}; e < sync_head_[i + 1]; e++)
+        {
+            const int j{sync_from_[e]};
+            const __m512d c{_mm512_add_pd(_mm512_load_pd(dist_[j].v_), _mm512_set1_pd(sync_cost_[e]))};
+            const __mmask8 lower{_mm512_cmp_pd_mask(c, m, _CMP_LT_OQ)};
+
+            m = _mm512_mask_mov_pd(m, lower, c);
+            p = _mm512_mask_mov_pd(p, lower, _mm512_set1_pd((double)j));
+        }
+
+        const __m512d old{_mm512_load_pd(d_i)};
+        const __mmask8 lowered{_mm512_cmp_pd_mask(m, _mm512_sub_pd(old, _mm512_set1_pd(eps)), _CMP_LT_OQ)};
+
+        _mm512_mask_store_pd(d_i, lowered, m);
+        _mm512_mask_store_pd(p_i, lowered, p);
+
+        return (uint32_t)lowered;
+#elif defined(__AVX2__)
+        // Lanes 0-3 (lo) and 4-7 (hi). Masked gathers: the plain ones read
+        // an undefined source, which GCC reports as uninitialized
+        const __m256d all{_mm256_castsi256_pd(_mm256_set1_epi64x(-1))};
+
+        __m256d m_lo{_mm256_add_pd(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), dist, _mm_load_si128((const __m128i *)succ), all, 8),
+                                   _mm256_load_pd(cost))};
+        __m256d m_hi{_mm256_add_pd(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), dist, _mm_load_si128((const __m128i *)(succ + 4)), all, 8),
+                                   _mm256_load_pd(cost + 4))};
+        __m256d p_lo{_mm256_load_pd(tail)};
+        __m256d p_hi{_mm256_load_pd(tail + 4)};
+
+        for (int e{sync_head_[i]}; e < sync_head_[i + 1]; e++)
+        {
+            const int j{sync_from_[e]};
+            const double *d_j{dist_[j].v_};
+            const __m256d w{_mm256_set1_pd(sync_cost_[e])};
+            const __m256d v_j{_mm256_set1_pd((double)j)};
+
+            const __m256d c_lo{_mm256_add_pd(_mm256_load_pd(d_j), w)};
+            const __m256d c_hi{_mm256_add_pd(_mm256_load_pd(d_j + 4), w)};
+            const __m256d lower_lo{_mm256_cmp_pd(c_lo, m_lo, _CMP_LT_OQ)};
+            const __m256d lower_hi{_mm256_cmp_pd(c_hi, m_hi, _CMP_LT_OQ)};
+
+            m_lo = _mm256_blendv_pd(m_lo, c_lo, lower_lo);
+            m_hi = _mm256_blendv_pd(m_hi, c_hi, lower_hi);
+            p_lo = _mm256_blendv_pd(p_lo, v_j, lower_lo);
+            p_hi = _mm256_blendv_pd(p_hi, v_j, lower_hi);
+        }
+
+        const __m256d v_eps{_mm256_set1_pd(eps)};
+        const __m256d old_lo{_mm256_load_pd(d_i)};
+        const __m256d old_hi{_mm256_load_pd(d_i + 4)};
+        const __m256d lowered_lo{_mm256_cmp_pd(m_lo, _mm256_sub_pd(old_lo, v_eps), _CMP_LT_OQ)};
+        const __m256d lowered_hi{_mm256_cmp_pd(m_hi, _mm256_sub_pd(old_hi, v_eps), _CMP_LT_OQ)};
+
+        _mm256_store_pd(d_i, _mm256_blendv_pd(old_lo, m_lo, lowered_lo));
+        _mm256_store_pd(d_i + 4, _mm256_blendv_pd(old_hi, m_hi, lowered_hi));
+        _mm256_store_pd(p_i, _mm256_blendv_pd(_mm256_load_pd(p_i), p_lo, lowered_lo));
+        _mm256_store_pd(p_i + 4, _mm256_blendv_pd(_mm256_load_pd(p_i + 4), p_hi, lowered_hi));
+
+        return (uint32_t)(_mm256_movemask_pd(lowered_lo) | (_mm256_movemask_pd(lowered_hi) << 4));
+#else
+        double m[n_lanes];
+        double p[n_lanes];
+
+        for (size_t l{0}; l < n_lanes; l++)
+        {
+            m[l] = dist[succ[l]] + cost[l];
+            p[l] = tail[l];
+        }
+
+        for (int e{sync_head_[i]}; e < sync_head_[i + 1]; e++)
+        {
+            const int j{sync_from_[e]};
+            const double *d_j{dist_[j].v_};
+            const double w{sync_cost_[e]};
+
+            for (size_t l{0}; l < n_lanes; l++)
+            {
+                if (d_j[l] + w < m[l])
+                {
+                    m[l] = d_j[l] + w;
+                    p[l] = (double)j;
+                }
+            }
+        }
+
+        uint32_t lowered{0};
+
+        for (size_t l{0}; l < n_lanes; l++)
+        {
+            if (m[l] < d_i[l] - eps)
+            {
+                d_i[l] = m[l];
+                p_i[l] = p[l];
+                lowered |= 1u << l;
+            }
+        }
+
+        return lowered;
+#endif
+    }
+
+    uint32_t sync_batch_checker::round_(const bool forward)
+    {
+        const int n{static_cast<int>(n_operations_)};
+
+        uint32_t lowered{0};
+
+        // Gauss-Seidel: potentials lowered earlier in the round are pulled at once
+        if (forward)
+        {
+            for (int i{0}; i < n; i++)
+                lowered |= relax_(i);
+        }
+        else
+        {
+            for (int i{n - 1}; i >= 0; i--)
+                lowered |= relax_(i);
+        }
+
+        n_rounds_++;
+
+        return lowered;
+    }
+
+    bool sync_batch_checker::has_pred_cycle_(const size_t l)
+    {
+        // 0: not visited, 1: on the current walk, 2: done
+        fill(mark_.begin(), mark_.end(), 0);
+
+        const int n{static_cast<int>(n_operations_)};
+
+        for (int v{0}; v < n; v++)
+        {
+            if (mark_[v] != 0)
+                continue;
+
+            int u{v};
+
+            while (u >= 0 && mark_[u] == 0)
+            {
+                mark_[u] = 1;
+                u = (int)pred_[u].v_[l];
+            }
+
+            if (u >= 0 && mark_[u] == 1)
+                return true;
+
+            u = v;
+
+            while (u >= 0 && mark_[u] == 1)
+            {
+                mark_[u] = 2;
+                u = (int)pred_[u].v_[l];
+            }
+        }
+
+        return false;
+    }
+
+    uint32_t sync_batch_checker::check_lanes(const vector<double> *const *xs, const size_t n)
+    {
+        assert(n <= n_lanes);
+
+        const uint32_t used{(1u << n) - 1};
+        const uint32_t not_routes{load_lanes_(xs, n)};
+
+        uint32_t feasible{0};
+        uint32_t open{used & ~not_routes};
+
+        // Bellman-Ford: a lane still lowered after n_operations + 1 rounds
+        // has a negative cycle
+        const size_t n_max{min(max_rounds_, n_operations_ + 1)};
+
+        size_t r{0};
+
+        while (r < n_max && open != 0)
+        {
+            const uint32_t lowered{round_(r % 2 == 0)};
+
+            r++;
+
+            // A round without change is a fixed point: no change afterwards
+            feasible |= open & ~lowered;
+            open &= lowered;
+
+            if (r % cycle_check_ != 0)
+                continue;
+
+            for (size_t l{0}; l < n; l++)
+            {
+                if ((open & (1u << l)) && has_pred_cycle_(l))
+                    open &= ~(1u << l);
+            }
+        }
+
+        // Lanes still open after every round have a negative cycle
+        uint32_t unsettled{not_routes};
+
+        if (r < n_operations_ + 1)
+            unsettled |= open;
+
+        for (size_t l{0}; l < n; l++)
+        {
+            if (unsettled & (1u << l))
+            {
+                n_fallbacks_++;
+
+                if (fallback_.is_feasible_(*xs[l]))
+                    feasible |= 1u << l;
+            }
+        }
+
+        n_checks_ += n;
+
+        return feasible & used;
+    }
+
+    size_t sync_batch_checker::check(const vector<vector<double>> &xs, vector<char> &feasible)
+    {
+        feasible.assign(xs.size(), 0);
+
+        const vector<double> *lanes[n_lanes];
+        size_t n_feasible{0};
+
+        for (size_t first{0}; first < xs.size(); first += n_lanes)
+        {
+            const size_t n{min(n_lanes, xs.size() - first)};
+
+            for (size_t l{0}; l < n; l++)
+                lanes[l] = &xs[first + l];
+
+            const uint32_t bits{check_lanes(lanes, n)};
+
+            for (size_t l{0}; l < n; l++)
+            {
+                if (bits & (1u << l))
+                {
+                    feasible[first + l] = 1;
+                    n_feasible++;
+                }
+            }
+        }
+
+        return n_feasible;
+    }
+
+    size_t sync_batch_checker::get_memory_bytes(void) const
+    {
+        return routing_arc_cost_.capacity() * sizeof(double) +
+               sync_head_.capacity() * sizeof(int) + sync_from_.capacity() * sizeof(int) +
+               sync_cost_.capacity() * sizeof(double) +
+               (dist_.capacity() + pred_.capacity() + tail_.capacity() + cost_.capacity()) * sizeof(lane_values) +
+               succ_.capacity() * sizeof(lane_indices) + mark_.capacity();
+    }
+}
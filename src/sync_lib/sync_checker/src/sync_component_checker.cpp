@@ -0,0 +1,373 @@
+#include "sync_component_checker.hpp"
+#include "sync_checker_solver.hpp"
+#include "trace_recorder.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    sync_component_checker::sync_component_checker(const sync_model_a_builder &builder, const double tol, const size_t n_threads) : tol_(tol),
+                                                                                                                                    precision_(1E3),
+                                                                                                                                    n_operations_(builder.get_n_operations()),
+                                                                                                                                    n_routing_arcs_(builder.get_n_routing_arcs()),
+                                                                                                                                    n_sync_arcs_(builder.get_n_sync_arcs()),
+                                                                                                                                    routing_arcs_(builder.get_routing_arcs()),
+                                                                                                                                    routing_arc_times_(builder.get_routing_arc_times()),
+                                                                                                                                    sync_arcs_(builder.get_sync_arcs()),
+                                                                                                                                    sync_arc_times_(builder.get_sync_arc_times()),
+                                                                                                                                    builder_(builder),
+                                                                                                                                    operation_names_(builder.get_operation_names()),
+                                                                                                                                    n_threads_(n_threads),
+                                                                                                                                    feasibility_only_(false),
+                                                                                                                                    deadline_(NULL),
+                                                                                                                                    truncated_(false),
+                                                                                                                                    x_(n_routing_arcs_, 0.0),
+                                                                                                                                    parent_(n_operations_),
+                                                                                                                                    component_(n_operations_, -1),
+                                                                                                                                    local_row_(n_operations_, -1),
+                                                                                                                                    n_lps_(0)
+    {
+        assert(routing_arc_times_.size() == n_routing_arcs_);
+        assert(sync_arc_times_.size() == n_sync_arcs_);
+    }
+
+    sync_component_checker::~sync_component_checker(void)
+    {
+    }
+
+    int sync_component_checker::find_(int i)
+    {
+        while (parent_[i] != i)
+        {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+
+        return i;
+    }
+
+    void sync_component_checker::find_components_(void)
+    {
+        for (size_t i{0}; i < n_operations_; i++)
+            parent_[i] = (int)i;
+
+        // Active routing arcs and every sync arc join their end operations
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+        {
+            if (x_[a] == 0.0)
+                continue;
+
+            const int r_i{find_(routing_arcs_[a].i_)};
+            const int r_j{find_(routing_arcs_[a].j_)};
+
+            if (r_i != r_j)
+                parent_[r_i] = r_j;
+        }
+
+        for (size_t a{0}; a < n_sync_arcs_; a++)
+        {
+            const int r_i{find_(sync_arcs_[a].i_)};
+            const int r_j{find_(sync_arcs_[a].j_)};
+
+            if (r_i != r_j)
+                parent_[r_i] = r_j;
+        }
+
+        // Number the components in order of their first operation
+        component_operations_.clear();
+        component_.assign(n_operations_, -1);
+
+        for (size_t i{0}; i < n_operations_; i++)
+        {
+            const int r{find_((int)i)};
+
+            if (component_[r] < 0)
+            {
+                component_[r] = (int)component_operations_.size();
+                component_operations_.push_back(vector<int>());
+            }
+
+            const int k{component_[r]};
+
+            component_[i] = k;
+            local_row_[i] = (int)component_operations_[k].size();
+            component_operations_[k].push_back((int)i);
+        }
+
+        const size_t n_components{component_operations_.size()};
+
+        component_routing_arcs_.assign(n_components, vector<int>());
+        component_sync_arcs_.assign(n_components, vector<int>());
+
+        // An inactive α column only has the -1 of its head row
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+            component_routing_arcs_[component_[routing_arcs_[a].j_]].push_back((int)a);
+
+        for (size_t a{0}; a < n_sync_arcs_; a++)
+            component_sync_arcs_[component_[sync_arcs_[a].j_]].push_back((int)a);
+    }
+
+    void sync_component_checker::build_model_(const size_t k, GOMA::model_description &model) const
+    {
+        const vector<int> &operations{component_operations_[k]};
+        const vector<int> &routing_arcs{component_routing_arcs_[k]};
+        const vector<int> &sync_arcs{component_sync_arcs_[k]};
+
+        const size_t n_row{operations.size()};
+        const size_t n_routing{routing_arcs.size()};
+        const size_t n_col{n_routing + sync_arcs.size()};
+
+        model.name_ = "SYNC_LIB_ctsp_lb_dual_component_model";
+        model.n_row_ = n_row;
+        model.n_col_ = n_col;
+
+        // Same bounds and senses as set_dual_ of ctsp_lb_primal_model: y in [0, 1], A y = 0
+        model.obj_.resize(n_col);
+        model.bd_.assign(n_col, GOMA::VarBnd::GBounded);
+        model.bounds_.assign(n_col, make_pair(0.0, 1.0));
+        model.sense_.assign(n_row, 'E');
+        model.rhs_.assign(n_row, 0.0);
+
+        model.M_.resize(n_row, n_col);
+        model.M_.reserve(2 * n_col);
+
+        int nz{0};
+
+        for (size_t c{0}; c < n_routing; c++)
+        {
+            const int arc{routing_arcs[c]};
+            const triplet &a{routing_arcs_[arc]};
+            const double x_val{x_[arc]};
+
+            model.obj_[c] = x_val != 0.0 ? truncate_(-routing_arc_times_[arc] * x_val) : 0.0;
+
+            if (x_val != 0.0)
+            {
+                model.M_.insert(local_row_[a.i_] + 1, c + 1, x_val);
+                nz++;
+            }
+
+            model.M_.insert(local_row_[a.j_] + 1, c + 1, -1);
+            nz++;
+        }
+
+        for (size_t c{n_routing}; c < n_col; c++)
+        {
+            const int arc{sync_arcs[c - n_routing]};
+            const triplet &a{sync_arcs_[arc]};
+            const double w_h_p_j{sync_arc_times_[arc]};
+
+            model.obj_[c] = w_h_p_j < INF_MD_THRLD ? w_h_p_j : 0.0;
+
+            model.M_.insert(local_row_[a.i_] + 1, c + 1, 1);
+            nz++;
+
+            model.M_.insert(local_row_[a.j_] + 1, c + 1, -1);
+            nz++;
+        }
+
+        model.M_.compress();
+        model.nz_ = nz;
+
+        assert(nz == model.M_.get_nz());
+
+        model.var_labels_.clear();
+        model.cons_labels_.clear();
+
+        if (GOMA::model_description::get_labels())
+        {
+            const vector<string> &routing_arc_names{builder_.get_routing_arc_names()};
+            const vector<string> &sync_arc_names{builder_.get_sync_arc_names()};
+
+            for (const int arc : routing_arcs)
+                model.var_labels_.push_back("alpha" + routing_arc_names[arc]);
+
+            for (const int arc : sync_arcs)
+                model.var_labels_.push_back("gamma" + sync_arc_names[arc]);
+
+            for (const int op : operations)
+                model.cons_labels_.push_back("Operation_" + operation_names_[op]);
+        }
+
+        model.obj_sense_ = GOMA::ObjSen::Minimize;
+        model.prob_type_ = GOMA::ProbType::LP;
+    }
+
+    void sync_component_checker::solve_component_(const size_t k)
+    {
+        const size_t n_row{component_operations_[k].size()};
+
+        s_[k].assign(n_row, 0.0);
+        y_[k].clear();
+
+        // A single operation has no cycle: s = 0 is feasible
+        if (n_row == 1)
+        {
+            feasible_[k] = true;
+            return;
+        }
+
+        GOMA::model_description model;
+        build_model_(k, model);
+
+        GOMA::sync_checker_solver solver(model, tol_);
+
+        if (feasibility_only_)
+            solver.set_obj_cutoff(-0.001);
+
+        solver.solve();
+
+        const int lp_stat{solver.get_lp_stat()};
+
+        if (lp_stat != 1 && lp_stat != GOMA::LP_STAT_OBJ_LIMIT)
+        {
+            assert(false);
+            cerr << (lp_stat == 2 ? "Unbounded" : "Error") << endl;
+            exit(0);
+        }
+
+        // A solve stopped by the cutoff is below the threshold
+        feasible_[k] = lp_stat == 1 && solver.get_obj() > -0.001;
+
+        if (feasible_[k])
+        {
+            solver.get_dual_vars(s_[k].data());
+        }
+        else
+        {
+            y_[k].resize(model.get_n_col());
+            solver.get_vars(y_[k].data());
+        }
+    }
+
+    void sync_component_checker::solve_worker_(atomic<size_t> &next_k)
+    {
+        const size_t n_components{component_operations_.size()};
+
+        for (size_t k{next_k++}; k < n_components; k = next_k++)
+        {
+            // The components left are not checked: no answer
+            if (deadline_ != NULL && deadline_->expired())
+            {
+                truncated_.store(true, memory_order_relaxed);
+                return;
+            }
+
+            GOMA::trace_scope trace("component", "checker");
+            solve_component_(k);
+        }
+    }
+
+    bool sync_component_checker::is_feasible_(const vector<double> &x)
+    {
+        assert(x.size() >= n_routing_arcs_);
+
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+            x_[i] = x_val_(x[i]);
+
+        find_components_();
+
+        const size_t n_components{component_operations_.size()};
+
+        feasible_.assign(n_components, true);
+        s_.resize(n_components);
+        y_.resize(n_components);
+
+        n_lps_ = 0;
+
+        for (const vector<int> &operations : component_operations_)
+        {
+            if (operations.size() > 1)
+                n_lps_++;
+        }
+
+        size_t n_threads{n_threads_ == 0 ? max(1u, thread::hardware_concurrency()) : n_threads_};
+        n_threads = min(n_threads, max(n_lps_, (size_t)1));
+
+        atomic<size_t> next_k{0};
+
+        truncated_.store(false, memory_order_relaxed);
+
+        vector<thread> workers;
+
+        for (size_t t{1}; t < n_threads; t++)
+            workers.push_back(thread(&sync_component_checker::solve_worker_, this, ref(next_k)));
+
+        solve_worker_(next_k);
+
+        for (thread &worker : workers)
+            worker.join();
+
+        if (truncated_.load(memory_order_relaxed))
+            return false;
+
+        return find(feasible_.begin(), feasible_.end(), false) == feasible_.end();
+    }
+
+    bool sync_component_checker::is_feasible(const vector<double> &x, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        const bool feasible{is_feasible_(x)};
+
+        if (!feasible)
+        {
+            get_alpha_beta_gamma(alpha, beta, gamma);
+        }
+
+        return feasible;
+    }
+
+    bool sync_component_checker::is_feasible(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        const bool feasible{is_feasible_(x)};
+
+        if (feasible)
+        {
+            get_s(s);
+        }
+        else
+        {
+            get_alpha_beta_gamma(alpha, beta, gamma);
+        }
+
+        return feasible;
+    }
+
+    void sync_component_checker::get_alpha_beta_gamma(vector<double> &alpha, vector<double> &, vector<double> &gamma) const
+    {
+        alpha.assign(n_routing_arcs_, 0.0);
+        gamma.assign(n_sync_arcs_, 0.0);
+
+        const size_t n_components{component_operations_.size()};
+
+        for (size_t k{0}; k < n_components; k++)
+        {
+            if (feasible_[k])
+                continue;
+
+            const vector<int> &routing_arcs{component_routing_arcs_[k]};
+            const vector<int> &sync_arcs{component_sync_arcs_[k]};
+            const vector<double> &y{y_[k]};
+
+            const size_t n_routing{routing_arcs.size()};
+
+            for (size_t c{0}; c < n_routing; c++)
+                alpha[routing_arcs[c]] = y[c];
+
+            for (size_t c{0}; c < sync_arcs.size(); c++)
+                gamma[sync_arcs[c]] = y[n_routing + c];
+        }
+    }
+
+    void sync_component_checker::get_s(vector<double> &s) const
+    {
+        s.resize(n_operations_);
+
+        for (size_t i{0}; i < n_operations_; i++)
+            s[i] = s_[component_[i]][local_row_[i]];
+    }
+}
@@ -0,0 +1,595 @@
+#include "sync_difference_checker.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    sync_difference_checker::sync_difference_checker(const sync_model_a_builder &builder, const double tol) : tol_(tol),
+                                                                                                             precision_(1E3),
+                                                                                                             n_operations_(0),
+                                                                                                             n_routing_arcs_(0),
+                                                                                                             n_sync_arcs_(0),
+                                                                                                             integer_(true),
+                                                                                                             units_(1.0),
+                                                                                                             sync_negative_icost_(0),
+                                                                                                             max_icost_(0),
+                                                                                                             type_(potential_type::DOUBLE),
+                                                                                                             floor_(0)
+    {
+        set(builder, tol);
+    }
+
+    sync_difference_checker::sync_difference_checker(void) : tol_(1E-3),
+                                                             precision_(1E3),
+                                                             n_operations_(0),
+                                                             n_routing_arcs_(0),
+                                                             n_sync_arcs_(0),
+                                                             integer_(true),
+                                                             units_(1.0),
+                                                             sync_negative_icost_(0),
+                                                             max_icost_(0),
+                                                             type_(potential_type::DOUBLE),
+                                                             floor_(0)
+    {
+    }
+
+    sync_difference_checker::~sync_difference_checker(void)
+    {
+    }
+
+    void sync_difference_checker::set(const sync_model_a_builder &builder, const double tol)
+    {
+        tol_ = tol;
+
+        n_operations_ = builder.get_n_operations();
+        n_routing_arcs_ = builder.get_n_routing_arcs();
+        n_sync_arcs_ = builder.get_n_sync_arcs();
+
+        model_ = builder.get_snapshot();
+
+        const vector<double> &routing_arc_times{builder.get_routing_arc_times()};
+
+        assert(routing_arc_times.size() == n_routing_arcs_);
+
+        // Same costs as the objective of ctsp_lb_dual_primal_model for x_ij = 1
+        routing_arc_cost_.resize(n_routing_arcs_);
+
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+        {
+            routing_arc_cost_[i] = truncate_(-routing_arc_times[i]);
+        }
+
+        update_sync_arc_times(builder);
+
+        const size_t max_edges{n_routing_arcs_ + n_sync_arcs_};
+
+        head_.resize(n_operations_ + 1);
+        degree_.resize(n_operations_);
+
+        edge_from_.resize(max_edges);
+        edge_to_.resize(max_edges);
+        edge_arc_.resize(max_edges);
+        edge_cost_.resize(max_edges);
+        edge_cost32_.resize(max_edges);
+        edge_cost64_.resize(max_edges);
+
+        dist_.resize(n_operations_);
+        dist32_.resize(n_operations_);
+        dist64_.resize(n_operations_);
+        pred_.resize(n_operations_);
+        queue_.resize(n_operations_);
+        in_queue_.resize(n_operations_);
+        mark_.resize(n_operations_);
+
+        cycle_.clear();
+    }
+
+    void sync_difference_checker::update_sync_arc_times(const sync_model_a_builder &builder)
+    {
+        const vector<double> &sync_arc_times{builder.get_sync_arc_times()};
+
+        assert(sync_arc_times.size() == n_sync_arcs_);
+
+        // Same RHS as the gamma constraints of ctsp_primal_model
+        sync_arc_cost_.resize(n_sync_arcs_);
+
+        for (size_t i{0}; i < n_sync_arcs_; i++)
+        {
+            const double w_h_p_j{sync_arc_times[i]};
+
+            sync_arc_cost_[i] = w_h_p_j < INF_MD_THRLD ? truncate_(w_h_p_j) : 0.0;
+        }
+
+        set_units_();
+    }
+
+    void sync_difference_checker::set_units_(void)
+    {
+        // Costs are multiples of 1/precision_; the time unit if all are integral
+        const double eps{0.5 / precision_};
+
+        bool integral{true};
+
+        for (const double c : routing_arc_cost_)
+            integral = integral && fabs(c - round(c)) < eps;
+
+        for (const double c : sync_arc_cost_)
+            integral = integral && fabs(c - round(c)) < eps;
+
+        units_ = integral ? 1.0 : precision_;
+
+        routing_arc_icost_.resize(n_routing_arcs_);
+        sync_arc_icost_.resize(n_sync_arcs_);
+
+        sync_negative_icost_ = 0;
+        max_icost_ = 0;
+
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+        {
+            routing_arc_icost_[i] = (int64_t)llround(routing_arc_cost_[i] * units_);
+            max_icost_ = max<int64_t>(max_icost_, llabs(routing_arc_icost_[i]));
+        }
+
+        for (size_t i{0}; i < n_sync_arcs_; i++)
+        {
+            sync_arc_icost_[i] = (int64_t)llround(sync_arc_cost_[i] * units_);
+            max_icost_ = max<int64_t>(max_icost_, llabs(sync_arc_icost_[i]));
+
+            if (sync_arc_icost_[i] < 0)
+                sync_negative_icost_ += sync_arc_icost_[i];
+        }
+    }
+
+    bool sync_difference_checker::is_integral(const vector<double> &x) const
+    {
+        for (size_t i{0}; i < n_routing_arcs_; i++)
+        {
+            const double val{x[i]};
+
+            if (fabs(val) > tol_ && fabs(val - 1.0) > tol_)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_difference_checker::is_integral(const sparse_x &x) const
+    {
+        for (const double val : x.get_values())
+        {
+            if (fabs(val) > tol_ && fabs(val - 1.0) > tol_)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_difference_checker::is_feasible_(const vector<double> &x)
+    {
+        assert(x.size() >= n_routing_arcs_);
+
+        build_graph_(x);
+
+        return shortest_paths_();
+    }
+
+    bool sync_difference_checker::is_feasible(const vector<double> &x, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        const bool feasible{is_feasible_(x)};
+
+        if (!feasible)
+        {
+            get_alpha_beta_gamma(alpha, beta, gamma);
+        }
+
+        return feasible;
+    }
+
+    bool sync_difference_checker::is_feasible(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        const bool feasible{is_feasible_(x)};
+
+        if (feasible)
+        {
+            get_s(s);
+        }
+        else
+        {
+            get_alpha_beta_gamma(alpha, beta, gamma);
+        }
+
+        return feasible;
+    }
+
+    void sync_difference_checker::get_alpha_beta_gamma(vector<double> &alpha, vector<double> &, vector<double> &gamma) const
+    {
+        alpha.assign(n_routing_arcs_, 0.0);
+        gamma.assign(n_sync_arcs_, 0.0);
+
+        for (const int arc : cycle_)
+        {
+            if (arc < (int)n_routing_arcs_)
+            {
+                alpha[arc] = 1.0;
+            }
+            else
+            {
+                gamma[arc - n_routing_arcs_] = 1.0;
+            }
+        }
+    }
+
+    void sync_difference_checker::get_s(vector<double> &s) const
+    {
+        s.resize(n_operations_);
+
+        if (n_operations_ == 0)
+            return;
+
+        if (type_ == potential_type::INT32)
+        {
+            const int32_t d_min{*min_element(dist32_.begin(), dist32_.end())};
+
+            for (size_t i{0}; i < n_operations_; i++)
+                s[i] = (double)(dist32_[i] - d_min) / units_;
+        }
+        else if (type_ == potential_type::INT64)
+        {
+            const int64_t d_min{*min_element(dist64_.begin(), dist64_.end())};
+
+            for (size_t i{0}; i < n_operations_; i++)
+                s[i] = (double)(dist64_[i] - d_min) / units_;
+        }
+        else
+        {
+            const double d_min{*min_element(dist_.begin(), dist_.end())};
+
+            for (size_t i{0}; i < n_operations_; i++)
+            {
+                s[i] = dist_[i] - d_min;
+            }
+        }
+    }
+
+    void sync_difference_checker::build_graph_(const vector<double> &x)
+    {
+        // Constraint s_i - s_j <= c becomes edge j -> i with cost c
+        const vector<triplet> &routing_arcs{model_->get_routing_arcs()};
+        const vector<triplet> &sync_arcs{model_->get_sync_arcs()};
+
+        fill(degree_.begin(), degree_.end(), 0);
+
+        // No path is cheaper than the sum of the negative edge costs
+        floor_ = sync_negative_icost_;
+
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+        {
+            if (x[a] >= 1.0 - tol_)
+            {
+                degree_[routing_arcs[a].j_]++;
+
+                if (routing_arc_icost_[a] < 0)
+                    floor_ += routing_arc_icost_[a];
+            }
+        }
+
+        // 32 bits if every potential, down to floor_ - max_icost_, fits
+        const int64_t range{max_icost_ - floor_ + 2};
+
+        if (!integer_ || range >= (INT64_C(1) << 62))
+            type_ = potential_type::DOUBLE;
+        else if (range < INT32_MAX)
+            type_ = potential_type::INT32;
+        else
+            type_ = potential_type::INT64;
+
+        for (size_t a{0}; a < n_sync_arcs_; a++)
+        {
+            degree_[sync_arcs[a].j_]++;
+        }
+
+        head_[0] = 0;
+
+        for (size_t v{0}; v < n_operations_; v++)
+        {
+            head_[v + 1] = head_[v] + degree_[v];
+            degree_[v] = head_[v];
+        }
+
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+        {
+            if (x[a] >= 1.0 - tol_)
+            {
+                const triplet &arc{routing_arcs[a]};
+                const int e{degree_[arc.j_]++};
+
+                edge_from_[e] = arc.j_;
+                edge_to_[e] = arc.i_;
+                edge_arc_[e] = (int)a;
+                set_edge_cost_(e, routing_arc_cost_[a], routing_arc_icost_[a]);
+            }
+        }
+
+        for (size_t a{0}; a < n_sync_arcs_; a++)
+        {
+            const triplet &arc{sync_arcs[a]};
+            const int e{degree_[arc.j_]++};
+
+            edge_from_[e] = arc.j_;
+            edge_to_[e] = arc.i_;
+            edge_arc_[e] = (int)(n_routing_arcs_ + a);
+            set_edge_cost_(e, sync_arc_cost_[a], sync_arc_icost_[a]);
+        }
+    }
+
+    bool sync_difference_checker::shortest_paths_(void)
+    {
+        cycle_.clear();
+
+        // Costs are truncated to 1/precision_, so any cycle of cost below
+        // -1/precision_ (the LP threshold) is found, and none above 0 is.
+        // In integer units the comparisons are exact.
+        switch (type_)
+        {
+        case potential_type::INT32:
+            return shortest_paths_<int32_t>(dist32_, edge_cost32_, 0, (int32_t)(floor_ - 1));
+        case potential_type::INT64:
+            return shortest_paths_<int64_t>(dist64_, edge_cost64_, 0, floor_ - 1);
+        default:
+            return shortest_paths_<double>(dist_, edge_cost_, 0.5 / precision_, (double)(floor_ - 1) / units_);
+        }
+    }
+
+    template <typename T>
+    bool sync_difference_checker::shortest_paths_(vector<T> &dist, const vector<T> &edge_cost, const T eps, const T floor)
+    {
+        const int n{static_cast<int>(n_operations_)};
+
+        // Virtual source joined to every vertex with cost 0
+        fill(dist.begin(), dist.end(), T(0));
+        fill(pred_.begin(), pred_.end(), -1);
+        fill(in_queue_.begin(), in_queue_.end(), 1);
+
+        for (int v{0}; v < n; v++)
+        {
+            queue_[v] = v;
+        }
+
+        int q_head{0};
+        int q_size{n};
+        int n_relax{0};
+
+        while (q_size > 0)
+        {
+            const int u{queue_[q_head]};
+
+            q_head = (q_head + 1) % n;
+            q_size--;
+            in_queue_[u] = 0;
+
+            const T d_u{dist[u]};
+
+            for (int e{head_[u]}; e < head_[u + 1]; e++)
+            {
+                const int v{edge_to_[e]};
+                const T d_v{d_u + edge_cost[e]};
+
+                if (d_v < dist[v] - eps)
+                {
+                    dist[v] = d_v;
+                    pred_[v] = e;
+
+                    // Cheaper than any path: the predecessors of v close a
+                    // negative cycle. Potentials stay above floor - max cost
+                    if (d_v < floor)
+                    {
+                        const int w{find_pred_cycle_()};
+
+                        assert(w >= 0);
+
+                        collect_cycle_(w);
+                        return false;
+                    }
+
+                    if (!in_queue_[v])
+                    {
+                        queue_[(q_head + q_size) % n] = v;
+                        q_size++;
+                        in_queue_[v] = 1;
+                    }
+
+                    // Amortized check: any cycle of the predecessor graph is negative
+                    if (++n_relax >= n)
+                    {
+                        n_relax = 0;
+
+                        const int w{find_pred_cycle_()};
+
+                        if (w >= 0)
+                        {
+                            collect_cycle_(w);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_difference_checker::get_flexibility(const double horizon, vector<double> &earliest, vector<double> &latest)
+    {
+        // The graph and the potentials of a feasible check
+        assert(cycle_.empty());
+
+        switch (type_)
+        {
+        case potential_type::INT32:
+            return get_flexibility_<int32_t>(dist32_, edge_cost32_, 0, units_, horizon, earliest, latest);
+        case potential_type::INT64:
+            return get_flexibility_<int64_t>(dist64_, edge_cost64_, 0, units_, horizon, earliest, latest);
+        default:
+            return get_flexibility_<double>(dist_, edge_cost_, 0.5 / precision_, 1.0, horizon, earliest, latest);
+        }
+    }
+
+    template <typename T>
+    bool sync_difference_checker::get_flexibility_(const vector<T> &dist, const vector<T> &edge_cost, const T eps,
+                                                   const double scale, const double horizon,
+                                                   vector<double> &earliest, vector<double> &latest)
+    {
+        const int n{static_cast<int>(n_operations_)};
+
+        earliest.assign(n_operations_, 0.0);
+        latest.assign(n_operations_, 0.0);
+
+        if (n == 0)
+            return true;
+
+        // dist is the latest schedule with every start ≤ 0. With u = -s the
+        // constraints s_i - s_j ≤ c read u_j - u_i ≤ c: the same edges
+        // walked backwards, whose potentials are the earliest schedule ≥ 0
+        vector<int> r_head(n + 1, 0);
+        vector<int> r_edge(head_[n]);
+
+        for (int e{0}; e < head_[n]; e++)
+            r_head[edge_to_[e] + 1]++;
+
+        for (int v{0}; v < n; v++)
+            r_head[v + 1] += r_head[v];
+
+        {
+            vector<int> next(r_head.begin(), r_head.end() - 1);
+
+            for (int e{0}; e < head_[n]; e++)
+                r_edge[next[edge_to_[e]]++] = e;
+        }
+
+        // SPFA from a virtual source, no negative cycle (the check passed)
+        vector<T> r_dist(n, T(0));
+
+        fill(in_queue_.begin(), in_queue_.end(), 1);
+
+        for (int v{0}; v < n; v++)
+        {
+            queue_[v] = v;
+        }
+
+        int q_head{0};
+        int q_size{n};
+
+        while (q_size > 0)
+        {
+            const int u{queue_[q_head]};
+
+            q_head = (q_head + 1) % n;
+            q_size--;
+            in_queue_[u] = 0;
+
+            for (int p{r_head[u]}; p < r_head[u + 1]; p++)
+            {
+                const int e{r_edge[p]};
+                const int v{edge_from_[e]};
+                const T d_v{r_dist[u] + edge_cost[e]};
+
+                if (d_v < r_dist[v] - eps)
+                {
+                    r_dist[v] = d_v;
+
+                    if (!in_queue_[v])
+                    {
+                        queue_[(q_head + q_size) % n] = v;
+                        q_size++;
+                        in_queue_[v] = 1;
+                    }
+                }
+            }
+        }
+
+        // The earliest completion is the tightest horizon
+        const T completion{-*min_element(r_dist.begin(), r_dist.end())};
+        T h{completion};
+
+        if (horizon >= 0.0)
+        {
+            h = std::is_integral<T>::value ? (T)llround(truncate_(horizon) * scale) : (T)truncate_(horizon);
+
+            if (h < completion - eps)
+                return false;
+        }
+
+        for (int v{0}; v < n; v++)
+        {
+            earliest[v] = (double)(-r_dist[v]) / scale;
+            latest[v] = (double)(h + dist[v]) / scale;
+        }
+
+        return true;
+    }
+
+    int sync_difference_checker::find_pred_cycle_(void)
+    {
+        // 0: not visited, 1: on the current walk, 2: done
+        fill(mark_.begin(), mark_.end(), 0);
+
+        const int n{static_cast<int>(n_operations_)};
+
+        for (int v{0}; v < n; v++)
+        {
+            if (mark_[v] != 0)
+                continue;
+
+            int u{v};
+
+            while (u >= 0 && mark_[u] == 0)
+            {
+                mark_[u] = 1;
+                u = pred_[u] >= 0 ? edge_from_[pred_[u]] : -1;
+            }
+
+            if (u >= 0 && mark_[u] == 1)
+            {
+                return u;
+            }
+
+            u = v;
+
+            while (u >= 0 && mark_[u] == 1)
+            {
+                mark_[u] = 2;
+                u = pred_[u] >= 0 ? edge_from_[pred_[u]] : -1;
+            }
+        }
+
+        return -1;
+    }
+
+    void sync_difference_checker::collect_cycle_(const int v)
+    {
+        cycle_.clear();
+
+        int u{v};
+
+        do
+        {
+            const int e{pred_[u]};
+
+            assert(e >= 0);
+
+            cycle_.push_back(edge_arc_[e]);
+            u = edge_from_[e];
+
+        } while (u != v);
+
+        reverse(cycle_.begin(), cycle_.end());
+    }
+}
@@ -0,0 +1,887 @@
+/**
+ * @file sync_move_evaluator.cpp
+ * @brief Implementation of the incremental move evaluator
+ */
+
+#include "sync_move_evaluator.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <deque>
+#include <queue>
+#include <stdexcept>
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    sync_move_evaluator::sync_move_evaluator(const sync_model_a_builder &builder, const double tol) : tol_(tol),
+                                                                                                     precision_(1E3),
+                                                                                                     builder_(&builder),
+                                                                                                     n_operations_(builder.get_n_operations()),
+                                                                                                     n_depots_(builder.get_n_depots()),
+                                                                                                     routing_arc_cost_(),
+                                                                                                     sync_arc_cost_(),
+                                                                                                     routes_(),
+                                                                                                     ops_(),
+                                                                                                     route_(n_operations_, -1),
+                                                                                                     position_(n_operations_, -1),
+                                                                                                     route_times_(),
+                                                                                                     P_(),
+                                                                                                     feasible_(false),
+                                                                                                     n_evaluations_(0),
+                                                                                                     n_commits_(0),
+                                                                                                     n_recomputes_(0)
+    {
+        const vector<double> &routing_arc_times{builder.get_routing_arc_times()};
+
+        // Same costs as sync_difference_checker
+        routing_arc_cost_.resize(routing_arc_times.size());
+
+        for (size_t a{0}; a < routing_arc_times.size(); a++)
+            routing_arc_cost_[a] = truncate_(-routing_arc_times[a]);
+
+        update_sync_arc_times(builder);
+    }
+
+    sync_move_evaluator::~sync_move_evaluator(void)
+    {
+    }
+
+    void sync_move_evaluator::update_sync_arc_times(const sync_model_a_builder &builder)
+    {
+        const vector<double> &sync_arc_times{builder.get_sync_arc_times()};
+
+        sync_arc_cost_.resize(sync_arc_times.size());
+
+        for (size_t a{0}; a < sync_arc_times.size(); a++)
+        {
+            const double w_h_p_j{sync_arc_times[a]};
+
+            sync_arc_cost_[a] = w_h_p_j < INF_MD_THRLD ? truncate_(w_h_p_j) : 0.0;
+        }
+    }
+
+    int sync_move_evaluator::operation_(const size_t k, const int node) const
+    {
+        const GOMA::matrix<int> &operations_map{builder_->get_operations_map()};
+
+        if (node < 0 || node + 1 > (int)builder_->get_n_customers() + 1)
+            return -1;
+
+        return operations_map.at(node + 1, k + 1);
+    }
+
+    bool sync_move_evaluator::load(const vector<vector<int>> &routes)
+    {
+        if (routes.size() != n_depots_)
+            throw std::invalid_argument("sync_move_evaluator: " + to_string(routes.size()) + " routes for " +
+                                        to_string(n_depots_) + " depots");
+
+        routes_ = routes;
+        ops_.resize(n_depots_);
+
+        fill(route_.begin(), route_.end(), -1);
+
+        route_times_.resize(n_depots_);
+
+        for (size_t k{0}; k < n_depots_; k++)
+        {
+            const vector<int> &route{routes_[k]};
+            vector<int> &ops{ops_[k]};
+
+            if (route.size() < 2)
+                throw std::invalid_argument("sync_move_evaluator: route " + to_string(k + 1) + " has no depot");
+
+            ops.resize(route.size());
+
+            ops.front() = (int)k;
+            ops.back() = (int)(n_depots_ + k);
+
+            for (size_t p{1}; p + 1 < route.size(); p++)
+            {
+                const int op{operation_(k, route[p])};
+
+                if (op < 0 || route_[op] >= 0)
+                    throw std::invalid_argument("sync_move_evaluator: customer " + to_string(route[p]) +
+                                                " not served by depot " + to_string(k + 1) + " or visited twice");
+
+                ops[p] = op;
+            }
+
+            for (size_t p{0}; p < ops.size(); p++)
+            {
+                route_[ops[p]] = (int)k;
+                position_[ops[p]] = (int)p;
+
+                if (p > 0 && arc_(ops[p - 1], ops[p]) == EMPTY_VAR)
+                    throw std::invalid_argument("sync_move_evaluator: route " + to_string(k + 1) + " uses an arc pruned from the model");
+            }
+
+            set_route_times_(k);
+        }
+
+        feasible_ = recompute_();
+
+        return feasible_;
+    }
+
+    void sync_move_evaluator::set_route_times_(const size_t k)
+    {
+        const vector<int> &ops{ops_[k]};
+
+        route_times_.start_route(k, ops[0]);
+
+        // Costs of a committed route are never pruned
+        for (size_t p{1}; p < ops.size(); p++)
+            route_times_.push_stop(k, ops[p], -routing_arc_cost_[arc_(ops[p - 1], ops[p])]);
+    }
+
+    void sync_move_evaluator::build_graph_(void)
+    {
+        const int n{(int)n_operations_};
+
+        // Constraint s_i - s_j <= c becomes edge j -> i with cost c
+        const vector<triplet> &sync_arcs{builder_->get_sync_arcs()};
+
+        head_.assign(n + 1, 0);
+
+        for (const vector<int> &ops : ops_)
+        {
+            for (size_t p{1}; p < ops.size(); p++)
+                head_[ops[p] + 1]++;
+        }
+
+        for (const triplet &arc : sync_arcs)
+            head_[arc.j_ + 1]++;
+
+        for (int v{0}; v < n; v++)
+            head_[v + 1] += head_[v];
+
+        edge_to_.resize(head_[n]);
+        edge_cost_.resize(head_[n]);
+        edge_removed_.assign(head_[n], 0);
+        route_edge_.resize(ops_.size());
+
+        // head_[v] is the fill cursor of v, shifted back afterwards
+        for (size_t k{0}; k < ops_.size(); k++)
+        {
+            const vector<int> &ops{ops_[k]};
+
+            route_edge_[k].assign(ops.size(), -1);
+
+            for (size_t p{1}; p < ops.size(); p++)
+            {
+                const int e{head_[ops[p]]++};
+
+                edge_to_[e] = ops[p - 1];
+                edge_cost_[e] = routing_arc_cost_[arc_(ops[p - 1], ops[p])];
+
+                route_edge_[k][p] = e;
+            }
+        }
+
+        for (size_t a{0}; a < sync_arcs.size(); a++)
+        {
+            const int e{head_[sync_arcs[a].j_]++};
+
+            edge_to_[e] = sync_arcs[a].i_;
+            edge_cost_[e] = sync_arc_cost_[a];
+        }
+
+        for (int v{n}; v > 0; v--)
+            head_[v] = head_[v - 1];
+
+        head_[0] = 0;
+    }
+
+    bool sync_move_evaluator::recompute_(void)
+    {
+        const int n{(int)n_operations_};
+
+        build_graph_();
+
+        n_recomputes_++;
+
+        // Potentials: SPFA from a virtual source joined to every vertex with cost 0
+        const double eps{0.5 / precision_};
+
+        potential_.assign(n, 0.0);
+        n_enqueued_.assign(n, 1);
+        in_queue_.assign(n, 1);
+
+        queue_.clear();
+
+        for (int v{0}; v < n; v++)
+            queue_.push_back(v);
+
+        while (!queue_.empty())
+        {
+            const int u{queue_.front()};
+
+            queue_.pop_front();
+            in_queue_[u] = 0;
+
+            for (int e{head_[u]}; e < head_[u + 1]; e++)
+            {
+                const int v{edge_to_[e]};
+                const double d_v{potential_[u] + edge_cost_[e]};
+
+                if (d_v < potential_[v] - eps)
+                {
+                    potential_[v] = d_v;
+
+                    if (!in_queue_[v])
+                    {
+                        // Enqueued n times: a negative cycle
+                        if (++n_enqueued_[v] > n)
+                        {
+                            P_.clear();
+                            return false;
+                        }
+
+                        queue_.push_back(v);
+                        in_queue_[v] = 1;
+                    }
+                }
+            }
+        }
+
+        // Local searches start from the potentials
+        label_ = potential_;
+        pred_.assign(n, -1);
+        in_queue_.assign(n, 0);
+
+        // One Dijkstra per source on the reduced costs (nonnegative)
+        const double inf{numeric_limits<double>::infinity()};
+
+        P_.assign((size_t)n * n, inf);
+        dist_.resize(n);
+
+        typedef pair<double, int> label;
+        priority_queue<label, vector<label>, greater<label>> heap;
+
+        for (int s{0}; s < n; s++)
+        {
+            fill(dist_.begin(), dist_.end(), inf);
+
+            dist_[s] = 0.0;
+            heap.push(label(0.0, s));
+
+            while (!heap.empty())
+            {
+                const label top{heap.top()};
+                heap.pop();
+
+                const int u{top.second};
+
+                if (top.first > dist_[u])
+                    continue;
+
+                for (int e{head_[u]}; e < head_[u + 1]; e++)
+                {
+                    const int v{edge_to_[e]};
+                    const double reduced{max(0.0, edge_cost_[e] + potential_[u] - potential_[v])};
+
+                    if (dist_[u] + reduced < dist_[v])
+                    {
+                        dist_[v] = dist_[u] + reduced;
+                        heap.push(label(dist_[v], v));
+                    }
+                }
+            }
+
+            double *row{&P_[(size_t)s * n]};
+
+            for (int v{0}; v < n; v++)
+            {
+                if (dist_[v] < inf)
+                    row[v] = truncate_(dist_[v] - potential_[s] + potential_[v]);
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_move_evaluator::set_insert_(const size_t k, const int customer, const size_t p)
+    {
+        assert(k < n_depots_ && p >= 1 && p < ops_[k].size());
+
+        const int op{operation_(k, customer)};
+
+        if (op < 0 || route_[op] >= 0)
+            return false;
+
+        changes_.resize(1);
+
+        route_change &change{changes_[0]};
+
+        change.k_ = k;
+        change.begin_ = p;
+        change.end_ = p;
+        change.ops_.assign(1, op);
+        change.nodes_.assign(1, customer);
+
+        return true;
+    }
+
+    bool sync_move_evaluator::set_remove_(const size_t k, const size_t p)
+    {
+        assert(k < n_depots_ && p >= 1 && p + 1 < ops_[k].size());
+
+        changes_.resize(1);
+
+        route_change &change{changes_[0]};
+
+        change.k_ = k;
+        change.begin_ = p;
+        change.end_ = p + 1;
+        change.ops_.clear();
+        change.nodes_.clear();
+
+        return true;
+    }
+
+    bool sync_move_evaluator::set_swap_(size_t k1, size_t p1, size_t k2, size_t p2)
+    {
+        assert(k1 < n_depots_ && p1 >= 1 && p1 + 1 < ops_[k1].size());
+        assert(k2 < n_depots_ && p2 >= 1 && p2 + 1 < ops_[k2].size());
+
+        if (k1 == k2)
+        {
+            if (p1 == p2)
+                return false;
+
+            if (p1 > p2)
+                std::swap(p1, p2);
+
+            const vector<int> &ops{ops_[k1]};
+            const vector<int> &route{routes_[k1]};
+
+            if (p2 == p1 + 1)
+            {
+                changes_.resize(1);
+
+                route_change &change{changes_[0]};
+
+                change.k_ = k1;
+                change.begin_ = p1;
+                change.end_ = p2 + 1;
+                change.ops_.assign({ops[p2], ops[p1]});
+                change.nodes_.assign({route[p2], route[p1]});
+
+                return true;
+            }
+
+            changes_.resize(2);
+
+            changes_[0].k_ = k1;
+            changes_[0].begin_ = p1;
+            changes_[0].end_ = p1 + 1;
+            changes_[0].ops_.assign(1, ops[p2]);
+            changes_[0].nodes_.assign(1, route[p2]);
+
+            changes_[1].k_ = k1;
+            changes_[1].begin_ = p2;
+            changes_[1].end_ = p2 + 1;
+            changes_[1].ops_.assign(1, ops[p1]);
+            changes_[1].nodes_.assign(1, route[p1]);
+
+            return true;
+        }
+
+        const int c1{routes_[k1][p1]};
+        const int c2{routes_[k2][p2]};
+
+        // Each customer takes the operation of the other depot
+        const int op1{operation_(k2, c1)};
+        const int op2{operation_(k1, c2)};
+
+        if (op1 < 0 || op2 < 0 || (route_[op1] >= 0 && op1 != ops_[k2][p2]) || (route_[op2] >= 0 && op2 != ops_[k1][p1]))
+            return false;
+
+        changes_.resize(2);
+
+        changes_[0].k_ = k1;
+        changes_[0].begin_ = p1;
+        changes_[0].end_ = p1 + 1;
+        changes_[0].ops_.assign(1, op2);
+        changes_[0].nodes_.assign(1, c2);
+
+        changes_[1].k_ = k2;
+        changes_[1].begin_ = p2;
+        changes_[1].end_ = p2 + 1;
+        changes_[1].ops_.assign(1, op1);
+        changes_[1].nodes_.assign(1, c1);
+
+        return true;
+    }
+
+    bool sync_move_evaluator::set_two_opt_(const size_t k, const size_t i, const size_t j)
+    {
+        assert(k < n_depots_ && i >= 1 && i < j && j + 1 < ops_[k].size());
+
+        changes_.resize(1);
+
+        route_change &change{changes_[0]};
+
+        change.k_ = k;
+        change.begin_ = i;
+        change.end_ = j + 1;
+        change.ops_.assign(ops_[k].rbegin() + (ops_[k].size() - j - 1), ops_[k].rbegin() + (ops_[k].size() - i));
+        change.nodes_.assign(routes_[k].rbegin() + (routes_[k].size() - j - 1), routes_[k].rbegin() + (routes_[k].size() - i));
+
+        return true;
+    }
+
+    bool sync_move_evaluator::collect_edges_(double &delta)
+    {
+        const vector<double> &routing_arc_times{builder_->get_routing_arc_times()};
+
+        added_from_.clear();
+        added_to_.clear();
+        added_cost_.clear();
+        removed_arcs_.clear();
+
+        delta = 0.0;
+
+        bool pruned{false};
+
+        for (const route_change &change : changes_)
+        {
+            const vector<int> &ops{ops_[change.k_]};
+
+            // Arcs of positions begin - 1 .. end in the committed route
+            for (size_t p{change.begin_}; p <= change.end_; p++)
+            {
+                const int arc{arc_(ops[p - 1], ops[p])};
+
+                removed_arcs_.push_back(arc);
+                delta -= routing_arc_times[arc];
+            }
+
+            // Arcs of the new window, from position begin - 1 to position end
+            int prev{ops[change.begin_ - 1]};
+
+            for (size_t q{0}; q <= change.ops_.size(); q++)
+            {
+                const int next{q < change.ops_.size() ? change.ops_[q] : ops[change.end_]};
+                const int arc{arc_(prev, next)};
+
+                if (arc == EMPTY_VAR)
+                {
+                    pruned = true;
+                }
+                else
+                {
+                    added_from_.push_back(next);
+                    added_to_.push_back(prev);
+                    added_cost_.push_back(routing_arc_cost_[arc]);
+
+                    delta += routing_arc_times[arc];
+                }
+
+                prev = next;
+            }
+        }
+
+        return !pruned;
+    }
+
+    bool sync_move_evaluator::evaluate_(double &delta)
+    {
+        assert(feasible_);
+
+        n_evaluations_++;
+
+        if (!collect_edges_(delta))
+            return false;
+
+        // Endpoints of the added edges
+        nodes_.clear();
+
+        for (size_t e{0}; e < added_from_.size(); e++)
+        {
+            for (const int v : {added_from_[e], added_to_[e]})
+            {
+                if (find(nodes_.begin(), nodes_.end(), v) == nodes_.end())
+                    nodes_.push_back(v);
+            }
+        }
+
+        const size_t N{nodes_.size()};
+
+        M_.resize(N * N);
+
+        for (size_t a{0}; a < N; a++)
+        {
+            for (size_t b{0}; b < N; b++)
+                M_[a * N + b] = P_at_(nodes_[a], nodes_[b]);
+        }
+
+        for (size_t e{0}; e < added_from_.size(); e++)
+        {
+            const size_t a{(size_t)(find(nodes_.begin(), nodes_.end(), added_from_[e]) - nodes_.begin())};
+            const size_t b{(size_t)(find(nodes_.begin(), nodes_.end(), added_to_[e]) - nodes_.begin())};
+
+            M_[a * N + b] = min(M_[a * N + b], added_cost_[e]);
+        }
+
+        // Floyd-Warshall on the endpoints: a negative diagonal is a negative cycle
+        const double eps{0.5 / precision_};
+
+        for (size_t m{0}; m < N; m++)
+        {
+            for (size_t a{0}; a < N; a++)
+            {
+                const double d_am{M_[a * N + m]};
+
+                if (std::isinf(d_am))
+                    continue;
+
+                for (size_t b{0}; b < N; b++)
+                {
+                    const double d{d_am + M_[m * N + b]};
+
+                    if (d < M_[a * N + b])
+                        M_[a * N + b] = d;
+                }
+
+                if (M_[a * N + a] < -eps)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool sync_move_evaluator::local_search_(const bool keep)
+    {
+        const double eps{0.5 / precision_};
+
+        for (const route_change &change : changes_)
+        {
+            for (size_t p{change.begin_}; p <= change.end_; p++)
+                edge_removed_[route_edge_[change.k_][p]] = 1;
+        }
+
+        touched_.clear();
+        queue_.clear();
+
+        bool feasible{true};
+
+        // Lower the label of v through u; false if v is an ancestor of u
+        // in the predecessor graph (a negative cycle)
+        auto relax = [&](const int u, const int v, const double cost) -> bool
+        {
+            const double d_v{label_[u] + cost};
+
+            if (d_v >= label_[v] - eps)
+                return true;
+
+            for (int w{u}; w >= 0; w = pred_[w])
+            {
+                if (w == v)
+                    return false;
+            }
+
+            if (pred_[v] < 0 && !in_queue_[v] && label_[v] == potential_[v])
+                touched_.push_back(v);
+
+            label_[v] = d_v;
+            pred_[v] = u;
+
+            if (!in_queue_[v])
+            {
+                queue_.push_back(v);
+                in_queue_[v] = 1;
+            }
+
+            return true;
+        };
+
+        // The committed potentials satisfy every edge but the added ones
+        for (size_t e{0}; feasible && e < added_from_.size(); e++)
+            feasible = relax(added_from_[e], added_to_[e], added_cost_[e]);
+
+        while (feasible && !queue_.empty())
+        {
+            const int u{queue_.front()};
+
+            queue_.pop_front();
+            in_queue_[u] = 0;
+
+            for (int e{head_[u]}; feasible && e < head_[u + 1]; e++)
+            {
+                if (!edge_removed_[e])
+                    feasible = relax(u, edge_to_[e], edge_cost_[e]);
+            }
+
+            for (size_t e{0}; feasible && e < added_from_.size(); e++)
+            {
+                if (added_from_[e] == u)
+                    feasible = relax(u, added_to_[e], added_cost_[e]);
+            }
+        }
+
+        // Restore the workspace (keeping the new potentials if asked)
+        for (const int v : touched_)
+        {
+            if (keep && feasible)
+                potential_[v] = label_[v];
+            else
+                label_[v] = potential_[v];
+
+            pred_[v] = -1;
+            in_queue_[v] = 0;
+        }
+
+        queue_.clear();
+
+        for (const route_change &change : changes_)
+        {
+            for (size_t p{change.begin_}; p <= change.end_; p++)
+                edge_removed_[route_edge_[change.k_][p]] = 0;
+        }
+
+        return feasible;
+    }
+
+    void sync_move_evaluator::commit_(void)
+    {
+        double delta;
+
+        const bool complete{collect_edges_(delta)};
+
+        assert(complete);
+        (void)complete;
+
+        // New potentials (a schedule of the new routing), or no feasible one
+        const bool feasible{local_search_(true)};
+
+        // Apply the windows from the last one, so earlier positions stay valid
+        for (size_t c{changes_.size()}; c-- > 0;)
+        {
+            const route_change &change{changes_[c]};
+
+            vector<int> &ops{ops_[change.k_]};
+            vector<int> &route{routes_[change.k_]};
+
+            for (size_t p{change.begin_}; p < change.end_; p++)
+                route_[ops[p]] = -1;
+
+            ops.erase(ops.begin() + change.begin_, ops.begin() + change.end_);
+            ops.insert(ops.begin() + change.begin_, change.ops_.begin(), change.ops_.end());
+
+            route.erase(route.begin() + change.begin_, route.begin() + change.end_);
+            route.insert(route.begin() + change.begin_, change.nodes_.begin(), change.nodes_.end());
+        }
+
+        for (const route_change &change : changes_)
+        {
+            const vector<int> &ops{ops_[change.k_]};
+
+            for (size_t p{0}; p < ops.size(); p++)
+            {
+                route_[ops[p]] = (int)change.k_;
+                position_[ops[p]] = (int)p;
+            }
+
+            set_route_times_(change.k_);
+        }
+
+        n_commits_++;
+
+        if (!feasible)
+        {
+            build_graph_();
+
+            feasible_ = false;
+            P_.clear();
+            return;
+        }
+
+        // A removed arc (i, j) is implied if j still follows i on the same
+        // route, at least t_ij later: P cannot increase
+        const vector<triplet> &routing_arcs{builder_->get_routing_arcs()};
+        const double eps{0.5 / precision_};
+
+        bool implied{true};
+
+        for (const int arc : removed_arcs_)
+        {
+            const int i{routing_arcs[arc].i_};
+            const int j{routing_arcs[arc].j_};
+
+            if (route_[i] < 0 || route_[i] != route_[j] || position_[i] >= position_[j])
+            {
+                implied = false;
+                break;
+            }
+
+            const double cost{-route_times_.get_elapsed(route_[i], position_[i], position_[j])};
+
+            if (cost > routing_arc_cost_[arc] + eps)
+            {
+                implied = false;
+                break;
+            }
+        }
+
+        if (!implied)
+        {
+            feasible_ = recompute_();
+            return;
+        }
+
+        build_graph_();
+
+        // P(u, v) = min(P(u, v), P(u, tail) + cost + P(head, v)) for each added edge
+        const size_t n{n_operations_};
+
+        column_.resize(n);
+        row_.resize(n);
+
+        for (size_t e{0}; e < added_from_.size(); e++)
+        {
+            const int from{added_from_[e]};
+            const int to{added_to_[e]};
+            const double cost{added_cost_[e]};
+
+            if (cost >= P_at_(from, to))
+                continue;
+
+            if (cost + P_at_(to, from) < -eps)
+            {
+                feasible_ = false;
+                return;
+            }
+
+            for (size_t u{0}; u < n; u++)
+            {
+                column_[u] = P_[u * n + from];
+                row_[u] = P_[(size_t)to * n + u];
+            }
+
+            for (size_t u{0}; u < n; u++)
+            {
+                if (std::isinf(column_[u]))
+                    continue;
+
+                const double d_u{column_[u] + cost};
+                double *P_u{&P_[u * n]};
+
+                for (size_t v{0}; v < n; v++)
+                {
+                    const double d{d_u + row_[v]};
+
+                    if (d < P_u[v])
+                        P_u[v] = d;
+                }
+            }
+        }
+    }
+
+    bool sync_move_evaluator::eval_insert(const size_t k, const int customer, const size_t p, double &delta)
+    {
+        delta = 0.0;
+
+        return set_insert_(k, customer, p) && evaluate_(delta);
+    }
+
+    bool sync_move_evaluator::eval_remove(const size_t k, const size_t p, double &delta)
+    {
+        delta = 0.0;
+
+        return set_remove_(k, p) && evaluate_(delta);
+    }
+
+    bool sync_move_evaluator::eval_swap(const size_t k1, const size_t p1, const size_t k2, const size_t p2, double &delta)
+    {
+        assert(feasible_);
+
+        delta = 0.0;
+
+        if (!set_swap_(k1, p1, k2, p2))
+            return false;
+
+        n_evaluations_++;
+
+        return collect_edges_(delta) && local_search_(false);
+    }
+
+    bool sync_move_evaluator::eval_two_opt(const size_t k, const size_t i, const size_t j, double &delta)
+    {
+        assert(feasible_);
+
+        delta = 0.0;
+
+        set_two_opt_(k, i, j);
+
+        n_evaluations_++;
+
+        return collect_edges_(delta) && local_search_(false);
+    }
+
+    void sync_move_evaluator::insert(const size_t k, const int customer, const size_t p)
+    {
+        if (set_insert_(k, customer, p))
+            commit_();
+    }
+
+    void sync_move_evaluator::remove(const size_t k, const size_t p)
+    {
+        if (set_remove_(k, p))
+            commit_();
+    }
+
+    void sync_move_evaluator::swap(const size_t k1, const size_t p1, const size_t k2, const size_t p2)
+    {
+        if (set_swap_(k1, p1, k2, p2))
+            commit_();
+    }
+
+    void sync_move_evaluator::two_opt(const size_t k, const size_t i, const size_t j)
+    {
+        if (set_two_opt_(k, i, j))
+            commit_();
+    }
+
+    void sync_move_evaluator::get_s(vector<double> &s) const
+    {
+        assert(feasible_);
+
+        s = potential_;
+
+        if (s.empty())
+            return;
+
+        const double d_min{*min_element(s.begin(), s.end())};
+
+        for (double &s_v : s)
+            s_v -= d_min;
+    }
+
+    size_t sync_move_evaluator::get_memory_bytes(void) const
+    {
+        size_t bytes{P_.capacity() * sizeof(double)};
+
+        bytes += (routing_arc_cost_.capacity() + sync_arc_cost_.capacity() + edge_cost_.capacity() + potential_.capacity() +
+                  dist_.capacity() + column_.capacity() + row_.capacity() + added_cost_.capacity() + M_.capacity()) *
+                 sizeof(double);
+
+        bytes += (route_.capacity() + position_.capacity() + head_.capacity() + edge_to_.capacity() + n_enqueued_.capacity() +
+                  added_from_.capacity() + added_to_.capacity() + removed_arcs_.capacity() + nodes_.capacity()) *
+                 sizeof(int);
+
+        for (size_t k{0}; k < ops_.size(); k++)
+            bytes += (ops_[k].capacity() + routes_[k].capacity()) * sizeof(int);
+
+        for (size_t k{0}; k < route_times_.get_n_routes(); k++)
+            bytes += route_times_.get_n_stops(k) * (sizeof(int) + sizeof(double));
+
+        return bytes;
+    }
+}
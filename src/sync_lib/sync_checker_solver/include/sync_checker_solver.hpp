@@ -1,6 +1,9 @@
 #pragma once
 
 #include "LP_solver.hpp"
+#include "stats_timer.hpp"
+
+#include <string>
 
 /**
  * @file sync_checker_solver.hpp
@@ -10,12 +13,10 @@
  * programming problems that arise in CTSP constraint checking, dual variable
  * computation, and separation algorithms.
  * 
- * Current Implementation: Uses CPLEX (IBM ILOG CPLEX Optimization Studio)
- * 
- * Alternative Solvers: The design supports switching to open-source alternatives
- * such as CLP (COIN-OR Linear Programming) by implementing a CLP_solver class
- * that follows the same LP_solver interface. This would eliminate the need for
- * a commercial CPLEX license.
+ * Backends: the LP solver is created through LP_backend_registry, so any
+ * backend compiled into the util library (CPLEX, CLP, HiGHS) can be chosen
+ * at runtime, per solver or globally (LP_backend_registry::set_default, the
+ * --lp-backend option of the schedulers).
  * 
  * The solver is primarily used for:
  * - Checking feasibility of synchronization constraints
@@ -29,7 +30,7 @@ namespace GOMA
      * @class sync_checker_solver
      * @brief Wrapper class for LP solver operations in CTSP algorithms
      * 
-     * This class provides a simplified interface to LP solvers (currently CPLEX)
+     * This class provides a simplified interface to LP solvers (CPLEX, CLP, HiGHS)
      * for solving LP problems related to CTSP synchronization checking. It encapsulates:
      * - Model creation and modification
      * - Solving LP/relaxations
@@ -37,12 +38,12 @@ namespace GOMA
      * - Dynamic constraint addition (cut generation)
      * 
      * The class uses PIMPL pattern to hide solver implementation details and
-     * enable easy switching between different LP solvers (CPLEX, CLP, Gurobi, etc.).
+     * enable easy switching between different LP solvers (CPLEX, CLP, HiGHS, etc.).
      * 
-     * To use an alternative solver like CLP (COIN-OR):
-     * 1. Implement a CLP_solver class with the same interface as CPX_solver
-     * 2. Replace CPX_solver instantiation in the .cpp file
-     * 3. Update CMakeLists.txt to link against CLP instead of CPLEX
+     * To add another solver (e.g. Gurobi):
+     * 1. Implement a solver class following the LP_solver interface
+     * 2. Register it with LP_backend_registry::register_backend()
+     * 3. Select it by name (constructor argument or set_default())
      * 
      * Typical usage:
      * 1. Create solver with initial model description
@@ -54,15 +55,26 @@ namespace GOMA
     class sync_checker_solver 
     {
     private:
-        LP_solver *solver_;  ///< Pointer to underlying LP solver (currently CPX_solver, can be CLP_solver)
+        LP_solver *solver_;  ///< Pointer to underlying LP solver (CPX_solver, CLP_solver, HiGHS_solver, ...)
+
+        // Work counters (USE_STATS), kept across set()
+        size_t n_solves_;      ///< Calls to solve()
+        size_t n_iterations_;  ///< Simplex iterations of those solves
+        double solve_time_;    ///< Seconds in solve()
+        size_t n_coef_nz_;     ///< Matrix coefficients changed by set_coef()
+        size_t n_obj_nz_;      ///< Objective coefficients changed by set_obj()
+
+        size_t model_bytes_;   ///< Heap bytes of the model_description of the last load
+        size_t matrix_bytes_;  ///< Those of its constraint matrix (M_)
 
     public:
         /**
          * @brief Construct solver with model description
          * @param model Complete LP model description (variables, constraints, objective)
          * @param tol Numerical tolerance for optimality and feasibility (default: 1e-6)
+         * @param backend LP backend name (default "": LP_backend_registry::get_default())
          */
-        sync_checker_solver(const model_description &model, const double tol = 1e-6);
+        sync_checker_solver(const model_description &model, const double tol = 1e-6, const string &backend = "");
         
         /**
          * @brief Default constructor (creates empty solver)
@@ -75,8 +87,9 @@ namespace GOMA
          * @brief Initialize or reinitialize solver with new model
          * @param model LP model description
          * @param tol Numerical tolerance (default: 1e-6)
+         * @param backend LP backend name (default "": LP_backend_registry::get_default())
          */
-        void set(const model_description &model, const double tol = 1e-6);
+        void set(const model_description &model, const double tol = 1e-6, const string &backend = "");
 
         /**
          * @brief Solve the current LP problem
@@ -182,6 +195,52 @@ namespace GOMA
          */
         void set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val);
 
+        /**
+         * @brief Enable or disable warm start from the previous basis
+         * @param warm_start true to start the next solve from the last basis
+         */
+        void set_warm_start(const bool warm_start);
+
+        /**
+         * @brief Stop the next solves once the objective drops below a cutoff
+         * @param cutoff Objective limit (-infinity: solve to optimality)
+         *
+         * A stopped solve reports GOMA::LP_STAT_OBJ_LIMIT, see LP_solver.
+         */
+        void set_obj_cutoff(const double cutoff);
+
+        /**
+         * @brief Stop the next solves after a number of seconds
+         * @param seconds Time limit of each solve (≤ 0: no limit)
+         *
+         * A stopped solve reports GOMA::LP_STAT_TIME_LIMIT, see LP_solver.
+         */
+        void set_time_limit(const double seconds);
+
+        /**
+         * @brief Stop the running solve and the next ones, from any thread
+         * @param interrupt true to stop them, false to let solves run again
+         *
+         * A stopped solve reports GOMA::LP_STAT_INTERRUPTED, see LP_solver.
+         */
+        void set_interrupt(const bool interrupt);
+
+        /**
+         * @brief Get the basis of the last solve
+         * @param col_stat Output: GOMA::BasisStat of each column
+         * @param row_stat Output: GOMA::BasisStat of each row
+         * @return false if the backend has no basis
+         */
+        bool get_basis(vector<int> &col_stat, vector<int> &row_stat) const;
+
+        /**
+         * @brief Start the next solve from a given basis
+         * @param col_stat GOMA::BasisStat of each column
+         * @param row_stat GOMA::BasisStat of each row
+         * @return false if the basis does not fit the model
+         */
+        bool set_basis(const vector<int> &col_stat, const vector<int> &row_stat);
+
         /**
          * @brief Write current model to file for debugging
          * @param filename Output file path (format determined by extension: .lp, .mps, etc.)
@@ -192,5 +251,29 @@ namespace GOMA
          * - External validation
          */
         void write_model(const char *filename) const;
+
+        /**
+         * @name Work counters (0 unless built with USE_STATS)
+         * Totals since construction.
+         */
+        ///@{
+        inline size_t get_n_solves(void) const { return n_solves_; }
+        inline size_t get_n_iterations(void) const { return n_iterations_; }
+        inline double get_solve_time(void) const { return solve_time_; }
+        inline size_t get_n_coef_nz(void) const { return n_coef_nz_; }
+        inline size_t get_n_obj_nz(void) const { return n_obj_nz_; }
+        ///@}
+
+        /**
+         * @name Memory of the last model loaded (constructor or set())
+         * The model_description is copied into the backend and usually
+         * released by the caller afterwards: these are the bytes it held
+         * during the load, on top of the backend's own copy (not exposed
+         * by the LP APIs).
+         */
+        ///@{
+        inline size_t get_model_bytes(void) const { return model_bytes_; }
+        inline size_t get_matrix_bytes(void) const { return matrix_bytes_; }
+        ///@}
     };
 }
@@ -3,29 +3,30 @@
  * @brief Implementation of LP solver wrapper for CTSP synchronization checking
  * 
  * This file implements the sync_checker_solver class, which provides a
- * simplified interface to CPLEX for solving linear programming problems
+ * simplified interface to the LP backends of LP_backend_registry (CPLEX,
+ * CLP, HiGHS) for solving linear programming problems
  * in CTSP constraint checking and separation algorithms.
  */
 
 #include "sync_checker_solver.hpp"
-#ifdef USE_CLP
-#include "CLP/CLP_solver.hpp"
-#else
-#include "CPX_solver.hpp"
-#endif
+#include "LP_backend.hpp"
+#include "trace_recorder.hpp"
 
 namespace GOMA
 {
     /**
      * Constructor: Creates solver with initial model description.
-     * Internally instantiates a CPLEX solver with the provided model.
+     * Internally instantiates the requested LP backend with the provided model.
      */
-    sync_checker_solver::sync_checker_solver(const model_description &model, const double tol) 
-#ifdef USE_CLP
-        : solver_(new CLP_solver(model, tol))
-#else
-        : solver_(new CPX_solver(model, tol))
-#endif
+    sync_checker_solver::sync_checker_solver(const model_description &model, const double tol, const string &backend)
+        : solver_(LP_backend_registry::create(backend, model, tol)),
+          n_solves_(0),
+          n_iterations_(0),
+          solve_time_(0),
+          n_coef_nz_(0),
+          n_obj_nz_(0),
+          model_bytes_(model.get_memory_bytes()),
+          matrix_bytes_(model.get_M().get_memory_bytes())
     {
     }
 
@@ -33,12 +34,19 @@ namespace GOMA
      * Default constructor: Creates an empty solver.
      * Must call set() before using.
      */
-    sync_checker_solver::sync_checker_solver(void) : solver_(NULL)
+    sync_checker_solver::sync_checker_solver(void) : solver_(NULL),
+                                                     n_solves_(0),
+                                                     n_iterations_(0),
+                                                     solve_time_(0),
+                                                     n_coef_nz_(0),
+                                                     n_obj_nz_(0),
+                                                     model_bytes_(0),
+                                                     matrix_bytes_(0)
     {
     }    
 
     /**
-     * Destructor: Properly releases CPLEX solver resources.
+     * Destructor: Properly releases LP solver resources.
      */
     sync_checker_solver::~sync_checker_solver(void)
     {
@@ -52,28 +60,33 @@ namespace GOMA
      * Initialize or reinitialize the solver with a new model.
      * Deletes any existing solver and creates a fresh instance.
      */
-    void sync_checker_solver::set(const model_description &model, const double tol)
+    void sync_checker_solver::set(const model_description &model, const double tol, const string &backend)
     {
         if (solver_)
         {
             delete solver_;
         }
 
-        
-#ifdef USE_CLP
-    solver_ = new CLP_solver(model, tol);
-#else
-    solver_ = new CPX_solver(model, tol);
-#endif
+        solver_ = LP_backend_registry::create(backend, model, tol);
+
+        model_bytes_ = model.get_memory_bytes();
+        matrix_bytes_ = model.get_M().get_memory_bytes();
     }
 
     /**
-     * Solve the LP problem using CPLEX's optimizer.
+     * Solve the LP problem using the backend optimizer.
      * After solving, query solution via get_obj(), get_vars(), get_dual_vars().
      */
     void sync_checker_solver::solve(void)
     {
-        solver_->solve();
+        {
+            stats_timer timer(solve_time_);
+            trace_scope trace("lp_solve", "lp");
+            solver_->solve();
+        }
+
+        GOMA_STATS(n_solves_++);
+        GOMA_STATS(n_iterations_ += solver_->get_n_iterations());
     }
 
     /**
@@ -108,6 +121,8 @@ namespace GOMA
      */
     void sync_checker_solver::set_obj(double *obj_coef, int *obj_inx, int sz)
     {
+        GOMA_STATS(n_obj_nz_ += sz);
+
         solver_->set_obj(obj_coef, obj_inx, sz);
     }
 
@@ -190,7 +205,64 @@ namespace GOMA
      */
     void sync_checker_solver::set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val)
     {
+        GOMA_STATS(n_coef_nz_ += cnt);
+
         solver_->set_coef(cnt, row_inx, col_inx, coef_val);
     }
 
+    /**
+     * Enable or disable warm start from the previous basis.
+     * Consecutive checks differ in a few coefficients, so reusing the
+     * basis saves most of the simplex iterations.
+     */
+    void sync_checker_solver::set_warm_start(const bool warm_start)
+    {
+        solver_->set_warm_start(warm_start);
+    }
+
+    /**
+     * Objective cutoff of the next solves. The checkers only need the sign
+     * of the optimum, so a primal point below the threshold already
+     * answers the check.
+     */
+    void sync_checker_solver::set_obj_cutoff(const double cutoff)
+    {
+        solver_->set_obj_cutoff(cutoff);
+    }
+
+    /**
+     * Time limit of the next solves. Set before each check from the
+     * remaining time of its deadline.
+     */
+    void sync_checker_solver::set_time_limit(const double seconds)
+    {
+        solver_->set_time_limit(seconds);
+    }
+
+    /**
+     * Raised by another thread that no longer needs the answer (e.g. the
+     * winner of a race, see conTSP2_scheduling::set_race).
+     */
+    void sync_checker_solver::set_interrupt(const bool interrupt)
+    {
+        solver_->set_interrupt(interrupt);
+    }
+
+    /**
+     * Get the final basis of the last solve (column and row statuses).
+     */
+    bool sync_checker_solver::get_basis(vector<int> &col_stat, vector<int> &row_stat) const
+    {
+        return solver_->get_basis(col_stat, row_stat);
+    }
+
+    /**
+     * Load a starting basis for the next solve, e.g. a cached basis of a
+     * similar routing.
+     */
+    bool sync_checker_solver::set_basis(const vector<int> &col_stat, const vector<int> &row_stat)
+    {
+        return solver_->set_basis(col_stat, row_stat);
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+/**
+ * @file cycle_cut_pool.hpp
+ * @brief Persistent pool of violated cycles across separation rounds
+ *
+ * Separation rounds of a branch-and-cut keep finding the same path
+ * elimination cycles. cycle_cut_pool stores the cycles returned by
+ * path_finder under their canonical signature (sorted routing arcs, the
+ * same key path_finder uses for deduplication), counts how often each one
+ * is violated again and drops the ones that were not violated for a while.
+ *
+ * A pooled cycle C with routing arcs R gives the cut
+ *
+ *     sum_{a in R} x_a <= |R| - 1
+ *
+ * Re-checking it against a new x costs O(|R|), so the pool is scanned
+ * before the LP checker and path_finder are called. For integral x, a
+ * violated pooled cut means all arcs of C are used, hence C is a negative
+ * cycle of the new routing too: x is infeasible without any LP solve.
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "sync_model_a_builder.hpp"
+#include "path_finder.hpp"
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class pooled_cycle
+     * @brief One cycle of the pool with its statistics
+     */
+    class pooled_cycle
+    {
+    public:
+        vector<int> cycle_;     ///< Arc indices, as returned by path_finder (sync arcs shifted)
+        vector<int> signature_; ///< Sorted, unique routing arcs of the cycle
+        size_t n_hits_;         ///< Times the cycle was found violated (including insertion)
+        size_t created_;        ///< Round of insertion
+        size_t last_hit_;       ///< Last round the cycle was violated
+
+        pooled_cycle(void) : cycle_(), signature_(), n_hits_(0), created_(0), last_hit_(0) {}
+
+        virtual ~pooled_cycle(void) {}
+    };
+
+    /**
+     * @class cycle_cut_pool
+     * @brief Hash-indexed pool of violated cycles with aging
+     *
+     * Each call to separate() is one round. A cycle not violated during
+     * more than max_age consecutive rounds is dropped (max_age = 0: cycles
+     * are never dropped).
+     *
+     * ```cpp
+     * cycle_cut_pool pool(builder, 50);
+     *
+     * cycle_list cycles;
+     *
+     * if (pool.separate(x, cycles) == 0)
+     * {
+     *     // Full separation only if no pooled cut is violated
+     *     if (!checker.is_feasible(x, alpha, beta, gamma))
+     *     {
+     *         finder.find_paths(alpha, beta, gamma, cycles);
+     *         pool.add(cycles);
+     *     }
+     * }
+     * ```
+     *
+     * conTSP2_scheduling::set_cut_pool() does the same inside solve().
+     */
+    class cycle_cut_pool
+    {
+    protected:
+        const double tol_;           ///< Violation tolerance
+        const size_t n_routing_arcs_; ///< Number of routing arcs
+        const size_t n_sync_arcs_;    ///< Number of sync arcs
+
+        size_t max_age_; ///< Rounds without violation before a cycle is dropped (0: never)
+        size_t round_;   ///< Current round (number of separate() calls)
+
+        vector<pooled_cycle> cycles_; ///< Pooled cycles, in insertion order
+        unordered_map<vector<int>, size_t, cycle_signature_hash> index_; ///< Signature -> position in cycles_
+
+        size_t n_checks_;     ///< Cumulative separate() calls
+        size_t n_successful_; ///< Calls that found at least one violated cycle
+
+    public:
+        /**
+         * @brief Construct an empty pool
+         * @param builder Model A builder (arc counts)
+         * @param max_age Rounds without violation before a cycle is dropped (0: never)
+         * @param tol Violation tolerance
+         */
+        cycle_cut_pool(const sync_model_a_builder &builder, size_t max_age = 0, double tol = 1E-6);
+
+        virtual ~cycle_cut_pool(void);
+
+        /**
+         * @brief Add cycles found by path_finder
+         * @param cycles Cycles (arc indices, sync arcs shifted by n_routing_arcs)
+         * @return Number of cycles not already in the pool
+         *
+         * A cycle already pooled counts as a hit. Cycles without routing
+         * arcs give no cut and are ignored.
+         */
+        size_t add(const cycle_list &cycles);
+
+        /**
+         * @brief Re-check pooled cycles against x (one round)
+         * @param x Routing variables (model_a order)
+         * @param[out] violated Pooled cycles whose cut is violated, most violated first
+         * @return Number of violated cycles
+         *
+         * Updates hits and ages, then drops cycles older than max_age.
+         */
+        size_t separate(const vector<double> &x, cycle_list &violated);
+
+        /**
+         * @brief Violation of the cut of a pooled cycle
+         * @param x Routing variables
+         * @param inx Position in the pool
+         * @return sum_{a in R} x_a - (|R| - 1), positive if violated
+         */
+        double violation(const vector<double> &x, size_t inx) const;
+
+        /**
+         * @brief 0/1 certificate of a cycle, as sync_difference_checker
+         * @param cycle Arc indices (sync arcs shifted by n_routing_arcs)
+         * @param[out] alpha Routing arc indicator (size n_routing_arcs)
+         * @param[out] gamma Sync arc indicator (size n_sync_arcs)
+         */
+        void get_alpha_gamma(const GOMA::array_view<int> &cycle, vector<double> &alpha, vector<double> &gamma) const;
+
+        /**
+         * @brief Set maximum age
+         * @param max_age Rounds without violation before a cycle is dropped (0: never)
+         */
+        inline void set_max_age(const size_t max_age) { max_age_ = max_age; }
+
+        /**
+         * @brief Remove every cycle and reset the statistics
+         */
+        void clear(void);
+
+        inline size_t size(void) const { return cycles_.size(); }                      ///< Number of pooled cycles
+        inline bool empty(void) const { return cycles_.empty(); }                      ///< true if no cycle is pooled
+        inline size_t get_round(void) const { return round_; }                         ///< Current round
+        inline const pooled_cycle &get_cycle(const size_t inx) const { return cycles_[inx]; } ///< Pooled cycle at a position
+        inline size_t get_n_checks(void) const { return n_checks_; }                   ///< separate() calls
+        inline size_t get_n_successful(void) const { return n_successful_; }           ///< Calls with a violated cycle
+
+    protected:
+        /**
+         * @brief Sorted, unique routing arcs of a cycle
+         * @param cycle Arc indices
+         * @param[out] signature Canonical signature
+         */
+        void signature_(const GOMA::array_view<int> &cycle, vector<int> &signature) const;
+
+        /**
+         * @brief Drop cycles not violated during more than max_age rounds
+         */
+        void age_(void);
+    };
+}
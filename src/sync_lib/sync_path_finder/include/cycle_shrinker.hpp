@@ -0,0 +1,160 @@
+/**
+ * @file cycle_shrinker.hpp
+ * @brief Reduction of violated cycles to minimal infeasible routing arc sets
+ *
+ * A cycle C of path_finder with routing arcs R gives the cut
+ *
+ *     sum_{a in R} x_a <= |R| - 1
+ *
+ * The cycles of the certificate support are often long, and many of them
+ * contain the routing arcs of a shorter violated cycle. The synchronization
+ * constraints hold for every routing, so R is an infeasible set as soon as
+ * the routing arcs of R, completed by any synchronization arcs, close a
+ * negative cycle:
+ *
+ * - routing arc a = (i,j): cost -t_a (x_a = 1)
+ * - sync arc a = (i,j): cost w_a (0 if w_a is infinite, as the γ rows)
+ *
+ * cycle_shrinker finds a minimal such subset R' of R (an irreducible
+ * infeasible subsystem of the routing constraints of C) and replaces C by
+ * the negative cycle of R'. Its cut dominates the one of C, and is violated
+ * whenever that one is: the deficit sum_{a in R'} (1 - x_a) is at most the
+ * one of R. Cycles reduced to the same R' are returned once.
+ *
+ * The search runs on the endpoints of R only: synchronization arcs are
+ * replaced by the shortest sync paths between endpoints (Dijkstra, sync
+ * costs are nonnegative), and the routing arcs are kept. A negative cycle
+ * of that graph (Bellman-Ford) gives a first subset; a deletion filter then
+ * drops, one by one, the routing arcs whose removal leaves a negative cycle.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "sync_model_a_builder.hpp"
+#include "path_finder.hpp"
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class cycle_shrinker
+     * @brief Deletion filter on the routing arcs of violated cycles
+     *
+     * ```cpp
+     * cycle_shrinker shrinker(builder);
+     *
+     * finder.find_paths(alpha, beta, gamma, cycles);
+     * shrinker.shrink(cycles);   // minimal, deduplicated cycles
+     * ```
+     *
+     * Cycles without routing arcs, and cycles that are not negative with
+     * every routing arc used (no valid reduction), are kept as they are.
+     * If a synchronization arc has a negative cost, shrink() keeps every
+     * cycle.
+     */
+    class cycle_shrinker
+    {
+    protected:
+        const double precision_; ///< Costs are counted in units of 1 / precision_, as in the checkers
+
+        const vector<triplet> &routing_arcs_;     ///< Routing arcs (i,j)
+        const vector<triplet> &sync_arcs_;        ///< Sync arcs (i,j)
+        const vector<double> &routing_arc_times_; ///< Travel times t_ij
+        const vector<double> &sync_arc_times_;    ///< Sync offsets w_ij (read at each call)
+
+        const size_t n_operations_;   ///< Vertices
+        const size_t n_routing_arcs_; ///< Routing arcs (sync arcs are shifted by this)
+
+        // Sync graph (CSR by tail), costs of the current call
+        vector<int> sync_head_;          ///< First out-arc of each vertex
+        vector<int> sync_out_;           ///< Sync arcs by tail
+        vector<int64_t> sync_cost_;      ///< Cost of each sync arc, in units
+
+        // Shortest sync paths from the endpoints seen in the current call
+        vector<int> row_;                ///< Row of each source vertex (-1: not computed)
+        vector<int> sources_;            ///< Source vertex of each row
+        vector<int64_t> sync_dist_;      ///< Distances, one row of n_operations per source
+        vector<int> sync_pred_;          ///< Last sync arc of each shortest path (-1: none)
+
+        // Reduced graph of one test
+        vector<int> node_;               ///< Local node of each vertex (-1: not an endpoint)
+        vector<int> vertices_;           ///< Vertex of each local node
+        vector<int> edge_from_;          ///< Tail node of each edge
+        vector<int> edge_to_;            ///< Head node of each edge
+        vector<int64_t> edge_cost_;      ///< Cost of each edge
+        vector<int> edge_arc_;           ///< Routing arc of each edge (-1: sync path)
+        vector<int64_t> dist_;           ///< Bellman-Ford labels
+        vector<int> pred_;               ///< Edge that last lowered each label (-1: none)
+        vector<int> witness_;            ///< Edges of the negative cycle found, in cycle order
+
+        size_t n_cycles_;        ///< Cycles given to shrink()
+        size_t n_shrunk_;        ///< Cycles replaced by a cycle with fewer routing arcs
+        size_t n_duplicates_;    ///< Reduced cycles dropped as duplicates
+        size_t n_arcs_in_;       ///< Routing arcs of the cycles given
+        size_t n_arcs_out_;      ///< Routing arcs of the cycles returned
+        size_t n_tests_;         ///< Negative cycle tests
+
+    public:
+        /**
+         * @brief Construct shrinker from model builder
+         * @param builder Model A builder (must outlive the shrinker)
+         */
+        cycle_shrinker(const sync_model_a_builder &builder);
+
+        virtual ~cycle_shrinker(void);
+
+        /**
+         * @brief Replace each cycle by a minimal violated cycle of its routing arcs
+         * @param[in,out] cycles Cycles (arc indices, sync arcs shifted by
+         *                n_routing_arcs, in cycle order), in place
+         * @return Number of cycles returned
+         *
+         * The order of the first occurrences is kept. The sync arc times are
+         * read from the builder at each call.
+         */
+        size_t shrink(cycle_list &cycles);
+
+        /**
+         * @name Work counters
+         * Totals since construction.
+         */
+        ///@{
+        inline size_t get_n_cycles(void) const { return n_cycles_; }
+        inline size_t get_n_shrunk(void) const { return n_shrunk_; }
+        inline size_t get_n_duplicates(void) const { return n_duplicates_; }
+        inline size_t get_n_arcs_in(void) const { return n_arcs_in_; }
+        inline size_t get_n_arcs_out(void) const { return n_arcs_out_; }
+        inline size_t get_n_tests(void) const { return n_tests_; }
+        ///@}
+
+    protected:
+        /**
+         * @brief Shortest sync paths from a vertex (computed once per call)
+         * @param u Source vertex
+         * @return Row of u in sync_dist_ / sync_pred_
+         */
+        size_t sync_row_(int u);
+
+        /**
+         * @brief Look for a negative cycle closed by a set of routing arcs
+         * @param arcs Routing arcs
+         * @return true if there is one (kept in witness_)
+         */
+        bool negative_cycle_(const vector<int> &arcs);
+
+        /**
+         * @brief Append the arcs of witness_ to a cycle list, in cycle order
+         * @param[out] cycles List the cycle is appended to
+         */
+        void push_witness_(cycle_list &cycles);
+
+        /**
+         * @brief Cost of an arc in units of 1 / precision_
+         */
+        inline int64_t units_(const double val) const { return (int64_t)llround(val * precision_); }
+    };
+}
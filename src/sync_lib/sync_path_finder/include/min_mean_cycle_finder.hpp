@@ -0,0 +1,147 @@
+/**
+ * @file min_mean_cycle_finder.hpp
+ * @brief Polynomial separation of violated cycles by minimum mean cycle search
+ *
+ * path_finder enumerates every simple path of the LP certificate support,
+ * which is exponential on dense fractional supports. min_mean_cycle_finder
+ * works directly on the x-weighted routing + sync graph:
+ *
+ * - routing arc a = (i,j) with x_a > tol: cost -t_a x_a
+ * - sync arc a = (i,j): cost w_a (0 if w_a is infinite, as the γ rows)
+ *
+ * i.e. the constraints s_j - s_i >= t_ij x_ij and s_i - s_j <= w_ij. For an
+ * integral x this is the constraint graph of sync_difference_checker, and
+ * a negative cycle is exactly a violated path elimination cycle.
+ *
+ * Cycles are found with Karp's minimum mean cycle algorithm, O(n m) per
+ * strongly connected component: the cycle whose cost per arc is the most
+ * negative is the most violated one. Each round finds one cycle per
+ * component; further rounds drop the weakest routing arc (smallest x) of
+ * every cycle found, so a cycle is never reported twice.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "sync_model_a_builder.hpp"
+#include "path_finder.hpp"
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class min_mean_cycle_finder
+     * @brief Karp minimum mean cycle separation over the x-weighted graph
+     *
+     * ```cpp
+     * min_mean_cycle_finder finder(builder);
+     * finder.set_max_cycles(10);
+     *
+     * cycle_list cycles;
+     * finder.find_cycles(x, cycles); // most violated first, path_finder arc indices
+     * ```
+     */
+    class min_mean_cycle_finder
+    {
+    protected:
+        const double tol_;       ///< Routing arcs with x_a <= tol_ are not in the graph
+        const double precision_; ///< Costs are truncated to 1 / precision_, as in the checkers
+
+        const vector<triplet> &routing_arcs_;     ///< Routing arcs (i,j)
+        const vector<triplet> &sync_arcs_;        ///< Sync arcs (i,j)
+        const vector<double> &routing_arc_times_; ///< Travel times t_ij
+        const vector<double> &sync_arc_times_;    ///< Sync offsets w_ij
+
+        const size_t n_operations_;  ///< Vertices
+        const size_t n_routing_arcs_; ///< Routing arcs (sync arcs are shifted by this)
+
+        size_t max_cycles_; ///< Cycles per find_cycles call (0: one round)
+
+        // Graph of the current round (CSR by tail)
+        vector<int> edge_from_;    ///< Tail vertex of each edge
+        vector<int> edge_to_;      ///< Head vertex of each edge
+        vector<int> edge_arc_;     ///< Arc index of each edge (sync arcs shifted)
+        vector<double> edge_cost_; ///< Cost of each edge
+        vector<bool> removed_;     ///< Arcs dropped by earlier rounds (routing then sync)
+
+        vector<int> head_;   ///< First out-edge of each vertex
+        vector<int> degree_; ///< Out-degree / insertion cursor
+
+        // Strongly connected components
+        vector<int> component_;       ///< Component of each vertex
+        vector<int> index_;           ///< Tarjan DFS index
+        vector<int> low_;             ///< Tarjan low link
+        vector<int> stack_;           ///< Tarjan vertex stack
+        vector<bool> on_stack_;       ///< Vertex on the Tarjan stack
+        vector<vector<int>> members_; ///< Vertices of each component
+
+        // Karp tables, n + 1 levels over the vertices of one component
+        vector<int> local_;      ///< Local index of each vertex in its component
+        vector<double> dist_;    ///< Minimum cost of walks with k edges
+        vector<int> pred_edge_;  ///< Last edge of those walks
+        vector<int> walk_pos_;   ///< Level of each vertex on the critical walk
+
+        size_t n_components_; ///< Components with at least one cycle
+        size_t n_rounds_;     ///< Rounds of the last call
+
+    public:
+        /**
+         * @brief Construct finder from model builder
+         * @param builder Model A builder (must outlive the finder)
+         */
+        min_mean_cycle_finder(const sync_model_a_builder &builder);
+
+        virtual ~min_mean_cycle_finder(void);
+
+        /**
+         * @brief Find violated cycles of x, most violated first
+         * @param x Routing variables (model_a order)
+         * @param[out] cycles Cycles appended (arc indices, sync arcs shifted
+         *             by n_routing_arcs, in cycle order); cycles with a
+         *             routing arc set already in the list are skipped
+         * @return Number of cycles added
+         */
+        size_t find_cycles(const vector<double> &x, cycle_list &cycles);
+
+        /**
+         * @brief Bound the number of cycles per call
+         * @param max_cycles Maximum cycles (0: one round, i.e. one per component)
+         */
+        inline void set_max_cycles(const size_t max_cycles) { max_cycles_ = max_cycles; }
+
+        /**
+         * @brief Cost of a cycle in the x-weighted graph
+         * @param x Routing variables
+         * @param cycle Arc indices
+         * @return Sum of the arc costs (negative if violated)
+         */
+        double get_cost(const vector<double> &x, const GOMA::array_view<int> &cycle) const;
+
+        inline size_t get_n_components(void) const { return n_components_; }
+        inline size_t get_n_rounds(void) const { return n_rounds_; }
+
+    protected:
+        /**
+         * @brief Build the CSR graph of the active, not removed arcs
+         * @param x Routing variables
+         */
+        void build_graph_(const vector<double> &x);
+
+        /**
+         * @brief Tarjan strongly connected components (iterative)
+         */
+        void find_components_(void);
+
+        /**
+         * @brief Karp minimum mean cycle of one component
+         * @param members Vertices of the component
+         * @param[out] cycle Edges of the cycle, in cycle order
+         * @return Cost of the cycle (>= 0 if none is negative)
+         */
+        double min_mean_cycle_(const vector<int> &members, vector<int> &cycle);
+
+        inline double truncate_(const double val) const { return round(val * precision_) / precision_; }
+    };
+}
@@ -17,8 +17,24 @@
  * 2. For each active sync arc (i,j):
  *    a. Find all simple paths from i to j using DFS
  *    b. Close each path with arc (j,i) to form cycle
- * 3. Remove duplicate cycles (same routing arc set)
+ * 3. Drop duplicate cycles (same routing arc set) as they are produced,
+ *    using a hash set of canonical cycle signatures
+ *
+ * Paths and cycles are kept in flat lists (cycle_list): one arc array and
+ * one offset array, reused from call to call, instead of a vector per cycle.
+ *
+ * Step 2 may run on several threads (set_n_threads), one DFS per sync arc
+ * on the shared support graph; duplicates are then dropped when merging.
  * 
+ * Bounded mode (set_limits): instead of enumerating all paths, the k most
+ * violated cycles per sync arc are found by best-first search, with a
+ * global cap and a time budget. Arc priorities come from the alpha/gamma
+ * weights of the certificate.
+ *
+ * Deadline (set_deadline): the searches poll a GOMA::search_deadline and
+ * stop when it expires or is cancelled; the cycles found until then are
+ * returned and is_truncated() reports the stop.
+ *
  * Used in constraint generation for branch-and-cut CTSP solving.
  */
 
@@ -28,15 +44,54 @@
 #include <string>
 #include <iostream>
 #include <utility>
+#include <unordered_set>
+#include <atomic>
 
 #include "sync_model_a_builder.hpp"
 #include "graph.hpp"
+#include "array_view.hpp"
+#include "stats_timer.hpp"
+#include "search_deadline.hpp"
 
 using namespace std;
 
 namespace SYNC_LIB
 {
 
+    /**
+     * @struct cycle_signature_hash
+     * @brief Hash of a cycle signature (sorted routing arc indices)
+     *
+     * Combines the indices with the boost::hash_combine mixing step, so two
+     * cycles with the same routing arc set always hash to the same value.
+     */
+    struct cycle_signature_hash
+    {
+        size_t operator()(const vector<int> &signature) const
+        {
+            size_t seed{signature.size()};
+
+            for (const int arc : signature)
+                seed ^= hash<int>()(arc) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+            return seed;
+        }
+    };
+
+    /// Set of cycle signatures (sorted routing arc indices of each unique cycle)
+    typedef unordered_set<vector<int>, cycle_signature_hash> cycle_signature_set;
+
+    /**
+     * @struct arc_cycle_span
+     * @brief Cycles of one sync arc in the list of the thread that searched it
+     */
+    struct arc_cycle_span
+    {
+        size_t list_;  ///< Thread (index of its cycle list)
+        size_t first_; ///< First cycle of the sync arc in that list
+        size_t n_;     ///< Number of cycles of the sync arc (0: none, or not searched)
+    };
+
     /**
      * @class path_finder
      * @brief Cycle detector for CTSP synchronization constraints
@@ -72,6 +127,54 @@ namespace SYNC_LIB
 
         GOMA::search_graph support_graph_;  ///< DFS graph for cycle detection
 
+        // Support graph of the previous call, updated by difference
+        vector<bool> in_support_;       ///< Arc in support_graph_ (routing, then sync arcs)
+        vector<double> support_cost_;   ///< Cost of each arc in support_graph_
+        vector<int> n_depot_arcs_;      ///< Active routing arcs of each depot (active depot set)
+        vector<int> routing_support_;   ///< Routing arcs in support_graph_, increasing
+        vector<int> routing_previous_;  ///< Scratch: routing_support_ of the previous call
+        size_t n_support_changes_;      ///< Arcs added, removed or recosted by the last update
+        size_t n_support_arcs_;         ///< Arcs in support_graph_
+
+        cycle_signature_set cycle_signatures_;  ///< Signatures of the cycles found in the current call
+
+        GOMA::ragged_array<int> sequences_;     ///< Vertex sequences of the serial searches (reused)
+        vector<cycle_list> thread_cycles_;      ///< Cycles of each thread of the full enumeration (reused)
+
+        size_t max_cycles_per_arc_;  ///< Bounded mode: cycles per active sync arc (0: no limit)
+        size_t max_cycles_;          ///< Bounded mode: cycles per find_paths call (0: no limit)
+        double time_limit_;          ///< Bounded mode: seconds per find_paths call (0: no limit)
+
+        const GOMA::search_deadline *deadline_; ///< Stop token of the searches (not owned, NULL: none)
+        bool truncated_;             ///< The last find_paths call stopped before searching every sync arc
+
+        double max_weight_;          ///< Largest alpha/gamma weight of the current support graph
+
+        size_t n_threads_;           ///< Threads for the full enumeration (1: serial)
+
+        bool shared_sources_;        ///< Full enumeration: one traversal per distinct sync arc source
+        bool work_stealing_;         ///< Full enumeration: every thread on each sync arc's DFS in turn
+
+        // Integral fast path (set_integral_fast_path)
+        bool integral_fast_path_;    ///< Integral routing support: route walk instead of enumeration
+        bool last_integral_;         ///< The last find_paths call took the fast path
+        vector<int> route_next_;     ///< Active routing successor of each vertex (-1: none)
+        vector<int> route_prev_;     ///< Active routing predecessor of each vertex (-1: none)
+        vector<int> walk_dist_;      ///< Sync arcs on the best walk from the source (-1: not reached)
+        vector<int> walk_pred_;      ///< Previous vertex on that walk
+
+        // Work counters (USE_STATS), totals since construction
+        size_t n_calls_;                 ///< find_paths calls
+        size_t n_support_arcs_total_;    ///< Support graph arcs, summed over the calls
+        size_t n_worker_expanded_;       ///< DFS nodes of the parallel / shared-source workspaces
+        size_t n_steals_;                ///< Frontiers handed between work-stealing workers
+        mutable size_t n_cycles_found_;  ///< Cycles checked against the signature set
+        mutable size_t n_cycles_new_;    ///< Those with a new signature
+
+        // Memory peaks (USE_STATS), over the calls
+        size_t worker_bytes_;        ///< Worker workspaces and per-arc cycles of the current call
+        size_t peak_search_bytes_;   ///< Largest adjacency lists + workspaces + signatures + worker scratch
+
     public:
         /**
          * @brief Construct path finder from model builder
@@ -92,28 +195,189 @@ namespace SYNC_LIB
          * @param alpha_v Routing arc variables (size = n_routing_arcs)
          * @param beta_v Time variables (currently unused in path finding)
          * @param gamma_v Sync arc variables (size = n_sync_arcs)
-         * @param[out] cycles Output vector of cycles (each cycle = vector of arc indices)
+         * @param[in,out] cycles Cycles (lists of arc indices); new ones are appended
          * 
          * Main algorithm:
          * 1. Update support graph with active arcs (alpha > tol, gamma > tol)
          * 2. For each active sync arc, find all paths using DFS
          * 3. Close paths to form cycles
-         * 4. Remove duplicate cycles
+         * 4. Keep a cycle only if its routing arc set was not seen before
          * 
          * Each cycle is represented as vector of arc indices:
          * - Indices [0, n_routing_arcs) are routing arcs
          * - Indices [n_routing_arcs, ...) are sync arcs (offset by n_routing_arcs)
+         *
+         * @param routing_candidates Routing arcs where alpha may be nonzero,
+         *        increasing (NULL: every routing arc). A certificate of x is
+         *        0 outside the support of x: with its sparse_x indices, the
+         *        routing part of the update visits those arcs and the ones
+         *        of the previous support only.
+         */
+        void find_paths(const GOMA::array_view<double> &alpha_v,
+                        const GOMA::array_view<double> &beta_v,
+                        const GOMA::array_view<double> &gamma_v,
+                        cycle_list &cycles,
+                        const vector<int> *routing_candidates = NULL);
+
+        /**
+         * @brief Bound the cycle enumeration
+         * @param max_cycles_per_arc Cycles kept per active sync arc (0: no limit)
+         * @param max_cycles Cycles kept per find_paths call (0: no limit)
+         * @param time_limit Seconds per find_paths call (0: no limit)
+         *
+         * With any limit set, find_paths runs in bounded mode: for each
+         * active sync arc, the cheapest paths are found by best-first search,
+         * where an arc with weight w costs 1 - w / w_max (w_max being the
+         * largest alpha/gamma weight). Cycles with the largest weights, i.e.
+         * most violated, come first. New cycles are returned sorted by cost.
+         * With no limit (the default), all cycles are enumerated by DFS.
+         */
+        void set_limits(size_t max_cycles_per_arc, size_t max_cycles, double time_limit);
+
+        /**
+         * @brief Check if the enumeration is bounded
+         * @return true if any limit of set_limits() is active
+         */
+        inline bool is_bounded(void) const { return max_cycles_per_arc_ > 0 || max_cycles_ > 0 || time_limit_ > 0; }
+
+        /**
+         * @brief Stop the searches of find_paths at a deadline
+         * @param deadline Stop token (not owned, NULL to disable), polled
+         *        by the DFS every 1024 steps
+         *
+         * The full enumeration stops inside the DFS of the sync arc being
+         * searched (the threads stop at their next poll); the bounded mode
+         * gives each best-first search the time left and sees a
+         * cancellation between sync arcs. The integral fast path is
+         * polynomial and never stops.
+         */
+        inline void set_deadline(const GOMA::search_deadline *deadline) { deadline_ = deadline; }
+
+        /**
+         * @brief Check if the last find_paths call was cut short
+         * @return true if the deadline (or the time limit of set_limits)
+         *         stopped it: the cycles returned are a subset of the
+         *         complete output
+         */
+        inline bool is_truncated(void) const { return truncated_; }
+
+        /**
+         * @brief Get number of support graph changes of the last find_paths call
+         * @return Arcs added, removed or recosted
+         */
+        inline size_t get_n_support_changes(void) const { return n_support_changes_; }
+
+        /**
+         * @brief Get number of arcs of the current support graph
+         * @return Routing and sync arcs in the support of the last find_paths call
+         */
+        inline size_t get_n_support_arcs(void) const { return n_support_arcs_; }
+
+        /**
+         * @name Work counters (0 unless built with USE_STATS)
+         * Totals since construction. Cycles found count every closed path
+         * (and pooled cycle) checked for duplicates; the new ones are
+         * those with a routing arc set not seen in the same call, before
+         * the bounded mode cap (max_cycles).
+         */
+        ///@{
+        inline size_t get_n_calls(void) const { return n_calls_; }
+        inline size_t get_n_support_arcs_total(void) const { return n_support_arcs_total_; }
+        inline size_t get_n_dfs_nodes(void) const { return support_graph_.get_n_expanded() + n_worker_expanded_; }
+        inline size_t get_n_cycles_found(void) const { return n_cycles_found_; }
+        inline size_t get_n_cycles_new(void) const { return n_cycles_new_; }
+        inline size_t get_n_steals(void) const { return n_steals_; }
+        ///@}
+
+        /**
+         * @brief Heap bytes held now (support graph, signatures, support arrays, cycle lists)
+         *
+         * The support graph includes its pre-allocated DFS stack, of
+         * (n + 2)(n + 1) entries for n operations.
+         */
+        size_t get_memory_bytes(void) const;
+
+        /**
+         * @name Memory of the searches (peak 0 unless built with USE_STATS)
+         * The peak is the largest value at the end of a find_paths call,
+         * before the scratch of that call is released.
          */
-        void find_paths(const vector<double> &alpha_v,
-                        const vector<double> &beta_v,
-                        const vector<double> &gamma_v,
-                        vector<vector<int>> &cycles);
+        ///@{
+        inline size_t get_support_succ_bytes(void) const { return support_graph_.get_succ_bytes(); }
+        inline size_t get_support_stack_bytes(void) const { return support_graph_.get_stack_bytes(); }
+        inline size_t get_peak_search_bytes(void) const { return peak_search_bytes_; }
+        ///@}
+
+        /**
+         * @brief Set number of threads of the full enumeration
+         * @param n_threads Number of threads (0: one per hardware thread, 1: serial)
+         *
+         * Each thread runs the DFS of a share of the active sync arcs on the
+         * shared support graph, with its own search_workspace. Cycles are
+         * merged and deduplicated in sync arc order at the end, so the
+         * output is the same for any number of threads.
+         */
+        void set_n_threads(size_t n_threads);
+
+        /**
+         * @brief Enable reachability pruning of the path searches (default on)
+         * @param pruning false: every search explores all vertices reachable
+         *        from its source (same cycles, for comparison)
+         */
+        inline void set_pruning(const bool pruning) { support_graph_.set_pruning(pruning); }
+
+        /**
+         * @brief Serve all sync arcs with the same source by one traversal
+         * @param shared_sources true: the full enumeration runs one
+         *        multi-target search per distinct source (same cycles, in
+         *        the same order, as one search per sync arc)
+         *
+         * The visits of a customer are linked pairwise across depots, so
+         * many active sync arcs share their source operation.
+         */
+        inline void set_shared_sources(const bool shared_sources) { shared_sources_ = shared_sources; }
+
+        /**
+         * @brief Spread each sync arc's DFS over the threads instead of the sync arcs
+         * @param work_stealing true: with more than one thread, the sync
+         *        arcs are searched one after the other, each by every thread
+         *        (search_graph::stealing_DFS); same cycles, in the same order
+         *
+         * One sync arc often owns most of the search tree: spreading the
+         * arcs leaves the other threads idle while it runs. Shared sources
+         * take precedence.
+         */
+        inline void set_work_stealing(const bool work_stealing) { work_stealing_ = work_stealing; }
+
+        /**
+         * @brief Walk the routes instead of enumerating paths for integral supports
+         * @param integral_fast_path true: when every vertex has at most one
+         *        active routing arc in and out (integral x), the full
+         *        enumeration is replaced by find_route_cycles_
+         *
+         * The routing support is then a set of disjoint routes, and for each
+         * active sync arc (i,j) one cycle is returned: the walk from i to j
+         * along route segments with the fewest sync arcs, closed by (j,i).
+         * This is a subset of the enumerated cycles (one per sync arc
+         * instead of all of them). Fractional supports are still enumerated.
+         */
+        inline void set_integral_fast_path(const bool integral_fast_path) { integral_fast_path_ = integral_fast_path; }
+
+        /**
+         * @brief Check if the last find_paths call took the integral fast path
+         */
+        inline bool is_last_integral(void) const { return last_integral_; }
+
+        /**
+         * @brief Strongly connected components of the last support graph
+         */
+        inline size_t get_n_components(void) const { return support_graph_.get_n_components(); }
         
     protected:
     
-        void sequence_2_path_(const vector<int> &sequence,
-                              const vector<double> &alpha_v,
-                              const vector<double> &beta_v,
+        void sequence_2_path_(const GOMA::array_view<int> &sequence,
+                              const GOMA::array_view<double> &alpha_v,
+                              const GOMA::array_view<double> &beta_v,
                               vector<int> &cycle) const;
 
         /**
@@ -122,19 +386,22 @@ namespace SYNC_LIB
          * @param beta_v Time variables (unused)
          * @param gamma_v Sync arc variables
          * @param active_sync_arcs Active sync arcs from support graph update
-         * @param[out] cycles Output vector of cycles
+         * @param[in,out] cycles Output cycles
          * 
          * For each active sync arc (i,j):
          * 1. Run DFS from i to j to find all paths
          * 2. Convert vertex sequences to arc sequences
          * 3. Close cycle by adding arc (j,i)
-         * 4. Remove duplicate cycles
+         * 4. Append it to cycles unless its signature is already in cycle_signatures_
+         *
+         * Cycles already in the output vector are deduplicated first and
+         * count as seen.
          */
-        void find_full_paths_(const vector<double> &alpha_v,
-                              const vector<double> &beta_v,
-                              const vector<double> &gamma_v,
+        void find_full_paths_(const GOMA::array_view<double> &alpha_v,
+                              const GOMA::array_view<double> &beta_v,
+                              const GOMA::array_view<double> &gamma_v,
                               const vector<pair<int, int>> &active_sync_arcs,
-                              vector<vector<int>> &cycles);
+                              cycle_list &cycles);
 
         /**
          * @brief Find closing arc index for sync arc
@@ -145,6 +412,110 @@ namespace SYNC_LIB
          */
         int closing_arc_(const pair<int, int> &arc) const;
 
+        /**
+         * @brief Search cost of an arc with weight w
+         * @param w alpha or gamma weight of the arc
+         * @return 1 - w / max_weight_, clamped to [0, 1]
+         */
+        double arc_cost_(double w) const;
+
+        /**
+         * @brief Cycles through active sync arcs [first, last), before deduplication
+         * @param alpha_v Routing arc variables
+         * @param gamma_v Sync arc variables
+         * @param active_sync_arcs Active sync arcs from support graph update
+         * @param next_arc Shared counter: next sync arc to take (0-based)
+         * @param truncated Shared flag: set when the deadline stops a search
+         * @param ws Search state of the calling thread
+         * @param list Index of the calling thread's list in thread_cycles_
+         * @param[in,out] cycles That list (cycles of the thread's sync arcs are appended)
+         * @param[out] arc_spans Where the cycles of each sync arc are (one entry per active sync arc)
+         *
+         * Worker of the parallel enumeration: takes sync arcs one at a time
+         * from next_arc until all are taken or the deadline expires. Only
+         * reads the support graph.
+         */
+        void enumerate_arc_cycles_(const GOMA::array_view<double> &alpha_v,
+                                   const GOMA::array_view<double> &gamma_v,
+                                   const vector<pair<int, int>> &active_sync_arcs,
+                                   atomic<size_t> &next_arc,
+                                   atomic<bool> &truncated,
+                                   GOMA::search_workspace &ws,
+                                   size_t list,
+                                   cycle_list &cycles,
+                                   vector<arc_cycle_span> &arc_spans) const;
+
+        /**
+         * @brief Cycles of groups of active sync arcs with a common source, before deduplication
+         * @param alpha_v Routing arc variables
+         * @param gamma_v Sync arc variables
+         * @param active_sync_arcs Active sync arcs from support graph update
+         * @param groups Indices (in active_sync_arcs) of the arcs of each source
+         * @param next_group Shared counter: next group to take (0-based)
+         * @param truncated Shared flag: set when the deadline stops a search
+         * @param ws Search state of the calling thread
+         * @param list Index of the calling thread's list in thread_cycles_
+         * @param[in,out] cycles That list (cycles of the thread's sync arcs are appended)
+         * @param[out] arc_spans Where the cycles of each sync arc are (one entry per active sync arc)
+         *
+         * Shared-source counterpart of enumerate_arc_cycles_: one
+         * multi-target backtrack_DFS per group. Only reads the support graph.
+         */
+        void enumerate_source_cycles_(const GOMA::array_view<double> &alpha_v,
+                                      const GOMA::array_view<double> &gamma_v,
+                                      const vector<pair<int, int>> &active_sync_arcs,
+                                      const vector<vector<size_t>> &groups,
+                                      atomic<size_t> &next_group,
+                                      atomic<bool> &truncated,
+                                      GOMA::search_workspace &ws,
+                                      size_t list,
+                                      cycle_list &cycles,
+                                      vector<arc_cycle_span> &arc_spans) const;
+
+        /**
+         * @brief Record the active routing successor / predecessor of each vertex
+         * @param alpha_v Routing arc variables
+         * @return true if no vertex has two active routing arcs out or in
+         *
+         * Walks routing_support_ (the arcs with alpha > tolerance).
+         */
+        bool integral_support_(const GOMA::array_view<double> &alpha_v);
+
+        /**
+         * @brief Fast path of find_paths for integral supports
+         * @param alpha_v Routing arc variables
+         * @param gamma_v Sync arc variables
+         * @param active_sync_arcs Active sync arcs from support graph update
+         * @param[in,out] cycles New cycles (one per active sync arc at most) are appended
+         *
+         * One 0-1 breadth-first search per distinct source on the support
+         * graph: route arcs cost 0, sync arcs cost 1, so route segments are
+         * walked at no cost. O(V + E) per source.
+         */
+        void find_route_cycles_(const GOMA::array_view<double> &alpha_v,
+                                const GOMA::array_view<double> &gamma_v,
+                                const vector<pair<int, int>> &active_sync_arcs,
+                                cycle_list &cycles);
+
+        /**
+         * @brief Append the new cycles of each sync arc, in sync arc order
+         * @param arc_spans Where the cycles of each active sync arc are in thread_cycles_
+         * @param[in,out] cycles Cycles with a new signature are appended
+         */
+        void merge_arc_cycles_(const vector<arc_cycle_span> &arc_spans, cycle_list &cycles);
+
+        /**
+         * @brief Bounded mode of find_full_paths_ (see set_limits)
+         * @param alpha_v Routing arc variables
+         * @param gamma_v Sync arc variables
+         * @param active_sync_arcs Active sync arcs from support graph update
+         * @param[in,out] cycles New cycles are appended, cheapest first
+         */
+        void find_best_paths_(const GOMA::array_view<double> &alpha_v,
+                              const GOMA::array_view<double> &gamma_v,
+                              const vector<pair<int, int>> &active_sync_arcs,
+                              cycle_list &cycles);
+
         /**
          * @brief Update support graph with active arcs from LP solution
          * @param alpha_v Routing arc variables
@@ -152,38 +523,104 @@ namespace SYNC_LIB
          * @param gamma_v Sync arc variables
          * @param[out] active_sync_arcs Sync arcs with gamma > tolerance
          * 
-         * Rebuilds support graph:
-         * 1. Clear existing graph
-         * 2. Add routing arcs where alpha > tolerance
-         * 3. Add sync arcs where gamma > tolerance
-         * 4. Collect active sync arcs for cycle detection
+         * Updates the support graph of the previous call by difference:
+         * 1. Add routing arcs whose alpha rose above tolerance, remove those
+         *    that dropped below it (per-depot counts of active arcs follow)
+         * 2. Same for sync arcs and gamma
+         * 3. Collect active sync arcs for cycle detection
+         *
+         * Arcs carry cost arc_cost_(weight), used in bounded mode; the cost
+         * of an arc that stays active is only rewritten if it changed. The
+         * graph operations are proportional to the arcs that changed.
          * 
          * Active sync arcs selected based on:
          * - If arc connects non-depot operations: always include
          * - If arc connects depots: include only if both depots are active
+         *
+         * With routing candidates, the routing arcs visited are those
+         * candidates and routing_support_ (merged, in increasing order as
+         * the full scan would), so the graph is the same.
+         */
+        void update_support_graph_(const GOMA::array_view<double> &alpha_v,
+                                   const GOMA::array_view<double> &beta_v,
+                                   const GOMA::array_view<double> &gamma_v,
+                                   vector<pair<int, int>> &active_sync_arcs,
+                                   const vector<int> *routing_candidates);
+
+        /**
+         * @brief Add, recost or remove a routing arc of the support graph
+         * @param a Routing arc
+         * @param alpha Its alpha
+         */
+        void update_routing_arc_(size_t a, double alpha);
+
+        /**
+         * @brief Put an active arc in the support graph, or update its cost
+         * @param a Arc index (sync arcs offset by n_routing_arcs)
+         * @param arc Arc endpoints
+         * @param cost Arc cost
+         */
+        void update_support_arc_(size_t a, const triplet &arc, double cost);
+
+        /**
+         * @brief Take an arc out of the support graph
+         * @param a Arc index (sync arcs offset by n_routing_arcs)
+         * @param arc Arc endpoints
+         */
+        void remove_support_arc_(size_t a, const triplet &arc);
+
+        /**
+         * @brief Insert the signature of a cycle in a signature set
+         * @param cycle Cycle (arc indices, sync arcs offset by n_routing_arcs)
+         * @param[in,out] signatures Signature set
+         * @return true if the cycle was not in the set (it is a new cycle)
+         *
+         * The signature is the sorted list of routing arcs of the cycle, so
+         * sync arcs and arc order are ignored.
          */
-        void update_support_graph_(const vector<double> &alpha_v,
-                                   const vector<double> &beta_v,
-                                   const vector<double> &gamma_v,
-                                   vector<pair<int, int>> &active_sync_arcs);
+        bool insert_signature_(const GOMA::array_view<int> &cycle, cycle_signature_set &signatures) const;
+
+        /**
+         * @brief Size thread_cycles_ for n_threads threads and empty the lists
+         * @param n_threads Threads of the full enumeration
+         */
+        void prepare_thread_cycles_(size_t n_threads);
+
+        /**
+         * @brief Heap bytes of the per-thread cycle lists
+         */
+        size_t thread_cycles_bytes_(void) const;
+
+        /**
+         * @brief Heap bytes of a signature set (buckets, nodes and signatures)
+         */
+        static size_t signature_bytes_(const cycle_signature_set &signatures);
+
+        /**
+         * @brief Update the memory peak at the end of a find_paths call
+         */
+        void note_peak_bytes_(void);
+
+        /**
+         * @brief Remove duplicate cycles, recording the signatures kept
+         * @param[in,out] cycles Cycles (compacted in place)
+         * @param[in,out] signatures Signature set (kept cycles are inserted)
+         */
+        void remove_repeated_cycles_(cycle_list &cycles, cycle_signature_set &signatures) const;
 
     public:
         /**
          * @brief Remove duplicate cycles from cycle list
-         * @param[in,out] cycles Vector of cycles (modified to remove duplicates)
+         * @param[in,out] cycles Cycles (duplicates removed in place)
          * 
          * Two cycles are considered duplicates if they contain the same
-         * routing arcs (ignoring sync arcs and arc order).
-         * 
-         * Algorithm:
-         * 1. Convert each cycle to boolean vector of routing arcs
-         * 2. Compare all pairs of cycles
-         * 3. Mark duplicates for removal
-         * 4. Rebuild cycle vector without duplicates
+         * routing arcs (ignoring sync arcs and arc order). The first
+         * occurrence is kept and the relative order of cycles is preserved.
          * 
-         * Note: Comment in code acknowledges inefficiency (O(n²×m) comparisons)
+         * Expected O(total cycle length · log(cycle length)): each cycle is
+         * reduced to its sorted routing arc signature and looked up in a hash set.
          */
-        void remove_repeated_cycles_(vector<vector<int>> &cycles) const;
+        void remove_repeated_cycles_(cycle_list &cycles) const;
     };
 
 }
\ No newline at end of file
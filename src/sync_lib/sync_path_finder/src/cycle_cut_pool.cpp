@@ -0,0 +1,204 @@
+/**
+ * @file cycle_cut_pool.cpp
+ * @brief Implementation of the persistent pool of violated cycles
+ */
+
+#include "cycle_cut_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace SYNC_LIB
+{
+    cycle_cut_pool::cycle_cut_pool(const sync_model_a_builder &builder, const size_t max_age, const double tol) : tol_(tol),
+                                                                                                              n_routing_arcs_(builder.get_n_routing_arcs()),
+                                                                                                              n_sync_arcs_(builder.get_n_sync_arcs()),
+                                                                                                              max_age_(max_age),
+                                                                                                              round_(0),
+                                                                                                              cycles_(),
+                                                                                                              index_(),
+                                                                                                              n_checks_(0),
+                                                                                                              n_successful_(0)
+    {
+    }
+
+    cycle_cut_pool::~cycle_cut_pool(void)
+    {
+    }
+
+    void cycle_cut_pool::clear(void)
+    {
+        cycles_.clear();
+        index_.clear();
+
+        round_ = 0;
+        n_checks_ = 0;
+        n_successful_ = 0;
+    }
+
+    void cycle_cut_pool::signature_(const GOMA::array_view<int> &cycle, vector<int> &signature) const
+    {
+        signature.clear();
+
+        for (const int c_arc : cycle)
+        {
+            if (c_arc < (int)n_routing_arcs_)
+                signature.push_back(c_arc);
+        }
+
+        sort(signature.begin(), signature.end());
+        signature.erase(unique(signature.begin(), signature.end()), signature.end());
+    }
+
+    size_t cycle_cut_pool::add(const cycle_list &cycles)
+    {
+        size_t n_new{0};
+
+        vector<int> signature;
+
+        for (const GOMA::array_view<int> cycle : cycles)
+        {
+            signature_(cycle, signature);
+
+            if (signature.empty())
+                continue;
+
+            const auto it{index_.find(signature)};
+
+            if (it != index_.end())
+            {
+                pooled_cycle &c_cycle{cycles_[it->second]};
+
+                c_cycle.n_hits_++;
+                c_cycle.last_hit_ = round_;
+
+                continue;
+            }
+
+            index_.emplace(signature, cycles_.size());
+
+            cycles_.push_back(pooled_cycle());
+
+            pooled_cycle &c_cycle{cycles_.back()};
+
+            cycle.copy_to(c_cycle.cycle_);
+            c_cycle.signature_ = signature;
+            c_cycle.n_hits_ = 1;
+            c_cycle.created_ = round_;
+            c_cycle.last_hit_ = round_;
+
+            n_new++;
+        }
+
+        return n_new;
+    }
+
+    double cycle_cut_pool::violation(const vector<double> &x, const size_t inx) const
+    {
+        const vector<int> &signature{cycles_[inx].signature_};
+
+        // sum x_a - (|R| - 1) = 1 - sum (1 - x_a)
+        double missing{0.0};
+
+        for (const int arc : signature)
+            missing += 1.0 - x[arc];
+
+        return 1.0 - missing;
+    }
+
+    size_t cycle_cut_pool::separate(const vector<double> &x, cycle_list &violated)
+    {
+        round_++;
+        n_checks_++;
+
+        vector<pair<double, size_t>> candidates;
+
+        const size_t n_cycles{cycles_.size()};
+
+        for (size_t i{0}; i < n_cycles; i++)
+        {
+            const vector<int> &signature{cycles_[i].signature_};
+
+            // Stop as soon as the cut cannot be violated (missing mass >= 1)
+            double missing{0.0};
+            size_t k{0};
+
+            for (; k < signature.size() && missing < 1.0 - tol_; k++)
+                missing += 1.0 - x[signature[k]];
+
+            if (k == signature.size() && missing < 1.0 - tol_)
+                candidates.push_back(make_pair(1.0 - missing, i));
+        }
+
+        // Most violated first; pool order breaks ties
+        stable_sort(candidates.begin(), candidates.end(),
+                    [](const pair<double, size_t> &a, const pair<double, size_t> &b)
+                    {
+                        return a.first > b.first;
+                    });
+
+        violated.clear();
+
+        for (const pair<double, size_t> &candidate : candidates)
+        {
+            pooled_cycle &c_cycle{cycles_[candidate.second]};
+
+            c_cycle.n_hits_++;
+            c_cycle.last_hit_ = round_;
+
+            violated.push_back(c_cycle.cycle_);
+        }
+
+        if (!violated.empty())
+            n_successful_++;
+
+        age_();
+
+        return violated.size();
+    }
+
+    void cycle_cut_pool::age_(void)
+    {
+        if (max_age_ == 0)
+            return;
+
+        const size_t n_cycles{cycles_.size()};
+
+        size_t n_kept{0};
+
+        for (size_t i{0}; i < n_cycles; i++)
+        {
+            if (round_ - cycles_[i].last_hit_ <= max_age_)
+            {
+                if (n_kept != i)
+                    cycles_[n_kept] = move(cycles_[i]);
+
+                n_kept++;
+            }
+        }
+
+        if (n_kept == n_cycles)
+            return;
+
+        cycles_.resize(n_kept);
+
+        index_.clear();
+
+        for (size_t i{0}; i < n_kept; i++)
+            index_.emplace(cycles_[i].signature_, i);
+    }
+
+    void cycle_cut_pool::get_alpha_gamma(const GOMA::array_view<int> &cycle, vector<double> &alpha, vector<double> &gamma) const
+    {
+        alpha.assign(n_routing_arcs_, 0.0);
+        gamma.assign(n_sync_arcs_, 0.0);
+
+        for (const int arc : cycle)
+        {
+            if (arc < (int)n_routing_arcs_)
+                alpha[arc] = 1.0;
+            else
+                gamma[arc - n_routing_arcs_] = 1.0;
+        }
+    }
+}
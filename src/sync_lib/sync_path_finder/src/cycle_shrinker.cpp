@@ -0,0 +1,369 @@
+/**
+ * @file cycle_shrinker.cpp
+ * @brief Implementation of the violated cycle reduction
+ */
+
+#include "cycle_shrinker.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    static const int64_t SHRINK_INF{numeric_limits<int64_t>::max() / 4};
+
+    cycle_shrinker::cycle_shrinker(const sync_model_a_builder &builder) : precision_(1E3),
+                                                                          routing_arcs_(builder.get_routing_arcs()),
+                                                                          sync_arcs_(builder.get_sync_arcs()),
+                                                                          routing_arc_times_(builder.get_routing_arc_times()),
+                                                                          sync_arc_times_(builder.get_sync_arc_times()),
+                                                                          n_operations_(builder.get_n_operations()),
+                                                                          n_routing_arcs_(builder.get_n_routing_arcs()),
+                                                                          sync_head_(n_operations_ + 1, 0),
+                                                                          sync_out_(sync_arcs_.size()),
+                                                                          sync_cost_(sync_arcs_.size()),
+                                                                          row_(n_operations_, -1),
+                                                                          sources_(),
+                                                                          sync_dist_(),
+                                                                          sync_pred_(),
+                                                                          node_(n_operations_, -1),
+                                                                          vertices_(),
+                                                                          edge_from_(),
+                                                                          edge_to_(),
+                                                                          edge_cost_(),
+                                                                          edge_arc_(),
+                                                                          dist_(),
+                                                                          pred_(),
+                                                                          witness_(),
+                                                                          n_cycles_(0),
+                                                                          n_shrunk_(0),
+                                                                          n_duplicates_(0),
+                                                                          n_arcs_in_(0),
+                                                                          n_arcs_out_(0),
+                                                                          n_tests_(0)
+    {
+        // Sync arcs by tail
+        for (const triplet &arc : sync_arcs_)
+            sync_head_[arc.i_ + 1]++;
+
+        for (size_t i{0}; i < n_operations_; i++)
+            sync_head_[i + 1] += sync_head_[i];
+
+        vector<int> next(sync_head_.begin(), sync_head_.end() - 1);
+
+        for (size_t a{0}; a < sync_arcs_.size(); a++)
+            sync_out_[next[sync_arcs_[a].i_]++] = (int)a;
+    }
+
+    cycle_shrinker::~cycle_shrinker(void)
+    {
+    }
+
+    size_t cycle_shrinker::shrink(cycle_list &cycles)
+    {
+        n_cycles_ += cycles.size();
+
+        // Costs of this call; a negative one would break the Dijkstra closure
+        bool nonnegative{true};
+
+        for (size_t a{0}; a < sync_arcs_.size(); a++)
+        {
+            const double w{sync_arc_times_[a]};
+
+            sync_cost_[a] = w < INF_MD_THRLD ? units_(w) : 0;
+            nonnegative = nonnegative && sync_cost_[a] >= 0;
+        }
+
+        if (!nonnegative)
+            return cycles.size();
+
+        // Sync paths of the previous call may use other times
+        for (const int u : sources_)
+            row_[u] = -1;
+
+        sources_.clear();
+        sync_dist_.clear();
+        sync_pred_.clear();
+
+        cycle_list shrunk;
+        cycle_signature_set signatures;
+
+        vector<int> arcs;
+        vector<int> kept;
+        vector<int> trial;
+
+        for (const GOMA::array_view<int> cycle : cycles)
+        {
+            arcs.clear();
+
+            for (const int arc : cycle)
+                if (arc < (int)n_routing_arcs_)
+                    arcs.push_back(arc);
+
+            sort(arcs.begin(), arcs.end());
+            arcs.erase(unique(arcs.begin(), arcs.end()), arcs.end());
+
+            n_arcs_in_ += arcs.size();
+
+            // No cut to reduce
+            if (arcs.empty())
+            {
+                shrunk.push_back(cycle);
+                continue;
+            }
+
+            // Not an infeasible set with x = 1: nothing valid to reduce to
+            if (!negative_cycle_(arcs))
+            {
+                if (signatures.insert(arcs).second)
+                {
+                    shrunk.push_back(cycle);
+                    n_arcs_out_ += arcs.size();
+                }
+                else
+                {
+                    n_duplicates_++;
+                }
+
+                continue;
+            }
+
+            // The negative cycle found may already skip some routing arcs
+            kept.clear();
+
+            for (const int e : witness_)
+                if (edge_arc_[e] >= 0)
+                    kept.push_back(edge_arc_[e]);
+
+            sort(kept.begin(), kept.end());
+            kept.erase(unique(kept.begin(), kept.end()), kept.end());
+
+            // Deletion filter: an arc stays only if the others are not infeasible
+            for (size_t p{0}; p < kept.size() && kept.size() > 1;)
+            {
+                trial.assign(kept.begin(), kept.begin() + p);
+                trial.insert(trial.end(), kept.begin() + p + 1, kept.end());
+
+                if (negative_cycle_(trial))
+                    kept.swap(trial);
+                else
+                    p++;
+            }
+
+            if (!signatures.insert(kept).second)
+            {
+                n_duplicates_++;
+                continue;
+            }
+
+            n_arcs_out_ += kept.size();
+
+            if (kept.size() == arcs.size())
+            {
+                shrunk.push_back(cycle);
+                continue;
+            }
+
+            // Cycle of the minimal set (the filter's last test may have failed)
+            const bool negative{negative_cycle_(kept)};
+            assert(negative);
+
+            if (negative)
+                push_witness_(shrunk);
+
+            n_shrunk_++;
+        }
+
+        cycles.swap(shrunk);
+
+        return cycles.size();
+    }
+
+    size_t cycle_shrinker::sync_row_(const int u)
+    {
+        if (row_[u] >= 0)
+            return (size_t)row_[u];
+
+        const size_t r{sources_.size()};
+
+        row_[u] = (int)r;
+        sources_.push_back(u);
+
+        sync_dist_.resize((r + 1) * n_operations_, SHRINK_INF);
+        sync_pred_.resize((r + 1) * n_operations_, -1);
+
+        int64_t *dist{sync_dist_.data() + r * n_operations_};
+        int *pred{sync_pred_.data() + r * n_operations_};
+
+        typedef pair<int64_t, int> label;
+        priority_queue<label, vector<label>, greater<label>> heap;
+
+        dist[u] = 0;
+        heap.push(label(0, u));
+
+        while (!heap.empty())
+        {
+            const label top{heap.top()};
+            heap.pop();
+
+            const int v{top.second};
+
+            if (top.first > dist[v])
+                continue;
+
+            for (int p{sync_head_[v]}; p < sync_head_[v + 1]; p++)
+            {
+                const int a{sync_out_[p]};
+                const int w{sync_arcs_[a].j_};
+                const int64_t d{top.first + sync_cost_[a]};
+
+                if (d < dist[w])
+                {
+                    dist[w] = d;
+                    pred[w] = a;
+                    heap.push(label(d, w));
+                }
+            }
+        }
+
+        return r;
+    }
+
+    bool cycle_shrinker::negative_cycle_(const vector<int> &arcs)
+    {
+        n_tests_++;
+
+        for (const int v : vertices_)
+            node_[v] = -1;
+
+        vertices_.clear();
+        edge_from_.clear();
+        edge_to_.clear();
+        edge_cost_.clear();
+        edge_arc_.clear();
+
+        // Endpoints of the routing arcs, and the arcs themselves
+        for (const int a : arcs)
+        {
+            const int ends[2]{routing_arcs_[a].i_, routing_arcs_[a].j_};
+
+            for (const int v : ends)
+            {
+                if (node_[v] < 0)
+                {
+                    node_[v] = (int)vertices_.size();
+                    vertices_.push_back(v);
+                }
+            }
+
+            edge_from_.push_back(node_[ends[0]]);
+            edge_to_.push_back(node_[ends[1]]);
+            edge_cost_.push_back(units_(-routing_arc_times_[a]));
+            edge_arc_.push_back(a);
+        }
+
+        // Shortest sync path from each arc head to each other arc tail
+        for (const int a : arcs)
+        {
+            const int u{routing_arcs_[a].j_};
+            const size_t row{sync_row_(u)};
+
+            for (const int b : arcs)
+            {
+                const int v{routing_arcs_[b].i_};
+                const int64_t d{sync_dist_[row * n_operations_ + v]};
+
+                if (v == u || d >= SHRINK_INF)
+                    continue;
+
+                edge_from_.push_back(node_[u]);
+                edge_to_.push_back(node_[v]);
+                edge_cost_.push_back(d);
+                edge_arc_.push_back(-1);
+            }
+        }
+
+        // Bellman-Ford from a virtual source (all labels 0)
+        const size_t n_nodes{vertices_.size()};
+        const size_t n_edges{edge_from_.size()};
+
+        dist_.assign(n_nodes, 0);
+        pred_.assign(n_nodes, -1);
+
+        int last{-1};
+
+        for (size_t round{0}; round < n_nodes; round++)
+        {
+            last = -1;
+
+            for (size_t e{0}; e < n_edges; e++)
+            {
+                const int64_t d{dist_[edge_from_[e]] + edge_cost_[e]};
+
+                if (d < dist_[edge_to_[e]])
+                {
+                    dist_[edge_to_[e]] = d;
+                    pred_[edge_to_[e]] = (int)e;
+                    last = edge_to_[e];
+                }
+            }
+
+            if (last < 0)
+                return false;
+        }
+
+        // Still lowering after n rounds: n predecessor steps end on the cycle
+        int v{last};
+
+        for (size_t k{0}; k < n_nodes; k++)
+            v = edge_from_[pred_[v]];
+
+        witness_.clear();
+
+        int u{v};
+
+        do
+        {
+            witness_.push_back(pred_[u]);
+            u = edge_from_[pred_[u]];
+        } while (u != v);
+
+        reverse(witness_.begin(), witness_.end());
+
+        return true;
+    }
+
+    void cycle_shrinker::push_witness_(cycle_list &cycles)
+    {
+        vector<int> path;
+
+        for (const int e : witness_)
+        {
+            if (edge_arc_[e] >= 0)
+            {
+                cycles.push_item(edge_arc_[e]);
+                continue;
+            }
+
+            // Sync path, walked back from its head
+            const int u{vertices_[edge_from_[e]]};
+            const int *pred{sync_pred_.data() + (size_t)row_[u] * n_operations_};
+
+            path.clear();
+
+            for (int w{vertices_[edge_to_[e]]}; w != u; w = sync_arcs_[pred[w]].i_)
+                path.push_back(pred[w]);
+
+            for (auto it{path.rbegin()}; it != path.rend(); ++it)
+                cycles.push_item(*it + (int)n_routing_arcs_);
+        }
+
+        cycles.close_list();
+    }
+}
@@ -0,0 +1,452 @@
+/**
+ * @file min_mean_cycle_finder.cpp
+ * @brief Implementation of the minimum mean cycle separation
+ */
+
+#include "min_mean_cycle_finder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#define INF_MD_THRLD 1E6
+
+namespace SYNC_LIB
+{
+    min_mean_cycle_finder::min_mean_cycle_finder(const sync_model_a_builder &builder) : tol_(1E-3),
+                                                                                        precision_(1E3),
+                                                                                        routing_arcs_(builder.get_routing_arcs()),
+                                                                                        sync_arcs_(builder.get_sync_arcs()),
+                                                                                        routing_arc_times_(builder.get_routing_arc_times()),
+                                                                                        sync_arc_times_(builder.get_sync_arc_times()),
+                                                                                        n_operations_(builder.get_n_operations()),
+                                                                                        n_routing_arcs_(builder.get_n_routing_arcs()),
+                                                                                        max_cycles_(0),
+                                                                                        edge_from_(),
+                                                                                        edge_to_(),
+                                                                                        edge_arc_(),
+                                                                                        edge_cost_(),
+                                                                                        removed_(),
+                                                                                        head_(n_operations_ + 1),
+                                                                                        degree_(n_operations_),
+                                                                                        component_(n_operations_),
+                                                                                        index_(n_operations_),
+                                                                                        low_(n_operations_),
+                                                                                        stack_(),
+                                                                                        on_stack_(n_operations_),
+                                                                                        members_(),
+                                                                                        local_(n_operations_, -1),
+                                                                                        dist_(),
+                                                                                        pred_edge_(),
+                                                                                        walk_pos_(n_operations_, -1),
+                                                                                        n_components_(0),
+                                                                                        n_rounds_(0)
+    {
+        const size_t max_edges{routing_arcs_.size() + sync_arcs_.size()};
+
+        edge_from_.resize(max_edges);
+        edge_to_.resize(max_edges);
+        edge_arc_.resize(max_edges);
+        edge_cost_.resize(max_edges);
+    }
+
+    min_mean_cycle_finder::~min_mean_cycle_finder(void)
+    {
+    }
+
+    size_t min_mean_cycle_finder::find_cycles(const vector<double> &x, cycle_list &cycles)
+    {
+        assert(x.size() >= n_routing_arcs_);
+
+        removed_.assign(routing_arcs_.size() + sync_arcs_.size(), false);
+
+        // Cycles already in the output count as seen
+        cycle_signature_set signatures;
+        vector<int> signature;
+
+        for (const GOMA::array_view<int> cycle : cycles)
+        {
+            signature.clear();
+
+            for (const int arc : cycle)
+                if (arc < (int)n_routing_arcs_)
+                    signature.push_back(arc);
+
+            sort(signature.begin(), signature.end());
+            signature.erase(unique(signature.begin(), signature.end()), signature.end());
+
+            signatures.insert(signature);
+        }
+
+        const size_t n_initial{cycles.size()};
+
+        vector<int> cycle_edges;
+        vector<int> cycle;
+        cycle_list candidates;                // New cycles of the round
+        vector<pair<double, size_t>> by_cost; // Mean cost and position of each candidate
+
+        n_components_ = 0;
+        n_rounds_ = 0;
+
+        // Violated means below the LP threshold, as in sync_difference_checker
+        const double eps{0.5 / precision_};
+
+        bool found{true};
+
+        while (found && (max_cycles_ == 0 ? n_rounds_ == 0 : cycles.size() - n_initial < max_cycles_))
+        {
+            found = false;
+            n_rounds_++;
+
+            build_graph_(x);
+            find_components_();
+
+            candidates.clear();
+            by_cost.clear();
+
+            for (const vector<int> &members : members_)
+            {
+                // One vertex without self-loops has no cycle
+                if (members.size() < 2)
+                    continue;
+
+                if (n_rounds_ == 1)
+                    n_components_++;
+
+                const double cost{min_mean_cycle_(members, cycle_edges)};
+
+                if (cost >= -eps)
+                    continue;
+
+                cycle.clear();
+                signature.clear();
+
+                int weakest{-1};
+
+                for (const int e : cycle_edges)
+                {
+                    const int arc{edge_arc_[e]};
+                    cycle.push_back(arc);
+
+                    if (arc < (int)n_routing_arcs_)
+                    {
+                        signature.push_back(arc);
+
+                        if (weakest < 0 || x[arc] < x[weakest])
+                            weakest = arc;
+                    }
+                }
+
+                // The next round looks for another cycle of the component
+                removed_[weakest >= 0 ? weakest : cycle[0]] = true;
+                found = true;
+
+                sort(signature.begin(), signature.end());
+                signature.erase(unique(signature.begin(), signature.end()), signature.end());
+
+                if (signatures.insert(signature).second)
+                {
+                    by_cost.push_back(pair<double, size_t>(cost / cycle.size(), candidates.size()));
+                    candidates.push_back(cycle);
+                }
+            }
+
+            // Most negative mean cost first
+            stable_sort(by_cost.begin(), by_cost.end(),
+                        [](const pair<double, size_t> &a, const pair<double, size_t> &b)
+                        { return a.first < b.first; });
+
+            for (const pair<double, size_t> &candidate : by_cost)
+            {
+                if (max_cycles_ > 0 && cycles.size() - n_initial >= max_cycles_)
+                    break;
+
+                cycles.push_back(candidates[candidate.second]);
+            }
+        }
+
+        return cycles.size() - n_initial;
+    }
+
+    double min_mean_cycle_finder::get_cost(const vector<double> &x, const GOMA::array_view<int> &cycle) const
+    {
+        double cost{0.0};
+
+        for (const int arc : cycle)
+        {
+            if (arc < (int)n_routing_arcs_)
+            {
+                cost += truncate_(-routing_arc_times_[arc] * x[arc]);
+            }
+            else
+            {
+                const double w_h_p_j{sync_arc_times_[arc - n_routing_arcs_]};
+
+                cost += w_h_p_j < INF_MD_THRLD ? truncate_(w_h_p_j) : 0.0;
+            }
+        }
+
+        return cost;
+    }
+
+    void min_mean_cycle_finder::build_graph_(const vector<double> &x)
+    {
+        fill(degree_.begin(), degree_.end(), 0);
+
+        const size_t n_sync_arcs{sync_arcs_.size()};
+
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+        {
+            if (x[a] > tol_ && !removed_[a])
+                degree_[routing_arcs_[a].i_]++;
+        }
+
+        for (size_t a{0}; a < n_sync_arcs; a++)
+        {
+            if (!removed_[n_routing_arcs_ + a])
+                degree_[sync_arcs_[a].i_]++;
+        }
+
+        head_[0] = 0;
+
+        for (size_t v{0}; v < n_operations_; v++)
+        {
+            head_[v + 1] = head_[v] + degree_[v];
+            degree_[v] = head_[v];
+        }
+
+        // Arcs keep their direction: the cycle is a circulation of the certificate
+        for (size_t a{0}; a < n_routing_arcs_; a++)
+        {
+            if (x[a] > tol_ && !removed_[a])
+            {
+                const triplet &arc{routing_arcs_[a]};
+                const int e{degree_[arc.i_]++};
+
+                edge_from_[e] = arc.i_;
+                edge_to_[e] = arc.j_;
+                edge_arc_[e] = (int)a;
+                edge_cost_[e] = truncate_(-routing_arc_times_[a] * x[a]);
+            }
+        }
+
+        for (size_t a{0}; a < n_sync_arcs; a++)
+        {
+            if (!removed_[n_routing_arcs_ + a])
+            {
+                const triplet &arc{sync_arcs_[a]};
+                const int e{degree_[arc.i_]++};
+
+                const double w_h_p_j{sync_arc_times_[a]};
+
+                edge_from_[e] = arc.i_;
+                edge_to_[e] = arc.j_;
+                edge_arc_[e] = (int)(n_routing_arcs_ + a);
+                edge_cost_[e] = w_h_p_j < INF_MD_THRLD ? truncate_(w_h_p_j) : 0.0;
+            }
+        }
+    }
+
+    void min_mean_cycle_finder::find_components_(void)
+    {
+        const int n{static_cast<int>(n_operations_)};
+
+        fill(index_.begin(), index_.end(), -1);
+        fill(on_stack_.begin(), on_stack_.end(), false);
+
+        members_.clear();
+        stack_.clear();
+
+        // Explicit DFS stack of (vertex, next out-edge)
+        vector<pair<int, int>> dfs;
+
+        int counter{0};
+
+        for (int root{0}; root < n; root++)
+        {
+            if (index_[root] >= 0)
+                continue;
+
+            dfs.push_back(pair<int, int>(root, head_[root]));
+            index_[root] = low_[root] = counter++;
+            stack_.push_back(root);
+            on_stack_[root] = true;
+
+            while (!dfs.empty())
+            {
+                const int v{dfs.back().first};
+                int &e{dfs.back().second};
+
+                if (e < head_[v + 1])
+                {
+                    const int w{edge_to_[e++]};
+
+                    if (index_[w] < 0)
+                    {
+                        index_[w] = low_[w] = counter++;
+                        stack_.push_back(w);
+                        on_stack_[w] = true;
+
+                        dfs.push_back(pair<int, int>(w, head_[w]));
+                    }
+                    else if (on_stack_[w])
+                    {
+                        low_[v] = min(low_[v], index_[w]);
+                    }
+
+                    continue;
+                }
+
+                dfs.pop_back();
+
+                if (!dfs.empty())
+                {
+                    const int u{dfs.back().first};
+                    low_[u] = min(low_[u], low_[v]);
+                }
+
+                // v is the root of a component
+                if (low_[v] == index_[v])
+                {
+                    const int c{(int)members_.size()};
+                    members_.push_back(vector<int>());
+
+                    int w{-1};
+
+                    do
+                    {
+                        w = stack_.back();
+                        stack_.pop_back();
+                        on_stack_[w] = false;
+
+                        component_[w] = c;
+                        members_[c].push_back(w);
+                    } while (w != v);
+                }
+            }
+        }
+    }
+
+    double min_mean_cycle_finder::min_mean_cycle_(const vector<int> &members, vector<int> &cycle)
+    {
+        const double inf{numeric_limits<double>::infinity()};
+
+        const int n{(int)members.size()};
+        const int c{component_[members[0]]};
+
+        for (int l{0}; l < n; l++)
+            local_[members[l]] = l;
+
+        // dist_[k * n + v]: cheapest walk with k edges ending at v (from anywhere)
+        dist_.assign((size_t)(n + 1) * n, inf);
+        pred_edge_.assign((size_t)(n + 1) * n, -1);
+
+        for (int l{0}; l < n; l++)
+            dist_[l] = 0.0;
+
+        for (int k{1}; k <= n; k++)
+        {
+            const double *prev{&dist_[(size_t)(k - 1) * n]};
+            double *curr{&dist_[(size_t)k * n]};
+            int *pred{&pred_edge_[(size_t)k * n]};
+
+            for (int l{0}; l < n; l++)
+            {
+                const int u{members[l]};
+
+                if (prev[l] == inf)
+                    continue;
+
+                for (int e{head_[u]}; e < head_[u + 1]; e++)
+                {
+                    const int w{edge_to_[e]};
+
+                    if (component_[w] != c)
+                        continue;
+
+                    const double d{prev[l] + edge_cost_[e]};
+                    const int lw{local_[w]};
+
+                    if (d < curr[lw])
+                    {
+                        curr[lw] = d;
+                        pred[lw] = e;
+                    }
+                }
+            }
+        }
+
+        // Karp: min over v of max over k of (D_n(v) - D_k(v)) / (n - k)
+        double best_mean{inf};
+        int best{-1};
+
+        for (int l{0}; l < n; l++)
+        {
+            const double d_n{dist_[(size_t)n * n + l]};
+
+            if (d_n == inf)
+                continue;
+
+            double mean{-inf};
+
+            for (int k{0}; k < n; k++)
+            {
+                const double d_k{dist_[(size_t)k * n + l]};
+
+                if (d_k != inf)
+                    mean = max(mean, (d_n - d_k) / (n - k));
+            }
+
+            if (mean < best_mean)
+            {
+                best_mean = mean;
+                best = l;
+            }
+        }
+
+        cycle.clear();
+
+        if (best < 0)
+            return 0.0;
+
+        // The walk of n edges to the best vertex contains a minimum mean cycle
+        vector<int> walk;
+        walk.reserve(n);
+
+        int v{members[best]};
+        walk_pos_[v] = 0;
+
+        for (int k{n}; k >= 1; k--)
+        {
+            const int e{pred_edge_[(size_t)k * n + local_[v]]};
+
+            assert(e >= 0);
+
+            walk.push_back(e);
+            v = edge_from_[e];
+
+            if (walk_pos_[v] >= 0)
+            {
+                // Edges walk[pos..] go backwards from v to v
+                cycle.assign(walk.begin() + walk_pos_[v], walk.end());
+                reverse(cycle.begin(), cycle.end());
+                break;
+            }
+
+            walk_pos_[v] = (int)walk.size();
+        }
+
+        for (const int e : walk)
+            walk_pos_[edge_from_[e]] = -1;
+
+        walk_pos_[members[best]] = -1;
+
+        double cost{0.0};
+
+        for (const int e : cycle)
+            cost += edge_cost_[e];
+
+        return cost;
+    }
+}
@@ -14,12 +14,18 @@
  */
 
 #include "path_finder.hpp"
+#include "trace_recorder.hpp"
+#include "memory_usage.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <vector>
 #include <cmath>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <deque>
 
 #include <bits/stdc++.h>
 
@@ -49,8 +55,42 @@ namespace SYNC_LIB
                                                                     routing_arc_times_(builder.get_routing_arc_times()),
                                                                     sync_arc_times_(builder.get_sync_arc_times()),
                                                                     n_routing_arcs_(builder.get_n_routing_arcs()),
-                                                                    support_graph_(n_operations_ + 2)
+                                                                    support_graph_(n_operations_ + 2),
+                                                                    in_support_(routing_arcs_.size() + sync_arcs_.size(), false),
+                                                                    support_cost_(routing_arcs_.size() + sync_arcs_.size(), 0.0),
+                                                                    n_depot_arcs_(n_operations_ + 2, 0),
+                                                                    routing_support_(),
+                                                                    routing_previous_(),
+                                                                    n_support_changes_(0),
+                                                                    n_support_arcs_(0),
+                                                                    cycle_signatures_(),
+                                                                    sequences_(),
+                                                                    thread_cycles_(),
+                                                                    max_cycles_per_arc_(0),
+                                                                    max_cycles_(0),
+                                                                    time_limit_(0),
+                                                                    deadline_(NULL),
+                                                                    truncated_(false),
+                                                                    max_weight_(1.0),
+                                                                    n_threads_(1),
+                                                                    shared_sources_(false),
+                                                                    work_stealing_(false),
+                                                                    integral_fast_path_(false),
+                                                                    last_integral_(false),
+                                                                    route_next_(n_operations_ + 2, -1),
+                                                                    route_prev_(n_operations_ + 2, -1),
+                                                                    walk_dist_(n_operations_ + 2, -1),
+                                                                    walk_pred_(n_operations_ + 2, -1),
+                                                                    n_calls_(0),
+                                                                    n_support_arcs_total_(0),
+                                                                    n_worker_expanded_(0),
+                                                                    n_steals_(0),
+                                                                    n_cycles_found_(0),
+                                                                    n_cycles_new_(0),
+                                                                    worker_bytes_(0),
+                                                                    peak_search_bytes_(0)
     {
+        support_graph_.set_pruning(true);
     }
 
     /**
@@ -73,17 +113,142 @@ namespace SYNC_LIB
      *
      * For each active sync arc (i,j), finds all simple paths from i to j,
      * then closes each path with arc (j,i) to form cycle.
+     *
+     * With the integral fast path enabled, an integral routing support
+     * (disjoint routes) is walked instead (find_route_cycles_).
+     *
+     * With a deadline, the searches stop when it expires and the cycles
+     * found until then are returned (truncated_).
      */
-    void path_finder::find_paths(const vector<double> &alpha_v,
-                                 const vector<double> &beta_v,
-                                 const vector<double> &gamma_v,
-                                 vector<vector<int>> &cycles)
+    void path_finder::find_paths(const GOMA::array_view<double> &alpha_v,
+                                 const GOMA::array_view<double> &beta_v,
+                                 const GOMA::array_view<double> &gamma_v,
+                                 cycle_list &cycles,
+                                 const vector<int> *routing_candidates)
     {
+        GOMA::trace_scope trace("find_paths", "cycles");
+
         vector<pair<int, int>> active_sync_arcs;
 
-        update_support_graph_(alpha_v, beta_v, gamma_v, active_sync_arcs);
+        update_support_graph_(alpha_v, beta_v, gamma_v, active_sync_arcs, routing_candidates);
+
+        GOMA_STATS(n_calls_++);
+        GOMA_STATS(n_support_arcs_total_ += n_support_arcs_);
+        GOMA_STATS(worker_bytes_ = 0);
+
+        last_integral_ = false;
+        truncated_ = false;
+
+        if (integral_fast_path_ && !is_bounded() && integral_support_(alpha_v))
+        {
+            last_integral_ = true;
 
-        find_full_paths_(alpha_v, beta_v, gamma_v, active_sync_arcs, cycles);
+            find_route_cycles_(alpha_v, gamma_v, active_sync_arcs, cycles);
+        }
+        else if (is_bounded())
+        {
+            cycle_signatures_.clear();
+            remove_repeated_cycles_(cycles, cycle_signatures_);
+
+            find_best_paths_(alpha_v, gamma_v, active_sync_arcs, cycles);
+        }
+        else
+        {
+            find_full_paths_(alpha_v, beta_v, gamma_v, active_sync_arcs, cycles);
+        }
+
+        GOMA_STATS(note_peak_bytes_());
+    }
+
+    /**
+     * Heap bytes held between calls
+     */
+    size_t path_finder::get_memory_bytes(void) const
+    {
+        return support_graph_.get_memory_bytes() + signature_bytes_(cycle_signatures_) +
+               GOMA::vector_bytes(in_support_) + GOMA::vector_bytes(support_cost_) + GOMA::vector_bytes(n_depot_arcs_) +
+               GOMA::vector_bytes(routing_support_) + GOMA::vector_bytes(routing_previous_) +
+               GOMA::vector_bytes(route_next_) + GOMA::vector_bytes(route_prev_) +
+               GOMA::vector_bytes(walk_dist_) + GOMA::vector_bytes(walk_pred_) +
+               sequences_.get_memory_bytes() + thread_cycles_bytes_();
+    }
+
+    /**
+     * Bytes of the per-thread cycle lists (kept between calls)
+     */
+    size_t path_finder::thread_cycles_bytes_(void) const
+    {
+        size_t bytes{thread_cycles_.capacity() * sizeof(cycle_list)};
+
+        for (const cycle_list &c_cycles : thread_cycles_)
+            bytes += c_cycles.get_memory_bytes();
+
+        return bytes;
+    }
+
+    /**
+     * Signature set bytes
+     *
+     * Bucket array plus one node per signature (hash cached, next pointer)
+     * and the signature itself.
+     */
+    size_t path_finder::signature_bytes_(const cycle_signature_set &signatures)
+    {
+        size_t bytes{signatures.bucket_count() * sizeof(void *) +
+                     signatures.size() * (sizeof(vector<int>) + sizeof(void *) + sizeof(size_t))};
+
+        for (const vector<int> &signature : signatures)
+            bytes += GOMA::vector_bytes(signature);
+
+        return bytes;
+    }
+
+    /**
+     * Memory peak of the searches
+     *
+     * The DFS stack of the support graph has a fixed size and is left out
+     * (get_support_stack_bytes()).
+     */
+    void path_finder::note_peak_bytes_(void)
+    {
+        const size_t search_bytes{support_graph_.get_succ_bytes() + support_graph_.get_workspace_bytes() +
+                                  signature_bytes_(cycle_signatures_) + worker_bytes_};
+
+        peak_search_bytes_ = max(peak_search_bytes_, search_bytes);
+    }
+
+    /**
+     * Set bounded mode limits (all 0: full enumeration)
+     */
+    void path_finder::set_limits(const size_t max_cycles_per_arc, const size_t max_cycles, const double time_limit)
+    {
+        max_cycles_per_arc_ = max_cycles_per_arc;
+        max_cycles_ = max_cycles;
+        time_limit_ = time_limit;
+    }
+
+    /**
+     * Set number of threads (0: hardware concurrency)
+     */
+    void path_finder::set_n_threads(const size_t n_threads)
+    {
+        n_threads_ = n_threads;
+
+        if (n_threads_ == 0)
+            n_threads_ = max(1u, thread::hardware_concurrency());
+    }
+
+    /**
+     * Search cost of an arc
+     *
+     * Arcs with the largest weight cost 0, so the cheapest paths are the
+     * ones that follow the strongest part of the certificate.
+     */
+    double path_finder::arc_cost_(const double w) const
+    {
+        const double cost{1.0 - w / max_weight_};
+
+        return cost < 0.0 ? 0.0 : (cost > 1.0 ? 1.0 : cost);
     }
 
     /**
@@ -111,163 +276,669 @@ namespace SYNC_LIB
     }
 
     /**
-     * Remove duplicate cycles (inefficient but functional)
+     * Insert cycle signature
+     *
+     * The signature is the sorted set of routing arcs of the cycle; sync
+     * arcs (indices >= n_routing_arcs) are ignored, as in the original
+     * pairwise comparison of routing arc indicator vectors.
+     */
+    bool path_finder::insert_signature_(const GOMA::array_view<int> &cycle, cycle_signature_set &signatures) const
+    {
+        vector<int> signature;
+        signature.reserve(cycle.size());
+
+        for (const int c_arc : cycle)
+        {
+            // Only routing arcs (indices < n_routing_arcs) identify a cycle
+            if (c_arc < (int)n_routing_arcs_)
+            {
+                signature.push_back(c_arc);
+            }
+        }
+
+        sort(signature.begin(), signature.end());
+        signature.erase(unique(signature.begin(), signature.end()), signature.end());
+
+        const bool inserted{signatures.insert(move(signature)).second};
+
+        GOMA_STATS(n_cycles_found_++);
+        GOMA_STATS(n_cycles_new_ += inserted);
+
+        return inserted;
+    }
+
+    /**
+     * Remove duplicate cycles
      *
      * Duplicates defined as: cycles with identical routing arc sets.
      * Ignores sync arcs and arc order for comparison.
      *
-     * Algorithm:
-     * 1. Convert each cycle to boolean vector of routing arcs (O(n×m))
-     * 2. Compare all pairs using boolean vector equality (O(n²×m))
-     * 3. Mark duplicates for removal
-     * 4. Rebuild cycle list without duplicates (O(n))
-     *
-     * Time complexity: O(n²×m) where n = cycles, m = routing arcs
-     * Space complexity: O(n×m) for boolean vectors
-     *
-     * Note: Self-deprecating comment acknowledges inefficiency.
-     * Could be optimized with hashing or canonical cycle representation.
+     * Single pass: a cycle is kept iff its signature was not in the set, and
+     * kept cycles are moved forward in place in the flat list.
      */
-    // Possible, the most inefficient function ever written ;)
-
-    void path_finder::remove_repeated_cycles_(vector<vector<int>> &cycles) const
+    void path_finder::remove_repeated_cycles_(cycle_list &cycles, cycle_signature_set &signatures) const
     {
-        const size_t n_cycles{cycles.size()};
-        const size_t n_routing_arcs{routing_arcs_.size()};
+        cycles.remove_if([this, &signatures](const GOMA::array_view<int> &cycle)
+                         { return !insert_signature_(cycle, signatures); });
+    }
 
+    void path_finder::remove_repeated_cycles_(cycle_list &cycles) const
+    {
         // Early exit: 0 or 1 cycle cannot have duplicates
-        if (n_cycles <= 1)
+        if (cycles.size() <= 1)
             return;
 
-        const vector<vector<int>> old_cycles(cycles);
+        cycle_signature_set signatures;
+        signatures.reserve(cycles.size());
 
-        cycles.clear();
-        vector<bool> redundant_cycles(n_cycles, false);
+        remove_repeated_cycles_(cycles, signatures);
+    }
 
+    /**
+     * Enumerate all cycles through active synchronization arcs
+     *
+     * For each active sync arc (i,j):
+     * 1. Run DFS from i to j to find all simple paths
+     * 2. Convert each vertex sequence to arc index sequence
+     * 3. Close cycle by appending reverse sync arc (j,i)
+     * 4. Add cycle to results if its routing arc set is new
+     *
+     * Duplicates (same routing arc set) are dropped as they are produced,
+     * so the cycle list never holds them.
+     *
+     * With n_threads_ > 1, steps 1-3 run on a pool of threads (one
+     * search_workspace and one cycle list each, the span of each sync arc
+     * recorded) and step 4 is done when merging the spans in sync arc order, so the output does not depend on the
+     * number of threads (unless a deadline stops the search).
+     *
+     * With work_stealing_, the sync arcs are searched in order as in the
+     * serial case, each by all the threads (search_graph::stealing_DFS,
+     * which returns the paths of backtrack_DFS in the same order).
+     *
+     * With shared_sources_, the sync arcs are grouped by source (in order
+     * of first appearance) and each group is served by one multi-target
+     * search; the per-arc results are merged as in the parallel case, so
+     * the output is the same.
+     *
+     * beta_v parameter currently unused (future extension for time-aware paths).
+     */
+    void path_finder::find_full_paths_(const GOMA::array_view<double> &alpha_v,
+                                       const GOMA::array_view<double> &beta_v,
+                                       const GOMA::array_view<double> &gamma_v,
+                                       const vector<pair<int, int>> &active_sync_arcs,
+                                       cycle_list &cycles)
+    {
+
+        // Cycles already in the output count as seen
+        cycle_signatures_.clear();
+        remove_repeated_cycles_(cycles, cycle_signatures_);
+
+        const size_t n_active_arcs{active_sync_arcs.size()};
+        const size_t n_threads{min(n_threads_, n_active_arcs)};
+
+        if (shared_sources_)
+        {
+            // Sync arcs of each source, sources in order of first appearance
+            vector<vector<size_t>> groups;
+            vector<int> group_of(support_graph_.get_n_vertices(), -1);
+
+            for (size_t i{0}; i < n_active_arcs; i++)
+            {
+                int &g{group_of[active_sync_arcs[i].first]};
+
+                if (g < 0)
+                {
+                    g = (int)groups.size();
+                    groups.push_back(vector<size_t>());
+                }
+
+                groups[g].push_back(i);
+            }
+
+            vector<arc_cycle_span> arc_spans(n_active_arcs, arc_cycle_span{0, 0, 0});
+            atomic<size_t> next_group{0};
+            atomic<bool> truncated{false};
+
+            const size_t n_group_threads{max((size_t)1, min(n_threads_, groups.size()))};
+
+            prepare_thread_cycles_(n_group_threads);
+
+            vector<GOMA::search_workspace> workspaces(n_group_threads, GOMA::search_workspace(support_graph_.get_n_vertices()));
+            vector<thread> workers;
+
+            for (size_t t{1}; t < n_group_threads; t++)
+            {
+                workers.push_back(thread(&path_finder::enumerate_source_cycles_, this,
+                                         cref(alpha_v), cref(gamma_v), cref(active_sync_arcs), cref(groups),
+                                         ref(next_group), ref(truncated), ref(workspaces[t]),
+                                         t, ref(thread_cycles_[t]), ref(arc_spans)));
+            }
+
+            enumerate_source_cycles_(alpha_v, gamma_v, active_sync_arcs, groups, next_group, truncated, workspaces[0],
+                                     0, thread_cycles_[0], arc_spans);
+
+            for (thread &worker : workers)
+                worker.join();
+
+            truncated_ = truncated;
+
+#ifdef USE_STATS
+            for (const GOMA::search_workspace &ws : workspaces)
+            {
+                n_worker_expanded_ += ws.n_expanded_;
+                worker_bytes_ += ws.get_memory_bytes();
+            }
+
+            worker_bytes_ += GOMA::vector_bytes(arc_spans) + thread_cycles_bytes_();
+#endif
+
+            merge_arc_cycles_(arc_spans, cycles);
+
+            return;
+        }
+
+        if (n_threads > 1 && !work_stealing_)
         {
-            // Phase 1: Convert cycles to boolean routing arc vectors
-            vector<vector<bool>> ordered_cycles(old_cycles.size());
+            // One DFS per sync arc, spread over the threads
+            vector<arc_cycle_span> arc_spans(n_active_arcs, arc_cycle_span{0, 0, 0});
+            atomic<size_t> next_arc{0};
+            atomic<bool> truncated{false};
+
+            prepare_thread_cycles_(n_threads);
+
+            vector<GOMA::search_workspace> workspaces(n_threads, GOMA::search_workspace(support_graph_.get_n_vertices()));
+            vector<thread> workers;
+
+            for (size_t t{1}; t < n_threads; t++)
+            {
+                workers.push_back(thread(&path_finder::enumerate_arc_cycles_, this,
+                                         cref(alpha_v), cref(gamma_v), cref(active_sync_arcs),
+                                         ref(next_arc), ref(truncated), ref(workspaces[t]),
+                                         t, ref(thread_cycles_[t]), ref(arc_spans)));
+            }
+
+            enumerate_arc_cycles_(alpha_v, gamma_v, active_sync_arcs, next_arc, truncated, workspaces[0],
+                                  0, thread_cycles_[0], arc_spans);
 
-            for (size_t i{0}; i < n_cycles; i++)
+            for (thread &worker : workers)
+                worker.join();
+
+            truncated_ = truncated;
+
+#ifdef USE_STATS
+            for (const GOMA::search_workspace &ws : workspaces)
             {
-                const vector<int> &old_cycle{old_cycles[i]};
+                n_worker_expanded_ += ws.n_expanded_;
+                worker_bytes_ += ws.get_memory_bytes();
+            }
+
+            worker_bytes_ += GOMA::vector_bytes(arc_spans) + thread_cycles_bytes_();
+#endif
+
+            merge_arc_cycles_(arc_spans, cycles);
+
+            return;
+        }
+
+        GOMA::ragged_array<int> &c_sequences{sequences_}; // Vertex sequences (paths)
+
+        vector<int> cycle; // Arc sequence for current cycle
+
+        // Work stealing: every thread searches each sync arc's tree
+        vector<GOMA::search_workspace> workspaces;
 
-                // Create boolean vector: ordered_cycle_i[k] = true if routing arc k in cycle
-                vector<bool> &ordered_cycle_i{ordered_cycles[i]};
-                ordered_cycle_i.resize(n_routing_arcs, false);
+        if (work_stealing_ && n_threads_ > 1)
+            workspaces.assign(n_threads_, GOMA::search_workspace(support_graph_.get_n_vertices()));
 
-                const size_t n_old_arcs{old_cycles[i].size()};
+        // For each active sync arc, find all paths and close to form cycles
+        for (const pair<int, int> &arc : active_sync_arcs)
+        {
+            c_sequences.clear();
+
+            // DFS from arc.first to arc.second to find all simple paths
+            const bool complete{workspaces.empty() ? support_graph_.backtrack_DFS(arc.first, arc.second, c_sequences, deadline_)
+                                                   : support_graph_.stealing_DFS(arc.first, arc.second, c_sequences, workspaces, deadline_)};
 
-                for (size_t j{0}; j < n_old_arcs; j++)
+            // Paths found before the deadline still give valid cycles
+            truncated_ = !complete;
+
+            if (c_sequences.size() > 0)
+            {
+                // Convert each vertex sequence to arc sequence and close cycle
+                for (const GOMA::array_view<int> c_sequence : c_sequences)
                 {
-                    const int c_arc{old_cycle[j]};
+                    // Convert vertex sequence to arc indices
+                    sequence_2_path_(c_sequence, alpha_v, gamma_v, cycle);
 
-                    // Only mark routing arcs (indices < n_routing_arcs)
-                    if (c_arc < (int)n_routing_arcs)
+                    // Close cycle with reverse sync arc
+                    const int closing_arc{closing_arc_(arc)};
+
+                    cycle.push_back(closing_arc);
+
+                    // Keep only cycles with a new routing arc set
+                    if (insert_signature_(cycle, cycle_signatures_))
                     {
-                        ordered_cycle_i[c_arc] = true;
+                        cycles.push_back(cycle);
                     }
                 }
             }
+            else if (complete)
+            {
+                cerr << "No path found" << endl;
+            }
+
+            if (truncated_)
+                break;
+        }
+
+#ifdef USE_STATS
+        for (const GOMA::search_workspace &ws : workspaces)
+        {
+            n_worker_expanded_ += ws.n_expanded_;
+            n_steals_ += ws.n_donated_;
+            worker_bytes_ += ws.get_memory_bytes();
+        }
+#endif
+    }
+
+    /**
+     * Parallel enumeration worker
+     *
+     * Same DFS and cycle closure as the serial loop of find_full_paths_,
+     * using the thread's own workspace. Each sync arc's cycles are appended
+     * to the thread's own list and their span is written to the sync arc's
+     * slot of arc_spans, so threads never write the same memory.
+     * A search stopped by the deadline keeps its paths and stops every
+     * thread at its next sync arc.
+     */
+    void path_finder::enumerate_arc_cycles_(const GOMA::array_view<double> &alpha_v,
+                                            const GOMA::array_view<double> &gamma_v,
+                                            const vector<pair<int, int>> &active_sync_arcs,
+                                            atomic<size_t> &next_arc,
+                                            atomic<bool> &truncated,
+                                            GOMA::search_workspace &ws,
+                                            const size_t list,
+                                            cycle_list &cycles,
+                                            vector<arc_cycle_span> &arc_spans) const
+    {
+        GOMA::trace_scope trace("enumerate_arcs", "cycles");
+
+        const size_t n_active_arcs{active_sync_arcs.size()};
+
+        GOMA::ragged_array<int> c_sequences; // Vertex sequences (paths)
+        vector<int> cycle;                   // Arc sequence for current cycle
+
+        for (size_t i{next_arc++}; i < n_active_arcs && !truncated; i = next_arc++)
+        {
+            const pair<int, int> &arc{active_sync_arcs[i]};
+
+            if (!support_graph_.backtrack_DFS(arc.first, arc.second, c_sequences, ws, deadline_))
+                truncated = true;
+
+            const int closing_arc{closing_arc_(arc)};
 
-            // Phase 2: Find duplicates by comparing boolean vectors
-            for (size_t i{0}; i < n_cycles - 1; i++)
+            arc_spans[i] = arc_cycle_span{list, cycles.size(), c_sequences.size()};
+
+            for (const GOMA::array_view<int> c_sequence : c_sequences)
             {
+                sequence_2_path_(c_sequence, alpha_v, gamma_v, cycle);
+                cycle.push_back(closing_arc);
 
-                const vector<bool> &ordered_cycle_i{ordered_cycles[i]};
+                cycles.push_back(cycle);
+            }
+        }
+    }
 
-                // Skip if cycle i already marked redundant
-                if (redundant_cycles[i])
-                    continue;
+    /**
+     * Shared-source enumeration worker
+     *
+     * One multi-target backtrack_DFS per group of sync arcs with the same
+     * source; the paths to each target are closed with the reverse sync
+     * arc into the slot of that arc.
+     */
+    void path_finder::enumerate_source_cycles_(const GOMA::array_view<double> &alpha_v,
+                                               const GOMA::array_view<double> &gamma_v,
+                                               const vector<pair<int, int>> &active_sync_arcs,
+                                               const vector<vector<size_t>> &groups,
+                                               atomic<size_t> &next_group,
+                                               atomic<bool> &truncated,
+                                               GOMA::search_workspace &ws,
+                                               const size_t list,
+                                               cycle_list &cycles,
+                                               vector<arc_cycle_span> &arc_spans) const
+    {
+        GOMA::trace_scope trace("enumerate_sources", "cycles");
 
-                // Compare cycle i with all subsequent cycles
-                for (size_t j{i + 1}; j < n_cycles; j++)
+        const size_t n_groups{groups.size()};
+
+        vector<int> targets;
+        vector<GOMA::ragged_array<int>> t_sequences; // Vertex sequences (paths) of each target
+        vector<int> cycle;                           // Arc sequence for current cycle
+
+        for (size_t g{next_group++}; g < n_groups && !truncated; g = next_group++)
+        {
+            const vector<size_t> &group{groups[g]};
+
+            targets.clear();
+
+            for (const size_t i : group)
+                targets.push_back(active_sync_arcs[i].second);
+
+            if (!support_graph_.backtrack_DFS(active_sync_arcs[group[0]].first, targets, t_sequences, ws, deadline_))
+                truncated = true;
+
+            for (size_t k{0}; k < group.size(); k++)
+            {
+                const pair<int, int> &arc{active_sync_arcs[group[k]]};
+                const int closing_arc{closing_arc_(arc)};
+
+                arc_spans[group[k]] = arc_cycle_span{list, cycles.size(), t_sequences[k].size()};
+
+                for (const GOMA::array_view<int> c_sequence : t_sequences[k])
+                {
+                    sequence_2_path_(c_sequence, alpha_v, gamma_v, cycle);
+                    cycle.push_back(closing_arc);
+
+                    cycles.push_back(cycle);
+                }
+            }
+        }
+    }
+
+    /**
+     * Routing support check
+     *
+     * With integral x, every operation has at most one active routing arc
+     * out and in, so the routing arcs of the support are disjoint routes.
+     */
+    bool path_finder::integral_support_(const GOMA::array_view<double> &alpha_v)
+    {
+        fill(route_next_.begin(), route_next_.end(), -1);
+        fill(route_prev_.begin(), route_prev_.end(), -1);
+
+        for (const int a : routing_support_)
+        {
+            const triplet &arc{routing_arcs_[a]};
+
+            if (route_next_[arc.i_] >= 0 || route_prev_[arc.j_] >= 0)
+                return false;
+
+            route_next_[arc.i_] = arc.j_;
+            route_prev_[arc.j_] = arc.i_;
+        }
+
+        return true;
+    }
+
+    /**
+     * Route walk of integral supports
+     *
+     * From each distinct source i (in order of first appearance), a 0-1
+     * breadth-first search (deque: route successors at the front, sync
+     * successors at the back) finds for every vertex the walk with the
+     * fewest sync arcs. For each sync arc (i,j) with j reached, the walk is
+     * closed by (j,i). Cycles are appended in sync arc order, new routing
+     * arc sets only, as in the enumeration.
+     */
+    void path_finder::find_route_cycles_(const GOMA::array_view<double> &alpha_v,
+                                         const GOMA::array_view<double> &gamma_v,
+                                         const vector<pair<int, int>> &active_sync_arcs,
+                                         cycle_list &cycles)
+    {
+        cycle_signatures_.clear();
+        remove_repeated_cycles_(cycles, cycle_signatures_);
+
+        const size_t n_active_arcs{active_sync_arcs.size()};
+
+        GOMA::ragged_array<int> &walks{sequences_};  // Vertex sequences of the cycles, in search order
+        vector<int> walk_of(n_active_arcs, -1);      // Walk of each arc's cycle (-1: none)
+        vector<bool> done(n_active_arcs, false);
+
+        walks.clear();
+
+        deque<int> queue;
+        vector<int> touched;
+        vector<int> sequence;
+
+        for (size_t i{0}; i < n_active_arcs; i++)
+        {
+            if (done[i])
+                continue;
+
+            const int s{active_sync_arcs[i].first};
+
+            walk_dist_[s] = 0;
+            touched.push_back(s);
+            queue.push_back(s);
+
+            while (!queue.empty())
+            {
+                const int u{queue.front()};
+                queue.pop_front();
+
+                size_t n_succ = 0;
+                const int *succ = NULL;
+
+                support_graph_.successors(u, succ, n_succ);
+
+                for (size_t r{0}; r < n_succ; r++)
                 {
+                    const int w{succ[r]};
+                    const int cost{w == route_next_[u] ? 0 : 1};
 
-                    // Skip if cycle i became redundant during inner loop
-                    if (redundant_cycles[i])
+                    if (walk_dist_[w] >= 0 && walk_dist_[w] <= walk_dist_[u] + cost)
                         continue;
 
-                    const vector<bool> &ordered_cycle_j{ordered_cycles[j]};
+                    if (walk_dist_[w] < 0)
+                        touched.push_back(w);
 
-                    // If boolean vectors equal, cycle j is duplicate
-                    if (ordered_cycle_i == ordered_cycle_j)
-                    {
-                        redundant_cycles[j] = true;
-                    }
+                    walk_dist_[w] = walk_dist_[u] + cost;
+                    walk_pred_[w] = u;
+
+                    if (cost == 0)
+                        queue.push_front(w);
+                    else
+                        queue.push_back(w);
                 }
             }
+
+            // Every sync arc leaving s is served by this search
+            for (size_t k{i}; k < n_active_arcs; k++)
+            {
+                if (active_sync_arcs[k].first != s)
+                    continue;
+
+                done[k] = true;
+
+                const int t{active_sync_arcs[k].second};
+
+                if (t == s || walk_dist_[t] < 0)
+                    continue;
+
+                sequence.clear();
+
+                for (int v{t}; v != s; v = walk_pred_[v])
+                    sequence.push_back(v);
+
+                sequence.push_back(s);
+                reverse(sequence.begin(), sequence.end());
+
+                walk_of[k] = (int)walks.size();
+                walks.push_back(sequence);
+            }
+
+            for (const int v : touched)
+            {
+                walk_dist_[v] = -1;
+                walk_pred_[v] = -1;
+            }
+
+            touched.clear();
         }
 
-        // Phase 3: Rebuild cycles vector without duplicates
-        for (size_t i{0}; i < n_cycles; i++)
+        vector<int> cycle;
+
+        for (size_t k{0}; k < n_active_arcs; k++)
         {
-            if (!redundant_cycles[i])
+            if (walk_of[k] < 0)
             {
-                cycles.push_back(old_cycles[i]);
+                cerr << "No path found" << endl;
+                continue;
             }
+
+            sequence_2_path_(walks[walk_of[k]], alpha_v, gamma_v, cycle);
+            cycle.push_back(closing_arc_(active_sync_arcs[k]));
+
+            if (insert_signature_(cycle, cycle_signatures_))
+                cycles.push_back(cycle);
         }
     }
 
     /**
-     * Enumerate all cycles through active synchronization arcs
-     *
-     * For each active sync arc (i,j):
-     * 1. Run DFS from i to j to find all simple paths
-     * 2. Convert each vertex sequence to arc index sequence
-     * 3. Close cycle by appending reverse sync arc (j,i)
-     * 4. Add cycle to results
+     * Merge per-arc cycles in sync arc order, as the serial enumeration
+     * produces them, dropping repeated signatures
+     */
+    void path_finder::merge_arc_cycles_(const vector<arc_cycle_span> &arc_spans, cycle_list &cycles)
+    {
+        GOMA::trace_scope trace("merge_cycles", "cycles");
+
+        for (const arc_cycle_span &span : arc_spans)
+        {
+            // Sync arcs left unsearched by a deadline are empty too
+            if (span.n_ == 0 && !truncated_)
+            {
+                cerr << "No path found" << endl;
+            }
+
+            const cycle_list &c_cycles{thread_cycles_[span.list_]};
+
+            for (size_t r{span.first_}; r < span.first_ + span.n_; r++)
+            {
+                const GOMA::array_view<int> c_cycle{c_cycles[r]};
+
+                if (insert_signature_(c_cycle, cycle_signatures_))
+                {
+                    cycles.push_back(c_cycle);
+                }
+            }
+        }
+    }
+
+    /**
+     * One cycle list per thread, emptied (capacity kept from the previous calls)
+     */
+    void path_finder::prepare_thread_cycles_(const size_t n_threads)
+    {
+        if (thread_cycles_.size() < n_threads)
+            thread_cycles_.resize(n_threads);
+
+        for (cycle_list &c_cycles : thread_cycles_)
+            c_cycles.clear();
+    }
+
+    /**
+     * Bounded cycle search through active synchronization arcs
      *
-     * Finally removes duplicate cycles (same routing arc set).
+     * For each active sync arc (i,j), the k cheapest paths from i to j are
+     * found by best-first search on the support graph, where k is the
+     * per-arc limit (or the global one if only that is set). Each path is
+     * closed with the reverse sync arc; its cost is the path cost plus the
+     * cost of the closing arc.
      *
-     * beta_v parameter currently unused (future extension for time-aware paths).
+     * Cycles with a new routing arc set are collected in a flat list,
+     * sorted by cost (stable, so ties keep enumeration order) and appended to cycles up
+     * to the global limit. The time budget covers the whole call; sync arcs
+     * not reached within it are skipped. A deadline caps the budget of
+     * each search by its time left.
      */
-    void path_finder::find_full_paths_(const vector<double> &alpha_v,
-                                       const vector<double> &beta_v,
-                                       const vector<double> &gamma_v,
+    void path_finder::find_best_paths_(const GOMA::array_view<double> &alpha_v,
+                                       const GOMA::array_view<double> &gamma_v,
                                        const vector<pair<int, int>> &active_sync_arcs,
-                                       vector<vector<int>> &cycles)
+                                       cycle_list &cycles)
     {
+        const chrono::steady_clock::time_point start{chrono::steady_clock::now()};
+
+        size_t k{numeric_limits<size_t>::max()};
 
-        const bool beta_empty{(beta_v.size() == 0)};
+        if (max_cycles_per_arc_ > 0)
+            k = max_cycles_per_arc_;
 
-        vector<vector<int>> c_sequences; // Vertex sequences (paths)
+        if (max_cycles_ > 0 && max_cycles_ < k)
+            k = max_cycles_;
+
+        GOMA::ragged_array<int> &c_sequences{sequences_}; // Vertex sequences (paths)
+        vector<double> c_costs;                           // Path costs
 
-        vector<int> type;
         vector<int> cycle; // Arc sequence for current cycle
 
-        // For each active sync arc, find all paths and close to form cycles
+        cycle_list candidates;                  // New cycles, in enumeration order
+        vector<pair<double, size_t>> by_cost;   // Cost and position of each candidate
+
         for (const pair<int, int> &arc : active_sync_arcs)
         {
-            c_sequences.clear();
-
-            // DFS from arc.first to arc.second to find all simple paths
-            support_graph_.DFS(arc.first, arc.second, c_sequences);
+            double time_left{0};
 
-            if (c_sequences.size() > 0)
+            if (time_limit_ > 0)
             {
-                // Convert each vertex sequence to arc sequence and close cycle
-                for (const vector<int> &c_sequence : c_sequences)
-                {
-                    // Convert vertex sequence to arc indices
-                    sequence_2_path_(c_sequence, alpha_v, gamma_v, cycle);
+                const chrono::duration<double> elapsed{chrono::steady_clock::now() - start};
 
-                    // Close cycle with reverse sync arc
-                    const int closing_arc{closing_arc_(arc)};
+                time_left = time_limit_ - elapsed.count();
 
-                    cycle.push_back(closing_arc);
+                if (time_left <= 0)
+                {
+                    truncated_ = true;
+                    break;
+                }
+            }
 
-                    cycles.push_back(cycle);
+            if (deadline_ != NULL)
+            {
+                if (deadline_->expired())
+                {
+                    truncated_ = true;
+                    break;
                 }
+
+                const double deadline_left{deadline_->remaining()};
+
+                if (deadline_->is_limited() && (time_left <= 0 || deadline_left < time_left))
+                    time_left = deadline_left;
             }
-            else
+
+            support_graph_.best_first_paths(arc.first, arc.second, k, time_left, c_sequences, c_costs);
+
+            const int closing_arc{closing_arc_(arc)};
+            const double closing_cost{arc_cost_(gamma_v[closing_arc - n_routing_arcs_])};
+
+            const size_t n_sequences{c_sequences.size()};
+
+            for (size_t r{0}; r < n_sequences; r++)
             {
-                cout << "No path found" << endl;
+                // Convert vertex sequence to arc indices
+                sequence_2_path_(c_sequences[r], alpha_v, gamma_v, cycle);
+
+                // Close cycle with reverse sync arc
+                cycle.push_back(closing_arc);
+
+                // Keep only cycles with a new routing arc set
+                if (insert_signature_(cycle, cycle_signatures_))
+                {
+                    by_cost.push_back(pair<double, size_t>(c_costs[r] + closing_cost, candidates.size()));
+                    candidates.push_back(cycle);
+                }
             }
         }
 
-        // Remove cycles with identical routing arc sets
-        remove_repeated_cycles_(cycles);
+        // Most violated (cheapest) cycles first
+        stable_sort(by_cost.begin(), by_cost.end(),
+                    [](const pair<double, size_t> &a, const pair<double, size_t> &b)
+                    { return a.first < b.first; });
+
+        if (max_cycles_ > 0 && by_cost.size() > max_cycles_)
+            by_cost.resize(max_cycles_);
+
+        for (const pair<double, size_t> &candidate : by_cost)
+            cycles.push_back(candidates[candidate.second]);
     }
 
     /**
@@ -283,9 +954,9 @@ namespace SYNC_LIB
      *
      * Parameters alpha_v and beta_v currently unused (reserved for future).
      */
-    void path_finder::sequence_2_path_(const vector<int> &sequence,
-                                       const vector<double> &alpha_v,
-                                       const vector<double> &beta_v,
+    void path_finder::sequence_2_path_(const GOMA::array_view<int> &sequence,
+                                       const GOMA::array_view<double> &alpha_v,
+                                       const GOMA::array_view<double> &beta_v,
                                        vector<int> &cycle) const
     {
         cycle.clear();
@@ -325,6 +996,16 @@ namespace SYNC_LIB
     /**
      * Build support graph from LP solution
      *
+     * The graph of the previous call is kept: only arcs whose activity
+     * flipped are added or removed, and the active depot set is a count of
+     * active routing arcs per depot. Consecutive separation rounds change
+     * few duals, so the graph work follows the change. The updated graph
+     * is then compressed once (CSR) for the searches, which only read it,
+     * and its strongly connected components are computed: each search
+     * from i to j only enters vertices that reach j (inside the component
+     * of i and j when they share one), so dead-end branches of the
+     * fractional support are never explored.
+     *
      * Constructs directed graph with edges corresponding to active arcs:
      * - Routing arcs with alpha > tolerance
      * - Sync arcs with gamma > tolerance
@@ -338,55 +1019,170 @@ namespace SYNC_LIB
      * Note: Inverted arc direction stored in active_sync_arcs (j,i) instead of (i,j)
      * for compatibility with DFS cycle closure.
      */
-    void path_finder::update_support_graph_(const vector<double> &alpha_v,
-                                            const vector<double> &beta_v,
-                                            const vector<double> &gamma_v,
-                                            vector<pair<int, int>> &active_sync_arcs)
+    void path_finder::update_support_graph_(const GOMA::array_view<double> &alpha_v,
+                                            const GOMA::array_view<double> &beta_v,
+                                            const GOMA::array_view<double> &gamma_v,
+                                            vector<pair<int, int>> &active_sync_arcs,
+                                            const vector<int> *routing_candidates)
     {
-        support_graph_.clear();
         active_sync_arcs.clear();
 
         const size_t n_routing_arcs{routing_arcs_.size()};
         const size_t n_sync_arcs{sync_arcs_.size()};
 
-        set<int> active_depot_set; // Depots with at least one active routing arc
-
-        // Add routing arcs to support graph (alpha > tolerance)
-        for (size_t i{0}; i < n_routing_arcs; i++)
-        {
-            if (alpha_v[i] > tol_)
-            {
+        n_support_changes_ = 0;
 
-                const triplet &arc{routing_arcs_[i]};
-                support_graph_.add_arc(arc.i_, arc.j_);
+        // Largest weight, so that the strongest arcs cost 0 in bounded mode
+        max_weight_ = 0.0;
 
-                // Track which depots are active (used in routes)
-                active_depot_set.insert(arc.k_i_);
-            }
+        if (routing_candidates == NULL)
+        {
+            for (size_t i{0}; i < n_routing_arcs; i++)
+                if (alpha_v[i] > max_weight_)
+                    max_weight_ = alpha_v[i];
+        }
+        else
+        {
+            for (const int i : *routing_candidates)
+                if (alpha_v[i] > max_weight_)
+                    max_weight_ = alpha_v[i];
         }
 
-        // Add sync arcs to support graph (gamma > tolerance)
         for (size_t i{0}; i < n_sync_arcs; i++)
+            if (gamma_v[i] > max_weight_)
+                max_weight_ = gamma_v[i];
+
+        if (max_weight_ <= tol_)
+            max_weight_ = 1.0;
+
+        // Routing arcs (alpha > tolerance): only flipped arcs touch the graph
+        routing_previous_.swap(routing_support_);
+        routing_support_.clear();
+
+        if (routing_candidates == NULL)
+        {
+            for (size_t i{0}; i < n_routing_arcs; i++)
+                update_routing_arc_(i, alpha_v[i]);
+        }
+        else
         {
-            if (gamma_v[i] > tol_)
+            // Arcs of the previous support and candidates: alpha is 0 elsewhere
+            const vector<int> &candidates{*routing_candidates};
+
+            size_t p{0};
+            size_t q{0};
+
+            while (p < routing_previous_.size() || q < candidates.size())
             {
-                const triplet &arc{sync_arcs_[i]};
-                support_graph_.add_arc(arc.i_, arc.j_);
+                int i;
 
-                // Determine if sync arc should be considered for cycle detection
-                if ((arc.i_ > n_depots_) || (arc.j_ > n_depots_))
+                if (q == candidates.size() || (p < routing_previous_.size() && routing_previous_[p] < candidates[q]))
                 {
-                    // At least one endpoint is non-depot operation: always consider
-                    // Note: Stores inverted arc (j,i) for cycle closure
-                    active_sync_arcs.push_back(pair<int, int>(arc.j_, arc.i_));
+                    i = routing_previous_[p++];
                 }
-                else if ((active_depot_set.find(arc.i_) != active_depot_set.end()) &&
-                         (active_depot_set.find(arc.j_) != active_depot_set.end()))
+                else
                 {
-                    // Both endpoints are active depots: consider for cycle detection
-                    active_sync_arcs.push_back(pair<int, int>(arc.i_, arc.j_));
+                    if (p < routing_previous_.size() && routing_previous_[p] == candidates[q])
+                        p++;
+
+                    i = candidates[q++];
                 }
+
+                update_routing_arc_(i, alpha_v[i]);
+            }
+        }
+
+        // Sync arcs (gamma > tolerance)
+        for (size_t i{0}; i < n_sync_arcs; i++)
+        {
+            const triplet &arc{sync_arcs_[i]};
+            const size_t a{n_routing_arcs + i};
+
+            if (gamma_v[i] <= tol_)
+            {
+                if (in_support_[a])
+                    remove_support_arc_(a, arc);
+
+                continue;
+            }
+
+            update_support_arc_(a, arc, arc_cost_(gamma_v[i]));
+
+            // Determine if sync arc should be considered for cycle detection
+            if ((arc.i_ > n_depots_) || (arc.j_ > n_depots_))
+            {
+                // At least one endpoint is non-depot operation: always consider
+                // Note: Stores inverted arc (j,i) for cycle closure
+                active_sync_arcs.push_back(pair<int, int>(arc.j_, arc.i_));
+            }
+            else if ((n_depot_arcs_[arc.i_] > 0) && (n_depot_arcs_[arc.j_] > 0))
+            {
+                // Both endpoints are active depots: consider for cycle detection
+                active_sync_arcs.push_back(pair<int, int>(arc.i_, arc.j_));
             }
         }
+
+        // One contiguous successor layout for all the searches of this call
+        support_graph_.compress();
+
+        // Components for the reachability pruning of the searches
+        support_graph_.find_components();
+    }
+
+    void path_finder::update_routing_arc_(const size_t a, const double alpha)
+    {
+        const triplet &arc{routing_arcs_[a]};
+
+        if (alpha > tol_)
+        {
+            // Track which depots are active (used in routes)
+            if (!in_support_[a])
+                n_depot_arcs_[arc.k_i_]++;
+
+            update_support_arc_(a, arc, arc_cost_(alpha));
+
+            routing_support_.push_back((int)a);
+        }
+        else if (in_support_[a])
+        {
+            remove_support_arc_(a, arc);
+            n_depot_arcs_[arc.k_i_]--;
+        }
+    }
+
+    /**
+     * Add arc a to the support graph, or rewrite its cost if it is already
+     * there with another one
+     */
+    void path_finder::update_support_arc_(const size_t a, const triplet &arc, const double cost)
+    {
+        if (!in_support_[a])
+        {
+            support_graph_.add_arc(arc.i_, arc.j_, cost);
+
+            in_support_[a] = true;
+            support_cost_[a] = cost;
+            n_support_changes_++;
+            n_support_arcs_++;
+        }
+        else if (support_cost_[a] != cost)
+        {
+            support_graph_.set_arc_cost(arc.i_, arc.j_, cost);
+
+            support_cost_[a] = cost;
+            n_support_changes_++;
+        }
+    }
+
+    /**
+     * Remove arc a from the support graph (O(out-degree of its tail))
+     */
+    void path_finder::remove_support_arc_(const size_t a, const triplet &arc)
+    {
+        support_graph_.remove_arc(arc.i_, arc.j_);
+
+        in_support_[a] = false;
+        n_support_changes_++;
+        n_support_arcs_--;
     }
 }
\ No newline at end of file
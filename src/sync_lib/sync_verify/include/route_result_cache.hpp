@@ -0,0 +1,154 @@
+/**
+ * @file route_result_cache.hpp
+ * @brief Memo of check results keyed by the route set of a routing
+ *
+ * A local search revisits routings: a move and its reverse, or a tabu
+ * neighbourhood where only one depot's route changed since an earlier
+ * visit. The answer of scheduling_session::check() only depends on the
+ * routes, so a routing seen before is answered from the memo, without
+ * building x or solving the checker LP.
+ *
+ * Entries are keyed by a fingerprint of the route set: one hash per depot
+ * route (its nodes in visiting order), combined in depot order. The routes
+ * are kept in the entry and compared on lookup, so two route sets with the
+ * same fingerprint are never confused.
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "sync_types.hpp"
+#include "sync_scheduling.hpp"
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class cached_result
+     * @brief Answer of one check with the routes it was computed for
+     */
+    class cached_result
+    {
+    public:
+        size_t key_;                     ///< Route set fingerprint
+        GOMA::ragged_array<int> routes_; ///< Routes, one list per depot
+        bool feasible_;                  ///< Answer of the check
+
+        vector<int> support_; ///< Routing arcs with x = 1
+        size_t n_arcs_;       ///< Size of x
+
+        sync_scheduling schedule_; ///< Schedule (feasible)
+
+        vector<double> alpha_; ///< Certificate α (infeasible)
+        vector<double> beta_;  ///< Certificate β (infeasible)
+        vector<double> gamma_; ///< Certificate γ (infeasible)
+        cycle_list cycles_;    ///< Violated cycles (infeasible)
+
+        size_t last_use_; ///< Clock of the last store or lookup hit
+
+        cached_result(void) : key_(0), routes_(), feasible_(false), support_(), n_arcs_(0), schedule_(),
+                              alpha_(), beta_(), gamma_(), cycles_(), last_use_(0) {}
+
+        virtual ~cached_result(void) {}
+    };
+
+    /**
+     * @class route_result_cache
+     * @brief Bounded LRU memo of check results keyed by route sets
+     *
+     * ```cpp
+     * session.set_result_cache(4096);    // owned by the session, 0 disables
+     *
+     * // ... checks: repeated route sets are answered from the memo ...
+     *
+     * const route_result_cache &cache{*session.get_result_cache()};
+     * cout << cache.get_n_hits() << " / " << cache.get_n_lookups() << endl;
+     * ```
+     *
+     * Only complete answers are stored: checks cut short by a deadline are
+     * not.
+     */
+    class route_result_cache
+    {
+    protected:
+        size_t capacity_; ///< Maximum number of entries (least recently used evicted)
+        size_t clock_;    ///< Logical time for LRU eviction
+
+        vector<cached_result> entries_;       ///< Cached results
+        unordered_map<size_t, size_t> index_; ///< Fingerprint → entry
+
+        size_t n_lookups_;   ///< Calls to find()
+        size_t n_hits_;      ///< Lookups answered from the memo
+        size_t n_evictions_; ///< Entries replaced when full
+
+    public:
+        /**
+         * @brief Construct an empty cache
+         * @param capacity Maximum number of results (at least 1)
+         */
+        route_result_cache(size_t capacity = 1024);
+
+        virtual ~route_result_cache(void);
+
+        /**
+         * @brief Fingerprint of a route set
+         * @param routes One route per depot
+         * @return Hash of the route hashes in depot order
+         */
+        static size_t key(const vector<vector<int>> &routes);
+
+        /**
+         * @brief Find the result of a route set
+         * @param key Fingerprint of routes (key())
+         * @param routes One route per depot
+         * @return Entry, or NULL on a miss
+         */
+        const cached_result *find(size_t key, const vector<vector<int>> &routes);
+
+        /**
+         * @brief Store the result of a route set
+         * @param key Fingerprint of routes (key())
+         * @param routes One route per depot
+         * @param feasible Answer of the check
+         * @param x model_a x of the routes
+         * @param schedule Schedule (stored if feasible)
+         * @param alpha α of the certificate (stored if infeasible)
+         * @param beta β of the certificate (stored if infeasible)
+         * @param gamma γ of the certificate (stored if infeasible)
+         * @param cycles Violated cycles (stored if infeasible)
+         *
+         * An entry with the same fingerprint (the same route set, or a
+         * colliding one) is replaced.
+         */
+        void store(size_t key, const vector<vector<int>> &routes, bool feasible, const vector<double> &x,
+                   const sync_scheduling &schedule, const vector<double> &alpha, const vector<double> &beta,
+                   const vector<double> &gamma, const cycle_list &cycles);
+
+        /**
+         * @brief Remove every entry and reset the statistics
+         */
+        void clear(void);
+
+        /**
+         * @brief Heap bytes held by the entries (schedules approximate)
+         */
+        size_t get_memory_bytes(void) const;
+
+        inline size_t size(void) const { return entries_.size(); }
+        inline bool empty(void) const { return entries_.empty(); }
+        inline size_t get_capacity(void) const { return capacity_; }
+        inline size_t get_n_lookups(void) const { return n_lookups_; }
+        inline size_t get_n_hits(void) const { return n_hits_; }
+        inline size_t get_n_misses(void) const { return n_lookups_ - n_hits_; }
+        inline size_t get_n_evictions(void) const { return n_evictions_; }
+
+    protected:
+        /**
+         * @brief Check if an entry holds a route set
+         */
+        static bool same_routes_(const cached_result &entry, const vector<vector<int>> &routes);
+    };
+}
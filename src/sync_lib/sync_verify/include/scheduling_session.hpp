@@ -0,0 +1,180 @@
+/**
+ * @file scheduling_session.hpp
+ * @brief In-process scheduling of many routings of one instance
+ *
+ * The ctsp_scheduler executable builds the model, the checker and the path
+ * finder on every run, and exchanges routes and schedules through files.
+ * A caller checking many routings (a heuristic, a branch-and-cut master)
+ * and forking the executable for each pays process start and model
+ * construction every time.
+ *
+ * scheduling_session owns a built model and keeps the converter (LP checker,
+ * difference checker, path finder) and the routing-to-x converter warm
+ * across calls: check() takes routes in memory and leaves the schedule or
+ * the violated cycles in the session, with no file involved. An optional
+ * memo (route_result_cache) answers the route sets checked before.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "sol_2_scheduling.hpp"
+#include "sync_model_a_builder.hpp"
+#include "model_a_solution_interface.hpp"
+#include "sync_solution.hpp"
+#include "sync_scheduling.hpp"
+#include "sync_infeasible.hpp"
+#include "route_result_cache.hpp"
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class scheduling_session
+     * @brief Warm converter for repeated in-memory checks
+     *
+     * ```cpp
+     * CTSP::CTSP_scheduling_session session(instance);   // built once
+     *
+     * for (const vector<vector<int>> &routes : candidates)
+     * {
+     *     if (session.check(routes))
+     *         use(session.get_schedule());
+     *     else
+     *         add_cuts(session.get_violated_cycles());    // or session.get_infeasible().get_cuts(...)
+     * }
+     * ```
+     *
+     * Routes use the sync_solution layout: one route per depot, nodes
+     * 0-based (as sync_solution::read stores them). The schedule and the
+     * cycles are valid until the next check(). The schedule is updated in
+     * place (conTSP2_scheduling::solve_incremental): depots whose start
+     * times did not change keep their lists. The converter does not print
+     * to stdout.
+     */
+    class scheduling_session
+    {
+    protected:
+        unique_ptr<sync_model_a_builder> owned_builder_; ///< Model, if owned by the session (NULL: shared)
+        const sync_model_a_builder &builder_;            ///< Model (outlives the converter)
+
+        conTSP2_scheduling scheduler_;                   ///< Checkers and cycle finders
+        model_a_solution_interface solution_interface_; ///< Routes to model_a x
+
+        sync_solution solution_;      ///< Routes of the last check (reused)
+        vector<double> x_;            ///< model_a x of the last check
+        sparse_x sx_;                 ///< Nonzero entries of x_ for a check of routes
+        bool x_sparse_;               ///< x_ is zero outside sx_ (reset in O(support))
+        sync_scheduling schedule_;    ///< Schedule of the last feasible check
+        sync_infeasible infeasible_;  ///< Certificate and cycles of the last infeasible check
+
+        unique_ptr<route_result_cache> result_cache_; ///< Memo of check(routes) results (NULL: disabled)
+
+        size_t n_checks_;   ///< Calls to check()
+        size_t n_feasible_; ///< Feasible ones
+
+    public:
+        /**
+         * @brief Session over a built model
+         * @param builder Model (ownership taken)
+         * @param tol Numerical tolerance of the checkers
+         * @param engine Verification engine (fractional x always uses the LP)
+         */
+        scheduling_session(unique_ptr<sync_model_a_builder> builder, const double tol = 1e-6,
+                           const sync_engine engine = sync_engine::LP);
+
+        /**
+         * @brief Session over a model shared with other sessions
+         * @param builder Model (not owned, must outlive the session and not
+         *        change while it is used)
+         * @param tol Numerical tolerance of the checkers
+         * @param engine Verification engine (fractional x always uses the LP)
+         *
+         * Several sessions of the same model can check in parallel, one per
+         * thread: each one has its own checkers and converter.
+         */
+        scheduling_session(const sync_model_a_builder &builder, const double tol = 1e-6,
+                           const sync_engine engine = sync_engine::LP);
+
+        virtual ~scheduling_session(void);
+
+        scheduling_session(const scheduling_session &) = delete;
+        scheduling_session &operator=(const scheduling_session &) = delete;
+
+        /**
+         * @brief Check a routing and compute its schedule or violated cycles
+         * @param routes One route per depot, 0-based nodes
+         * @return true if the routing satisfies the synchronization
+         *         constraints (get_schedule), false otherwise
+         *         (get_violated_cycles, get_infeasible)
+         * @throw std::invalid_argument If there is not one route per depot,
+         *        a route does not start and end at the depot (node 0) or
+         *        visits a node that is not a customer of its depot, or a
+         *        route uses an arc pruned from the model (arc_pruning)
+         *
+         * The routes are converted to the nonzero entries of x only
+         * (sparse_x), which the converter and the LP checker load in
+         * O(support). With a result cache, a route set found in it restores
+         * x, the schedule or the certificate and cycles of the earlier
+         * check, without calling the converter.
+         */
+        bool check(const vector<vector<int>> &routes);
+
+        /**
+         * @brief Check a routing given in model_a form
+         * @param x Routing arc values (fractional values use the LP)
+         * @return As check(routes)
+         */
+        bool check_x(const vector<double> &x);
+
+        inline const sync_scheduling &get_schedule(void) const { return schedule_; }
+        inline const cycle_list &get_violated_cycles(void) const { return infeasible_.violated_cycles(); }
+        inline const sync_infeasible &get_infeasible(void) const { return infeasible_; }
+        inline const vector<double> &get_x(void) const { return x_; }
+
+        /**
+         * @brief Converter, to set its options (engine limits, decomposition, cut pool, ...)
+         */
+        inline conTSP2_scheduling &get_scheduler(void) { return scheduler_; }
+
+        inline const sync_model_a_builder &get_builder(void) const { return builder_; }
+
+        /**
+         * @brief Memoize the results of check(routes)
+         * @param capacity Route sets kept (least recently used evicted), 0
+         *        to disable and free the cache
+         *
+         * Results depend on the converter options: clear the cache (set it
+         * again) after changing them. check_x() is not memoized.
+         */
+        void set_result_cache(size_t capacity);
+
+        /**
+         * @brief Result cache, for its hit and miss counters
+         * @return NULL if disabled
+         */
+        inline const route_result_cache *get_result_cache(void) const { return result_cache_.get(); }
+
+        inline size_t get_n_checks(void) const { return n_checks_; }
+        inline size_t get_n_feasible(void) const { return n_feasible_; }
+
+    private:
+        /**
+         * @brief Check x_ with the converter
+         * @param x Its nonzero entries (NULL: dense check of x_)
+         * @return true if feasible
+         */
+        bool solve_(const sparse_x *x);
+
+        /**
+         * @brief Restore the result of an earlier check
+         * @param entry Cached result
+         * @return Its answer
+         */
+        bool restore_(const cached_result &entry);
+    };
+}
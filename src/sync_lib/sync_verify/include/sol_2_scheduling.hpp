@@ -14,10 +14,19 @@
 
 #include "sync_iterative_checker.hpp"
 #include "ctsp_lb_sync_checker.hpp"
+#include "sync_difference_checker.hpp"
+#include "sync_component_checker.hpp"
 #include "sync_scheduling.hpp"
 #include "sync_infeasible.hpp"
+#include "sparse_x.hpp"
+#include "sync_model_snapshot.hpp"
+#include "sync_stats.hpp"
+#include "sync_memory.hpp"
 #include "sync_tw.hpp"
 #include "path_finder.hpp"
+#include "cycle_cut_pool.hpp"
+#include "min_mean_cycle_finder.hpp"
+#include "cycle_shrinker.hpp"
 
 using namespace std;
 
@@ -35,6 +44,49 @@ namespace SYNC_LIB
      */
     typedef pair<int, operation_times> operation_info;
 
+    /**
+     * @enum sync_engine
+     * @brief Engine used to verify synchronization constraints
+     */
+    enum class sync_engine
+    {
+        LP,        ///< Dual LP solved by CPLEX/CLP (ctsp_lb_sync_checker)
+        DIFFERENCE ///< Negative-cycle search (sync_difference_checker), integral x only
+    };
+
+    /**
+     * @enum race_entrant
+     * @brief Engine of a check run by the race mode (set_race)
+     */
+    enum class race_entrant
+    {
+        DIFFERENCE, ///< sync_difference_checker (integral x only)
+        LP,         ///< Full LP (ctsp_lb_sync_checker)
+        COMPONENTS, ///< One LP per support graph component (sync_component_checker)
+        NONE        ///< No engine answered (stopped by the deadline)
+    };
+
+    /**
+     * @enum cycle_search
+     * @brief Engine used to find the violated cycles of an infeasible x
+     */
+    enum class cycle_search
+    {
+        PATHS,   ///< Paths of the certificate support (path_finder), exponential in the worst case
+        MIN_MEAN ///< Minimum mean cycles of the x-weighted graph (min_mean_cycle_finder), polynomial
+    };
+
+    /**
+     * @enum schedule_objective
+     * @brief Start times returned for a feasible solution
+     */
+    enum class schedule_objective
+    {
+        FEASIBLE, ///< Those of the check, no objective
+        MIN_IDLE, ///< Minimum total idle time: Σ_k (return_k - departure_k), less the travel times
+        WEIGHTED  ///< Minimum Σ w_i s_i for the weights of set_schedule_weights()
+    };
+
     /**
      * @class conTSP2_scheduling
      * @brief Converts CTSP solutions to temporal schedules with time windows
@@ -59,28 +111,92 @@ namespace SYNC_LIB
     protected:
         /// Synchronization constraint checker (uses ctsp_lb_sync_checker internally)
         sync_iterative_checker<ctsp_lb_sync_checker> checker_;
+        sync_difference_checker difference_checker_; ///< LP-free checker for integral x
+        sync_component_checker component_checker_;   ///< One LP per support graph component
         path_finder path_finder_;  ///< DFS-based violated cycle finder utility
+        min_mean_cycle_finder mean_cycle_finder_; ///< Polynomial violated cycle finder
+        cycle_search cycle_search_;               ///< Selected cycle finder
+        cycle_shrinker cycle_shrinker_;           ///< Reduction of the cycles found to minimal ones
+        bool minimal_cycles_;                     ///< Shrink the cycles found before returning them
+        cycle_cut_pool *cut_pool_; ///< Optional pool of cycles re-checked before the checker (not owned)
+
+        const sync_engine engine_;           ///< Selected verification engine
+        bool decompose_;                     ///< Solve one LP per component instead of the full LP
+        bool race_;                          ///< Run the applicable engines concurrently, first answer wins
+        bool feasibility_only_;              ///< Stop the LPs at the first infeasibility certificate
+        bool verbose_;                       ///< Report infeasible solutions on stdout
+
+        schedule_objective objective_;       ///< Start times returned for feasible solutions
+        vector<double> objective_weights_;   ///< Start time weights of objective_ (per operation)
+
+        const GOMA::search_deadline *deadline_;  ///< Caller's stop token of solve() (not owned, NULL: none)
+        GOMA::search_deadline solve_deadline_;   ///< Token restarted by each solve() with time_limit_
+        double time_limit_;                      ///< Seconds per solve() without caller's token (0: no limit)
+        bool truncated_;                         ///< The last solve() was stopped by the deadline
 
         const size_t n_depots_;              ///< Number of depots in the problem
         const size_t n_customers_;           ///< Number of customers to serve
         const size_t n_operations_;          ///< Total number of operations (pickups + deliveries + customer visits)
-        const double max_time_windows_size_; ///< Maximum allowed time window width
+        double max_time_windows_size_;       ///< Maximum allowed time window width
         const double max_distance_;          ///< Maximum route distance/duration
-        const vector<int> operation_2_depot_;    ///< Maps each operation to its depot
-        const vector<int> operation_2_customer_; ///< Maps each operation to its customer
 
-        /// Travel time matrix between operations (i+1, j+1 indexing)
-        const GOMA::matrix<double> arc_time_matrix_;
+        /// Operation arrays, shared with the checkers of the model
+        const shared_ptr<const sync_model_snapshot> model_;
+        const vector<int> &operation_2_depot_;    ///< Maps each operation to its depot (in model_)
+        const vector<int> &operation_2_customer_; ///< Maps each operation to its customer (in model_)
+
+        /// Travel times between operations (get_arc_time), not copied
+        const sync_model_a_builder &builder_;
+
+        const vector<string> &operation_names_; ///< Human-readable operation names (in model_)
+
+        // Incremental schedules (solve_incremental)
+        vector<int> depot_ops_head_;    ///< CSR offsets of the operations of each depot (n_depots + 1)
+        vector<int> depot_ops_;         ///< Operations of each depot, in increasing order
+        vector<double> schedule_s_;     ///< Start times of the last schedule built (empty: none)
+        size_t n_depots_rebuilt_;       ///< Depot schedules built by the feasible checks
+        size_t n_depots_reused_;        ///< Depot schedules kept by solve_incremental
+
+        // Sparse solutions (solve with a sparse_x)
+        const sparse_x *sparse_; ///< x of the running solve() if given sparse (NULL: dense call)
+        vector<double> x_;       ///< Dense mirror of the last sparse x (zero elsewhere)
+        sparse_x x_support_;     ///< Entries of x_ set by the last sparse x
+
+        vector<double> s_;     ///< Start times of the differential checks
+        vector<double> alpha_; ///< α certificate of the differential checks
+        vector<double> beta_;  ///< β certificate of the differential checks
+        vector<double> gamma_; ///< γ certificate of the differential checks
 
-        const vector<string> operation_names_; ///< Human-readable operation names
+        /// Buffers of one engine of a race
+        struct race_lane
+        {
+            vector<double> s, alpha, beta, gamma; ///< Its answer (start times or certificate)
+            bool feasible;                        ///< Its result, if answered
+        };
+
+        // Race mode (set_race)
+        vector<race_lane> race_lanes_;     ///< One per race_entrant (capacity kept between checks)
+        GOMA::search_deadline race_token_; ///< Deadline of the check, cancelled by the winner to stop the component LPs
+        race_entrant race_winner_;         ///< Engine that answered the last check
+        vector<size_t> n_race_wins_;       ///< Races won by each engine (USE_STATS)
+
+        // Work counters of solve() (USE_STATS)
+        size_t n_checks_;      ///< solve() calls
+        size_t n_feasible_;    ///< Feasible ones
+        size_t n_truncated_;   ///< Stopped by the deadline
+        size_t n_cycles_kept_; ///< Violated cycles returned
+        double check_time_;    ///< Seconds in the checks
+        double cycle_time_;    ///< Seconds in the cycle searches
+        size_t peak_cycle_bytes_; ///< Largest set of violated cycles returned
 
     public:
         /**
          * @brief Construct a new conTSP2_scheduling converter
-         * @param builder Model builder containing problem data
+         * @param builder Model builder containing problem data (must outlive the converter)
          * @param tol Numerical tolerance for constraint verification
+         * @param engine Verification engine (fractional x always uses the LP)
          */
-        conTSP2_scheduling(const sync_model_a_builder &builder, double tol);
+        conTSP2_scheduling(const sync_model_a_builder &builder, double tol, sync_engine engine = sync_engine::LP);
         
         /**
          * @brief Destructor
@@ -105,7 +221,454 @@ namespace SYNC_LIB
          */
         bool solve(const string &instance_name, const vector<double> &x, sync_scheduling &scheduling, sync_infeasible &infeasible);
 
+        /**
+         * @brief solve(), reusing the depot schedules that did not change
+         *
+         * scheduling must hold the schedule built by the last feasible
+         * solve() or solve_incremental() of this converter (as
+         * scheduling_session keeps it). A depot schedule only depends on the
+         * start times of the depot's operations: the depots whose start
+         * times are all unchanged keep their list, the others are rebuilt.
+         * The result is the one solve() returns. Without a previous schedule
+         * (or after forget_schedule()) every depot is built.
+         *
+         * @param instance_name Name of the instance (stored in scheduling output)
+         * @param x CTSP decision variables (arc usage indicators)
+         * @param scheduling [in/out] Previous schedule, updated if feasible
+         * @param infeasible [out] Certificate and violated cycles if infeasible
+         * @return true if the solution satisfies all synchronization constraints
+         */
+        bool solve_incremental(const string &instance_name, const vector<double> &x, sync_scheduling &scheduling, sync_infeasible &infeasible);
+
+        /**
+         * @brief solve() for the nonzero entries of x
+         * @param instance_name Name of the instance (stored in scheduling output)
+         * @param x CTSP decision variables, sparse (e.g. from
+         *          model_a_solution_interface::sync_solution_2_model_a)
+         * @param scheduling [out] Generated schedule for each depot
+         * @param infeasible [out] Certificate and violated cycles if infeasible;
+         *        built on get_x(), which holds x densely on return
+         * @return true if the solution satisfies all synchronization constraints
+         *
+         * The full LP checker loads only the arcs that changed since its last
+         * x (found by merging the sorted supports) and the path finder visits
+         * the arcs of x and of the previous support only. The other engines
+         * read the dense mirror get_x(), updated in O(support).
+         */
+        bool solve(const string &instance_name, const sparse_x &x, sync_scheduling &scheduling, sync_infeasible &infeasible);
+
+        /**
+         * @brief solve_incremental() for the nonzero entries of x
+         * @see solve(const string &, const sparse_x &, sync_scheduling &, sync_infeasible &)
+         */
+        bool solve_incremental(const string &instance_name, const sparse_x &x, sync_scheduling &scheduling, sync_infeasible &infeasible);
+
+        /**
+         * @brief Dense copy of the last sparse x solved
+         * @return n routing arc values (empty before the first sparse solve)
+         *
+         * The reference is stable: a sync_infeasible built on it reads the
+         * x of each sparse solve().
+         */
+        inline const vector<double> &get_x(void) const { return x_; }
+
+        /**
+         * @brief Forget the last schedule built
+         *
+         * Call it when the schedule passed to solve_incremental() was not
+         * built by this converter (e.g. replaced by a cached one): its next
+         * call builds every depot.
+         */
+        inline void forget_schedule(void) { schedule_s_.clear(); }
+
+        /**
+         * @brief Select the start times returned for feasible solutions
+         * @param objective FEASIBLE (default), MIN_IDLE or WEIGHTED (the
+         *        weights of the last set_schedule_weights())
+         *
+         * After a feasible check, the LP checker re-solves its loaded LP with
+         * the objective (ctsp_sync_checker::optimize_s): only the right-hand
+         * sides of the operation rows change and the solve starts from the
+         * feasibility basis. With the difference engine or the decomposition
+         * the full LP is checked first. The minimum total idle time is also
+         * the minimum sum of the day makespans, departures being free. If the
+         * re-solve does not reach optimality, the schedule of the check is
+         * returned. Results memoized by a scheduling_session keep the
+         * objective they were built with.
+         */
+        void set_schedule_objective(schedule_objective objective);
+
+        /**
+         * @brief Minimize a weighted sum of start times
+         * @param weights Weight of each operation (sum 0: start times are
+         *        only defined up to a shift)
+         * @throw std::invalid_argument If weights has not one entry per
+         *        operation or does not sum to 0
+         *
+         * Selects schedule_objective::WEIGHTED.
+         */
+        void set_schedule_weights(const vector<double> &weights);
+
+        inline schedule_objective get_schedule_objective(void) const { return objective_; }
+        inline size_t get_n_objective_solves(void) const { return checker_.get_n_objective_solves(); }
+
+        inline size_t get_n_depots_rebuilt(void) const { return n_depots_rebuilt_; }
+        inline size_t get_n_depots_reused(void) const { return n_depots_reused_; }
+
+        /**
+         * @brief Violated cycle finder used when the solution is infeasible
+         * @return Path finder (e.g. to bound the search with set_limits)
+         */
+        inline path_finder &get_path_finder(void) { return path_finder_; }
+
+        /**
+         * @brief Minimum mean cycle finder used with cycle_search::MIN_MEAN
+         * @return Finder (e.g. to set the number of cycles)
+         */
+        inline min_mean_cycle_finder &get_mean_cycle_finder(void) { return mean_cycle_finder_; }
+
+        /**
+         * @brief Select how violated cycles are found
+         * @param search PATHS (default) or MIN_MEAN
+         *
+         * MIN_MEAN runs Karp's algorithm on the x-weighted routing + sync
+         * graph instead of enumerating the certificate support. If it finds
+         * no negative cycle (possible for a fractional x, whose LP is not a
+         * pure difference system), path_finder is used.
+         */
+        inline void set_cycle_search(const cycle_search search) { cycle_search_ = search; }
+
+        /**
+         * @brief Return minimal violated cycles only
+         * @param minimal_cycles true to shrink every cycle found to a minimal
+         *        infeasible set of its routing arcs (cycle_shrinker)
+         *
+         * The cycles of the search are replaced by the negative cycles of
+         * their minimal routing arc sets, and duplicates are dropped, before
+         * they are returned and pooled. Their cuts dominate the original
+         * ones and are violated whenever those are.
+         */
+        inline void set_minimal_cycles(const bool minimal_cycles) { minimal_cycles_ = minimal_cycles; }
+
+        /**
+         * @brief Cycle shrinker used with set_minimal_cycles
+         * @return Shrinker (e.g. to read its counters)
+         */
+        inline const cycle_shrinker &get_cycle_shrinker(void) const { return cycle_shrinker_; }
+
+        /**
+         * @brief Re-check pooled cycles before the checker
+         * @param pool Cycle pool (not owned, NULL to disable). Cycles found by
+         *             path_finder are added to it
+         *
+         * An integral x violating a pooled cut is infeasible: solve() returns
+         * the violated pooled cycles without calling the checker or the
+         * path finder.
+         */
+        inline void set_cut_pool(cycle_cut_pool *pool) { cut_pool_ = pool; }
+
+        /**
+         * @brief Warm start the full LP checker from a basis cache
+         * @param cache Basis cache (not owned, NULL to disable)
+         * @see ctsp_sync_checker::set_basis_cache
+         */
+        inline void set_basis_cache(lp_basis_cache *cache) { checker_.set_basis_cache(cache); }
+
+        /**
+         * @brief Instance fingerprint of the LP checker
+         * @return Key for lp_basis_cache
+         */
+        inline size_t get_instance_key(void) const { return checker_.get_instance_key(); }
+
+        /**
+         * @brief Split the LP into the components of the support graph
+         * @param decompose true to use sync_component_checker instead of the full LP
+         * @param n_threads Component LP workers (0: one per hardware thread)
+         *
+         * Applies whenever the LP is used (LP engine, or fractional x with
+         * the difference engine).
+         */
+        inline void set_decomposition(const bool decompose, const size_t n_threads = 1)
+        {
+            decompose_ = decompose;
+            component_checker_.set_n_threads(n_threads);
+        }
+
+        /**
+         * @brief Stop the checker LPs at the first infeasibility certificate
+         * @param feasibility_only true for yes/no checks (e.g. move screening)
+         *
+         * The certificate is valid but not the most violated one, so the
+         * cycles found from it may differ. The differential sweep always
+         * works in this mode.
+         */
+        inline void set_feasibility_only(const bool feasibility_only)
+        {
+            feasibility_only_ = feasibility_only;
+            checker_.set_feasibility_only(feasibility_only);
+            component_checker_.set_feasibility_only(feasibility_only);
+        }
+
+        inline size_t get_n_early_stops(void) const { return checker_.get_n_early_stops(); }
+
+        /**
+         * @brief Race the engines that apply to each check
+         * @param race true to run them concurrently, one thread each
+         *
+         * Each check starts the difference engine (integral x), the full
+         * LP and, with set_decomposition, the component LPs on the same x.
+         * The first definitive answer is returned with its start times or
+         * certificate; the full LP is then interrupted (LP_STAT_INTERRUPTED)
+         * and the component LPs stop before their next component. The
+         * difference engine is not interruptible: it is run on the calling
+         * thread, so a race it enters costs at most its own time. Latency
+         * rather than CPU time: with one engine left the check runs as
+         * usual. The differential sweeps do not race. The deadline of the
+         * check (set_time_limit, set_deadline) bounds every engine but the
+         * difference one: with no answer by then, the check is truncated.
+         */
+        inline void set_race(const bool race) { race_ = race; }
+
+        /**
+         * @brief Engine whose answer the last check returned
+         * @return The race winner, LP / DIFFERENCE / COMPONENTS outside a
+         *         race, NONE if no engine answered
+         */
+        inline race_entrant get_race_winner(void) const { return race_winner_; }
+
+        /**
+         * @brief Races won by an engine so far (USE_STATS)
+         * @param entrant Engine (not NONE)
+         */
+        inline size_t get_n_race_wins(const race_entrant entrant) const { return n_race_wins_[(size_t)entrant]; }
+
+        /**
+         * @brief Bound each solve() by a time limit
+         * @param seconds Time for the check and the cycle search of one
+         *        solve() call (0: no limit)
+         * @see set_deadline
+         */
+        inline void set_time_limit(const double seconds) { time_limit_ = seconds; }
+
+        /**
+         * @brief Bound solve() by a caller's deadline / cancellation token
+         * @param deadline Stop token (not owned, NULL to disable); replaces
+         *        set_time_limit while set
+         *
+         * The full LP check gets the time left as its LP time limit and
+         * path_finder polls the token in its DFS. A solve() cut short
+         * returns false with sync_infeasible::truncated() set: with no
+         * cycles if the check was stopped (x is not proven infeasible),
+         * with the cycles found so far if the cycle search was. The pool
+         * check, the difference engine, the component LPs and the minimum
+         * mean cycle search are not bounded. The differential sweeps ignore
+         * the deadline.
+         */
+        inline void set_deadline(const GOMA::search_deadline *deadline) { deadline_ = deadline; }
+
+        /**
+         * @brief Check if the last solve() was stopped by the deadline
+         */
+        inline bool is_truncated(void) const { return truncated_; }
+
+        /**
+         * @brief Work counters and timers of the solve() calls so far
+         * @return Totals of the converter, its full LP checker and its path
+         *         finder (all 0 unless built with USE_STATS)
+         *
+         * model_build_time and output_time are left at 0. The LP solves of
+         * the decomposition and the differential sweeps are not timed as
+         * checks, but their full LP solves count in the LP fields.
+         */
+        sync_stats get_stats(void) const;
+
+        /**
+         * @brief Bytes held by the model, the full LP checker and the path finder
+         * @return Sizes now and separation peaks of the solve() calls so far
+         *         (peaks 0 unless built with USE_STATS)
+         *
+         * rss_after_build and peak_rss are left at 0. Walks the DFS stack of
+         * the support graph: O(n²) for n operations, not for the hot path.
+         */
+        sync_memory get_memory(void) const;
+
+        /**
+         * @brief Report infeasible solutions on stdout (default: yes)
+         * @param verbose false when stdout carries results (stream mode) or
+         *        the converter is embedded (scheduling_session)
+         */
+        inline void set_verbose(const bool verbose) { verbose_ = verbose; }
+
+        /**
+         * @brief Reload the synchronization arc times of the builder
+         * @param builder Builder given at construction, after
+         *        sync_model_a_builder::set_time_windows_max_size
+         *
+         * Only the γ objective entries of the LP (and the sync arc costs of
+         * the difference engine) change; the model is not rebuilt. Pooled
+         * cycles are dropped when the time window grows, as they may no
+         * longer be violated.
+         */
+        void update_sync_arc_times(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Check x for several maximum time window widths
+         * @param builder Builder given at construction (restored on return)
+         * @param x CTSP decision variables
+         * @param values Time window widths (MAXIMUM_ALLOWABLE_DIFFERENTIAL) to check
+         * @param feasible [out] Feasibility of x for each value
+         *
+         * One model for every value: each check only changes the γ
+         * objective entries and warm starts from the previous basis.
+         */
+        void sweep_time_windows_max_size(sync_model_a_builder &builder, const vector<double> &x, const vector<double> &values, vector<bool> &feasible);
+
+        /**
+         * @brief Smallest time window width x is feasible for
+         * @param builder Builder given at construction (restored on return)
+         * @param x CTSP decision variables
+         * @param n_checks [out] Synchronization checks performed
+         * @return Minimal MAXIMUM_ALLOWABLE_DIFFERENTIAL (rounded up to 1e-3),
+         *         or infinity if x is infeasible for every width
+         *
+         * Parametric (Newton / Dinkelbach) search from W = 0: every
+         * certificate of infeasibility is a cycle of weight c + k·W, with k
+         * the γ weight of its customer sync arcs, so W is raised to -c / k,
+         * the smallest width that cycle allows. The first feasible W is the
+         * minimum. A certificate with k = 0 does not depend on W.
+         */
+        double get_min_time_windows_max_size(sync_model_a_builder &builder, const vector<double> &x, size_t &n_checks);
+
+        /**
+         * @brief Earliest and latest start time of every operation
+         * @param instance_name Instance name for the output
+         * @param x CTSP decision variables (integral)
+         * @param flexibility [out] One window per operation
+         * @param horizon Every operation starts in [0, horizon]; negative
+         *        (default): the earliest completion of the routing
+         * @return false if x is infeasible or does not fit in the horizon
+         * @throws std::invalid_argument if x is not integral
+         *
+         * One difference check and one reversed shortest path pass, with
+         * the difference engine whatever the engine of solve(): no LP per
+         * operation. The windows are those of the difference constraints,
+         * in the time frame of solve() (earliest start 0).
+         */
+        bool get_flexibility(const string &instance_name, const vector<double> &x, sync_flexibility &flexibility, double horizon = -1.0);
+
     protected:
+        /**
+         * @brief Verify synchronization with the selected engine
+         * @param x CTSP decision variables
+         * @param s [out] Start times (if feasible)
+         * @param alpha [out] α certificate (if infeasible)
+         * @param beta [out] β certificate (if infeasible)
+         * @param gamma [out] γ certificate (if infeasible)
+         * @return true if synchronization is feasible
+         */
+        bool check_(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Verify synchronization, reading the certificate in place
+         * @param x CTSP decision variables
+         * @param alpha [out] View of the α certificate (if infeasible)
+         * @param gamma [out] View of the γ certificate (if infeasible)
+         * @return true if synchronization is feasible
+         *
+         * The LP engine views the checker buffers (no copy); the other
+         * engines fill alpha_ / gamma_ and view them. Views are valid until
+         * the next check.
+         */
+        bool check_(const vector<double> &x, GOMA::array_view<double> &alpha, GOMA::array_view<double> &gamma);
+
+        /**
+         * @brief Check if x is integral
+         * @param x CTSP decision variables (the dense mirror of a sparse solve)
+         *
+         * The values of a sparse x are scanned instead of every arc.
+         */
+        bool is_integral_(const vector<double> &x) const;
+
+        /**
+         * @brief Run check_() with several engines concurrently
+         * @param x CTSP decision variables
+         * @param entrants Engines to race (two or more)
+         * @param s [out] Start times of the winner (if feasible)
+         * @param alpha [out] α certificate of the winner (if infeasible)
+         * @param beta [out] β certificate of the winner (if infeasible)
+         * @param gamma [out] γ certificate of the winner (if infeasible)
+         * @return Answer of the first engine to finish with one; false with
+         *         truncated_ set if none did (deadline)
+         */
+        bool race_check_(const vector<double> &x, const vector<race_entrant> &entrants,
+                         vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma);
+
+        /**
+         * @brief Check x with one engine
+         * @param x CTSP decision variables
+         * @param entrant Engine (not NONE)
+         * @param s [out] Start times (if feasible)
+         * @param alpha [out] α certificate (if infeasible)
+         * @param beta [out] β certificate (if infeasible)
+         * @param gamma [out] γ certificate (if infeasible)
+         * @param answered [out] false if the engine was stopped (no answer)
+         * @return true if synchronization is feasible
+         */
+        bool run_entrant_(const vector<double> &x, race_entrant entrant, vector<double> &s,
+                          vector<double> &alpha, vector<double> &beta, vector<double> &gamma, bool &answered);
+
+        /**
+         * @brief Copy a sparse x into the dense mirror x_
+         * @param x Sparse solution
+         *
+         * Resets the entries of the previous sparse x and sets the new ones.
+         */
+        void load_sparse_(const sparse_x &x);
+
+        /**
+         * @brief Load the sync arc times of the builder into every engine
+         * @param builder Model builder
+         */
+        void set_sync_arc_times_(const sync_model_a_builder &builder);
+
+        /**
+         * @brief Verify synchronization with the selected engine
+         * @param x CTSP decision variables
+         * @param s [out] Start times (if feasible)
+         * @param infeasible [out] Dual certificate (if infeasible)
+         * @return true if synchronization is feasible
+         *
+         * Races the engines that apply to x with set_race.
+         */
+        bool check_(const vector<double> &x, vector<double> &s, sync_infeasible &infeasible);
+
+        /**
+         * @brief Look for pooled cycles violated by an integral x
+         * @param x CTSP decision variables
+         * @param infeasible [out] Violated pooled cycles and certificate of the first one
+         * @return true if x is proven infeasible by the pool
+         */
+        bool pool_check_(const vector<double> &x, sync_infeasible &infeasible);
+
+        /**
+         * @brief Deadline of one solve() call
+         * @return Caller's token, solve_deadline_ restarted with time_limit_,
+         *         or NULL without limit
+         */
+        const GOMA::search_deadline *start_deadline_(void);
+
+        /**
+         * @brief Detach the deadline from the checker and the path finder
+         */
+        void end_deadline_(void);
+
+        /**
+         * @brief Replace the start times of a feasible check by optimal ones
+         * @param x CTSP decision variables (feasible)
+         * @param s [in/out] Start times, changed if the objective is solved
+         */
+        void optimize_schedule_(const vector<double> &x, vector<double> &s);
+
         /**
          * @brief Normalize start times to begin from time 0
          * @param s [in/out] Start time variables (modified in place)
@@ -124,17 +687,29 @@ namespace SYNC_LIB
          *          - Depot pickup/delivery operations placed appropriately
          */
         void var_2_schedule_(const vector<double> &s, sync_scheduling &scheduling);
-        
+
+        /**
+         * @brief Rebuild the depot schedules whose start times changed
+         * @param s Start time variables for all operations
+         * @param s_prev Start times scheduling was built from
+         * @param scheduling [in/out] Schedule for each depot
+         */
+        void update_schedule_(const vector<double> &s, const vector<double> &s_prev, sync_scheduling &scheduling);
+
         /**
-         * @brief Compute customer time windows from start time variables
+         * @brief Schedule of one depot (see var_2_schedule_)
+         * @param k Depot
          * @param s Start time variables for all operations
-         * @param time_windows [out] Time windows for each customer
-         * @details For each customer, computes a time window [a, b] such that:
-         *          - All vehicle visits occur within [a, b]
-         *          - Window width (b - a) ≤ max_time_windows_size_
-         *          - Window is centered around the average visit time
+         * @param op_times_v [out] Operations of the depot with their times
+         */
+        void depot_schedule_(size_t k, const vector<double> &s, vector<operation_info> &op_times_v);
+
+        /**
+         * @brief Shared body of solve() and solve_incremental()
+         * @param incremental Update scheduling with update_schedule_
          */
-        void var_2_time_windows_(const vector<double> &s, sync_time_windows &time_windows);
+        bool solve_(const string &instance_name, const vector<double> &x, sync_scheduling &scheduling,
+                    sync_infeasible &infeasible, bool incremental);
     };
 
 }
@@ -0,0 +1,68 @@
+/**
+ * @file sync_memory.hpp
+ * @brief Bytes held by the model and search structures of a conTSP2_scheduling converter
+ *
+ * Splits the memory of a run by structure (memory_usage.hpp), to find the
+ * one to blame when a large instance runs out of memory. The structure
+ * sizes are read on demand; the separation peaks are tracked with
+ * USE_STATS (CMake option, on by default) and read 0 without it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_memory
+     * @brief Heap bytes per structure, and process resident set (bytes)
+     *
+     * conTSP2_scheduling::get_memory fills every field except rss_after_build
+     * and peak_rss, which belong to the caller (the ctsp_scheduler --memory
+     * option sets them). The LP backends do not expose their memory: it is
+     * part of the process figures only.
+     */
+    class sync_memory
+    {
+    public:
+        // Model (after the build)
+        size_t model;      ///< sync_model_a_builder arrays, pair maps and snapshot included
+        size_t pair_maps;  ///< Routing and sync arc pair maps
+
+        // Full LP checker (model_description loaded into the backend)
+        size_t lp_model;   ///< Model description of the checker LP (released after the load)
+        size_t lp_matrix;  ///< Its constraint matrix (M_)
+
+        // Violated cycle search
+        size_t path_finder;   ///< Path finder now (support graph, signatures, support arrays)
+        size_t support_succ;  ///< Support graph adjacency lists (succ_list) now
+        size_t dfs_stack;     ///< Pre-allocated DFS stack of the support graph (node_info_stack)
+
+        // Separation peaks (USE_STATS)
+        size_t peak_search;  ///< Largest adjacency lists + search workspaces + signatures of a cycle search
+        size_t peak_cycles;  ///< Largest set of violated cycles returned by a check
+
+        // Caller
+        size_t rss_after_build; ///< Process resident set after the model build
+        size_t peak_rss;        ///< Largest process resident set of the run
+
+        sync_memory(void);
+
+        virtual ~sync_memory(void);
+
+        /**
+         * @brief Reset every field to 0
+         */
+        void clear(void);
+
+        /**
+         * @brief Write the fields as one JSON object (keys as the field names)
+         * @param os Output stream
+         */
+        void write_json(ostream &os) const;
+    };
+}
@@ -0,0 +1,79 @@
+/**
+ * @file sync_stats.hpp
+ * @brief Work counters and timers of a conTSP2_scheduling converter
+ *
+ * Gathers the counters of the LP checker, the path finder and the search
+ * graph (stats_timer.hpp) in one object, to follow latency and work per
+ * check across runs. The counters are compiled in with USE_STATS (CMake
+ * option, on by default); without it every field stays 0.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+namespace SYNC_LIB
+{
+    /**
+     * @class sync_stats
+     * @brief Totals of a converter since its construction (seconds for times)
+     *
+     * conTSP2_scheduling::get_stats fills every field except
+     * model_build_time and output_time, which belong to the caller (the
+     * ctsp_scheduler --stats option sets them).
+     */
+    class sync_stats
+    {
+    public:
+        // conTSP2_scheduling::solve
+        size_t n_checks;    ///< solve() calls
+        size_t n_feasible;  ///< Feasible ones
+        size_t n_truncated; ///< Stopped by the deadline (set_time_limit / set_deadline)
+        double check_time;  ///< Seconds in the synchronization checks (pool, engines)
+
+        // Full LP checker (component LPs not included)
+        size_t n_lp_solves;   ///< LP solves
+        size_t lp_iterations; ///< Simplex iterations of those solves
+        double lp_time;       ///< Seconds in the LP solver
+        size_t coef_nz;       ///< Matrix coefficients changed (set_coef)
+        size_t obj_nz;        ///< Objective coefficients changed (set_obj)
+
+        // Violated cycle search of infeasible checks
+        size_t n_cycle_searches; ///< path_finder::find_paths calls
+        size_t support_arcs;     ///< Support graph arcs, summed over the searches
+        size_t dfs_nodes;        ///< Search nodes expanded
+        size_t cycles_found;     ///< Cycles checked for duplicates
+        size_t cycles_new;       ///< Cycles with a new routing arc set
+        size_t cycles_kept;      ///< Cycles returned by solve()
+        double cycle_time;       ///< Seconds in the cycle searches (both finders)
+
+        // Caller
+        double model_build_time; ///< Seconds to build or load the model
+        double output_time;      ///< Seconds to write the results
+
+        sync_stats(void);
+
+        virtual ~sync_stats(void);
+
+        /**
+         * @brief Reset every field to 0
+         */
+        void clear(void);
+
+        /**
+         * @brief Add the totals of another converter (converters of one run,
+         *        such as the workers of a pipelined batch)
+         * @param stats Totals to add (caller fields included)
+         */
+        void add(const sync_stats &stats);
+
+        /**
+         * @brief Write the fields as one JSON object (keys as the field names)
+         * @param os Output stream
+         */
+        void write_json(ostream &os) const;
+    };
+}
@@ -0,0 +1,189 @@
+/**
+ * @file route_result_cache.cpp
+ * @brief Implementation of the route set result memo
+ */
+
+#include "route_result_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace SYNC_LIB
+{
+    route_result_cache::route_result_cache(const size_t capacity) : capacity_(capacity > 0 ? capacity : 1),
+                                                                     clock_(0),
+                                                                     entries_(),
+                                                                     index_(),
+                                                                     n_lookups_(0),
+                                                                     n_hits_(0),
+                                                                     n_evictions_(0)
+    {
+    }
+
+    route_result_cache::~route_result_cache(void)
+    {
+    }
+
+    void route_result_cache::clear(void)
+    {
+        entries_.clear();
+        index_.clear();
+
+        clock_ = 0;
+        n_lookups_ = 0;
+        n_hits_ = 0;
+        n_evictions_ = 0;
+    }
+
+    size_t route_result_cache::key(const vector<vector<int>> &routes)
+    {
+        // boost::hash_combine mixing step, as active_set_hash
+        size_t seed{routes.size()};
+
+        for (const vector<int> &route : routes)
+        {
+            size_t route_seed{route.size()};
+
+            for (const int node : route)
+                route_seed ^= hash<int>()(node) + 0x9e3779b9 + (route_seed << 6) + (route_seed >> 2);
+
+            seed ^= route_seed + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        return seed;
+    }
+
+    bool route_result_cache::same_routes_(const cached_result &entry, const vector<vector<int>> &routes)
+    {
+        if (entry.routes_.size() != routes.size())
+            return false;
+
+        for (size_t k{0}; k < routes.size(); k++)
+        {
+            const GOMA::array_view<int> route{entry.routes_[k]};
+
+            if (route.size() != routes[k].size() || !equal(route.begin(), route.end(), routes[k].begin()))
+                return false;
+        }
+
+        return true;
+    }
+
+    const cached_result *route_result_cache::find(const size_t key, const vector<vector<int>> &routes)
+    {
+        n_lookups_++;
+        clock_++;
+
+        const auto it{index_.find(key)};
+
+        if (it == index_.end())
+            return nullptr;
+
+        cached_result &entry{entries_[it->second]};
+
+        if (!same_routes_(entry, routes))
+            return nullptr;
+
+        entry.last_use_ = clock_;
+        n_hits_++;
+
+        return &entry;
+    }
+
+    void route_result_cache::store(const size_t key, const vector<vector<int>> &routes, const bool feasible,
+                                   const vector<double> &x, const sync_scheduling &schedule,
+                                   const vector<double> &alpha, const vector<double> &beta,
+                                   const vector<double> &gamma, const cycle_list &cycles)
+    {
+        clock_++;
+
+        size_t k{entries_.size()};
+
+        const auto it{index_.find(key)};
+
+        if (it != index_.end())
+        {
+            k = it->second;
+        }
+        else if (entries_.size() < capacity_)
+        {
+            entries_.push_back(cached_result());
+            index_.emplace(key, k);
+        }
+        else
+        {
+            // Evict the least recently used entry
+            k = 0;
+
+            for (size_t l{1}; l < entries_.size(); l++)
+            {
+                if (entries_[l].last_use_ < entries_[k].last_use_)
+                    k = l;
+            }
+
+            index_.erase(entries_[k].key_);
+            index_.emplace(key, k);
+
+            n_evictions_++;
+        }
+
+        // Assignments reuse the buffers of the entry replaced
+        cached_result &entry{entries_[k]};
+
+        entry.key_ = key;
+        entry.feasible_ = feasible;
+        entry.last_use_ = clock_;
+
+        entry.routes_.clear();
+
+        for (const vector<int> &route : routes)
+            entry.routes_.push_back(route);
+
+        entry.support_.clear();
+
+        for (size_t i{0}; i < x.size(); i++)
+        {
+            if (x[i] > 0.5)
+                entry.support_.push_back((int)i);
+        }
+
+        entry.n_arcs_ = x.size();
+
+        entry.schedule_.clear();
+        entry.alpha_.clear();
+        entry.beta_.clear();
+        entry.gamma_.clear();
+        entry.cycles_.clear();
+
+        if (feasible)
+        {
+            entry.schedule_ = schedule;
+        }
+        else
+        {
+            entry.alpha_ = alpha;
+            entry.beta_ = beta;
+            entry.gamma_ = gamma;
+            entry.cycles_.append(cycles);
+        }
+    }
+
+    size_t route_result_cache::get_memory_bytes(void) const
+    {
+        size_t bytes{entries_.capacity() * sizeof(cached_result)};
+
+        for (const cached_result &entry : entries_)
+        {
+            bytes += entry.routes_.get_memory_bytes() + entry.support_.capacity() * sizeof(int) +
+                     (entry.alpha_.capacity() + entry.beta_.capacity() + entry.gamma_.capacity()) * sizeof(double) +
+                     entry.cycles_.get_memory_bytes();
+
+            bytes += entry.schedule_.capacity() * sizeof(vector<operation_info>);
+
+            for (const vector<operation_info> &route : entry.schedule_)
+                bytes += route.capacity() * sizeof(operation_info);
+        }
+
+        return bytes + index_.size() * (sizeof(size_t) * 2 + sizeof(void *));
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @file scheduling_session.cpp
+ * @brief Implementation of the in-process scheduling session
+ */
+
+#include "scheduling_session.hpp"
+
+#include <stdexcept>
+
+namespace SYNC_LIB
+{
+    scheduling_session::scheduling_session(unique_ptr<sync_model_a_builder> builder, const double tol, const sync_engine engine)
+        : owned_builder_(move(builder)),
+          builder_(*owned_builder_),
+          scheduler_(builder_, tol, engine),
+          solution_interface_(),
+          solution_(builder_.get_instance_name(), vector<vector<int>>()),
+          x_(),
+          sx_(),
+          x_sparse_(false),
+          schedule_(builder_.get_instance_name()),
+          infeasible_(x_, builder_),
+          result_cache_(),
+          n_checks_(0),
+          n_feasible_(0)
+    {
+        solution_interface_.set(builder_);
+
+        scheduler_.set_verbose(false);
+    }
+
+    scheduling_session::scheduling_session(const sync_model_a_builder &builder, const double tol, const sync_engine engine)
+        : owned_builder_(),
+          builder_(builder),
+          scheduler_(builder_, tol, engine),
+          solution_interface_(),
+          solution_(builder_.get_instance_name(), vector<vector<int>>()),
+          x_(),
+          sx_(),
+          x_sparse_(false),
+          schedule_(builder_.get_instance_name()),
+          infeasible_(x_, builder_),
+          result_cache_(),
+          n_checks_(0),
+          n_feasible_(0)
+    {
+        solution_interface_.set(builder_);
+
+        scheduler_.set_verbose(false);
+    }
+
+    scheduling_session::~scheduling_session(void)
+    {
+    }
+
+    bool scheduling_session::check(const vector<vector<int>> &routes)
+    {
+        solution_interface_.validate_routes(routes);
+
+        size_t key{0};
+
+        if (result_cache_)
+        {
+            key = route_result_cache::key(routes);
+
+            const cached_result *entry{result_cache_->find(key, routes)};
+
+            if (entry != nullptr)
+                return restore_(*entry);
+        }
+
+        // Element-wise assignment keeps the capacity of the previous routes
+        solution_.get_routes() = routes;
+
+        // x_ was zero outside sx_: reset those entries only
+        const bool zero{x_sparse_};
+
+        if (x_sparse_)
+            sx_.unscatter(x_);
+
+        x_sparse_ = false;
+
+        if (!solution_interface_.sync_solution_2_model_a(solution_, sx_))
+            throw std::invalid_argument("scheduling_session: routes use arcs pruned from the model");
+
+        if (!zero || x_.size() != sx_.get_n())
+            x_.assign(sx_.get_n(), 0.0);
+
+        sx_.scatter(x_);
+        x_sparse_ = true;
+
+        const bool feasible{solve_(&sx_)};
+
+        // An answer cut short by a deadline is not final
+        if (result_cache_ && !infeasible_.truncated())
+            result_cache_->store(key, routes, feasible, x_, schedule_, infeasible_.alpha(), infeasible_.beta(),
+                                 infeasible_.gamma(), infeasible_.violated_cycles());
+
+        return feasible;
+    }
+
+    void scheduling_session::set_result_cache(const size_t capacity)
+    {
+        if (capacity == 0)
+            result_cache_.reset();
+        else
+            result_cache_.reset(new route_result_cache(capacity));
+    }
+
+    bool scheduling_session::restore_(const cached_result &entry)
+    {
+        x_.assign(entry.n_arcs_, 0.0);
+        x_sparse_ = false;
+
+        for (const int arc : entry.support_)
+            x_[arc] = 1.0;
+
+        infeasible_.violated_cycles().clear();
+        infeasible_.set_truncated(false);
+
+        if (entry.feasible_)
+        {
+            // Not built by the scheduler: its next check rebuilds every depot
+            schedule_ = entry.schedule_;
+            scheduler_.forget_schedule();
+        }
+        else
+        {
+            infeasible_.alpha() = entry.alpha_;
+            infeasible_.beta() = entry.beta_;
+            infeasible_.gamma() = entry.gamma_;
+            infeasible_.violated_cycles().append(entry.cycles_);
+        }
+
+        n_checks_++;
+
+        if (entry.feasible_)
+            n_feasible_++;
+
+        return entry.feasible_;
+    }
+
+    bool scheduling_session::check_x(const vector<double> &x)
+    {
+        x_ = x;
+        x_sparse_ = false;
+
+        return solve_(NULL);
+    }
+
+    bool scheduling_session::solve_(const sparse_x *x)
+    {
+        // infeasible_ reads x_ (held by reference)
+        infeasible_.violated_cycles().clear();
+
+        // schedule_ holds the last schedule: unchanged depots are kept
+        const bool feasible{x != NULL ? scheduler_.solve_incremental(builder_.get_instance_name(), *x, schedule_, infeasible_)
+                                      : scheduler_.solve_incremental(builder_.get_instance_name(), x_, schedule_, infeasible_)};
+
+        n_checks_++;
+
+        if (feasible)
+            n_feasible_++;
+
+        return feasible;
+    }
+}
@@ -6,34 +6,188 @@
 #include "sol_2_scheduling.hpp"
 
 #include "ctsp_lb_primal_model.hpp"
+#include "stats_timer.hpp"
+#include "trace_recorder.hpp"
+#include "memory_usage.hpp"
 
 #include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+
+#define INF_MD_THRLD 1E6
 
 namespace SYNC_LIB
 {
-    conTSP2_scheduling::conTSP2_scheduling(const sync_model_a_builder &builder, double tol)
+    conTSP2_scheduling::conTSP2_scheduling(const sync_model_a_builder &builder, double tol, sync_engine engine)
         : checker_(builder, tol),
+          difference_checker_(builder, tol),
+          component_checker_(builder, tol),
           path_finder_(builder),
+          mean_cycle_finder_(builder),
+          cycle_search_(cycle_search::PATHS),
+          cycle_shrinker_(builder),
+          minimal_cycles_(false),
+          cut_pool_(NULL),
+          engine_(engine),
+          decompose_(false),
+          race_(false),
+          feasibility_only_(false),
+          verbose_(true),
+          objective_(schedule_objective::FEASIBLE),
+          objective_weights_(),
+          deadline_(NULL),
+          solve_deadline_(),
+          time_limit_(0),
+          truncated_(false),
           n_depots_(builder.get_n_depots()),
           n_customers_(builder.get_n_customers()),
           n_operations_(builder.get_n_operations()),
           max_time_windows_size_(builder.get_time_windows_max_size()),
           max_distance_(builder.get_max_distance()),
-          operation_2_depot_(builder.get_operation_2_depot()),
-          operation_2_customer_(builder.get_operation_2_customer()),
-          arc_time_matrix_(builder.get_arc_time_matrix()),
-          operation_names_(builder.get_operation_names())
+          model_(builder.get_snapshot()),
+          operation_2_depot_(model_->get_operation_2_depot()),
+          operation_2_customer_(model_->get_operation_2_customer()),
+          builder_(builder),
+          operation_names_(model_->get_operation_names()),
+          depot_ops_head_(n_depots_ + 1, 0),
+          depot_ops_(),
+          schedule_s_(),
+          n_depots_rebuilt_(0),
+          n_depots_reused_(0),
+          sparse_(NULL),
+          x_(),
+          x_support_(),
+          s_(),
+          alpha_(),
+          beta_(),
+          gamma_(),
+          race_lanes_(3),
+          race_token_(),
+          race_winner_(race_entrant::NONE),
+          n_race_wins_(3, 0),
+          n_checks_(0),
+          n_feasible_(0),
+          n_truncated_(0),
+          n_cycles_kept_(0),
+          check_time_(0),
+          cycle_time_(0),
+          peak_cycle_bytes_(0)
     {
+        // Operations of each depot, in increasing order
+        depot_ops_.resize(n_operations_);
+
+        for (size_t i{0}; i < n_operations_; ++i)
+            depot_ops_head_[operation_2_depot_[i] + 1]++;
+
+        for (size_t k{0}; k < n_depots_; ++k)
+            depot_ops_head_[k + 1] += depot_ops_head_[k];
+
+        vector<int> next_depot(depot_ops_head_.begin(), depot_ops_head_.end() - 1);
+
+        for (size_t i{0}; i < n_operations_; ++i)
+            depot_ops_[next_depot[operation_2_depot_[i]]++] = (int)i;
     }
 
     conTSP2_scheduling::~conTSP2_scheduling(void)
     {
     }
 
+    void conTSP2_scheduling::set_schedule_objective(const schedule_objective objective)
+    {
+        objective_ = objective;
+
+        if (objective == schedule_objective::MIN_IDLE)
+        {
+            // Route durations; the travel times are a constant of the routing
+            objective_weights_.assign(n_operations_, 0.0);
+
+            for (size_t k{0}; k < n_depots_; ++k)
+            {
+                objective_weights_[k] = -1.0;
+                objective_weights_[n_depots_ + k] = 1.0;
+            }
+        }
+    }
+
+    void conTSP2_scheduling::set_schedule_weights(const vector<double> &weights)
+    {
+        double sum{0.0};
+        double scale{1.0};
+
+        for (const double w : weights)
+        {
+            sum += w;
+            scale = max(scale, fabs(w));
+        }
+
+        if (weights.size() != n_operations_ || fabs(sum) > 1E-9 * scale * (double)n_operations_)
+            throw std::invalid_argument("conTSP2_scheduling: schedule weights need one entry per operation and sum 0");
+
+        objective_weights_ = weights;
+        objective_ = schedule_objective::WEIGHTED;
+    }
+
     bool conTSP2_scheduling::solve(const string &instance_name, const vector<double> &x,
                                    sync_scheduling &scheduling, sync_infeasible &infeasible)
+    {
+        return solve_(instance_name, x, scheduling, infeasible, false);
+    }
+
+    bool conTSP2_scheduling::solve_incremental(const string &instance_name, const vector<double> &x,
+                                               sync_scheduling &scheduling, sync_infeasible &infeasible)
+    {
+        return solve_(instance_name, x, scheduling, infeasible, true);
+    }
+
+    bool conTSP2_scheduling::solve(const string &instance_name, const sparse_x &x,
+                                   sync_scheduling &scheduling, sync_infeasible &infeasible)
+    {
+        load_sparse_(x);
+
+        sparse_ = &x;
+        const bool feasible{solve_(instance_name, x_, scheduling, infeasible, false)};
+        sparse_ = NULL;
+
+        return feasible;
+    }
+
+    bool conTSP2_scheduling::solve_incremental(const string &instance_name, const sparse_x &x,
+                                               sync_scheduling &scheduling, sync_infeasible &infeasible)
+    {
+        load_sparse_(x);
+
+        sparse_ = &x;
+        const bool feasible{solve_(instance_name, x_, scheduling, infeasible, true)};
+        sparse_ = NULL;
+
+        return feasible;
+    }
+
+    void conTSP2_scheduling::load_sparse_(const sparse_x &x)
+    {
+        // Reset only the entries of the previous x when the size is unchanged
+        if (x_.size() == x.get_n() && x_support_.get_n() == x.get_n())
+            x_support_.unscatter(x_);
+        else
+            x_.assign(x.get_n(), 0.0);
+
+        x.scatter(x_);
+        x_support_ = x;
+    }
+
+    bool conTSP2_scheduling::is_integral_(const vector<double> &x) const
+    {
+        return sparse_ != NULL ? difference_checker_.is_integral(*sparse_) : difference_checker_.is_integral(x);
+    }
+
+    bool conTSP2_scheduling::solve_(const string &instance_name, const vector<double> &x,
+                                    sync_scheduling &scheduling, sync_infeasible &infeasible,
+                                    const bool incremental)
     {
         // Set the instance name in the output
         scheduling.instance_name_ = instance_name;
@@ -42,196 +196,675 @@ namespace SYNC_LIB
         // Initialize start time variables
         vector<double> s(n_operations_, 0.0);
 
-        // Verify synchronization constraints and compute start times
-        // The checker solves an LP to find feasible start times if they exist
-        const bool is_feasible = checker_.is_feasible(x, s, infeasible.alpha(), infeasible.beta(), infeasible.gamma());
+        GOMA_STATS(n_checks_++);
+        GOMA::trace_scope trace("check", "converter");
+
+        // The deadline bounds this call only (not the differential sweeps)
+        const GOMA::search_deadline *deadline{start_deadline_()};
+
+        checker_.set_deadline(deadline);
+        path_finder_.set_deadline(deadline);
+
+        truncated_ = false;
+        infeasible.set_truncated(false);
+
+        bool pooled{false};
+        bool is_feasible{false};
+
+        {
+            GOMA::stats_timer timer(check_time_);
+
+            // Pooled cycles give a cheap infeasibility proof for integral x
+            {
+                GOMA::trace_scope trace_pool("pool_check", "converter");
+                pooled = pool_check_(x, infeasible);
+            }
+
+            // Verify synchronization constraints and compute start times
+            if (!pooled)
+            {
+                GOMA::trace_scope trace_check("sync_check", "converter");
+                is_feasible = check_(x, s, infeasible);
+            }
+        }
+
+        if (pooled)
+        {
+            GOMA_STATS(n_cycles_kept_ += infeasible.violated_cycles().size());
+            GOMA_STATS(peak_cycle_bytes_ = max(peak_cycle_bytes_, infeasible.violated_cycles().get_memory_bytes()));
+
+            if (verbose_)
+                cout << "Solution is infeasible in synchronization constraints." << endl;
+
+            end_deadline_();
+
+            return false;
+        }
+
         if (is_feasible)
         {
+            GOMA_STATS(n_feasible_++);
+
+            if (objective_ != schedule_objective::FEASIBLE)
+                optimize_schedule_(x, s);
+
             // Normalize start times to begin from t=0
             refine_solution_(s);
 
             // Convert start times to depot schedules
-            var_2_schedule_(s, scheduling);
+            if (incremental && schedule_s_.size() == n_operations_ && scheduling.size() == n_depots_)
+                update_schedule_(s, schedule_s_, scheduling);
+            else
+                var_2_schedule_(s, scheduling);
+
+            schedule_s_.swap(s);
+        }
+        else if (truncated_)
+        {
+            // No answer: neither start times nor a certificate to search
+            GOMA_STATS(n_truncated_++);
+
+            infeasible.set_truncated(true);
+
+            if (verbose_)
+                cout << "Synchronization check stopped by the deadline." << endl;
         }
         else
         {
-            vector<vector<int>> &cycles = infeasible.violated_cycles();
+            cycle_list &cycles = infeasible.violated_cycles();
 
-            path_finder_.find_paths(infeasible.alpha(), infeasible.beta(), infeasible.gamma(), cycles);
-            cout << "Solution is infeasible in synchronization constraints." << endl;
+            {
+                GOMA::stats_timer timer(cycle_time_);
+                GOMA::trace_scope trace_cycles("cycle_search", "converter");
+
+                // Polynomial search first; the certificate support is the fallback
+                if (cycle_search_ == cycle_search::MIN_MEAN)
+                    mean_cycle_finder_.find_cycles(x, cycles);
+
+                if (cycles.empty())
+                {
+                    // A sparse x bounds the routing arcs the certificate can use
+                    path_finder_.find_paths(infeasible.alpha(), infeasible.beta(), infeasible.gamma(), cycles,
+                                            sparse_ != NULL ? &sparse_->get_indices() : NULL);
+
+                    // The cycles found before the deadline are returned
+                    truncated_ = path_finder_.is_truncated();
+                }
+
+                // Minimal, deduplicated cuts only
+                if (minimal_cycles_)
+                {
+                    GOMA::trace_scope trace_shrink("cycle_shrink", "converter");
+                    cycle_shrinker_.shrink(cycles);
+                }
+            }
+
+            if (truncated_)
+            {
+                GOMA_STATS(n_truncated_++);
+                infeasible.set_truncated(true);
+            }
+
+            GOMA_STATS(n_cycles_kept_ += cycles.size());
+            GOMA_STATS(peak_cycle_bytes_ = max(peak_cycle_bytes_, cycles.get_memory_bytes()));
+
+            if (cut_pool_ != NULL)
+                cut_pool_->add(cycles);
+
+            if (verbose_)
+                cout << "Solution is infeasible in synchronization constraints."
+                     << (truncated_ ? " Cycle search stopped by the deadline." : "") << endl;
         }
 
+        end_deadline_();
+
         return is_feasible;
     }
 
-    void conTSP2_scheduling::refine_solution_(vector<double> &s)
+    const GOMA::search_deadline *conTSP2_scheduling::start_deadline_(void)
     {
-        // Find the minimum start time among all depot operations (first n_depots operations)
-        double s_min{0.0};
+        if (deadline_ != NULL)
+            return deadline_;
 
-        for (size_t k{0}; k < n_depots_; ++k)
+        if (time_limit_ <= 0)
+            return NULL;
+
+        solve_deadline_.set_time_limit(time_limit_);
+
+        return &solve_deadline_;
+    }
+
+    void conTSP2_scheduling::end_deadline_(void)
+    {
+        checker_.set_deadline(NULL);
+        path_finder_.set_deadline(NULL);
+    }
+
+    sync_stats conTSP2_scheduling::get_stats(void) const
+    {
+        sync_stats stats;
+
+        stats.n_checks = n_checks_;
+        stats.n_feasible = n_feasible_;
+        stats.n_truncated = n_truncated_;
+        stats.check_time = check_time_;
+
+        stats.n_lp_solves = checker_.get_n_solves();
+        stats.lp_iterations = checker_.get_n_iterations();
+        stats.lp_time = checker_.get_solve_time();
+        stats.coef_nz = checker_.get_n_coef_nz();
+        stats.obj_nz = checker_.get_n_obj_nz();
+
+        stats.n_cycle_searches = path_finder_.get_n_calls();
+        stats.support_arcs = path_finder_.get_n_support_arcs_total();
+        stats.dfs_nodes = path_finder_.get_n_dfs_nodes();
+        stats.cycles_found = path_finder_.get_n_cycles_found();
+        stats.cycles_new = path_finder_.get_n_cycles_new();
+        stats.cycles_kept = n_cycles_kept_;
+        stats.cycle_time = cycle_time_;
+
+        return stats;
+    }
+
+    sync_memory conTSP2_scheduling::get_memory(void) const
+    {
+        sync_memory memory;
+
+        memory.model = builder_.get_memory_bytes();
+        memory.pair_maps = builder_.get_pair_map_bytes();
+
+        memory.lp_model = checker_.get_model_bytes();
+        memory.lp_matrix = checker_.get_matrix_bytes();
+
+        memory.path_finder = path_finder_.get_memory_bytes();
+        memory.support_succ = path_finder_.get_support_succ_bytes();
+        memory.dfs_stack = path_finder_.get_support_stack_bytes();
+
+        memory.peak_search = path_finder_.get_peak_search_bytes();
+        memory.peak_cycles = peak_cycle_bytes_;
+
+        return memory;
+    }
+
+    bool conTSP2_scheduling::check_(const vector<double> &x, vector<double> &s, sync_infeasible &infeasible)
+    {
+        // Every engine that applies to x, the one on the calling thread first
+        if (race_)
         {
-            if (s_min > s[k])
-            {
-                s_min = s[k];
-            }
+            vector<race_entrant> entrants;
+
+            if (is_integral_(x))
+                entrants.push_back(race_entrant::DIFFERENCE);
+
+            entrants.push_back(race_entrant::LP);
+
+            if (decompose_)
+                entrants.push_back(race_entrant::COMPONENTS);
+
+            if (entrants.size() > 1)
+                return race_check_(x, entrants, s, infeasible.alpha(), infeasible.beta(), infeasible.gamma());
         }
 
-        // Shift all start times so that the earliest depot operation starts at t=0
-        // This normalization doesn't affect feasibility since all temporal differences are preserved
-        for (size_t i{0}; i < n_operations_; ++i)
+        return check_(x, s, infeasible.alpha(), infeasible.beta(), infeasible.gamma());
+    }
+
+    bool conTSP2_scheduling::check_(const vector<double> &x, vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        // The difference engine is exact for integral routings only
+        if (engine_ == sync_engine::DIFFERENCE && is_integral_(x))
         {
-            s[i] -= s_min;
+            race_winner_ = race_entrant::DIFFERENCE;
+            return difference_checker_.is_feasible(x, s, alpha, beta, gamma);
+        }
+
+        // Small independent LPs, stitched back into s (or alpha/gamma)
+        if (decompose_)
+        {
+            race_winner_ = race_entrant::COMPONENTS;
+            return component_checker_.is_feasible(x, s, alpha, beta, gamma);
         }
+
+        // The checker solves an LP to find feasible start times if they exist
+        const bool feasible{sparse_ != NULL ? checker_.is_feasible(*sparse_, s, alpha, beta, gamma)
+                                            : checker_.is_feasible(x, s, alpha, beta, gamma)};
+
+        truncated_ = checker_.is_truncated();
+        race_winner_ = truncated_ ? race_entrant::NONE : race_entrant::LP;
+
+        return feasible;
     }
 
-    void conTSP2_scheduling::var_2_schedule_(const vector<double> &s, sync_scheduling &scheduling)
+    bool conTSP2_scheduling::run_entrant_(const vector<double> &x, const race_entrant entrant, vector<double> &s,
+                                          vector<double> &alpha, vector<double> &beta, vector<double> &gamma, bool &answered)
     {
-        // Initialize scheduling structure with one list per depot
-        scheduling.resize(n_depots_);
-
-        for (size_t k{0}; k < n_depots_; ++k)
+        switch (entrant)
+        {
+        case race_entrant::DIFFERENCE:
         {
-            scheduling[k].clear();
+            GOMA::trace_scope trace("race_difference", "converter");
+
+            answered = true;
+            return difference_checker_.is_feasible(x, s, alpha, beta, gamma);
         }
+        case race_entrant::COMPONENTS:
+        {
+            GOMA::trace_scope trace("race_components", "converter");
 
-        // Assign each operation to its depot with initial timing (arrival=0, start=s[i])
-        for (size_t i{0}; i < n_operations_; ++i)
+            const bool feasible{component_checker_.is_feasible(x, s, alpha, beta, gamma)};
+
+            answered = !component_checker_.is_truncated();
+            return feasible;
+        }
+        default:
         {
-            const int depot_i{operation_2_depot_[i]};
-            scheduling[depot_i].push_back(operation_info(i, operation_times(0, s[i])));
+            GOMA::trace_scope trace("race_lp", "converter");
+
+            const bool feasible{sparse_ != NULL ? checker_.is_feasible(*sparse_, s, alpha, beta, gamma)
+                                                : checker_.is_feasible(x, s, alpha, beta, gamma)};
+
+            answered = !checker_.is_truncated();
+            return feasible;
         }
+        }
+    }
 
-        // For each depot, sort operations by start time and ensure depot pickup is last
-        for (size_t k{0}; k < n_depots_; ++k)
+    bool conTSP2_scheduling::race_check_(const vector<double> &x, const vector<race_entrant> &entrants,
+                                         vector<double> &s, vector<double> &alpha, vector<double> &beta, vector<double> &gamma)
+    {
+        // Deadline of this solve(): the LP keeps it, the race token inherits it
+        const GOMA::search_deadline *deadline{deadline_ != NULL ? deadline_ : time_limit_ > 0 ? &solve_deadline_ : NULL};
+
+        race_token_.set_time_limit(deadline != NULL && deadline->is_limited() ? max(deadline->remaining(), 1E-9) : 0);
+
+        if (deadline != NULL && deadline->expired())
+            race_token_.cancel();
+
+        component_checker_.set_deadline(&race_token_);
+
+        atomic<int> winner{-1};
+
+        const auto run = [&](const race_entrant entrant)
         {
-            vector<operation_info> &op_times_v{scheduling[k]};
+            race_lane &lane{race_lanes_[(size_t)entrant]};
+
+            lane.s.resize(s.size());
+            lane.alpha.resize(alpha.size());
+            lane.beta.resize(beta.size());
+            lane.gamma.resize(gamma.size());
 
-            // Sort operations by start time (ascending)
-            sort(op_times_v.begin(), op_times_v.end(),
-                 [](const operation_info &a, const operation_info &b)
-                 {
-                     return a.second.second < b.second.second;
-                 });
+            bool answered{false};
+            lane.feasible = run_entrant_(x, entrant, lane.s, lane.alpha, lane.beta, lane.gamma, answered);
 
-            // Find and move depot pickup to the last position
-            // Depot pickups have IDs in range [n_depots, 2*n_depots)
+            // The first answer stops the others
+            int none{-1};
+
+            if (answered && winner.compare_exchange_strong(none, (int)entrant))
             {
-                const size_t n_ops_k{op_times_v.size()};
+                race_token_.cancel();
+
+                if (entrant != race_entrant::LP)
+                    checker_.set_interrupt(true);
+            }
+            else if (!answered && deadline != NULL && deadline->expired())
+                race_token_.cancel(); // Caller's token cancelled during the race
+        };
 
-                size_t delivery_pos{0};
+        // The difference engine cannot be stopped: it runs here, after the others are started
+        vector<thread> runners;
 
-                for (size_t i{0}; i < n_ops_k; ++i)
-                {
-                    const int op_i{op_times_v[i].first};
+        for (size_t e{1}; e < entrants.size(); e++)
+            runners.emplace_back(run, entrants[e]);
 
-                    if ((op_i >= (int)n_depots_) && (op_i < (int)(2 * n_depots_)))
-                    {
-                        delivery_pos = i;
-                        break;
-                    }
-                }
+        run(entrants[0]);
 
-                // Swap depot pickup with the last position
-                if (delivery_pos < n_ops_k - 1)
-                {
-                    std::swap(op_times_v[delivery_pos], op_times_v[n_ops_k - 1]);
-                }
-            }
+        for (thread &runner : runners)
+            runner.join();
+
+        checker_.set_interrupt(false);
+        component_checker_.set_deadline(NULL);
+
+        // No answer (deadline): the LP reports it with an all-zero certificate
+        const int w{winner.load()};
+
+        race_winner_ = w < 0 ? race_entrant::NONE : (race_entrant)w;
+        truncated_ = w < 0;
+
+        race_lane &lane{race_lanes_[(size_t)(w < 0 ? race_entrant::LP : race_winner_)]};
+
+        s.swap(lane.s);
+        alpha.swap(lane.alpha);
+        beta.swap(lane.beta);
+        gamma.swap(lane.gamma);
+
+        GOMA_STATS(if (w >= 0) n_race_wins_[w]++);
+
+        return w >= 0 && lane.feasible;
+    }
+
+    bool conTSP2_scheduling::check_(const vector<double> &x, GOMA::array_view<double> &alpha, GOMA::array_view<double> &gamma)
+    {
+        if ((engine_ == sync_engine::DIFFERENCE && difference_checker_.is_integral(x)) || decompose_)
+        {
+            const bool feasible{check_(x, s_, alpha_, beta_, gamma_)};
+
+            alpha = GOMA::array_view<double>(alpha_);
+            gamma = GOMA::array_view<double>(gamma_);
+
+            return feasible;
         }
 
-        // Compute actual arrival times based on travel times between consecutive operations
-        for (size_t k{0}; k < n_depots_; ++k)
+        GOMA::array_view<double> s;
+        GOMA::array_view<double> beta;
+
+        return checker_.is_feasible(x, s, alpha, beta, gamma);
+    }
+
+    void conTSP2_scheduling::update_sync_arc_times(const sync_model_a_builder &builder)
+    {
+        // Cycles violated for a width may be feasible for a larger one
+        if (cut_pool_ != NULL && builder.get_time_windows_max_size() > max_time_windows_size_)
+            cut_pool_->clear();
+
+        set_sync_arc_times_(builder);
+    }
+
+    void conTSP2_scheduling::set_sync_arc_times_(const sync_model_a_builder &builder)
+    {
+        max_time_windows_size_ = builder.get_time_windows_max_size();
+
+        // The component checker and the path finder read the builder times
+        checker_.update_sync_arc_times(builder);
+        difference_checker_.update_sync_arc_times(builder);
+    }
+
+    void conTSP2_scheduling::sweep_time_windows_max_size(sync_model_a_builder &builder, const vector<double> &x, const vector<double> &values, vector<bool> &feasible)
+    {
+        const double initial_size{builder.get_time_windows_max_size()};
+        const bool feasibility_only{feasibility_only_};
+
+        // Only the answers are reported
+        set_feasibility_only(true);
+
+        const size_t n_values{values.size()};
+        feasible.resize(n_values);
+
+        GOMA::array_view<double> alpha;
+        GOMA::array_view<double> gamma;
+
+        for (size_t i{0}; i < n_values; i++)
         {
-            vector<operation_info> &op_times_v{scheduling[k]};
+            builder.set_time_windows_max_size(values[i]);
+            set_sync_arc_times_(builder);
+
+            feasible[i] = check_(x, alpha, gamma);
+        }
+
+        set_feasibility_only(feasibility_only);
+
+        builder.set_time_windows_max_size(initial_size);
+        set_sync_arc_times_(builder);
+    }
+
+    double conTSP2_scheduling::get_min_time_windows_max_size(sync_model_a_builder &builder, const vector<double> &x, size_t &n_checks)
+    {
+        const double precision{1E3};
+        const size_t max_checks{1000};
+
+        const double initial_size{builder.get_time_windows_max_size()};
+
+        const vector<double> &routing_arc_times{builder.get_routing_arc_times()};
+        const vector<double> &sync_arc_times{builder.get_sync_arc_times()};
+
+        double size{0.0};
+        double min_size{numeric_limits<double>::infinity()};
+
+        GOMA::array_view<double> alpha;
+        GOMA::array_view<double> gamma;
 
-            const size_t n_ops_k{op_times_v.size()};
+        for (n_checks = 0; n_checks < max_checks;)
+        {
+            builder.set_time_windows_max_size(size);
+            set_sync_arc_times_(builder);
 
-            // First operation starts at time 0 (depot departure)
-            op_times_v[0].second.second = 0.0;
+            n_checks++;
 
-            // For each subsequent operation, compute arrival time
-            for (size_t i{1}; i < n_ops_k; ++i)
+            if (check_(x, alpha, gamma))
             {
-                const int op_i_prev{op_times_v[i - 1].first};
-                const int op_i_curr{op_times_v[i].first};
+                min_size = size;
+                break;
+            }
 
-                // Get travel time between consecutive operations (using 1-based indexing)
-                const double travel_time{arc_time_matrix_(op_i_prev + 1, op_i_curr + 1)};
+            // Certificate weight c + k * size, split by the customer sync arcs
+            double c{0.0};
+            double k{0.0};
 
-                // Verify temporal feasibility: current start ≥ previous start + travel time
-                assert(s[op_i_curr] >= s[op_i_prev] + travel_time - 1E-6);
+            for (size_t i{0}; i < alpha.size(); i++)
+            {
+                c -= routing_arc_times[i] * x[i] * alpha[i];
+            }
 
-                // Arrival time = previous start time + travel time
-                op_times_v[i].second.first = op_times_v[i - 1].second.second + travel_time;
+            for (size_t i{0}; i < gamma.size(); i++)
+            {
+                if (builder.is_customer_sync_arc(i))
+                    k += gamma[i];
+                else if (sync_arc_times[i] < INF_MD_THRLD)
+                    c += sync_arc_times[i] * gamma[i];
             }
+
+            // Violated for every width (e.g. a route longer than max_distance)
+            if (k < 1E-9)
+                break;
+
+            // Smallest width this cycle allows, on the checkers precision grid
+            const double next_size{ceil(-c / k * precision - 1E-6) / precision};
+
+            size = next_size > size ? next_size : size + 1.0 / precision;
         }
 
-        // Convert operation IDs to customer IDs for output format
-        for (size_t k{0}; k < n_depots_; ++k)
+        builder.set_time_windows_max_size(initial_size);
+        set_sync_arc_times_(builder);
+
+        return min_size;
+    }
+
+    bool conTSP2_scheduling::get_flexibility(const string &instance_name, const vector<double> &x,
+                                             sync_flexibility &flexibility, const double horizon)
+    {
+        if (!difference_checker_.is_integral(x))
+            throw std::invalid_argument("conTSP2_scheduling: schedule flexibility needs an integral routing");
+
+        GOMA::trace_scope trace("flexibility", "converter");
+
+        flexibility.instance_name_ = instance_name;
+        flexibility.clear();
+
+        vector<double> earliest;
+        vector<double> latest;
+
+        if (!difference_checker_.is_feasible_(x) || !difference_checker_.get_flexibility(horizon, earliest, latest))
+            return false;
+
+        flexibility.resize(n_operations_);
+
+        double completion{0.0};
+
+        for (size_t i{0}; i < n_operations_; ++i)
+        {
+            flexibility[i] = tw_info(earliest[i], latest[i]);
+            completion = max(completion, earliest[i]);
+        }
+
+        flexibility.horizon_ = horizon < 0.0 ? completion : horizon;
+        flexibility.operation_names_ = operation_names_;
+
+        return true;
+    }
+
+    bool conTSP2_scheduling::pool_check_(const vector<double> &x, sync_infeasible &infeasible)
+    {
+        // A violated cut proves infeasibility only if every arc of the cycle is used
+        if (cut_pool_ == NULL || cut_pool_->empty() || !is_integral_(x))
+            return false;
+
+        cycle_list &cycles = infeasible.violated_cycles();
+
+        if (cut_pool_->separate(x, cycles) == 0)
+            return false;
+
+        cut_pool_->get_alpha_gamma(cycles[0], infeasible.alpha(), infeasible.gamma());
+
+        return true;
+    }
+
+    void conTSP2_scheduling::optimize_schedule_(const vector<double> &x, vector<double> &s)
+    {
+        GOMA::stats_timer timer(check_time_);
+        GOMA::trace_scope trace("schedule_objective", "converter");
+
+        // The other engines did not load x in the LP checker (an interrupted race LP did not solve it)
+        if (race_winner_ != race_entrant::LP)
         {
-            vector<operation_info> &op_times_v{scheduling[k]};
-            const size_t n_ops_k{op_times_v.size()};
+            if (!(sparse_ != NULL ? checker_.is_feasible_(*sparse_) : checker_.is_feasible_(x)))
+                return;
+        }
 
-            // Convert customer visit operations to customer IDs (1-based)
-            for (size_t i{1}; i < n_ops_k - 1; ++i)
+        if (checker_.optimize_s(objective_weights_))
+            checker_.get_s(s);
+    }
+
+    void conTSP2_scheduling::refine_solution_(vector<double> &s)
+    {
+        // Find the minimum start time among all depot operations (first n_depots operations)
+        double s_min{0.0};
+
+        for (size_t k{0}; k < n_depots_; ++k)
+        {
+            if (s_min > s[k])
             {
-                op_times_v[i].first = operation_2_customer_[op_times_v[i].first] + 1;
+                s_min = s[k];
             }
+        }
 
-            // Mark first and last operations as depot operations (ID = 1)
-            op_times_v[0].first = 1;           // Depot delivery (departure)
-            op_times_v[n_ops_k - 1].first = 1; // Depot pickup (return)
+        // Shift all start times so that the earliest depot operation starts at t=0
+        // This normalization doesn't affect feasibility since all temporal differences are preserved
+        for (size_t i{0}; i < n_operations_; ++i)
+        {
+            s[i] -= s_min;
         }
     }
 
-    void conTSP2_scheduling::var_2_time_windows_(const vector<double> &s, sync_time_windows &time_windows)
+    void conTSP2_scheduling::var_2_schedule_(const vector<double> &s, sync_scheduling &scheduling)
     {
-        // Allocate space for customer time windows (index 0 = depot, 1..n_customers = customers)
-        time_windows.resize(n_customers_ + 1);
+        // Initialize scheduling structure with one list per depot
+        scheduling.resize(n_depots_);
 
-        // Track the earliest and latest start times for each customer across all vehicles
-        vector<double> min_start_times(n_customers_ + 1, std::numeric_limits<double>::max());
-        vector<double> max_start_times(n_customers_ + 1, std::numeric_limits<double>::lowest());
+        for (size_t k{0}; k < n_depots_; ++k)
+        {
+            depot_schedule_(k, s, scheduling[k]);
+        }
+
+        n_depots_rebuilt_ += n_depots_;
+    }
 
-        // Collect min/max start times for each customer
-        // Customer operations have IDs >= 2*n_depots (first n_depots = depot departures, next n_depots = depot returns)
-        for (size_t i{2 * n_depots_}; i < n_operations_; ++i)
+    void conTSP2_scheduling::update_schedule_(const vector<double> &s, const vector<double> &s_prev,
+                                              sync_scheduling &scheduling)
+    {
+        for (size_t k{0}; k < n_depots_; ++k)
         {
-            const int customer_i{operation_2_customer_[i]};
+            // The list of depot k only depends on the start times of its operations
+            bool changed{scheduling[k].size() != (size_t)(depot_ops_head_[k + 1] - depot_ops_head_[k])};
+
+            for (int p{depot_ops_head_[k]}; p < depot_ops_head_[k + 1] && !changed; ++p)
+            {
+                changed = s[depot_ops_[p]] != s_prev[depot_ops_[p]];
+            }
+
+            if (changed)
+            {
+                depot_schedule_(k, s, scheduling[k]);
+                n_depots_rebuilt_++;
+            }
+            else
+            {
+                n_depots_reused_++;
+            }
+        }
+    }
+
+    void conTSP2_scheduling::depot_schedule_(const size_t k, const vector<double> &s, vector<operation_info> &op_times_v)
+    {
+        op_times_v.clear();
 
-            min_start_times[customer_i] = std::min(min_start_times[customer_i], s[i]);
-            max_start_times[customer_i] = std::max(max_start_times[customer_i], s[i]);
+        // Operations of the depot with initial timing (arrival=0, start=s[i])
+        for (int p{depot_ops_head_[k]}; p < depot_ops_head_[k + 1]; ++p)
+        {
+            const int i{depot_ops_[p]};
+            op_times_v.push_back(operation_info(i, operation_times(0, s[i])));
         }
 
-        // Verify that the time span for each customer doesn't exceed the maximum allowed
-        for (size_t i{1}; i <= n_customers_; ++i)
+        // Sort operations by start time (ascending)
+        sort(op_times_v.begin(), op_times_v.end(),
+             [](const operation_info &a, const operation_info &b)
+             {
+                 return a.second.second < b.second.second;
+             });
+
+        const size_t n_ops_k{op_times_v.size()};
+
+        // Find and move depot pickup to the last position
+        // Depot pickups have IDs in range [n_depots, 2*n_depots)
         {
-            const double diff = max_start_times[i] - min_start_times[i];
+            size_t delivery_pos{0};
+
+            for (size_t i{0}; i < n_ops_k; ++i)
+            {
+                const int op_i{op_times_v[i].first};
 
-            // All visits to customer i must occur within a time window of max_time_windows_size_
-            assert(diff <= max_time_windows_size_ + 1E-6);
+                if ((op_i >= (int)n_depots_) && (op_i < (int)(2 * n_depots_)))
+                {
+                    delivery_pos = i;
+                    break;
+                }
+            }
+
+            // Swap depot pickup with the last position
+            if (delivery_pos < n_ops_k - 1)
+            {
+                std::swap(op_times_v[delivery_pos], op_times_v[n_ops_k - 1]);
+            }
         }
 
-        // Compute time windows centered around the average visit time
-        for (size_t i{1}; i <= n_customers_; ++i)
+        // Compute actual arrival times based on travel times between consecutive operations
+
+        // First operation starts at time 0 (depot departure)
+        op_times_v[0].second.second = 0.0;
+
+        // For each subsequent operation, compute arrival time
+        for (size_t i{1}; i < n_ops_k; ++i)
         {
-            // Center the time window around the midpoint of min and max visit times
-            const double time_windows_center{0.5 * (min_start_times[i] + max_start_times[i])};
+            const int op_i_prev{op_times_v[i - 1].first};
+            const int op_i_curr{op_times_v[i].first};
 
-            // Compute time window bounds (ensuring non-negative start time)
-            const double min_start_t = std::max(0.0, time_windows_center - 0.5 * max_time_windows_size_);
-            const double max_start_t = min_start_t + max_time_windows_size_;
+            // Get travel time between consecutive operations
+            const double travel_time{builder_.get_arc_time(op_i_prev, op_i_curr)};
 
-            // Verify that the computed window contains all actual visit times
-            assert(min_start_t <= min_start_times[i] + 1E-6);
-            assert(max_start_t >= max_start_times[i] - 1E-6);
+            // Verify temporal feasibility: current start ≥ previous start + travel time
+            assert(s[op_i_curr] >= s[op_i_prev] + travel_time - 1E-6);
 
-            // Store the computed time window
-            time_windows[i] = tw_info(min_start_t, max_start_t);
+            // Arrival time = previous start time + travel time
+            op_times_v[i].second.first = op_times_v[i - 1].second.second + travel_time;
+        }
+
+        // Convert operation IDs to customer IDs for output format
+
+        // Convert customer visit operations to customer IDs (1-based)
+        for (size_t i{1}; i < n_ops_k - 1; ++i)
+        {
+            op_times_v[i].first = operation_2_customer_[op_times_v[i].first] + 1;
         }
 
-        // Set depot time window to [0, max_distance] (vehicles can return anytime before max route duration)
-        time_windows[0] = tw_info(0.0, max_distance_);
+        // Mark first and last operations as depot operations (ID = 1)
+        op_times_v[0].first = 1;           // Depot delivery (departure)
+        op_times_v[n_ops_k - 1].first = 1; // Depot pickup (return)
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+/**
+ * @file sync_memory.cpp
+ * @brief Implementation of the converter memory report
+ */
+
+#include "sync_memory.hpp"
+
+namespace SYNC_LIB
+{
+    sync_memory::sync_memory(void)
+    {
+        clear();
+    }
+
+    sync_memory::~sync_memory(void)
+    {
+    }
+
+    void sync_memory::clear(void)
+    {
+        model = 0;
+        pair_maps = 0;
+
+        lp_model = 0;
+        lp_matrix = 0;
+
+        path_finder = 0;
+        support_succ = 0;
+        dfs_stack = 0;
+
+        peak_search = 0;
+        peak_cycles = 0;
+
+        rss_after_build = 0;
+        peak_rss = 0;
+    }
+
+    void sync_memory::write_json(ostream &os) const
+    {
+        os << "{\"model\": " << model
+           << ", \"pair_maps\": " << pair_maps
+           << ", \"lp_model\": " << lp_model
+           << ", \"lp_matrix\": " << lp_matrix
+           << ", \"path_finder\": " << path_finder
+           << ", \"support_succ\": " << support_succ
+           << ", \"dfs_stack\": " << dfs_stack
+           << ", \"peak_search\": " << peak_search
+           << ", \"peak_cycles\": " << peak_cycles
+           << ", \"rss_after_build\": " << rss_after_build
+           << ", \"peak_rss\": " << peak_rss
+           << "}" << endl;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file sync_stats.cpp
+ * @brief Implementation of the converter work counters
+ */
+
+#include "sync_stats.hpp"
+
+namespace SYNC_LIB
+{
+    sync_stats::sync_stats(void)
+    {
+        clear();
+    }
+
+    sync_stats::~sync_stats(void)
+    {
+    }
+
+    void sync_stats::clear(void)
+    {
+        n_checks = 0;
+        n_feasible = 0;
+        n_truncated = 0;
+        check_time = 0;
+
+        n_lp_solves = 0;
+        lp_iterations = 0;
+        lp_time = 0;
+        coef_nz = 0;
+        obj_nz = 0;
+
+        n_cycle_searches = 0;
+        support_arcs = 0;
+        dfs_nodes = 0;
+        cycles_found = 0;
+        cycles_new = 0;
+        cycles_kept = 0;
+        cycle_time = 0;
+
+        model_build_time = 0;
+        output_time = 0;
+    }
+
+    void sync_stats::add(const sync_stats &stats)
+    {
+        n_checks += stats.n_checks;
+        n_feasible += stats.n_feasible;
+        n_truncated += stats.n_truncated;
+        check_time += stats.check_time;
+
+        n_lp_solves += stats.n_lp_solves;
+        lp_iterations += stats.lp_iterations;
+        lp_time += stats.lp_time;
+        coef_nz += stats.coef_nz;
+        obj_nz += stats.obj_nz;
+
+        n_cycle_searches += stats.n_cycle_searches;
+        support_arcs += stats.support_arcs;
+        dfs_nodes += stats.dfs_nodes;
+        cycles_found += stats.cycles_found;
+        cycles_new += stats.cycles_new;
+        cycles_kept += stats.cycles_kept;
+        cycle_time += stats.cycle_time;
+
+        model_build_time += stats.model_build_time;
+        output_time += stats.output_time;
+    }
+
+    void sync_stats::write_json(ostream &os) const
+    {
+        os << "{\"n_checks\": " << n_checks
+           << ", \"n_feasible\": " << n_feasible
+           << ", \"n_truncated\": " << n_truncated
+           << ", \"check_time\": " << check_time
+           << ", \"n_lp_solves\": " << n_lp_solves
+           << ", \"lp_iterations\": " << lp_iterations
+           << ", \"lp_time\": " << lp_time
+           << ", \"coef_nz\": " << coef_nz
+           << ", \"obj_nz\": " << obj_nz
+           << ", \"n_cycle_searches\": " << n_cycle_searches
+           << ", \"support_arcs\": " << support_arcs
+           << ", \"dfs_nodes\": " << dfs_nodes
+           << ", \"cycles_found\": " << cycles_found
+           << ", \"cycles_new\": " << cycles_new
+           << ", \"cycles_kept\": " << cycles_kept
+           << ", \"cycle_time\": " << cycle_time
+           << ", \"model_build_time\": " << model_build_time
+           << ", \"output_time\": " << output_time
+           << "}" << endl;
+    }
+}
@@ -30,7 +30,8 @@ namespace GOMA
      * Unlike CPLEX which uses raw pointers, CLP uses STL containers and
      * COIN utility classes, making memory management safer.
      * 
-     * @note Memory is managed by this class
+     * @note Memory is managed by this class, except the constraint matrix arrays,
+     *       which are read from the model_description (it must outlive this structure)
      * @note This class is specific to CLP; use model_description for solver-independent code
      * 
      * @see model_description for generic model representation
@@ -47,10 +48,7 @@ namespace GOMA
         vector<double> rhs_;   ///< Right-hand side values
         vector<char> sense_;   ///< Constraint senses ('L', 'E', 'G')
         
-        vector<int> matbeg_;    ///< Column start indices in sparse matrix
-        vector<int> matind_;    ///< Row indices of non-zero coefficients
-        vector<int> matcnt_;    ///< Number of non-zeros per column
-        vector<double> matval_; ///< Non-zero coefficient values
+        const sparse_matrix<double> &M_; ///< Constraint matrix (CSC, owned by the model_description)
         
         vector<double> obj_;   ///< Objective function coefficients
         vector<double> lb_;    ///< Lower bounds on variables
@@ -83,10 +81,9 @@ namespace GOMA
         inline int nrow(void) const {return nrow_;}
         inline const vector<double>& get_rhs(void) const {return rhs_;}
         inline const vector<char>& get_sense(void) const {return sense_;}
-        inline const vector<int>& get_matbeg(void) const {return matbeg_;}
-        inline const vector<int>& get_matind(void) const {return matind_;}
-        inline const vector<int>& get_matcnt(void) const {return matcnt_;}
-        inline const vector<double>& get_matval(void) const {return matval_;}
+        inline const vector<int>& get_matbeg(void) const {return M_.get_matbeg();}
+        inline const vector<int>& get_matind(void) const {return M_.get_matind();}
+        inline const vector<double>& get_matval(void) const {return M_.get_matval();}
         inline const vector<double>& get_obj(void) const {return obj_;}
         inline const vector<double>& get_lb(void) const {return lb_;}
         inline const vector<double>& get_ub(void) const {return ub_;}
@@ -14,6 +14,8 @@
 #include "CLP/CLP_model_structure.hpp"
 #include "LP_solver.hpp"
 
+#include <atomic>
+
 // Forward declarations for CLP classes to avoid heavy includes in header
 class ClpSimplex;
 class CoinPackedMatrix;
@@ -70,6 +72,10 @@ namespace GOMA
     {
     protected:
         ClpSimplex *model_;  ///< CLP model pointer (unique ownership)
+        bool warm_start_;    ///< Reuse the status array (basis) of the last solve
+        double obj_cutoff_;  ///< Primal objective limit (-infinity: solve to optimality)
+        double time_limit_;  ///< Seconds per solve (≤ 0: no limit)
+        atomic<bool> interrupt_; ///< Stop the solves (polled by the event handler of model_)
 
     public:
         /**
@@ -107,6 +113,16 @@ namespace GOMA
         void set_obj(double *obj_coef, int *obj_inx, int sz);
         void set_bdn(double *obj_coef, char *sense, int *obj_inx, int sz);
         void set_rhs(int cnt, const int *rhs_inx, const double *rhs_val);
+
+        /**
+         * @brief Modify constraint matrix coefficients in bulk
+         * @param cnt Number of coefficients
+         * @param row_inx Row indices
+         * @param col_inx Column indices
+         * @param coef_val New values (0 keeps the element as an explicit zero)
+         * @note Existing elements are overwritten in place, one pass over the
+         *       updates; only elements outside the current pattern are inserted
+         */
         void set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val);
 
         void add_cut(int nzcnt, double const *rhs, char const *sense, int const *rmatbeg, int const *rmatind, double const *rmatval, char **rowname);
@@ -119,6 +135,39 @@ namespace GOMA
          */
         void disable_prep_linear(void);
 
+        /**
+         * @brief Enable or disable warm start from the last basis
+         * @param warm_start false resets to an all-slack basis before each solve
+         */
+        void set_warm_start(const bool warm_start);
+
+        /**
+         * @brief Stop at the first primal point below an objective limit
+         * @param cutoff Objective limit (-infinity disables it)
+         * @note With a cutoff the solve uses primal simplex and
+         *       setPrimalObjectiveLimit: the dual simplex iterates are not
+         *       primal feasible, so they are no certificate
+         */
+        void set_obj_cutoff(const double cutoff);
+
+        /**
+         * @brief Stop the next solves after a number of seconds
+         * @param seconds Time limit (≤ 0: no limit)
+         * @note CLP counts CPU time (setMaximumSeconds)
+         */
+        void set_time_limit(const double seconds);
+
+        /**
+         * @brief Stop the running solve and the next ones
+         * @param interrupt true to stop them, false to let solves run again
+         * @note An event handler of the model polls the flag at the end of
+         *       every simplex iteration
+         */
+        void set_interrupt(const bool interrupt);
+
+        bool get_basis(vector<int> &col_stat, vector<int> &row_stat) const;
+        bool set_basis(const vector<int> &col_stat, const vector<int> &row_stat);
+
         void del_rows(int begin, int end);
 
         /**
@@ -169,6 +218,12 @@ namespace GOMA
          */
         int get_n_rows(void) const;
 
+        /**
+         * @brief Get simplex iterations of the last solve
+         * @return Iteration count
+         */
+        int get_n_iterations(void) const;
+
         /**
          * @brief Write model to file
          * @param filename Output file (.lp, .mps, etc.)
@@ -177,6 +232,25 @@ namespace GOMA
         void write_model(const char *filename) const;
 
     private:
+        /**
+         * @brief Translate a ClpSimplex::Status to BasisStat
+         * @param status CLP status
+         * @return BasisStat value
+         */
+        static int clp_2_basis_stat(int status);
+
+        /**
+         * @brief Translate a BasisStat to ClpSimplex::Status
+         * @param status BasisStat value
+         * @return CLP status
+         */
+        static int basis_stat_2_clp(int status);
+
+        /**
+         * @brief Refresh the zeros/gaps flags of the CLP matrix after a bulk update
+         */
+        void update_matrix_flags(void);
+
         /**
          * @brief Convert row lower/upper bounds from sense/rhs format
          * @param sense Constraint sense ('L', 'E', 'G')
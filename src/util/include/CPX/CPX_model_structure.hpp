@@ -27,7 +27,8 @@ namespace GOMA
      * 
      * All string data is converted to C-style char* pointers for CPLEX compatibility.
      * 
-     * @note Memory is managed by this class - all pointers are freed in destructor
+     * @note Memory is managed by this class - all pointers are freed in destructor,
+     *       except the constraint matrix arrays, which belong to the model_description
      * @note This class is specific to CPLEX; use model_description for solver-independent code
      * 
      * @see model_description for generic model representation
@@ -44,10 +45,10 @@ namespace GOMA
         double *rhs_;  ///< Right-hand side values
         char *sense_;  ///< Constraint senses ('L', 'E', 'G')
         
-        int *matbeg_;  ///< Column start indices in sparse matrix
-        int *matind_;  ///< Row indices of non-zero coefficients
+        int *matbeg_;  ///< Column start indices in sparse matrix (not owned, points into model M_)
+        int *matind_;  ///< Row indices of non-zero coefficients (not owned)
         int *matcnt_;  ///< Number of non-zeros per column
-        double *matval_; ///< Non-zero coefficient values
+        double *matval_; ///< Non-zero coefficient values (not owned)
         
         double *obj_;  ///< Objective function coefficients
         double *lb_;   ///< Lower bounds on variables
@@ -57,6 +57,7 @@ namespace GOMA
     protected:
         CPXENVptr env_;     ///< CPLEX environment pointer
         CPXLPptr problem_;  ///< CPLEX problem pointer
+        volatile int terminate_; ///< CPXsetterminate flag (1: stop the solve)
 
     public:
         /**
@@ -106,6 +107,33 @@ namespace GOMA
          */
         void disable_prep_linear(void);
 
+        /**
+         * @brief Enable or disable CPLEX advanced start
+         * @param warm_start true to start from the last basis (CPXPARAM_Advance)
+         */
+        void set_warm_start(const bool warm_start);
+
+        /**
+         * @brief Set the lower objective limit of the simplex (CPXPARAM_Simplex_Limits_LowerObj)
+         * @param cutoff Objective limit (-1e75, the CPLEX default, disables it)
+         */
+        void set_obj_cutoff(const double cutoff);
+
+        /**
+         * @brief Set the time limit of the solves (CPXPARAM_TimeLimit)
+         * @param seconds Time limit (≤ 0: 1e75, the CPLEX default)
+         */
+        void set_time_limit(const double seconds);
+
+        /**
+         * @brief Stop the running solve and the next ones (CPXsetterminate)
+         * @param interrupt true to stop them, false to let solves run again
+         */
+        void set_interrupt(const bool interrupt);
+
+        bool get_basis(vector<int> &col_stat, vector<int> &row_stat) const;
+        bool set_basis(const vector<int> &col_stat, const vector<int> &row_stat);
+
         void del_rows(int begin, int end);
 
         /**
@@ -154,6 +182,12 @@ namespace GOMA
          */
         int get_n_rows(void) const;
 
+        /**
+         * @brief Get simplex iterations of the last solve
+         * @return Iteration count
+         */
+        int get_n_iterations(void) const;
+
         /**
          * @brief Write model to file
          * @param filename Output file (.lp, .mps, .sav, etc.)
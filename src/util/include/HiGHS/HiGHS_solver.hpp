@@ -0,0 +1,177 @@
+/**
+ * @file HiGHS_solver.hpp
+ * @brief HiGHS solver implementation
+ *
+ * This module provides a concrete implementation of the LP_solver interface
+ * using HiGHS (https://highs.dev), an open-source (MIT) dual simplex / IPM /
+ * MIP solver.
+ *
+ * @note The model is loaded from the CSC arrays of CLP_model_structure,
+ *       which only uses standard containers.
+ */
+
+#pragma once
+
+#include "CLP/CLP_model_structure.hpp"
+#include "LP_solver.hpp"
+
+#include <atomic>
+
+// Forward declarations to avoid including Highs.h in the header
+class Highs;
+enum class HighsBasisStatus : unsigned char;
+
+namespace GOMA
+{
+    /**
+     * @class HiGHS_solver
+     * @brief HiGHS-based LP solver implementation
+     *
+     * Registered as backend `highs` in LP_backend_registry when the util
+     * library is built with `-DUSE_HIGHS=ON`.
+     *
+     * **Installation:**
+     * ```bash
+     * git clone https://github.com/ERGO-Code/HiGHS
+     * cd HiGHS && cmake -S . -B build && cmake --build build && sudo cmake --install build
+     * ```
+     *
+     * @note Row and column modifications keep the HiGHS basis, so
+     *       consecutive check() calls of the same checker warm start
+     *       (set_warm_start(false) clears it before each solve)
+     * @note Thread safety: Each instance has its own Highs object
+     *
+     * @see LP_solver for interface documentation
+     * @see CLP_solver for the same bounds / sense conventions
+     */
+    class HiGHS_solver : public LP_solver
+    {
+    protected:
+        Highs *highs_;    ///< HiGHS instance (unique ownership)
+        bool warm_start_; ///< Reuse the basis of the last solve
+        atomic<bool> interrupt_; ///< Stop the runs (polled by the interrupt callbacks)
+
+    public:
+        /**
+         * @brief Construct HiGHS solver from model
+         * @param model Problem description
+         * @param tol Numerical tolerance (default 1e-6)
+         */
+        HiGHS_solver(const model_description &model, const double tol = 1e-6);
+
+        /**
+         * @brief Destructor - frees the HiGHS instance
+         */
+        virtual ~HiGHS_solver(void);
+
+        /**
+         * @brief Solve the optimization problem (LP or MIP)
+         */
+        void solve(void);
+
+        void get_dual_vars(double *alpha) const;
+        void get_vars(double *alpha) const;
+
+        void set_obj(double *obj_coef, int *obj_inx, int sz);
+        void set_bdn(double *obj_coef, char *sense, int *obj_inx, int sz);
+        void set_rhs(int cnt, const int *rhs_inx, const double *rhs_val);
+        void set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val);
+
+        void add_cut(int nzcnt, double const *rhs, char const *sense, int const *rmatbeg, int const *rmatind, double const *rmatval, char **rowname);
+
+        void set_rhs(const int row, const double val);
+
+        /**
+         * @brief Disable HiGHS presolve
+         */
+        void disable_prep_linear(void);
+
+        /**
+         * @brief Enable or disable warm start from the last basis
+         * @param warm_start false clears the basis before each solve
+         */
+        void set_warm_start(const bool warm_start);
+
+        /**
+         * @brief Objective cutoff (not supported)
+         * @param cutoff Objective limit
+         * @note HiGHS only bounds the dual simplex objective, which proves
+         *       the optimum is above the bound but gives no primal point
+         *       below it; the LP is solved to optimality and the first
+         *       finite cutoff prints a warning. The ctsp_checker app refuses
+         *       --feasibility-only with this backend.
+         */
+        void set_obj_cutoff(const double cutoff);
+
+        /**
+         * @brief Set the time limit of the runs (option time_limit)
+         * @param seconds Time limit (≤ 0: no limit)
+         */
+        void set_time_limit(const double seconds);
+
+        /**
+         * @brief Stop the running run and the next ones
+         * @param interrupt true to stop them, false to let runs go again
+         * @note The simplex and IPM interrupt callbacks poll the flag
+         */
+        void set_interrupt(const bool interrupt);
+
+        bool get_basis(vector<int> &col_stat, vector<int> &row_stat) const;
+        bool set_basis(const vector<int> &col_stat, const vector<int> &row_stat);
+
+        void del_rows(int begin, int end);
+
+        int get_nz(void) const;
+
+        /**
+         * @brief Get objective function value
+         * @return Objective value (-1e20 if unbounded, 1e20 if infeasible)
+         */
+        double get_obj(void) const;
+
+        void init_solver(void);
+        void clear(void);
+
+        /**
+         * @brief Load the model into HiGHS
+         * @param model Model arrays (CSC matrix, bounds, senses)
+         */
+        void build_model(const CLP_model_structure &model);
+
+        void solve_LP(void);
+        void solve_MIP(void);
+
+        int get_n_rows(void) const;
+        int get_n_iterations(void) const;
+
+        /**
+         * @brief Write model to file
+         * @param filename Output file (.lp, .mps; format from extension)
+         */
+        void write_model(const char *filename) const;
+
+    private:
+        /**
+         * @brief Translate a HiGHS basis status to BasisStat
+         * @param status HiGHS status
+         * @return BasisStat value
+         */
+        static int highs_2_basis_stat(HighsBasisStatus status);
+
+        /**
+         * @brief Translate a BasisStat to a HiGHS basis status
+         * @param status BasisStat value
+         * @return HiGHS status
+         */
+        static HighsBasisStatus basis_stat_2_highs(int status);
+
+        /**
+         * @brief Convert row bounds from sense/rhs format
+         * @param sense Constraint sense ('L', 'E', 'G')
+         * @param rhs Right-hand side value
+         * @param row_lower [output] Row lower bound
+         * @param row_upper [output] Row upper bound
+         */
+        void convert_row_bounds(char sense, double rhs, double &row_lower, double &row_upper) const;
+    };
+}
@@ -0,0 +1,114 @@
+/**
+ * @file LP_backend.hpp
+ * @brief Runtime registry of LP solver backends
+ *
+ * Every LP_solver implementation compiled into the util library (CPLEX,
+ * CLP, HiGHS, see the USE_CPLEX / USE_CLP / USE_HIGHS CMake options) is
+ * registered under a short name, so the backend can be chosen when a solver
+ * is created instead of when the code is compiled.
+ */
+
+#pragma once
+
+#include "LP_solver.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @typedef LP_solver_factory
+     * @brief Creates a solver of one backend for a model
+     */
+    typedef LP_solver *(*LP_solver_factory)(const model_description &model, double tol);
+
+    /**
+     * @class LP_backend_registry
+     * @brief Name → LP_solver factory map
+     *
+     * Built-in backends, in default order of preference:
+     *
+     * | Name    | Class        | CMake option |
+     * |---------|--------------|--------------|
+     * | `cplex` | CPX_solver   | USE_CPLEX    |
+     * | `clp`   | CLP_solver   | USE_CLP      |
+     * | `highs` | HiGHS_solver | USE_HIGHS    |
+     *
+     * ```cpp
+     * LP_backend_registry::set_default("clp");             // e.g. from --lp-backend
+     * LP_solver *solver{LP_backend_registry::create("", model, tol)};  // "": default backend
+     * ```
+     *
+     * @note Register backends and set the default before creating solvers
+     *       from several threads; create() only reads the registry.
+     */
+    class LP_backend_registry
+    {
+    public:
+        /**
+         * @brief Register (or replace) a backend
+         * @param name Backend name
+         * @param factory Solver factory
+         */
+        static void register_backend(const string &name, LP_solver_factory factory);
+
+        /**
+         * @brief Check if a backend is available
+         * @param name Backend name
+         * @return true if registered
+         */
+        static bool has_backend(const string &name);
+
+        /**
+         * @brief Names of the available backends
+         * @return Backend names, in alphabetical order
+         */
+        static vector<string> get_backends(void);
+
+        /**
+         * @brief Set the backend used when no name is given
+         * @param name Backend name
+         * @note Exits with an error if the backend is not available
+         */
+        static void set_default(const string &name);
+
+        /**
+         * @brief Get the backend used when no name is given
+         * @return Backend name (first built-in backend unless set_default() was called)
+         */
+        static const string &get_default(void);
+
+        /**
+         * @brief Create a solver
+         * @param name Backend name ("" for the default backend)
+         * @param model Problem description
+         * @param tol Numerical tolerance
+         * @return New solver (owned by the caller)
+         * @note Exits with an error if the backend is not available
+         */
+        static LP_solver *create(const string &name, const model_description &model, double tol);
+
+    private:
+        /**
+         * @brief Registered backends (built-in ones added on first use)
+         * @return Backend map
+         */
+        static map<string, LP_solver_factory> &backends_(void);
+
+        /**
+         * @brief Default backend name
+         * @return Reference to the default name
+         */
+        static string &default_(void);
+
+        /**
+         * @brief Exit with the list of available backends
+         * @param name Unknown backend name
+         */
+        static void unknown_backend_(const string &name);
+    };
+}
@@ -11,9 +11,42 @@
 
 #include "model_description.hpp"
 
+#include <vector>
 
 namespace GOMA
 {
+    /**
+     * @brief Basis status of a column or a row (slack)
+     *
+     * Same values as CPLEX (CPX_AT_LOWER, CPX_BASIC, CPX_AT_UPPER,
+     * CPX_FREE_SUPER); the other backends translate their own codes.
+     */
+    enum BasisStat { AtLower, Basic, AtUpper, FreeSuper };
+
+    /**
+     * @brief get_lp_stat() of a solve stopped by the objective cutoff
+     *
+     * Same value as CPX_STAT_ABORT_OBJ_LIM; the other backends map their
+     * own status to it (1 is optimal and 2 unbounded in every backend).
+     */
+    const int LP_STAT_OBJ_LIMIT{12};
+
+    /**
+     * @brief get_lp_stat() of a solve stopped by the time limit
+     *
+     * Same value as CPX_STAT_ABORT_TIME_LIM; the point at the stop is no
+     * answer (neither optimal nor a certificate).
+     */
+    const int LP_STAT_TIME_LIMIT{11};
+
+    /**
+     * @brief get_lp_stat() of a solve stopped by set_interrupt()
+     *
+     * Same value as CPX_STAT_ABORT_USER; as after the time limit, the
+     * point at the stop is no answer.
+     */
+    const int LP_STAT_INTERRUPTED{13};
+
     /**
      * @class LP_solver
      * @brief Abstract base class for optimization solvers
@@ -115,15 +148,16 @@ namespace GOMA
         virtual void set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val) = 0;
 
         /**
-         * @brief Add cutting plane constraints
-         * @param nzcnt Number of constraints to add
-         * @param rhs Right-hand side values
-         * @param sense Constraint senses ('L', 'E', 'G')
-         * @param rmatbeg Row start indices
+         * @brief Add one cutting plane constraint
+         * @param nzcnt Number of non-zeros of the cut
+         * @param rhs Right-hand side value
+         * @param sense Constraint sense ('L', 'E', 'G')
+         * @param rmatbeg Row start index (rmatbeg[0], usually 0)
          * @param rmatind Column indices of non-zeros
          * @param rmatval Non-zero coefficient values
-         * @param rowname Row names (can be NULL)
-         * @note Used in branch-and-cut algorithms
+         * @param rowname Row name (can be NULL)
+         * @note Used in branch-and-cut algorithms. See SYNC_LIB::sync_cuts to
+         *       add a batch of cuts stored in this layout.
          */
         virtual void add_cut(int nzcnt, double const *rhs, char const *sense, int const *rmatbeg, int const *rmatind, double const *rmatval, char **rowname) = 0;
 
@@ -140,6 +174,55 @@ namespace GOMA
          */
         virtual void disable_prep_linear(void) = 0;
 
+        /**
+         * @brief Enable or disable warm start from the previous basis
+         * @param warm_start true to start the next solve from the last basis
+         * @note Useful when consecutive solves differ in a few coefficients
+         */
+        virtual void set_warm_start(const bool warm_start) = 0;
+
+        /**
+         * @brief Stop a minimization once the objective drops below a cutoff
+         * @param cutoff Objective limit (-infinity disables it)
+         * @note Primal simplex phase II: the point at the stop is primal
+         *       feasible with objective < cutoff and get_lp_stat() returns
+         *       LP_STAT_OBJ_LIMIT. Backends without such a limit (HiGHS)
+         *       warn and solve to optimality.
+         */
+        virtual void set_obj_cutoff(const double cutoff) = 0;
+
+        /**
+         * @brief Stop the next solves after a number of seconds
+         * @param seconds Time limit of each solve (≤ 0: no limit)
+         * @note A stopped solve reports LP_STAT_TIME_LIMIT
+         */
+        virtual void set_time_limit(const double seconds) = 0;
+
+        /**
+         * @brief Stop the running solve and the next ones
+         * @param interrupt true to stop them, false to let solves run again
+         * @note Callable from another thread while solve() runs. A stopped
+         *       solve reports LP_STAT_INTERRUPTED
+         */
+        virtual void set_interrupt(const bool interrupt) = 0;
+
+        /**
+         * @brief Get the basis of the last solve
+         * @param col_stat [output] BasisStat of each column (size = n_col)
+         * @param row_stat [output] BasisStat of each row (size = get_n_rows())
+         * @return false if there is no basis (unsolved or not an LP)
+         */
+        virtual bool get_basis(vector<int> &col_stat, vector<int> &row_stat) const = 0;
+
+        /**
+         * @brief Set the starting basis of the next solve
+         * @param col_stat BasisStat of each column
+         * @param row_stat BasisStat of each row
+         * @return false if the sizes do not match the model or the solver rejects it
+         * @note Takes effect with warm start enabled (the default of the checkers)
+         */
+        virtual bool set_basis(const vector<int> &col_stat, const vector<int> &row_stat) = 0;
+
         /**
          * @brief Delete constraint rows
          * @param begin First row to delete
@@ -188,6 +271,12 @@ namespace GOMA
          */
         virtual int get_n_rows(void) const = 0;
 
+        /**
+         * @brief Get simplex iterations of the last solve
+         * @return Iteration count (0 before the first solve)
+         */
+        virtual int get_n_iterations(void) const = 0;
+
         /**
          * @brief Get LP solver status
          * @return Status code (optimal, infeasible, unbounded, etc.)
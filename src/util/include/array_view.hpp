@@ -0,0 +1,84 @@
+/**
+ * @file array_view.hpp
+ * @brief Read-only view of a contiguous range (base pointer + size)
+ *
+ * Lets consumers read buffers owned by someone else (e.g. the dual and
+ * primal arrays of an LP checker) in place, without copying them into a
+ * vector. A vector converts implicitly, so functions taking a view accept
+ * both.
+ *
+ * Example:
+ * @code
+ * array_view<double> gamma(a + base_gamma, n_gamma); // no copy
+ * for (size_t i{0}; i < gamma.size(); i++) { ... gamma[i] ... }
+ * @endcode
+ *
+ * @note The view does not own the data: it is only valid while the
+ *       underlying buffer is alive and unchanged
+ */
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class array_view
+     * @brief Non-owning read-only view of a contiguous array
+     * @tparam T Element type
+     */
+    template <class T>
+    class array_view
+    {
+    protected:
+        const T *data_; ///< First element (not owned)
+        size_t size_;   ///< Number of elements
+
+    public:
+        array_view(void) : data_(nullptr), size_(0) {}
+
+        array_view(const T *data, const size_t size) : data_(data), size_(size) {}
+
+        /**
+         * @brief View of a whole vector (implicit)
+         * @param v Vector (must outlive the view and not be resized)
+         */
+        array_view(const vector<T> &v) : data_(v.data()), size_(v.size()) {}
+
+        inline const T &operator[](const size_t i) const
+        {
+            assert(i < size_);
+            return data_[i];
+        }
+
+        inline const T *data(void) const { return data_; }
+        inline size_t size(void) const { return size_; }
+        inline bool empty(void) const { return size_ == 0; }
+
+        inline const T *begin(void) const { return data_; }
+        inline const T *end(void) const { return data_ + size_; }
+
+        /**
+         * @brief View of a sub-range
+         * @param first First element of the sub-range
+         * @param n Number of elements
+         * @return View of [first, first + n)
+         */
+        inline array_view subview(const size_t first, const size_t n) const
+        {
+            assert(first + n <= size_);
+            return array_view(data_ + first, n);
+        }
+
+        /**
+         * @brief Copy the viewed elements
+         * @param v Output: v resized to size() and overwritten
+         */
+        inline void copy_to(vector<T> &v) const { v.assign(data_, data_ + size_); }
+    };
+}
@@ -0,0 +1,126 @@
+/**
+ * @file bounded_queue.hpp
+ * @brief Blocking FIFO queue of bounded capacity, for pipelines of threads
+ *
+ * Producers wait while the queue is full and consumers while it is empty,
+ * so a fast stage cannot run ahead of a slow one by more than the
+ * capacity. close() ends the stream: producers are refused, and consumers
+ * drain what is left before pop() returns false.
+ *
+ * Example:
+ * @code
+ * bounded_queue<size_t> queue(8);
+ *
+ * thread producer([&] { for (size_t i{0}; i < n; i++) queue.push(i); queue.close(); });
+ *
+ * size_t i;
+ * while (queue.pop(i))
+ *     consume(i);
+ *
+ * producer.join();
+ * @endcode
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class bounded_queue
+     * @brief Multi-producer, multi-consumer FIFO holding at most capacity items
+     * @tparam T Item type (movable)
+     */
+    template <class T>
+    class bounded_queue
+    {
+    private:
+        mutex mutex_;                  ///< Guards the fields below
+        condition_variable not_empty_; ///< Signalled on push and close
+        condition_variable not_full_;  ///< Signalled on pop and close
+        deque<T> items_;               ///< Items, oldest first
+        const size_t capacity_;        ///< Largest number of items
+        bool closed_;                  ///< No more items accepted
+
+    public:
+        /**
+         * @brief Empty open queue
+         * @param capacity Largest number of items held (at least 1)
+         */
+        explicit bounded_queue(const size_t capacity) : mutex_(),
+                                                        not_empty_(),
+                                                        not_full_(),
+                                                        items_(),
+                                                        capacity_(capacity > 0 ? capacity : 1),
+                                                        closed_(false)
+        {
+        }
+
+        virtual ~bounded_queue(void) {}
+
+        /**
+         * @brief Append an item, waiting while the queue is full
+         * @param item Item to append
+         * @return false if the queue is closed (item dropped)
+         */
+        bool push(T item)
+        {
+            unique_lock<mutex> lock(mutex_);
+
+            not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+
+            if (closed_)
+                return false;
+
+            items_.push_back(move(item));
+            lock.unlock();
+
+            not_empty_.notify_one();
+
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest item, waiting while the queue is empty and open
+         * @param item Output: oldest item
+         * @return false if the queue is closed and empty
+         */
+        bool pop(T &item)
+        {
+            unique_lock<mutex> lock(mutex_);
+
+            not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+
+            if (items_.empty())
+                return false;
+
+            item = move(items_.front());
+            items_.pop_front();
+            lock.unlock();
+
+            not_full_.notify_one();
+
+            return true;
+        }
+
+        /**
+         * @brief Accept no more items and wake every waiting thread
+         */
+        void close(void)
+        {
+            {
+                lock_guard<mutex> lock(mutex_);
+                closed_ = true;
+            }
+
+            not_empty_.notify_all();
+            not_full_.notify_all();
+        }
+    };
+}
@@ -0,0 +1,90 @@
+/**
+ * @file distance_oracle.hpp
+ * @brief Read-only access to a distance matrix that need not be stored
+ *
+ * Consumers that only read distances (e.g. the model builders) take a
+ * distance_oracle instead of a GOMA::matrix, so that large coordinate
+ * instances can compute the distances on demand instead of keeping a
+ * dense n x n copy alive. matrix_distance_oracle adapts a stored matrix.
+ *
+ * Example:
+ * @code
+ * GOMA::matrix<double> D(n, n, 0.0);
+ * GOMA::matrix_distance_oracle oracle(D); // no copy
+ *
+ * const double d_12{oracle(1, 2)};        // 1-based, as D(1, 2)
+ *
+ * const double *D_1{oracle.get_row(1)};   // stored row, D_1[1] = d_12
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "matrix.hpp"
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class distance_oracle
+     * @brief Interface of a square distance matrix read element by element
+     */
+    class distance_oracle
+    {
+    public:
+        virtual ~distance_oracle(void) {}
+
+        /**
+         * @brief Number of rows (= columns)
+         */
+        virtual size_t get_n_rows(void) const = 0;
+
+        /**
+         * @brief Distance from i to j
+         * @param i Row index (1-based)
+         * @param j Column index (1-based)
+         */
+        virtual double operator()(size_t i, size_t j) const = 0;
+
+        /**
+         * @brief Stored row, to read without a call per element
+         * @param i Row index (1-based)
+         * @return Distance from i to j at [j - 1], NULL if the distances
+         *         are not stored (read them through operator())
+         */
+        virtual const double *get_row(size_t i) const
+        {
+            (void)i;
+            return NULL;
+        }
+
+        /**
+         * @brief true if operator() can be called from several threads at once
+         */
+        virtual bool concurrent_reads(void) const { return true; }
+    };
+
+    /**
+     * @class matrix_distance_oracle
+     * @brief distance_oracle over a stored matrix (not owned)
+     */
+    class matrix_distance_oracle : public distance_oracle
+    {
+    protected:
+        const matrix<double> &M_; ///< Distances (must outlive the oracle)
+
+    public:
+        matrix_distance_oracle(const matrix<double> &M) : M_(M) {}
+
+        virtual ~matrix_distance_oracle(void) {}
+
+        inline size_t get_n_rows(void) const { return M_.get_n_rows(); }
+
+        inline double operator()(size_t i, size_t j) const { return M_(i, j); }
+
+        inline const double *get_row(size_t i) const { return M_.row(i); }
+    };
+}
@@ -14,8 +14,8 @@
  * Key features:
  * - Compile-time fixed size (no dynamic resizing)
  * - Template parameterized storage type and capacity
- * - Zero overhead abstraction (inline operations)
- * - Set operations using bitwise operations on blocks
+ * - Zero overhead abstraction (inline operations, inline storage)
+ * - Set operations using bitwise operations on blocks (AVX2/SSE2 when available)
  * - GCC intrinsics for efficient bit manipulation
  * 
  * Example:
@@ -33,6 +33,12 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <string>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -54,8 +60,13 @@ namespace GOMA
 	 * @tparam N Maximum number of elements (compile-time constant)
 	 * 
 	 * Storage:
-	 * - block_[]: Array of T blocks (size = ceil(N / N_BITS_W) + 1)
-	 * - sz_: Number of blocks allocated
+	 * - block_[]: Inline array of T blocks (size = ceil(N / N_BITS_W)),
+	 *   32-byte aligned; copies are a plain block copy (no heap allocation)
+	 * - sz_: Number of blocks (compile-time constant)
+	 * 
+	 * Whole-set operations (union, intersection, difference, equality,
+	 * cardinality) run on 256-bit (AVX2) or 128-bit (SSE2) registers when
+	 * the target has them, block by block otherwise.
 	 * 
 	 * Advantages over dynamic bitset:
 	 * - No runtime memory allocation overhead
@@ -74,25 +85,20 @@ namespace GOMA
 	class fixed_bitset
 	{
 	public:
-		T *block_;    ///< Array of bit storage blocks
-		int sz_;      ///< Number of blocks (ceil(N/N_BITS_W) + 1)
+		/** @brief Number of blocks (ceil(N/N_BITS_W)) */
+		static constexpr int sz_{(int)((N + N_BITS_W - 1) / N_BITS_W)};
+
+		alignas(32) T block_[sz_]; ///< Bit storage blocks (inline, no heap allocation)
 
 	public:
 		/**
 		 * @brief Default constructor: Create empty bitset
 		 * 
-		 * Allocates ceil(N/N_BITS_W)+1 blocks and clears all bits.
+		 * Clears all ceil(N/N_BITS_W) inline blocks.
 		 * Capacity N is compile-time constant from template parameter.
 		 */
-		fixed_bitset(void) : block_(NULL),
-				   sz_(ceil((double)N / (double)N_BITS_W))
+		fixed_bitset(void)
 		{
-
-			if ((N % N_BITS_W) != 0)
-				sz_++;
-
-			block_ = new T[sz_];
-
 			clear();
 		};
 
@@ -100,58 +106,27 @@ namespace GOMA
 		 * @brief Constructor: Create bitset with single element
 		 * @param i Initial element to insert (1-indexed)
 		 * 
-		 * Allocates blocks, clears all bits, then inserts element i.
+		 * Clears all bits, then inserts element i.
 		 */
-		fixed_bitset(const int i) : block_(NULL),
-				   sz_(ceil((double)N / (double)N_BITS_W))
+		fixed_bitset(const int i)
 		{
-
-			if ((N % N_BITS_W) != 0)
-				sz_++;
-
-			block_ = new T[sz_];
-
 			clear();
 
 			insert(i);
 		};
 
 		/**
-		 * @brief Copy constructor: Deep copy of bitset
+		 * @brief Copy constructor: Copy of the inline blocks
 		 * @param bs Source bitset to copy
-		 * 
-		 * Allocates new block array and copies all bits.
 		 */
-		fixed_bitset(const fixed_bitset &bs) : block_(NULL),
-							   sz_(bs.sz_)
-		{
-			block_ = new T[bs.sz_];
-
-			for (int i{0}; i < sz_; i++)
-				block_[i] = bs.block_[i];
-		}		/**
-		 * @brief Destructor: Free allocated blocks
-		 */
-		~fixed_bitset(void)
-		{
-			if (block_)
-				delete[] block_;
-		}
+		fixed_bitset(const fixed_bitset &bs) = default;
 
 		/**
 		 * @brief Assignment operator: Copy bits from source
 		 * @param bs Source bitset
-		 * @return Reference to source bitset
-		 * 
-		 * Copies all blocks. Both bitsets must have same template parameters (T, N).
+		 * @return Reference to this bitset
 		 */
-		const fixed_bitset &operator=(const fixed_bitset &bs)
-		{
-			for (int i{0}; i < sz_; i++)
-				block_[i] = bs.block_[i];
-
-			return bs;
-		}
+		fixed_bitset &operator=(const fixed_bitset &bs) = default;
 
 		/**
 		 * @brief Clear all bits (set to empty)
@@ -257,8 +232,7 @@ namespace GOMA
 		 */
 		void insert(const fixed_bitset &bs)
 		{
-			for (int i{0}; i < sz_; i++)
-				block_[i] |= bs.block_[i];
+			apply_<or_op>(block_, bs.block_, block_);
 		}
 
 		/**
@@ -269,8 +243,7 @@ namespace GOMA
 		 */
 		void remove(const fixed_bitset &bs)
 		{
-			for (int i{0}; i < sz_; i++)
-				block_[i] &= ~bs.block_[i];
+			apply_<andnot_op>(block_, bs.block_, block_);
 		}
 
 		/**
@@ -295,6 +268,21 @@ namespace GOMA
 			return contains_set;
 		}
 
+		/**
+		 * @brief Check if both bitsets have the same elements
+		 * @param bs Bitset to compare
+		 * @return true if all blocks are equal
+		 */
+		bool operator==(const fixed_bitset &bs) const
+		{
+			return equal_(block_, bs.block_);
+		}
+
+		bool operator!=(const fixed_bitset &bs) const
+		{
+			return !equal_(block_, bs.block_);
+		}
+
 		/**
 		 * @brief Check if bitsets are disjoint (this ∩ bs = ∅)
 		 * @param bs Bitset to test
@@ -361,15 +349,37 @@ namespace GOMA
 		 * @brief Count number of elements in bitset
 		 * @return Number of set bits (cardinality)
 		 * 
-		 * Uses __builtin_popcount (population count - count set bits).
-		 * Sums bit counts across all blocks.
+		 * Nibble lookup popcount on 256-bit registers with AVX2,
+		 * __builtin_popcountll per block otherwise.
 		 */
 		int cardinality(void) const
 		{
 			int card = 0;
+			int j = 0;
 
-			for (int i{0}; i < sz_; i++)
-				card += cardinality(block_[i]);
+#if defined(__AVX2__)
+			// Mula: per-byte counts from two nibble lookups, summed by _mm256_sad_epu8
+			const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+													0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+			__m256i acc = _mm256_setzero_si256();
+
+			for (; j + blocks_per_256_ <= sz_; j += blocks_per_256_)
+			{
+				const __m256i v = _mm256_load_si256((const __m256i *)(block_ + j));
+				const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+				const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+
+				acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+			}
+
+			card += (int)(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+						  _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+#endif
+
+			for (; j < sz_; j++)
+				card += cardinality(block_[j]);
 
 			return card;
 		}
@@ -398,8 +408,7 @@ namespace GOMA
 		 */
 		void union_set(const fixed_bitset &B, fixed_bitset &C) const
 		{
-			for (int j{0}; j < sz_; j++)
-				C.block_[j] = block_[j] | B.block_[j];
+			apply_<or_op>(block_, B.block_, C.block_);
 		}
 
 		/**
@@ -411,8 +420,7 @@ namespace GOMA
 		 */
 		void intersec_set(const fixed_bitset &B, fixed_bitset &C) const
 		{
-			for (int j{0}; j < sz_; j++)
-				C.block_[j] = block_[j] & B.block_[j];
+			apply_<and_op>(block_, B.block_, C.block_);
 		}
 
 		/**
@@ -424,11 +432,112 @@ namespace GOMA
 		 */
 		void diff_set(const fixed_bitset &B, fixed_bitset &C) const
 		{
-			for (int j{0}; j < sz_; j++)
-				C.block_[j] = block_[j] & ~B.block_[j];
+			apply_<andnot_op>(block_, B.block_, C.block_);
 		}
 
 	private:
+		/** @brief Blocks per 256-bit / 128-bit register */
+		static constexpr int blocks_per_256_{(int)(32 / sizeof(T))};
+		static constexpr int blocks_per_128_{(int)(16 / sizeof(T))};
+
+		/**
+		 * @brief Bitwise block operations (scalar and register versions)
+		 */
+		struct or_op
+		{
+			static inline T scalar(const T a, const T b) { return a | b; }
+#if defined(__AVX2__)
+			static inline __m256i avx(const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+#if defined(__SSE2__)
+			static inline __m128i sse(const __m128i a, const __m128i b) { return _mm_or_si128(a, b); }
+#endif
+		};
+
+		struct and_op
+		{
+			static inline T scalar(const T a, const T b) { return a & b; }
+#if defined(__AVX2__)
+			static inline __m256i avx(const __m256i a, const __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+#if defined(__SSE2__)
+			static inline __m128i sse(const __m128i a, const __m128i b) { return _mm_and_si128(a, b); }
+#endif
+		};
+
+		/** @brief a & ~b (note: _mm_andnot negates its first operand) */
+		struct andnot_op
+		{
+			static inline T scalar(const T a, const T b) { return a & ~b; }
+#if defined(__AVX2__)
+			static inline __m256i avx(const __m256i a, const __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+#if defined(__SSE2__)
+			static inline __m128i sse(const __m128i a, const __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+		};
+
+		/**
+		 * @brief C = A op B on all blocks, widest registers first
+		 * 
+		 * C may alias A or B. Block arrays are 32-byte aligned, so register
+		 * loads/stores at multiples of 32 (16) bytes are aligned.
+		 */
+		template <class OP>
+		static inline void apply_(const T *A, const T *B, T *C)
+		{
+			int j = 0;
+
+#if defined(__AVX2__)
+			for (; j + blocks_per_256_ <= sz_; j += blocks_per_256_)
+				_mm256_store_si256((__m256i *)(C + j), OP::avx(_mm256_load_si256((const __m256i *)(A + j)),
+															  _mm256_load_si256((const __m256i *)(B + j))));
+#endif
+#if defined(__SSE2__)
+			for (; j + blocks_per_128_ <= sz_; j += blocks_per_128_)
+				_mm_store_si128((__m128i *)(C + j), OP::sse(_mm_load_si128((const __m128i *)(A + j)),
+														   _mm_load_si128((const __m128i *)(B + j))));
+#endif
+
+			for (; j < sz_; j++)
+				C[j] = OP::scalar(A[j], B[j]);
+		}
+
+		/**
+		 * @brief Equality of all blocks, widest registers first
+		 */
+		static inline bool equal_(const T *A, const T *B)
+		{
+			int j = 0;
+
+#if defined(__AVX2__)
+			for (; j + blocks_per_256_ <= sz_; j += blocks_per_256_)
+			{
+				const __m256i x = _mm256_xor_si256(_mm256_load_si256((const __m256i *)(A + j)),
+												   _mm256_load_si256((const __m256i *)(B + j)));
+
+				if (!_mm256_testz_si256(x, x))
+					return false;
+			}
+#endif
+#if defined(__SSE2__)
+			for (; j + blocks_per_128_ <= sz_; j += blocks_per_128_)
+			{
+				const __m128i eq = _mm_cmpeq_epi8(_mm_load_si128((const __m128i *)(A + j)),
+												  _mm_load_si128((const __m128i *)(B + j)));
+
+				if (_mm_movemask_epi8(eq) != 0xffff)
+					return false;
+			}
+#endif
+
+			for (; j < sz_; j++)
+				if (A[j] != B[j])
+					return false;
+
+			return true;
+		}
+
 		/**
 		 * @brief Find first set bit in block (GCC intrinsic)
 		 * @param block Block of type T to scan
@@ -455,10 +564,13 @@ namespace GOMA
 		 * @brief Count set bits in block (GCC intrinsic)
 		 * @param block Block of type T to count
 		 * @return Number of 1-bits (population count)
+		 * 
+		 * Counts all sizeof(T) bytes (__builtin_popcount would truncate
+		 * 64-bit blocks to their low 32 bits).
 		 */
 		int cardinality(T block) const
 		{
-			return __builtin_popcount(block);
+			return __builtin_popcountll((unsigned long long)(typename make_unsigned<T>::type)block);
 		}
 
 		/**
@@ -15,6 +15,9 @@
 #include "fixed_bitset.hpp"
 #include "matrix.hpp"
 #include "bitset.hpp"
+#include "stats_timer.hpp"
+#include "search_deadline.hpp"
+#include "ragged_array.hpp"
 #include <vector>
 #include <set>
 #include <stack>
@@ -111,6 +114,19 @@ namespace GOMA
         void clear_(void);
     };
 
+    /**
+     * @struct path_label
+     * @brief Partial path of the best-first path search
+     * 
+     * The path is the parent chain of the label, from the source to id_.
+     */
+    struct path_label
+    {
+        int id_;      ///< Last vertex of the partial path
+        int parent_;  ///< Label of the path without id_ (-1 at the source)
+        double cost_; ///< Path cost (sum of arc costs)
+    };
+
     /**
      * @class node_info_stack
      * @brief Stack of node_info for DFS traversal
@@ -186,6 +202,11 @@ namespace GOMA
          * @return Number of elements in stack
          */
         int cap(void) const { return top_ + 1; }
+
+        /**
+         * @brief Heap bytes held (pre-allocated entries and their paths)
+         */
+        size_t get_memory_bytes(void) const;
     };
 
     /**
@@ -239,26 +260,30 @@ namespace GOMA
      * @class succ_list
      * @brief Adjacency list for directed graph with arc costs
      * 
-     * Efficient successor list representation using arrays.
-     * For each vertex i, maintains:
-     * - Array of successor vertices
-     * - Array of arc costs to successors
-     * - Bitset for O(1) arc existence checking
+     * Two layers:
+     * - Edit lists: per vertex, successor vertices and parallel arc costs,
+     *   grown with the arcs (O(n + arcs) memory)
+     * - Compressed (CSR) layout: all successors and costs in two contiguous
+     *   arrays plus per-vertex offsets, built by compress()
      * 
-     * Supports dynamic arc addition/removal during graph construction.
+     * Arcs are added/removed on the edit lists, which drops the compressed
+     * layout; successors() reads the compressed arrays while they are valid.
+     * Build the graph, compress() once, then search.
      */
     class succ_list
     {
     private:
         size_t n_vertices_;           ///< Number of vertices in graph
 
-        int **succ_;                  ///< Successor arrays (one per vertex)
-        double **cost_;               ///< Arc cost arrays (one per vertex)
-        int *top_;                    ///< Top index for each successor list
-
-        int *base_succ_;              ///< Base successor index (for clear)
+        vector<vector<int>> succ_;    ///< Successor lists (one per vertex)
+        vector<vector<double>> cost_; ///< Arc cost lists (one per vertex)
 
-        search_fixed_bitset *in_succ_; ///< Bitsets for fast arc existence check
+        bool compressed_;             ///< csr_* arrays match the successor lists
+        vector<int> csr_begin_;       ///< First CSR entry of each vertex (n + 1)
+        vector<int> csr_succ_;        ///< Successors of all vertices, contiguous
+        vector<double> csr_cost_;     ///< Arc costs, parallel to csr_succ_
+        vector<int> csr_pred_begin_;  ///< First predecessor entry of each vertex (n + 1)
+        vector<int> csr_pred_;        ///< Predecessors of all vertices, contiguous
 
     public:
         /**
@@ -308,6 +333,28 @@ namespace GOMA
          * @param j Target vertex
          */
         void remove_arc(const int i, const int j);
+
+        /**
+         * @brief Change the cost of an existing arc (i,j)
+         * @param i Source vertex
+         * @param j Target vertex
+         * @param cost New arc cost (no effect if the arc does not exist)
+         */
+        void set_cost(const int i, const int j, const double cost);
+
+        /**
+         * @brief Build the compressed (CSR) layout of the current arcs
+         *
+         * Successors and, for backward searches, predecessors. No effect
+         * if already compressed. Any add_arc/remove_arc/clear
+         * drops it; set_cost keeps it up to date.
+         */
+        void compress(void);
+
+        /**
+         * @brief Check whether successors() reads the compressed layout
+         */
+        inline bool is_compressed(void) const { return compressed_; }
         
         /**
          * @brief Get successors of vertex i
@@ -315,7 +362,7 @@ namespace GOMA
          * @param succ Output: pointer to successor array
          * @param sz Output: number of successors
          */
-        void successors(const int i, int *&succ, size_t &sz) const;
+        void successors(const int i, const int *&succ, size_t &sz) const;
         
         /**
          * @brief Get successors and costs of vertex i
@@ -324,20 +371,39 @@ namespace GOMA
          * @param cost Output: pointer to cost array
          * @param sz Output: number of successors
          */
-        void successors(const int i, int *&succ, double *&cost, size_t &sz) const;
+        void successors(const int i, const int *&succ, const double *&cost, size_t &sz) const;
+
+        /**
+         * @brief Get predecessors of vertex i (compressed layout only)
+         * @param i Vertex
+         * @param pred Output: pointer to predecessor array
+         * @param sz Output: number of predecessors
+         */
+        void predecessors(const int i, const int *&pred, size_t &sz) const;
 
         /**
          * @brief Get number of successors of vertex
          * @param vertex_i Vertex ID
          * @return Number of outgoing arcs from vertex_i
          */
-        size_t get_n_succ(const int vertex_i) const { return top_[vertex_i] + 1; }
+        size_t get_n_succ(const int vertex_i) const { return succ_[vertex_i].size(); }
+
+        /**
+         * @brief Get number of vertices
+         */
+        inline size_t get_n_vertices(void) const { return n_vertices_; }
+
+        /**
+         * @brief Heap bytes held (edit lists and compressed arrays, capacities)
+         */
+        size_t get_memory_bytes(void) const;
 
     private:
         /**
-         * @brief Deallocate all internal arrays
+         * @brief Position of j in the successor list of i
+         * @return Index in succ_[i], or -1 if (i,j) is not an arc
          */
-        void clear_(void);
+        int find_(const int i, const int j) const;
     };
 
     /**
@@ -395,6 +461,66 @@ namespace GOMA
         search_fixed_bitset &at(int i) { return table_[i]; }
     };
 
+    /**
+     * @class search_workspace
+     * @brief Mutable state of a path search on a search_graph
+     * 
+     * backtrack_DFS() and best_first_paths() keep all their state here, so
+     * several threads can search the same (unchanged) graph at the same
+     * time, each with its own workspace.
+     */
+    class search_workspace
+    {
+    public:
+        std::vector<int> path_;          ///< Current path of backtrack_DFS (one vertex per depth)
+        std::vector<size_t> next_succ_;  ///< Successors left to try at each depth of backtrack_DFS
+        search_fixed_bitset on_path_;    ///< Vertices on the current path of backtrack_DFS
+        search_fixed_bitset reach_;      ///< Vertices that reach the target (pruned searches)
+        std::vector<int> queue_;         ///< Backward search queue (pruned searches)
+        std::vector<int> target_slot_;   ///< Output slot of each target vertex, -1 otherwise (multi-target backtrack_DFS)
+
+        std::vector<path_label> labels_; ///< Labels of best_first_paths (capacity kept between calls)
+
+        size_t n_expanded_;              ///< Vertices entered / labels extended by the searches (USE_STATS)
+        size_t n_donated_;               ///< Frontiers handed to idle workers by stealing_DFS (USE_STATS)
+
+    public:
+        /**
+         * @brief Construct workspace for graphs of up to n vertices
+         * @param n_vertices Number of vertices
+         */
+        search_workspace(const size_t n_vertices);
+
+        /**
+         * @brief Default constructor - empty workspace
+         */
+        search_workspace(void);
+
+        virtual ~search_workspace(void);
+
+        /**
+         * @brief Heap bytes held (labels_ keeps the capacity of the largest best_first_paths call)
+         */
+        size_t get_memory_bytes(void) const;
+    };
+
+    /**
+     * @struct search_frontier
+     * @brief Unexplored subtrees of a backtrack_DFS search, handed to another worker
+     *
+     * The subtrees below the first n_succ_ successors of prefix_.back(),
+     * which the search tries from the last one (n_succ_ - 1) to the first.
+     */
+    struct search_frontier
+    {
+        std::vector<int> prefix_;     ///< Path from the source to the vertex whose successors are left
+        search_fixed_bitset on_path_; ///< Vertices of prefix_
+        size_t n_succ_;               ///< Successors left to try
+        size_t slot_;                 ///< Output slot of the paths found below them
+    };
+
+    class search_steal_pool; ///< Shared state of one stealing_DFS call (graph.cpp)
+
     /**
      * @class search_graph
      * @brief Directed graph with DFS path enumeration
@@ -428,6 +554,14 @@ namespace GOMA
 
         GOMA::bitset active_vertices_;   ///< Set of vertices with incident arcs
 
+        search_workspace workspace_;     ///< State of backtrack_DFS / best_first_paths calls without workspace
+
+        vector<int> component_;          ///< Strongly connected component of each vertex
+        size_t n_components_;            ///< Number of strongly connected components
+        bool components_valid_;          ///< component_ matches the current arcs
+
+        bool pruning_;                   ///< Skip vertices that cannot reach the target
+
     public:
         /**
          * @brief Construct graph with n vertices
@@ -453,16 +587,126 @@ namespace GOMA
          */
         void add_arc(const int i, const int j, const double arc_cost = 0.0);
 
+        /**
+         * @brief Remove directed arc (i,j)
+         * @param i Source vertex
+         * @param j Target vertex
+         *
+         * O(degree(i)). No effect if the arc does not exist.
+         */
+        void remove_arc(const int i, const int j);
+
+        /**
+         * @brief Change the cost of an existing arc
+         * @param i Source vertex
+         * @param j Target vertex
+         * @param arc_cost New cost
+         */
+        void set_arc_cost(const int i, const int j, const double arc_cost);
+
+        /**
+         * @brief Check if arc (i,j) exists
+         * @param i Source vertex
+         * @param j Target vertex
+         * @return true if the arc is in the graph
+         */
+        inline bool is_arc(const int i, const int j) const { return succ_.is_arc(i, j); }
+
+        /**
+         * @brief Get successors of vertex i
+         * @param i Vertex
+         * @param succ Output: pointer to successor array
+         * @param sz Output: number of successors
+         */
+        inline void successors(const int i, const int *&succ, size_t &sz) const { succ_.successors(i, succ, sz); }
+
+        /**
+         * @brief Pack the arcs into one contiguous (CSR) layout for the searches
+         *
+         * Call once after building or updating the graph; later arc
+         * additions/removals fall back to the per-vertex lists until the
+         * next call.
+         */
+        void compress(void);
+
+        /**
+         * @brief Compute the strongly connected components of the graph
+         *
+         * Iterative Tarjan, O(V + E). Valid until the next arc addition
+         * or removal. Pruned searches between two vertices of the same
+         * component only look inside that component.
+         */
+        void find_components(void);
+
+        /**
+         * @brief Component of a vertex (after find_components())
+         * @param v Vertex
+         * @return Component index
+         */
+        inline int get_component(const int v) const { return component_[v]; }
+
+        inline size_t get_n_components(void) const { return n_components_; }
+        inline bool has_components(void) const { return components_valid_; }
+
+        /**
+         * @brief Enable reachability pruning of the path searches
+         * @param pruning true: backtrack_DFS / best_first_paths never enter
+         *        a vertex that cannot reach the target
+         *
+         * Only applies to a compressed graph (compress()), whose
+         * predecessor lists give the backward search from the target.
+         * Paths and their order are the same as without pruning: only
+         * dead ends are skipped.
+         */
+        inline void set_pruning(const bool pruning) { pruning_ = pruning; }
+        inline bool get_pruning(void) const { return pruning_; }
+
         /**
          * @brief Clear all arcs and reset internal state
          */
         void clear();
 
+        /**
+         * @brief Get number of vertices
+         * @return Number of vertices given at construction
+         */
+        inline size_t get_n_vertices(void) const { return n_vertices_; }
+
+        /**
+         * @brief Search nodes expanded on the internal workspace (USE_STATS)
+         * @return Vertices entered by backtrack_DFS and labels extended by
+         *         best_first_paths, over the calls without workspace
+         */
+        inline size_t get_n_expanded(void) const { return workspace_.n_expanded_; }
+
+        /**
+         * @brief Heap bytes of the adjacency lists (succ_list)
+         */
+        inline size_t get_succ_bytes(void) const { return succ_.get_memory_bytes(); }
+
+        /**
+         * @brief Heap bytes of the pre-allocated DFS stack (node_info_stack, n (n - 1) entries)
+         */
+        inline size_t get_stack_bytes(void) const { return stack_.get_memory_bytes(); }
+
+        /**
+         * @brief Heap bytes of the internal search workspace
+         */
+        inline size_t get_workspace_bytes(void) const { return workspace_.get_memory_bytes(); }
+
+        /**
+         * @brief Heap bytes held by the graph (adjacency lists, stack, internal workspace, components)
+         */
+        size_t get_memory_bytes(void) const;
+
         /**
          * @brief Find all simple paths from source to target using DFS
          * @param source Starting vertex (0-indexed)
          * @param target Destination vertex (0-indexed)
          * @param p Output: vector of all simple paths found
+         * @param deadline Stop token (NULL: none), polled every 1024 pops
+         * @return false if the deadline stopped the search (p holds the
+         *         paths found until then)
          * 
          * Performs iterative depth-first search to enumerate all simple
          * paths (paths with no repeated vertices) from source to target.
@@ -481,7 +725,148 @@ namespace GOMA
          * @note Paths are found in reverse DFS order
          * @note Only simple paths (no cycles) are returned
          */
-        void DFS(const int source, const int target, vector<vector<int>> &p);
+        bool DFS(const int source, const int target, vector<vector<int>> &p, const search_deadline *deadline = NULL);
+
+        /**
+         * @brief Find all simple paths from source to target by backtracking
+         * @param source Starting vertex (0-indexed)
+         * @param target Destination vertex (0-indexed)
+         * @param p Output: all simple paths found, one list of vertices each
+         * @param deadline Stop token (NULL: none), polled every 1024 steps
+         * @return false if the deadline stopped the search (p holds the
+         *         paths found until then, a prefix of the full output)
+         * 
+         * Same output as DFS() (same paths, in the same order), but the
+         * search keeps a single path array and one visited bitset that are
+         * updated in place when a vertex is entered or left. No node state
+         * is copied and nothing is allocated during the search: the paths
+         * are copied into p, which keeps its capacity when reused.
+         * 
+         * Successors are tried from last to first, which is the order in
+         * which DFS() pops them from its stack.
+         * 
+         * Space complexity: O(V) for the path and successor cursors
+         */
+        bool backtrack_DFS(const int source, const int target, ragged_array<int> &p, const search_deadline *deadline = NULL);
+
+        /**
+         * @brief backtrack_DFS() with caller-owned search state
+         * @param source Starting vertex (0-indexed)
+         * @param target Destination vertex (0-indexed)
+         * @param p Output: all simple paths found
+         * @param ws Search state (built for at least get_n_vertices() vertices)
+         * @param deadline Stop token (NULL: none)
+         * @return false if the deadline stopped the search
+         * 
+         * Does not modify the graph, so it may run concurrently on
+         * different workspaces.
+         */
+        bool backtrack_DFS(const int source, const int target, ragged_array<int> &p, search_workspace &ws,
+                           const search_deadline *deadline = NULL) const;
+
+        /**
+         * @brief backtrack_DFS() of one source and target on several threads
+         * @param source Starting vertex (0-indexed)
+         * @param target Destination vertex (0-indexed)
+         * @param p Output: all simple paths found, in the order of backtrack_DFS()
+         * @param ws One search state per worker (each built for at least
+         *        get_n_vertices() vertices); the calling thread uses ws[0]
+         * @param deadline Stop token (NULL: none)
+         * @return false if the deadline stopped the search (p holds the
+         *         paths found until then, not necessarily a prefix)
+         *
+         * Work stealing: the workers start idle but one, which searches from
+         * the source. A busy worker that sees an idle one hands it the
+         * untried successors of the shallowest vertex of its path that has
+         * any (a search_frontier: the path up to that vertex and its on-path
+         * bitset) and keeps the branch it is in. Every frontier writes its
+         * own output slot, linked right after the slot of the worker that
+         * gave it: the subtrees handed over are the ones its search would
+         * have reached after the current branch. The slots are concatenated
+         * in list order, so the paths and their order do not depend on the
+         * number of threads or on who stole what. Does not modify the graph.
+         */
+        bool stealing_DFS(const int source, const int target, ragged_array<int> &p, vector<search_workspace> &ws,
+                          const search_deadline *deadline = NULL) const;
+
+        /**
+         * @brief Find all simple paths from source to each of several targets in one traversal
+         * @param source Starting vertex (0-indexed)
+         * @param targets Destination vertices (distinct)
+         * @param p Output: p[k] holds the paths to targets[k], in the order
+         *        backtrack_DFS(source, targets[k], ...) returns them (p is
+         *        resized to the number of targets; arrays kept from a
+         *        previous call keep their capacity)
+         * @param ws Search state (built for at least get_n_vertices() vertices)
+         * @param deadline Stop token (NULL: none)
+         * @return false if the deadline stopped the search (each p[k] holds
+         *         a prefix of its full output)
+         * 
+         * Targets are expanded as any other vertex, so the traversal covers
+         * the union of the single-target search trees once instead of
+         * once per target. Does not modify the graph.
+         */
+        bool backtrack_DFS(const int source, const vector<int> &targets, vector<ragged_array<int>> &p,
+                           search_workspace &ws, const search_deadline *deadline = NULL) const;
+
+        /**
+         * @brief Find the k cheapest simple paths from source to target
+         * @param source Starting vertex (0-indexed)
+         * @param target Destination vertex (0-indexed)
+         * @param k Maximum number of paths
+         * @param time_limit Time budget in seconds (≤ 0: no limit)
+         * @param p Output: paths found, cheapest first
+         * @param costs Output: cost of each path (sum of the add_arc costs)
+         * 
+         * Best-first search on partial paths ordered by cost. Arc costs must
+         * be nonnegative. When the time limit is reached, the paths found so
+         * far are returned (they are still the cheapest ones, in order).
+         * 
+         * @note Without limits this enumerates the same paths as DFS(), so a
+         *       small k (or time limit) should be used on dense graphs
+         */
+        void best_first_paths(const int source, const int target, const size_t k, const double time_limit,
+                              ragged_array<int> &p, vector<double> &costs);
+
+        /**
+         * @brief best_first_paths() with caller-owned search state
+         * @param ws Search state (any size)
+         * 
+         * Other parameters as in best_first_paths(). Does not modify the
+         * graph, so it may run concurrently on different workspaces.
+         */
+        void best_first_paths(const int source, const int target, const size_t k, const double time_limit,
+                              ragged_array<int> &p, vector<double> &costs, search_workspace &ws) const;
+
+    private:
+        /**
+         * @brief Mark in ws.reach_ the vertices that reach a target
+         * @param source Source vertex
+         * @param targets Target vertices
+         * @param n_targets Number of targets
+         * @param ws Search state
+         * @return false if source reaches no target (no path)
+         *
+         * Backward breadth-first search from the targets over the compressed
+         * predecessor lists, restricted to the component of source when
+         * all targets are in it.
+         */
+        bool mark_reaching_(const int source, const int *targets, const size_t n_targets, search_workspace &ws) const;
+
+        /**
+         * @brief Worker of stealing_DFS: searches the frontiers of the pool until none is left
+         * @param target Destination vertex
+         * @param pool Shared frontiers, output slots and idle count
+         * @param ws Search state of the worker
+         * @param deadline Stop token (NULL: none)
+         */
+        void steal_worker_(const int target, search_steal_pool &pool, search_workspace &ws,
+                           const search_deadline *deadline) const;
+
+        /**
+         * @brief Check whether the searches of the current call are pruned
+         */
+        inline bool is_pruned_(void) const { return pruning_ && succ_.is_compressed(); }
     };
 
 }
\ No newline at end of file
@@ -4,6 +4,11 @@
  * 
  * This module provides a flexible 2D matrix implementation with 1-based indexing,
  * supporting dynamic resizing, I/O operations, and efficient memory management.
+ *
+ * The storage is aligned on a cache line and rows of a cache line or more
+ * are padded to a whole number of lines, so that every such row starts on
+ * a line. Inner loops over a row read it through row(i) as a contiguous
+ * array, without the index arithmetic and asserts of operator()(i, j).
  */
 
 #pragma once
@@ -11,11 +16,17 @@
 #include <iostream>
 #include <iomanip>
 #include <cassert>
+#include <memory>
+#include <new>
+
+#include "array_view.hpp"
 
 /// Default column width for matrix output formatting
 #define WIDE 6
 /// Default precision for floating-point matrix output
 #define PRECISION 1
+/// Alignment of the matrix storage and of its padded rows (bytes, one cache line)
+#define MATRIX_ALIGN 64
 
 using namespace std;
 
@@ -30,6 +41,7 @@ namespace GOMA
      * 
      * - **1-based indexing**: Uses mathematical notation (1,1) for first element
      * - **0-based raw access**: Also supports operator[] for raw memory access
+     * - **Row access**: row(i) is a contiguous, aligned array (padded stride)
      * - **Dynamic resizing**: Can resize with or without preserving existing data
      * - **Memory management**: RAII-compliant with proper copy semantics
      * - **I/O support**: Read/write operations with formatting
@@ -37,7 +49,10 @@ namespace GOMA
      * 
      * @tparam T Element type (typically int, double, or float)
      * 
-     * @note This class uses row-major storage order
+     * @note This class uses row-major storage order with a row stride of
+     *       get_stride() ≥ n elements: element (i, j) is at
+     *       (i - 1) * get_stride() + j - 1. The padding holds the fill()
+     *       value and is not part of the matrix
      * @warning Assertion failures occur on out-of-bounds access in debug mode
      * 
      * @example
@@ -54,16 +69,23 @@ namespace GOMA
      * 
      * // Write to stream (formatted output)
      * std::cout << M;
+     *
+     * // Row i as a contiguous array: element j at [j - 1]
+     * const double *M_i{M.row(i)};
+     *
+     * for (size_t j{0}; j < M.get_n(); j++)
+     *     sum += M_i[j];
      * ```
      */
     template <class T>
     class matrix
     {
     private:
-        size_t m_; ///< Number of rows
-        size_t n_; ///< Number of columns
+        size_t m_;  ///< Number of rows
+        size_t n_;  ///< Number of columns
+        size_t ld_; ///< Row stride (n_ rounded up to whole cache lines)
 
-        T *v_; ///< Data storage (row-major order)
+        T *v_; ///< Data storage (row-major order, MATRIX_ALIGN-aligned)
 
     public:
         /**
@@ -71,6 +93,7 @@ namespace GOMA
          */
         matrix(void) : m_(0),
                        n_(0),
+                       ld_(0),
                        v_(NULL) {}
 
         /**
@@ -80,6 +103,7 @@ namespace GOMA
          */
         matrix(int m, int n) : m_(m),
                                n_(n),
+                               ld_(stride(n)),
                                v_(NULL)
         {
             build();
@@ -93,6 +117,7 @@ namespace GOMA
          */
         matrix(int m, int n, T data) : m_(m),
                                        n_(n),
+                                       ld_(stride(n)),
                                        v_(NULL)
         {
             build();
@@ -106,11 +131,12 @@ namespace GOMA
          */
         matrix(const matrix &M) : m_(M.m_),
                                   n_(M.n_),
+                                  ld_(M.ld_),
                                   v_(NULL)
         {
             build();
 
-            copy(M.v_, M.m_, M.n_, v_, m_, n_);
+            copy(M.v_, m_ * ld_, v_);
         }
 
         /**
@@ -118,10 +144,7 @@ namespace GOMA
          */
         virtual ~matrix(void)
         {
-            if (v_)
-            {
-                delete[] v_;
-            }
+            release(v_, m_ * ld_);
         }
 
         /**
@@ -135,8 +158,11 @@ namespace GOMA
             if (m == m_ && n == n_)
                 return;
 
+            release(v_, m_ * ld_);
+
             m_ = m;
             n_ = n;
+            ld_ = stride(n);
 
             build();
 
@@ -154,36 +180,23 @@ namespace GOMA
             if (m == m_ && n == n_)
                 return;
 
-            T *v;
+            const size_t ld{stride(n)};
+
+            T *v{allocate(m * ld)};
 
-            build(v, m, n);
+            const size_t l_m = min(m, m_);
+            const size_t l_n = min(n, n_);
 
-            copy(v_, m_, n_, v, m, n);
+            for (size_t i = 0; i < l_m; i++)
+                copy(v_ + i * ld_, l_n, v + i * ld);
+
+            release(v_, m_ * ld_);
 
             v_ = v;
 
             m_ = m;
             n_ = n;
-        }
-
-        /**
-         * @brief Copy data from one matrix buffer to another
-         * @param v Source buffer
-         * @param m Source rows
-         * @param n Source columns
-         * @param w Destination buffer (output)
-         * @param p Destination rows
-         * @param q Destination columns
-         * @note Copies min(m,p) x min(n,q) elements
-         */
-        void copy(T *v, size_t m, size_t n, T *&w, size_t p, size_t q)
-        {
-            const size_t l_m = min(m, p);
-            const size_t l_n = min(n, q);
-
-            for (size_t i = 1; i <= l_m; i++)
-                for (size_t j = 1; j <= l_n; j++)
-                    w[pos(q, i, j)] = v[pos(i, j)];
+            ld_ = ld;
         }
 
         /**
@@ -202,7 +215,7 @@ namespace GOMA
          */
         void fill(T data)
         {
-            const size_t sz = m_ * n_;
+            const size_t sz = m_ * ld_;
 
             T *v_ptr{v_};
 
@@ -215,30 +228,67 @@ namespace GOMA
 
         /**
          * @brief 0-based raw array access (mutable)
-         * @param i Linear index into raw storage
+         * @param i Linear index into raw storage (padded rows, see pos())
          * @return Reference to element at position i
-         * @warning Asserts i < m*n in debug mode
+         * @warning Asserts i < m*stride in debug mode
          */
         T &operator[](size_t i)
         {
-            assert(i < m_ * n_);
+            assert(i < m_ * ld_);
 
             return v_[i];
         }
 
         /**
          * @brief 0-based raw array access (const)
-         * @param i Linear index into raw storage
+         * @param i Linear index into raw storage (padded rows, see pos())
          * @return Const reference to element at position i
-         * @warning Asserts i < m*n in debug mode
+         * @warning Asserts i < m*stride in debug mode
          */
         const T &operator[](size_t i) const
         {
-            assert(i < m_ * n_);
+            assert(i < m_ * ld_);
 
             return v_[i];
         }
 
+        /**
+         * @brief Row as a contiguous array (mutable)
+         * @param i Row index (1-based)
+         * @return Pointer to element (i, 1): element (i, j) is at [j - 1]
+         * @note Aligned on MATRIX_ALIGN if a row fills a cache line
+         */
+        inline T *row(size_t i)
+        {
+            assert(i >= 1);
+            assert(i <= m_);
+
+            return v_ + (i - 1) * ld_;
+        }
+
+        /**
+         * @brief Row as a contiguous array (const)
+         * @param i Row index (1-based)
+         * @return Pointer to element (i, 1): element (i, j) is at [j - 1]
+         */
+        inline const T *row(size_t i) const
+        {
+            assert(i >= 1);
+            assert(i <= m_);
+
+            return v_ + (i - 1) * ld_;
+        }
+
+        /**
+         * @brief Read-only view of a row
+         * @param i Row index (1-based)
+         * @return View of the n elements of row i (0-based)
+         */
+        inline array_view<T> row_view(size_t i) const
+        {
+            return array_view<T>(row(i), n_);
+        }
+
         /**
          * @brief 1-based matrix element access (mutable)
          * @param i Row index (1-based)
@@ -327,7 +377,7 @@ namespace GOMA
                 resize(M.m_, M.n_);
             }
 
-            copy(M.v_, M.m_, M.n_, v_, m_, n_);
+            copy(M.v_, m_ * ld_, v_);
 
             return *this;
         }
@@ -368,6 +418,23 @@ namespace GOMA
             return n_;
         }
 
+        /**
+         * @brief Get the row stride (elements from (i, j) to (i + 1, j))
+         * @return n rounded up to whole cache lines (n if a row is shorter than a line)
+         */
+        inline size_t get_stride(void) const
+        {
+            return ld_;
+        }
+
+        /**
+         * @brief Heap bytes held by the elements
+         */
+        inline size_t get_memory_bytes(void) const
+        {
+            return v_ ? m_ * ld_ * sizeof(T) : 0;
+        }
+
         /**
          * @brief Compute transpose of this matrix
          * @param M [output] Transposed matrix (will be resized to n x m)
@@ -428,69 +495,81 @@ namespace GOMA
          * @brief Convert 1-based (i,j) indices to 0-based linear index
          * @param i Row index (1-based)
          * @param j Column index (1-based)
-         * @return Linear index in row-major storage
+         * @return Linear index in row-major storage (padded rows)
          */
-        inline int pos(size_t i, size_t j) const
+        inline size_t pos(size_t i, size_t j) const
         {
-            return (i - 1) * n_ + j - 1;
+            return (i - 1) * ld_ + j - 1;
         }
 
         /**
-         * @brief Convert 1-based (i,j) indices to 0-based linear index (static version)
+         * @brief Row stride of a matrix with n columns
          * @param n Number of columns
-         * @param i Row index (1-based)
-         * @param j Column index (1-based)
-         * @return Linear index in row-major storage
+         * @return n rounded up to whole MATRIX_ALIGN lines, n if a row is
+         *         shorter than a line (short rows are not padded)
          */
-        inline int pos(size_t n, size_t i, size_t j)
+        static size_t stride(size_t n)
         {
-            return (i - 1) * n + j - 1;
+            const size_t line{MATRIX_ALIGN / sizeof(T)};
+
+            if (MATRIX_ALIGN % sizeof(T) != 0 || n < line)
+                return n;
+
+            return (n + line - 1) / line * line;
         }
 
     private:
         /**
          * @brief Allocate memory for matrix data
-         * @note Deletes existing memory before allocating
+         * @note The previous storage must have been released
          */
         void build(void)
         {
-            if (v_)
-            {
-                delete[] v_;
-            }
+            v_ = allocate(m_ * ld_);
+        }
 
-            if (m_ * n_ > 0)
-            {
-                v_ = new T[m_ * n_];
-            }
-            else
-            {
-                v_ = NULL;
-            }
+        /**
+         * @brief Allocate an aligned buffer
+         * @param sz Number of elements
+         * @return Default-initialized elements, NULL if sz is 0
+         */
+        static T *allocate(size_t sz)
+        {
+            if (sz == 0)
+                return NULL;
+
+            T *v{static_cast<T *>(::operator new[](sz * sizeof(T), align_val_t(MATRIX_ALIGN)))};
+
+            uninitialized_default_construct_n(v, sz);
+
+            return v;
         }
 
         /**
-         * @brief Allocate memory for external buffer
-         * @param v Buffer pointer (will be deleted and reallocated)
-         * @param m Number of rows
-         * @param n Number of columns
+         * @brief Free a buffer of allocate()
+         * @param v Buffer (NULL: nothing to do)
+         * @param sz Number of elements
          */
-        void
-        build(T *v, size_t m, size_t n)
+        static void release(T *v, size_t sz)
         {
-            if (v)
-            {
-                delete[] v;
-            }
+            if (v == NULL)
+                return;
 
-            if (m * n > 0)
-            {
-                v = new T[m * n];
-            }
-            else
-            {
-                v = NULL;
-            }
+            destroy_n(v, sz);
+
+            ::operator delete[](v, align_val_t(MATRIX_ALIGN));
+        }
+
+        /**
+         * @brief Copy elements between buffers
+         * @param v Source
+         * @param sz Number of elements
+         * @param w Destination
+         */
+        static void copy(const T *v, size_t sz, T *w)
+        {
+            for (size_t k = 0; k < sz; k++)
+                w[k] = v[k];
         }
     };
 }
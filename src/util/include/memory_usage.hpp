@@ -0,0 +1,92 @@
+/**
+ * @file memory_usage.hpp
+ * @brief Heap bytes held by containers, and process memory
+ *
+ * The model and search structures report the bytes they hold
+ * (get_memory_bytes()) with these helpers, so the memory of a large
+ * instance can be split by structure without a heap profiler. Vectors
+ * count their capacity, not their size: what is allocated, not what is
+ * used. The process figures (resident set) cover what the structures do
+ * not report, such as the memory inside the LP solvers.
+ *
+ * Example:
+ * @code
+ * size_t bytes{vector_bytes(successors_) + vector_bytes(routes_)};
+ * cerr << process_peak_rss_bytes() << endl;
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @brief Heap bytes of a vector of plain elements (capacity)
+     */
+    template <class T>
+    inline size_t vector_bytes(const vector<T> &v)
+    {
+        return v.capacity() * sizeof(T);
+    }
+
+    /**
+     * @brief Heap bytes of a vector of bits
+     */
+    inline size_t vector_bytes(const vector<bool> &v)
+    {
+        return (v.capacity() + 7) / 8;
+    }
+
+    /**
+     * @brief Heap bytes of a string (short strings are stored inline)
+     */
+    inline size_t string_bytes(const string &s)
+    {
+        return s.capacity() > 15 ? s.capacity() + 1 : 0;
+    }
+
+    /**
+     * @brief Heap bytes of a vector of strings
+     */
+    inline size_t vector_bytes(const vector<string> &v)
+    {
+        size_t bytes{v.capacity() * sizeof(string)};
+
+        for (const string &s : v)
+            bytes += string_bytes(s);
+
+        return bytes;
+    }
+
+    /**
+     * @brief Heap bytes of a vector of vectors (outer and inner capacities)
+     */
+    template <class T>
+    inline size_t vector_bytes(const vector<vector<T>> &v)
+    {
+        size_t bytes{v.capacity() * sizeof(vector<T>)};
+
+        for (const vector<T> &w : v)
+            bytes += vector_bytes(w);
+
+        return bytes;
+    }
+
+    /**
+     * @brief Resident set size of the process (Linux /proc/self/statm)
+     * @return Bytes, 0 if not available
+     */
+    size_t process_rss_bytes(void);
+
+    /**
+     * @brief Largest resident set size of the process so far (getrusage)
+     * @return Bytes, 0 if not available
+     */
+    size_t process_peak_rss_bytes(void);
+}
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "matrix.hpp"
+#include "sparse_matrix.hpp"
 #include <vector>
 #include <string>
 #include <utility>
@@ -40,7 +41,7 @@ namespace GOMA
         vector<char> sense_;
         vector<double> rhs_;
 
-        matrix<double> M_;
+        sparse_matrix<double> M_;
         int nz_;
 
         vector<string> var_labels_;
@@ -60,7 +61,7 @@ namespace GOMA
         inline const vector<int> &get_ctype(void) const { return ctype_; }
         inline const vector<char> &get_sense(void) const { return sense_; }
         inline const vector<double> &get_rhs(void) const { return rhs_; }
-        inline const matrix<double> &get_M(void) const { return M_; }
+        inline const sparse_matrix<double> &get_M(void) const { return M_; }
         inline int get_nz(void) const { return nz_; }
         inline const vector<string> &get_var_labels(void) const { return var_labels_; }
         inline const vector<string> &get_cons_labels(void) const { return cons_labels_; }
@@ -69,19 +70,39 @@ namespace GOMA
         inline string get_name(void) const { return name_; }
         inline const vector<pair<double, double>> &get_bounds(void) const { return bounds_; }
 
+        /**
+         * @brief Heap bytes held by the model (M_ included, see get_M().get_memory_bytes())
+         */
+        size_t get_memory_bytes(void) const;
+
         void set_n_col(int n_col) { n_col_ = n_col; }
         void set_n_row(int n_row) { n_row_ = n_row; }
         void set_obj(const vector<double> &obj) { obj_ = obj; }
         void set_bd(const vector<int> &bd) { bd_ = bd; }
         void set_sense(const vector<char> &sense) { sense_ = sense; }
         void set_rhs(const vector<double> &rhs) { rhs_ = rhs; }
-        void set_M(const matrix<double> &M) { M_ = M; }
+        void set_M(const sparse_matrix<double> &M) { M_ = M; }
         void set_nz(int nz) { nz_ = nz; }
         void set_var_labels(const vector<string> &var_labels) { var_labels_ = var_labels; }
         void set_cons_labels(const vector<string> &cons_labels) { cons_labels_ = cons_labels; }
         void set_obj_sense(int obj_sense) { obj_sense_ = obj_sense; }
         void set_prob_type(int prob_type) { prob_type_ = prob_type; }
 
+        /**
+         * @brief Whether models built from now on fill var_labels_ / cons_labels_
+         *
+         * Labels are only read when a model is written (write_model) and cost
+         * one string per column and row, so they are off by default. A model
+         * without labels is loaded unnamed; the solvers write their generic
+         * names instead.
+         *
+         * ```cpp
+         * GOMA::model_description::set_labels(true);   // before building the model to export
+         * ```
+         */
+        static void set_labels(const bool labels);
+        static bool get_labels(void);
+
     protected:
         void set_dual_(const model_description &primal);
         void set_cons_sense_rhs_(const model_description &primal);
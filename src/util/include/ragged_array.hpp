@@ -0,0 +1,247 @@
+/**
+ * @file ragged_array.hpp
+ * @brief List of variable-length lists in one contiguous array (items + offsets)
+ *
+ * A vector<vector<T>> makes one heap allocation per inner list, and
+ * clearing it frees them all. A ragged_array keeps the items of every list
+ * back to back in one array, with the start of each list in a second one.
+ * clear() keeps both capacities, so an array reused from call to call
+ * (an arena) stops allocating once it has held its largest contents.
+ * Lists are read through array_view.
+ *
+ * Example:
+ * @code
+ * ragged_array<int> paths;
+ *
+ * paths.push_back(path);           // vector<int> or array_view<int>
+ *
+ * for (const array_view<int> p : paths)
+ *     for (const int v : p)
+ *         ...
+ *
+ * paths.clear();                   // capacity kept for the next round
+ * @endcode
+ *
+ * @note Views of the lists are invalidated by any change of the array
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "array_view.hpp"
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class ragged_array
+     * @brief Append-only sequence of lists of T stored in one array
+     * @tparam T Item type (plain data)
+     */
+    template <class T>
+    class ragged_array
+    {
+    protected:
+        vector<T> items_;        ///< Items of all the lists, list after list
+        vector<size_t> offsets_; ///< First item of each list, then one past the last (size() + 1 entries)
+
+    public:
+        /**
+         * @class const_iterator
+         * @brief Forward iterator over the lists (array_view of each)
+         */
+        class const_iterator
+        {
+        private:
+            const ragged_array *array_; ///< Iterated array
+            size_t k_;                  ///< Current list
+
+        public:
+            const_iterator(const ragged_array *array, const size_t k) : array_(array), k_(k) {}
+
+            inline array_view<T> operator*(void) const { return (*array_)[k_]; }
+
+            inline const_iterator &operator++(void)
+            {
+                k_++;
+                return *this;
+            }
+
+            inline bool operator==(const const_iterator &other) const { return k_ == other.k_; }
+            inline bool operator!=(const const_iterator &other) const { return k_ != other.k_; }
+        };
+
+        ragged_array(void) : items_(), offsets_(1, 0) {}
+
+        virtual ~ragged_array(void) {}
+
+        /**
+         * @brief Number of lists
+         */
+        inline size_t size(void) const { return offsets_.size() - 1; }
+
+        inline bool empty(void) const { return offsets_.size() == 1; }
+
+        /**
+         * @brief Number of items, over all the lists
+         */
+        inline size_t n_items(void) const { return items_.size(); }
+
+        /**
+         * @brief View of list k
+         * @param k List (0-based, < size())
+         * @return View valid until the array changes
+         */
+        inline array_view<T> operator[](const size_t k) const
+        {
+            assert(k + 1 < offsets_.size());
+            return array_view<T>(items_.data() + offsets_[k], offsets_[k + 1] - offsets_[k]);
+        }
+
+        inline array_view<T> back(void) const { return (*this)[size() - 1]; }
+
+        inline const_iterator begin(void) const { return const_iterator(this, 0); }
+        inline const_iterator end(void) const { return const_iterator(this, size()); }
+
+        /**
+         * @brief Remove all the lists, keeping the allocated memory
+         */
+        inline void clear(void)
+        {
+            items_.clear();
+            offsets_.resize(1);
+        }
+
+        /**
+         * @brief Allocate room for a number of lists and items
+         * @param n_lists Lists
+         * @param n_items Items, over all the lists
+         */
+        inline void reserve(const size_t n_lists, const size_t n_items)
+        {
+            offsets_.reserve(n_lists + 1);
+            items_.reserve(n_items);
+        }
+
+        /**
+         * @brief Append a list
+         * @param list Items of the list (a vector converts implicitly; it
+         *        must not be a view of this array)
+         */
+        inline void push_back(const array_view<T> &list)
+        {
+            items_.insert(items_.end(), list.begin(), list.end());
+            offsets_.push_back(items_.size());
+        }
+
+        /**
+         * @brief Append one item to a list under construction
+         *
+         * The items appended since the last list was closed form a list
+         * once close_list() is called.
+         */
+        inline void push_item(const T &item) { items_.push_back(item); }
+
+        /**
+         * @brief Close the list under construction (see push_item)
+         */
+        inline void close_list(void) { offsets_.push_back(items_.size()); }
+
+        /**
+         * @brief Remove the last list
+         */
+        inline void pop_back(void)
+        {
+            assert(!empty());
+
+            offsets_.pop_back();
+            items_.resize(offsets_.back());
+        }
+
+        /**
+         * @brief Keep the first n lists
+         * @param n Lists kept (≤ size())
+         */
+        inline void truncate(const size_t n)
+        {
+            assert(n <= size());
+
+            offsets_.resize(n + 1);
+            items_.resize(offsets_.back());
+        }
+
+        /**
+         * @brief Append lists [first, first + n) of another array
+         */
+        void append(const ragged_array &other, const size_t first, const size_t n)
+        {
+            assert(&other != this && first + n <= other.size());
+
+            const size_t begin{other.offsets_[first]};
+            const size_t shift{items_.size() - begin};
+
+            items_.insert(items_.end(), other.items_.begin() + begin, other.items_.begin() + other.offsets_[first + n]);
+
+            for (size_t k{first + 1}; k <= first + n; k++)
+                offsets_.push_back(other.offsets_[k] + shift);
+        }
+
+        inline void append(const ragged_array &other) { append(other, 0, other.size()); }
+
+        /**
+         * @brief Remove the lists matching a predicate, keeping the order of the others
+         * @param remove Called once per list, in order, with its view
+         * @return Number of lists removed
+         *
+         * Kept lists are moved forward in place: no allocation.
+         */
+        template <class Pred>
+        size_t remove_if(Pred remove)
+        {
+            const size_t n_lists{size()};
+
+            size_t n_kept{0};
+            size_t n_items{0};
+
+            for (size_t k{0}; k < n_lists; k++)
+            {
+                const size_t begin{offsets_[k]};
+                const size_t end{offsets_[k + 1]};
+
+                if (remove((*this)[k]))
+                    continue;
+
+                if (n_items != begin)
+                    copy(items_.begin() + begin, items_.begin() + end, items_.begin() + n_items);
+
+                n_items += end - begin;
+                offsets_[++n_kept] = n_items;
+            }
+
+            offsets_.resize(n_kept + 1);
+            items_.resize(n_items);
+
+            return n_lists - n_kept;
+        }
+
+        inline void swap(ragged_array &other)
+        {
+            items_.swap(other.items_);
+            offsets_.swap(other.offsets_);
+        }
+
+        /**
+         * @brief Heap bytes held (capacities of both arrays)
+         */
+        inline size_t get_memory_bytes(void) const
+        {
+            return items_.capacity() * sizeof(T) + offsets_.capacity() * sizeof(size_t);
+        }
+    };
+}
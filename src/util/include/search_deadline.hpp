@@ -0,0 +1,114 @@
+/**
+ * @file search_deadline.hpp
+ * @brief Deadline and cancellation token for long searches and solves
+ *
+ * A search that may take exponential time (path enumeration) or an LP
+ * solve that may stall is given a token. The search polls expired() at
+ * regular intervals and returns what it has found so far, marked as
+ * truncated; an LP is given remaining() as its time limit. Any thread may
+ * cancel() the token, e.g. a branch-and-cut node that no longer needs the
+ * answer.
+ *
+ * Example:
+ * @code
+ * search_deadline deadline(0.5);  // 500 ms from now
+ *
+ * const bool complete{graph.backtrack_DFS(s, t, paths, workspace, &deadline)};
+ *
+ * if (!complete)
+ *     ...  // paths holds the ones found before the deadline
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class search_deadline
+     * @brief Point in time (steady clock) after which searches stop, and a cancel flag
+     *
+     * expired() reads the clock, so loops should poll it every few
+     * hundred steps rather than on each one.
+     */
+    class search_deadline
+    {
+    private:
+        chrono::steady_clock::time_point deadline_; ///< Stop time (if limited_)
+        bool limited_;                              ///< A time limit is set
+        atomic<bool> cancelled_;                    ///< cancel() was called
+
+    public:
+        /**
+         * @brief Token without time limit (only cancel() stops the searches)
+         */
+        search_deadline(void) : deadline_(), limited_(false), cancelled_(false) {}
+
+        /**
+         * @brief Token expiring some time from now
+         * @param seconds Time limit (≤ 0: no limit)
+         */
+        explicit search_deadline(const double seconds) : deadline_(), limited_(false), cancelled_(false)
+        {
+            set_time_limit(seconds);
+        }
+
+        virtual ~search_deadline(void) {}
+
+        /**
+         * @brief Restart the token: expire some time from now, not cancelled
+         * @param seconds Time limit (≤ 0: no limit)
+         */
+        void set_time_limit(const double seconds)
+        {
+            limited_ = seconds > 0;
+
+            if (limited_)
+                deadline_ = chrono::steady_clock::now() +
+                            chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+
+            cancelled_.store(false, memory_order_relaxed);
+        }
+
+        /**
+         * @brief Stop the searches using the token (any thread)
+         */
+        inline void cancel(void) { cancelled_.store(true, memory_order_relaxed); }
+
+        inline bool is_cancelled(void) const { return cancelled_.load(memory_order_relaxed); }
+
+        inline bool is_limited(void) const { return limited_; }
+
+        /**
+         * @brief Check if the searches must stop
+         * @return true if cancelled or past the deadline
+         */
+        inline bool expired(void) const
+        {
+            return is_cancelled() || (limited_ && chrono::steady_clock::now() >= deadline_);
+        }
+
+        /**
+         * @brief Seconds left
+         * @return 0 if expired, infinity without time limit
+         */
+        double remaining(void) const
+        {
+            if (is_cancelled())
+                return 0.0;
+
+            if (!limited_)
+                return numeric_limits<double>::infinity();
+
+            const chrono::duration<double> left{deadline_ - chrono::steady_clock::now()};
+
+            return left.count() > 0 ? left.count() : 0.0;
+        }
+    };
+}
@@ -0,0 +1,375 @@
+/**
+ * @file sparse_matrix.hpp
+ * @brief Compressed sparse column (CSC) matrix for LP models
+ *
+ * This module provides a sparse matrix used by model_description to store
+ * constraint matrices. Entries are staged as triplets and compressed into
+ * the column-major (matbeg, matind, matval) arrays expected by CPLEX and
+ * CLP, so solver structures can point at them without copying.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class sparse_matrix
+     * @brief Sparse matrix in compressed sparse column format
+     *
+     * Usage follows two phases:
+     *
+     * 1. **Build**: resize(m, n), then insert(i, j, val) with 1-based indices
+     *    (the same convention as GOMA::matrix). The last value inserted for
+     *    a given (i, j) wins; zeros are dropped.
+     * 2. **Compress**: compress() builds the CSC arrays. After that, the
+     *    matrix can be read through get_matbeg(), get_matind(), get_matval().
+     *
+     * Memory is O(nz + n) instead of O(m·n) for the dense matrix.
+     *
+     * @tparam T Element type (typically double)
+     *
+     * @example
+     * ```cpp
+     * GOMA::sparse_matrix<double> M(3, 4);
+     * M.insert(1, 1, 1.0);
+     * M.insert(3, 2, -1.0);
+     * M.compress();
+     *
+     * const vector<int> &matbeg = M.get_matbeg();  // size n + 1
+     * ```
+     */
+    template <class T>
+    class sparse_matrix
+    {
+    private:
+        size_t m_; ///< Number of rows
+        size_t n_; ///< Number of columns
+
+        vector<int> beg_; ///< Column start offsets (n + 1, 0-based)
+        vector<int> ind_; ///< Row index of each non-zero (0-based)
+        vector<T> val_;   ///< Value of each non-zero
+
+        vector<int> t_row_; ///< Staged triplets: rows (0-based)
+        vector<int> t_col_; ///< Staged triplets: columns (0-based)
+        vector<T> t_val_;   ///< Staged triplets: values
+
+    public:
+        /**
+         * @brief Default constructor - creates an empty matrix
+         */
+        sparse_matrix(void) : m_(0),
+                              n_(0),
+                              beg_(1, 0),
+                              ind_(),
+                              val_(),
+                              t_row_(),
+                              t_col_(),
+                              t_val_() {}
+
+        /**
+         * @brief Construct an empty m x n matrix
+         * @param m Number of rows
+         * @param n Number of columns
+         */
+        sparse_matrix(size_t m, size_t n) : m_(m),
+                                            n_(n),
+                                            beg_(n + 1, 0),
+                                            ind_(),
+                                            val_(),
+                                            t_row_(),
+                                            t_col_(),
+                                            t_val_() {}
+
+        virtual ~sparse_matrix(void) {}
+
+        /**
+         * @brief Resize to m x n and remove every entry
+         * @param m New number of rows
+         * @param n New number of columns
+         */
+        void resize(size_t m, size_t n)
+        {
+            m_ = m;
+            n_ = n;
+
+            beg_.assign(n + 1, 0);
+            ind_.clear();
+            val_.clear();
+
+            t_row_.clear();
+            t_col_.clear();
+            t_val_.clear();
+        }
+
+        /**
+         * @brief Reserve space for staged entries
+         * @param nz Expected number of non-zeros
+         */
+        void reserve(size_t nz)
+        {
+            t_row_.reserve(nz);
+            t_col_.reserve(nz);
+            t_val_.reserve(nz);
+        }
+
+        /**
+         * @brief Stage entry (i, j) = val
+         * @param i Row index (1-based)
+         * @param j Column index (1-based)
+         * @param val Value
+         * @warning Asserts 1 ≤ i ≤ m and 1 ≤ j ≤ n in debug mode
+         */
+        void insert(size_t i, size_t j, T val)
+        {
+            assert(i >= 1);
+            assert(i <= m_);
+
+            assert(j >= 1);
+            assert(j <= n_);
+
+            t_row_.push_back((int)(i - 1));
+            t_col_.push_back((int)(j - 1));
+            t_val_.push_back(val);
+        }
+
+        /**
+         * @brief Build the CSC arrays from the staged entries
+         *
+         * Staged entries are merged with the already compressed ones, sorted
+         * by column and row. Duplicates keep the last inserted value.
+         */
+        void compress(void)
+        {
+            // Previously compressed entries go first, so staged ones win
+            vector<int> row;
+            vector<int> col;
+            vector<T> val;
+
+            row.reserve(ind_.size() + t_row_.size());
+            col.reserve(ind_.size() + t_row_.size());
+            val.reserve(ind_.size() + t_row_.size());
+
+            for (size_t j{0}; j < n_; j++)
+            {
+                for (int k{beg_[j]}; k < beg_[j + 1]; k++)
+                {
+                    row.push_back(ind_[k]);
+                    col.push_back((int)j);
+                    val.push_back(val_[k]);
+                }
+            }
+
+            row.insert(row.end(), t_row_.begin(), t_row_.end());
+            col.insert(col.end(), t_col_.begin(), t_col_.end());
+            val.insert(val.end(), t_val_.begin(), t_val_.end());
+
+            t_row_.clear();
+            t_col_.clear();
+            t_val_.clear();
+
+            const size_t sz{row.size()};
+
+            // Stable counting sort by row, then by column
+            vector<int> by_row(sz);
+            {
+                vector<int> cnt(m_ + 1, 0);
+
+                for (size_t k{0}; k < sz; k++)
+                    cnt[row[k] + 1]++;
+
+                for (size_t i{0}; i < m_; i++)
+                    cnt[i + 1] += cnt[i];
+
+                for (size_t k{0}; k < sz; k++)
+                    by_row[cnt[row[k]]++] = (int)k;
+            }
+
+            vector<int> by_col(sz);
+            {
+                vector<int> cnt(n_ + 1, 0);
+
+                for (size_t k{0}; k < sz; k++)
+                    cnt[col[k] + 1]++;
+
+                for (size_t j{0}; j < n_; j++)
+                    cnt[j + 1] += cnt[j];
+
+                for (size_t k{0}; k < sz; k++)
+                {
+                    const int e{by_row[k]};
+                    by_col[cnt[col[e]]++] = e;
+                }
+            }
+
+            beg_.assign(n_ + 1, 0);
+            ind_.clear();
+            val_.clear();
+
+            ind_.reserve(sz);
+            val_.reserve(sz);
+
+            size_t k{0};
+
+            for (size_t j{0}; j < n_; j++)
+            {
+                beg_[j] = (int)ind_.size();
+
+                while (k < sz && col[by_col[k]] == (int)j)
+                {
+                    // Equal (i, j) entries are contiguous in insertion order
+                    size_t last{k};
+
+                    while (last + 1 < sz && col[by_col[last + 1]] == (int)j && row[by_col[last + 1]] == row[by_col[k]])
+                        last++;
+
+                    const int e{by_col[last]};
+
+                    if (val[e] != T(0))
+                    {
+                        ind_.push_back(row[e]);
+                        val_.push_back(val[e]);
+                    }
+
+                    k = last + 1;
+                }
+            }
+
+            beg_[n_] = (int)ind_.size();
+        }
+
+        /**
+         * @brief Value of entry (i, j)
+         * @param i Row index (1-based)
+         * @param j Column index (1-based)
+         * @return Stored value, or 0 if the entry is not stored
+         * @note Searches the compressed column (staged entries are ignored)
+         */
+        T operator()(size_t i, size_t j) const
+        {
+            assert(i >= 1);
+            assert(i <= m_);
+
+            assert(j >= 1);
+            assert(j <= n_);
+
+            for (int k{beg_[j - 1]}; k < beg_[j]; k++)
+            {
+                if (ind_[k] == (int)(i - 1))
+                    return val_[k];
+            }
+
+            return T(0);
+        }
+
+        /**
+         * @brief Compute transpose of this matrix
+         * @param M [output] Transposed matrix (n x m, compressed)
+         */
+        void transpose(sparse_matrix &M) const
+        {
+            const size_t nz{ind_.size()};
+
+            M.resize(n_, m_);
+
+            M.beg_.assign(m_ + 1, 0);
+            M.ind_.resize(nz);
+            M.val_.resize(nz);
+
+            for (size_t k{0}; k < nz; k++)
+                M.beg_[ind_[k] + 1]++;
+
+            for (size_t i{0}; i < m_; i++)
+                M.beg_[i + 1] += M.beg_[i];
+
+            vector<int> next(M.beg_.begin(), M.beg_.end() - 1);
+
+            for (size_t j{0}; j < n_; j++)
+            {
+                for (int k{beg_[j]}; k < beg_[j + 1]; k++)
+                {
+                    const int p{next[ind_[k]]++};
+
+                    M.ind_[p] = (int)j;
+                    M.val_[p] = val_[k];
+                }
+            }
+        }
+
+        /**
+         * @brief Get number of rows
+         * @return Number of rows
+         */
+        inline size_t get_m(void) const { return m_; }
+
+        /**
+         * @brief Get number of columns
+         * @return Number of columns
+         */
+        inline size_t get_n(void) const { return n_; }
+
+        /**
+         * @brief Get number of rows (alias for get_m)
+         * @return Number of rows
+         */
+        inline size_t get_n_rows(void) const { return m_; }
+
+        /**
+         * @brief Get number of columns (alias for get_n)
+         * @return Number of columns
+         */
+        inline size_t get_n_cols(void) const { return n_; }
+
+        /**
+         * @brief Get number of compressed non-zeros
+         * @return Number of non-zeros
+         */
+        inline int get_nz(void) const { return (int)ind_.size(); }
+
+        /**
+         * @brief Column start offsets (size n + 1)
+         * @return CSC column starts
+         */
+        inline const vector<int> &get_matbeg(void) const { return beg_; }
+
+        /**
+         * @brief Row index of each non-zero
+         * @return CSC row indices
+         */
+        inline const vector<int> &get_matind(void) const { return ind_; }
+
+        /**
+         * @brief Value of each non-zero
+         * @return CSC values
+         */
+        inline const vector<T> &get_matval(void) const { return val_; }
+
+        /**
+         * @brief Heap bytes held (compressed arrays and staged triplets, capacities)
+         */
+        inline size_t get_memory_bytes(void) const
+        {
+            return (beg_.capacity() + ind_.capacity() + t_row_.capacity() + t_col_.capacity()) * sizeof(int) +
+                   (val_.capacity() + t_val_.capacity()) * sizeof(T);
+        }
+
+        /**
+         * @brief Write non-zeros as (row, col, value) lines (1-based)
+         * @param os Output stream
+         * @return Output stream reference
+         */
+        ostream &write(ostream &os) const
+        {
+            for (size_t j{0}; j < n_; j++)
+                for (int k{beg_[j]}; k < beg_[j + 1]; k++)
+                    os << ind_[k] + 1 << " " << j + 1 << " " << val_[k] << endl;
+
+            return os;
+        }
+    };
+}
@@ -0,0 +1,62 @@
+/**
+ * @file stats_timer.hpp
+ * @brief Compile-time switchable counters and timers of the hot paths
+ *
+ * The checkers, the LP wrapper and the path searches count their work
+ * (solves, simplex iterations, nonzeros changed, DFS nodes, cycles) and time
+ * it when the build defines USE_STATS (CMake option USE_STATS, on by
+ * default). Without it the updates compile to nothing and the counters stay
+ * at 0.
+ *
+ * Example:
+ * @code
+ * GOMA_STATS(n_solves_++);
+ * {
+ *     stats_timer timer(solve_time_); // adds the scope time to solve_time_
+ *     solver_->solve();
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <chrono>
+
+#ifdef USE_STATS
+#define GOMA_STATS(statement) statement
+#else
+#define GOMA_STATS(statement)
+#endif
+
+namespace GOMA
+{
+    /**
+     * @class stats_timer
+     * @brief Adds the lifetime of a scope, in seconds, to a counter
+     *
+     * Does not read the clock without USE_STATS.
+     */
+    class stats_timer
+    {
+#ifdef USE_STATS
+    private:
+        double &seconds_;                                  ///< Counter (not owned)
+        const std::chrono::steady_clock::time_point start_; ///< Construction time
+
+    public:
+        explicit stats_timer(double &seconds) : seconds_(seconds), start_(std::chrono::steady_clock::now()) {}
+
+        ~stats_timer(void)
+        {
+            const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start_};
+            seconds_ += elapsed.count();
+        }
+#else
+    public:
+        explicit stats_timer(double &) {}
+#endif
+
+        stats_timer(const stats_timer &) = delete;
+        stats_timer &operator=(const stats_timer &) = delete;
+    };
+}
@@ -0,0 +1,135 @@
+/**
+ * @file trace_recorder.hpp
+ * @brief Timeline of the pipeline stages in Chrome trace format
+ *
+ * The counters of stats_timer.hpp give totals; with several threads
+ * (cycle workers, component LPs, checker pools, server clients) the
+ * contention, queueing and stragglers only show on a timeline. While the
+ * recorder is started, every trace_scope records one complete event (name,
+ * category, start, duration, thread) and write() saves them as a Chrome
+ * trace JSON file, to open in chrome://tracing or ui.perfetto.dev. Nested
+ * scopes of a thread nest in the viewer.
+ *
+ * Example:
+ * @code
+ * trace_recorder::start();
+ * {
+ *     trace_scope scope("lp_solve", "lp");
+ *     solver_->solve();
+ * }
+ * trace_recorder::write("run.trace.json");
+ * @endcode
+ *
+ * A stopped recorder costs one atomic load per scope.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace GOMA
+{
+    /**
+     * @class trace_recorder
+     * @brief Process-wide event buffer (one per thread, no lock shared by the threads)
+     *
+     * Each thread appends to its own buffer. A buffer is handed to the
+     * next new thread when its thread ends, so short-lived workers reuse
+     * the trace rows (tid) of the finished ones. At most max_events events
+     * are kept per buffer; later ones are counted as dropped.
+     */
+    class trace_recorder
+    {
+    public:
+        static const size_t max_events{1 << 20}; ///< Events kept per thread buffer
+
+        /**
+         * @brief Clear the events and start recording (time origin: now)
+         */
+        static void start(void);
+
+        /**
+         * @brief Stop recording (the events are kept for write())
+         */
+        static void stop(void);
+
+        /**
+         * @brief Check if the recorder is started
+         */
+        static bool is_started(void);
+
+        /**
+         * @brief Read the clock at the start of an event
+         * @return Current time
+         *
+         * Takes the buffer of the calling thread before the event starts,
+         * so a buffer is never shared by two running threads.
+         */
+        static chrono::steady_clock::time_point begin(void);
+
+        /**
+         * @brief Record a complete event of the calling thread
+         * @param name Event name (string literal: the pointer is kept)
+         * @param category Event category (string literal)
+         * @param start Start time
+         * @param end End time
+         */
+        static void record(const char *name, const char *category,
+                           const chrono::steady_clock::time_point &start,
+                           const chrono::steady_clock::time_point &end);
+
+        /**
+         * @brief Write the recorded events as a Chrome trace JSON file
+         * @param file_name Output file
+         * @return false if the file cannot be written
+         *
+         * Threads may keep recording while the file is written.
+         */
+        static bool write(const string &file_name);
+
+        /**
+         * @brief Events not kept because a thread buffer was full
+         */
+        static size_t get_n_dropped(void);
+    };
+
+    /**
+     * @class trace_scope
+     * @brief Records the lifetime of a scope as one event, if the recorder is started
+     */
+    class trace_scope
+    {
+    private:
+        const char *name_;                          ///< Event name (not owned)
+        const char *category_;                      ///< Event category (not owned)
+        bool active_;                               ///< Recorder started at construction
+        chrono::steady_clock::time_point start_;    ///< Construction time
+
+    public:
+        /**
+         * @param name Event name (string literal)
+         * @param category Event category (string literal)
+         */
+        trace_scope(const char *name, const char *category) : name_(name),
+                                                              category_(category),
+                                                              active_(trace_recorder::is_started()),
+                                                              start_()
+        {
+            if (active_)
+                start_ = trace_recorder::begin();
+        }
+
+        ~trace_scope(void)
+        {
+            if (active_)
+                trace_recorder::record(name_, category_, start_, chrono::steady_clock::now());
+        }
+
+        trace_scope(const trace_scope &) = delete;
+        trace_scope &operator=(const trace_scope &) = delete;
+    };
+}
@@ -8,6 +8,7 @@ namespace GOMA
     CLP_model_structure::CLP_model_structure(const model_description &model, double tol) : probname_(model.get_name()),
                                                                                            ncol_(0),
                                                                                            nrow_(0),
+                                                                                           M_(model.get_M()),
                                                                                            obj_sense_(0),
                                                                                            prob_type_(0)
     {
@@ -96,66 +97,53 @@ namespace GOMA
             rhs_[i] = rhs[i];
         }
 
-        const int M_nz = model.get_nz();
-        const matrix<double> &M = model.get_M();
+        // The CSC arrays are read from the model, not copied
+        const sparse_matrix<double> &M = model.get_M();
 
-        matval_.reserve(M_nz);
-        matind_.reserve(M_nz);
-        matcnt_.resize(ncol_);
-        matbeg_.resize(ncol_ + 1);
-
-        matbeg_[0] = 0;
-
-        int nz = 0;
-
-        for(int j{0}; j < ncol_; j++)
-        {
-            matcnt_[j] = 0;
-
-            for(int i{0}; i < nrow_; i++)
-            {
-                if (fabs(M(i + 1, j + 1)) > tol)
-                {
-                    matval_.push_back(M(i + 1, j + 1));
-                    matind_.push_back(i);
-                    nz++;
-
-                    matcnt_[j]++;
-                }
-            }
-            matbeg_[j + 1] = matbeg_[j] + matcnt_[j];
-        }
-
-        if (nz != M_nz)
+        if (M.get_nz() != model.get_nz())
         {
-            cerr << "Error: nz != M_nz (" << nz << " != " << M_nz << ")" << endl;
+            cerr << "Error: nz != M_nz (" << M.get_nz() << " != " << model.get_nz() << ")" << endl;
             exit(1);
         }
 
         const vector<string> &colname = model.get_var_labels();
+        const vector<string> &rowname = model.get_cons_labels();
 
-        colname_.resize(ncol_);
-
-        const int colname_size = colname.size();
-        const int ncol = colname_size < ncol_ ? colname_size : ncol_;
+        colname_.clear();
+        rowname_.clear();
 
-        for(int i{0}; i < ncol; ++i)
+        // Unlabeled model (model_description::get_labels): no names
+        if (!colname.empty() || !rowname.empty())
         {
-            colname_[i] = colname[i];
-        }
+            colname_.resize(ncol_);
 
-        for (int i{ncol}; i < ncol_; ++i)
-        {
-            colname_[i] = "aux_" + std::to_string(i);
-        }
+            const int colname_size = colname.size();
+            const int ncol = colname_size < ncol_ ? colname_size : ncol_;
 
-        const vector<string> &rowname = model.get_cons_labels();
+            for(int i{0}; i < ncol; ++i)
+            {
+                colname_[i] = colname[i];
+            }
 
-        rowname_.resize(nrow_);
+            for (int i{ncol}; i < ncol_; ++i)
+            {
+                colname_[i] = "aux_" + std::to_string(i);
+            }
 
-        for(int i{0}; i < nrow_; ++i)
-        {
-            rowname_[i] = rowname[i];
+            rowname_.resize(nrow_);
+
+            const int rowname_size = rowname.size();
+            const int nrow = rowname_size < nrow_ ? rowname_size : nrow_;
+
+            for(int i{0}; i < nrow; ++i)
+            {
+                rowname_[i] = rowname[i];
+            }
+
+            for (int i{nrow}; i < nrow_; ++i)
+            {
+                rowname_[i] = "row_" + std::to_string(i);
+            }
         }
 
         if (model.get_obj_sense() == ObjSen::Minimize)
@@ -2,6 +2,8 @@
 #include "CLP/CLP_model_structure.hpp"
 
 #include <ClpSimplex.hpp>
+#include <ClpEventHandler.hpp>
+#include <ClpPackedMatrix.hpp>
 #include <CoinPackedMatrix.hpp>
 #include <CoinPackedVector.hpp>
 #include <limits>
@@ -10,8 +12,44 @@
 
 namespace GOMA
 {
+    /**
+     * @brief Stops the simplex once an interrupt flag is raised
+     *
+     * CLP clones the handler passed to the model: the clones share the flag.
+     */
+    class CLP_interrupt_handler : public ClpEventHandler
+    {
+    protected:
+        const atomic<bool> *interrupt_; ///< Flag of the CLP_solver (not owned)
+
+    public:
+        explicit CLP_interrupt_handler(const atomic<bool> *interrupt) : ClpEventHandler(), interrupt_(interrupt) {}
+
+        virtual ~CLP_interrupt_handler(void) {}
+
+        /**
+         * @return -1 to go on, 0 to stop (problem status 5)
+         */
+        virtual int event(Event whichEvent)
+        {
+            if (whichEvent == endOfIteration && interrupt_->load(memory_order_relaxed))
+                return 0;
+
+            return -1;
+        }
+
+        virtual ClpEventHandler *clone(void) const
+        {
+            return new CLP_interrupt_handler(*this);
+        }
+    };
+
     CLP_solver::CLP_solver(const model_description &model, const double tol) : LP_solver(model, tol),
-                                                                               model_(nullptr)
+                                                                               model_(nullptr),
+                                                                               warm_start_(true),
+                                                                               obj_cutoff_(-std::numeric_limits<double>::infinity()),
+                                                                               time_limit_(0),
+                                                                               interrupt_(false)
     {
         init_solver();
         CLP_model_structure clp_model(model, tol);
@@ -53,7 +91,7 @@ namespace GOMA
         // 0 = optimal, 1 = primal infeasible, 2 = dual infeasible (unbounded)
         int status = model_->status();
         
-        if (status == 0)  // Optimal
+        if (status == 0 || lpstat_ == LP_STAT_OBJ_LIMIT)  // Optimal or stopped by the cutoff
         {
             return model_->objectiveValue();
         }
@@ -76,6 +114,85 @@ namespace GOMA
         }
     }
 
+    void CLP_solver::set_warm_start(const bool warm_start)
+    {
+        warm_start_ = warm_start;
+    }
+
+    void CLP_solver::set_obj_cutoff(const double cutoff)
+    {
+        // Applied by solve_LP(), the model may be rebuilt meanwhile
+        obj_cutoff_ = cutoff;
+    }
+
+    void CLP_solver::set_time_limit(const double seconds)
+    {
+        // Applied by solve_LP(), as the cutoff
+        time_limit_ = seconds;
+    }
+
+    void CLP_solver::set_interrupt(const bool interrupt)
+    {
+        interrupt_.store(interrupt, memory_order_relaxed);
+    }
+
+    bool CLP_solver::get_basis(vector<int> &col_stat, vector<int> &row_stat) const
+    {
+        if (model_ == nullptr || model_->statusArray() == nullptr)
+            return false;
+
+        const int nrow = model_->numberRows();
+
+        col_stat.resize(n_col_);
+        row_stat.resize(nrow);
+
+        for (int i = 0; i < n_col_; ++i)
+            col_stat[i] = clp_2_basis_stat(model_->getColumnStatus(i));
+
+        for (int i = 0; i < nrow; ++i)
+            row_stat[i] = clp_2_basis_stat(model_->getRowStatus(i));
+
+        return true;
+    }
+
+    bool CLP_solver::set_basis(const vector<int> &col_stat, const vector<int> &row_stat)
+    {
+        if (model_ == nullptr || (int)col_stat.size() != n_col_ || (int)row_stat.size() != model_->numberRows())
+            return false;
+
+        for (int i = 0; i < n_col_; ++i)
+            model_->setColumnStatus(i, static_cast<ClpSimplex::Status>(basis_stat_2_clp(col_stat[i])));
+
+        for (int i = 0; i < (int)row_stat.size(); ++i)
+            model_->setRowStatus(i, static_cast<ClpSimplex::Status>(basis_stat_2_clp(row_stat[i])));
+
+        return true;
+    }
+
+    int CLP_solver::clp_2_basis_stat(const int status)
+    {
+        if (status == ClpSimplex::basic)
+            return BasisStat::Basic;
+        else if (status == ClpSimplex::atUpperBound)
+            return BasisStat::AtUpper;
+        else if (status == ClpSimplex::isFree || status == ClpSimplex::superBasic)
+            return BasisStat::FreeSuper;
+        else  // atLowerBound or isFixed
+            return BasisStat::AtLower;
+    }
+
+    int CLP_solver::basis_stat_2_clp(const int status)
+    {
+        if (status == BasisStat::Basic)
+            return ClpSimplex::basic;
+        else if (status == BasisStat::AtUpper)
+            return ClpSimplex::atUpperBound;
+        else if (status == BasisStat::FreeSuper)
+            return ClpSimplex::superBasic;
+        else
+            return ClpSimplex::atLowerBound;
+    }
+
     void CLP_solver::get_vars(double *alpha) const
     {
         if (model_ == nullptr || alpha == nullptr)
@@ -215,27 +332,17 @@ namespace GOMA
         if (model_ == nullptr)
             return;
 
-        // Add one row at a time (nzcnt is number of rows, not non-zeros)
-        for (int r = 0; r < nzcnt; ++r)
+        // One row with nzcnt non-zeros, as CPX_solver::add_cut (CPXaddrows with rcnt = 1)
+        CoinPackedVector row;
+        for (int i = rmatbeg[0]; i < rmatbeg[0] + nzcnt; ++i)
         {
-            int start = rmatbeg[r];
-            int end = (r < nzcnt - 1) ? rmatbeg[r + 1] : get_nz();
-            int num_elements = end - start;
-
-            CoinPackedVector row;
-            for (int i = start; i < end; ++i)
-            {
-                row.insert(rmatind[i], rmatval[i]);
-            }
+            row.insert(rmatind[i], rmatval[i]);
+        }
 
-            double row_lower, row_upper;
-            convert_row_bounds(sense[r], rhs[r], row_lower, row_upper);
+        double row_lower, row_upper;
+        convert_row_bounds(sense[0], rhs[0], row_lower, row_upper);
 
-            const int num = row.getNumElements();
-            const int* idx = row.getIndices();
-            const double* elts = row.getElements();
-            model_->addRow(num, idx, elts, row_lower, row_upper);
-        }
+        model_->addRow(row.getNumElements(), row.getIndices(), row.getElements(), row_lower, row_upper);
 
         n_row_ = model_->numberRows();
     }
@@ -249,16 +356,78 @@ namespace GOMA
         if (matrix == nullptr)
             return;
 
+        if (!matrix->isColOrdered())
+        {
+            for (int i = 0; i < cnt; ++i)
+            {
+                int row = row_inx[i];
+                int col = col_inx[i];
+
+                if (row >= 0 && row < n_row_ && col >= 0 && col < n_col_)
+                {
+                    matrix->modifyCoefficient(row, col, coef_val[i], true);
+                }
+            }
+
+            update_matrix_flags();
+            return;
+        }
+
+        // Overwrite the values in place: the sparsity pattern, explicit zeros
+        // included, is kept, so an update never shifts the element arrays
+        // (modifyCoefficient drops a zeroed element and shifts on reinsertion)
+        const CoinBigIndex *starts = matrix->getVectorStarts();
+        const int *lengths = matrix->getVectorLengths();
+        const int *indices = matrix->getIndices();
+        double *elements = matrix->getMutableElements();
+
+        bool changed_flags = false;
+
         for (int i = 0; i < cnt; ++i)
         {
             int row = row_inx[i];
             int col = col_inx[i];
-            
-            if (row >= 0 && row < n_row_ && col >= 0 && col < n_col_)
+
+            if (row < 0 || row >= n_row_ || col < 0 || col >= n_col_)
+                continue;
+
+            const double val = coef_val[i];
+
+            CoinBigIndex k = starts[col];
+            const CoinBigIndex end = k + lengths[col];
+
+            while (k < end && indices[k] != row)
+                ++k;
+
+            if (k < end)
+            {
+                elements[k] = val;
+                changed_flags = changed_flags || val == 0.0;
+            }
+            else if (val != 0.0)
             {
-                matrix->modifyCoefficient(row, col, coef_val[i]);
+                // New element: grows the pattern once, later updates are in place
+                matrix->modifyCoefficient(row, col, val, true);
+                changed_flags = true;
+
+                starts = matrix->getVectorStarts();
+                lengths = matrix->getVectorLengths();
+                indices = matrix->getIndices();
+                elements = matrix->getMutableElements();
             }
         }
+
+        if (changed_flags)
+            update_matrix_flags();
+    }
+
+    void CLP_solver::update_matrix_flags(void)
+    {
+        // ClpPackedMatrix caches whether the matrix has zeros or gaps
+        ClpPackedMatrix *clp_matrix = dynamic_cast<ClpPackedMatrix *>(model_->clpMatrix());
+
+        if (clp_matrix != nullptr)
+            clp_matrix->checkFlags(0);
     }
 
     int CLP_solver::get_n_rows(void) const
@@ -269,6 +438,14 @@ namespace GOMA
         return model_->numberRows();
     }
 
+    int CLP_solver::get_n_iterations(void) const
+    {
+        if (model_ == nullptr)
+            return 0;
+
+        return model_->numberIterations();
+    }
+
     void CLP_solver::init_solver(void)
     {
         if (model_ != nullptr)
@@ -283,6 +460,10 @@ namespace GOMA
         
         // Use dual simplex (generally faster for most problems)
         model_->setOptimizationDirection(1);  // 1 = minimize, -1 = maximize
+
+        // Polls interrupt_ (the model keeps a clone)
+        CLP_interrupt_handler handler(&interrupt_);
+        model_->passInEventHandler(&handler);
     }
 
     void CLP_solver::build_model(const CLP_model_structure &model)
@@ -351,11 +532,44 @@ namespace GOMA
         if (model_ == nullptr)
             return;
 
-        // Use dual simplex (generally robust and fast)
-        model_->dual();
+        // The status array of the last solve is the starting basis
+        if (!warm_start_)
+            model_->allSlackBasis(true);
+
+        const bool cutoff{obj_cutoff_ > -1E75};
+
+        model_->setMaximumSeconds(time_limit_ > 0 ? time_limit_ : -1.0);
+
+        // Use dual simplex (generally robust and fast), primal for a cutoff
+        if (cutoff)
+        {
+            model_->setPrimalObjectiveLimit(obj_cutoff_);
+            model_->primal();
+        }
+        else
+            model_->dual();
 
         // Update solver status
         lpstat_ = model_->status();
+
+        // 5 = stopped by the event handler (set_interrupt)
+        if (lpstat_ == 5)
+        {
+            lpstat_ = LP_STAT_INTERRUPTED;
+            return;
+        }
+
+        if (cutoff && lpstat_ != 0 && model_->isPrimalObjectiveLimitReached())
+        {
+            lpstat_ = LP_STAT_OBJ_LIMIT;
+            return;
+        }
+
+        if (lpstat_ == 3 && time_limit_ > 0)
+        {
+            lpstat_ = LP_STAT_TIME_LIMIT;
+            return;
+        }
         
         // 0 = optimal
         // 1 = primal infeasible
@@ -113,70 +113,67 @@ namespace GOMA
             rhs_[i] = rhs[i];
         }
 
-        const int M_nz = model.get_nz();
-        const matrix<double> &M = model.get_M();
+        // The CSC arrays of the model are passed to CPXcopylp as they are
+        const sparse_matrix<double> &M = model.get_M();
 
-        matval_ = new double[M_nz];
-        matind_ = new int[M_nz];
-        matcnt_ = new int[ncol_ + 1];
-        matbeg_ = new int[ncol_ + 1];
-
-        matbeg_[0] = 0;
+        matbeg_ = const_cast<int *>(M.get_matbeg().data());
+        matind_ = const_cast<int *>(M.get_matind().data());
+        matval_ = const_cast<double *>(M.get_matval().data());
 
-        int nz = 0;
+        matcnt_ = new int[ncol_ + 1];
 
         for(int j{0}; j < ncol_; j++)
         {
-            matcnt_[j] = 0;
-
-            for(int i{0}; i < nrow_; i++)
-            {
-                if (fabs(M(i + 1, j + 1)) > tol)
-                {
-                    matval_[nz] = M(i + 1, j + 1);
-                    matind_[nz] = i;
-                    nz++;
-
-                    matcnt_[j]++;
-                }
-            }
-            matbeg_[j + 1] = matbeg_[j] + matcnt_[j];
+            matcnt_[j] = matbeg_[j + 1] - matbeg_[j];
         }
 
-        if (nz != M_nz)
+        if (M.get_nz() != model.get_nz())
         {
             cerr << "Error: nz != M_nz" << endl;
             exit(1);
         }
 
         const vector<string> &colname = model.get_var_labels();
+        const vector<string> &rowname = model.get_cons_labels();
 
-        colname_ = new char *[ncol_];
+        // Unlabeled model (model_description::get_labels): loaded unnamed
+        if (!colname.empty() || !rowname.empty())
+        {
+            colname_ = new char *[ncol_];
 
-        const int colname_size = colname.size();
+            const int colname_size = colname.size();
 
-        const int ncol = colname_size < ncol_ ? colname_size : ncol_;
+            const int ncol = colname_size < ncol_ ? colname_size : ncol_;
 
-        for(int i{0}; i < ncol; ++i)
-        {
-            colname_[i] = new char[colname[i].size() + 1];
-            strcpy(colname_[i], colname[i].c_str());
-        }
+            for(int i{0}; i < ncol; ++i)
+            {
+                colname_[i] = new char[colname[i].size() + 1];
+                strcpy(colname_[i], colname[i].c_str());
+            }
 
-        for (int i{ncol}; i < ncol_; ++i)
-        {
-            colname_[i] = new char[10];
-            sprintf(colname_[i], "aux_%d", i);
-        }
+            for (int i{ncol}; i < ncol_; ++i)
+            {
+                colname_[i] = new char[16];
+                sprintf(colname_[i], "aux_%d", i);
+            }
 
-        const vector<string> &rowname = model.get_cons_labels();
+            rowname_ = new char *[nrow_];
 
-        rowname_ = new char *[nrow_];
+            const int rowname_size = rowname.size();
 
-        for(int i{0}; i < nrow_; ++i)
-        {
-            rowname_[i] = new char[rowname[i].size() + 1];
-            strcpy(rowname_[i], rowname[i].c_str());
+            const int nrow = rowname_size < nrow_ ? rowname_size : nrow_;
+
+            for(int i{0}; i < nrow; ++i)
+            {
+                rowname_[i] = new char[rowname[i].size() + 1];
+                strcpy(rowname_[i], rowname[i].c_str());
+            }
+
+            for (int i{nrow}; i < nrow_; ++i)
+            {
+                rowname_[i] = new char[16];
+                sprintf(rowname_[i], "row_%d", i);
+            }
         }
 
         probname_p_ = new char[model.get_name().size() + 1];
@@ -209,18 +206,11 @@ namespace GOMA
         if (rhs_)
             delete[] rhs_;
 
-        if (matbeg_)
-            delete[] matbeg_;
-
-        if (matind_)
-            delete[] matind_;
+        // matbeg_, matind_ and matval_ belong to the model_description
 
         if (matcnt_)
             delete[] matcnt_;
 
-        if (matval_)
-            delete[] matval_;
-
         if (probname_p_)
             delete[] probname_p_;
 
@@ -4,7 +4,8 @@ namespace GOMA
 {
     CPX_solver::CPX_solver(const model_description &model, const double tol) : LP_solver(model, tol),
                                                                                env_(NULL),
-                                                                               problem_(NULL)
+                                                                               problem_(NULL),
+                                                                               terminate_(0)
     {
         init_solver();
         build_model(model);
@@ -59,7 +60,8 @@ namespace GOMA
 
     double CPX_solver::get_obj(void) const
     {
-        if (lpstat_ == CPX_STAT_OPTIMAL)
+        // A solve stopped by the cutoff has a primal feasible point
+        if (lpstat_ == CPX_STAT_OPTIMAL || lpstat_ == LP_STAT_OBJ_LIMIT)
         {
             double obj;
             int status = CPXgetobjval(env_, problem_, &obj);
@@ -95,6 +97,66 @@ namespace GOMA
         }
     }
 
+    void CPX_solver::set_warm_start(const bool warm_start)
+    {
+        int status = CPXsetintparam(env_, CPXPARAM_Advance, warm_start ? 1 : 0);
+
+        if (status)
+        {
+            fprintf(stderr, "Failed to set advanced start.\n");
+            exit(1);
+        }
+    }
+
+    void CPX_solver::set_obj_cutoff(const double cutoff)
+    {
+        int status = CPXsetdblparam(env_, CPXPARAM_Simplex_Limits_LowerObj, cutoff > -1E75 ? cutoff : -1E75);
+
+        if (status)
+        {
+            fprintf(stderr, "Failed to set objective cutoff.\n");
+            exit(1);
+        }
+    }
+
+    void CPX_solver::set_interrupt(const bool interrupt)
+    {
+        // Polled by CPLEX during the solve
+        terminate_ = interrupt ? 1 : 0;
+    }
+
+    void CPX_solver::set_time_limit(const double seconds)
+    {
+        int status = CPXsetdblparam(env_, CPXPARAM_TimeLimit, seconds > 0 ? seconds : 1E75);
+
+        if (status)
+        {
+            fprintf(stderr, "Failed to set time limit.\n");
+            exit(1);
+        }
+    }
+
+    bool CPX_solver::get_basis(vector<int> &col_stat, vector<int> &row_stat) const
+    {
+        col_stat.resize(n_col_);
+        row_stat.resize(CPXgetnumrows(env_, problem_));
+
+        // BasisStat uses the CPLEX codes
+        int status = CPXgetbase(env_, problem_, col_stat.data(), row_stat.data());
+
+        return status == 0;
+    }
+
+    bool CPX_solver::set_basis(const vector<int> &col_stat, const vector<int> &row_stat)
+    {
+        if ((int)col_stat.size() != n_col_ || (int)row_stat.size() != CPXgetnumrows(env_, problem_))
+            return false;
+
+        int status = CPXcopybase(env_, problem_, col_stat.data(), row_stat.data());
+
+        return status == 0;
+    }
+
     void CPX_solver::get_vars(double *alpha) const
     {
         int status = CPXgetx(env_, problem_, alpha, 0, n_col_ - 1);
@@ -206,6 +268,11 @@ namespace GOMA
         return CPXgetnumrows(env_, problem_);
     }
 
+    int CPX_solver::get_n_iterations(void) const
+    {
+        return CPXgetitcnt(env_, problem_);
+    }
+
     void CPX_solver::init_solver(void)
     {
         int status;
@@ -237,6 +304,15 @@ namespace GOMA
             fprintf(stderr, "Failed to create LP.\n");
             exit(1);
         }
+
+        // set_interrupt() raises the flag from another thread
+        status = CPXsetterminate(env_, &terminate_);
+
+        if (status)
+        {
+            fprintf(stderr, "Failed to set the terminate flag.\n");
+            exit(1);
+        }
     }
 
     void CPX_solver::build_model(const CPX_model_structure &model)
@@ -283,6 +359,7 @@ namespace GOMA
         for (int i{0}; i < max_sz; ++i)
             inx[i] = i;
 
+        if (model.get_colname() != NULL)
         {
             char **colname = model.get_colname();
 
@@ -295,6 +372,7 @@ namespace GOMA
             }
         }
 
+        if (model.get_rowname() != NULL)
         {
             char **rowname = model.get_rowname();
 
@@ -322,6 +400,14 @@ namespace GOMA
 
         lpstat_ = CPXgetstat(env_, problem_);
 
+        // Primal simplex stopped by the lower objective limit
+        if (lpstat_ == CPX_STAT_ABORT_PRIM_OBJ_LIM)
+            lpstat_ = LP_STAT_OBJ_LIMIT;
+
+        // Stopped by set_interrupt()
+        if (lpstat_ == CPX_STAT_ABORT_USER)
+            lpstat_ = LP_STAT_INTERRUPTED;
+
         // double obj;
 
         // DEBUG
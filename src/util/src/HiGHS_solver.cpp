@@ -0,0 +1,492 @@
+#include "HiGHS/HiGHS_solver.hpp"
+
+#include <Highs.h>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace GOMA
+{
+    HiGHS_solver::HiGHS_solver(const model_description &model, const double tol) : LP_solver(model, tol),
+                                                                                   highs_(nullptr),
+                                                                                   warm_start_(true),
+                                                                                   interrupt_(false)
+    {
+        init_solver();
+        CLP_model_structure highs_model(model, tol);
+        build_model(highs_model);
+    }
+
+    HiGHS_solver::~HiGHS_solver()
+    {
+        clear();
+    }
+
+    void HiGHS_solver::clear(void)
+    {
+        if (highs_ != nullptr)
+        {
+            delete highs_;
+            highs_ = nullptr;
+        }
+    }
+
+    void HiGHS_solver::init_solver(void)
+    {
+        if (highs_ != nullptr)
+        {
+            delete highs_;
+        }
+
+        highs_ = new Highs();
+
+        // Quiet mode
+        highs_->setOptionValue("output_flag", false);
+
+        // set_interrupt() raises the flag from another thread
+        highs_->setCallback([](const int, const std::string &, const HighsCallbackDataOut *, HighsCallbackDataIn *data_in, void *user_data)
+                            {
+                                if (static_cast<const atomic<bool> *>(user_data)->load(memory_order_relaxed))
+                                    data_in->user_interrupt = true;
+                            },
+                            &interrupt_);
+
+        highs_->startCallback(kCallbackSimplexInterrupt);
+        highs_->startCallback(kCallbackIpmInterrupt);
+    }
+
+    void HiGHS_solver::build_model(const CLP_model_structure &model)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        const int ncol = model.ncol();
+        const int nrow = model.nrow();
+
+        HighsLp lp;
+
+        lp.model_name_ = model.get_probname();
+        lp.num_col_ = ncol;
+        lp.num_row_ = nrow;
+
+        lp.col_cost_ = model.get_obj();
+        lp.col_lower_ = model.get_lb();
+        lp.col_upper_ = model.get_ub();
+
+        // Convert constraint sense to row bounds
+        const vector<char> &sense = model.get_sense();
+        const vector<double> &rhs = model.get_rhs();
+
+        lp.row_lower_.resize(nrow);
+        lp.row_upper_.resize(nrow);
+
+        for (int i = 0; i < nrow; ++i)
+        {
+            convert_row_bounds(sense[i], rhs[i], lp.row_lower_[i], lp.row_upper_[i]);
+        }
+
+        // Column-major matrix (HighsInt may be 64 bits)
+        const vector<int> &starts = model.get_matbeg();
+        const vector<int> &indices = model.get_matind();
+
+        lp.a_matrix_.format_ = MatrixFormat::kColwise;
+        lp.a_matrix_.num_col_ = ncol;
+        lp.a_matrix_.num_row_ = nrow;
+        lp.a_matrix_.start_.assign(starts.begin(), starts.begin() + ncol + 1);
+        lp.a_matrix_.index_.assign(indices.begin(), indices.begin() + starts[ncol]);
+        lp.a_matrix_.value_.assign(model.get_matval().begin(), model.get_matval().begin() + starts[ncol]);
+
+        lp.sense_ = model.get_obj_sense() == 1 ? ObjSense::kMinimize : ObjSense::kMaximize;
+
+        lp.col_names_ = model.get_colname();
+        lp.row_names_ = model.get_rowname();
+
+        const vector<char> &ctype = model.get_ctype();
+
+        if (prob_type_ == ProbType::MIP)
+        {
+            lp.integrality_.resize(ncol);
+
+            for (int i = 0; i < ncol; ++i)
+            {
+                lp.integrality_[i] = (ctype[i] == 'B' || ctype[i] == 'I') ? HighsVarType::kInteger : HighsVarType::kContinuous;
+            }
+        }
+
+        if (highs_->passModel(lp) == HighsStatus::kError)
+        {
+            cerr << "Error: HiGHS rejected model " << lp.model_name_ << endl;
+            exit(1);
+        }
+
+        n_col_ = ncol;
+        n_row_ = nrow;
+    }
+
+    int HiGHS_solver::get_nz(void) const
+    {
+        if (highs_ == nullptr)
+            return 0;
+
+        return (int)highs_->getNumNz();
+    }
+
+    int HiGHS_solver::get_n_rows(void) const
+    {
+        if (highs_ == nullptr)
+            return 0;
+
+        return (int)highs_->getNumRow();
+    }
+
+    int HiGHS_solver::get_n_iterations(void) const
+    {
+        if (highs_ == nullptr)
+            return 0;
+
+        return (int)highs_->getInfo().simplex_iteration_count;
+    }
+
+    double HiGHS_solver::get_obj(void) const
+    {
+        if (highs_ == nullptr)
+            return 1e20;
+
+        const HighsModelStatus status = highs_->getModelStatus();
+
+        if (status == HighsModelStatus::kOptimal)
+        {
+            return highs_->getInfo().objective_function_value;
+        }
+        else if (status == HighsModelStatus::kUnbounded)
+        {
+            return -1e20;
+        }
+        else  // Infeasible or error
+        {
+            return 1e20;
+        }
+    }
+
+    void HiGHS_solver::disable_prep_linear(void)
+    {
+        if (highs_ != nullptr)
+            highs_->setOptionValue("presolve", "off");
+    }
+
+    void HiGHS_solver::set_warm_start(const bool warm_start)
+    {
+        warm_start_ = warm_start;
+    }
+
+    void HiGHS_solver::set_obj_cutoff(const double cutoff)
+    {
+        static atomic<bool> warned{false};
+
+        if (cutoff > -kHighsInf && !warned.exchange(true))
+            cerr << "Warning: HiGHS has no objective cutoff, the LP is solved to optimality" << endl;
+    }
+
+    void HiGHS_solver::set_interrupt(const bool interrupt)
+    {
+        interrupt_.store(interrupt, memory_order_relaxed);
+    }
+
+    void HiGHS_solver::set_time_limit(const double seconds)
+    {
+        if (highs_ != nullptr)
+            highs_->setOptionValue("time_limit", seconds > 0 ? seconds : kHighsInf);
+    }
+
+    bool HiGHS_solver::get_basis(vector<int> &col_stat, vector<int> &row_stat) const
+    {
+        if (highs_ == nullptr)
+            return false;
+
+        const HighsBasis &basis = highs_->getBasis();
+
+        if (!basis.valid)
+            return false;
+
+        col_stat.resize(basis.col_status.size());
+        row_stat.resize(basis.row_status.size());
+
+        for (size_t i = 0; i < basis.col_status.size(); ++i)
+            col_stat[i] = highs_2_basis_stat(basis.col_status[i]);
+
+        for (size_t i = 0; i < basis.row_status.size(); ++i)
+            row_stat[i] = highs_2_basis_stat(basis.row_status[i]);
+
+        return true;
+    }
+
+    bool HiGHS_solver::set_basis(const vector<int> &col_stat, const vector<int> &row_stat)
+    {
+        if (highs_ == nullptr || (int)col_stat.size() != n_col_ || (int)row_stat.size() != (int)highs_->getNumRow())
+            return false;
+
+        HighsBasis basis;
+
+        basis.valid = true;
+        basis.col_status.resize(col_stat.size());
+        basis.row_status.resize(row_stat.size());
+
+        for (size_t i = 0; i < col_stat.size(); ++i)
+            basis.col_status[i] = basis_stat_2_highs(col_stat[i]);
+
+        for (size_t i = 0; i < row_stat.size(); ++i)
+            basis.row_status[i] = basis_stat_2_highs(row_stat[i]);
+
+        return highs_->setBasis(basis) != HighsStatus::kError;
+    }
+
+    void HiGHS_solver::get_vars(double *alpha) const
+    {
+        if (highs_ == nullptr || alpha == nullptr)
+            return;
+
+        const vector<double> &solution = highs_->getSolution().col_value;
+
+        if ((int)solution.size() < n_col_)
+            return;
+
+        memcpy(alpha, solution.data(), n_col_ * sizeof(double));
+    }
+
+    void HiGHS_solver::get_dual_vars(double *alpha) const
+    {
+        if (highs_ == nullptr || alpha == nullptr)
+            return;
+
+        const vector<double> &duals = highs_->getSolution().row_dual;
+
+        if ((int)duals.size() < n_row_)
+            return;
+
+        memcpy(alpha, duals.data(), n_row_ * sizeof(double));
+    }
+
+    void HiGHS_solver::set_obj(double *obj_coef, int *obj_inx, int sz)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        for (int i = 0; i < sz; ++i)
+        {
+            const int idx = obj_inx[i];
+
+            if (idx >= 0 && idx < n_col_)
+            {
+                highs_->changeColCost(idx, obj_coef[i]);
+            }
+        }
+    }
+
+    void HiGHS_solver::set_bdn(double *obj_coef, char *sense, int *obj_inx, int sz)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        const HighsLp &lp = highs_->getLp();
+
+        for (int i = 0; i < sz; ++i)
+        {
+            const int idx = obj_inx[i];
+
+            if (idx >= 0 && idx < n_col_)
+            {
+                if (sense[i] == 'L')  // Lower bound
+                {
+                    highs_->changeColBounds(idx, obj_coef[i], lp.col_upper_[idx]);
+                }
+                else if (sense[i] == 'U')  // Upper bound
+                {
+                    highs_->changeColBounds(idx, lp.col_lower_[idx], obj_coef[i]);
+                }
+                else if (sense[i] == 'B')  // Both bounds (binary)
+                {
+                    highs_->changeColBounds(idx, 0.0, 1.0);
+                }
+            }
+        }
+    }
+
+    void HiGHS_solver::set_rhs(int cnt, const int *rhs_inx, const double *rhs_val)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        const HighsLp &lp = highs_->getLp();
+
+        for (int i = 0; i < cnt; ++i)
+        {
+            const int idx = rhs_inx[i];
+
+            if (idx >= 0 && idx < n_row_)
+            {
+                // The sense is inferred from the current bounds, as CLP_solver
+                const double row_lower = lp.row_lower_[idx];
+                const double row_upper = lp.row_upper_[idx];
+                const double rhs = rhs_val[i];
+
+                if (row_lower == row_upper)  // Equality
+                {
+                    highs_->changeRowBounds(idx, rhs, rhs);
+                }
+                else if (row_lower > -kHighsInf)  // Greater than
+                {
+                    highs_->changeRowBounds(idx, rhs, row_upper);
+                }
+                else  // Less than
+                {
+                    highs_->changeRowBounds(idx, row_lower, rhs);
+                }
+            }
+        }
+    }
+
+    void HiGHS_solver::set_rhs(const int row, const double val)
+    {
+        set_rhs(1, &row, &val);
+    }
+
+    void HiGHS_solver::set_coef(int cnt, const int *row_inx, const int *col_inx, const double *coef_val)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        for (int i = 0; i < cnt; ++i)
+        {
+            const int row = row_inx[i];
+            const int col = col_inx[i];
+
+            if (row >= 0 && row < n_row_ && col >= 0 && col < n_col_)
+            {
+                highs_->changeCoeff(row, col, coef_val[i]);
+            }
+        }
+    }
+
+    void HiGHS_solver::add_cut(int nzcnt, double const *rhs, char const *sense,
+                               int const *rmatbeg, int const *rmatind,
+                               double const *rmatval, char **rowname)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        // One row with nzcnt non-zeros, as CPX_solver::add_cut (CPXaddrows with rcnt = 1)
+        const vector<HighsInt> indices(rmatind + rmatbeg[0], rmatind + rmatbeg[0] + nzcnt);
+
+        double row_lower, row_upper;
+        convert_row_bounds(sense[0], rhs[0], row_lower, row_upper);
+
+        highs_->addRow(row_lower, row_upper, nzcnt, indices.data(), rmatval + rmatbeg[0]);
+
+        if (rowname != nullptr && rowname[0] != nullptr)
+            highs_->passRowName(highs_->getNumRow() - 1, rowname[0]);
+
+        n_row_ = (int)highs_->getNumRow();
+    }
+
+    void HiGHS_solver::del_rows(int begin, int end)
+    {
+        if (highs_ == nullptr || begin < 0 || end >= n_row_)
+            return;
+
+        highs_->deleteRows(begin, end);
+
+        n_row_ = (int)highs_->getNumRow();
+    }
+
+    void HiGHS_solver::solve(void)
+    {
+        if (prob_type_ == ProbType::MIP)
+            solve_MIP();
+        else
+            solve_LP();
+    }
+
+    void HiGHS_solver::solve_LP(void)
+    {
+        if (highs_ == nullptr)
+            return;
+
+        // The basis of the last run is the starting basis
+        if (!warm_start_)
+            highs_->clearSolver();
+
+        highs_->run();
+
+        const HighsModelStatus status = highs_->getModelStatus();
+
+        // Map to our status convention (1 = optimal)
+        if (status == HighsModelStatus::kOptimal)
+            lpstat_ = 1;  // optimal
+        else if (status == HighsModelStatus::kUnbounded)
+            lpstat_ = 2;  // unbounded
+        else if (status == HighsModelStatus::kTimeLimit)
+            lpstat_ = LP_STAT_TIME_LIMIT;
+        else if (status == HighsModelStatus::kInterrupt)
+            lpstat_ = LP_STAT_INTERRUPTED;
+        else
+            lpstat_ = 0;  // infeasible or error
+    }
+
+    void HiGHS_solver::solve_MIP(void)
+    {
+        // HiGHS detects the integrality passed in build_model() and runs branch and cut
+        solve_LP();
+    }
+
+    void HiGHS_solver::write_model(const char *filename) const
+    {
+        if (highs_ == nullptr || filename == nullptr)
+            return;
+
+        highs_->writeModel(string(filename));
+    }
+
+    int HiGHS_solver::highs_2_basis_stat(const HighsBasisStatus status)
+    {
+        if (status == HighsBasisStatus::kBasic)
+            return BasisStat::Basic;
+        else if (status == HighsBasisStatus::kUpper)
+            return BasisStat::AtUpper;
+        else if (status == HighsBasisStatus::kZero)
+            return BasisStat::FreeSuper;
+        else  // kLower or kNonbasic
+            return BasisStat::AtLower;
+    }
+
+    HighsBasisStatus HiGHS_solver::basis_stat_2_highs(const int status)
+    {
+        if (status == BasisStat::Basic)
+            return HighsBasisStatus::kBasic;
+        else if (status == BasisStat::AtUpper)
+            return HighsBasisStatus::kUpper;
+        else if (status == BasisStat::FreeSuper)
+            return HighsBasisStatus::kZero;
+        else
+            return HighsBasisStatus::kLower;
+    }
+
+    void HiGHS_solver::convert_row_bounds(char sense, double rhs, double &row_lower, double &row_upper) const
+    {
+        if (sense == 'L')  // Less than or equal
+        {
+            row_lower = -kHighsInf;
+            row_upper = rhs;
+        }
+        else if (sense == 'G')  // Greater than or equal
+        {
+            row_lower = rhs;
+            row_upper = kHighsInf;
+        }
+        else  // Equal (unknown sense treated as equality)
+        {
+            row_lower = rhs;
+            row_upper = rhs;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file LP_backend.cpp
+ * @brief Implementation of the LP backend registry
+ */
+
+#include "LP_backend.hpp"
+
+#ifdef USE_CPLEX
+#include "CPX_solver.hpp"
+#endif
+#ifdef USE_CLP
+#include "CLP/CLP_solver.hpp"
+#endif
+#ifdef USE_HIGHS
+#include "HiGHS/HiGHS_solver.hpp"
+#endif
+
+#include <iostream>
+#include <cstdlib>
+
+namespace GOMA
+{
+#ifdef USE_CPLEX
+    static LP_solver *create_cplex_(const model_description &model, const double tol)
+    {
+        return new CPX_solver(model, tol);
+    }
+#endif
+
+#ifdef USE_CLP
+    static LP_solver *create_clp_(const model_description &model, const double tol)
+    {
+        return new CLP_solver(model, tol);
+    }
+#endif
+
+#ifdef USE_HIGHS
+    static LP_solver *create_highs_(const model_description &model, const double tol)
+    {
+        return new HiGHS_solver(model, tol);
+    }
+#endif
+
+    map<string, LP_solver_factory> &LP_backend_registry::backends_(void)
+    {
+        static map<string, LP_solver_factory> backends{
+#ifdef USE_CPLEX
+            {"cplex", create_cplex_},
+#endif
+#ifdef USE_CLP
+            {"clp", create_clp_},
+#endif
+#ifdef USE_HIGHS
+            {"highs", create_highs_},
+#endif
+        };
+
+        return backends;
+    }
+
+    string &LP_backend_registry::default_(void)
+    {
+        // First built-in backend: CPLEX, then CLP, then HiGHS
+        static string name{
+#if defined(USE_CPLEX)
+            "cplex"
+#elif defined(USE_CLP)
+            "clp"
+#elif defined(USE_HIGHS)
+            "highs"
+#endif
+        };
+
+        return name;
+    }
+
+    void LP_backend_registry::register_backend(const string &name, LP_solver_factory factory)
+    {
+        backends_()[name] = factory;
+
+        if (default_().empty())
+            default_() = name;
+    }
+
+    bool LP_backend_registry::has_backend(const string &name)
+    {
+        return backends_().count(name) > 0;
+    }
+
+    vector<string> LP_backend_registry::get_backends(void)
+    {
+        vector<string> names;
+
+        for (const auto &backend : backends_())
+            names.push_back(backend.first);
+
+        return names;
+    }
+
+    void LP_backend_registry::set_default(const string &name)
+    {
+        if (!has_backend(name))
+            unknown_backend_(name);
+
+        default_() = name;
+    }
+
+    const string &LP_backend_registry::get_default(void)
+    {
+        return default_();
+    }
+
+    LP_solver *LP_backend_registry::create(const string &name, const model_description &model, const double tol)
+    {
+        const string &backend{name.empty() ? default_() : name};
+
+        const auto it{backends_().find(backend)};
+
+        if (it == backends_().end())
+            unknown_backend_(backend);
+
+        return it->second(model, tol);
+    }
+
+    void LP_backend_registry::unknown_backend_(const string &name)
+    {
+        cerr << "ERROR: LP backend '" << name << "' is not available. Available backends:";
+
+        for (const string &backend : get_backends())
+            cerr << " " << backend;
+
+        cerr << endl;
+
+        exit(1);
+    }
+}
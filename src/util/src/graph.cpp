@@ -8,12 +8,14 @@
  * 
  * Key implementation details:
  * - Pre-allocated stack (n*(n-1) capacity) avoids dynamic allocation during DFS
- * - Bitsets provide O(1) visited checks and arc existence queries
- * - Adjacency lists use dynamically resized arrays with doubling strategy
+ * - Bitsets provide O(1) visited checks
+ * - Adjacency lists grow with the arcs (O(n + arcs) memory) and are
+ *   compressed to one contiguous CSR layout before the searches
  * - Iterative DFS implementation avoids recursion stack overflow
  */
 
 #include "graph.hpp"
+#include "memory_usage.hpp"
 
 #include <iostream>
 #include <string>
@@ -23,6 +25,12 @@
 #include <cassert>
 #include <algorithm>
 #include <limits>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
 
 #include <cstdint>
 
@@ -35,129 +43,144 @@ namespace GOMA
     // ========================================================================
     
     /**
-     * Constructor: Allocate adjacency list arrays for all vertices
+     * Constructor: One empty successor list per vertex
      * 
-     * Initializes with capacity (n-1) for each vertex (complete graph capacity).
-     * Uses base_succ_[] to track current array capacity for dynamic resizing.
+     * Lists grow with the arcs actually added, so memory is O(n + arcs)
+     * instead of the n*(n-1) of complete graph capacity.
      */
-    succ_list::succ_list(const size_t n_vertices) : n_vertices_(n_vertices)
+    succ_list::succ_list(const size_t n_vertices) : n_vertices_(n_vertices),
+                                                    succ_(n_vertices),
+                                                    cost_(n_vertices),
+                                                    compressed_(false),
+                                                    csr_begin_(),
+                                                    csr_succ_(),
+                                                    csr_cost_(),
+                                                    csr_pred_begin_(),
+                                                    csr_pred_()
     {
-        succ_ = new int *[n_vertices_];
-        cost_ = new double *[n_vertices_];
-        top_ = new int[n_vertices_];
-        base_succ_ = new int[n_vertices_];
-
-        in_succ_ = new search_fixed_bitset[n_vertices_];
-
-        for (size_t i{0}; i < n_vertices_; i++)
-        {
-            succ_[i] = new int[n_vertices_ - 1];
-            cost_[i] = new double[n_vertices_ - 1];
-            top_[i] = -1;
-            base_succ_[i] = -1;
-        }
     }
 
     /**
      * Default constructor: Initialize empty adjacency list
-     * All pointers set to nullptr for safe destruction.
      */
     succ_list::succ_list(void) : n_vertices_{0},
-                                 succ_{nullptr},
-                                 cost_{nullptr},
-                                 top_{nullptr},
-                                 base_succ_{nullptr},
-                                 in_succ_{nullptr}
+                                 succ_(),
+                                 cost_(),
+                                 compressed_(false),
+                                 csr_begin_(),
+                                 csr_succ_(),
+                                 csr_cost_(),
+                                 csr_pred_begin_(),
+                                 csr_pred_()
     {
     }
 
     /**
-     * Deallocate all internal arrays
-     * Frees succ_[], cost_[], top_[], in_succ_[], base_succ_[]
+     * Destructor
      */
-    void succ_list::clear_(void)
+    succ_list::~succ_list(void)
     {
-        for (size_t i{0}; i < n_vertices_; i++)
-        {
-            delete[] succ_[i];
-            delete[] cost_[i];
-        }
-
-        if (succ_)
-            delete[] succ_;
-
-        if (cost_)
-            delete[] cost_;
-
-        if (top_)
-            delete[] top_;
-
-        if (in_succ_)
-            delete[] in_succ_;
-
-        if (base_succ_)
-            delete[] base_succ_;
     }
 
     /**
-     * Destructor: Free all allocated memory
+     * Heap bytes of the edit lists and the CSR arrays
      */
-    succ_list::~succ_list(void)
+    size_t succ_list::get_memory_bytes(void) const
     {
-        clear_();
+        return vector_bytes(succ_) + vector_bytes(cost_) + vector_bytes(csr_begin_) + vector_bytes(csr_succ_) +
+               vector_bytes(csr_cost_) + vector_bytes(csr_pred_begin_) + vector_bytes(csr_pred_);
     }
 
     /**
      * Reset adjacency list to empty (preserve allocated memory)
-     * Resets top_[] indices and clears in_succ_[] bitsets.
+     * Empties every successor list and drops the compressed layout.
      * Does not deallocate memory - allows reuse.
      */
     void succ_list::clear(void)
     {
         for (size_t i{0}; i < n_vertices_; i++)
         {
-            top_[i] = base_succ_[i];
-            in_succ_[i].clear();
+            succ_[i].clear();
+            cost_[i].clear();
         }
+
+        compressed_ = false;
+    }
+
+    /**
+     * Position of j in the successor list of i
+     * 
+     * Linear scan, O(degree(i)). Support graphs are sparse, so this is
+     * cheaper than keeping an n-bit membership set per vertex.
+     * 
+     * @return Index of j in succ_[i], or -1 if (i,j) is not an arc
+     */
+    int succ_list::find_(const int i, const int j) const
+    {
+        const vector<int> &succ{succ_[i]};
+        const int n_succ{(int)succ.size()};
+
+        for (int k{0}; k < n_succ; k++)
+            if (succ[k] == j)
+                return k;
+
+        return -1;
     }
 
     /**
      * Remove arc (i,j) from adjacency list
      * 
-     * Searches for j in succ_[i] and removes it by shifting remaining elements.
-     * Updates in_succ_[i] bitset. O(degree(i)) complexity.
+     * Searches for j in succ_[i] and overwrites it with the last successor.
+     * O(degree(i)) complexity.
      */
     void succ_list::remove_arc(const int i, const int j)
     {
         assert(i >= 0 && i < (int)(n_vertices_));
         assert(j >= 0 && j < (int)(n_vertices_));
 
-        if (!is_arc(i, j))
+        const int k{find_(i, j)};
+
+        if (k < 0)
             return;
 
-        in_succ_[i].remove(j + 1);
+        vector<int> &succ{succ_[i]};
+        vector<double> &cost{cost_[i]};
+
+        succ[k] = succ.back();
+        cost[k] = cost.back();
+
+        succ.pop_back();
+        cost.pop_back();
 
-        int *succ{succ_[i]};
-        double *cost{cost_[i]};
-        int &top{top_[i]};
+        compressed_ = false;
+    }
+
+    /**
+     * Change the cost of arc (i,j)
+     *
+     * Searches for j in succ_[i] and overwrites the parallel cost entry,
+     * also in the compressed layout so that it stays valid.
+     * O(degree(i)) complexity.
+     */
+    void succ_list::set_cost(const int i, const int j, const double cost)
+    {
+        assert(i >= 0 && i < (int)n_vertices_);
+        assert(j >= 0 && j < (int)n_vertices_);
 
-        int k = 0;
-        while ((k <= top) && (succ[k] != j))
-            k++;
+        const int k{find_(i, j)};
 
-        assert(k <= top);
+        if (k < 0)
+            return;
 
-        succ[k] = succ[top];
-        cost[k] = cost[top];
-        top--;
+        cost_[i][k] = cost;
+
+        if (compressed_)
+            csr_cost_[csr_begin_[i] + k] = cost;
     }
 
     /**
      * Check if arc (i,j) exists
      * 
-     * Uses bitset for O(1) lookup via in_succ_[i].contains(j+1)
-     * Note: j is stored as (j+1) in bitset (1-indexed)
-     * 
      * @return true if arc exists, false otherwise
      */
     bool succ_list::is_arc(const int i, const int j) const
@@ -165,16 +188,26 @@ namespace GOMA
         assert(i >= 0 && i < (int)n_vertices_);
         assert(j >= 0 && j < (int)n_vertices_);
 
-        return in_succ_[i].contains(j + 1);
+        return find_(i, j) >= 0;
     }
 
     /**
      * Add arc (i,j) without cost
      * 
-     * Appends j to succ_[i] and marks in bitset.
-     * Increments top_[i]. No effect if arc already exists.
+     * Calls add_arc(i,j,0). No effect if arc already exists.
      */
     void succ_list::add_arc(const int i, const int j)
+    {
+        add_arc(i, j, 0.0);
+    }
+
+    /**
+     * Add arc (i,j) with cost
+     * 
+     * Appends j to succ_[i] and the cost to cost_[i] (same index).
+     * No effect if arc already exists (its cost is kept).
+     */
+    void succ_list::add_arc(const int i, const int j, const double cost)
     {
         assert(i >= 0 && i < (int)n_vertices_);
         assert(j >= 0 && j < (int)n_vertices_);
@@ -182,46 +215,81 @@ namespace GOMA
         if (is_arc(i, j))
             return;
 
-        top_[i]++;
-        succ_[i][top_[i]] = j;
-        in_succ_[i].insert(j + 1);
+        succ_[i].push_back(j);
+        cost_[i].push_back(cost);
+
+        compressed_ = false;
     }
 
     /**
-     * Add arc (i,j) with cost
+     * Build the compressed (CSR) layout of the current arcs
      * 
-     * Calls add_arc(i,j) then stores cost in cost_[i][top_[i]].
-     * Cost is stored at same index as successor vertex.
+     * csr_begin_[i] .. csr_begin_[i+1] is the range of vertex i in csr_succ_
+     * and csr_cost_, in the order of the successor lists. The predecessor
+     * arrays are the same layout for the reversed arcs (counting sort by
+     * head). Two passes over the arcs; the arrays keep their capacity
+     * between calls.
      */
-    void succ_list::add_arc(const int i, const int j, const double cost)
+    void succ_list::compress(void)
     {
-        add_arc(i, j);
-        cost_[i][top_[i]] = cost;
+        if (compressed_)
+            return;
+
+        csr_begin_.resize(n_vertices_ + 1);
+        csr_succ_.clear();
+        csr_cost_.clear();
+
+        for (size_t i{0}; i < n_vertices_; i++)
+        {
+            csr_begin_[i] = (int)csr_succ_.size();
+
+            csr_succ_.insert(csr_succ_.end(), succ_[i].begin(), succ_[i].end());
+            csr_cost_.insert(csr_cost_.end(), cost_[i].begin(), cost_[i].end());
+        }
+
+        csr_begin_[n_vertices_] = (int)csr_succ_.size();
+
+        // Predecessors: count in-degrees, then place each arc at its head
+        csr_pred_begin_.assign(n_vertices_ + 1, 0);
+        csr_pred_.resize(csr_succ_.size());
+
+        for (const int j : csr_succ_)
+            csr_pred_begin_[j + 1]++;
+
+        for (size_t i{0}; i < n_vertices_; i++)
+            csr_pred_begin_[i + 1] += csr_pred_begin_[i];
+
+        vector<int> next{csr_pred_begin_.begin(), csr_pred_begin_.end() - 1};
+
+        for (size_t i{0}; i < n_vertices_; i++)
+            for (int k{csr_begin_[i]}; k < csr_begin_[i + 1]; k++)
+                csr_pred_[next[csr_succ_[k]]++] = (int)i;
+
+        compressed_ = true;
     }
 
     /**
      * Get successor array for vertex i
      * 
-     * Returns pointer to internal succ_[i] array and its size.
-     * Array contains vertex IDs of all neighbors.
+     * Returns a pointer into the compressed arrays if the list is
+     * compressed, into succ_[i] otherwise, and the number of successors.
      * 
      * @param[in] i Source vertex
      * @param[out] succ Pointer to successor array (not copied, direct reference)
-     * @param[out] sz Number of successors (top_[i] + 1)
+     * @param[out] sz Number of successors
      */
-    void succ_list::successors(const int i, int *&succ, size_t &sz) const
+    void succ_list::successors(const int i, const int *&succ, size_t &sz) const
     {
         assert(i >= 0 && i < (int)n_vertices_);
 
-        sz = top_[i] + 1;
+        sz = succ_[i].size();
 
-        succ = succ_[i];
+        succ = compressed_ ? csr_succ_.data() + csr_begin_[i] : succ_[i].data();
     }
 
     /**
      * Get successor array and costs for vertex i
      * 
-     * Returns pointers to both succ_[i] and cost_[i] arrays.
      * Delegates to successors(i, succ, sz) then adds cost pointer.
      * 
      * @param[in] i Source vertex
@@ -229,10 +297,30 @@ namespace GOMA
      * @param[out] cost Pointer to cost array (parallel to succ)
      * @param[out] sz Number of successors
      */
-    void succ_list::successors(const int i, int *&succ, double *&cost, size_t &sz) const
+    void succ_list::successors(const int i, const int *&succ, const double *&cost, size_t &sz) const
     {
         successors(i, succ, sz);
-        cost = cost_[i];
+
+        cost = compressed_ ? csr_cost_.data() + csr_begin_[i] : cost_[i].data();
+    }
+
+    /**
+     * Get predecessor array for vertex i
+     * 
+     * Only the compressed layout has predecessor lists.
+     * 
+     * @param[in] i Target vertex
+     * @param[out] pred Pointer to predecessor array
+     * @param[out] sz Number of predecessors
+     */
+    void succ_list::predecessors(const int i, const int *&pred, size_t &sz) const
+    {
+        assert(compressed_);
+        assert(i >= 0 && i < (int)n_vertices_);
+
+        sz = csr_pred_begin_[i + 1] - csr_pred_begin_[i];
+
+        pred = csr_pred_.data() + csr_pred_begin_[i];
     }
 
     // ========================================================================
@@ -404,6 +492,19 @@ namespace GOMA
     {
     }
 
+    /**
+     * Heap bytes of the entries (visited bitsets inline) and of their paths
+     */
+    size_t node_info_stack::get_memory_bytes(void) const
+    {
+        size_t bytes{capacity() * sizeof(node_info)};
+
+        for (const node_info &node : *this)
+            bytes += vector_bytes(node.get_path());
+
+        return bytes;
+    }
+
     /**
      * Push vertex with path and visited set onto stack
      * 
@@ -464,6 +565,48 @@ namespace GOMA
         return at(top_);
     }
 
+    // ========================================================================
+    // search_workspace: Per-search mutable state
+    // ========================================================================
+
+    /**
+     * Constructor: One path entry per depth (n + 1, as succ_ in search_graph)
+     */
+    search_workspace::search_workspace(const size_t n_vertices) : path_(n_vertices + 1),
+                                                                  next_succ_(n_vertices + 1),
+                                                                  on_path_(),
+                                                                  reach_(),
+                                                                  queue_(),
+                                                                  target_slot_(),
+                                                                  labels_(),
+                                                                  n_expanded_(0),
+                                                                  n_donated_(0)
+    {
+    }
+
+    /**
+     * Default constructor: Empty workspace
+     */
+    search_workspace::search_workspace(void) : path_(), next_succ_(), on_path_(), reach_(), queue_(), target_slot_(), labels_(), n_expanded_(0), n_donated_(0)
+    {
+    }
+
+    /**
+     * Destructor
+     */
+    search_workspace::~search_workspace(void)
+    {
+    }
+
+    /**
+     * Heap bytes of the search state (bitsets inline)
+     */
+    size_t search_workspace::get_memory_bytes(void) const
+    {
+        return vector_bytes(path_) + vector_bytes(next_succ_) + vector_bytes(queue_) +
+               vector_bytes(target_slot_) + vector_bytes(labels_);
+    }
+
     // ========================================================================
     // search_graph: Main graph class with DFS path enumeration
     // ========================================================================
@@ -475,16 +618,24 @@ namespace GOMA
      * - succ_: adjacency list for n+1 vertices (0-indexed + extra)
      * - stack_: capacity n*(n-1) for DFS
      * - active_vertices_: bitset for n vertices
+     * - workspace_: search state for backtrack_DFS / best_first_paths
+     * - component_: strongly connected component of each vertex
      */
     search_graph::search_graph(const size_t n_vertices) : n_vertices_(n_vertices), succ_(n_vertices + 1), stack_(n_vertices),
-                                                          active_vertices_(n_vertices)
+                                                          active_vertices_(n_vertices),
+                                                          workspace_(n_vertices),
+                                                          component_(n_vertices + 1, 0),
+                                                          n_components_(0),
+                                                          components_valid_(false),
+                                                          pruning_(false)
     {
     }
 
     /**
      * Default constructor: Empty graph
      */
-    search_graph::search_graph(void) : n_vertices_(0), succ_(), stack_(), active_vertices_()
+    search_graph::search_graph(void) : n_vertices_(0), succ_(), stack_(), active_vertices_(), workspace_(),
+                                       component_(), n_components_(0), components_valid_(false), pruning_(false)
     {
     }
 
@@ -495,6 +646,15 @@ namespace GOMA
     {
     }
 
+    /**
+     * Heap bytes of the graph and its internal search state
+     */
+    size_t search_graph::get_memory_bytes(void) const
+    {
+        return succ_.get_memory_bytes() + stack_.get_memory_bytes() + active_vertices_.sz_ * sizeof(long) +
+               workspace_.get_memory_bytes() + vector_bytes(component_);
+    }
+
     /**
      * Clear all arcs and reset stack
      * Empties graph while preserving allocated memory.
@@ -503,6 +663,8 @@ namespace GOMA
     {
         succ_.clear();
         stack_.clear();
+
+        components_valid_ = false;
     }
 
     /**
@@ -515,10 +677,191 @@ namespace GOMA
     {
         succ_.add_arc(i, j, arc_cost);
 
+        components_valid_ = false;
+
         active_vertices_.insert(i + 1);
         active_vertices_.insert(j + 1);
     }
 
+    /**
+     * Remove directed arc (i,j)
+     *
+     * Delegates to succ_.remove_arc(). Vertices stay marked as active.
+     */
+    void search_graph::remove_arc(const int i, const int j)
+    {
+        succ_.remove_arc(i, j);
+
+        components_valid_ = false;
+    }
+
+    /**
+     * Change the cost of arc (i,j)
+     */
+    void search_graph::set_arc_cost(const int i, const int j, const double arc_cost)
+    {
+        succ_.set_cost(i, j, arc_cost);
+    }
+
+    /**
+     * Build the compressed successor layout used by the searches
+     *
+     * Delegates to succ_.compress(). Searches also work on an uncompressed
+     * graph (through the per-vertex lists), so this is only a layout choice.
+     */
+    void search_graph::compress(void)
+    {
+        succ_.compress();
+    }
+
+    /**
+     * Strongly connected components (iterative Tarjan)
+     *
+     * Explicit stack of (vertex, successors left), so deep graphs do not
+     * overflow the call stack. Components are numbered in the order
+     * Tarjan closes them (reverse topological order of the condensation).
+     */
+    void search_graph::find_components(void)
+    {
+        const int n{(int)succ_.get_n_vertices()};
+
+        vector<int> index(n, -1);
+        vector<int> low(n, 0);
+        vector<int> stack;
+        vector<bool> on_stack(n, false);
+        vector<pair<int, size_t>> dfs;
+
+        component_.assign(n, -1);
+        n_components_ = 0;
+
+        int counter{0};
+
+        for (int root{0}; root < n; root++)
+        {
+            if (index[root] >= 0)
+                continue;
+
+            dfs.push_back(pair<int, size_t>(root, succ_.get_n_succ(root)));
+            index[root] = low[root] = counter++;
+            stack.push_back(root);
+            on_stack[root] = true;
+
+            while (!dfs.empty())
+            {
+                const int v{dfs.back().first};
+                size_t &left{dfs.back().second};
+
+                if (left > 0)
+                {
+                    size_t n_succ = 0;
+                    const int *succ = NULL;
+
+                    succ_.successors(v, succ, n_succ);
+
+                    const int w{succ[--left]};
+
+                    if (index[w] < 0)
+                    {
+                        index[w] = low[w] = counter++;
+                        stack.push_back(w);
+                        on_stack[w] = true;
+
+                        dfs.push_back(pair<int, size_t>(w, succ_.get_n_succ(w)));
+                    }
+                    else if (on_stack[w])
+                    {
+                        low[v] = min(low[v], index[w]);
+                    }
+
+                    continue;
+                }
+
+                dfs.pop_back();
+
+                if (!dfs.empty())
+                {
+                    const int u{dfs.back().first};
+                    low[u] = min(low[u], low[v]);
+                }
+
+                // v is the root of a component
+                if (low[v] == index[v])
+                {
+                    int w{-1};
+
+                    do
+                    {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+
+                        component_[w] = (int)n_components_;
+                    } while (w != v);
+
+                    n_components_++;
+                }
+            }
+        }
+
+        components_valid_ = true;
+    }
+
+    /**
+     * Vertices that reach a target
+     *
+     * Every vertex of a path from source to target reaches target. If
+     * source and target are in the same component, so is every vertex of
+     * such a path (it reaches target, hence source, and source reaches
+     * it), and the backward search stays inside the component. With
+     * several targets, this holds if all of them are in the component of
+     * the source.
+     */
+    bool search_graph::mark_reaching_(const int s, const int *targets, const size_t n_targets, search_workspace &ws) const
+    {
+        search_fixed_bitset &reach{ws.reach_};
+        vector<int> &queue{ws.queue_};
+
+        const int c{component_[s]};
+
+        bool same_component{components_valid_};
+
+        for (size_t k{0}; k < n_targets && same_component; k++)
+            same_component = component_[targets[k]] == c;
+
+        reach.clear();
+        queue.clear();
+
+        for (size_t k{0}; k < n_targets; k++)
+        {
+            if (reach.contains(targets[k] + 1))
+                continue;
+
+            reach.insert(targets[k] + 1);
+            queue.push_back(targets[k]);
+        }
+
+        for (size_t q{0}; q < queue.size(); q++)
+        {
+            size_t n_pred = 0;
+            const int *pred = NULL;
+
+            succ_.predecessors(queue[q], pred, n_pred);
+
+            for (size_t r{0}; r < n_pred; r++)
+            {
+                const int i{pred[r]};
+
+                if (reach.contains(i + 1) || (same_component && component_[i] != c))
+                    continue;
+
+                reach.insert(i + 1);
+                queue.push_back(i);
+            }
+        }
+
+        return reach.contains(s + 1);
+    }
+
     /**
      * Depth-First Search to find all simple paths from s to t
      * 
@@ -556,16 +899,22 @@ namespace GOMA
      * // paths = {{0,1,3}, {0,2,3}}
      * @endcode
      */
-    void search_graph::DFS(const int s, const int t, vector<vector<int>> &p)
+    bool search_graph::DFS(const int s, const int t, vector<vector<int>> &p, const search_deadline *deadline)
     {
         p.clear();
         stack_.clear();
 
         stack_.push(s);
 
+        size_t n_steps{0};
+
         // Main DFS loop: process stack until empty
         while (!stack_.empty())
         {
+            // Cooperative stop: the clock is read every 1024 pops
+            if (deadline != NULL && (++n_steps & 1023) == 0 && deadline->expired())
+                return false;
+
             // Pop current vertex and its state
             const node_info si{stack_.top()};
             stack_.pop();
@@ -586,14 +935,14 @@ namespace GOMA
             {
                 // Explore successors of current vertex
                 size_t n_succ = 0;
-                int *succ = NULL;
+                const int *succ = NULL;
 
                 succ_.successors(id, succ, n_succ);
 
                 if (n_succ != 0)
                 {
                     // Get visited set for cycle detection
-                    const search_fixed_bitset visited{si.get_visited()};
+                    const search_fixed_bitset &visited{si.get_visited()};
 
                     // Push all unvisited successors onto stack
                     for (size_t k{0}; k < n_succ; k++)
@@ -612,6 +961,671 @@ namespace GOMA
                 }
             }
         }
+
+        return true;
+    }
+
+    /**
+     * Backtracking Depth-First Search to find all simple paths from s to t
+     * 
+     * Recursive DFS written with explicit per-depth state:
+     * - path_[d]: vertex at depth d of the current path
+     * - next_succ_[d]: number of successors of path_[d] not tried yet
+     * - on_path_: vertices of path_[0..d] (the visited set of DFS())
+     * 
+     * Entering a vertex sets path_, next_succ_ and on_path_ at the next
+     * depth; leaving it removes it from on_path_. Successors are consumed
+     * from last to first, so paths come out in the same order as DFS().
+     * The target is never expanded, as in DFS().
+     *
+     * With a deadline, the clock is read every 1024 steps (vertex entered
+     * or successor tried); the paths found until the stop are kept.
+     */
+    bool search_graph::backtrack_DFS(const int s, const int t, ragged_array<int> &p, const search_deadline *deadline)
+    {
+        return backtrack_DFS(s, t, p, workspace_, deadline);
+    }
+
+    bool search_graph::backtrack_DFS(const int s, const int t, ragged_array<int> &p, search_workspace &ws,
+                                     const search_deadline *deadline) const
+    {
+        p.clear();
+
+        vector<int> &path{ws.path_};
+        vector<size_t> &next_succ{ws.next_succ_};
+        search_fixed_bitset &on_path{ws.on_path_};
+
+        assert(path.size() > n_vertices_);
+
+        // A path already ends at the source
+        if (s == t)
+        {
+            p.push_item(s);
+            p.close_list();
+            return true;
+        }
+
+        // Vertices that cannot reach t are dead ends
+        const bool pruned{is_pruned_()};
+        const search_fixed_bitset &reach{ws.reach_};
+
+        if (pruned && !mark_reaching_(s, &t, 1, ws))
+            return true;
+
+        size_t n_succ = 0;
+        const int *succ = NULL;
+
+        on_path.clear();
+
+        int depth{0};
+        size_t n_steps{0};
+
+        path[0] = s;
+        on_path.insert(s + 1);
+
+        GOMA_STATS(ws.n_expanded_++);
+
+        succ_.successors(s, succ, n_succ);
+        next_succ[0] = n_succ;
+
+        while (depth >= 0)
+        {
+            const int id{path[depth]};
+
+            // All successors tried: leave vertex
+            if (next_succ[depth] == 0)
+            {
+                on_path.remove(id + 1);
+                depth--;
+
+                continue;
+            }
+
+            if (deadline != NULL && (++n_steps & 1023) == 0 && deadline->expired())
+                return false;
+
+            succ_.successors(id, succ, n_succ);
+
+            const int j{succ[--next_succ[depth]]};
+
+            // Only explore if j not on the current path (avoid cycles) and reaches t
+            if (on_path.contains(j + 1) || (pruned && !reach.contains(j + 1)))
+                continue;
+
+            if (j == t)
+            {
+                // Found complete path from s to t
+                for (int d{0}; d <= depth; d++)
+                    p.push_item(path[d]);
+
+                p.push_item(j);
+                p.close_list();
+            }
+            else
+            {
+                // Enter successor
+                depth++;
+
+                path[depth] = j;
+                on_path.insert(j + 1);
+
+                GOMA_STATS(ws.n_expanded_++);
+
+                succ_.successors(j, succ, n_succ);
+                next_succ[depth] = n_succ;
+            }
+        }
+
+        return true;
+    }
+
+    // ========================================================================
+    // search_steal_pool: Shared state of a work-stealing enumeration
+    // ========================================================================
+
+    /**
+     * Frontiers waiting for a worker, output slots in DFS order and the
+     * idle workers. Slots are a linked list: a frontier given by the worker
+     * of slot k gets a new slot right after k. The paths of a slot are only
+     * written by the worker searching its frontier, and a deque keeps their
+     * address while other slots are added.
+     */
+    class search_steal_pool
+    {
+    public:
+        const size_t n_workers_;          ///< Threads of the search
+
+        mutex mutex_;                     ///< Guards everything below but the atomics
+        condition_variable work_;         ///< Signalled when a frontier is given or the search ends
+
+        vector<search_frontier> pending_; ///< Frontiers not taken yet
+        deque<ragged_array<int>> paths_;  ///< Paths of each slot
+        vector<int> next_slot_;           ///< Slot after each slot in DFS order (-1: last)
+
+        atomic<size_t> n_waiting_;        ///< Workers waiting for a frontier (read by busy ones)
+        atomic<bool> stopped_;            ///< The deadline stopped a worker
+        bool done_;                       ///< No frontier left and every worker idle, or stopped
+
+    public:
+        search_steal_pool(const size_t n_workers) : n_workers_(n_workers),
+                                                    mutex_(),
+                                                    work_(),
+                                                    pending_(),
+                                                    paths_(1),
+                                                    next_slot_(1, -1),
+                                                    n_waiting_(0),
+                                                    stopped_(false),
+                                                    done_(false)
+        {
+        }
+
+        /**
+         * @brief Wait for a frontier
+         * @param f Output: frontier to search
+         * @param paths Output: its output slot
+         * @return false when the search is over
+         */
+        bool take(search_frontier &f, ragged_array<int> *&paths)
+        {
+            unique_lock<mutex> lock(mutex_);
+
+            n_waiting_++;
+
+            while (pending_.empty() && !done_)
+            {
+                // Nobody left to give work: the enumeration is complete
+                if (n_waiting_ == n_workers_)
+                {
+                    done_ = true;
+                    work_.notify_all();
+                    break;
+                }
+
+                work_.wait(lock);
+            }
+
+            n_waiting_--;
+
+            if (pending_.empty() || stopped_)
+                return false;
+
+            swap(f, pending_.back());
+            pending_.pop_back();
+
+            paths = &paths_[f.slot_];
+
+            return true;
+        }
+
+        /**
+         * @brief Check whether a waiting worker has no frontier yet (lock held)
+         */
+        inline bool is_hungry(void) const { return pending_.size() < n_waiting_; }
+
+        /**
+         * @brief Queue a frontier after the slot of its giver (lock held)
+         * @param f Frontier, its slot_ set here
+         * @param giver_slot Slot of the worker that gives it
+         */
+        void give(search_frontier &f, const size_t giver_slot)
+        {
+            f.slot_ = paths_.size();
+
+            paths_.emplace_back();
+            next_slot_.push_back(next_slot_[giver_slot]);
+            next_slot_[giver_slot] = (int)f.slot_;
+
+            pending_.push_back(search_frontier());
+            swap(pending_.back(), f);
+
+            work_.notify_one();
+        }
+
+        /**
+         * @brief End the search early (deadline)
+         */
+        void stop(void)
+        {
+            lock_guard<mutex> lock(mutex_);
+
+            stopped_ = true;
+            done_ = true;
+
+            work_.notify_all();
+        }
+    };
+
+    /**
+     * Work-stealing enumeration of the simple paths from s to t
+     *
+     * The root frontier (s and all its successors) goes to slot 0 and the
+     * calling thread searches with ws[0] next to ws.size() - 1 threads.
+     * With pruning, the vertices reaching t are marked once in ws[0] and
+     * copied to the other workspaces.
+     */
+    bool search_graph::stealing_DFS(const int s, const int t, ragged_array<int> &p, vector<search_workspace> &ws,
+                                    const search_deadline *deadline) const
+    {
+        assert(!ws.empty());
+
+        if (ws.size() == 1)
+            return backtrack_DFS(s, t, p, ws[0], deadline);
+
+        p.clear();
+
+        // A path already ends at the source
+        if (s == t)
+        {
+            p.push_item(s);
+            p.close_list();
+            return true;
+        }
+
+        // Vertices that cannot reach t are dead ends
+        if (is_pruned_())
+        {
+            if (!mark_reaching_(s, &t, 1, ws[0]))
+                return true;
+
+            for (size_t w{1}; w < ws.size(); w++)
+                ws[w].reach_ = ws[0].reach_;
+        }
+
+        search_steal_pool pool(ws.size());
+
+        size_t n_succ = 0;
+        const int *succ = NULL;
+
+        succ_.successors(s, succ, n_succ);
+
+        search_frontier root;
+        root.prefix_.assign(1, s);
+        root.on_path_.clear();
+        root.on_path_.insert(s + 1);
+        root.n_succ_ = n_succ;
+        root.slot_ = 0;
+
+        pool.pending_.push_back(root);
+
+        GOMA_STATS(ws[0].n_expanded_++);
+
+        vector<thread> workers;
+
+        for (size_t w{1}; w < ws.size(); w++)
+            workers.push_back(thread(&search_graph::steal_worker_, this, t, ref(pool), ref(ws[w]), deadline));
+
+        steal_worker_(t, pool, ws[0], deadline);
+
+        for (thread &worker : workers)
+            worker.join();
+
+        // Slots in DFS order: the output of backtrack_DFS
+        for (int slot{0}; slot >= 0; slot = pool.next_slot_[slot])
+            p.append(pool.paths_[slot]);
+
+        return !pool.stopped_;
+    }
+
+    /**
+     * Work-stealing worker
+     *
+     * Each frontier is searched as backtrack_DFS does below its prefix,
+     * down to the depth of the prefix. Every 64 steps the worker looks at
+     * the idle count; if a waiting worker has no frontier, it gives away
+     * the untried successors of the shallowest vertex of its path above the
+     * current one (the largest subtrees left) and goes on with its branch.
+     */
+    void search_graph::steal_worker_(const int t, search_steal_pool &pool, search_workspace &ws,
+                                     const search_deadline *deadline) const
+    {
+        vector<int> &path{ws.path_};
+        vector<size_t> &next_succ{ws.next_succ_};
+        search_fixed_bitset &on_path{ws.on_path_};
+
+        assert(path.size() > n_vertices_);
+
+        const bool pruned{is_pruned_()};
+        const search_fixed_bitset &reach{ws.reach_};
+
+        search_frontier task;
+        ragged_array<int> *paths{NULL};
+
+        size_t n_succ = 0;
+        const int *succ = NULL;
+
+        size_t n_steps{0};
+
+        while (pool.take(task, paths))
+        {
+            const int base{(int)task.prefix_.size() - 1};
+
+            copy(task.prefix_.begin(), task.prefix_.end(), path.begin());
+            on_path = task.on_path_;
+            next_succ[base] = task.n_succ_;
+
+            int depth{base};
+
+            while (depth >= base)
+            {
+                const int id{path[depth]};
+
+                // All successors tried: leave vertex
+                if (next_succ[depth] == 0)
+                {
+                    on_path.remove(id + 1);
+                    depth--;
+
+                    continue;
+                }
+
+                if ((++n_steps & 63) == 0)
+                {
+                    if (pool.stopped_)
+                        return;
+
+                    if (deadline != NULL && (n_steps & 1023) == 0 && deadline->expired())
+                    {
+                        pool.stop();
+                        return;
+                    }
+
+                    if (pool.n_waiting_ > 0)
+                    {
+                        lock_guard<mutex> lock(pool.mutex_);
+
+                        int d{base};
+
+                        while (d < depth && next_succ[d] == 0)
+                            d++;
+
+                        if (d < depth && pool.is_hungry())
+                        {
+                            search_frontier f;
+
+                            f.prefix_.assign(path.begin(), path.begin() + d + 1);
+                            f.on_path_ = on_path;
+
+                            for (int e{d + 1}; e <= depth; e++)
+                                f.on_path_.remove(path[e] + 1);
+
+                            f.n_succ_ = next_succ[d];
+                            next_succ[d] = 0;
+
+                            pool.give(f, task.slot_);
+
+                            GOMA_STATS(ws.n_donated_++);
+                        }
+                    }
+                }
+
+                succ_.successors(id, succ, n_succ);
+
+                const int j{succ[--next_succ[depth]]};
+
+                // Only explore if j not on the current path (avoid cycles) and reaches t
+                if (on_path.contains(j + 1) || (pruned && !reach.contains(j + 1)))
+                    continue;
+
+                if (j == t)
+                {
+                    for (int d{0}; d <= depth; d++)
+                        paths->push_item(path[d]);
+
+                    paths->push_item(j);
+                    paths->close_list();
+                }
+                else
+                {
+                    // Enter successor
+                    depth++;
+
+                    path[depth] = j;
+                    on_path.insert(j + 1);
+
+                    GOMA_STATS(ws.n_expanded_++);
+
+                    succ_.successors(j, succ, n_succ);
+                    next_succ[depth] = n_succ;
+                }
+            }
+        }
+    }
+
+    /**
+     * Backtracking enumeration of the simple paths from s to several targets
+     *
+     * One traversal serves all targets: target_slot_ maps each target to
+     * its output slot, every vertex entered that is a target adds the
+     * current path to its slot, and targets are expanded like any other
+     * vertex (a path to one target may continue to another). Each simple
+     * path from s is one node of the traversal, and the paths to one
+     * target come out in the order of backtrack_DFS(s, t), which visits
+     * a prefix-closed subset of the same tree in the same order.
+     */
+    bool search_graph::backtrack_DFS(const int s, const vector<int> &targets, vector<ragged_array<int>> &p,
+                                     search_workspace &ws, const search_deadline *deadline) const
+    {
+        const size_t n_targets{targets.size()};
+
+        p.resize(n_targets);
+
+        for (ragged_array<int> &p_target : p)
+            p_target.clear();
+
+        if (n_targets == 0)
+            return true;
+
+        vector<int> &path{ws.path_};
+        vector<size_t> &next_succ{ws.next_succ_};
+        search_fixed_bitset &on_path{ws.on_path_};
+        vector<int> &slot{ws.target_slot_};
+
+        assert(path.size() > n_vertices_);
+
+        if (slot.size() < path.size())
+            slot.assign(path.size(), -1);
+
+        for (size_t k{0}; k < n_targets; k++)
+        {
+            assert(slot[targets[k]] < 0);
+            slot[targets[k]] = (int)k;
+        }
+
+        // Vertices that cannot reach any target are dead ends
+        const bool pruned{is_pruned_()};
+        const search_fixed_bitset &reach{ws.reach_};
+
+        bool complete{true};
+
+        if (!pruned || mark_reaching_(s, targets.data(), n_targets, ws))
+        {
+            size_t n_succ = 0;
+            const int *succ = NULL;
+
+            on_path.clear();
+
+            int depth{0};
+            size_t n_steps{0};
+
+            path[0] = s;
+            on_path.insert(s + 1);
+
+            GOMA_STATS(ws.n_expanded_++);
+
+            // A path already ends at the source
+            if (slot[s] >= 0)
+            {
+                p[slot[s]].push_item(s);
+                p[slot[s]].close_list();
+            }
+
+            succ_.successors(s, succ, n_succ);
+            next_succ[0] = n_succ;
+
+            while (depth >= 0)
+            {
+                const int id{path[depth]};
+
+                // All successors tried: leave vertex
+                if (next_succ[depth] == 0)
+                {
+                    on_path.remove(id + 1);
+                    depth--;
+
+                    continue;
+                }
+
+                if (deadline != NULL && (++n_steps & 1023) == 0 && deadline->expired())
+                {
+                    complete = false;
+                    break;
+                }
+
+                succ_.successors(id, succ, n_succ);
+
+                const int j{succ[--next_succ[depth]]};
+
+                if (on_path.contains(j + 1) || (pruned && !reach.contains(j + 1)))
+                    continue;
+
+                // Enter successor
+                depth++;
+
+                path[depth] = j;
+                on_path.insert(j + 1);
+
+                GOMA_STATS(ws.n_expanded_++);
+
+                if (slot[j] >= 0)
+                    p[slot[j]].push_back(array_view<int>(path.data(), depth + 1));
+
+                succ_.successors(j, succ, n_succ);
+                next_succ[depth] = n_succ;
+            }
+        }
+
+        for (const int t : targets)
+            slot[t] = -1;
+
+        return complete;
+    }
+
+    /**
+     * Best-first enumeration of the k cheapest simple paths from s to t
+     * 
+     * Labels (vertex, parent label, path cost) are kept in the workspace (labels_) and
+     * selected in nondecreasing cost order from a binary heap. A label is
+     * extended to every successor not already on its path (checked by
+     * walking the parent chain). As costs are nonnegative, labels reach t
+     * in nondecreasing path cost, so the first k of them are the k
+     * cheapest simple paths. Ties are broken by creation order.
+     * 
+     * The clock is read every 1024 label selections when a time limit is
+     * given.
+     */
+    void search_graph::best_first_paths(const int s, const int t, const size_t k, const double time_limit,
+                                        ragged_array<int> &p, vector<double> &costs)
+    {
+        best_first_paths(s, t, k, time_limit, p, costs, workspace_);
+    }
+
+    void search_graph::best_first_paths(const int s, const int t, const size_t k, const double time_limit,
+                                        ragged_array<int> &p, vector<double> &costs, search_workspace &ws) const
+    {
+        p.clear();
+        costs.clear();
+
+        if (k == 0)
+            return;
+
+        vector<path_label> &labels{ws.labels_};
+
+        labels.clear();
+
+        // Vertices that cannot reach t are dead ends
+        const bool pruned{is_pruned_()};
+        const search_fixed_bitset &reach{ws.reach_};
+
+        if (pruned && !mark_reaching_(s, &t, 1, ws))
+            return;
+
+        // Min-heap of (cost, label index)
+        typedef pair<double, int> heap_item;
+        priority_queue<heap_item, vector<heap_item>, greater<heap_item>> heap;
+
+        const chrono::steady_clock::time_point start{chrono::steady_clock::now()};
+
+        labels.push_back(path_label{s, -1, 0.0});
+        heap.push(heap_item(0.0, 0));
+
+        size_t n_selected{0};
+
+        vector<int> path;
+
+        while (!heap.empty() && p.size() < k)
+        {
+            const int l{heap.top().second};
+            heap.pop();
+
+            if (time_limit > 0 && (++n_selected & 1023) == 0)
+            {
+                const chrono::duration<double> elapsed{chrono::steady_clock::now() - start};
+
+                if (elapsed.count() >= time_limit)
+                    break;
+            }
+
+            const int id{labels[l].id_};
+            const double cost{labels[l].cost_};
+
+            if (id == t)
+            {
+                // Found path: rebuild it from the parent chain
+                path.clear();
+
+                for (int m{l}; m >= 0; m = labels[m].parent_)
+                    path.push_back(labels[m].id_);
+
+                reverse(path.begin(), path.end());
+
+                p.push_back(path);
+                costs.push_back(cost);
+
+                continue;
+            }
+
+            GOMA_STATS(ws.n_expanded_++);
+
+            size_t n_succ = 0;
+            const int *succ = NULL;
+            const double *succ_cost = NULL;
+
+            succ_.successors(id, succ, succ_cost, n_succ);
+
+            for (size_t r{0}; r < n_succ; r++)
+            {
+                const int j{succ[r]};
+
+                assert(succ_cost[r] >= 0.0);
+
+                if (pruned && !reach.contains(j + 1))
+                    continue;
+
+                // Only extend if j is not on the path of label l (avoid cycles)
+                bool on_path{false};
+
+                for (int m{l}; m >= 0 && !on_path; m = labels[m].parent_)
+                    on_path = labels[m].id_ == j;
+
+                if (!on_path)
+                {
+                    const double new_cost{cost + succ_cost[r]};
+
+                    labels.push_back(path_label{j, l, new_cost});
+                    heap.push(heap_item(new_cost, (int)labels.size() - 1));
+                }
+            }
+        }
     }
 
-}
\ No newline at end of file
+}
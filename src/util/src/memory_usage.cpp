@@ -0,0 +1,44 @@
+/**
+ * @file memory_usage.cpp
+ * @brief Implementation of the process memory queries
+ */
+
+#include "memory_usage.hpp"
+
+#include <cstdio>
+
+#include <unistd.h>
+#include <sys/resource.h>
+
+namespace GOMA
+{
+    size_t process_rss_bytes(void)
+    {
+        FILE *file{fopen("/proc/self/statm", "r")};
+
+        if (file == NULL)
+            return 0;
+
+        unsigned long size{0};
+        unsigned long resident{0};
+
+        const int n_read{fscanf(file, "%lu %lu", &size, &resident)};
+        fclose(file);
+
+        if (n_read != 2)
+            return 0;
+
+        return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+    }
+
+    size_t process_peak_rss_bytes(void)
+    {
+        rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+        // Linux reports kilobytes
+        return (size_t)usage.ru_maxrss * 1024;
+    }
+}
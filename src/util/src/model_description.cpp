@@ -1,4 +1,7 @@
 #include "model_description.hpp"
+#include "memory_usage.hpp"
+
+#include <atomic>
 
 namespace GOMA
 {
@@ -24,14 +27,31 @@ namespace GOMA
     {
     }
 
+    size_t model_description::get_memory_bytes(void) const
+    {
+        return string_bytes(name_) + vector_bytes(obj_) + vector_bytes(bd_) + vector_bytes(bounds_) +
+               vector_bytes(ctype_) + vector_bytes(sense_) + vector_bytes(rhs_) + M_.get_memory_bytes() +
+               vector_bytes(var_labels_) + vector_bytes(cons_labels_);
+    }
+
+    static atomic<bool> labels_{false};
+
+    void model_description::set_labels(const bool labels)
+    {
+        labels_.store(labels);
+    }
+
+    bool model_description::get_labels(void)
+    {
+        return labels_.load();
+    }
+
     void model_description::set_dual_(const model_description &primal)
     {
         set_n_col(primal.get_n_row());
         set_n_row(primal.get_n_col());
 
-        matrix<double> M;
-        primal.get_M().transpose(M);
-        set_M(M);
+        primal.get_M().transpose(M_);
         set_nz(primal.get_nz());
 
         set_var_labels(primal.get_cons_labels());
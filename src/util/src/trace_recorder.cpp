@@ -0,0 +1,214 @@
+/**
+ * @file trace_recorder.cpp
+ * @brief Implementation of the Chrome trace recorder
+ */
+
+#include "trace_recorder.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GOMA
+{
+    /**
+     * @brief One complete event (ph "X")
+     */
+    struct trace_event_
+    {
+        const char *name;
+        const char *category;
+        chrono::steady_clock::time_point start;
+        chrono::steady_clock::time_point end;
+    };
+
+    /**
+     * @brief Events of one thread (of one thread at a time)
+     *
+     * The mutex is only contended by start() and write().
+     */
+    struct trace_buffer_
+    {
+        mutex mutex_;
+        vector<trace_event_> events_;
+        size_t tid_;
+        size_t n_dropped_;
+
+        explicit trace_buffer_(const size_t tid) : mutex_(), events_(), tid_(tid), n_dropped_(0) {}
+    };
+
+    /**
+     * @brief Buffers of every thread that recorded since the process start
+     *
+     * Never destroyed: threads may still record during the static
+     * destruction.
+     */
+    struct trace_registry_
+    {
+        mutex mutex_;
+        vector<unique_ptr<trace_buffer_>> buffers_;
+        vector<trace_buffer_ *> free_;
+        atomic<bool> started_;
+        chrono::steady_clock::time_point origin_;
+
+        trace_registry_(void) : mutex_(), buffers_(), free_(), started_(false), origin_(chrono::steady_clock::now()) {}
+    };
+
+    static trace_registry_ &registry_(void)
+    {
+        static trace_registry_ *registry = new trace_registry_();
+        return *registry;
+    }
+
+    /**
+     * @brief Buffer of the calling thread, taken on its first event and
+     * handed back when the thread ends
+     */
+    class trace_holder_
+    {
+    private:
+        trace_buffer_ *buffer_;
+
+    public:
+        trace_holder_(void) : buffer_(nullptr) {}
+
+        ~trace_holder_(void)
+        {
+            if (buffer_ != nullptr)
+            {
+                trace_registry_ &registry = registry_();
+                lock_guard<mutex> lock(registry.mutex_);
+                registry.free_.push_back(buffer_);
+            }
+        }
+
+        trace_buffer_ &get(void)
+        {
+            if (buffer_ == nullptr)
+            {
+                trace_registry_ &registry = registry_();
+                lock_guard<mutex> lock(registry.mutex_);
+                if (registry.free_.empty())
+                {
+                    registry.buffers_.emplace_back(new trace_buffer_(registry.buffers_.size() + 1));
+                    buffer_ = registry.buffers_.back().get();
+                }
+                else
+                {
+                    buffer_ = registry.free_.back();
+                    registry.free_.pop_back();
+                }
+            }
+            return *buffer_;
+        }
+    };
+
+    static trace_buffer_ &thread_buffer_(void)
+    {
+        thread_local trace_holder_ holder;
+        return holder.get();
+    }
+
+    void trace_recorder::start(void)
+    {
+        trace_registry_ &registry = registry_();
+        lock_guard<mutex> lock(registry.mutex_);
+
+        for (unique_ptr<trace_buffer_> &buffer : registry.buffers_)
+        {
+            lock_guard<mutex> buffer_lock(buffer->mutex_);
+            buffer->events_.clear();
+            buffer->n_dropped_ = 0;
+        }
+        registry.origin_ = chrono::steady_clock::now();
+        registry.started_.store(true, memory_order_release);
+    }
+
+    void trace_recorder::stop(void)
+    {
+        registry_().started_.store(false, memory_order_release);
+    }
+
+    bool trace_recorder::is_started(void)
+    {
+        return registry_().started_.load(memory_order_relaxed);
+    }
+
+    chrono::steady_clock::time_point trace_recorder::begin(void)
+    {
+        thread_buffer_();
+        return chrono::steady_clock::now();
+    }
+
+    void trace_recorder::record(const char *name, const char *category,
+                                const chrono::steady_clock::time_point &start,
+                                const chrono::steady_clock::time_point &end)
+    {
+        trace_buffer_ &buffer = thread_buffer_();
+
+        lock_guard<mutex> lock(buffer.mutex_);
+        if (buffer.events_.size() < max_events)
+            buffer.events_.push_back(trace_event_{name, category, start, end});
+        else
+            buffer.n_dropped_++;
+    }
+
+    bool trace_recorder::write(const string &file_name)
+    {
+        ofstream file(file_name);
+        if (!file)
+            return false;
+
+        trace_registry_ &registry = registry_();
+        lock_guard<mutex> lock(registry.mutex_);
+
+        const chrono::steady_clock::time_point origin = registry.origin_;
+        bool first = true;
+
+        // Times in microseconds since start()
+        file << fixed << setprecision(3);
+        file << "{\"traceEvents\":[" << endl;
+        for (unique_ptr<trace_buffer_> &buffer : registry.buffers_)
+        {
+            lock_guard<mutex> buffer_lock(buffer->mutex_);
+
+            if (buffer->events_.empty())
+                continue;
+
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid_
+                 << ",\"args\":{\"name\":\"thread " << buffer->tid_ << "\"}}";
+            first = false;
+
+            for (const trace_event_ &event : buffer->events_)
+            {
+                const chrono::duration<double, micro> ts{event.start - origin};
+                const chrono::duration<double, micro> dur{event.end - event.start};
+
+                file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                     << "\",\"ph\":\"X\",\"ts\":" << ts.count() << ",\"dur\":" << dur.count()
+                     << ",\"pid\":1,\"tid\":" << buffer->tid_ << "}";
+            }
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}" << endl;
+
+        return bool(file);
+    }
+
+    size_t trace_recorder::get_n_dropped(void)
+    {
+        trace_registry_ &registry = registry_();
+        lock_guard<mutex> lock(registry.mutex_);
+
+        size_t n_dropped = 0;
+        for (unique_ptr<trace_buffer_> &buffer : registry.buffers_)
+        {
+            lock_guard<mutex> buffer_lock(buffer->mutex_);
+            n_dropped += buffer->n_dropped_;
+        }
+        return n_dropped;
+    }
+}